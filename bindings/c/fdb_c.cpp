@@ -295,6 +295,46 @@ fdb_error_t fdb_future_get_keyvalue_array_impl(FDBFuture* f,
 	                 *out_more = rrr.more;);
 }
 
+// Copies the pairs of rrr that fit into buffer, in the format documented for fdb_future_get_keyvalue_buffer
+static void packKeyValues(RangeResultRef const& rrr,
+                          uint8_t* buffer,
+                          int bufferLength,
+                          int* outCount,
+                          int* outLength,
+                          fdb_bool_t* outMore) {
+	int count = 0;
+	int length = 0;
+	for (; count < rrr.size(); count++) {
+		const KeyValueRef& kv = rrr[count];
+		int32_t keyLength = kv.key.size();
+		int32_t valueLength = kv.value.size();
+		int pairLength = 2 * sizeof(int32_t) + keyLength + valueLength;
+		if (pairLength > bufferLength - length) {
+			break;
+		}
+		memcpy(buffer + length, &keyLength, sizeof(int32_t));
+		memcpy(buffer + length + sizeof(int32_t), &valueLength, sizeof(int32_t));
+		length += 2 * sizeof(int32_t);
+		memcpy(buffer + length, kv.key.begin(), keyLength);
+		length += keyLength;
+		memcpy(buffer + length, kv.value.begin(), valueLength);
+		length += valueLength;
+	}
+	*outCount = count;
+	*outLength = length;
+	*outMore = rrr.more || count < rrr.size();
+}
+
+extern "C" DLLEXPORT fdb_error_t fdb_future_get_keyvalue_buffer(FDBFuture* f,
+                                                               uint8_t* buffer,
+                                                               int buffer_length,
+                                                               int* out_count,
+                                                               int* out_length,
+                                                               fdb_bool_t* out_more) {
+	CATCH_AND_RETURN(Standalone<RangeResultRef> rrr = TSAV(Standalone<RangeResultRef>, f)->get();
+	                 packKeyValues(rrr, buffer, buffer_length, out_count, out_length, out_more););
+}
+
 fdb_error_t fdb_future_get_keyvalue_array_v13(FDBFuture* f, FDBKeyValue const** out_kv, int* out_count) {
 	CATCH_AND_RETURN(Standalone<RangeResultRef> rrr = TSAV(Standalone<RangeResultRef>, f)->get();
 	                 *out_kv = (FDBKeyValue*)rrr.begin();
@@ -1179,6 +1219,19 @@ extern "C" DLLEXPORT FDBFuture* fdb_transaction_get_tag_throttled_duration(FDBTr
 	return (FDBFuture*)TXN(tr)->getTagThrottledDuration().extractPtr();
 }
 
+extern "C" DLLEXPORT FDBFuture* fdb_transaction_get_multi(FDBTransaction* tr,
+                                                         uint8_t const* const* key_names,
+                                                         int const* key_name_lengths,
+                                                         int key_count,
+                                                         fdb_bool_t snapshot) {
+	Standalone<VectorRef<KeyRef>> keys;
+	keys.reserve(keys.arena(), std::max(key_count, 0));
+	for (int i = 0; i < key_count; i++) {
+		keys.push_back(keys.arena(), KeyRef(key_names[i], key_name_lengths[i]));
+	}
+	return (FDBFuture*)(TXN(tr)->getMulti(keys, snapshot).extractPtr());
+}
+
 extern "C" DLLEXPORT FDBFuture* fdb_transaction_get_total_cost(FDBTransaction* tr) {
 	return (FDBFuture*)TXN(tr)->getTotalCost().extractPtr();
 }
@@ -311,6 +311,16 @@ DLLEXPORT WARN_UNUSED_RESULT fdb_error_t fdb_future_get_keyvalue_array(FDBFuture
                                                                        fdb_bool_t* out_more);
 #endif
 
+/* Copies as many key-value pairs of a range result as fit into buffer, each as a native-endian 4 byte key length, a
+ * 4 byte value length, the key and then the value, so that bindings can decode the pairs in place. out_count is the
+ * number of pairs copied and out_length the number of bytes used. out_more is also set if some pairs did not fit. */
+DLLEXPORT WARN_UNUSED_RESULT fdb_error_t fdb_future_get_keyvalue_buffer(FDBFuture* f,
+                                                                        uint8_t* buffer,
+                                                                        int buffer_length,
+                                                                        int* out_count,
+                                                                        int* out_length,
+                                                                        fdb_bool_t* out_more);
+
 DLLEXPORT WARN_UNUSED_RESULT fdb_error_t fdb_future_get_mappedkeyvalue_array(FDBFuture* f,
                                                                              FDBMappedKeyValue const** out_kv,
                                                                              int* out_count,
@@ -632,6 +642,14 @@ DLLEXPORT WARN_UNUSED_RESULT fdb_error_t fdb_transaction_get_committed_version(F
  */
 DLLEXPORT WARN_UNUSED_RESULT FDBFuture* fdb_transaction_get_tag_throttled_duration(FDBTransaction* tr);
 
+/* Reads the values of key_count keys at once. The future is read with fdb_future_get_keyvalue_array, and holds the
+ * keys that have values, in the order they were given. */
+DLLEXPORT WARN_UNUSED_RESULT FDBFuture* fdb_transaction_get_multi(FDBTransaction* tr,
+                                                                  uint8_t const* const* key_names,
+                                                                  int const* key_name_lengths,
+                                                                  int key_count,
+                                                                  fdb_bool_t snapshot);
+
 DLLEXPORT WARN_UNUSED_RESULT FDBFuture* fdb_transaction_get_total_cost(FDBTransaction* tr);
 
 DLLEXPORT WARN_UNUSED_RESULT FDBFuture* fdb_transaction_get_approximate_size(FDBTransaction* tr);
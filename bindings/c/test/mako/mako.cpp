@@ -61,6 +61,7 @@
 #include "mako.hpp"
 #include "operations.hpp"
 #include "process.hpp"
+#include "replay.hpp"
 #include "utils.hpp"
 #include "shm.hpp"
 #include "stats.hpp"
@@ -311,9 +312,11 @@ int runOneTransaction(Transaction& tx,
                       WorkflowStatistics& stats,
                       ByteString& key1,
                       ByteString& key2,
-                      ByteString& val) {
+                      ByteString& val,
+                      std::optional<timepoint_t> intended_start = std::nullopt) {
 	const auto do_sample = (stats.getOpCount(OP_TRANSACTION) % args.sampling) == 0;
-	auto watch_tx = Stopwatch(StartAtCtor{});
+	// In open-loop mode the transaction latency includes the time spent waiting behind earlier transactions
+	auto watch_tx = intended_start ? Stopwatch(*intended_start) : Stopwatch(StartAtCtor{});
 	auto watch_op = Stopwatch{};
 
 	auto op_iter = getOpBegin(args);
@@ -413,6 +416,67 @@ transaction_begin:
 	return 0;
 }
 
+bool createTempDataStore(std::string const& dirname) {
+	const auto rc = mkdir(dirname.c_str(), S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH);
+	if (rc < 0 && errno != EEXIST) {
+		logr.error("mkdir {}: {}", dirname, strerror(errno));
+		return false;
+	}
+	return true;
+}
+
+std::string getLatencyWindowFilename(std::string_view dirname, int process_idx, int thread_id) {
+	return fmt::format("{}/{}_{}_windows", dirname, process_idx + 1, thread_id + 1);
+}
+
+// Appends one line per --latency_window seconds to a worker thread's file, holding the latency sketch of every
+// operation for just the samples taken in that window. Windows are numbered by steady_clock time, so that the same
+// window of every thread and process can be merged in the report.
+class LatencyWindowWriter {
+	Arguments const& args;
+	std::ofstream out;
+	int64_t window{ -1 };
+	WorkflowStatistics window_begin;
+
+	int64_t windowOf(timepoint_t t) const {
+		return toIntegerSeconds(t.time_since_epoch()) / static_cast<uint64_t>(args.latency_window);
+	}
+
+	void write(WorkflowStatistics const& stats) {
+		rapidjson::StringBuffer ss;
+		rapidjson::Writer<rapidjson::StringBuffer> writer(ss);
+		writer.StartObject();
+		writer.String("window");
+		writer.Int64(window);
+		for (auto op = 0; op < MAX_OP; op++) {
+			if (args.txnspec.ops[op][OP_COUNT] > 0 || isAbstractOp(op)) {
+				auto sketch = stats.sketchSince(window_begin, op);
+				if (sketch.getPopulationSize() > 0) {
+					writer.String(getOpName(op));
+					sketch.serialize(writer);
+				}
+			}
+		}
+		writer.EndObject();
+		out << ss.GetString() << '\n';
+	}
+
+public:
+	LatencyWindowWriter(Arguments const& args, std::string const& filename) : args(args), out(filename) {}
+
+	// Called after each transaction, and with last set once the workload is done
+	void update(WorkflowStatistics const& stats, bool last = false) {
+		const auto now = windowOf(steady_clock::now());
+		if (window >= 0 && (now != window || last)) {
+			write(stats);
+		}
+		if (window != now) {
+			window = now;
+			window_begin = stats;
+		}
+	}
+};
+
 int runWorkload(Database db,
                 Arguments const& args,
                 int const thread_tps,
@@ -420,6 +484,7 @@ int runWorkload(Database db,
                 int const thread_iters,
                 std::atomic<int> const& signal,
                 WorkflowStatistics& workflow_stats,
+                LatencyWindowWriter* latency_windows,
                 int const dotrace,
                 int const dotagging) {
 	auto traceid = std::string{};
@@ -439,6 +504,10 @@ int runWorkload(Database db,
 	auto time_prev = steady_clock::now();
 	auto time_last_trace = time_prev;
 
+	// In open-loop mode transactions arrive at a fixed rate whether or not earlier ones have finished, and each is
+	// timed from its scheduled arrival, so queueing delay at saturation shows up as latency instead of lower TPS.
+	auto next_arrival = time_prev;
+
 	auto rc = 0;
 	auto xacts = 0;
 	auto total_xacts = int64_t{};
@@ -455,7 +524,20 @@ int runWorkload(Database db,
 
 	/* main transaction loop */
 	while (1) {
-		if ((thread_tps > 0 /* iff throttling on */) && (xacts >= current_tps)) {
+		auto intended_start = std::optional<timepoint_t>{};
+		if (args.open_loop) {
+			current_tps = static_cast<int>(thread_tps * throttle_factor.load());
+			if (current_tps > 0) {
+				intended_start = next_arrival;
+				const auto interval = std::chrono::duration<double>(1.0 / current_tps);
+				next_arrival += std::chrono::duration_cast<timediff_t>(interval);
+				std::this_thread::sleep_until(*intended_start);
+			} else {
+				/* no arrivals at this rate; start the schedule afresh once the rate picks up */
+				usleep(1000);
+				next_arrival = steady_clock::now();
+			}
+		} else if ((thread_tps > 0 /* iff throttling on */) && (xacts >= current_tps)) {
 			/* throttle on */
 			auto time_now = steady_clock::now();
 			while (toDoubleSeconds(time_now - time_prev) < 1.0) {
@@ -509,10 +591,13 @@ int runWorkload(Database db,
 				}
 			}
 
-			rc = runOneTransaction(tx, token, args, workflow_stats, key1, key2, val);
+			rc = runOneTransaction(tx, token, args, workflow_stats, key1, key2, val, intended_start);
 			if (rc) {
 				logr.warn("runOneTransaction failed ({})", rc);
 			}
+			if (latency_windows) {
+				latency_windows->update(workflow_stats);
+			}
 
 			xacts++;
 			total_xacts++;
@@ -528,9 +613,128 @@ int runWorkload(Database db,
 			break;
 		}
 	}
+	if (latency_windows) {
+		latency_windows->update(workflow_stats, true /* last */);
+	}
 	return rc;
 }
 
+// Runs the operations of one captured transaction once, mapping captured keys onto mako's rows by hash, so that a
+// hot key in the capture is a hot row here. Failed captured operations are skipped, since the client's retry of them
+// was captured as another transaction.
+FutureRC replayTransaction(Transaction& tx,
+                           Arguments const& args,
+                           CapturedTransaction const& captured,
+                           WorkflowStatistics& stats,
+                           bool do_sample,
+                           ByteString& key1,
+                           ByteString& key2,
+                           ByteString& val) {
+	const auto row_bytes = args.key_length + args.value_length;
+	for (const auto& captured_op : captured.ops) {
+		auto watch_op = Stopwatch(StartAtCtor{});
+		auto f = Future{};
+		auto op = 0;
+		switch (captured_op.type) {
+		case CapturedOp::GET_VERSION:
+			op = OP_GETREADVERSION;
+			f = tx.getReadVersion().eraseType();
+			break;
+		case CapturedOp::GET:
+			op = OP_GET;
+			genKey(key1.data(), KEY_PREFIX, args, captured_op.key_hash % args.rows);
+			f = tx.get(key1, false /*snapshot*/).eraseType();
+			break;
+		case CapturedOp::GET_RANGE: {
+			// read as many rows as the captured range returned bytes
+			op = OP_GETRANGE;
+			const auto begin = static_cast<int>(captured_op.key_hash % args.rows);
+			const auto rows = std::max(1, captured_op.bytes / row_bytes);
+			genKey(key1.data(), KEY_PREFIX, args, begin);
+			genKey(key2.data(), KEY_PREFIX, args, std::min(begin + rows - 1, args.rows - 1));
+			f = tx.getRange(key_select::firstGreaterOrEqual(key1),
+			                key_select::lastLessOrEqual(key2, 1),
+			                0 /*limit*/,
+			                0 /*target_bytes*/,
+			                args.streaming_mode,
+			                0 /*iteration*/,
+			                false /*snapshot*/,
+			                false /*reverse*/)
+			        .eraseType();
+			break;
+		}
+		case CapturedOp::COMMIT: {
+			// spread the captured commit bytes evenly over its mutations
+			op = OP_COMMIT;
+			const auto mutations = std::max(1, captured_op.count);
+			val.resize(std::max(0, captured_op.bytes / mutations - args.key_length));
+			for (const auto key_hash : captured_op.mutation_key_hashes) {
+				genKey(key1.data(), KEY_PREFIX, args, key_hash % args.rows);
+				randomString(val.data(), val.size());
+				tx.set(key1, val);
+			}
+			f = tx.commit().eraseType();
+			break;
+		}
+		default:
+			continue;
+		}
+		const auto rc = waitAndHandleError(tx, f, opTable[op].name(), args.isAnyTimeoutEnabled());
+		updateErrorStatsRunMode(stats, f.error(), op);
+		if (rc != FutureRC::OK)
+			return rc;
+		if (do_sample)
+			stats.addLatency(op, watch_op.stop().diff());
+		stats.incrOpCount(op);
+	}
+	return FutureRC::OK;
+}
+
+// Replays this worker's share of --replay_file, starting each transaction at its captured start time divided by
+// --replay_speed, and timing it from then whether or not earlier transactions have finished
+int runReplay(Database db,
+              Arguments const& args,
+              int const worker_idx,
+              int const num_workers,
+              std::atomic<int> const& signal,
+              WorkflowStatistics& stats) {
+	const auto transactions = readCaptureFile(args.replay_file, worker_idx, num_workers);
+	if (!transactions)
+		return -1;
+
+	auto key1 = ByteString{};
+	key1.resize(args.key_length);
+	auto key2 = ByteString{};
+	key2.resize(args.key_length);
+	auto val = ByteString{};
+
+	std::optional<std::vector<fdb::Tenant>> tenants = args.prepareTenants(db);
+
+	const auto replay_start = steady_clock::now();
+	for (const auto& captured : *transactions) {
+		const auto offset = std::chrono::duration<double>(captured.start_time / args.replay_speed);
+		const auto intended_start = replay_start + std::chrono::duration_cast<timediff_t>(offset);
+		std::this_thread::sleep_until(intended_start);
+		if (signal.load() == SIGNAL_RED)
+			break;
+
+		const auto do_sample = (stats.getOpCount(OP_TRANSACTION) % args.sampling) == 0;
+		auto watch_tx = Stopwatch(intended_start);
+		auto [tx, token] = createNewTransaction(db, args, -1, tenants);
+		setTransactionTimeoutIfEnabled(args, tx);
+		auto rc = FutureRC::RETRY;
+		while (rc == FutureRC::RETRY) {
+			rc = replayTransaction(tx, args, captured, stats, do_sample, key1, key2, val);
+		}
+		if (rc == FutureRC::ABORT)
+			continue;
+		if (do_sample)
+			stats.addLatency(OP_TRANSACTION, watch_tx.stop().diff());
+		stats.incrOpCount(OP_TRANSACTION);
+	}
+	return 0;
+}
+
 std::string getStatsFilename(std::string_view dirname, int process_idx, int thread_id, int op) {
 
 	return fmt::format("{}/{}_{}_{}", dirname, process_idx + 1, thread_id + 1, opTable[op].name());
@@ -547,9 +751,7 @@ void dumpThreadSamples(Arguments const& args,
                        const WorkflowStatistics& stats,
                        bool overwrite = true) {
 	const auto dirname = fmt::format("{}{}", TEMP_DATA_STORE, parent_id);
-	const auto rc = mkdir(dirname.c_str(), S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH);
-	if (rc < 0 && errno != EEXIST) {
-		logr.error("mkdir {}: {}", dirname, strerror(errno));
+	if (!createTempDataStore(dirname)) {
 		return;
 	}
 	for (auto op = 0; op < MAX_OP; op++) {
@@ -689,9 +891,34 @@ void workerThread(const ThreadArgs& thread_args) {
 		if (rc < 0) {
 			logr.error("populate failed");
 		}
+	} else if (args.mode == MODE_RUN && args.replay_file[0] != '\0') {
+		auto rc = runReplay(database,
+		                    args,
+		                    process_idx * args.num_threads + thread_idx,
+		                    args.num_processes * args.num_threads,
+		                    signal,
+		                    workflow_stats);
+		if (rc < 0) {
+			logr.error("runReplay failed");
+		}
 	} else if (args.mode == MODE_RUN) {
-		auto rc = runWorkload(
-		    database, args, thread_tps, throttle_factor, thread_iters, signal, workflow_stats, dotrace, dotagging);
+		auto latency_windows = std::optional<LatencyWindowWriter>{};
+		if (args.latency_window > 0) {
+			const auto dirname = fmt::format("{}{}", TEMP_DATA_STORE, parent_id);
+			if (createTempDataStore(dirname)) {
+				latency_windows.emplace(args, getLatencyWindowFilename(dirname, process_idx, thread_idx));
+			}
+		}
+		auto rc = runWorkload(database,
+		                      args,
+		                      thread_tps,
+		                      throttle_factor,
+		                      thread_iters,
+		                      signal,
+		                      workflow_stats,
+		                      latency_windows ? &*latency_windows : nullptr,
+		                      dotrace,
+		                      dotagging);
 		if (rc < 0) {
 			logr.error("runWorkload failed");
 		}
@@ -885,6 +1112,11 @@ Arguments::Arguments() {
 	transaction_timeout_db = 0;
 	transaction_timeout_tx = 0;
 	num_report_files = 0;
+	open_loop = 0;
+	latency_window = 0;
+	latency_window_path[0] = '\0';
+	replay_file[0] = '\0';
+	replay_speed = 1.0;
 }
 
 int Arguments::setGlobalOptions() const {
@@ -1157,6 +1389,17 @@ void usage() {
 	printf("%-24s %s\n", "    --tpsmin=TPS", "Specify the target min TPS");
 	printf("%-24s %s\n", "    --tpsinterval=SEC", "Specify the TPS change interval (Default: 10 seconds)");
 	printf("%-24s %s\n", "    --tpschange=<sin|square|pulse>", "Specify the TPS change type (Default: sin)");
+	printf("%-24s %s\n",
+	       "    --open_loop",
+	       "Start transactions at the --tpsmax rate regardless of completions, timing each from its scheduled start");
+	printf("%-24s %s\n", "    --latency_window=SEC", "Record latency sketches for every SEC second window");
+	printf("%-24s %s\n",
+	       "    --replay_file=PATH",
+	       "Replay the transactions captured with the traffic_capture_file client knob instead of --transaction");
+	printf("%-24s %s\n", "    --replay_speed=SPEED", "Replay SPEED times faster than captured (Default: 1)");
+	printf("%-24s %s\n",
+	       "    --latency_window_path=PATH",
+	       "Write the per-window latency sketches to PATH (Default: mako_windows.json)");
 	printf("%-24s %s\n", "    --sampling=RATE", "Specify the sampling rate for latency stats");
 	printf("%-24s %s\n", "-m, --mode=MODE", "Specify the mode (build, run, clean, report)");
 	printf("%-24s %s\n", "-z, --zipf", "Use zipfian distribution instead of uniform distribution");
@@ -1259,6 +1502,10 @@ int parseArguments(int argc, char* argv[], Arguments& args) {
 			{ "authorization_private_key_pem_file", required_argument, NULL, ARG_AUTHORIZATION_PRIVATE_KEY_PEM_FILE },
 			{ "transaction_timeout_tx", required_argument, NULL, ARG_TRANSACTION_TIMEOUT_TX },
 			{ "transaction_timeout_db", required_argument, NULL, ARG_TRANSACTION_TIMEOUT_DB },
+			{ "latency_window", required_argument, NULL, ARG_LATENCY_WINDOW },
+			{ "latency_window_path", required_argument, NULL, ARG_LATENCY_WINDOW_PATH },
+			{ "replay_file", required_argument, NULL, ARG_REPLAY_FILE },
+			{ "replay_speed", required_argument, NULL, ARG_REPLAY_SPEED },
 			/* options which may or may not have an argument */
 			{ "json_report", optional_argument, NULL, ARG_JSON_REPORT },
 			{ "stats_export_path", optional_argument, NULL, ARG_EXPORT_PATH },
@@ -1273,6 +1520,7 @@ int parseArguments(int argc, char* argv[], Arguments& args) {
 			{ "disable_client_bypass", no_argument, NULL, ARG_DISABLE_CLIENT_BYPASS },
 			{ "disable_ryw", no_argument, NULL, ARG_DISABLE_RYW },
 			{ "enable_token_based_authorization", no_argument, NULL, ARG_ENABLE_TOKEN_BASED_AUTHORIZATION },
+			{ "open_loop", no_argument, NULL, ARG_OPEN_LOOP },
 			{ NULL, 0, NULL, 0 }
 		};
 
@@ -1547,6 +1795,22 @@ int parseArguments(int argc, char* argv[], Arguments& args) {
 		case ARG_ENABLE_TOKEN_BASED_AUTHORIZATION:
 			args.enable_token_based_authorization = true;
 			break;
+		case ARG_OPEN_LOOP:
+			args.open_loop = 1;
+			break;
+		case ARG_LATENCY_WINDOW:
+			args.latency_window = atoi(optarg);
+			break;
+		case ARG_REPLAY_FILE:
+			strncpy(args.replay_file, optarg, std::min(sizeof(args.replay_file), strlen(optarg) + 1));
+			break;
+		case ARG_REPLAY_SPEED:
+			args.replay_speed = atof(optarg);
+			break;
+		case ARG_LATENCY_WINDOW_PATH:
+			strncpy(
+			    args.latency_window_path, optarg, std::min(sizeof(args.latency_window_path), strlen(optarg) + 1));
+			break;
 		}
 	}
 
@@ -1554,6 +1818,18 @@ int parseArguments(int argc, char* argv[], Arguments& args) {
 		args.tpsmin = args.tpsmax;
 	}
 
+	if (args.replay_file[0] != '\0') {
+		// show the replayed operations in the stats
+		for (const auto op : { OP_GETREADVERSION, OP_GET, OP_GETRANGE, OP_COMMIT }) {
+			args.txnspec.ops[op][OP_COUNT] = 1;
+		}
+	}
+
+	if (args.latency_window > 0 && args.latency_window_path[0] == '\0') {
+		char default_file[] = "mako_windows.json";
+		strncpy(args.latency_window_path, default_file, sizeof(default_file));
+	}
+
 	return 0;
 }
 
@@ -1651,6 +1927,31 @@ int Arguments::validate() {
 		}
 	}
 
+	if (open_loop) {
+		if (mode != MODE_RUN || async_xacts > 0 || tpsmax <= 0) {
+			logr.error("--open_loop is only supported in run mode with --tpsmax|--tps and without --async_xacts");
+			return -1;
+		}
+	}
+	if (replay_file[0] != '\0') {
+		if (mode != MODE_RUN || async_xacts > 0 || seconds == 0) {
+			logr.error("--replay_file is only supported in run mode with --seconds and without --async_xacts");
+			return -1;
+		}
+		if (replay_speed <= 0) {
+			logr.error("--replay_speed must be positive");
+			return -1;
+		}
+	}
+	if (latency_window < 0) {
+		logr.error("--latency_window must be a non-negative integer");
+		return -1;
+	}
+	if (latency_window > 0 && (mode != MODE_RUN || async_xacts > 0)) {
+		logr.error("--latency_window is only supported in run mode without --async_xacts");
+		return -1;
+	}
+
 	if (mode != MODE_RUN && (transaction_timeout_db != 0 || transaction_timeout_tx != 0)) {
 		logr.error("--transaction_timeout_[tx|db] only supported in run mode");
 		return -1;
@@ -2097,6 +2398,68 @@ void loadSample(int pid_main, int op, std::vector<DDSketchMako>& data_points, in
 	}
 }
 
+// Merges the per-window latency sketches of every worker thread and writes one line per window to
+// --latency_window_path, with the window's start relative to the first window and each operation's percentiles
+void writeLatencyWindows(Arguments const& args, pid_t pid_main) {
+	const auto dirname = fmt::format("{}{}", TEMP_DATA_STORE, pid_main);
+	auto windows = std::map<int64_t, std::vector<DDSketchMako>>{};
+	for (auto i = 0; i < args.num_processes; i++) {
+		for (auto j = 0; j < args.num_threads; j++) {
+			std::ifstream fp{ getLatencyWindowFilename(dirname, i, j) };
+			std::string line;
+			while (std::getline(fp, line)) {
+				rapidjson::Document doc;
+				doc.Parse(line.c_str());
+				if (doc.HasParseError()) {
+					continue;
+				}
+				auto& sketches = windows[doc["window"].GetInt64()];
+				sketches.resize(MAX_OP);
+				for (auto op = 0; op < MAX_OP; op++) {
+					if (doc.HasMember(getOpName(op))) {
+						DDSketchMako sketch;
+						sketch.deserialize(doc[getOpName(op)]);
+						sketches[op].mergeWith(sketch);
+					}
+				}
+			}
+		}
+	}
+
+	std::ofstream out(args.latency_window_path);
+	for (auto& [window, sketches] : windows) {
+		rapidjson::StringBuffer ss;
+		rapidjson::Writer<rapidjson::StringBuffer> writer(ss);
+		writer.StartObject();
+		writer.String("start");
+		writer.Int64((window - windows.begin()->first) * args.latency_window);
+		writer.String("seconds");
+		writer.Int(args.latency_window);
+		for (auto op = 0; op < MAX_OP; op++) {
+			auto& sketch = sketches[op];
+			if (sketch.getPopulationSize() == 0) {
+				continue;
+			}
+			writer.String(getOpName(op));
+			writer.StartObject();
+			writer.String("samples");
+			writer.Uint64(sketch.getPopulationSize());
+			for (auto [name, quantile] : { std::pair{ "p50", 0.5 },
+			                               std::pair{ "p90", 0.9 },
+			                               std::pair{ "p99", 0.99 },
+			                               std::pair{ "p99.9", 0.999 } }) {
+				writer.String(name);
+				writer.Uint64(sketch.percentile(quantile));
+			}
+			writer.String("sketch");
+			sketch.serialize(writer);
+			writer.EndObject();
+		}
+		writer.EndObject();
+		out << ss.GetString() << '\n';
+	}
+}
+
 void printReport(Arguments const& args,
                  WorkflowStatistics const* worker_stats,
                  ThreadStatistics const* thread_stats,
@@ -2317,6 +2680,10 @@ void printReport(Arguments const& args,
 		f << final_worker_stats;
 	}
 
+	if (args.latency_window > 0) {
+		writeLatencyWindows(args, pid_main);
+	}
+
 	const auto command_remove = fmt::format("rm -rf {}{}", TEMP_DATA_STORE, pid_main);
 	if (auto rc = system(command_remove.c_str())) {
 		logr.error("Command {} returned {}", command_remove, rc);
@@ -91,6 +91,11 @@ enum ArgKind {
 	ARG_ENABLE_TOKEN_BASED_AUTHORIZATION,
 	ARG_TRANSACTION_TIMEOUT_TX,
 	ARG_TRANSACTION_TIMEOUT_DB,
+	ARG_OPEN_LOOP,
+	ARG_LATENCY_WINDOW,
+	ARG_LATENCY_WINDOW_PATH,
+	ARG_REPLAY_FILE,
+	ARG_REPLAY_SPEED,
 };
 
 constexpr const int OP_COUNT = 0;
@@ -213,6 +218,11 @@ struct Arguments {
 	std::vector<int64_t> tenant_ids; // maps tenant index to tenant id for signing tokens
 	int transaction_timeout_db;
 	int transaction_timeout_tx;
+	int open_loop;
+	int latency_window;
+	char latency_window_path[PATH_MAX];
+	char replay_file[PATH_MAX];
+	double replay_speed;
 };
 
 // helper functions
@@ -0,0 +1,143 @@
+/*
+ * replay.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include "logger.hpp"
+#include "replay.hpp"
+
+extern thread_local mako::Logger logr;
+
+namespace mako {
+
+namespace {
+
+constexpr const uint64_t CAPTURE_MAGIC = 0x50414354434246ULL; // "FBCTCAP"
+constexpr const uint32_t CAPTURE_FORMAT_VERSION = 1;
+
+// Reads the little endian fields written by flow's BinaryWriter(Unversioned()), where a vector is a uint32_t count
+// followed by its elements
+class CaptureReader {
+	const char* pos;
+	const char* end;
+
+public:
+	CaptureReader(const char* begin, const char* end) noexcept : pos(begin), end(end) {}
+
+	bool done() const noexcept { return pos == end; }
+
+	template <class T>
+	bool read(T& out) noexcept {
+		if (end - pos < static_cast<std::ptrdiff_t>(sizeof(T)))
+			return false;
+		memcpy(&out, pos, sizeof(T));
+		pos += sizeof(T);
+		return true;
+	}
+
+	bool read(CapturedOp& op) {
+		auto num_mutations = uint32_t{};
+		if (!read(op.type) || !read(op.start) || !read(op.latency) || !read(op.key_hash) || !read(op.end_key_hash) ||
+		    !read(op.bytes) || !read(op.count) || !read(num_mutations))
+			return false;
+		op.mutation_key_hashes.resize(num_mutations);
+		for (auto& hash : op.mutation_key_hashes) {
+			if (!read(hash))
+				return false;
+		}
+		return true;
+	}
+
+	bool read(CapturedTransaction& tx) {
+		auto num_ops = uint32_t{};
+		if (!read(tx.start_time) || !read(num_ops))
+			return false;
+		tx.ops.resize(num_ops);
+		for (auto& op : tx.ops) {
+			if (!read(op))
+				return false;
+		}
+		return true;
+	}
+
+	// Splits off a reader for the next length bytes
+	std::optional<CaptureReader> record(uint32_t length) noexcept {
+		if (end - pos < static_cast<std::ptrdiff_t>(length))
+			return std::nullopt;
+		auto r = CaptureReader(pos, pos + length);
+		pos += length;
+		return r;
+	}
+};
+
+} // namespace
+
+std::optional<std::vector<CapturedTransaction>> readCaptureFile(std::string const& path,
+                                                                int worker_idx,
+                                                                int num_workers) {
+	std::ifstream f(path, std::ios::binary);
+	if (!f) {
+		logr.error("cannot open capture file {}", path);
+		return std::nullopt;
+	}
+	const auto contents = std::string(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+	auto reader = CaptureReader(contents.data(), contents.data() + contents.size());
+
+	auto magic = uint64_t{};
+	auto version = uint32_t{};
+	if (!reader.read(magic) || magic != CAPTURE_MAGIC || !reader.read(version) || version != CAPTURE_FORMAT_VERSION) {
+		logr.error("{} is not a version {} capture file", path, CAPTURE_FORMAT_VERSION);
+		return std::nullopt;
+	}
+
+	auto transactions = std::vector<CapturedTransaction>{};
+	auto first_start = std::optional<double>{};
+	for (auto i = 0; !reader.done(); i++) {
+		auto length = uint32_t{};
+		auto record = reader.read(length) ? reader.record(length) : std::nullopt;
+		if (!record) {
+			logr.warn("capture file {} ends with a partial record", path);
+			break;
+		}
+		// every worker parses the first record, which sets the time the replay starts from
+		if (i % num_workers != worker_idx && first_start)
+			continue;
+		auto tx = CapturedTransaction{};
+		if (!record->read(tx)) {
+			logr.error("capture file {} has a malformed record", path);
+			return std::nullopt;
+		}
+		if (!first_start)
+			first_start = tx.start_time;
+		tx.start_time -= *first_start;
+		if (i % num_workers == worker_idx)
+			transactions.push_back(std::move(tx));
+	}
+	// records are written as transactions finish, so they are only roughly in start order
+	std::stable_sort(
+	    transactions.begin(), transactions.end(), [](CapturedTransaction const& a, CapturedTransaction const& b) {
+		    return a.start_time < b.start_time;
+	    });
+	return transactions;
+}
+
+} // namespace mako
@@ -0,0 +1,59 @@
+/*
+ * replay.hpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MAKO_REPLAY_HPP
+#define MAKO_REPLAY_HPP
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace mako {
+
+// A transaction captured by a client with the traffic_capture_file knob set. These mirror CapturedOp and
+// CapturedTransaction in fdbclient/TrafficCapture.h, which defines the file format.
+struct CapturedOp {
+	enum Type : uint8_t { GET_VERSION, GET, GET_RANGE, COMMIT, ERROR_GET, ERROR_GET_RANGE, ERROR_COMMIT };
+
+	uint8_t type;
+	double start; // seconds since the transaction's first operation started
+	double latency;
+	uint64_t key_hash;
+	uint64_t end_key_hash;
+	int32_t bytes;
+	int32_t count; // mutations of a commit, or the error code of a failed operation
+	std::vector<uint64_t> mutation_key_hashes;
+};
+
+struct CapturedTransaction {
+	double start_time; // seconds since the first transaction in the file started
+	std::vector<CapturedOp> ops;
+};
+
+// Reads every num_workers-th transaction of a capture file, starting from the worker_idx-th, so that workers can
+// split a capture between them. Returns std::nullopt if the file can't be read or isn't a capture file.
+std::optional<std::vector<CapturedTransaction>> readCaptureFile(std::string const& path,
+                                                                int worker_idx,
+                                                                int num_workers);
+
+} // namespace mako
+
+#endif /*MAKO_REPLAY_HPP*/
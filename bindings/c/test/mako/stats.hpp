@@ -87,6 +87,19 @@ public:
 			idx++;
 		}
 	}
+
+	// Removes the samples of 'earlier', a copy of this sketch taken before, leaving only the samples added since.
+	// min() and max() still cover every sample, since they can't be recovered.
+	DDSketchMako& subtract(const DDSketchMako& earlier) {
+		assert(buckets.size() == earlier.buckets.size());
+		for (size_t i = 0; i < buckets.size(); i++) {
+			buckets[i] -= earlier.buckets[i];
+		}
+		populationSize -= earlier.populationSize;
+		zeroPopulationSize -= earlier.zeroPopulationSize;
+		sum -= earlier.sum;
+		return *this;
+	}
 };
 
 class alignas(64) WorkflowStatistics {
@@ -137,6 +150,13 @@ public:
 
 	uint64_t mean(int op) const noexcept { return sketches[op].mean(); }
 
+	// Latency sketch of op holding only the samples added since 'earlier', a copy of these statistics taken before
+	DDSketchMako sketchSince(const WorkflowStatistics& earlier, int op) const {
+		auto sketch = sketches[op];
+		sketch.subtract(earlier.sketches[op]);
+		return sketch;
+	}
+
 	// with 'this' as final aggregation, factor in 'other'
 	void combine(const WorkflowStatistics& other) {
 		conflicts += other.conflicts;
@@ -102,6 +102,14 @@ void Future::cancel() {
 	return fdb_future_get_keyvalue_array(future_, out_kv, out_count, out_more);
 }
 
+[[nodiscard]] fdb_error_t KeyValueArrayFuture::get(uint8_t* buffer,
+                                                   int buffer_length,
+                                                   int* out_count,
+                                                   int* out_length,
+                                                   fdb_bool_t* out_more) {
+	return fdb_future_get_keyvalue_buffer(future_, buffer, buffer_length, out_count, out_length, out_more);
+}
+
 // MappedKeyValueArrayFuture
 
 [[nodiscard]] fdb_error_t MappedKeyValueArrayFuture::get(const FDBMappedKeyValue** out_kv,
@@ -253,6 +261,17 @@ ValueFuture Transaction::get(std::string_view key, fdb_bool_t snapshot) {
 	return ValueFuture(fdb_transaction_get(tr_, (const uint8_t*)key.data(), key.size(), snapshot));
 }
 
+KeyValueArrayFuture Transaction::get_multi(const std::vector<std::string>& keys, fdb_bool_t snapshot) {
+	std::vector<const uint8_t*> key_names;
+	std::vector<int> key_name_lengths;
+	for (const auto& key : keys) {
+		key_names.push_back((const uint8_t*)key.data());
+		key_name_lengths.push_back(key.size());
+	}
+	return KeyValueArrayFuture(
+	    fdb_transaction_get_multi(tr_, key_names.data(), key_name_lengths.data(), keys.size(), snapshot));
+}
+
 KeyFuture Transaction::get_key(const uint8_t* key_name,
                                int key_name_length,
                                fdb_bool_t or_equal,
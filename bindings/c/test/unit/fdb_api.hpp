@@ -44,6 +44,7 @@
 
 #include <string>
 #include <string_view>
+#include <vector>
 
 namespace fdb {
 
@@ -144,6 +145,11 @@ public:
 	// fdb_future_get_keyvalue_array.
 	fdb_error_t get(const FDBKeyValue** out_kv, int* out_count, fdb_bool_t* out_more);
 
+	// Call this function instead of fdb_future_get_keyvalue_buffer when using
+	// the KeyValueArrayFuture type. Its behavior is identical to
+	// fdb_future_get_keyvalue_buffer.
+	fdb_error_t get(uint8_t* buffer, int buffer_length, int* out_count, int* out_length, fdb_bool_t* out_more);
+
 private:
 	friend class Transaction;
 	KeyValueArrayFuture(FDBFuture* f) : Future(f) {}
@@ -301,6 +307,10 @@ public:
 	// Returns a future which will be set to the value of `key` in the database.
 	ValueFuture get(std::string_view key, fdb_bool_t snapshot);
 
+	// Returns a future which will be set to an FDBKeyValue array of the keys that
+	// have values, in the order they were given.
+	KeyValueArrayFuture get_multi(const std::vector<std::string>& keys, fdb_bool_t snapshot);
+
 	// Returns a future which will be set to the key in the database matching the
 	// passed key selector.
 	KeyFuture get_key(const uint8_t* key_name,
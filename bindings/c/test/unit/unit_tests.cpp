@@ -522,6 +522,37 @@ TEST_CASE("fdb_future_get_value") {
 	}
 }
 
+TEST_CASE("fdb_database_immutable_key_prefix") {
+	std::string prefix = key("immutable/");
+	fdb_check(fdb_database_set_option(
+	    db, FDB_DB_OPTION_IMMUTABLE_KEY_PREFIX, (const uint8_t*)prefix.c_str(), prefix.size()));
+	insert_data(db, create_data({ { "immutable/foo", "bar" } }));
+
+	// The second read can be served from the client's cache, and must return the same value
+	for (int i = 0; i < 2; ++i) {
+		fdb::Transaction tr(db);
+		while (1) {
+			fdb::ValueFuture f1 = tr.get(key("immutable/foo"), /* snapshot */ false);
+
+			fdb_error_t err = wait_future(f1);
+			if (err) {
+				fdb::EmptyFuture f2 = tr.on_error(err);
+				fdb_check(wait_future(f2));
+				continue;
+			}
+
+			int out_present;
+			char* val;
+			int vallen;
+			fdb_check(f1.get(&out_present, (const uint8_t**)&val, &vallen));
+
+			CHECK(out_present);
+			CHECK(std::string(val, vallen) == "bar");
+			break;
+		}
+	}
+}
+
 TEST_CASE("fdb_future_get_string_array") {
 	insert_data(db, create_data({ { "foo", "bar" } }));
 
@@ -1957,6 +1988,82 @@ TEST_CASE("fdb_transaction_get_tag_throttled_duration") {
 	}
 }
 
+TEST_CASE("fdb_transaction_get_multi") {
+	insert_data(db, create_data({ { "a", "1" }, { "b", "" }, { "d", "4" } }));
+
+	fdb::Transaction tr(db);
+	while (1) {
+		fdb::KeyValueArrayFuture f1 = tr.get_multi({ key("d"), key("c"), key("a"), key("b") }, /*snapshot*/ false);
+		fdb_error_t err = wait_future(f1);
+		if (err) {
+			fdb::EmptyFuture fOnError = tr.on_error(err);
+			fdb_check(wait_future(fOnError));
+			continue;
+		}
+
+		const FDBKeyValue* out_kv;
+		int out_count;
+		fdb_bool_t out_more;
+		fdb_check(f1.get(&out_kv, &out_count, &out_more));
+
+		std::vector<std::pair<std::string, std::string>> results;
+		for (int i = 0; i < out_count; ++i) {
+			results.emplace_back(std::string((const char*)out_kv[i].key, out_kv[i].key_length),
+			                     std::string((const char*)out_kv[i].value, out_kv[i].value_length));
+		}
+		CHECK(results == std::vector<std::pair<std::string, std::string>>{
+		                     { key("d"), "4" }, { key("a"), "1" }, { key("b"), "" } });
+		break;
+	}
+}
+
+TEST_CASE("fdb_future_get_keyvalue_buffer") {
+	insert_data(db, create_data({ { "a", "1" }, { "b", "22" }, { "c", "333" } }));
+
+	fdb::Transaction tr(db);
+	while (1) {
+		fdb::KeyValueArrayFuture f1 = tr.get_multi({ key("a"), key("b"), key("c") }, /*snapshot*/ false);
+		fdb_error_t err = wait_future(f1);
+		if (err) {
+			fdb::EmptyFuture fOnError = tr.on_error(err);
+			fdb_check(wait_future(fOnError));
+			continue;
+		}
+
+		auto decode = [](const uint8_t* buffer, int count) {
+			std::vector<std::pair<std::string, std::string>> results;
+			for (int i = 0; i < count; ++i) {
+				int32_t keyLength, valueLength;
+				memcpy(&keyLength, buffer, sizeof(keyLength));
+				memcpy(&valueLength, buffer + sizeof(keyLength), sizeof(valueLength));
+				buffer += sizeof(keyLength) + sizeof(valueLength);
+				results.emplace_back(std::string((const char*)buffer, keyLength),
+				                     std::string((const char*)buffer + keyLength, valueLength));
+				buffer += keyLength + valueLength;
+			}
+			return results;
+		};
+
+		uint8_t buffer[1024];
+		int out_count;
+		int out_length;
+		fdb_bool_t out_more;
+		fdb_check(f1.get(buffer, sizeof(buffer), &out_count, &out_length, &out_more));
+		CHECK(!out_more);
+		CHECK(decode(buffer, out_count) == std::vector<std::pair<std::string, std::string>>{
+		                                       { key("a"), "1" }, { key("b"), "22" }, { key("c"), "333" } });
+
+		// Only the first pair fits, so the rest are reported as more
+		int firstLength = 8 + key("a").size() + 1;
+		fdb_check(f1.get(buffer, firstLength + 1, &out_count, &out_length, &out_more));
+		CHECK(out_count == 1);
+		CHECK(out_length == firstLength);
+		CHECK(out_more);
+		CHECK(decode(buffer, out_count) == std::vector<std::pair<std::string, std::string>>{ { key("a"), "1" } });
+		break;
+	}
+}
+
 TEST_CASE("fdb_transaction_get_total_cost") {
 	fdb::Transaction tr(db);
 	while (1) {
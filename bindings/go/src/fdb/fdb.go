@@ -47,6 +47,11 @@ func unlockMutex(p unsafe.Pointer) {
 	m.Unlock()
 }
 
+//export batchFutureReady
+func batchFutureReady(id C.uintptr_t) {
+	notifyBatchFutureReady(uintptr(id))
+}
+
 // A Transactor can execute a function that requires a Transaction. Functions
 // written to accept a Transactor are called transactional functions, and may be
 // called with either a Database or a Transaction.
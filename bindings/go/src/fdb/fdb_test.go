@@ -115,6 +115,33 @@ func TestReadTransactionOptions(t *testing.T) {
 	}
 }
 
+func TestGetBatch(t *testing.T) {
+	fdb.MustAPIVersion(API_VERSION)
+	db := fdb.MustOpenDefault()
+
+	keys := []fdb.KeyConvertible{fdb.Key("batch1"), fdb.Key("batch2"), fdb.Key("batch3")}
+	_, e := db.Transact(func(tr fdb.Transaction) (interface{}, error) {
+		tr.Set(keys[0], []byte("one"))
+		tr.Clear(keys[1])
+		tr.Set(keys[2], []byte("three"))
+		return nil, nil
+	})
+	if e != nil {
+		t.Fatalf("Failed to write keys: %s", e)
+	}
+
+	ret, e := db.ReadTransact(func(rtr fdb.ReadTransaction) (interface{}, error) {
+		return rtr.Snapshot().GetBatch(keys).MustGet(), nil
+	})
+	if e != nil {
+		t.Fatalf("GetBatch failed: %s", e)
+	}
+	values := ret.([][]byte)
+	if len(values) != 3 || string(values[0]) != "one" || values[1] != nil || string(values[2]) != "three" {
+		t.Errorf("GetBatch returned %q", values)
+	}
+}
+
 func ExampleTransactor() {
 	fdb.MustAPIVersion(API_VERSION)
 	db := fdb.MustOpenDefault()
@@ -36,11 +36,54 @@ package fdb
 //  void go_set_callback(void* f, void* m) {
 //      fdb_future_set_callback(f, (FDBCallback)&go_callback, m);
 //  }
+//
+//  extern void batchFutureReady(uintptr_t);
+//
+//  void go_batch_callback(FDBFuture* f, void* b) {
+//      batchFutureReady((uintptr_t)b);
+//  }
+//
+//  void go_transaction_get_batch(FDBTransaction* tr, const uint8_t* keys, const int* lengths, int count,
+//                                fdb_bool_t snapshot, FDBFuture** futures, uintptr_t batch) {
+//      for (int i = 0; i < count; i++) {
+//          futures[i] = fdb_transaction_get(tr, keys, lengths[i], snapshot);
+//          keys += lengths[i];
+//      }
+//      for (int i = 0; i < count; i++) {
+//          fdb_future_set_callback(futures[i], (FDBCallback)&go_batch_callback, (void*)batch);
+//      }
+//  }
+//
+//  void go_future_get_values(FDBFuture** futures, int count, fdb_error_t* errors, fdb_bool_t* present,
+//                            const uint8_t** values, int* lengths) {
+//      for (int i = 0; i < count; i++) {
+//          errors[i] = fdb_future_get_value(futures[i], &present[i], &values[i], &lengths[i]);
+//      }
+//  }
+//
+//  void go_futures_release_memory(FDBFuture** futures, int count) {
+//      for (int i = 0; i < count; i++) {
+//          fdb_future_release_memory(futures[i]);
+//      }
+//  }
+//
+//  void go_futures_cancel(FDBFuture** futures, int count) {
+//      for (int i = 0; i < count; i++) {
+//          fdb_future_cancel(futures[i]);
+//      }
+//  }
+//
+//  void go_futures_destroy(FDBFuture** futures, int count) {
+//      for (int i = 0; i < count; i++) {
+//          fdb_future_destroy(futures[i]);
+//      }
+//  }
 import "C"
 
 import (
 	"runtime"
 	"sync"
+	"sync/atomic"
 	"unsafe"
 )
 
@@ -173,6 +216,165 @@ func (f *futureByteSlice) MustGet() []byte {
 	return val
 }
 
+// FutureByteSliceBatch represents the asynchronous results of reading several
+// keys at once. All of the reads are started, and later collected, with a single
+// call into the C API each, and the batch becomes ready through one shared
+// notification when the last read completes. This makes FutureByteSliceBatch
+// much cheaper than a FutureByteSlice per key when reading many keys.
+// FutureByteSliceBatch is a lightweight object that may be efficiently copied,
+// and is safe for concurrent use by multiple goroutines.
+type FutureByteSliceBatch interface {
+	// Get returns the database values of the keys, in the order the keys were
+	// given (with nil for a key that has no value), or the first error of any of
+	// the reads. The current goroutine will be blocked until all of the reads
+	// are complete.
+	Get() ([][]byte, error)
+
+	// MustGet returns the database values of the keys, in the order the keys
+	// were given (with nil for a key that has no value), or panics if any of the
+	// reads did not successfully complete. The current goroutine will be blocked
+	// until all of the reads are complete.
+	MustGet() [][]byte
+
+	Future
+}
+
+// batchNotifier counts down the reads of a batch that have yet to complete, and
+// closes ready when the last one does. It is kept in batchNotifiers, rather than
+// handed to C, so that no Go pointer is stored in C memory.
+type batchNotifier struct {
+	remaining int32
+	ready     chan struct{}
+}
+
+var (
+	batchNotifiers    sync.Map
+	nextBatchNotifier uint64
+)
+
+func notifyBatchFutureReady(id uintptr) {
+	n, ok := batchNotifiers.Load(id)
+	if !ok {
+		return
+	}
+	notifier := n.(*batchNotifier)
+	if atomic.AddInt32(&notifier.remaining, -1) == 0 {
+		batchNotifiers.Delete(id)
+		close(notifier.ready)
+	}
+}
+
+type futureByteSliceBatch struct {
+	*futureBatch
+	v [][]byte
+	e error
+	o sync.Once
+}
+
+// futureBatch owns the C futures of a batch, and destroys them all at once when
+// it is garbage collected.
+type futureBatch struct {
+	ptrs  []*C.FDBFuture
+	ready chan struct{}
+}
+
+func newFutureByteSliceBatch(tr *C.FDBTransaction, keys [][]byte, snapshot int) *futureByteSliceBatch {
+	b := &futureBatch{ptrs: make([]*C.FDBFuture, len(keys)), ready: make(chan struct{})}
+	if len(keys) == 0 {
+		close(b.ready)
+		return &futureByteSliceBatch{futureBatch: b}
+	}
+
+	// The keys are passed to C packed back to back, so that one call can start
+	// every read
+	size := 0
+	for _, key := range keys {
+		size += len(key)
+	}
+	packed := make([]byte, 0, size)
+	lengths := make([]C.int, len(keys))
+	for i, key := range keys {
+		packed = append(packed, key...)
+		lengths[i] = C.int(len(key))
+	}
+
+	id := uintptr(atomic.AddUint64(&nextBatchNotifier, 1))
+	batchNotifiers.Store(id, &batchNotifier{remaining: int32(len(keys)), ready: b.ready})
+	C.go_transaction_get_batch(tr, byteSliceToPtr(packed), &lengths[0], C.int(len(keys)),
+		C.fdb_bool_t(snapshot), &b.ptrs[0], C.uintptr_t(id))
+
+	runtime.SetFinalizer(b, func(b *futureBatch) {
+		C.go_futures_destroy(&b.ptrs[0], C.int(len(b.ptrs)))
+	})
+	return &futureByteSliceBatch{futureBatch: b}
+}
+
+func (b *futureBatch) BlockUntilReady() {
+	<-b.ready
+}
+
+func (b *futureBatch) IsReady() bool {
+	select {
+	case <-b.ready:
+		return true
+	default:
+		return false
+	}
+}
+
+func (b *futureBatch) Cancel() {
+	defer runtime.KeepAlive(b)
+	if len(b.ptrs) > 0 {
+		C.go_futures_cancel(&b.ptrs[0], C.int(len(b.ptrs)))
+	}
+}
+
+func (f *futureByteSliceBatch) Get() ([][]byte, error) {
+	f.o.Do(func() {
+		defer runtime.KeepAlive(f.futureBatch)
+
+		f.BlockUntilReady()
+
+		count := len(f.ptrs)
+		if count == 0 {
+			f.v = [][]byte{}
+			return
+		}
+
+		errors := make([]C.fdb_error_t, count)
+		present := make([]C.fdb_bool_t, count)
+		values := make([]*C.uint8_t, count)
+		lengths := make([]C.int, count)
+		C.go_future_get_values(&f.ptrs[0], C.int(count), &errors[0], &present[0], &values[0], &lengths[0])
+
+		for _, err := range errors {
+			if err != 0 {
+				f.e = Error{int(err)}
+				return
+			}
+		}
+
+		f.v = make([][]byte, count)
+		for i := range f.v {
+			if present[i] != 0 {
+				f.v[i] = C.GoBytes(unsafe.Pointer(values[i]), lengths[i])
+			}
+		}
+
+		C.go_futures_release_memory(&f.ptrs[0], C.int(count))
+	})
+
+	return f.v, f.e
+}
+
+func (f *futureByteSliceBatch) MustGet() [][]byte {
+	val, err := f.Get()
+	if err != nil {
+		panic(err)
+	}
+	return val
+}
+
 // FutureKey represents the asynchronous result of a function that returns a key
 // from a database. FutureKey is a lightweight object that may be efficiently
 // copied, and is safe for concurrent use by multiple goroutines.
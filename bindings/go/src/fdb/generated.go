@@ -367,6 +367,13 @@ func (o DatabaseOptions) SetSnapshotRywDisable() error {
 	return o.setOpt(27, nil)
 }
 
+// Declares that keys starting with the given prefix are never changed or cleared once they have been written, so that values read under the prefix can be cached by the client and returned by later reads without contacting a storage server. Reads of keys that are not yet set are not cached. Only point reads by transactions not using a tenant use the cache. This option can be set more than once to declare several prefixes.
+//
+// Parameter: key prefix
+func (o DatabaseOptions) SetImmutableKeyPrefix(param []byte) error {
+	return o.setOpt(30, param)
+}
+
 // Sets the maximum escaped length of key and value fields to be logged to the trace file via the LOG_TRANSACTION option. This sets the ``transaction_logging_max_field_length`` option of each transaction created by this database. See the transaction option description for more information.
 //
 // Parameter: Maximum length of escaped key and value fields.
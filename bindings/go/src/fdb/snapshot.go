@@ -64,6 +64,12 @@ func (s Snapshot) Get(key KeyConvertible) FutureByteSlice {
 	return s.get(key.FDBKey(), 1)
 }
 
+// GetBatch is equivalent to (Transaction).GetBatch, performed as a snapshot
+// read.
+func (s Snapshot) GetBatch(keys []KeyConvertible) FutureByteSliceBatch {
+	return s.getBatch(keys, 1)
+}
+
 // GetKey is equivalent to (Transaction).GetKey, performed as a snapshot read.
 func (s Snapshot) GetKey(sel Selectable) FutureKey {
 	return s.getKey(sel.FDBKeySelector(), 1)
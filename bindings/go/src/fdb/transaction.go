@@ -34,6 +34,7 @@ import "C"
 // with read-only transactional functions.
 type ReadTransaction interface {
 	Get(key KeyConvertible) FutureByteSlice
+	GetBatch(keys []KeyConvertible) FutureByteSliceBatch
 	GetKey(sel Selectable) FutureKey
 	GetRange(r Range, options RangeOptions) RangeResult
 	GetReadVersion() FutureInt64
@@ -260,6 +261,25 @@ func (t Transaction) Get(key KeyConvertible) FutureByteSlice {
 	return t.get(key.FDBKey(), 0)
 }
 
+func (t *transaction) getBatch(keys []KeyConvertible, snapshot int) FutureByteSliceBatch {
+	kbs := make([][]byte, len(keys))
+	for i, key := range keys {
+		kbs[i] = key.FDBKey()
+	}
+	return newFutureByteSliceBatch(t.ptr, kbs, snapshot)
+}
+
+// GetBatch returns the (future) values associated with each of the specified
+// keys. The reads are performed asynchronously and do not block the calling
+// goroutine. The future will become ready when all of the reads are complete.
+//
+// GetBatch is equivalent to calling Get for each key, but starts every read,
+// waits for them and collects their results with a constant number of calls
+// into the C API rather than several per key.
+func (t Transaction) GetBatch(keys []KeyConvertible) FutureByteSliceBatch {
+	return t.getBatch(keys, 0)
+}
+
 func (t *transaction) doGetRange(r Range, options RangeOptions, snapshot bool, iteration int) futureKeyValueArray {
 	begin, end := r.FDBRangeKeySelectors()
 	bsel := begin.FDBKeySelector()
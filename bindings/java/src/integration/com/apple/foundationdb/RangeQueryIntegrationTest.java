@@ -19,7 +19,11 @@
  */
 package com.apple.foundationdb;
 
+import java.nio.ByteBuffer;
+import java.util.ArrayList;
+import java.util.Collections;
 import java.util.Iterator;
+import java.util.List;
 import java.util.Map;
 import java.util.NavigableMap;
 import java.util.Random;
@@ -187,4 +191,54 @@ class RangeQueryIntegrationTest {
 			});
 		}
 	}
+
+	@Test
+	void rangeCursorOverMultipleBatches() throws Exception {
+		/*
+		 * Make sure that the direct cursor returns the same rows as getRange, in both directions, when the
+		 * results span several batches
+		 */
+		int numRows = 2000;
+		byte[] padding = new byte[100];
+		Map<byte[], byte[]> expectedKvs = new TreeMap<>(ByteArrayUtil.comparator());
+		try (Database db = fdb.open()) {
+			db.run(tr -> {
+				for (int i = 0; i < numRows; i++) {
+					byte[] key = String.format("cursorRow%05d", i).getBytes();
+					byte[] value = ByteArrayUtil.join(("cursorValue" + i).getBytes(), padding);
+					tr.set(key, value);
+					expectedKvs.put(key, value);
+				}
+				return null;
+			});
+
+			for (boolean reverse : new boolean[] { false, true }) {
+				List<Map.Entry<byte[], byte[]>> expected = new ArrayList<>(expectedKvs.entrySet());
+				if (reverse) {
+					Collections.reverse(expected);
+				}
+				db.run(tr -> {
+					try (DirectRangeCursor cursor =
+					         tr.getRangeCursor(KeySelector.firstGreaterOrEqual("cursor".getBytes()),
+					                           KeySelector.firstGreaterOrEqual("cursos".getBytes()), 0, reverse,
+					                           StreamingMode.ITERATOR)) {
+						for (Map.Entry<byte[], byte[]> expectedKv : expected) {
+							Assertions.assertTrue(cursor.next(), "cursor ended too early");
+							Assertions.assertArrayEquals(expectedKv.getKey(), toBytes(cursor.key()), "Incorrect key!");
+							Assertions.assertArrayEquals(expectedKv.getValue(), toBytes(cursor.value()),
+							                             "Incorrect value!");
+						}
+						Assertions.assertFalse(cursor.next(), "cursor returned too much data");
+					}
+					return null;
+				});
+			}
+		}
+	}
+
+	private static byte[] toBytes(ByteBuffer buffer) {
+		byte[] bytes = new byte[buffer.remaining()];
+		buffer.duplicate().get(bytes);
+		return bytes;
+	}
 }
@@ -67,6 +67,13 @@ class DirectBufferPool {
 		}
 	}
 
+	/**
+	 * The size of the buffers in the pool.
+	 */
+	public synchronized int getBufferCapacity() {
+		return currentBufferCapacity;
+	}
+
 	/**
 	 * Requests a {@link DirectByteBuffer} from our pool. Returns null if pool is empty.
 	 */
@@ -0,0 +1,273 @@
+/*
+ * DirectRangeCursor.java
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.apple.foundationdb;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.util.concurrent.CompletableFuture;
+
+import com.apple.foundationdb.EventKeeper.Events;
+import com.apple.foundationdb.async.AsyncUtil;
+
+/**
+ * A forward-only cursor over the results of a range read that allocates no objects per row. Each batch of results
+ *  is copied by the native client into a direct buffer from the pool managed by
+ *  {@link FDB#resizeDirectBufferPool(int, int)}, and {@link #key()} and {@link #value()} return read-only views into
+ *  that buffer. While a batch is read, the next batch is already being fetched into a second buffer.
+ *  <br><br>
+ *  A typical use is:
+ *  <pre>
+ *  try (DirectRangeCursor cursor = tr.getRangeCursor(begin, end, limit, false, StreamingMode.ITERATOR)) {
+ *      while (cursor.next()) {
+ *          process(cursor.key(), cursor.value());
+ *      }
+ *  }
+ *  </pre>
+ *  The buffers returned by {@code key()} and {@code value()} are the same objects for a whole batch and their
+ *  contents are only valid until the next call to {@link #next()} or {@link #onNext()}; copy anything that must
+ *  outlive that. The cursor must be closed to return its buffers to the pool, and it must not be used by more than
+ *  one thread at a time.
+ */
+public class DirectRangeCursor implements AutoCloseable {
+	private final FDBTransaction tr;
+	private final boolean snapshot;
+	private final boolean reverse;
+	private final boolean rowsLimited;
+	private final StreamingMode streamingMode;
+	private final EventKeeper eventKeeper;
+
+	private KeySelector begin;
+	private KeySelector end;
+	private int rowsRemaining;
+	private int iteration = 0;
+
+	// The batch being read, as [int count, int more, (int keyLength, int valueLength, key, value)...]
+	private ByteBuffer current = null;
+	private ByteBuffer keyView;
+	private ByteBuffer valueView;
+	private int count = 0;
+	private int index = 0;
+	private int offset = 0;
+
+	// The fetch of the next batch, or null if there is none
+	private CompletableFuture<ByteBuffer> fetch = null;
+	private FutureResults fetchingChunk = null;
+	private boolean closed = false;
+
+	DirectRangeCursor(FDBTransaction transaction, boolean isSnapshot, KeySelector begin, KeySelector end, int rowLimit,
+	                  boolean reverse, StreamingMode streamingMode, EventKeeper eventKeeper) {
+		this.tr = transaction;
+		this.snapshot = isSnapshot;
+		this.begin = begin;
+		this.end = end;
+		this.rowsLimited = rowLimit != 0;
+		this.rowsRemaining = rowLimit;
+		this.reverse = reverse;
+		this.streamingMode = streamingMode;
+		this.eventKeeper = eventKeeper;
+
+		startFetch();
+	}
+
+	/**
+	 * Moves to the next row, waiting for its batch if it hasn't arrived yet.
+	 *
+	 * @return {@code true} if there is a row to read, or {@code false} once the range is exhausted
+	 */
+	public boolean next() {
+		return onNext().join();
+	}
+
+	/**
+	 * Moves to the next row once it is available.
+	 *
+	 * @return a future that is set to {@code true} when there is a row to read, or to {@code false} once the range is
+	 *  exhausted
+	 */
+	public synchronized CompletableFuture<Boolean> onNext() {
+		if(closed)
+			throw new IllegalStateException("Cursor has been closed");
+
+		if(current != null && index < count) {
+			readPair();
+			return AsyncUtil.READY_TRUE;
+		}
+
+		releaseCurrent();
+		if(fetch == null) {
+			return AsyncUtil.READY_FALSE;
+		}
+		final CompletableFuture<ByteBuffer> batch = fetch;
+		return batch.thenCompose(buffer -> {
+			install(buffer);
+			return onNext();
+		});
+	}
+
+	/**
+	 * The key of the current row, as a read-only buffer from its position to its limit.
+	 *
+	 * @return the key of the row that the last call to {@link #next()} moved to
+	 */
+	public ByteBuffer key() {
+		return keyView;
+	}
+
+	/**
+	 * The value of the current row, as a read-only buffer from its position to its limit.
+	 *
+	 * @return the value of the row that the last call to {@link #next()} moved to
+	 */
+	public ByteBuffer value() {
+		return valueView;
+	}
+
+	/**
+	 * Stops any outstanding fetch and returns the cursor's buffers to the pool.
+	 */
+	@Override
+	public synchronized void close() {
+		if(closed)
+			return;
+		closed = true;
+		releaseCurrent();
+		if(fetch != null) {
+			// The buffer of an outstanding fetch goes back to the pool when the fetch completes or is cancelled
+			fetch.thenAccept(buffer -> DirectBufferPool.getInstance().add(buffer));
+			fetchingChunk.cancel(true);
+			fetch = null;
+		}
+	}
+
+	private void readPair() {
+		final int keyLength = current.getInt(offset);
+		final int valueLength = current.getInt(offset + Integer.BYTES);
+		final int keyStart = offset + 2 * Integer.BYTES;
+		final int valueStart = keyStart + keyLength;
+		offset = valueStart + valueLength;
+		index++;
+
+		keyView.clear();
+		keyView.position(keyStart).limit(valueStart);
+		valueView.clear();
+		valueView.position(valueStart).limit(offset);
+	}
+
+	// Makes a fetched batch current and starts fetching the one after it
+	private synchronized void install(ByteBuffer buffer) {
+		fetch = null;
+		fetchingChunk = null;
+		if(closed) {
+			// close() has already arranged to return the buffer
+			return;
+		}
+
+		current = buffer;
+		keyView = buffer.asReadOnlyBuffer();
+		valueView = buffer.asReadOnlyBuffer();
+		count = buffer.getInt(0);
+		final boolean more = buffer.getInt(Integer.BYTES) != 0;
+		index = 0;
+		offset = 2 * Integer.BYTES;
+		rowsRemaining -= count;
+
+		// The next batch continues after the last key of this one
+		int pairOffset = offset;
+		int lastKeyOffset = -1;
+		int lastKeyLength = 0;
+		for(int i = 0; i < count; i++) {
+			lastKeyLength = buffer.getInt(pairOffset);
+			lastKeyOffset = pairOffset + 2 * Integer.BYTES;
+			pairOffset = lastKeyOffset + lastKeyLength + buffer.getInt(pairOffset + Integer.BYTES);
+		}
+
+		if(eventKeeper != null) {
+			eventKeeper.count(Events.BYTES_FETCHED, pairOffset - offset);
+			eventKeeper.count(Events.RANGE_QUERY_RECORDS_FETCHED, count);
+		}
+
+		// An empty batch can't advance the range, so it ends it
+		if(count == 0 || !more || (rowsLimited && rowsRemaining < 1)) {
+			return;
+		}
+		byte[] lastKey = new byte[lastKeyLength];
+		ByteBuffer lastKeyView = buffer.duplicate();
+		lastKeyView.position(lastKeyOffset);
+		lastKeyView.get(lastKey);
+		if(reverse) {
+			end = KeySelector.firstGreaterOrEqual(lastKey);
+		}
+		else {
+			begin = KeySelector.firstGreaterThan(lastKey);
+		}
+		startFetch();
+	}
+
+	private synchronized void startFetch() {
+		ByteBuffer buffer = DirectBufferPool.getInstance().poll();
+		if(eventKeeper != null) {
+			eventKeeper.increment(Events.RANGE_QUERY_FETCHES);
+			eventKeeper.increment(buffer != null ? Events.RANGE_QUERY_DIRECT_BUFFER_HIT
+			                                     : Events.RANGE_QUERY_DIRECT_BUFFER_MISS);
+		}
+		if(buffer == null) {
+			buffer = ByteBuffer.allocateDirect(DirectBufferPool.getInstance().getBufferCapacity());
+		}
+		buffer.order(ByteOrder.nativeOrder());
+
+		final ByteBuffer target = buffer;
+		final CompletableFuture<ByteBuffer> promise = new CompletableFuture<>();
+		final FutureResults chunk = tr.getRange_internal(begin, end, rowsLimited ? rowsRemaining : 0, 0,
+		                                                 streamingMode.code(), ++iteration, snapshot, reverse);
+		fetch = promise;
+		fetchingChunk = chunk;
+		chunk.whenComplete((result, error) -> {
+			try {
+				if(error != null) {
+					DirectBufferPool.getInstance().add(target);
+					if(eventKeeper != null) {
+						eventKeeper.increment(Events.RANGE_QUERY_CHUNK_FAILED);
+					}
+					promise.completeExceptionally(error);
+					return;
+				}
+				chunk.getDirect(target);
+				promise.complete(target);
+			}
+			catch(Throwable t) {
+				DirectBufferPool.getInstance().add(target);
+				promise.completeExceptionally(t);
+			}
+			finally {
+				chunk.close();
+			}
+		});
+	}
+
+	private void releaseCurrent() {
+		if(current != null) {
+			DirectBufferPool.getInstance().add(current);
+			current = null;
+			keyView = null;
+			valueView = null;
+		}
+	}
+}
@@ -119,6 +119,11 @@ class FDBTransaction extends NativeObjectWrapper implements Transaction, OptionC
 			return new RangeQuery(FDBTransaction.this, true, begin, end, limit, reverse, mode, eventKeeper);
 		}
 		@Override
+		public DirectRangeCursor getRangeCursor(KeySelector begin, KeySelector end, int limit, boolean reverse,
+		                                        StreamingMode mode) {
+			return new DirectRangeCursor(FDBTransaction.this, true, begin, end, limit, reverse, mode, eventKeeper);
+		}
+		@Override
 		public AsyncIterable<KeyValue> getRange(KeySelector begin, KeySelector end,
 				int limit, boolean reverse) {
 			return getRange(begin, end, limit, reverse, StreamingMode.ITERATOR);
@@ -386,6 +391,11 @@ class FDBTransaction extends NativeObjectWrapper implements Transaction, OptionC
 		return new RangeQuery(this, false, begin, end, limit, reverse, mode, eventKeeper);
 	}
 	@Override
+	public DirectRangeCursor getRangeCursor(KeySelector begin, KeySelector end, int limit, boolean reverse,
+	                                        StreamingMode mode) {
+		return new DirectRangeCursor(this, false, begin, end, limit, reverse, mode, eventKeeper);
+	}
+	@Override
 	public AsyncIterable<KeyValue> getRange(KeySelector begin, KeySelector end,
 			int limit, boolean reverse) {
 		return getRange(begin, end, limit, reverse, StreamingMode.ITERATOR);
@@ -78,6 +78,19 @@ class FutureResults extends NativeFuture<RangeResultInfo> {
 		}
 	}
 
+	// Copies the results into buffer in the format read by DirectBufferIterator, without decoding them
+	void getDirect(ByteBuffer buffer) {
+		if (eventKeeper != null) {
+			eventKeeper.increment(Events.JNI_CALL);
+		}
+		try {
+			pointerReadLock.lock();
+			FutureResults_getDirect(getPtr(), buffer, buffer.capacity());
+		} finally {
+			pointerReadLock.unlock();
+		}
+	}
+
 	private boolean enableDirectBufferQueries = false;
 
 	private native RangeResult FutureResults_get(long cPtr) throws FDBException;
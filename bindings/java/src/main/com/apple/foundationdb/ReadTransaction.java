@@ -228,6 +228,26 @@ public interface ReadTransaction extends ReadTransactionContext {
 	AsyncIterable<KeyValue> getRange(KeySelector begin, KeySelector end,
 			int limit, boolean reverse, StreamingMode mode);
 
+	/**
+	 * Gets an ordered range of keys and values from the database as a {@link DirectRangeCursor}, which
+	 *  exposes each key and value as a view into a pooled direct buffer rather than as a {@link KeyValue}
+	 *  with its own arrays. Unlike {@link #getRange(KeySelector, KeySelector, int, boolean, StreamingMode)},
+	 *  the read starts immediately. The cursor must be closed when it is no longer needed.
+	 *
+	 * @param begin the beginning of the range (inclusive)
+	 * @param end the end of the range (exclusive)
+	 * @param limit the maximum number of results to return. Limits results to the
+	 *  <i>first</i> keys in the range. Pass {@link #ROW_LIMIT_UNLIMITED} if this query
+	 *  should not limit the number of results. If {@code reverse} is {@code true} rows
+	 *  will be limited starting at the end of the range.
+	 * @param reverse return results starting at the end of the range in reverse order.
+	 * @param mode provide a hint about how the results are to be used.
+	 *
+	 * @return a cursor over the results
+	 */
+	DirectRangeCursor getRangeCursor(KeySelector begin, KeySelector end, int limit, boolean reverse,
+	                                 StreamingMode mode);
+
 	/**
 	 * Gets an ordered range of keys and values from the database.  The begin
 	 *  and end keys are specified by {@code byte[]} arrays, with the begin
@@ -0,0 +1,453 @@
+/*
+ * _speedups.c
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Optional native implementations of the hottest paths of the Python binding. fdb.tuple and fdb.impl use them when
+ * this module can be imported, and otherwise run in pure Python.
+ *
+ * pack() and unpack() only handle the common tuple element types: None, bytes, str, int within 64 bits, bool, float
+ * and nested tuples and lists. They return NotImplemented for anything else, including malformed input, and the
+ * caller then runs the pure Python codec, which also produces the usual errors.
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <stdint.h>
+#include <string.h>
+
+#define NULL_CODE 0x00
+#define BYTES_CODE 0x01
+#define STRING_CODE 0x02
+#define NESTED_CODE 0x05
+#define INT_ZERO_CODE 0x14
+#define POS_INT_END 0x1D
+#define NEG_INT_START 0x0B
+#define DOUBLE_CODE 0x21
+#define FALSE_CODE 0x26
+#define TRUE_CODE 0x27
+
+/* The layout of FDBKeyValue in fdb_c.h */
+#pragma pack(push, 4)
+typedef struct {
+	const uint8_t* key;
+	int key_length;
+	const uint8_t* value;
+	int value_length;
+} KeyValueStruct;
+#pragma pack(pop)
+
+typedef struct {
+	char* data;
+	Py_ssize_t length;
+	Py_ssize_t capacity;
+} Buffer;
+
+static int buffer_reserve(Buffer* b, Py_ssize_t extra) {
+	if (b->length + extra <= b->capacity)
+		return 0;
+	Py_ssize_t capacity = b->capacity * 2;
+	if (capacity < b->length + extra)
+		capacity = b->length + extra;
+	char* data = PyMem_Realloc(b->data, capacity);
+	if (!data) {
+		PyErr_NoMemory();
+		return -1;
+	}
+	b->data = data;
+	b->capacity = capacity;
+	return 0;
+}
+
+static int buffer_append(Buffer* b, const char* data, Py_ssize_t length) {
+	if (buffer_reserve(b, length) < 0)
+		return -1;
+	memcpy(b->data + b->length, data, length);
+	b->length += length;
+	return 0;
+}
+
+static int buffer_append_byte(Buffer* b, uint8_t c) {
+	if (buffer_reserve(b, 1) < 0)
+		return -1;
+	b->data[b->length++] = (char)c;
+	return 0;
+}
+
+/* Appends data with each \x00 escaped as \x00\xff, followed by the \x00 terminator */
+static int buffer_append_escaped(Buffer* b, const char* data, Py_ssize_t length) {
+	for (Py_ssize_t i = 0; i < length; i++) {
+		if (buffer_append_byte(b, (uint8_t)data[i]) < 0)
+			return -1;
+		if (data[i] == 0 && buffer_append_byte(b, 0xff) < 0)
+			return -1;
+	}
+	return buffer_append_byte(b, 0x00);
+}
+
+static int byte_length(uint64_t v) {
+	int n = 0;
+	while (v) {
+		n++;
+		v >>= 8;
+	}
+	return n;
+}
+
+static int buffer_append_int(Buffer* b, long long value) {
+	if (value == 0)
+		return buffer_append_byte(b, INT_ZERO_CODE);
+	uint64_t v;
+	int n;
+	if (value > 0) {
+		v = (uint64_t)value;
+		n = byte_length(v);
+		if (buffer_append_byte(b, INT_ZERO_CODE + n) < 0)
+			return -1;
+	} else {
+		uint64_t magnitude = (uint64_t)0 - (uint64_t)value;
+		n = byte_length(magnitude);
+		/* Negative integers are stored as the ones' complement of their magnitude in n bytes */
+		v = (n == 8 ? UINT64_MAX : (((uint64_t)1 << (8 * n)) - 1)) - magnitude;
+		if (buffer_append_byte(b, INT_ZERO_CODE - n) < 0)
+			return -1;
+	}
+	for (int i = n - 1; i >= 0; i--) {
+		if (buffer_append_byte(b, (uint8_t)(v >> (8 * i))) < 0)
+			return -1;
+	}
+	return 0;
+}
+
+static int buffer_append_double(Buffer* b, double d) {
+	uint64_t bits;
+	memcpy(&bits, &d, sizeof(bits));
+	/* Flip all of the bits of negative numbers, and just the sign bit of positive ones, so that they sort */
+	bits ^= (bits >> 63) ? UINT64_MAX : ((uint64_t)1 << 63);
+	if (buffer_append_byte(b, DOUBLE_CODE) < 0)
+		return -1;
+	for (int i = 7; i >= 0; i--) {
+		if (buffer_append_byte(b, (uint8_t)(bits >> (8 * i))) < 0)
+			return -1;
+	}
+	return 0;
+}
+
+/* Returns 1 if the value was encoded, 0 if its type isn't supported, and -1 on an error */
+static int encode(Buffer* b, PyObject* value, int nested, int bools_supported) {
+	if (value == Py_None) {
+		if (buffer_append_byte(b, NULL_CODE) < 0)
+			return -1;
+		if (nested && buffer_append_byte(b, 0xff) < 0)
+			return -1;
+		return 1;
+	}
+	if (PyBytes_CheckExact(value)) {
+		if (buffer_append_byte(b, BYTES_CODE) < 0)
+			return -1;
+		return buffer_append_escaped(b, PyBytes_AS_STRING(value), PyBytes_GET_SIZE(value)) < 0 ? -1 : 1;
+	}
+	if (PyUnicode_CheckExact(value)) {
+		Py_ssize_t length;
+		const char* utf8 = PyUnicode_AsUTF8AndSize(value, &length);
+		if (!utf8) {
+			/* e.g. lone surrogates, for which the pure Python codec raises the appropriate error */
+			PyErr_Clear();
+			return 0;
+		}
+		if (buffer_append_byte(b, STRING_CODE) < 0)
+			return -1;
+		return buffer_append_escaped(b, utf8, length) < 0 ? -1 : 1;
+	}
+	if (PyBool_Check(value)) {
+		if (bools_supported)
+			return buffer_append_byte(b, value == Py_True ? TRUE_CODE : FALSE_CODE) < 0 ? -1 : 1;
+		return buffer_append_int(b, value == Py_True ? 1 : 0) < 0 ? -1 : 1;
+	}
+	if (PyLong_CheckExact(value)) {
+		int overflow;
+		long long v = PyLong_AsLongLongAndOverflow(value, &overflow);
+		if (overflow)
+			return 0;
+		if (v == -1 && PyErr_Occurred())
+			return -1;
+		return buffer_append_int(b, v) < 0 ? -1 : 1;
+	}
+	if (PyFloat_CheckExact(value)) {
+		return buffer_append_double(b, PyFloat_AS_DOUBLE(value)) < 0 ? -1 : 1;
+	}
+	if (PyTuple_CheckExact(value) || PyList_CheckExact(value)) {
+		if (buffer_append_byte(b, NESTED_CODE) < 0)
+			return -1;
+		for (Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(value); i++) {
+			int r = encode(b, PySequence_Fast_GET_ITEM(value, i), 1, bools_supported);
+			if (r <= 0)
+				return r;
+		}
+		return buffer_append_byte(b, 0x00) < 0 ? -1 : 1;
+	}
+	return 0;
+}
+
+static PyObject* speedups_pack(PyObject* self, PyObject* args) {
+	PyObject* t;
+	PyObject* prefix;
+	int bools_supported;
+	if (!PyArg_ParseTuple(args, "O!Op", &PyTuple_Type, &t, &prefix, &bools_supported))
+		return NULL;
+	if (prefix != Py_None && !PyBytes_Check(prefix))
+		Py_RETURN_NOTIMPLEMENTED;
+
+	Buffer b = { NULL, 0, 0 };
+	PyObject* result = NULL;
+	if (prefix != Py_None && buffer_append(&b, PyBytes_AS_STRING(prefix), PyBytes_GET_SIZE(prefix)) < 0)
+		goto done;
+	for (Py_ssize_t i = 0; i < PyTuple_GET_SIZE(t); i++) {
+		int r = encode(&b, PyTuple_GET_ITEM(t, i), 0, bools_supported);
+		if (r < 0)
+			goto done;
+		if (r == 0) {
+			result = Py_NotImplemented;
+			Py_INCREF(result);
+			goto done;
+		}
+	}
+	result = PyBytes_FromStringAndSize(b.data ? b.data : "", b.length);
+
+done:
+	PyMem_Free(b.data);
+	return result;
+}
+
+/* Returns the position of the \x00 that ends an escaped byte string starting at pos, or length if there is none */
+static Py_ssize_t find_terminator(const uint8_t* v, Py_ssize_t length, Py_ssize_t pos) {
+	while (pos < length) {
+		const uint8_t* zero = memchr(v + pos, 0, length - pos);
+		if (!zero)
+			return length;
+		pos = zero - v;
+		if (pos + 1 == length || v[pos + 1] != 0xff)
+			return pos;
+		pos += 2;
+	}
+	return length;
+}
+
+static PyObject* unescape(const uint8_t* v, Py_ssize_t begin, Py_ssize_t end) {
+	PyObject* result = PyBytes_FromStringAndSize(NULL, end - begin);
+	if (!result)
+		return NULL;
+	char* out = PyBytes_AS_STRING(result);
+	Py_ssize_t length = 0;
+	for (Py_ssize_t i = begin; i < end; i++) {
+		out[length++] = (char)v[i];
+		if (v[i] == 0)
+			i++;
+	}
+	if (length != end - begin && _PyBytes_Resize(&result, length) < 0)
+		return NULL;
+	return result;
+}
+
+/* The sentinel that decode() returns for input it doesn't handle */
+static PyObject unsupported_sentinel;
+#define UNSUPPORTED (&unsupported_sentinel)
+
+/* Returns a new reference, NULL on an error, or UNSUPPORTED */
+static PyObject* decode(const uint8_t* v, Py_ssize_t length, Py_ssize_t* pos, int bools_supported) {
+	Py_ssize_t p = *pos;
+	uint8_t code = v[p];
+	if (code == NULL_CODE) {
+		*pos = p + 1;
+		Py_RETURN_NONE;
+	}
+	if (code == BYTES_CODE || code == STRING_CODE) {
+		Py_ssize_t end = find_terminator(v, length, p + 1);
+		PyObject* bytes = unescape(v, p + 1, end);
+		*pos = end + 1;
+		if (!bytes || code == BYTES_CODE)
+			return bytes;
+		PyObject* s = PyUnicode_DecodeUTF8(PyBytes_AS_STRING(bytes), PyBytes_GET_SIZE(bytes), NULL);
+		Py_DECREF(bytes);
+		if (!s) {
+			PyErr_Clear();
+			return UNSUPPORTED;
+		}
+		return s;
+	}
+	if (code > NEG_INT_START && code < POS_INT_END) {
+		int n = code >= INT_ZERO_CODE ? code - INT_ZERO_CODE : INT_ZERO_CODE - code;
+		if (p + 1 + n > length)
+			return UNSUPPORTED;
+		uint64_t value = 0;
+		for (int i = 0; i < n; i++)
+			value = (value << 8) | v[p + 1 + i];
+		*pos = p + 1 + n;
+		if (code >= INT_ZERO_CODE)
+			return PyLong_FromUnsignedLongLong(value);
+		uint64_t magnitude = (n == 8 ? UINT64_MAX : (((uint64_t)1 << (8 * n)) - 1)) - value;
+		if (magnitude <= (uint64_t)INT64_MAX)
+			return PyLong_FromLongLong(-(long long)magnitude);
+		PyObject* m = PyLong_FromUnsignedLongLong(magnitude);
+		if (!m)
+			return NULL;
+		PyObject* result = PyNumber_Negative(m);
+		Py_DECREF(m);
+		return result;
+	}
+	if (code == DOUBLE_CODE) {
+		if (p + 9 > length)
+			return UNSUPPORTED;
+		uint64_t bits = 0;
+		for (int i = 0; i < 8; i++)
+			bits = (bits << 8) | v[p + 1 + i];
+		bits ^= (bits >> 63) ? ((uint64_t)1 << 63) : UINT64_MAX;
+		double d;
+		memcpy(&d, &bits, sizeof(d));
+		*pos = p + 9;
+		return PyFloat_FromDouble(d);
+	}
+	if ((code == FALSE_CODE || code == TRUE_CODE) && bools_supported) {
+		*pos = p + 1;
+		return PyBool_FromLong(code == TRUE_CODE);
+	}
+	if (code == NESTED_CODE) {
+		PyObject* items = PyList_New(0);
+		if (!items)
+			return NULL;
+		p++;
+		while (p < length) {
+			PyObject* item;
+			if (v[p] == 0x00) {
+				if (p + 1 < length && v[p + 1] == 0xff) {
+					item = Py_None;
+					Py_INCREF(item);
+					p += 2;
+				} else {
+					break;
+				}
+			} else {
+				item = decode(v, length, &p, bools_supported);
+				if (!item || item == UNSUPPORTED) {
+					Py_DECREF(items);
+					return item;
+				}
+			}
+			int r = PyList_Append(items, item);
+			Py_DECREF(item);
+			if (r < 0) {
+				Py_DECREF(items);
+				return NULL;
+			}
+		}
+		*pos = p + 1;
+		PyObject* result = PyList_AsTuple(items);
+		Py_DECREF(items);
+		return result;
+	}
+	return UNSUPPORTED;
+}
+
+static PyObject* speedups_unpack(PyObject* self, PyObject* args) {
+	Py_buffer key;
+	Py_ssize_t prefix_len;
+	int bools_supported;
+	if (!PyArg_ParseTuple(args, "y*np", &key, &prefix_len, &bools_supported))
+		return NULL;
+
+	const uint8_t* v = key.buf;
+	Py_ssize_t length = key.len;
+	PyObject* items = PyList_New(0);
+	PyObject* result = NULL;
+	if (!items)
+		goto done;
+	for (Py_ssize_t pos = prefix_len < 0 ? 0 : prefix_len; pos < length;) {
+		PyObject* item = decode(v, length, &pos, bools_supported);
+		if (!item)
+			goto done;
+		if (item == UNSUPPORTED) {
+			result = Py_NotImplemented;
+			Py_INCREF(result);
+			goto done;
+		}
+		int r = PyList_Append(items, item);
+		Py_DECREF(item);
+		if (r < 0)
+			goto done;
+	}
+	result = PyList_AsTuple(items);
+
+done:
+	Py_XDECREF(items);
+	PyBuffer_Release(&key);
+	return result;
+}
+
+static PyObject* speedups_key_value_array(PyObject* self, PyObject* args) {
+	PyObject* kv_type;
+	unsigned long long address;
+	int count;
+	if (!PyArg_ParseTuple(args, "OKi", &kv_type, &address, &count))
+		return NULL;
+
+	const KeyValueStruct* kvs = (const KeyValueStruct*)(uintptr_t)address;
+	PyObject* result = PyList_New(count);
+	if (!result)
+		return NULL;
+	for (int i = 0; i < count; i++) {
+		PyObject* key = PyBytes_FromStringAndSize((const char*)kvs[i].key, kvs[i].key_length);
+		PyObject* value = key ? PyBytes_FromStringAndSize((const char*)kvs[i].value, kvs[i].value_length) : NULL;
+		PyObject* kv = value ? PyObject_CallFunctionObjArgs(kv_type, key, value, NULL) : NULL;
+		Py_XDECREF(key);
+		Py_XDECREF(value);
+		if (!kv) {
+			Py_DECREF(result);
+			return NULL;
+		}
+		PyList_SET_ITEM(result, i, kv);
+	}
+	return result;
+}
+
+static PyMethodDef speedups_methods[] = {
+	{ "pack",
+	  speedups_pack,
+	  METH_VARARGS,
+	  "pack(t, prefix, bools_supported) -> bytes, or NotImplemented if t has an element that isn't supported" },
+	{ "unpack",
+	  speedups_unpack,
+	  METH_VARARGS,
+	  "unpack(key, prefix_len, bools_supported) -> tuple, or NotImplemented if key has an element that isn't "
+	  "supported" },
+	{ "key_value_array",
+	  speedups_key_value_array,
+	  METH_VARARGS,
+	  "key_value_array(kv_type, address, count) -> a list of kv_type(key, value) for the FDBKeyValue array at "
+	  "address" },
+	{ NULL, NULL, 0, NULL }
+};
+
+static struct PyModuleDef speedups_module = {
+	PyModuleDef_HEAD_INIT, "fdb._speedups", "Native helpers for the FoundationDB Python binding", -1, speedups_methods
+};
+
+PyMODINIT_FUNC PyInit__speedups(void) {
+	return PyModule_Create(&speedups_module);
+}
@@ -233,7 +233,15 @@ class DirectoryLayer(Directory):
         node_subspace=Subspace(rawPrefix=b"\xfe"),
         content_subspace=Subspace(),
         allow_manual_prefixes=False,
+        cache=False,
     ):
+        """If cache is true, the layer remembers the nodes that it has resolved
+        and reuses them for as long as the database's metadata version is
+        unchanged, so that repeatedly opening a directory costs no reads. Every
+        change that this module makes to a directory updates the metadata
+        version, but the cache must not be used if the directories are also
+        changed by clients that don't.
+        """
         Directory.__init__(self, self)
 
         # If specified, new automatically allocated prefixes will all fall within content_subspace
@@ -246,6 +254,11 @@ class DirectoryLayer(Directory):
         self._root_node = self._node_subspace[self._node_subspace.key()]
         self._allocator = HighContentionAllocator(self._root_node[b"hca"])
 
+        # path -> (metadata version, path of the node, prefix of the node, layer)
+        self._cache = {} if cache else None
+        # The metadata version at which the directory version was last checked
+        self._version_checked_at = None
+
     @_impl.transactional
     def create_or_open(self, tr, path, layer=None):
         """Opens the directory with the given path.
@@ -329,6 +342,9 @@ class DirectoryLayer(Directory):
             # print repr(path[:-1])
             raise ValueError("The parent directory doesn't exist.")
 
+        # Changing the metadata version first also keeps any later lookup in
+        # this transaction out of the cache
+        self._changed_metadata(tr)
         node = self._node_with_prefix(prefix)
         tr[parent_node[self.SUBDIRS][path[-1]]] = prefix
         if not layer:
@@ -416,6 +432,7 @@ class DirectoryLayer(Directory):
             raise ValueError(
                 "The parent of the destination directory does not exist. Create it first."
             )
+        self._changed_metadata(tr)
         tr[
             parent_node.subspace[self.SUBDIRS][new_path[-1]]
         ] = self._node_subspace.unpack(old_node.subspace.key())[0]
@@ -462,6 +479,7 @@ class DirectoryLayer(Directory):
                 tr, node.get_partition_subpath(), fail_on_nonexistent
             )
 
+        self._changed_metadata(tr)
         self._remove_recursive(tr, node.subspace)
         self._remove_from_parent(tr, path)
         return True
@@ -507,6 +525,11 @@ class DirectoryLayer(Directory):
     VERSION = (1, 0, 0)
 
     def _check_version(self, tr, write_access=True):
+        cache_version = None if write_access else self._cache_version(tr)
+        if cache_version is not None and cache_version == self._version_checked_at:
+            # Changing the directory version would have changed the metadata version
+            return
+
         version = tr[self._root_node[b"version"]]
 
         if not version.present():
@@ -529,8 +552,39 @@ class DirectoryLayer(Directory):
                 % (version + self.VERSION)
             )
 
+        if cache_version is not None:
+            self._version_checked_at = cache_version
+
     def _initialize_directory(self, tr):
         tr[self._root_node[b"version"]] = struct.pack("<III", *self.VERSION)
+        self._changed_metadata(tr)
+
+    METADATA_VERSION_KEY = b"\xff/metadataVersion"
+    CACHE_LIMIT = 10000
+
+    def _changed_metadata(self, tr):
+        # Invalidates the node caches of every client. The value is a
+        # versionstamp followed by its offset.
+        if fdb.get_api_version() < 610:
+            return
+        tr.set_versionstamped_value(
+            self.METADATA_VERSION_KEY, b"\x00" * 10 + struct.pack("<I", 0)
+        )
+
+    def _cache_version(self, tr):
+        # Returns the metadata version that cached nodes must match, or None if
+        # the cache can't be used by this transaction. The metadata version
+        # comes with the read version, so reading it costs no round trip.
+        if self._cache is None or fdb.get_api_version() < 610:
+            return None
+        try:
+            version = tr[self.METADATA_VERSION_KEY]
+            return bytes(version) if version.present() else b""
+        except _impl.FDBError as e:
+            # accessed_unreadable: this transaction has changed the directories itself
+            if e.code == 1036:
+                return None
+            raise
 
     def _node_containing_key(self, tr, key):
         # Right now this is only used for _is_prefix_free(), but if we add
@@ -563,6 +617,14 @@ class DirectoryLayer(Directory):
             return DirectorySubspace(self._path + path, prefix, self, layer)
 
     def _find(self, tr, path):
+        version = self._cache_version(tr)
+        if version is not None:
+            cached = self._cache.get(path)
+            if cached is not None and cached[0] == version:
+                n = _Node(self._node_with_prefix(cached[2]), cached[1], path)
+                n._layer = cached[3]
+                return n
+
         n = _Node(self._root_node, (), path)
         for i, name in enumerate(path):
             n = _Node(
@@ -571,7 +633,13 @@ class DirectoryLayer(Directory):
                 path,
             )
             if not n.exists() or n.layer(tr) == b"partition":
-                return n
+                break
+
+        if version is not None and n.exists() and path:
+            if len(self._cache) >= self.CACHE_LIMIT:
+                self._cache.clear()
+            prefix = self._node_subspace.unpack(n.subspace.key())[0]
+            self._cache[path] = (version, n.path, prefix, n._layer)
         return n
 
     def _subdir_names_and_nodes(self, tr, node):
@@ -660,7 +728,9 @@ class DirectorySubspace(Subspace, Directory):
 class DirectoryPartition(DirectorySubspace):
     def __init__(self, path, prefix, parent_directory_layer):
         directory_layer = DirectoryLayer(
-            Subspace(rawPrefix=prefix + b"\xfe"), Subspace(rawPrefix=prefix)
+            Subspace(rawPrefix=prefix + b"\xfe"),
+            Subspace(rawPrefix=prefix),
+            cache=parent_directory_layer._cache is not None,
         )
         directory_layer._path = path
         DirectorySubspace.__init__(self, path, prefix, directory_layer, b"partition")
@@ -720,7 +790,7 @@ class _Node(object):
         return self.subspace is not None
 
     def prefetch_metadata(self, tr):
-        if self.exists():
+        if self.exists() and self._layer is None:
             self.layer(tr)
 
         return self
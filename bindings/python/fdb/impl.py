@@ -35,7 +35,7 @@ import traceback
 import weakref
 import fdb
 from fdb import six
-from fdb.tuple import pack, unpack
+from fdb.tuple import pack, unpack, _speedups
 
 from fdb import fdboptions as _opts
 import types
@@ -835,6 +835,15 @@ class FutureKeyValueArray(Future):
         self.capi.fdb_future_get_keyvalue_array(
             self.fpointer, ctypes.byref(kvs), ctypes.byref(count), ctypes.byref(more)
         )
+        if _speedups is not None:
+            # Builds the KeyValues straight from the C array, without a ctypes object per row
+            return (
+                _speedups.key_value_array(
+                    KeyValue, ctypes.cast(kvs, ctypes.c_void_p).value or 0, count.value
+                ),
+                count.value,
+                more.value,
+            )
         return (
             [
                 KeyValue(
@@ -31,6 +31,12 @@ from bisect import bisect_left
 from fdb import six
 import fdb
 
+# The optional native implementation of pack() and unpack() for the common element types
+try:
+    from fdb import _speedups
+except ImportError:
+    _speedups = None
+
 _size_limits = tuple((1 << (i * 8)) - 1 for i in range(9))
 
 # Define type codes:
@@ -488,8 +494,16 @@ def _pack_maybe_with_versionstamp(t, prefix=None):
     return b"".join(bytes_list), version_pos
 
 
+def _bools_supported():
+    return not (fdb.is_api_version_selected() and fdb.get_api_version() < 500)
+
+
 # packs the specified tuple into a key
 def pack(t, prefix=None):
+    if _speedups is not None and isinstance(t, tuple):
+        res = _speedups.pack(t, prefix, _bools_supported())
+        if res is not NotImplemented:
+            return res
     res, version_pos = _pack_maybe_with_versionstamp(t, prefix)
     if version_pos >= 0:
         raise ValueError("Incomplete versionstamp included in vanilla tuple pack")
@@ -508,6 +522,10 @@ def pack_with_versionstamp(t, prefix=None):
 
 # unpacks the specified key into a tuple
 def unpack(key, prefix_len=0):
+    if _speedups is not None and isinstance(key, bytes):
+        res = _speedups.unpack(key, prefix_len, _bools_supported())
+        if res is not NotImplemented:
+            return res
     pos = prefix_len
     res = []
     while pos < len(key):
@@ -1,4 +1,4 @@
-from distutils.core import setup
+from distutils.core import setup, Extension
 
 try:
     with open("README.rst") as f:
@@ -14,6 +14,8 @@ setup(name="foundationdb",
       url="https://www.foundationdb.org",
       packages=['fdb'],
       package_data={'fdb': ["fdb/*.py"]},
+      # An optional accelerator; the binding runs in pure Python if it can't be built
+      ext_modules=[Extension('fdb._speedups', ['fdb/_speedups.c'], optional=True)],
       long_description=long_desc,
       classifiers=[
           'Development Status :: 5 - Production/Stable',
@@ -30,6 +30,7 @@ import uuid
 
 _range = range
 
+import fdb.tuple
 from fdb.tuple import pack, unpack, range, compare, SingleFloat
 from fdb import six
 
@@ -176,6 +177,34 @@ def tupleTest(N=10000):
     print("Tuple check %d OK" % N)
     return True
 
+def speedupsTest(N=10000):
+    # The native pack and unpack must agree with the pure Python ones wherever they handle a tuple
+    if fdb.tuple._speedups is None:
+        print("Native tuple codec not built, skipping")
+        return True
+
+    speedups = fdb.tuple._speedups
+    for i in _range(N):
+        t = randomTuple()
+        fast = speedups.pack(t, None, True)
+        fdb.tuple._speedups = None
+        try:
+            packed = pack(t)
+            unpacked = unpack(packed)
+        finally:
+            fdb.tuple._speedups = speedups
+        if fast is not NotImplemented and fast != packed:
+            print("Native pack differs:\n    Tuple:  %s\n    Native: %s\n    Python: %s" % (t, repr(fast), repr(packed)))
+            return False
+        fast_unpacked = speedups.unpack(packed, 0, True)
+        if fast_unpacked is not NotImplemented and repr(fast_unpacked) != repr(unpacked):
+            print("Native unpack differs:\n    Bytes:  %s\n    Native: %s\n    Python: %s" %
+                  (repr(packed), fast_unpacked, unpacked))
+            return False
+
+    print("Native tuple check %d OK" % N)
+    return True
+
 # test:
 # a = ('\x00a', -2, 'b\x01', 12345, '')
 # assert(a==fdbtuple.unpack(fdbtuple.pack(a)))
@@ -183,3 +212,4 @@ def tupleTest(N=10000):
 
 if __name__ == '__main__':
     assert tupleTest(10000)
+    assert speedupsTest(10000)
@@ -227,6 +227,44 @@ def test_get_client_status(db):
     assert status["Healthy"]
 
 
+def test_directory_cache(db):
+    node_subspace = fdb.Subspace(rawPrefix=b"\xfe\x00directory_cache_test")
+    content_subspace = fdb.Subspace(rawPrefix=b"directory_cache_test")
+    cached = fdb.DirectoryLayer(node_subspace, content_subspace, cache=True)
+    uncached = fdb.DirectoryLayer(node_subspace, content_subspace)
+    path = ("a", "b", "c")
+
+    uncached.remove_if_exists(db, ("a",))
+    created = cached.create(db, path)
+    assert cached.open(db, path).key() == created.key()
+    assert cached._cache[path][2] == created.key()
+
+    @fdb.transactional
+    def open_twice(tr):
+        first = cached.open(tr, path).key()
+        # The second open is answered from the cache
+        return first, cached.open(tr, path).key()
+
+    assert open_twice(db) == (created.key(), created.key())
+
+    # A change made through another layer invalidates the cached nodes
+    uncached.remove(db, ("a",))
+    try:
+        cached.open(db, path)
+        assert False, "Opened a removed directory"
+    except ValueError:
+        pass
+
+    @fdb.transactional
+    def create_and_open(tr):
+        # Once the transaction has changed the directories it doesn't use the cache
+        created = cached.create(tr, path)
+        return created.key() == cached.open(tr, path).key()
+
+    assert create_and_open(db)
+    uncached.remove(db, ("a",))
+
+
 def run_unit_tests(db):
     try:
         log("test_db_options")
@@ -257,6 +295,8 @@ def run_unit_tests(db):
         test_get_approximate_size(db)
         log("test_get_client_status")
         test_get_client_status(db)
+        log("test_directory_cache")
+        test_directory_cache(db)
 
         if fdb.get_api_version() >= 710:
             log("test_tenants")
@@ -50,6 +50,12 @@
 #include <algorithm>
 #include "crc32c-generated-constants.cpp"
 
+// _M_X64 is only defined by MSVC, so also use the 64 bit crc instructions and tables for gcc and clang on x86_64 and
+// aarch64. They process twice as many bytes per instruction as the 32 bit ones and produce the same checksum.
+#if defined(_M_X64) || defined(__x86_64__) || defined(__aarch64__)
+#define CRC32C_64BIT 1
+#endif
+
 // CRC32C
 #ifdef __aarch64__
 // aarch64
@@ -64,7 +70,7 @@ static inline uint32_t hwCrc32cU32(unsigned int crc, unsigned int v) {
 	asm volatile("crc32cw %w[r], %w[c], %w[v]" : [r] "=r"(ret) : [c] "r"(crc), [v] "r"(v));
 	return ret;
 }
-#ifdef _M_X64
+#ifdef CRC32C_64BIT
 static inline uint64_t hwCrc32cU64(uint64_t crc, uint64_t v) {
 	uint64_t ret;
 	asm volatile("crc32cx %w[r], %w[c], %x[v]" : [r] "=r"(ret) : [c] "r"(crc), [v] "r"(v));
@@ -76,7 +82,7 @@ static inline uint64_t hwCrc32cU64(uint64_t crc, uint64_t v) {
 // Intel
 #define hwCrc32cU8(c, v) _mm_crc32_u8(c, v)
 #define hwCrc32cU32(c, v) _mm_crc32_u32(c, v)
-#ifdef _M_X64
+#ifdef CRC32C_64BIT
 #define hwCrc32cU64(c, v) _mm_crc32_u64(c, v)
 #endif
 #endif
@@ -123,14 +129,14 @@ static inline uint64_t hwCrc32cU64(uint64_t crc, uint64_t v) {
    as is the case on Intel processors that the assembler code here is for. */
 static uint32_t append_table(uint32_t crci, const uint8_t* input, size_t length) {
 	const uint8_t* next = input;
-#ifdef _M_X64
+#ifdef CRC32C_64BIT
 	uint64_t crc;
 #else
 	uint32_t crc;
 #endif
 
 	crc = crci ^ 0xffffffff;
-#ifdef _M_X64
+#ifdef CRC32C_64BIT
 	while (length && ((uintptr_t)next & 7) != 0) {
 		crc = table[0][(crc ^ *next++) & 0xff] ^ (crc >> 8);
 		--length;
@@ -187,7 +193,7 @@ static uint32_t
 append_hw(uint32_t crc, const uint8_t* buf, size_t len) {
 	const uint8_t* next = buf;
 	const uint8_t* end;
-#ifdef _M_X64
+#ifdef CRC32C_64BIT
 	uint64_t crc0, crc1, crc2; /* need to be 64 bits for crc32q */
 #else
 	uint32_t crc0, crc1, crc2;
@@ -204,7 +210,7 @@ append_hw(uint32_t crc, const uint8_t* buf, size_t len) {
 		--len;
 	}
 
-#ifdef _M_X64
+#ifdef CRC32C_64BIT
 	/* compute the crc on sets of LONG_SHIFT*3 bytes, executing three independent crc
 	   instructions, each on LONG_SHIFT bytes -- this is optimized for the Nehalem,
 	   Westmere, Sandy Bridge, and Ivy Bridge architectures, which have a
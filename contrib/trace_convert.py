@@ -0,0 +1,160 @@
+#!/usr/bin/env python3
+#
+# trace_convert.py
+#
+# This source file is part of the FoundationDB open source project
+#
+# Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+# Converts trace files written with --trace-format msgpack (see flow/include/flow/MsgpackTraceLogFormatter.h) to the
+# json or xml trace formats, so that the existing tools can read them. Compressed blocks need the zstandard module.
+
+import argparse
+import struct
+import sys
+
+MAGIC = b"FDBTRACE-MSGPACK-1\n"
+FILTER_NONE = 0
+FILTER_ZSTD = 1
+
+
+def read_blocks(f):
+    if f.read(len(MAGIC)) != MAGIC:
+        raise ValueError("not a msgpack trace file")
+    while True:
+        header = f.read(9)
+        if len(header) < 9:
+            # A file that is still being written, or was cut off by a crash, can end with a partial block
+            return
+        raw_length, stored_length, compression = struct.unpack("<IIB", header)
+        stored = f.read(stored_length)
+        if len(stored) < stored_length:
+            return
+        if compression == FILTER_NONE:
+            raw = stored
+        elif compression == FILTER_ZSTD:
+            import zstandard
+
+            raw = zstandard.ZstdDecompressor().decompress(stored, max_output_size=raw_length)
+        else:
+            raise ValueError("unknown compression filter %d" % compression)
+        if len(raw) != raw_length:
+            raise ValueError("block decompressed to %d bytes instead of %d" % (len(raw), raw_length))
+        yield raw
+
+
+def read_length(data, pos, size):
+    return int.from_bytes(data[pos : pos + size], "big"), pos + size
+
+
+def read_string(data, pos):
+    tag = data[pos]
+    pos += 1
+    if tag & 0xE0 == 0xA0:
+        length = tag & 0x1F
+    elif tag == 0xD9:
+        length, pos = read_length(data, pos, 1)
+    elif tag == 0xDA:
+        length, pos = read_length(data, pos, 2)
+    elif tag == 0xDB:
+        length, pos = read_length(data, pos, 4)
+    else:
+        raise ValueError("expected a string at offset %d" % (pos - 1))
+    return data[pos : pos + length].decode("utf-8", errors="backslashreplace"), pos + length
+
+
+def read_events(raw):
+    pos = 0
+    while pos < len(raw):
+        tag = raw[pos]
+        pos += 1
+        if tag & 0xF0 == 0x80:
+            fields = tag & 0x0F
+        elif tag == 0xDE:
+            fields, pos = read_length(raw, pos, 2)
+        elif tag == 0xDF:
+            fields, pos = read_length(raw, pos, 4)
+        else:
+            raise ValueError("expected an event map at offset %d" % (pos - 1))
+        event = []
+        for _ in range(fields):
+            name, pos = read_string(raw, pos)
+            value, pos = read_string(raw, pos)
+            event.append((name, value))
+        yield event
+
+
+def json_string(s):
+    # The same escaping as JsonTraceLogFormatter
+    out = []
+    for c in s:
+        if c == '"':
+            out.append('\\"')
+        elif c == "\\":
+            out.append("\\\\")
+        elif c == "\n":
+            out.append("\\n")
+        elif c == "\r":
+            out.append("\\r")
+        elif c.isprintable():
+            out.append(c)
+        else:
+            out.append("\\x%02x" % (ord(c) & 0xFF))
+    return '"' + "".join(out) + '"'
+
+
+def write_json(events, out):
+    for event in events:
+        out.write("{  " + ", ".join("%s: %s" % (json_string(k), json_string(v)) for k, v in event) + " }\n")
+
+
+# The same escaping as XmlTraceLogFormatter
+XML_ESCAPES = (("&", "&amp;"), ('"', "&quot;"), ("<", "&lt;"), (">", "&gt;"), ("\r", " "), ("\n", " "), ("\0", " "))
+
+
+def xml_string(s):
+    for c, escaped in XML_ESCAPES:
+        s = s.replace(c, escaped)
+    return s
+
+
+def write_xml(events, out):
+    out.write('<?xml version="1.0"?>\r\n<Trace>\r\n')
+    for event in events:
+        out.write("<Event " + "".join('%s="%s" ' % (xml_string(k), xml_string(v)) for k, v in event) + "/>\n")
+    out.write("</Trace>\r\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert msgpack trace files to json or xml")
+    parser.add_argument("input", help="a trace file written with --trace-format msgpack")
+    parser.add_argument("--format", choices=["json", "xml"], default="json")
+    parser.add_argument("--output", help="output file (default: stdout)")
+    args = parser.parse_args()
+
+    out = open(args.output, "w") if args.output else sys.stdout
+    with open(args.input, "rb") as f:
+        events = (event for raw in read_blocks(f) for event in read_events(raw))
+        if args.format == "json":
+            write_json(events, out)
+        else:
+            write_xml(events, out)
+    if args.output:
+        out.close()
+
+
+if __name__ == "__main__":
+    main()
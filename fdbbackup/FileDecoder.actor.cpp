@@ -20,6 +20,7 @@
 
 #include <algorithm>
 #include <cstdlib>
+#include <deque>
 #include <iostream>
 #include <limits>
 #include <memory>
@@ -88,6 +89,8 @@ void printDecodeUsage() {
 	             "  --knob-KNOBNAME KNOBVALUE\n"
 	             "                 Changes a knob value. KNOBNAME should be lowercase.\n"
 	             "  -s, --save     Save a copy of downloaded files (default: not saving).\n"
+	             "  --concurrency N\n"
+	             "                 The number of blocks of a file that are read at once (default: 8).\n"
 	             "\n";
 	return;
 }
@@ -108,6 +111,7 @@ struct DecodeParams {
 	std::string prefix; // Key prefix for filtering
 	Version beginVersionFilter = 0;
 	Version endVersionFilter = std::numeric_limits<Version>::max();
+	int concurrency = 8; // blocks of a file read at once
 
 	std::vector<std::pair<std::string, std::string>> knobs;
 
@@ -152,6 +156,7 @@ struct DecodeParams {
 			s.append(", KNOB-").append(knob).append(" = ").append(value);
 		}
 		s.append(", SaveFile: ").append(save_file_locally ? "true" : "false");
+		s.append(", Concurrency: ").append(std::to_string(concurrency));
 		return s;
 	}
 
@@ -299,6 +304,14 @@ int parseDecodeCommandLine(DecodeParams* param, CSimpleOpt* args) {
 			param->save_file_locally = true;
 			break;
 
+		case OPT_CONCURRENCY:
+			param->concurrency = std::atoi(args->OptionArg());
+			if (param->concurrency < 1) {
+				std::cerr << "ERROR: invalid concurrency " << args->OptionArg() << "\n";
+				return FDB_EXIT_ERROR;
+			}
+			break;
+
 		case TLSConfig::OPT_TLS_PLUGIN:
 			args->OptionArg();
 			break;
@@ -372,7 +385,8 @@ struct VersionedMutations {
  * decoded into a list of key/value pairs, which are then decoded into batches
  * of mutations. Because a version's mutations can be split into many key/value
  * pairs, the decoding of mutation needs to look ahead to find all batches that
- * belong to the same version.
+ * belong to the same version. Up to `concurrency` blocks are read at once, and
+ * they are added in file order.
  */
 class DecodeProgress {
 	std::vector<Standalone<VectorRef<KeyValueRef>>> blocks;
@@ -380,7 +394,8 @@ class DecodeProgress {
 
 public:
 	DecodeProgress() = default;
-	DecodeProgress(const LogFile& file, bool save) : file(file), save(save) {}
+	DecodeProgress(const LogFile& file, bool save, int concurrency)
+	  : file(file), save(save), concurrency(concurrency) {}
 
 	~DecodeProgress() {
 		if (lfd != -1) {
@@ -434,9 +449,21 @@ public:
 				throw platform_error();
 			}
 		}
-		while (!self->eof) {
-			wait(readAndDecodeFile(self));
+		state std::deque<Future<Standalone<VectorRef<KeyValueRef>>>> reads;
+		state int64_t readOffset = 0;
+		loop {
+			while (reads.size() < (size_t)self->concurrency && readOffset < self->file.fileSize) {
+				int64_t len = std::min<int64_t>(self->file.blockSize, self->file.fileSize - readOffset);
+				reads.push_back(fileBackup::decodeMutationLogFileBlock(self->fd, readOffset, len));
+				readOffset += len;
+			}
+			if (reads.empty()) {
+				break;
+			}
+			wait(readAndDecodeFile(self, reads.front()));
+			reads.pop_front();
 		}
+		self->eof = true;
 		return Void();
 	}
 
@@ -448,18 +475,15 @@ public:
 		}
 	}
 
-	// Reads a file block, decodes it into key/value pairs, and stores these pairs.
-	ACTOR static Future<Void> readAndDecodeFile(DecodeProgress* self) {
+	// Waits for the read of the file block at the current offset, which decodes it into key/value pairs, and stores
+	// these pairs.
+	ACTOR static Future<Void> readAndDecodeFile(DecodeProgress* self,
+	                                            Future<Standalone<VectorRef<KeyValueRef>>> block) {
 		try {
 			state int64_t len = std::min<int64_t>(self->file.blockSize, self->file.fileSize - self->offset);
-			if (len == 0) {
-				self->eof = true;
-				return Void();
-			}
 
-			// Decode a file block into log_key and log_value chunks
-			state Standalone<VectorRef<KeyValueRef>> chunks =
-			    wait(fileBackup::decodeMutationLogFileBlock(self->fd, self->offset, len));
+			// The file block decoded into log_key and log_value chunks
+			state Standalone<VectorRef<KeyValueRef>> chunks = wait(block);
 			self->blocks.push_back(chunks);
 
 			if (self->save) {
@@ -509,6 +533,7 @@ public:
 	int64_t offset = 0;
 	bool eof = false;
 	bool save = false;
+	int concurrency = 1;
 	int lfd = -1; // local file descriptor
 };
 
@@ -518,7 +543,7 @@ ACTOR Future<Void> process_file(Reference<IBackupContainer> container, LogFile f
 		return Void();
 	}
 
-	state DecodeProgress progress(file, params.save_file_locally);
+	state DecodeProgress progress(file, params.save_file_locally, params.concurrency);
 	wait(progress.openFile(container));
 	while (true) {
 		auto batch = progress.getNextBatch();
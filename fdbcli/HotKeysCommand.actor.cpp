@@ -0,0 +1,117 @@
+/*
+ * HotKeysCommand.actor.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fmt/format.h"
+#include "fdbcli/fdbcli.actor.h"
+
+#include "fdbclient/IClientApi.h"
+#include "fdbclient/json_spirit/json_spirit_reader_template.h"
+
+#include "flow/Arena.h"
+#include "flow/FastRef.h"
+#include "flow/ThreadHelper.actor.h"
+#include "flow/actorcompiler.h" // This must be the last #include.
+
+namespace fdb_cli {
+
+const KeyRangeRef hotKeysSpecialKeyRange("\xff\xff/metrics/hot_keys/"_sr, "\xff\xff/metrics/hot_keys/\xff\xff"_sr);
+
+namespace {
+struct HotKey {
+	Key key;
+	double reads, writes;
+};
+} // namespace
+
+ACTOR Future<bool> hotKeysCommandActor(Reference<IDatabase> db, std::vector<StringRef> tokens) {
+	if (tokens.size() > 4) {
+		printUsage(tokens[0]);
+		return false;
+	}
+	state KeyRange keys = normalKeys;
+	if (tokens.size() == 2) {
+		keys = prefixRange(tokens[1]);
+	} else if (tokens.size() >= 3) {
+		if (tokens[1] >= tokens[2]) {
+			fprintf(stderr, "ERROR: BEGINKEY must be less than ENDKEY\n");
+			return false;
+		}
+		keys = KeyRangeRef(tokens[1], tokens[2]);
+	}
+	state int limit = 25;
+	if (tokens.size() == 4) {
+		int n = 0;
+		if (sscanf(tokens[3].toString().c_str(), "%d%n", &limit, &n) != 1 || n != tokens[3].size() || limit <= 0) {
+			fprintf(stderr, "ERROR: LIMIT must be a positive integer\n");
+			return false;
+		}
+	}
+
+	state Reference<ITransaction> tr = db->createTransaction();
+	loop {
+		try {
+			state ThreadFuture<RangeResult> resultFuture =
+			    tr->getRange(KeyRangeRef(keys.begin.withPrefix(hotKeysSpecialKeyRange.begin),
+			                             keys.end.withPrefix(hotKeysSpecialKeyRange.begin)),
+			                 CLIENT_KNOBS->TOO_MANY);
+			RangeResult result = wait(safeThreadFutureToFuture(resultFuture));
+
+			std::vector<HotKey> hotKeys;
+			for (auto const& kv : result) {
+				json_spirit::mValue value;
+				json_spirit::read_string(kv.value.toString(), value);
+				auto const& obj = value.get_obj();
+				hotKeys.push_back({ kv.key.removePrefix(hotKeysSpecialKeyRange.begin),
+				                    obj.at("reads_per_second").get_real(),
+				                    obj.at("writes_per_second").get_real() });
+			}
+			std::sort(hotKeys.begin(), hotKeys.end(), [](HotKey const& a, HotKey const& b) {
+				return a.reads + a.writes > b.reads + b.writes;
+			});
+			if (hotKeys.size() > static_cast<size_t>(limit)) {
+				hotKeys.resize(limit);
+			}
+
+			if (hotKeys.empty()) {
+				fmt::print("No hot keys found in range\n");
+			} else {
+				fmt::print("{:>12} {:>12}  Key\n", "Reads/s", "Writes/s");
+				for (auto const& hotKey : hotKeys) {
+					fmt::print("{:>12.1f} {:>12.1f}  `{}'\n", hotKey.reads, hotKey.writes, printable(hotKey.key));
+				}
+			}
+			return true;
+		} catch (Error& e) {
+			wait(safeThreadFutureToFuture(tr->onError(e)));
+		}
+	}
+}
+
+CommandFactory hotKeysFactory(
+    "hotkeys",
+    CommandHelp("hotkeys [BEGINKEY [ENDKEY [LIMIT]]]",
+                "show the most frequently read and written keys",
+                "Displays up to LIMIT keys that storage servers count among their most frequently read or written, "
+                "with their estimated operations per second, hottest first. Only keys between BEGINKEY (inclusive) "
+                "and ENDKEY (exclusive) are considered. If ENDKEY is omitted, then the range includes all keys "
+                "starting with BEGINKEY, and if both are omitted, all normal keys. LIMIT defaults to 25. Storage "
+                "servers track a sample of their operations, as set by the HOT_KEY_SAMPLE_RATE knob.\n\n"
+                "For information on escaping keys, type `help escaping'."));
+} // namespace fdb_cli
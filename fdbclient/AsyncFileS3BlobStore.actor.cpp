@@ -30,7 +30,44 @@ Future<int64_t> AsyncFileS3BlobStoreRead::size() const {
 	return m_size;
 }
 
+ACTOR static Future<int> readPart(Reference<AsyncFileS3BlobStoreRead> f, uint8_t* data, int length, int64_t offset) {
+	wait(f->m_concurrentReads.take());
+	state FlowLock::Releaser releaser(f->m_concurrentReads, 1);
+	int rlen = wait(f->m_bstore->readObject(f->m_bucket, f->m_object, data, length, offset));
+	return std::min(rlen, length);
+}
+
+// Splits a read larger than read_block_size into ranged GETs that run in parallel on separate connections, since a
+// single GET is limited by the throughput of one connection.
+ACTOR static Future<int> readParallel(Reference<AsyncFileS3BlobStoreRead> f,
+                                     uint8_t* data,
+                                     int length,
+                                     int64_t offset) {
+	// Clip to the end of the object so that no part asks for a range past it
+	int64_t fileSize = wait(f->size());
+	if (offset >= fileSize)
+		return 0;
+	length = std::min<int64_t>(length, fileSize - offset);
+
+	state std::vector<Future<int>> parts;
+	for (int pos = 0; pos < length; pos += f->m_bstore->knobs.read_block_size) {
+		int partLen = std::min(f->m_bstore->knobs.read_block_size, length - pos);
+		parts.push_back(readPart(f, data + pos, partLen, offset + pos));
+	}
+	wait(waitForAll(parts));
+
+	int total = 0;
+	for (auto& p : parts) {
+		total += p.get();
+	}
+	return total;
+}
+
 Future<int> AsyncFileS3BlobStoreRead::read(void* data, int length, int64_t offset) {
+	if (length > m_bstore->knobs.read_block_size && m_bstore->knobs.read_block_size > 0 &&
+	    m_bstore->knobs.concurrent_reads_per_file > 1) {
+		return readParallel(Reference<AsyncFileS3BlobStoreRead>::addRef(this), (uint8_t*)data, length, offset);
+	}
 	return m_bstore->readObject(m_bucket, m_object, data, length, offset);
 }
 
@@ -491,7 +491,8 @@ Reference<BlobCipherKey> BlobCipherKeyIdCache::insertBaseCipherKey(const Encrypt
 			    .detail("DomainId", domainId);
 #endif
 
-			// Key is already present; nothing more to do.
+			// Key is already present and is still the latest, so only its lifetime may have been extended
+			latestCipherKey->extendRefreshAndExpireAt(refreshAt, expireAt);
 			return latestCipherKey;
 		} else {
 			TraceEvent(SevInfo, "BlobCipherUpdatetBaseCipherKey")
@@ -861,6 +862,15 @@ void EncryptBlobCipherAes265Ctr::init() {
 	}
 }
 
+void EncryptBlobCipherAes265Ctr::resetIV(const uint8_t* cipherIV, const int ivLen) {
+	ASSERT_EQ(ivLen, AES_256_IV_LENGTH);
+	memcpy(&iv[0], cipherIV, ivLen);
+	// A null cipher and key keep the ones already set up in ctx, so only the counter block is reset
+	if (EVP_EncryptInit_ex(ctx, nullptr, nullptr, nullptr, iv) != 1) {
+		throw encrypt_ops_error();
+	}
+}
+
 template <class Params>
 void EncryptBlobCipherAes265Ctr::setCipherAlgoHeaderWithAuthV1(const uint8_t* ciphertext,
                                                                const int ciphertextLen,
@@ -2362,6 +2372,54 @@ void testConfigurableEncryptionSingleAuthMode(const int minDomainId) {
 	TraceEvent("TestSingleAuthTokenConfigurableEncryptionEnd").detail("Mode", authAlgoStr);
 }
 
+// validate that one encryptor given a new IV per buffer produces the same ciphertext as a fresh encryptor per buffer
+void testConfigurableEncryptionResetIV(const int minDomainId) {
+	ASSERT(CLIENT_KNOBS->ENABLE_CONFIGURABLE_ENCRYPTION);
+
+	TraceEvent("BlobCipherTestConfigurableEncryptionResetIVStart");
+
+	Reference<BlobCipherKeyCache> cipherKeyCache = BlobCipherKeyCache::getInstance();
+	Reference<BlobCipherKey> cipherKey = cipherKeyCache->getLatestCipherKey(minDomainId);
+	Reference<BlobCipherKey> headerCipherKey = cipherKeyCache->getLatestCipherKey(ENCRYPT_HEADER_DOMAIN_ID);
+
+	Arena arena;
+	EncryptBlobCipherAes265Ctr shared(cipherKey,
+	                                  headerCipherKey,
+	                                  EncryptAuthTokenMode::ENCRYPT_HEADER_AUTH_TOKEN_MODE_NONE,
+	                                  BlobCipherMetrics::TEST);
+	for (int i = 0; i < 10; i++) {
+		const int bufLen = deterministicRandom()->randomInt(1, 300);
+		uint8_t orgData[bufLen];
+		deterministicRandom()->randomBytes(&orgData[0], bufLen);
+		uint8_t iv[AES_256_IV_LENGTH];
+		deterministicRandom()->randomBytes(&iv[0], AES_256_IV_LENGTH);
+
+		shared.resetIV(&iv[0], AES_256_IV_LENGTH);
+		BlobCipherEncryptHeaderRef headerRef;
+		StringRef encryptedBuf = shared.encrypt(&orgData[0], bufLen, &headerRef, arena);
+
+		EncryptBlobCipherAes265Ctr fresh(cipherKey,
+		                                 headerCipherKey,
+		                                 iv,
+		                                 AES_256_IV_LENGTH,
+		                                 EncryptAuthTokenMode::ENCRYPT_HEADER_AUTH_TOKEN_MODE_NONE,
+		                                 BlobCipherMetrics::TEST);
+		BlobCipherEncryptHeaderRef freshHeaderRef;
+		StringRef freshBuf = fresh.encrypt(&orgData[0], bufLen, &freshHeaderRef, arena);
+		ASSERT(encryptedBuf == freshBuf);
+
+		AesCtrNoAuth noAuth = std::get<AesCtrNoAuth>(headerRef.algoHeader);
+		ASSERT_EQ(memcmp(&noAuth.v1.iv[0], &iv[0], AES_256_IV_LENGTH), 0);
+		DecryptBlobCipherAes256Ctr decryptor(
+		    cipherKey, Reference<BlobCipherKey>(), &noAuth.v1.iv[0], BlobCipherMetrics::TEST);
+		StringRef decryptedBuf = decryptor.decrypt(encryptedBuf.begin(), encryptedBuf.size(), headerRef, arena);
+		ASSERT_EQ(decryptedBuf.size(), bufLen);
+		ASSERT_EQ(memcmp(decryptedBuf.begin(), &orgData[0], bufLen), 0);
+	}
+
+	TraceEvent("BlobCipherTestConfigurableEncryptionResetIVDone");
+}
+
 void testKeyCacheCleanup(const int minDomainId, const int maxDomainId) {
 	TraceEvent("BlobCipherTestKeyCacheCleanupStart");
 
@@ -2420,6 +2478,7 @@ TEST_CASE("/blobCipher") {
 	testConfigurableEncryptionNoAuthMode(minDomainId);
 	testConfigurableEncryptionSingleAuthMode<AesCtrWithHmacParams>(minDomainId);
 	testConfigurableEncryptionSingleAuthMode<AesCtrWithCmacParams>(minDomainId);
+	testConfigurableEncryptionResetIV(minDomainId);
 	testKeyCacheCleanup(minDomainId, maxDomainId);
 
 	return Void();
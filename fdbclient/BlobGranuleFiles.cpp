@@ -40,9 +40,15 @@
 
 #include "fmt/format.h"
 
+#include <condition_variable>
 #include <cstring>
+#include <deque>
 #include <fstream> // for perf microbenchmark
+#include <functional>
+#include <future>
 #include <limits>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 #define BG_READ_DEBUG false
@@ -54,9 +60,14 @@
 // File Format stuff
 
 // Version info for file format of chunked files.
-uint16_t LATEST_BG_FORMAT_VERSION = 1;
+uint16_t LATEST_BG_FORMAT_VERSION = 2;
 uint16_t MIN_SUPPORTED_BG_FORMAT_VERSION = 1;
 
+// Files are written in the oldest format version that can represent them, so that older readers can still read them.
+// Only snapshot files with columnar chunks (see ColumnarSnapshotChunk) need version 2.
+const uint16_t ROW_BG_FORMAT_VERSION = 1;
+const uint16_t COLUMNAR_BG_FORMAT_VERSION = 2;
+
 // TODO combine with SystemData? These don't actually have to match though
 
 const uint8_t SNAPSHOT_FILE_TYPE = 'S';
@@ -620,8 +631,10 @@ struct IndexedBlobGranuleFile {
 	// Non-serialized member fields
 	StringRef fileBytes;
 
-	void init(uint8_t fType, const Optional<BlobGranuleCipherKeysCtx> cipherKeysCtx) {
-		formatVersion = LATEST_BG_FORMAT_VERSION;
+	void init(uint8_t fType,
+	          const Optional<BlobGranuleCipherKeysCtx> cipherKeysCtx,
+	          uint16_t fVersion = ROW_BG_FORMAT_VERSION) {
+		formatVersion = fVersion;
 		fileType = fType;
 		chunkStartOffset = -1;
 	}
@@ -674,11 +687,11 @@ struct IndexedBlobGranuleFile {
 		return startBlock;
 	}
 
-	// FIXME: implement some sort of iterator type interface?
-	template <class ChildType>
-	Standalone<ChildType> getChild(const ChildBlockPointerRef* childPointer,
-	                               Optional<BlobGranuleCipherKeysCtx> cipherKeysCtx,
-	                               int startOffset) {
+	// Returns the decrypted and decompressed bytes of a child block, which may point into arena or into fileBytes
+	StringRef getChildBytes(const ChildBlockPointerRef* childPointer,
+	                        Optional<BlobGranuleCipherKeysCtx> cipherKeysCtx,
+	                        int startOffset,
+	                        Arena& arena) {
 		ASSERT(childPointer != indexBlockRef.block.children.end());
 		const ChildBlockPointerRef* nextPointer = childPointer + 1;
 		ASSERT(nextPointer != indexBlockRef.block.children.end());
@@ -694,13 +707,22 @@ struct IndexedBlobGranuleFile {
 			    .detail("StartOffset", chunkStartOffset);
 		}
 
-		Arena childArena;
 		IndexBlobGranuleFileChunkRef chunkRef =
-		    IndexBlobGranuleFileChunkRef::fromBytes(cipherKeysCtx, childData, childArena);
+		    IndexBlobGranuleFileChunkRef::fromBytes(cipherKeysCtx, childData, arena);
+		return chunkRef.chunkBytes.get();
+	}
+
+	// FIXME: implement some sort of iterator type interface?
+	template <class ChildType>
+	Standalone<ChildType> getChild(const ChildBlockPointerRef* childPointer,
+	                               Optional<BlobGranuleCipherKeysCtx> cipherKeysCtx,
+	                               int startOffset) {
+		Arena childArena;
+		StringRef childBytes = getChildBytes(childPointer, cipherKeysCtx, startOffset, childArena);
 
 		// TODO implement some sort of decrypted+decompressed+deserialized cache, if this object gets reused?
 
-		BinaryReader br(chunkRef.chunkBytes.get(), IncludeVersion());
+		BinaryReader br(childBytes, IncludeVersion());
 		Standalone<ChildType> child;
 		br >> child;
 		return child;
@@ -759,6 +781,121 @@ Value serializeFileFromChunks(Standalone<IndexedBlobGranuleFile>& file,
 	return Standalone<StringRef>(StringRef(bufferStart, size), ret);
 }
 
+// A snapshot chunk stored as columns instead of as a serialized GranuleSnapshot. Keys in a chunk are sorted and usually
+// share long prefixes, so each key only stores the suffix after the prefix it shares with the previous key. The
+// fixed-width columns come first, so that decoding finds every key suffix and value with simple passes over them, and
+// values are referenced in place instead of being copied.
+//
+//   int32 count
+//   int32 keySuffixEnd[count]  end offset of each key suffix in the key bytes
+//   int32 valueEnd[count]      end offset of each value in the value bytes
+//   uint16 sharedPrefix[count] bytes each key shares with the previous key
+//   key suffix bytes
+//   value bytes
+struct ColumnarSnapshotChunk {
+	static Value encode(const GranuleSnapshot& rows) {
+		int count = rows.size();
+		std::vector<uint16_t> sharedPrefix(count);
+		int keyBytes = 0;
+		int valueBytes = 0;
+		for (int i = 0; i < count; i++) {
+			sharedPrefix[i] = i == 0 ? 0
+			                         : std::min<int>(commonPrefixLength(rows[i - 1].key, rows[i].key),
+			                                         std::numeric_limits<uint16_t>::max());
+			keyBytes += rows[i].key.size() - sharedPrefix[i];
+			valueBytes += rows[i].value.size();
+		}
+
+		Value result = makeString(sizeof(int32_t) + count * (2 * sizeof(int32_t) + sizeof(uint16_t)) + keyBytes +
+		                          valueBytes);
+		uint8_t* out = mutateString(result);
+		auto write = [&out](auto v) {
+			memcpy(out, &v, sizeof(v));
+			out += sizeof(v);
+		};
+
+		write(int32_t(count));
+		int32_t end = 0;
+		for (int i = 0; i < count; i++) {
+			end += rows[i].key.size() - sharedPrefix[i];
+			write(end);
+		}
+		end = 0;
+		for (int i = 0; i < count; i++) {
+			end += rows[i].value.size();
+			write(end);
+		}
+		for (int i = 0; i < count; i++) {
+			write(sharedPrefix[i]);
+		}
+		for (int i = 0; i < count; i++) {
+			out = rows[i].key.substr(sharedPrefix[i]).copyTo(out);
+		}
+		for (int i = 0; i < count; i++) {
+			out = rows[i].value.copyTo(out);
+		}
+		ASSERT(out == result.end());
+		return result;
+	}
+
+	// bytes must stay valid for as long as the result, and are kept alive by depending on bytesArena
+	static Standalone<GranuleSnapshot> decode(StringRef bytes, Arena& bytesArena) {
+		auto read = [](const uint8_t* column, int i, auto& v) { memcpy(&v, column + i * sizeof(v), sizeof(v)); };
+
+		int32_t count;
+		read(bytes.begin(), 0, count);
+		const uint8_t* keySuffixEnd = bytes.begin() + sizeof(int32_t);
+		const uint8_t* valueEnd = keySuffixEnd + count * sizeof(int32_t);
+		const uint8_t* sharedPrefix = valueEnd + count * sizeof(int32_t);
+		const uint8_t* keyBytes = sharedPrefix + count * sizeof(uint16_t);
+		int32_t keyBytesSize = 0;
+		if (count > 0) {
+			read(keySuffixEnd, count - 1, keyBytesSize);
+		}
+		const uint8_t* valueBytes = keyBytes + keyBytesSize;
+
+		Standalone<GranuleSnapshot> rows;
+		rows.arena().dependsOn(bytesArena);
+		rows.resize(rows.arena(), count);
+
+		int32_t begin = 0;
+		int32_t end;
+		int totalKeyBytes = 0;
+		for (int i = 0; i < count; i++) {
+			uint16_t shared;
+			read(sharedPrefix, i, shared);
+			read(keySuffixEnd, i, end);
+			totalKeyBytes += shared + end - begin;
+			begin = end;
+		}
+
+		begin = 0;
+		for (int i = 0; i < count; i++) {
+			read(valueEnd, i, end);
+			rows[i].value = StringRef(valueBytes + begin, end - begin);
+			begin = end;
+		}
+		ASSERT(valueBytes + begin == bytes.end());
+
+		// Keys are rebuilt into one allocation, since each one starts with part of the key before it
+		uint8_t* keyOut = new (rows.arena()) uint8_t[totalKeyBytes];
+		begin = 0;
+		for (int i = 0; i < count; i++) {
+			uint16_t shared;
+			read(sharedPrefix, i, shared);
+			read(keySuffixEnd, i, end);
+			uint8_t* key = keyOut;
+			if (shared > 0) {
+				keyOut = rows[i - 1].key.substr(0, shared).copyTo(keyOut);
+			}
+			keyOut = StringRef(keyBytes + begin, end - begin).copyTo(keyOut);
+			rows[i].key = StringRef(key, keyOut - key);
+			begin = end;
+		}
+		return rows;
+	}
+};
+
 // TODO: this should probably be in actor file with yields? - move writing logic to separate actor file in server?
 // TODO: optimize memory copying
 // TODO: sanity check no oversized files
@@ -767,7 +904,8 @@ Value serializeChunkedSnapshot(const Standalone<StringRef>& fileNameRef,
                                int targetChunkBytes,
                                Optional<CompressionFilter> compressFilter,
                                Optional<BlobGranuleCipherKeysCtx> cipherKeysCtx,
-                               bool isSnapshotSorted) {
+                               bool isSnapshotSorted,
+                               bool columnar) {
 
 	if (BG_ENCRYPT_COMPRESS_DEBUG) {
 		TraceEvent(SevDebug, "SerializeChunkedSnapshot")
@@ -780,7 +918,7 @@ Value serializeChunkedSnapshot(const Standalone<StringRef>& fileNameRef,
 	CODE_PROBE(cipherKeysCtx.present(), "serializing encrypted snapshot file");
 	Standalone<IndexedBlobGranuleFile> file;
 
-	file.init(SNAPSHOT_FILE_TYPE, cipherKeysCtx);
+	file.init(SNAPSHOT_FILE_TYPE, cipherKeysCtx, columnar ? COLUMNAR_BG_FORMAT_VERSION : ROW_BG_FORMAT_VERSION);
 
 	size_t currentChunkBytesEstimate = 0;
 	size_t previousChunkBytes = 0;
@@ -800,7 +938,8 @@ Value serializeChunkedSnapshot(const Standalone<StringRef>& fileNameRef,
 
 		if (currentChunkBytesEstimate >= targetChunkBytes || i == snapshot.size() - 1) {
 			Value serialized =
-			    BinaryWriter::toValue(currentChunk, IncludeVersion(ProtocolVersion::withBlobGranuleFile()));
+			    columnar ? ColumnarSnapshotChunk::encode(currentChunk)
+			             : BinaryWriter::toValue(currentChunk, IncludeVersion(ProtocolVersion::withBlobGranuleFile()));
 			Value chunkBytes =
 			    IndexBlobGranuleFileChunkRef::toBytes(cipherKeysCtx, compressFilter, serialized, file.arena());
 			chunks.push_back(chunkBytes);
@@ -874,8 +1013,14 @@ static Standalone<VectorRef<ParsedDeltaBoundaryRef>> loadSnapshotFile(
 		auto nextBlock = currentBlock;
 		nextBlock++;
 		lastBlock = (nextBlock == (file.indexBlockRef.block.children.end() - 1)) || (keyRange.end <= nextBlock->key);
-		Standalone<GranuleSnapshot> dataBlock =
-		    file.getChild<GranuleSnapshot>(currentBlock, cipherKeysCtx, file.chunkStartOffset);
+		Standalone<GranuleSnapshot> dataBlock;
+		if (file.formatVersion == COLUMNAR_BG_FORMAT_VERSION) {
+			Arena childArena;
+			StringRef childBytes = file.getChildBytes(currentBlock, cipherKeysCtx, file.chunkStartOffset, childArena);
+			dataBlock = ColumnarSnapshotChunk::decode(childBytes, childArena);
+		} else {
+			dataBlock = file.getChild<GranuleSnapshot>(currentBlock, cipherKeysCtx, file.chunkStartOffset);
+		}
 		ASSERT(!dataBlock.empty());
 		ASSERT(currentBlock->key == dataBlock.front().key);
 
@@ -1353,32 +1498,52 @@ Standalone<VectorRef<ParsedDeltaBoundaryRef>> sortMemoryDeltas(const GranuleDelt
 	return deltas;
 }
 
-// does a sorted merge of the delta streams.
-// In terms of write precedence, streams[i] < streams[i+1]
-// Handles range clears by tracking the active clears when they start
-struct MergeStreamNext {
-	KeyRef key;
-	int16_t streamIdx;
-	int dataIdx;
-};
-
-// the sort order is logically lower by key, and then higher by streamIdx
-// because a priority queue is backwards, we invert that
-struct OrderForPriorityQueue {
-	int commonPrefixLen;
-	OrderForPriorityQueue(int commonPrefixLen) : commonPrefixLen(commonPrefixLen) {}
-
-	bool operator()(MergeStreamNext const& a, MergeStreamNext const& b) const {
-		int keyCmp = a.key.compareSuffix(b.key, commonPrefixLen);
-		if (keyCmp != 0) {
-			return keyCmp > 0; // reverse
+// A tournament tree of losers over k sorted streams, identified by index. top() is the stream whose head sorts first
+// under less, and after that stream's head advances, replay() restores the tree by only replaying the matches on the
+// stream's path to the root. That is log2(k) comparisons per element with no allocation after construction, where a
+// binary heap needs about twice as many comparisons and moves whole elements on every pop and push.
+// Leaf i is node k + i, and internal node n has children 2n and 2n + 1. tree[n] holds the loser of the match at node n,
+// and tree[0] holds the overall winner.
+template <class Less>
+class LoserTree {
+public:
+	LoserTree(int k, Less less) : k(k), tree(k), less(less) {
+		ASSERT(k > 0);
+		std::vector<int> winners(2 * k);
+		for (int i = 0; i < k; i++) {
+			winners[k + i] = i;
+		}
+		for (int n = k - 1; n > 0; n--) {
+			int a = winners[2 * n];
+			int b = winners[2 * n + 1];
+			bool aWins = less(a, b);
+			winners[n] = aWins ? a : b;
+			tree[n] = aWins ? b : a;
+		}
+		tree[0] = k == 1 ? 0 : winners[1];
+	}
+
+	int top() const { return tree[0]; }
+
+	// Must be called with top() after its stream's head changed
+	void replay(int s) {
+		for (int n = (k + s) / 2; n > 0; n /= 2) {
+			if (less(tree[n], s)) {
+				std::swap(tree[n], s);
+			}
 		}
-		return a.streamIdx < b.streamIdx;
+		tree[0] = s;
 	}
-};
 
-typedef std::priority_queue<MergeStreamNext, std::vector<MergeStreamNext>, OrderForPriorityQueue> MergePQ;
+private:
+	int k;
+	std::vector<int> tree;
+	Less less;
+};
 
+// does a sorted merge of the delta streams.
+// In terms of write precedence, streams[i] < streams[i+1]
+// Handles range clears by tracking the active clears when they start
 static RangeResult mergeDeltaStreams(const BlobGranuleChunkRef& chunk,
                                      const std::vector<Standalone<VectorRef<ParsedDeltaBoundaryRef>>>& streams,
                                      const std::vector<bool> startClears,
@@ -1391,65 +1556,75 @@ static RangeResult mergeDeltaStreams(const BlobGranuleChunkRef& chunk,
 	}
 
 	int prefixLen = commonPrefixLength(chunk.keyRange.begin, chunk.keyRange.end);
+	int16_t streamCount = streams.size();
 
-	// next element for each stream
-	MergePQ next = MergePQ(OrderForPriorityQueue(prefixLen));
+	// position of the next element in each stream
+	std::vector<int> dataIdx(streamCount, 0);
 
-	// efficiently find the highest stream's active clear
-	std::set<int16_t, std::greater<int16_t>> activeClears;
+	// check if a given stream is actively clearing, and the highest stream with an active clear
+	std::vector<uint8_t> clearActive(streamCount, 0);
 	int16_t maxActiveClear = -1;
 
 	// trade off memory for cpu performance by assuming all inserts
 	RangeResult result;
 	int maxExpectedSize = 0;
 
-	// check if a given stream is actively clearing
-	bool clearActive[streams.size()];
-	for (int16_t i = 0; i < streams.size(); i++) {
+	for (int16_t i = 0; i < streamCount; i++) {
 		clearActive[i] = startClears[i];
 		if (startClears[i]) {
-			activeClears.insert(i);
 			maxActiveClear = i;
 		}
 		if (streams[i].empty()) {
 			// single clear that entirely encases partial read bounds
 			ASSERT(clearActive[i]);
 		} else {
-			MergeStreamNext item;
-			item.key = streams[i][0].key;
-			item.streamIdx = i;
-			item.dataIdx = 0;
-			next.push(item);
 			maxExpectedSize += streams[i].size();
 			result.arena().dependsOn(streams[i].arena());
 		}
 	}
 	result.reserve(result.arena(), maxExpectedSize);
 
-	std::vector<MergeStreamNext> cur;
-	cur.reserve(streams.size());
-	while (!next.empty()) {
+	// the sort order is lower by key, and then higher by streamIdx, with exhausted streams last
+	auto headLess = [&](int a, int b) {
+		if (dataIdx[a] >= streams[a].size()) {
+			return false;
+		}
+		if (dataIdx[b] >= streams[b].size()) {
+			return true;
+		}
+		int keyCmp = streams[a][dataIdx[a]].key.compareSuffix(streams[b][dataIdx[b]].key, prefixLen);
+		return keyCmp < 0 || (keyCmp == 0 && a > b);
+	};
+	LoserTree<decltype(headLess)> next(streamCount, headLess);
+
+	// (streamIdx, dataIdx) of each stream's element for the current key, highest stream first
+	std::vector<std::pair<int16_t, int>> cur;
+	cur.reserve(streamCount);
+	while (dataIdx[next.top()] < streams[next.top()].size()) {
 		cur.clear();
-		cur.push_back(next.top());
-		next.pop();
+		KeyRef key = streams[next.top()][dataIdx[next.top()]].key;
 
-		// next.top().key == cur.front().key but with suffix comparison
-		while (!next.empty() && cur.front().key.compareSuffix(next.top().key, prefixLen) == 0) {
-			cur.push_back(next.top());
-			next.pop();
-		}
+		// pop every stream whose head has this key, with suffix comparison
+		do {
+			int16_t s = next.top();
+			cur.push_back({ s, dataIdx[s] });
+			dataIdx[s]++;
+			next.replay(s);
+		} while (dataIdx[next.top()] < streams[next.top()].size() &&
+		         key.compareSuffix(streams[next.top()][dataIdx[next.top()]].key, prefixLen) == 0);
 
 		// un-set clears and find latest value for key (if present)
 		bool foundValue = false;
-		bool includesSnapshot = cur.back().streamIdx == 0 && chunk.snapshotFile.present();
-		for (auto& it : cur) {
-			auto& v = streams[it.streamIdx][it.dataIdx];
-			if (clearActive[it.streamIdx]) {
-				clearActive[it.streamIdx] = false;
-				activeClears.erase(it.streamIdx);
-				if (it.streamIdx == maxActiveClear) {
+		bool includesSnapshot = cur.back().first == 0 && chunk.snapshotFile.present();
+		for (auto& [streamIdx, idx] : cur) {
+			auto& v = streams[streamIdx][idx];
+			if (clearActive[streamIdx]) {
+				clearActive[streamIdx] = false;
+				if (streamIdx == maxActiveClear) {
 					// re-get max active clear
-					maxActiveClear = activeClears.empty() ? -1 : *activeClears.begin();
+					while (maxActiveClear >= 0 && !clearActive[maxActiveClear]) {
+						maxActiveClear--;
+					}
 				}
 			}
 
@@ -1457,13 +1632,13 @@ static RangeResult mergeDeltaStreams(const BlobGranuleChunkRef& chunk,
 			if (!foundValue && !v.isNoOp()) {
 				foundValue = true;
 				// if it's a clear, or maxActiveClear is higher, no value for this key
-				if (v.isSet() && maxActiveClear < it.streamIdx) {
+				if (v.isSet() && maxActiveClear < streamIdx) {
 					KeyRef finalKey =
 					    chunk.tenantPrefix.present() ? v.key.removePrefix(chunk.tenantPrefix.get()) : v.key;
 					result.push_back(result.arena(), KeyValueRef(finalKey, v.value));
 					if (!includesSnapshot) {
 						stats.rowsInserted++;
-					} else if (it.streamIdx > 0) {
+					} else if (streamIdx > 0) {
 						stats.rowsUpdated++;
 					}
 				} else if (includesSnapshot) {
@@ -1472,19 +1647,13 @@ static RangeResult mergeDeltaStreams(const BlobGranuleChunkRef& chunk,
 			}
 		}
 
-		// advance streams and start clearAfter
-		for (auto& it : cur) {
-			if (streams[it.streamIdx][it.dataIdx].clearAfter) {
-				clearActive[it.streamIdx] = true;
-				activeClears.insert(it.streamIdx);
-				maxActiveClear = std::max(maxActiveClear, it.streamIdx);
-			}
+		// start clearAfter
+		for (auto& [streamIdx, idx] : cur) {
 			// TODO: implement skipping if large clear!!
-			// if (maxClearIdx > it.streamIdx) - skip
-			it.dataIdx++;
-			if (it.dataIdx < streams[it.streamIdx].size()) {
-				it.key = streams[it.streamIdx][it.dataIdx].key;
-				next.push(it);
+			// if (maxClearIdx > streamIdx) - skip
+			if (streams[streamIdx][idx].clearAfter) {
+				clearActive[streamIdx] = true;
+				maxActiveClear = std::max(maxActiveClear, streamIdx);
 			}
 		}
 	}
@@ -1671,6 +1840,54 @@ static void startLoad(const ReadBlobGranuleContext* granuleContext,
 	}
 }
 
+// Threads that materialize granules for loadAndMaterializeBlobGranules, so that a read of many granules is not limited
+// to the calling thread. The threads are started on first use and are never joined, so the pool is never destroyed.
+class GranuleMaterializePool {
+public:
+	static GranuleMaterializePool* get() {
+		static GranuleMaterializePool* pool = new GranuleMaterializePool(CLIENT_KNOBS->BG_MATERIALIZE_THREADS);
+		return pool;
+	}
+
+	int size() const { return threadCount; }
+
+	std::future<RangeResult> run(std::function<RangeResult()> f) {
+		std::packaged_task<RangeResult()> task(std::move(f));
+		std::future<RangeResult> result = task.get_future();
+		{
+			std::lock_guard<std::mutex> g(mutex);
+			tasks.push_back(std::move(task));
+		}
+		cv.notify_one();
+		return result;
+	}
+
+private:
+	explicit GranuleMaterializePool(int threadCount) : threadCount(threadCount) {
+		for (int i = 0; i < threadCount; i++) {
+			std::thread([this]() { work(); }).detach();
+		}
+	}
+
+	void work() {
+		while (true) {
+			std::packaged_task<RangeResult()> task;
+			{
+				std::unique_lock<std::mutex> l(mutex);
+				cv.wait(l, [this]() { return !tasks.empty(); });
+				task = std::move(tasks.front());
+				tasks.pop_front();
+			}
+			task();
+		}
+	}
+
+	int threadCount;
+	std::mutex mutex;
+	std::condition_variable cv;
+	std::deque<std::packaged_task<RangeResult()>> tasks;
+};
+
 ErrorOr<RangeResult> loadAndMaterializeBlobGranules(const Standalone<VectorRef<BlobGranuleChunkRef>>& files,
                                                     const KeyRangeRef& keyRange,
                                                     Version beginVersion,
@@ -1685,22 +1902,39 @@ ErrorOr<RangeResult> loadAndMaterializeBlobGranules(const Standalone<VectorRef<B
 		parallelism = CLIENT_KNOBS->BG_MAX_GRANULE_PARALLELISM;
 	}
 
+	// Materialize on the calling thread if there is only one granule, or in simulation to stay deterministic
+	GranuleMaterializePool* pool = nullptr;
+	if (files.size() > 1 && CLIENT_KNOBS->BG_MATERIALIZE_THREADS > 0 && !(g_network && g_network->isSimulated())) {
+		pool = GranuleMaterializePool::get();
+	}
+
 	GranuleLoadIds loadIds[files.size()];
+	std::vector<GranuleMaterializeStats> chunkStats(files.size());
+
+	// Chunks being materialized by the pool, oldest first. Their file data must stay loaded, and nothing from files may
+	// be copied into the tasks, since arena reference counts are not thread safe.
+	std::deque<std::pair<int, std::future<RangeResult>>> pending;
+	RangeResult results;
+
+	auto appendChunk = [&](int chunkIdx, RangeResult const& chunkRows) {
+		results.arena().dependsOn(chunkRows.arena());
+		results.append(results.arena(), chunkRows.begin(), chunkRows.size());
+
+		// free once done by forcing FreeHandles to trigger
+		loadIds[chunkIdx].freeHandles.clear();
+	};
 
 	try {
 		// Kick off first file reads if parallelism > 1
 		for (int i = 0; i < parallelism - 1 && i < files.size(); i++) {
 			startLoad(&granuleContext, files[i], loadIds[i]);
 		}
-		RangeResult results;
 		for (int chunkIdx = 0; chunkIdx < files.size(); chunkIdx++) {
 			// Kick off files for this granule if parallelism == 1, or future granule if parallelism > 1
 			if (chunkIdx + parallelism - 1 < files.size()) {
 				startLoad(&granuleContext, files[chunkIdx + parallelism - 1], loadIds[chunkIdx + parallelism - 1]);
 			}
 
-			RangeResult chunkRows;
-
 			// once all loads kicked off, load data for chunk
 			Optional<StringRef> snapshotData;
 			if (files[chunkIdx].snapshotFile.present()) {
@@ -1708,7 +1942,7 @@ ErrorOr<RangeResult> loadAndMaterializeBlobGranules(const Standalone<VectorRef<B
 				    StringRef(granuleContext.get_load_f(loadIds[chunkIdx].snapshotId.get(), granuleContext.userContext),
 				              files[chunkIdx].snapshotFile.get().length);
 				if (!snapshotData.get().begin()) {
-					return ErrorOr<RangeResult>(blob_granule_file_load_error());
+					throw blob_granule_file_load_error();
 				}
 			}
 
@@ -1720,24 +1954,57 @@ ErrorOr<RangeResult> loadAndMaterializeBlobGranules(const Standalone<VectorRef<B
 				              files[chunkIdx].deltaFiles[i].length);
 				// null data is error
 				if (!deltaData[i].begin()) {
-					return ErrorOr<RangeResult>(blob_granule_file_load_error());
+					throw blob_granule_file_load_error();
 				}
 			}
 
 			// materialize rows from chunk
-			chunkRows = materializeBlobGranule(
-			    files[chunkIdx], keyRange, beginVersion, readVersion, snapshotData, deltaData, stats);
-
-			results.arena().dependsOn(chunkRows.arena());
-			results.append(results.arena(), chunkRows.begin(), chunkRows.size());
+			if (!pool) {
+				GranuleMaterializeStats& chunkStat = chunkStats[chunkIdx];
+				RangeResult chunkRows = materializeBlobGranule(
+				    files[chunkIdx], keyRange, beginVersion, readVersion, snapshotData, deltaData, chunkStat);
+				appendChunk(chunkIdx, chunkRows);
+				continue;
+			}
 
-			// free once done by forcing FreeHandles to trigger
-			loadIds[chunkIdx].freeHandles.clear();
+			// keep at most one chunk per pool thread in flight, appending results in key order
+			if (pending.size() >= (size_t)pool->size()) {
+				auto [doneIdx, doneRows] = std::move(pending.front());
+				pending.pop_front();
+				appendChunk(doneIdx, doneRows.get());
+			}
+			const BlobGranuleChunkRef* chunk = &files[chunkIdx];
+			GranuleMaterializeStats* chunkStat = &chunkStats[chunkIdx];
+			KeyRangeRef range = keyRange;
+			pending.emplace_back(
+			    chunkIdx,
+			    pool->run([chunk, range, beginVersion, readVersion, snapshotData, deltaData, chunkStat]() {
+				    return materializeBlobGranule(
+				        *chunk, range, beginVersion, readVersion, snapshotData, deltaData, *chunkStat);
+			    }));
+		}
+		while (!pending.empty()) {
+			auto [doneIdx, doneRows] = std::move(pending.front());
+			pending.pop_front();
+			appendChunk(doneIdx, doneRows.get());
 		}
-		return ErrorOr<RangeResult>(results);
 	} catch (Error& e) {
+		// the remaining tasks still reference the loaded files
+		for (auto& it : pending) {
+			it.second.wait();
+		}
 		return ErrorOr<RangeResult>(e);
 	}
+
+	for (auto& it : chunkStats) {
+		stats.inputBytes += it.inputBytes;
+		stats.outputBytes += it.outputBytes;
+		stats.snapshotRows += it.snapshotRows;
+		stats.rowsCleared += it.rowsCleared;
+		stats.rowsInserted += it.rowsInserted;
+		stats.rowsUpdated += it.rowsUpdated;
+	}
+	return ErrorOr<RangeResult>(results);
 }
 
 // just for client passthrough. reads all key-value pairs from a snapshot file, and all mutations from a delta file
@@ -2468,6 +2735,32 @@ TEST_CASE("/blobgranule/files/validateEncryptionCompression") {
 	return Void();
 }
 
+TEST_CASE("/blobgranule/files/columnarSnapshotChunk") {
+	Standalone<GranuleSnapshot> rows;
+	std::string key;
+	int count = deterministicRandom()->randomInt(0, 100);
+	for (int i = 0; i < count; i++) {
+		// Keep a random part of the previous key so that shared prefixes of every length are covered
+		key = key.substr(0, deterministicRandom()->randomInt(0, key.size() + 1)) +
+		      deterministicRandom()->randomAlphaNumeric(deterministicRandom()->randomInt(1, 10));
+		if (!rows.empty() && StringRef(key) <= rows.back().key) {
+			continue;
+		}
+		std::string value = deterministicRandom()->randomAlphaNumeric(deterministicRandom()->randomInt(0, 100));
+		rows.push_back_deep(rows.arena(), KeyValueRef(StringRef(key), StringRef(value)));
+	}
+
+	Value encoded = ColumnarSnapshotChunk::encode(rows);
+	Arena arena = encoded.arena();
+	Standalone<GranuleSnapshot> decoded = ColumnarSnapshotChunk::decode(encoded, arena);
+	ASSERT(decoded.size() == rows.size());
+	for (int i = 0; i < rows.size(); i++) {
+		ASSERT(decoded[i].key == rows[i].key);
+		ASSERT(decoded[i].value == rows[i].value);
+	}
+	return Void();
+}
+
 TEST_CASE("/blobgranule/files/snapshotFormatUnitTest") {
 	// snapshot files are likely to have a non-trivial shared prefix since they're for a small contiguous key range
 	KeyValueGen kvGen;
@@ -2490,10 +2783,14 @@ TEST_CASE("/blobgranule/files/snapshotFormatUnitTest") {
 		ASSERT(data[i].key < data[i + 1].key);
 	}
 
-	fmt::print("Constructing snapshot with {0} rows, {1} chunks\n", data.size(), targetChunks);
+	bool columnar = deterministicRandom()->coinflip();
+	fmt::print("Constructing {0}snapshot with {1} rows, {2} chunks\n",
+	           columnar ? "columnar " : "",
+	           data.size(),
+	           targetChunks);
 
-	Value serialized =
-	    serializeChunkedSnapshot(fnameRef, data, targetChunkSize, kvGen.compressFilter, kvGen.cipherKeys);
+	Value serialized = serializeChunkedSnapshot(
+	    fnameRef, data, targetChunkSize, kvGen.compressFilter, kvGen.cipherKeys, true, columnar);
 
 	fmt::print("Snapshot serialized! {0} bytes\n", serialized.size());
 
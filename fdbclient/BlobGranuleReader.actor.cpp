@@ -18,9 +18,13 @@
  * limitations under the License.
  */
 
+#include <functional>
 #include <map>
+#include <unordered_map>
 #include <vector>
 
+#include <boost/intrusive/list.hpp>
+
 #include "fmt/format.h"
 #include "fdbclient/AsyncFileS3BlobStore.actor.h"
 #include "fdbclient/BlobGranuleCommon.h"
@@ -29,9 +33,85 @@
 #include "fdbclient/BlobWorkerCommon.h"
 #include "fdbclient/BlobWorkerInterface.h"
 #include "fdbclient/FDBTypes.h"
+#include "fdbclient/Knobs.h"
 #include "flow/actorcompiler.h" // This must be the last #include.
 
-ACTOR Future<Standalone<StringRef>> readFile(Reference<BlobConnectionProvider> bstoreProvider, BlobFilePointerRef f) {
+// An LRU cache of blob granule file contents, shared by every reader in the process. Granule files are never modified
+// once written, so an entry, keyed by the file name and the part of the file read, never goes stale. Concurrent reads
+// of the same file share one load. An entry is charged its length as soon as its load starts, and files larger than a
+// quarter of the capacity are not cached so that one large snapshot can't flush everything else.
+class BlobGranuleFileCache : NonCopyable {
+public:
+	explicit BlobGranuleFileCache(int64_t capacityBytes) : capacityBytes(capacityBytes) {}
+	~BlobGranuleFileCache() { lru.clear(); }
+
+	static BlobGranuleFileCache& get() {
+		auto c = g_network->global(INetwork::enBlobGranuleFileCache);
+		if (c) {
+			return *reinterpret_cast<BlobGranuleFileCache*>(c);
+		}
+		auto res = new BlobGranuleFileCache(CLIENT_KNOBS->BG_FILE_CACHE_BYTES);
+		g_network->setGlobal(INetwork::enBlobGranuleFileCache, res);
+		return *res;
+	}
+
+	// Returns the cached contents of f, or starts load() and caches it. A load that failed is retried by the next read.
+	Future<Standalone<StringRef>> read(const BlobFilePointerRef& f,
+	                                   const std::function<Future<Standalone<StringRef>>()>& load,
+	                                   bool* cached) {
+		std::string key = fmt::format("{}:{}:{}", f.filename.toString(), f.offset, f.length);
+		auto it = entries.find(key);
+		if (it != entries.end() && !it->second.data.isError()) {
+			lru.erase(lru.iterator_to(it->second));
+			lru.push_back(it->second);
+			*cached = true;
+			return it->second.data;
+		}
+		if (it != entries.end()) {
+			erase(it);
+		}
+
+		*cached = false;
+		Future<Standalone<StringRef>> data = load();
+		if (f.length > capacityBytes / 4) {
+			return data;
+		}
+		it = entries.emplace(std::move(key), Entry()).first;
+		it->second.key = &it->first;
+		it->second.data = data;
+		it->second.size = f.length;
+		lru.push_back(it->second);
+		bytes += f.length;
+		while (bytes > capacityBytes) {
+			erase(entries.find(*lru.front().key));
+		}
+		return data;
+	}
+
+	int64_t getBytes() const { return bytes; }
+
+private:
+	struct Entry : boost::intrusive::list_base_hook<> {
+		const std::string* key = nullptr; // Points into the key of the map node holding this entry
+		Future<Standalone<StringRef>> data;
+		int64_t size = 0;
+	};
+
+	void erase(std::unordered_map<std::string, Entry>::iterator it) {
+		lru.erase(lru.iterator_to(it->second));
+		bytes -= it->second.size;
+		entries.erase(it);
+	}
+
+	const int64_t capacityBytes;
+	std::unordered_map<std::string, Entry> entries;
+	// Least recently used first
+	boost::intrusive::list<Entry> lru;
+	int64_t bytes = 0;
+};
+
+ACTOR Future<Standalone<StringRef>> readFileFromBlob(Reference<BlobConnectionProvider> bstoreProvider,
+                                                     BlobFilePointerRef f) {
 	try {
 		state Arena arena;
 		std::string fname = f.filename.toString();
@@ -50,6 +130,17 @@ ACTOR Future<Standalone<StringRef>> readFile(Reference<BlobConnectionProvider> b
 	}
 }
 
+// Sets cached if the file didn't need a new read from the blob store
+Future<Standalone<StringRef>> readFile(Reference<BlobConnectionProvider> bstoreProvider,
+                                       BlobFilePointerRef f,
+                                       bool* cached) {
+	if (CLIENT_KNOBS->BG_FILE_CACHE_BYTES <= 0) {
+		*cached = false;
+		return readFileFromBlob(bstoreProvider, f);
+	}
+	return BlobGranuleFileCache::get().read(f, [&]() { return readFileFromBlob(bstoreProvider, f); }, cached);
+}
+
 // TODO: improve the interface of this function so that it doesn't need
 //       to be passed the entire BlobWorkerStats object
 
@@ -70,8 +161,9 @@ ACTOR Future<RangeResult> readBlobGranule(BlobGranuleChunkRef chunk,
 	try {
 		Future<Standalone<StringRef>> readSnapshotFuture;
 		if (chunk.snapshotFile.present()) {
-			readSnapshotFuture = readFile(bstore, chunk.snapshotFile.get());
-			if (stats.present()) {
+			bool cached;
+			readSnapshotFuture = readFile(bstore, chunk.snapshotFile.get(), &cached);
+			if (stats.present() && !cached) {
 				++stats.get()->s3GetReqs;
 			}
 		}
@@ -79,8 +171,9 @@ ACTOR Future<RangeResult> readBlobGranule(BlobGranuleChunkRef chunk,
 
 		readDeltaFutures.reserve(chunk.deltaFiles.size());
 		for (BlobFilePointerRef deltaFile : chunk.deltaFiles) {
-			readDeltaFutures.push_back(readFile(bstore, deltaFile));
-			if (stats.present()) {
+			bool cached;
+			readDeltaFutures.push_back(readFile(bstore, deltaFile, &cached));
+			if (stats.present() && !cached) {
 				++stats.get()->s3GetReqs;
 			}
 		}
@@ -195,3 +288,55 @@ TEST_CASE("/fdbserver/blobgranule/isRangeCoveredByBlob") {
 	}
 	return Void();
 }
+
+TEST_CASE("/fdbserver/blobgranule/fileCache") {
+	BlobGranuleFileCache cache(1000);
+	Arena arena;
+	int loads = 0;
+	auto file = [&](std::string name, int64_t length) {
+		return BlobFilePointerRef(arena, name, 0, length, length, 1);
+	};
+	auto load = [&]() {
+		++loads;
+		return Future<Standalone<StringRef>>(Standalone<StringRef>("data"_sr));
+	};
+	bool cached;
+
+	// a second read of a file is served from the cache
+	cache.read(file("a", 200), load, &cached);
+	ASSERT(!cached && loads == 1);
+	cache.read(file("a", 200), load, &cached);
+	ASSERT(cached && loads == 1);
+	ASSERT(cache.getBytes() == 200);
+
+	// files over a quarter of the capacity are not cached
+	cache.read(file("big", 300), load, &cached);
+	cache.read(file("big", 300), load, &cached);
+	ASSERT(!cached && loads == 3);
+
+	// filling the cache evicts the least recently used file, which is b since a was just read
+	cache.read(file("b", 200), load, &cached);
+	cache.read(file("c", 200), load, &cached);
+	cache.read(file("d", 200), load, &cached);
+	cache.read(file("a", 200), load, &cached);
+	ASSERT(cached);
+	cache.read(file("e", 200), load, &cached);
+	cache.read(file("f", 200), load, &cached);
+	ASSERT(cache.getBytes() == 1000);
+	cache.read(file("b", 200), load, &cached);
+	ASSERT(!cached);
+	cache.read(file("a", 200), load, &cached);
+	ASSERT(cached);
+
+	// a failed load is not served again
+	auto fail = [&]() {
+		++loads;
+		return Future<Standalone<StringRef>>(io_error());
+	};
+	cache.read(file("g", 100), fail, &cached);
+	loads = 0;
+	cache.read(file("g", 100), load, &cached);
+	ASSERT(!cached && loads == 1);
+
+	return Void();
+}
@@ -52,6 +52,7 @@ void ClientKnobs::initialize(Randomize randomize) {
 	init( COORDINATOR_RECONNECTION_DELAY,          1.0 );
 	init( CLIENT_EXAMPLE_AMOUNT,                    20 );
 	init( MAX_CLIENT_STATUS_AGE,                   1.0 );
+	init( SPECIAL_KEY_SHARED_RESULT_AGE,           1.0 ); if( randomize && BUGGIFY ) SPECIAL_KEY_SHARED_RESULT_AGE = deterministicRandom()->coinflip() ? 0.0 : 5.0; // Seconds that the transactions of a database reuse the result of an expensive special key read
 	init( MAX_COMMIT_PROXY_CONNECTIONS,              5 ); if( randomize && BUGGIFY ) MAX_COMMIT_PROXY_CONNECTIONS = 1;
 	init( MAX_GRV_PROXY_CONNECTIONS,                 3 ); if( randomize && BUGGIFY ) MAX_GRV_PROXY_CONNECTIONS = 1;
 	init( STATUS_IDLE_TIMEOUT,                   120.0 );
@@ -77,7 +78,9 @@ void ClientKnobs::initialize(Randomize randomize) {
 	init( SYSTEM_KEY_SIZE_LIMIT,                   3e4 );
 	init( VALUE_SIZE_LIMIT,                        1e5 );
 	init( SPLIT_KEY_SIZE_LIMIT,                    KEY_SIZE_LIMIT/2 );  if( randomize && BUGGIFY ) SPLIT_KEY_SIZE_LIMIT = KEY_SIZE_LIMIT - 31;//serverKeysPrefixFor(UID()).size() - 1;
+	init( RYW_BLIND_WRITES,                      false ); if( randomize && BUGGIFY ) RYW_BLIND_WRITES = true;
 	init( METADATA_VERSION_CACHE_SIZE,            1000 );
+	init( IMMUTABLE_VALUE_CACHE_BYTES,             1e7 ); if( randomize && BUGGIFY ) IMMUTABLE_VALUE_CACHE_BYTES = 1000;
 	init( CHANGE_FEED_LOCATION_LIMIT,            10000 );
 	init( CHANGE_FEED_CACHE_SIZE,               100000 ); if( randomize && BUGGIFY ) CHANGE_FEED_CACHE_SIZE = 1;
 	init( CHANGE_FEED_POP_TIMEOUT,                10.0 );
@@ -88,14 +91,20 @@ void ClientKnobs::initialize(Randomize randomize) {
 	init( MAX_BATCH_SIZE,                         1000 ); if( randomize && BUGGIFY ) MAX_BATCH_SIZE = 1;
 	init( GRV_BATCH_TIMEOUT,                     0.005 ); if( randomize && BUGGIFY ) GRV_BATCH_TIMEOUT = 0.1;
 	init( BROADCAST_BATCH_SIZE,                     20 ); if( randomize && BUGGIFY ) BROADCAST_BATCH_SIZE = 1;
+	init( COMMIT_BATCHING,                       false ); if( randomize && BUGGIFY ) COMMIT_BATCHING = true;
+	init( COMMIT_BATCH_MAX_SIZE,                   100 ); if( randomize && BUGGIFY ) COMMIT_BATCH_MAX_SIZE = deterministicRandom()->randomInt(1, 10);
+	init( COMMIT_BATCH_MAX_BYTES,                  1e6 );
 	init( TRANSACTION_TIMEOUT_DELAY_INTERVAL,     10.0 ); if( randomize && BUGGIFY ) TRANSACTION_TIMEOUT_DELAY_INTERVAL = 1.0;
 
 	init( LOCATION_CACHE_EVICTION_SIZE,         600000 );
 	init( LOCATION_CACHE_EVICTION_SIZE_SIM,         10 ); if( randomize && BUGGIFY ) LOCATION_CACHE_EVICTION_SIZE_SIM = 3;
 	init( LOCATION_CACHE_ENDPOINT_FAILURE_GRACE_PERIOD,     60 );
 	init( LOCATION_CACHE_FAILED_ENDPOINT_RETRY_INTERVAL,    60 );
+	init( LOCATION_CACHE_PREFETCH_SHARDS,                    1 ); if( randomize && BUGGIFY ) LOCATION_CACHE_PREFETCH_SHARDS = deterministicRandom()->randomInt(2, 10);
 
 	init( GET_RANGE_SHARD_LIMIT,                     2 );
+	init( COALESCE_GET_VALUES,                    true ); if( randomize && BUGGIFY ) COALESCE_GET_VALUES = deterministicRandom()->coinflip();
+	init( GET_VALUES_MAX_KEYS,                     500 ); if( randomize && BUGGIFY ) GET_VALUES_MAX_KEYS = deterministicRandom()->randomInt(2, 10);
 	init( WARM_RANGE_SHARD_LIMIT,                  100 );
 	init( STORAGE_METRICS_SHARD_LIMIT,             100 ); if( randomize && BUGGIFY ) STORAGE_METRICS_SHARD_LIMIT = 3;
 	init( SHARD_COUNT_LIMIT,                        80 ); if( randomize && BUGGIFY ) SHARD_COUNT_LIMIT = 3;
@@ -142,6 +151,7 @@ void ClientKnobs::initialize(Randomize randomize) {
 	init( TASKBUCKET_CHECK_ACTIVE_AMOUNT,           10 );
 	init( TASKBUCKET_TIMEOUT_VERSIONS,     60*CORE_VERSIONSPERSECOND ); if( randomize && BUGGIFY ) TASKBUCKET_TIMEOUT_VERSIONS = 30*CORE_VERSIONSPERSECOND;
 	init( TASKBUCKET_MAX_TASK_KEYS,               1000 ); if( randomize && BUGGIFY ) TASKBUCKET_MAX_TASK_KEYS = 20;
+	init( TASKBUCKET_CLAIM_SCAN_ROWS,              100 ); if( randomize && BUGGIFY ) TASKBUCKET_CLAIM_SCAN_ROWS = 2;
 
 	//Backup
 	init( BACKUP_LOCAL_FILE_WRITE_BLOCK,     1024*1024 );
@@ -149,6 +159,8 @@ void ClientKnobs::initialize(Randomize randomize) {
 	init( BACKUP_SIMULATED_LIMIT_BYTES,		       1e6 ); if( randomize && BUGGIFY ) BACKUP_SIMULATED_LIMIT_BYTES = 1000;
 	init( BACKUP_GET_RANGE_LIMIT_BYTES,		       1e6 );
 	init( BACKUP_LOCK_BYTES,                       1e8 );
+	init( BACKUP_RANGE_READ_PARALLELISM,             4 ); if( randomize && BUGGIFY ) BACKUP_RANGE_READ_PARALLELISM = deterministicRandom()->randomInt(1, 8);
+	init( BACKUP_RANGE_READ_SPLIT_BYTES,          10e6 ); if( randomize && BUGGIFY ) BACKUP_RANGE_READ_SPLIT_BYTES = deterministicRandom()->randomInt(1e3, 1e6);
 	init( BACKUP_RANGE_TIMEOUT,   TASKBUCKET_TIMEOUT_VERSIONS/CORE_VERSIONSPERSECOND/2.0 );
 	init( BACKUP_RANGE_MINWAIT,   std::max(1.0, BACKUP_RANGE_TIMEOUT/2.0));
 	init( BACKUP_SNAPSHOT_DISPATCH_INTERVAL_SEC,  10 * 60 );  // 10 minutes
@@ -180,6 +192,7 @@ void ClientKnobs::initialize(Randomize randomize) {
 	init( RESTORE_DISPATCH_ADDTASK_SIZE,           150 );
 	init( RESTORE_DISPATCH_BATCH_SIZE,           30000 ); if( randomize && BUGGIFY ) RESTORE_DISPATCH_BATCH_SIZE = 20;
 	init( RESTORE_WRITE_TX_SIZE,            256 * 1024 );
+	init( RESTORE_SKIP_UNNEEDED_BLOCKS,           true ); if( randomize && BUGGIFY ) RESTORE_SKIP_UNNEEDED_BLOCKS = deterministicRandom()->coinflip();
 	init( APPLY_MAX_LOCK_BYTES,                    1e9 );
 	init( APPLY_MIN_LOCK_BYTES,                   11e6 ); //Must be bigger than TRANSACTION_SIZE_LIMIT
 	init( APPLY_BLOCK_SIZE,     LOG_RANGE_BLOCK_SIZE/5 );
@@ -256,6 +269,11 @@ void ClientKnobs::initialize(Randomize randomize) {
 	}
 	init(CSI_STATUS_DELAY,						  10.0  );
 
+	init( TRAFFIC_CAPTURE_FILE,                      "" );
+	init( TRAFFIC_CAPTURE_SAMPLE_RATE,              1.0 ); if( randomize && BUGGIFY ) TRAFFIC_CAPTURE_SAMPLE_RATE = deterministicRandom()->random01();
+	init( TRAFFIC_CAPTURE_FLUSH_INTERVAL,           1.0 );
+	init( LATENCY_BREAKDOWN_SAMPLE_RATE,           0.01 ); if( randomize && BUGGIFY ) LATENCY_BREAKDOWN_SAMPLE_RATE = 1.0;
+
 	init( CONSISTENCY_CHECK_RATE_LIMIT_MAX,        50e6 ); // Limit in per sec
 	init( CONSISTENCY_CHECK_ONE_ROUND_TARGET_COMPLETION_TIME,	7 * 24 * 60 * 60 ); // 7 days
 
@@ -285,7 +303,9 @@ void ClientKnobs::initialize(Randomize randomize) {
 
 	// Blob granules
 	init( BG_MAX_GRANULE_PARALLELISM,                10 );
+	init( BG_MATERIALIZE_THREADS,                     4 ); // 0 materializes granules on the calling thread
 	init( BG_TOO_MANY_GRANULES,                   20000 );
+	init( BG_FILE_CACHE_BYTES,                    100e6 ); if( randomize && BUGGIFY ) BG_FILE_CACHE_BYTES = deterministicRandom()->coinflip() ? 0 : 1e6;
 	init( BLOB_METADATA_REFRESH_INTERVAL,          3600 ); if ( randomize && BUGGIFY ) { BLOB_METADATA_REFRESH_INTERVAL = deterministicRandom()->randomInt(5, 120); }
 
 	init( CHANGE_QUORUM_BAD_STATE_RETRY_TIMES,        3 );
@@ -311,6 +331,7 @@ void ClientKnobs::initialize(Randomize randomize) {
 	init( ENCRYPT_HEADER_AES_CTR_NO_AUTH_VERSION,       1 );
 	init( ENCRYPT_HEADER_AES_CTR_AES_CMAC_AUTH_VERSION, 1 );
 	init( ENCRYPT_HEADER_AES_CTR_HMAC_SHA_AUTH_VERSION, 1 );
+	init( ENCRYPT_CIPHER_KEY_REFRESH_AHEAD,            30 ); if( randomize && BUGGIFY ) ENCRYPT_CIPHER_KEY_REFRESH_AHEAD = deterministicRandom()->randomInt(0, 600);
 
 	// clang-format on
 }
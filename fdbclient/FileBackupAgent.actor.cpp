@@ -1154,6 +1154,25 @@ ACTOR static Future<Void> decodeKVPairs(StringRefReader* reader,
 	return Void();
 }
 
+// Reads only the begin key of an unencrypted range file block, which is the end key of the block before it. Returns an
+// empty Optional for an encrypted block or a begin key too large to be read this way.
+ACTOR static Future<Optional<Key>> readRangeFileBlockBeginKey(Reference<IAsyncFile> file, int64_t offset, int len) {
+	state int readLen =
+	    std::min<int64_t>(len, sizeof(int32_t) + sizeof(uint32_t) + CLIENT_KNOBS->SYSTEM_KEY_SIZE_LIMIT);
+	state Standalone<StringRef> buf = makeString(readLen);
+	int rLen = wait(uncancellable(holdWhile(buf, file->read(mutateString(buf), readLen, offset))));
+	if (rLen != readLen)
+		throw restore_bad_read();
+
+	StringRefReader reader(buf, restore_corrupted_data());
+	if (reader.consume<int32_t>() != BACKUP_AGENT_SNAPSHOT_FILE_VERSION)
+		return Optional<Key>();
+	uint32_t kLen = reader.consumeNetworkUInt32();
+	if (kLen > reader.remainder().size())
+		return Optional<Key>();
+	return Key(StringRef(reader.consume(kLen), kLen));
+}
+
 ACTOR Future<Standalone<VectorRef<KeyValueRef>>> decodeRangeFileBlock(Reference<IAsyncFile> file,
                                                                       int64_t offset,
                                                                       int len,
@@ -1763,12 +1782,27 @@ struct BackupRangeTaskFunc : BackupTaskFuncBase {
 		return key;
 	}
 
+	// Splits range into parts of about BACKUP_RANGE_READ_SPLIT_BYTES by the storage servers' byte samples. The result
+	// includes the range's begin and end.
+	ACTOR static Future<Standalone<VectorRef<KeyRef>>> getReadSplitPoints(Database cx, KeyRange range) {
+		state Reference<ReadYourWritesTransaction> tr(new ReadYourWritesTransaction(cx));
+		loop {
+			try {
+				tr->setOption(FDBTransactionOptions::ACCESS_SYSTEM_KEYS);
+				tr->setOption(FDBTransactionOptions::LOCK_AWARE);
+				Standalone<VectorRef<KeyRef>> splitPoints =
+				    wait(tr->getRangeSplitPoints(range, CLIENT_KNOBS->BACKUP_RANGE_READ_SPLIT_BYTES));
+				return splitPoints;
+			} catch (Error& e) {
+				wait(tr->onError(e));
+			}
+		}
+	}
+
 	ACTOR static Future<Void> _execute(Database cx,
 	                                   Reference<TaskBucket> taskBucket,
 	                                   Reference<FutureBucket> futureBucket,
 	                                   Reference<Task> task) {
-		state Reference<FlowLock> lock(new FlowLock(CLIENT_KNOBS->BACKUP_LOCK_BYTES));
-
 		wait(checkTaskVersion(cx, task, BackupRangeTaskFunc::name, BackupRangeTaskFunc::version));
 
 		state Key beginKey = Params.beginKey().get(task);
@@ -1801,16 +1835,35 @@ struct BackupRangeTaskFunc : BackupTaskFuncBase {
 		state Version outVersion = invalidVersion;
 		state Key lastKey;
 
-		// retrieve kvData
-		state PromiseStream<RangeResultWithVersion> results;
-
-		state Future<Void> rc = readCommitted(cx,
-		                                      results,
-		                                      lock,
-		                                      KeyRangeRef(beginKey, endKey),
-		                                      Terminator::True,
-		                                      AccessSystemKeys::True,
-		                                      LockAware::True);
+		// retrieve kvData. Up to BACKUP_RANGE_READ_PARALLELISM parts of the range are read at once, each through its
+		// own lock so that a part read ahead can't starve the one being written, and the parts are written in order.
+		state int readParallelism = std::max(CLIENT_KNOBS->BACKUP_RANGE_READ_PARALLELISM, 1);
+		state Standalone<VectorRef<KeyRef>> readSplitPoints;
+		if (readParallelism > 1) {
+			wait(store(readSplitPoints, getReadSplitPoints(cx, KeyRangeRef(beginKey, endKey))));
+		}
+		if (readSplitPoints.size() < 2) {
+			readSplitPoints = Standalone<VectorRef<KeyRef>>();
+			readSplitPoints.push_back_deep(readSplitPoints.arena(), beginKey);
+			readSplitPoints.push_back_deep(readSplitPoints.arena(), endKey);
+		}
+		state int readParts = readSplitPoints.size() - 1;
+		state std::vector<PromiseStream<RangeResultWithVersion>> results(readParts);
+		state std::vector<Reference<FlowLock>> locks(readParts);
+		state std::vector<Future<Void>> readers(readParts);
+		state int readIdx = 0; // the part being written
+		state int partIdx;
+		for (partIdx = 0; partIdx < std::min(readParallelism, readParts); partIdx++) {
+			KeyRangeRef partRange(readSplitPoints[partIdx], readSplitPoints[partIdx + 1]);
+			locks[partIdx] = makeReference<FlowLock>(CLIENT_KNOBS->BACKUP_LOCK_BYTES / readParallelism);
+			readers[partIdx] = readCommitted(cx,
+			                                 results[partIdx],
+			                                 locks[partIdx],
+			                                 partRange,
+			                                 Terminator::True,
+			                                 AccessSystemKeys::True,
+			                                 LockAware::True);
+		}
 		state std::unique_ptr<IRangeFileWriter> rangeFile;
 		state BackupConfig backup(task);
 		state Arena arena;
@@ -1836,16 +1889,37 @@ struct BackupRangeTaskFunc : BackupTaskFuncBase {
 
 		loop {
 			state RangeResultWithVersion values;
+			state bool partDone = false;
 			try {
-				RangeResultWithVersion _values = waitNext(results.getFuture());
+				RangeResultWithVersion _values = waitNext(results[readIdx].getFuture());
 				values = _values;
-				lock->release(values.first.expectedSize());
+				locks[readIdx]->release(values.first.expectedSize());
 			} catch (Error& e) {
 				if (e.code() == error_code_end_of_stream)
-					done = true;
+					partDone = true;
 				else
 					throw;
 			}
+			if (partDone) {
+				readers[readIdx] = Future<Void>();
+				locks[readIdx].clear();
+				partIdx = readIdx + readParallelism;
+				if (partIdx < readParts) {
+					KeyRangeRef partRange(readSplitPoints[partIdx], readSplitPoints[partIdx + 1]);
+					locks[partIdx] = makeReference<FlowLock>(CLIENT_KNOBS->BACKUP_LOCK_BYTES / readParallelism);
+					readers[partIdx] = readCommitted(cx,
+					                                 results[partIdx],
+					                                 locks[partIdx],
+					                                 partRange,
+					                                 Terminator::True,
+					                                 AccessSystemKeys::True,
+					                                 LockAware::True);
+				}
+				if (++readIdx < readParts) {
+					continue;
+				}
+				done = true;
+			}
 
 			// If we've seen a new read version OR hit the end of the stream, then if we were writing a file finish
 			// it.
@@ -3681,6 +3755,34 @@ struct RestoreRangeTaskFunc : RestoreFileTaskFuncBase {
 		}
 
 		state Reference<IAsyncFile> inFile = wait(bc.get()->readFile(rangeFile.fileName));
+
+		// A block's key range is its begin key up to the next block's begin key, so when only some ranges are being
+		// restored a block outside all of them is skipped after reading just those two keys.
+		if (CLIENT_KNOBS->RESTORE_SKIP_UNNEEDED_BLOCKS && readOffset + readLen < rangeFile.fileSize &&
+		    !(restoreRanges.get().size() == 1 && restoreRanges.get()[0].contains(normalKeys))) {
+			state int64_t nextOffset = readOffset + readLen;
+			state Optional<Key> blockBegin;
+			state Optional<Key> blockEnd;
+			wait(store(blockBegin, readRangeFileBlockBeginKey(inFile, readOffset, readLen)) &&
+			     store(blockEnd, readRangeFileBlockBeginKey(inFile, nextOffset, rangeFile.fileSize - nextOffset)));
+			if (blockBegin.present() && blockEnd.present()) {
+				KeyRangeRef blockRange(blockBegin.get(), blockEnd.get());
+				if (std::none_of(restoreRanges.get().begin(), restoreRanges.get().end(), [&](KeyRange const& r) {
+					    return r.intersects(blockRange);
+				    })) {
+					CODE_PROBE(true, "Restore skipped range file block outside restore ranges");
+					TraceEvent("FileRestoreRangeSkippedBlock")
+					    .suppressFor(60)
+					    .detail("RestoreUID", restore.getUid())
+					    .detail("FileName", rangeFile.fileName)
+					    .detail("ReadOffset", readOffset)
+					    .detail("ReadLen", readLen)
+					    .detail("BlockRange", blockRange);
+					return Void();
+				}
+			}
+		}
+
 		state Standalone<VectorRef<KeyValueRef>> blockData;
 		try {
 			Standalone<VectorRef<KeyValueRef>> data = wait(decodeRangeFileBlock(inFile, readOffset, readLen, cx));
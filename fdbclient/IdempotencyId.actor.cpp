@@ -174,6 +174,22 @@ TEST_CASE("/fdbclient/IdempotencyId/serialization") {
 	return Void();
 }
 
+TEST_CASE("/fdbclient/IdempotencyId/timeIndex") {
+	int64_t bucketTime = deterministicRandom()->randomInt64(0, std::numeric_limits<int32_t>::max());
+	Key key = idempotencyIdTimeIndexKeyFor(bucketTime);
+	ASSERT(idempotencyIdTimeIndexKeys.contains(key));
+	ASSERT(key < idempotencyIdTimeIndexKeyFor(bucketTime + 1));
+	ASSERT(!idempotencyIdKeys.contains(key));
+
+	Version version = deterministicRandom()->randomInt64(0, std::numeric_limits<Version>::max());
+	Version decodedVersion;
+	int64_t decodedTime;
+	decodeIdempotencyIdTimeIndexValue(idempotencyIdTimeIndexValue(version, bucketTime), decodedVersion, decodedTime);
+	ASSERT_EQ(decodedVersion, version);
+	ASSERT_EQ(decodedTime, bucketTime);
+	return Void();
+}
+
 KeyRangeRef makeIdempotencySingleKeyRange(Arena& arena, Version version, uint8_t highOrderBatchIndex) {
 	static const auto size =
 	    idempotencyIdKeys.begin.size() + sizeof(version) + sizeof(highOrderBatchIndex) + /*\x00*/ 1;
@@ -205,6 +221,21 @@ void decodeIdempotencyKey(KeyRef key, Version& commitVersion, uint8_t& highOrder
 	reader >> highOrderBatchIndex;
 }
 
+Key idempotencyIdTimeIndexKeyFor(int64_t bucketTime) {
+	return BinaryWriter::toValue(bigEndian64(bucketTime), Unversioned()).withPrefix(idempotencyIdTimeIndexKeys.begin);
+}
+
+Value idempotencyIdTimeIndexValue(Version version, int64_t time) {
+	BinaryWriter wr(Unversioned());
+	wr << version << time;
+	return wr.toValue();
+}
+
+void decodeIdempotencyIdTimeIndexValue(ValueRef value, Version& version, int64_t& time) {
+	BinaryReader reader(value, Unversioned());
+	reader >> version >> time;
+}
+
 FDB_BOOLEAN_PARAM(Oldest);
 
 // Find the youngest or oldest idempotency id key in `range` (depending on `oldest`)
@@ -269,6 +300,29 @@ ACTOR Future<JsonBuilderObject> getIdmpKeyStatus(Database db) {
 	}
 }
 
+// Find the youngest idempotency id time index entry written at least minAgeSeconds ago. Every idempotency id at a lower
+// version than the entry's is at least that old.
+ACTOR static Future<Optional<KeyValue>> getTimeIndexBoundary(Reference<ReadYourWritesTransaction> tr,
+                                                             double minAgeSeconds) {
+	state int64_t cutoff = int64_t(now() - minAgeSeconds);
+	// An entry is written in its own bucket, so it is at least as late as its key. A couple of entries before the
+	// cutoff bucket are enough to find one written before the cutoff.
+	RangeResult result = wait(tr->getRange(KeyRangeRef(idempotencyIdTimeIndexKeys.begin,
+	                                                   idempotencyIdTimeIndexKeyFor(cutoff + 1)),
+	                                       /*limit*/ 2,
+	                                       Snapshot::False,
+	                                       Reverse::True));
+	for (auto const& kv : result) {
+		Version version;
+		int64_t time;
+		decodeIdempotencyIdTimeIndexValue(kv.value, version, time);
+		if (time <= cutoff) {
+			return KeyValue(kv, result.arena());
+		}
+	}
+	return Optional<KeyValue>();
+}
+
 ACTOR Future<Void> cleanIdempotencyIds(Database db, double minAgeSeconds) {
 	state int64_t idmpKeySize;
 	state int64_t candidateDeleteSize;
@@ -284,6 +338,7 @@ ACTOR Future<Void> cleanIdempotencyIds(Database db, double minAgeSeconds) {
 	state Version candidateDeleteVersion;
 	state int64_t candidateDeleteTime;
 	state KeyRange candidateRangeToClean;
+	state Optional<KeyValue> indexBoundary;
 
 	tr = makeReference<ReadYourWritesTransaction>(db);
 	loop {
@@ -305,53 +360,75 @@ ACTOR Future<Void> cleanIdempotencyIds(Database db, double minAgeSeconds) {
 			// Only used for a trace event
 			wait(store(idmpKeySize, tr->getEstimatedRangeSizeBytes(idempotencyIdKeys)));
 
-			// Get the version of the most recent idempotency ID
-			wait(success(
-			    getBoundary(tr, idempotencyIdKeys, Oldest::False, &candidateDeleteVersion, &candidateDeleteTime)));
-
-			// Keep dividing the candidate range until clearing it would not delete something younger than
-			// minAgeSeconds
-			loop {
-
-				candidateRangeToClean =
-				    KeyRangeRef(oldestKey,
-				                BinaryWriter::toValue(bigEndian64(candidateDeleteVersion + 1), Unversioned())
-				                    .withPrefix(idempotencyIdKeys.begin));
-
-				// We know that we're okay deleting oldestVersion at this point. Go ahead and do that.
-				if (oldestVersion == candidateDeleteVersion) {
+			// The time index gives the boundary directly. Fall back to searching the ids for it if the index has no
+			// entry old enough, e.g. because the ids were written before the index was.
+			wait(store(indexBoundary, getTimeIndexBoundary(tr, minAgeSeconds)));
+			if (indexBoundary.present()) {
+				Version indexVersion;
+				decodeIdempotencyIdTimeIndexValue(indexBoundary.get().value, indexVersion, candidateDeleteTime);
+				if (indexVersion <= oldestVersion) {
 					break;
 				}
-
-				// Find the youngest key in candidate range
-				wait(success(getBoundary(
-				    tr, candidateRangeToClean, Oldest::False, &candidateDeleteVersion, &candidateDeleteTime)));
-
-				// Update the range so that it ends at an idempotency id key. Since we're binary searching, the
-				// candidate range was probably too large before.
+				candidateDeleteVersion = indexVersion - 1;
 				candidateRangeToClean =
 				    KeyRangeRef(oldestKey,
-				                BinaryWriter::toValue(bigEndian64(candidateDeleteVersion + 1), Unversioned())
+				                BinaryWriter::toValue(bigEndian64(indexVersion), Unversioned())
 				                    .withPrefix(idempotencyIdKeys.begin));
-
 				wait(store(candidateDeleteSize, tr->getEstimatedRangeSizeBytes(candidateRangeToClean)));
-
-				int64_t youngestAge = int64_t(now()) - candidateDeleteTime;
-				TraceEvent("IdempotencyIdsCleanerCandidateDelete")
-				    .detail("Range", candidateRangeToClean.toString())
-				    .detail("IdmpKeySizeEstimate", idmpKeySize)
-				    .detail("YoungestIdAge", youngestAge)
-				    .detail("MinAgeSeconds", minAgeSeconds)
-				    .detail("ClearRangeSizeEstimate", candidateDeleteSize);
-				if (youngestAge > minAgeSeconds) {
-					break;
+				CODE_PROBE(true, "Idempotency id cleaner used the time index");
+			} else {
+				// Get the version of the most recent idempotency ID
+				wait(success(
+				    getBoundary(tr, idempotencyIdKeys, Oldest::False, &candidateDeleteVersion, &candidateDeleteTime)));
+
+				// Keep dividing the candidate range until clearing it would not delete something younger than
+				// minAgeSeconds
+				loop {
+
+					candidateRangeToClean =
+					    KeyRangeRef(oldestKey,
+					                BinaryWriter::toValue(bigEndian64(candidateDeleteVersion + 1), Unversioned())
+					                    .withPrefix(idempotencyIdKeys.begin));
+
+					// We know that we're okay deleting oldestVersion at this point. Go ahead and do that.
+					if (oldestVersion == candidateDeleteVersion) {
+						break;
+					}
+
+					// Find the youngest key in candidate range
+					wait(success(getBoundary(
+					    tr, candidateRangeToClean, Oldest::False, &candidateDeleteVersion, &candidateDeleteTime)));
+
+					// Update the range so that it ends at an idempotency id key. Since we're binary searching, the
+					// candidate range was probably too large before.
+					candidateRangeToClean =
+					    KeyRangeRef(oldestKey,
+					                BinaryWriter::toValue(bigEndian64(candidateDeleteVersion + 1), Unversioned())
+					                    .withPrefix(idempotencyIdKeys.begin));
+
+					wait(store(candidateDeleteSize, tr->getEstimatedRangeSizeBytes(candidateRangeToClean)));
+
+					int64_t youngestAge = int64_t(now()) - candidateDeleteTime;
+					TraceEvent("IdempotencyIdsCleanerCandidateDelete")
+					    .detail("Range", candidateRangeToClean.toString())
+					    .detail("IdmpKeySizeEstimate", idmpKeySize)
+					    .detail("YoungestIdAge", youngestAge)
+					    .detail("MinAgeSeconds", minAgeSeconds)
+					    .detail("ClearRangeSizeEstimate", candidateDeleteSize);
+					if (youngestAge > minAgeSeconds) {
+						break;
+					}
+					candidateDeleteVersion = (oldestVersion + candidateDeleteVersion) / 2;
 				}
-				candidateDeleteVersion = (oldestVersion + candidateDeleteVersion) / 2;
 			}
 			finalRange = KeyRangeRef(idempotencyIdKeys.begin, candidateRangeToClean.end);
 			if (!finalRange.empty()) {
 				tr->addReadConflictRange(finalRange);
 				tr->clear(finalRange);
+				if (indexBoundary.present()) {
+					// Older index entries only point into the range just cleared
+					tr->clear(KeyRangeRef(idempotencyIdTimeIndexKeys.begin, indexBoundary.get().key));
+				}
 				tr->set(
 				    idempotencyIdsExpiredVersion,
 				    ObjectWriter::toValue(IdempotencyIdsExpiredVersion{ candidateDeleteVersion, candidateDeleteTime },
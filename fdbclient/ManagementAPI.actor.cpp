@@ -30,6 +30,7 @@
 #include "fdbclient/FDBOptions.g.h"
 #include "fdbclient/FDBTypes.h"
 #include "fdbclient/ReadYourWrites.h"
+#include "fdbclient/KeyRangeMap.h"
 #include "fdbclient/ManagementAPI.actor.h"
 
 #include "fdbclient/SystemData.h"
@@ -2557,6 +2558,44 @@ ACTOR Future<UID> auditStorage(Reference<IClusterConnectionRecord> clusterFile,
 	}
 }
 
+ACTOR Future<Void> setBulkLoad(Database cx, KeyRange range, BulkLoadState bulkLoadState) {
+	state Transaction tr(cx);
+	loop {
+		try {
+			tr.setOption(FDBTransactionOptions::ACCESS_SYSTEM_KEYS);
+			tr.setOption(FDBTransactionOptions::PRIORITY_SYSTEM_IMMEDIATE);
+			// The files replace whatever the range holds, so there must be nothing for them to replace
+			RangeResult existing = wait(tr.getRange(range, 1));
+			if (!existing.empty()) {
+				TraceEvent(SevWarn, "SetBulkLoadRangeNotEmpty").detail("Range", range).detail("Key", existing[0].key);
+				throw client_invalid_operation();
+			}
+			wait(krmSetRange(&tr, bulkLoadPrefix, range, bulkLoadStateValue(bulkLoadState)));
+			wait(tr.commit());
+			TraceEvent("SetBulkLoad").detail("Range", range).detail("State", bulkLoadState.toString());
+			return Void();
+		} catch (Error& e) {
+			wait(tr.onError(e));
+		}
+	}
+}
+
+ACTOR Future<Void> clearBulkLoad(Database cx, KeyRange range) {
+	state Transaction tr(cx);
+	loop {
+		try {
+			tr.setOption(FDBTransactionOptions::ACCESS_SYSTEM_KEYS);
+			tr.setOption(FDBTransactionOptions::PRIORITY_SYSTEM_IMMEDIATE);
+			wait(krmSetRange(&tr, bulkLoadPrefix, range, Value()));
+			wait(tr.commit());
+			TraceEvent("ClearBulkLoad").detail("Range", range);
+			return Void();
+		} catch (Error& e) {
+			wait(tr.onError(e));
+		}
+	}
+}
+
 ACTOR Future<Void> waitForPrimaryDC(Database cx, StringRef dcId) {
 	state ReadYourWritesTransaction tr(cx);
 
@@ -102,6 +102,33 @@ ThreadFuture<Optional<Value>> DLTransaction::get(const KeyRef& key, bool snapsho
 	});
 }
 
+ThreadFuture<RangeResult> DLTransaction::getMulti(const VectorRef<KeyRef>& keys, bool snapshot) {
+	if (!api->transactionGetMulti) {
+		return unsupported_operation();
+	}
+
+	std::vector<uint8_t const*> keyNames;
+	std::vector<int> keyNameLengths;
+	keyNames.reserve(keys.size());
+	keyNameLengths.reserve(keys.size());
+	for (auto const& key : keys) {
+		keyNames.push_back(key.begin());
+		keyNameLengths.push_back(key.size());
+	}
+	FdbCApi::FDBFuture* f =
+	    api->transactionGetMulti(tr, keyNames.data(), keyNameLengths.data(), keys.size(), snapshot);
+	return toThreadFuture<RangeResult>(api, f, [](FdbCApi::FDBFuture* f, FdbCApi* api) {
+		const FdbCApi::FDBKeyValue* kvs;
+		int count;
+		FdbCApi::fdb_bool_t more;
+		FdbCApi::fdb_error_t error = api->futureGetKeyValueArray(f, &kvs, &count, &more);
+		ASSERT(!error);
+
+		// The memory for this is stored in the FDBFuture and is released when the future gets destroyed
+		return RangeResult(RangeResultRef(VectorRef<KeyValueRef>((KeyValueRef*)kvs, count), more), Arena());
+	});
+}
+
 ThreadFuture<Key> DLTransaction::getKey(const KeySelectorRef& key, bool snapshot) {
 	FdbCApi::FDBFuture* f =
 	    api->transactionGetKey(tr, key.getKey().begin(), key.getKey().size(), key.orEqual, key.offset, snapshot);
@@ -1127,6 +1154,8 @@ void DLApi::init() {
 	                   fdbCPath,
 	                   "fdb_transaction_get_tag_throttled_duration",
 	                   headerVersion >= ApiVersion::withGetTagThrottledDuration().version());
+	// Missing from client libraries that predate it, in which case getMulti() is unsupported
+	loadClientFunction(&api->transactionGetMulti, lib, fdbCPath, "fdb_transaction_get_multi", false);
 	loadClientFunction(&api->transactionGetTotalCost,
 	                   lib,
 	                   fdbCPath,
@@ -1350,7 +1379,7 @@ void DLApi::addNetworkThreadCompletionHook(void (*hook)(void*), void* hookParame
 MultiVersionTransaction::MultiVersionTransaction(Reference<MultiVersionDatabase> db,
                                                  Optional<Reference<MultiVersionTenant>> tenant,
                                                  UniqueOrderedOptionList<FDBTransactionOptions> defaultOptions)
-  : db(db), tenant(tenant), startTime(timer_monotonic()), timeoutTsav(new ThreadSingleAssignmentVar<Void>()) {
+  : db(db), tenant(tenant), startTime(timer_monotonic()) {
 	setDefaultOptions(defaultOptions);
 	updateTransaction(false);
 }
@@ -1462,6 +1491,10 @@ ThreadFuture<Optional<Value>> MultiVersionTransaction::get(const KeyRef& key, bo
 	return executeOperation(&ITransaction::get, key, std::forward<bool>(snapshot));
 }
 
+ThreadFuture<RangeResult> MultiVersionTransaction::getMulti(const VectorRef<KeyRef>& keys, bool snapshot) {
+	return executeOperation(&ITransaction::getMulti, keys, std::forward<bool>(snapshot));
+}
+
 ThreadFuture<Key> MultiVersionTransaction::getKey(const KeySelectorRef& key, bool snapshot) {
 	return executeOperation(&ITransaction::getKey, key, std::forward<bool>(snapshot));
 }
@@ -1809,7 +1842,7 @@ void MultiVersionTransaction::setTimeout(Optional<StringRef> value) {
 		prevTimeout = currentTimeout;
 
 		if (timeoutDuration > 0) {
-			Reference<ThreadSingleAssignmentVar<Void>> tsav = timeoutTsav;
+			Reference<ThreadSingleAssignmentVar<Void>> tsav = getTimeoutTsavUnsafe();
 			ThreadFuture<Void> newTimeout = onMainThread([transactionStartTime, tsav, timeoutDuration]() {
 				return timeoutImpl(tsav, timeoutDuration - std::max(0.0, now() - transactionStartTime));
 			});
@@ -1838,6 +1871,15 @@ void MultiVersionTransaction::resetTimeout() {
 		prevTimeout.cancel();
 	}
 }
+// Most transactions have an underlying ITransaction and never need timeoutTsav, so it is only created when first used.
+// Must be called with timeoutLock held.
+Reference<ThreadSingleAssignmentVar<Void>> MultiVersionTransaction::getTimeoutTsavUnsafe() {
+	if (!timeoutTsav) {
+		timeoutTsav = makeReference<ThreadSingleAssignmentVar<Void>>();
+	}
+	return timeoutTsav;
+}
+
 // Creates a ThreadFuture<T> that will signal an error if the transaction times out.
 template <class T>
 ThreadFuture<T> MultiVersionTransaction::makeTimeout() {
@@ -1846,10 +1888,8 @@ ThreadFuture<T> MultiVersionTransaction::makeTimeout() {
 	{ // lock scope
 		ThreadSpinLockHolder holder(timeoutLock);
 
-		// Our ThreadFuture holds a reference to this TSAV,
-		// but the ThreadFuture does not increment the ref count
-		timeoutTsav->addref();
-		f = ThreadFuture<Void>(timeoutTsav.getPtr());
+		// Our ThreadFuture takes over the reference to this TSAV held by the returned Reference
+		f = ThreadFuture<Void>(getTimeoutTsavUnsafe().extractPtr());
 	}
 
 	// When our timeoutTsav gets set, map it to the appropriate type
@@ -1883,15 +1923,16 @@ void MultiVersionTransaction::reset() {
 	{ // lock scope
 		ThreadSpinLockHolder holder(timeoutLock);
 
-		prevTimeoutTsav = timeoutTsav;
-		timeoutTsav = makeReference<ThreadSingleAssignmentVar<Void>>();
+		prevTimeoutTsav = std::move(timeoutTsav);
 
 		prevTimeout = currentTimeout;
 		currentTimeout = ThreadFuture<Void>();
 	}
 
 	// Cancel any outstanding operations if they don't have an underlying transaction object to cancel them
-	prevTimeoutTsav->trySendError(transaction_cancelled());
+	if (prevTimeoutTsav) {
+		prevTimeoutTsav->trySendError(transaction_cancelled());
+	}
 	if (prevTimeout.isValid()) {
 		prevTimeout.cancel();
 	}
@@ -1901,7 +1942,9 @@ void MultiVersionTransaction::reset() {
 }
 
 MultiVersionTransaction::~MultiVersionTransaction() {
-	timeoutTsav->trySendError(transaction_cancelled());
+	if (timeoutTsav) {
+		timeoutTsav->trySendError(transaction_cancelled());
+	}
 	if (currentTimeout.isValid()) {
 		currentTimeout.cancel();
 	}
@@ -2088,6 +2131,9 @@ MultiVersionDatabase::MultiVersionDatabase(MultiVersionApi* api,
 
 MultiVersionDatabase::~MultiVersionDatabase() {
 	dbState->close();
+	if (assignedThread >= 0) {
+		MultiVersionApi::api->releaseDatabaseThread(assignedThread);
+	}
 }
 
 // Create a MultiVersionDatabase that wraps an already created IDatabase object
@@ -3274,6 +3320,22 @@ void MultiVersionApi::addNetworkThreadCompletionHook(void (*hook)(void*), void*
 	}
 }
 
+// Picks the client thread with the fewest live databases, so that destroying databases doesn't leave some threads
+// carrying most of the load as round robin assignment would. Must be called with lock held.
+int MultiVersionApi::assignDatabaseThread() {
+	threadDatabases.resize(threadCount);
+	int threadIdx = std::min_element(threadDatabases.begin(), threadDatabases.end()) - threadDatabases.begin();
+	++threadDatabases[threadIdx];
+	return threadIdx;
+}
+
+void MultiVersionApi::releaseDatabaseThread(int threadIdx) {
+	lock.enter();
+	ASSERT(threadIdx < threadDatabases.size() && threadDatabases[threadIdx] > 0);
+	--threadDatabases[threadIdx];
+	lock.leave();
+}
+
 // Creates an IDatabase object that represents a connection to the cluster
 Reference<IDatabase> MultiVersionApi::createDatabase(ClusterConnectionRecord const& connectionRecord) {
 	lock.enter();
@@ -3284,13 +3346,13 @@ Reference<IDatabase> MultiVersionApi::createDatabase(ClusterConnectionRecord con
 	if (localClientDisabled) {
 		ASSERT(!bypassMultiClientApi);
 
-		int threadIdx = nextThread;
-		nextThread = (nextThread + 1) % threadCount;
+		int threadIdx = assignDatabaseThread();
 		lock.leave();
 
 		Reference<IDatabase> localDb = connectionRecord.createDatabase(localClient->api);
-		return Reference<IDatabase>(
-		    new MultiVersionDatabase(this, threadIdx, connectionRecord, Reference<IDatabase>(), localDb));
+		auto db = new MultiVersionDatabase(this, threadIdx, connectionRecord, Reference<IDatabase>(), localDb);
+		db->assignedThread = threadIdx;
+		return Reference<IDatabase>(db);
 	}
 
 	lock.leave();
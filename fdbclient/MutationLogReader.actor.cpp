@@ -45,9 +45,14 @@ Standalone<RangeResultRef> RangeResultBlock::consume() {
 	                                   CLIENT_KNOBS->LOG_RANGE_BLOCK_SIZE * CLIENT_KNOBS->LOG_RANGE_BLOCK_SIZE) +
 	                      1; // firstVersion rounded up to the nearest 1M versions, then + 1
 	int startIndex = indexToRead;
-	while (indexToRead < result.size() && keyRefToVersion(result[indexToRead].key, prefixLen) < stopVersion) {
-		++indexToRead;
-	}
+	// Keys are ordered by version, so the end of this block's versions can be found by bisection
+	indexToRead = std::lower_bound(result.begin() + indexToRead,
+	                               result.end(),
+	                               stopVersion,
+	                               [this](KeyValueRef const& kv, Version v) {
+		                               return keyRefToVersion(kv.key, prefixLen) < v;
+	                               }) -
+	              result.begin();
 	if (indexToRead < result.size()) {
 		firstVersion = keyRefToVersion(result[indexToRead].key, prefixLen); // the version of result[indexToRead]
 	}
@@ -143,6 +148,21 @@ Future<Standalone<RangeResultRef>> MutationLogReader::getNext() {
 
 ACTOR Future<Standalone<RangeResultRef>> MutationLogReader::getNext_impl(MutationLogReader* self) {
 	loop {
+		if (self->waitingHash >= 0) {
+			// The heap can't yield its next block until it holds the next block of the reader whose block was used up
+			// last.  That read was left to complete while the consumer handled the previous result.
+			try {
+				mutation_log_reader::RangeResultBlock next =
+				    waitNext(self->pipelinedReaders[self->waitingHash]->reads.getFuture());
+				self->priorityQueue.push(next);
+			} catch (Error& e) {
+				if (e.code() != error_code_end_of_stream) {
+					throw e;
+				}
+				++self->finished;
+			}
+			self->waitingHash = -1;
+		}
 		if (self->finished == 256) {
 			state int i;
 			for (i = 0; i < self->pipelinedReaders.size(); ++i) {
@@ -156,17 +176,7 @@ ACTOR Future<Standalone<RangeResultRef>> MutationLogReader::getNext_impl(Mutatio
 		state Standalone<RangeResultRef> ret = top.consume();
 		if (top.empty()) {
 			self->pipelinedReaders[(int)hash]->release();
-			try {
-				mutation_log_reader::RangeResultBlock next =
-				    waitNext(self->pipelinedReaders[(int)hash]->reads.getFuture());
-				self->priorityQueue.push(next);
-			} catch (Error& e) {
-				if (e.code() == error_code_end_of_stream) {
-					++self->finished;
-				} else {
-					throw e;
-				}
-			}
+			self->waitingHash = hash;
 		} else {
 			self->priorityQueue.push(top);
 		}
@@ -191,6 +201,34 @@ TEST_CASE("/fdbclient/mutationlogreader/VersionKeyRefConversion") {
 
 	return Void();
 }
+
+TEST_CASE("/fdbclient/mutationlogreader/ConsumeByBlock") {
+	Key prefix = "foos"_sr;
+	const Version blockSize = CLIENT_KNOBS->LOG_RANGE_BLOCK_SIZE;
+	std::vector<Version> versions = { 1, 5, blockSize, blockSize + 1, 2 * blockSize + 3 };
+
+	RangeResult result;
+	for (Version v : versions) {
+		result.push_back_deep(result.arena(), KeyValueRef(versionToKey(v, prefix), ""_sr));
+	}
+	mutation_log_reader::RangeResultBlock block{ .result = result,
+		                                         .firstVersion = versions.front(),
+		                                         .lastVersion = versions.back(),
+		                                         .hash = 0,
+		                                         .prefixLen = prefix.size(),
+		                                         .indexToRead = 0 };
+
+	// Each consume() returns the rest of one block of versions
+	ASSERT(block.consume().size() == 3);
+	ASSERT(!block.empty());
+	ASSERT(block.consume().size() == 1);
+	Standalone<RangeResultRef> last = block.consume();
+	ASSERT(last.size() == 1);
+	ASSERT(keyRefToVersion(last[0].key, prefix.size()) == 2 * blockSize + 3);
+	ASSERT(block.empty());
+
+	return Void();
+}
 } // namespace
 
 void forceLinkMutationLogReaderTests() {}
@@ -189,6 +189,8 @@ void DatabaseContext::addTssMapping(StorageServerInterface const& ssi, StorageSe
 		// data requests duplicated for load and data comparison
 		queueModel.updateTssEndpoint(ssi.getValue.getEndpoint().token.first(),
 		                             TSSEndpointData(tssi.id(), tssi.getValue.getEndpoint(), metrics));
+		queueModel.updateTssEndpoint(ssi.getValues.getEndpoint().token.first(),
+		                             TSSEndpointData(tssi.id(), tssi.getValues.getEndpoint(), metrics));
 		queueModel.updateTssEndpoint(ssi.getKey.getEndpoint().token.first(),
 		                             TSSEndpointData(tssi.id(), tssi.getKey.getEndpoint(), metrics));
 		queueModel.updateTssEndpoint(ssi.getKeyValues.getEndpoint().token.first(),
@@ -224,6 +226,7 @@ void DatabaseContext::removeTssMapping(StorageServerInterface const& ssi) {
 		tssMetrics.erase(ssi.id());
 		tssMapping.erase(result);
 		queueModel.removeTssEndpoint(ssi.getValue.getEndpoint().token.first());
+		queueModel.removeTssEndpoint(ssi.getValues.getEndpoint().token.first());
 		queueModel.removeTssEndpoint(ssi.getKey.getEndpoint().token.first());
 		queueModel.removeTssEndpoint(ssi.getKeyValues.getEndpoint().token.first());
 		queueModel.removeTssEndpoint(ssi.getMappedKeyValues.getEndpoint().token.first());
@@ -399,6 +402,10 @@ double DatabaseContext::getLastGrvTime() {
 	return lastGrvTime;
 }
 
+double DatabaseContext::getGrvCacheLease() const {
+	return grvCacheLease.present() ? grvCacheLease.get() : CLIENT_KNOBS->MAX_VERSION_CACHE_LAG;
+}
+
 Reference<StorageServerInfo> StorageServerInfo::getInterface(DatabaseContext* cx,
                                                              StorageServerInterface const& ssi,
                                                              LocalityData const& locality) {
@@ -525,6 +532,40 @@ void DatabaseContext::validateVersion(Version version) const {
 	ASSERT(version > 0 || version == latestVersion);
 }
 
+bool DatabaseContext::isImmutableKey(KeyRef key) const {
+	for (auto const& prefix : immutableKeyPrefixes) {
+		if (key.startsWith(prefix)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+Optional<Value> DatabaseContext::getImmutableValue(KeyRef key, Version readVersion) const {
+	auto it = immutableValueCache.find(key);
+	if (it == immutableValueCache.end() || readVersion < it->second.second) {
+		return Optional<Value>();
+	}
+	return it->second.first;
+}
+
+void DatabaseContext::addImmutableValue(Key const& key, Value const& value, Version version) {
+	auto [it, inserted] = immutableValueCache.try_emplace(key, value, version);
+	if (!inserted) {
+		// The value is valid from the earliest version it was read at
+		it->second.second = std::min(it->second.second, version);
+		return;
+	}
+	immutableValueCacheOrder.push_back(key);
+	immutableValueCacheBytes += key.expectedSize() + value.expectedSize();
+	while (immutableValueCacheBytes > CLIENT_KNOBS->IMMUTABLE_VALUE_CACHE_BYTES) {
+		auto evicted = immutableValueCache.find(immutableValueCacheOrder.front());
+		immutableValueCacheBytes -= evicted->first.expectedSize() + evicted->second.first.expectedSize();
+		immutableValueCache.erase(evicted);
+		immutableValueCacheOrder.pop_front();
+	}
+}
+
 void validateOptionValuePresent(Optional<StringRef> value) {
 	if (!value.present()) {
 		throw invalid_option_value();
@@ -941,6 +982,54 @@ ACTOR static Future<Void> clientStatusUpdateActor(DatabaseContext* cx) {
 	}
 }
 
+// Appends the transactions captured for CLIENT_KNOBS->TRAFFIC_CAPTURE_FILE, which it truncates first, every
+// TRAFFIC_CAPTURE_FLUSH_INTERVAL. Like clientStatusUpdateActor, this takes a DatabaseContext pointer to avoid a cycle.
+ACTOR static Future<Void> trafficCaptureActor(DatabaseContext* cx) {
+	state std::string filename = CLIENT_KNOBS->TRAFFIC_CAPTURE_FILE;
+	state Reference<IAsyncFile> file;
+	state int64_t offset = 0;
+	state Standalone<StringRef> data;
+	try {
+		Reference<IAsyncFile> f = wait(IAsyncFileSystem::filesystem()->open(
+		    filename,
+		    IAsyncFile::OPEN_NO_AIO | IAsyncFile::OPEN_UNCACHED | IAsyncFile::OPEN_CREATE | IAsyncFile::OPEN_READWRITE,
+		    0644));
+		file = f;
+		wait(file->truncate(0));
+
+		{
+			BinaryWriter header(Unversioned());
+			header << FdbClientLogEvents::TRAFFIC_CAPTURE_MAGIC << FdbClientLogEvents::TRAFFIC_CAPTURE_FORMAT_VERSION;
+			data = header.toValue();
+		}
+		loop {
+			if (data.size()) {
+				wait(file->write(data.begin(), data.size(), offset));
+				offset += data.size();
+			}
+			wait(delay(CLIENT_KNOBS->TRAFFIC_CAPTURE_FLUSH_INTERVAL));
+
+			BinaryWriter records(Unversioned());
+			for (auto& tr : cx->trafficCapture.queue) {
+				BinaryWriter record(Unversioned());
+				record << tr;
+				records << (uint32_t)record.getLength();
+				records.serializeBytes(record.toValue());
+			}
+			cx->trafficCapture.queue.clear();
+			data = records.toValue();
+		}
+	} catch (Error& e) {
+		if (e.code() == error_code_actor_cancelled) {
+			throw;
+		}
+		TraceEvent(SevWarnAlways, "TrafficCaptureFailed").error(e).detail("File", filename);
+		cx->trafficCapture.failed = true;
+		cx->trafficCapture.queue.clear();
+	}
+	return Void();
+}
+
 ACTOR Future<Void> assertFailure(GrvProxyInterface remote, Future<ErrorOr<GetReadVersionReply>> reply) {
 	try {
 		ErrorOr<GetReadVersionReply> res = wait(reply);
@@ -1275,6 +1364,9 @@ ACTOR static Future<Void> backgroundGrvUpdater(DatabaseContext* cx) {
 			state double curTime = now();
 			state double lastTime = cx->getLastGrvTime();
 			state double lastProxyTime = cx->lastProxyRequestTime;
+			// Without a usable lease there is nothing to keep fresh but the contact with the proxies
+			state double refreshBound = cx->getGrvCacheLease() > grvDelay ? cx->getGrvCacheLease() - grvDelay
+			                                                                : std::numeric_limits<double>::max();
 			TraceEvent(SevDebug, "BackgroundGrvUpdaterBefore")
 			    .detail("CurTime", curTime)
 			    .detail("LastTime", lastTime)
@@ -1282,8 +1374,8 @@ ACTOR static Future<Void> backgroundGrvUpdater(DatabaseContext* cx) {
 			    .detail("CachedReadVersion", cx->getCachedReadVersion())
 			    .detail("CachedTime", cx->getLastGrvTime())
 			    .detail("Gap", curTime - lastTime)
-			    .detail("Bound", CLIENT_KNOBS->MAX_VERSION_CACHE_LAG - grvDelay);
-			if (curTime - lastTime >= (CLIENT_KNOBS->MAX_VERSION_CACHE_LAG - grvDelay) ||
+			    .detail("Bound", refreshBound);
+			if (curTime - lastTime >= refreshBound ||
 			    curTime - lastProxyTime > CLIENT_KNOBS->MAX_PROXY_CONTACT_LAG) {
 				try {
 					tr.setOption(FDBTransactionOptions::SKIP_GRV_CACHE);
@@ -1304,7 +1396,7 @@ ACTOR static Future<Void> backgroundGrvUpdater(DatabaseContext* cx) {
 				wait(
 				    delay(std::max(0.001,
 				                   std::min(CLIENT_KNOBS->MAX_PROXY_CONTACT_LAG - (curTime - lastProxyTime),
-				                            (CLIENT_KNOBS->MAX_VERSION_CACHE_LAG - grvDelay) - (curTime - lastTime)))));
+				                            refreshBound - (curTime - lastTime)))));
 			}
 		}
 	} catch (Error& e) {
@@ -1485,6 +1577,46 @@ Future<RangeResult> HealthMetricsRangeImpl::getRange(ReadYourWritesTransaction*
 	return healthMetricsGetRangeActor(ryw, kr);
 }
 
+// "\xff\xff/metrics/hot_keys/<key>" := json with the estimated reads and writes per second of the keys that storage
+// servers count among their most frequent
+class HotKeysRangeImpl : public SpecialKeyRangeAsyncImpl {
+public:
+	explicit HotKeysRangeImpl(KeyRangeRef kr);
+	Future<RangeResult> getRange(ReadYourWritesTransaction* ryw,
+	                             KeyRangeRef kr,
+	                             GetRangeLimits limitsHint) const override;
+};
+
+ACTOR static Future<RangeResult> hotKeysGetRangeActor(ReadYourWritesTransaction* ryw,
+                                                      KeyRangeRef prefix,
+                                                      KeyRangeRef kr) {
+	state KeyRange keys = kr.removePrefix(prefix.begin) & allKeys;
+	if (keys.empty()) {
+		return RangeResult();
+	}
+	Standalone<VectorRef<HotKeyRef>> hotKeys = wait(ryw->getDatabase()->getHotKeys(keys));
+	RangeResult result;
+	for (auto const& hotKey : hotKeys) {
+		json_spirit::mObject statsObj;
+		statsObj["reads_per_second"] = hotKey.readsPerSecond;
+		statsObj["writes_per_second"] = hotKey.writesPerSecond;
+		std::string statsString =
+		    json_spirit::write_string(json_spirit::mValue(statsObj), json_spirit::Output_options::raw_utf8);
+		result.push_back(result.arena(),
+		                 KeyValueRef(hotKey.key.withPrefix(prefix.begin, result.arena()),
+		                             ValueRef(result.arena(), statsString)));
+	}
+	return result;
+}
+
+HotKeysRangeImpl::HotKeysRangeImpl(KeyRangeRef kr) : SpecialKeyRangeAsyncImpl(kr) {}
+
+Future<RangeResult> HotKeysRangeImpl::getRange(ReadYourWritesTransaction* ryw,
+                                               KeyRangeRef kr,
+                                               GetRangeLimits limitsHint) const {
+	return hotKeysGetRangeActor(ryw, getKeyRange(), kr);
+}
+
 ACTOR Future<UID> getClusterId(Database db) {
 	while (!db->clientInfo->get().clusterId.isValid()) {
 		wait(db->clientInfo->onChange());
@@ -1525,6 +1657,7 @@ DatabaseContext::DatabaseContext(Reference<AsyncVar<Reference<IClusterConnection
     transactionGetRangeStreamRequests("GetRangeStreamRequests", cc), transactionWatchRequests("WatchRequests", cc),
     transactionGetAddressesForKeyRequests("GetAddressesForKeyRequests", cc), transactionBytesRead("BytesRead", cc),
     transactionKeysRead("KeysRead", cc), transactionMetadataVersionReads("MetadataVersionReads", cc),
+    transactionImmutableValueCacheHits("ImmutableValueCacheHits", cc),
     transactionCommittedMutations("CommittedMutations", cc),
     transactionCommittedMutationBytes("CommittedMutationBytes", cc), transactionSetMutations("SetMutations", cc),
     transactionClearMutations("ClearMutations", cc), transactionAtomicMutations("AtomicMutations", cc),
@@ -1578,6 +1711,9 @@ DatabaseContext::DatabaseContext(Reference<AsyncVar<Reference<IClusterConnection
 	clientDBInfoMonitor = monitorClientDBInfoChange(this, clientInfo, &proxiesChangeTrigger);
 	tssMismatchHandler = handleTssMismatches(this);
 	clientStatusUpdater.actor = clientStatusUpdateActor(this);
+	if (!CLIENT_KNOBS->TRAFFIC_CAPTURE_FILE.empty()) {
+		trafficCapture.actor = trafficCaptureActor(this);
+	}
 	cacheListMonitor = monitorCacheList(this);
 
 	smoothMidShardSize.reset(CLIENT_KNOBS->INIT_MID_SHARD_BYTES);
@@ -1724,6 +1860,9 @@ DatabaseContext::DatabaseContext(Reference<AsyncVar<Reference<IClusterConnection
 		                        SpecialKeySpace::IMPLTYPE::READONLY,
 		                        std::make_unique<HealthMetricsRangeImpl>(
 		                            KeyRangeRef("\xff\xff/metrics/health/"_sr, "\xff\xff/metrics/health0"_sr)));
+		registerSpecialKeysImpl(SpecialKeySpace::MODULE::METRICS,
+		                        SpecialKeySpace::IMPLTYPE::READONLY,
+		                        std::make_unique<HotKeysRangeImpl>(hotKeysRange));
 		registerSpecialKeysImpl(SpecialKeySpace::MODULE::WORKERINTERFACE,
 		                        SpecialKeySpace::IMPLTYPE::READONLY,
 		                        std::make_unique<WorkerInterfacesSpecialKeyImpl>(
@@ -1734,8 +1873,12 @@ DatabaseContext::DatabaseContext(Reference<AsyncVar<Reference<IClusterConnection
 		                            "\xff\xff/status/json"_sr,
 		                            [](ReadYourWritesTransaction* ryw) -> Future<Optional<Value>> {
 			                            if (ryw->getDatabase().getPtr() && ryw->getDatabase()->getConnectionRecord()) {
-				                            ++ryw->getDatabase()->transactionStatusRequests;
-				                            return getJSON(ryw->getDatabase());
+				                            Database db = ryw->getDatabase();
+				                            ++db->transactionStatusRequests;
+				                            return DatabaseContext::getSharedResult<Optional<Value>>(
+				                                db->sharedStatusJson, db->sharedStatusJsonTime, [db]() {
+					                                return getJSON(db);
+				                                });
 			                            } else {
 				                            return Optional<Value>();
 			                            }
@@ -1827,6 +1970,7 @@ DatabaseContext::DatabaseContext(const Error& err)
     transactionGetRangeStreamRequests("GetRangeStreamRequests", cc), transactionWatchRequests("WatchRequests", cc),
     transactionGetAddressesForKeyRequests("GetAddressesForKeyRequests", cc), transactionBytesRead("BytesRead", cc),
     transactionKeysRead("KeysRead", cc), transactionMetadataVersionReads("MetadataVersionReads", cc),
+    transactionImmutableValueCacheHits("ImmutableValueCacheHits", cc),
     transactionCommittedMutations("CommittedMutations", cc),
     transactionCommittedMutationBytes("CommittedMutationBytes", cc), transactionSetMutations("SetMutations", cc),
     transactionClearMutations("ClearMutations", cc), transactionAtomicMutations("AtomicMutations", cc),
@@ -2124,6 +2268,10 @@ void DatabaseContext::setOption(FDBDatabaseOptions::Option option, Optional<Stri
 			validateOptionValueNotPresent(value);
 			useConfigDatabase = true;
 			break;
+		case FDBDatabaseOptions::IMMUTABLE_KEY_PREFIX:
+			validateOptionValuePresent(value);
+			immutableKeyPrefixes.push_back(value.get());
+			break;
 		case FDBDatabaseOptions::TEST_CAUSAL_READ_RISKY:
 			verifyCausalReadsProp = double(extractIntOption(value, 0, 100)) / 100.0;
 			break;
@@ -2161,6 +2309,9 @@ ACTOR static Future<Void> switchConnectionRecordImpl(Reference<IClusterConnectio
 	self->grvProxies.clear();
 	self->minAcceptableReadVersion = std::numeric_limits<Version>::max();
 	self->invalidateCache({}, allKeys);
+	self->immutableValueCache.clear();
+	self->immutableValueCacheOrder.clear();
+	self->immutableValueCacheBytes = 0;
 
 	self->ssVersionVectorCache.clear();
 
@@ -2982,6 +3133,11 @@ ACTOR Future<KeyRangeLocationInfo> getKeyLocation_internal(Database cx,
 	if (debugID.present())
 		g_traceBatch.addEvent("TransactionDebug", debugID.get().first(), "NativeAPI.getKeyLocation.Before");
 
+	// A forward lookup also caches the shards that follow the key, so that a scan or a burst of nearby reads (after a
+	// restart or a shard split) doesn't send a request to the proxies for every shard it touches
+	state int prefetchShards = isBackward ? 1 : std::max(1, CLIENT_KNOBS->LOCATION_CACHE_PREFETCH_SHARDS);
+	state Optional<KeyRef> prefetchEnd = prefetchShards > 1 ? allKeys.end : Optional<KeyRef>();
+
 	loop {
 		++cx->transactionKeyServerLocationRequests;
 		choose {
@@ -2989,14 +3145,24 @@ ACTOR Future<KeyRangeLocationInfo> getKeyLocation_internal(Database cx,
 			when(GetKeyServerLocationsReply rep = wait(basicLoadBalance(
 			         cx->getCommitProxies(useProvisionalProxies),
 			         &CommitProxyInterface::getKeyServersLocations,
-			         GetKeyServerLocationsRequest(
-			             span.context, tenant, key, Optional<KeyRef>(), 100, isBackward, version, key.arena()),
+			         GetKeyServerLocationsRequest(span.context,
+			                                      tenant,
+			                                      key,
+			                                      prefetchEnd,
+			                                      prefetchShards > 1 ? prefetchShards : 100,
+			                                      isBackward,
+			                                      version,
+			                                      key.arena()),
 			         TaskPriority::DefaultPromiseEndpoint))) {
 				++cx->transactionKeyServerLocationRequestsCompleted;
 				if (debugID.present())
 					g_traceBatch.addEvent("TransactionDebug", debugID.get().first(), "NativeAPI.getKeyLocation.After");
-				ASSERT(rep.results.size() == 1);
+				ASSERT(rep.results.size() >= 1 && rep.results.size() <= prefetchShards);
 
+				// The shard containing the key is cached last, so that making room for its neighbors can't evict it
+				for (int i = rep.results.size() - 1; i > 0; i--) {
+					cx->setCachedLocation(rep.results[i].first, rep.results[i].second);
+				}
 				auto locationInfo = cx->setCachedLocation(rep.results[0].first, rep.results[0].second);
 				updateTssMappings(cx, rep);
 				updateTagMappings(cx, rep);
@@ -3487,6 +3653,118 @@ Future<Void> Transaction::warmRange(KeyRange keys) {
 	return warmRange_impl(trState, keys);
 }
 
+// The point reads of a transaction to one shard that were issued in the same run loop tick.  They are sent together
+// in one GetValuesRequest once the tick is over, and each read picks its own key out of the reply.
+struct GetValuesBatch : ReferenceCounted<GetValuesBatch> {
+	KeyRangeLocationInfo locationInfo;
+	GetValuesRequest request;
+	Promise<GetValuesReply> reply;
+};
+
+struct GetValuesCoalescer {
+	// Batches still accepting keys, by the beginning of their shard and whether they read inside the tenant
+	std::map<std::pair<Key, bool>, Reference<GetValuesBatch>> open;
+	// Cancelled with the transaction state, which outlives every read waiting on a batch
+	ActorCollection senders;
+};
+
+// Reads the only key of a batch with a GetValueRequest, the way it would have been read without coalescing
+ACTOR Future<GetValuesReply> getLoneValue(Database cx, Reference<GetValuesBatch> batch) {
+	GetValueReply reply = wait(loadBalance(cx.getPtr(),
+	                                       batch->locationInfo.locations,
+	                                       &StorageServerInterface::getValue,
+	                                       GetValueRequest(batch->request.spanContext,
+	                                                       batch->request.tenantInfo,
+	                                                       Key(batch->request.keys[0], batch->request.arena),
+	                                                       batch->request.version,
+	                                                       batch->request.tags,
+	                                                       batch->request.options,
+	                                                       batch->request.ssLatestCommitVersions),
+	                                       TaskPriority::DefaultPromiseEndpoint,
+	                                       AtMostOnce::False,
+	                                       cx->enableLocalityLoadBalance ? &cx->queueModel : nullptr));
+	GetValuesReply values;
+	if (reply.value.present()) {
+		values.data.push_back_deep(values.arena, KeyValueRef(batch->request.keys[0], reply.value.get()));
+	}
+	values.cached = reply.cached;
+	return values;
+}
+
+ACTOR Future<Void> sendGetValuesBatch(Database cx,
+                                      GetValuesCoalescer* coalescer,
+                                      std::pair<Key, bool> slot,
+                                      Reference<GetValuesBatch> batch,
+                                      TaskPriority taskID) {
+	wait(delay(0, taskID));
+	auto it = coalescer->open.find(slot);
+	if (it != coalescer->open.end() && it->second == batch) {
+		coalescer->open.erase(it);
+	}
+
+	// The reply holds the keys in request order, which the reads binary search
+	VectorRef<KeyRef>& keys = batch->request.keys;
+	std::sort(keys.begin(), keys.end());
+	keys.resize(batch->request.arena, std::unique(keys.begin(), keys.end()) - keys.begin());
+
+	++cx->transactionPhysicalReads;
+	try {
+		state Future<GetValuesReply> read =
+		    keys.size() == 1 ? getLoneValue(cx, batch)
+		                     : loadBalance(cx.getPtr(),
+		                                   batch->locationInfo.locations,
+		                                   &StorageServerInterface::getValues,
+		                                   batch->request,
+		                                   TaskPriority::DefaultPromiseEndpoint,
+		                                   AtMostOnce::False,
+		                                   cx->enableLocalityLoadBalance ? &cx->queueModel : nullptr);
+		choose {
+			when(wait(cx->connectionFileChanged())) {
+				throw transaction_too_old();
+			}
+			when(GetValuesReply reply = wait(read)) {
+				++cx->transactionPhysicalReadsCompleted;
+				batch->reply.send(reply);
+			}
+		}
+	} catch (Error& e) {
+		if (e.code() == error_code_actor_cancelled)
+			throw;
+		++cx->transactionPhysicalReadsCompleted;
+		batch->reply.sendError(e);
+	}
+	return Void();
+}
+
+// Adds key to the open batch for the shard of locationInfo, opening one if needed, and returns the reply of the batch
+Future<GetValuesReply> joinGetValuesBatch(Reference<TransactionState> trState,
+                                          const KeyRangeLocationInfo& locationInfo,
+                                          const Key& key,
+                                          UseTenant useTenant,
+                                          SpanContext spanContext,
+                                          const Optional<ReadOptions>& readOptions,
+                                          const VersionVector& ssLatestCommitVersions) {
+	if (!trState->getValuesCoalescer) {
+		trState->getValuesCoalescer = std::make_shared<GetValuesCoalescer>();
+	}
+	GetValuesCoalescer* coalescer = trState->getValuesCoalescer.get();
+	std::pair<Key, bool> slot(locationInfo.range.begin, useTenant);
+	Reference<GetValuesBatch>& batch = coalescer->open[slot];
+	if (!batch || batch->request.keys.size() >= CLIENT_KNOBS->GET_VALUES_MAX_KEYS) {
+		batch = makeReference<GetValuesBatch>();
+		batch->locationInfo = locationInfo;
+		batch->request.spanContext = spanContext;
+		batch->request.tenantInfo = useTenant ? trState->getTenantInfo() : TenantInfo();
+		batch->request.version = trState->readVersion();
+		batch->request.tags = trState->cx->sampleReadTags() ? trState->options.readTags : Optional<TagSet>();
+		batch->request.options = readOptions;
+		batch->request.ssLatestCommitVersions = ssLatestCommitVersions;
+		coalescer->senders.add(sendGetValuesBatch(trState->cx, coalescer, slot, batch, trState->taskID));
+	}
+	batch->request.keys.push_back_deep(batch->request.arena, key);
+	return batch->reply.getFuture();
+}
+
 ACTOR Future<Optional<Value>> getValue(Reference<TransactionState> trState,
                                        Key key,
                                        UseTenant useTenant,
@@ -3500,6 +3778,7 @@ ACTOR Future<Optional<Value>> getValue(Reference<TransactionState> trState,
 	}
 
 	trState->cx->validateVersion(trState->readVersion());
+	state double queueStart = now();
 
 	loop {
 		state KeyRangeLocationInfo locationInfo =
@@ -3531,40 +3810,59 @@ ACTOR Future<Optional<Value>> getValue(Reference<TransactionState> trState,
 			++trState->cx->getValueSubmitted;
 			startTime = timer_int();
 			startTimeD = now();
-			++trState->cx->transactionPhysicalReads;
 
 			state GetValueReply reply;
-			try {
+			if (CLIENT_KNOBS->COALESCE_GET_VALUES && !getValueID.present()) {
 				if (CLIENT_BUGGIFY_WITH_PROB(.01)) {
 					throw deterministicRandom()->randomChoice(
 					    std::vector<Error>{ transaction_too_old(), future_version() });
 				}
-				choose {
-					when(wait(trState->cx->connectionFileChanged())) {
-						throw transaction_too_old();
+				GetValuesReply values = wait(joinGetValuesBatch(
+				    trState, locationInfo, key, useTenant, span.context, readOptions, ssLatestCommitVersions));
+				auto kv = std::lower_bound(values.data.begin(), values.data.end(), key, KeyValueRef::OrderByKey());
+				if (kv != values.data.end() && kv->key == key) {
+					reply.value = Value(kv->value, values.arena);
+				}
+			} else {
+				++trState->cx->transactionPhysicalReads;
+				try {
+					if (CLIENT_BUGGIFY_WITH_PROB(.01)) {
+						throw deterministicRandom()->randomChoice(
+						    std::vector<Error>{ transaction_too_old(), future_version() });
 					}
-					when(GetValueReply _reply = wait(loadBalance(
-					         trState->cx.getPtr(),
-					         locationInfo.locations,
-					         &StorageServerInterface::getValue,
-					         GetValueRequest(span.context,
-					                         useTenant ? trState->getTenantInfo() : TenantInfo(),
-					                         key,
-					                         trState->readVersion(),
-					                         trState->cx->sampleReadTags() ? trState->options.readTags
-					                                                       : Optional<TagSet>(),
-					                         readOptions,
-					                         ssLatestCommitVersions),
-					         TaskPriority::DefaultPromiseEndpoint,
-					         AtMostOnce::False,
-					         trState->cx->enableLocalityLoadBalance ? &trState->cx->queueModel : nullptr))) {
-						reply = _reply;
+					if (deterministicRandom()->random01() < CLIENT_KNOBS->LATENCY_BREAKDOWN_SAMPLE_RATE) {
+						if (!readOptions.present()) {
+							readOptions = ReadOptions();
+						}
+						readOptions.get().clientQueueTime = now() - queueStart;
 					}
+					choose {
+						when(wait(trState->cx->connectionFileChanged())) {
+							throw transaction_too_old();
+						}
+						when(GetValueReply _reply = wait(loadBalance(
+						         trState->cx.getPtr(),
+						         locationInfo.locations,
+						         &StorageServerInterface::getValue,
+						         GetValueRequest(span.context,
+						                         useTenant ? trState->getTenantInfo() : TenantInfo(),
+						                         key,
+						                         trState->readVersion(),
+						                         trState->cx->sampleReadTags() ? trState->options.readTags
+						                                                       : Optional<TagSet>(),
+						                         readOptions,
+						                         ssLatestCommitVersions),
+						         TaskPriority::DefaultPromiseEndpoint,
+						         AtMostOnce::False,
+						         trState->cx->enableLocalityLoadBalance ? &trState->cx->queueModel : nullptr))) {
+							reply = _reply;
+						}
+					}
+					++trState->cx->transactionPhysicalReadsCompleted;
+				} catch (Error&) {
+					++trState->cx->transactionPhysicalReadsCompleted;
+					throw;
 				}
-				++trState->cx->transactionPhysicalReadsCompleted;
-			} catch (Error&) {
-				++trState->cx->transactionPhysicalReadsCompleted;
-				throw;
 			}
 
 			double latency = now() - startTimeD;
@@ -4139,6 +4437,7 @@ ACTOR template <class GetKeyValuesFamilyRequest, class GetKeyValuesFamilyReply,
 Future<RangeResultFamily> getExactRange(Reference<TransactionState> trState,
                                         KeyRange keys,
                                         Key mapper,
+                                        Key filter,
                                         GetRangeLimits limits,
                                         int matchIndex,
                                         Reverse reverse,
@@ -4169,6 +4468,8 @@ Future<RangeResultFamily> getExactRange(Reference<TransactionState> trState,
 			GetKeyValuesFamilyRequest req;
 			req.mapper = mapper;
 			req.arena.dependsOn(mapper.arena());
+			req.filter = filter;
+			req.arena.dependsOn(filter.arena());
 
 			req.tenantInfo = useTenant ? trState->getTenantInfo() : TenantInfo();
 			req.version = trState->readVersion();
@@ -4254,7 +4555,7 @@ Future<RangeResultFamily> getExactRange(Reference<TransactionState> trState,
 					more = false;
 
 				if (more) {
-					if (!rep.data.size()) {
+					if (!rep.data.size() && !rep.readThrough.present()) {
 						TraceEvent(SevError, "GetExactRangeError")
 						    .detail("Reason", "More data indicated but no rows present")
 						    .detail("LimitBytes", limits.bytes)
@@ -4266,8 +4567,16 @@ Future<RangeResultFamily> getExactRange(Reference<TransactionState> trState,
 						ASSERT(false);
 					}
 					CODE_PROBE(true, "GetKeyValuesFamilyReply.more in getExactRange");
-					// Make next request to the same shard with a beginning key just after the last key returned
-					if (reverse)
+					// Make next request to the same shard with a beginning key just after the last key returned, or
+					// for a filtered read just after the last key examined
+					if (rep.readThrough.present()) {
+						if (reverse)
+							locations[shard].range =
+							    KeyRangeRef(locations[shard].range.begin, rep.readThrough.get());
+						else
+							locations[shard].range =
+							    KeyRangeRef(rep.readThrough.get(), locations[shard].range.end);
+					} else if (reverse)
 						locations[shard].range =
 						    KeyRangeRef(locations[shard].range.begin, output[output.size() - 1].key);
 					else
@@ -4345,6 +4654,7 @@ Future<RangeResultFamily> getRangeFallback(Reference<TransactionState> trState,
                                            KeySelector begin,
                                            KeySelector end,
                                            Key mapper,
+                                           Key filter,
                                            GetRangeLimits limits,
                                            int matchIndex,
                                            Reverse reverse,
@@ -4363,7 +4673,7 @@ Future<RangeResultFamily> getRangeFallback(Reference<TransactionState> trState,
 	// or allKeys.begin exists in the database/tenant and will be part of the conflict range anyways
 
 	RangeResultFamily _r = wait(getExactRange<GetKeyValuesFamilyRequest, GetKeyValuesFamilyReply, RangeResultFamily>(
-	    trState, KeyRangeRef(b, e), mapper, limits, matchIndex, reverse, useTenant));
+	    trState, KeyRangeRef(b, e), mapper, filter, limits, matchIndex, reverse, useTenant));
 	RangeResultFamily r = _r;
 
 	if (b == allKeys.begin && ((reverse && !r.more) || !reverse))
@@ -4484,6 +4794,7 @@ Future<RangeResultFamily> getRange(Reference<TransactionState> trState,
                                    KeySelector begin,
                                    KeySelector end,
                                    Key mapper,
+                                   Key filter,
                                    GetRangeLimits limits,
                                    Promise<std::pair<Key, Key>> conflictRange,
                                    int matchIndex,
@@ -4532,6 +4843,8 @@ Future<RangeResultFamily> getRange(Reference<TransactionState> trState,
 			state GetKeyValuesFamilyRequest req;
 			req.mapper = mapper;
 			req.arena.dependsOn(mapper.arena());
+			req.filter = filter;
+			req.arena.dependsOn(filter.arena());
 			setMatchIndex<GetKeyValuesFamilyRequest>(req, matchIndex);
 			req.tenantInfo = useTenant ? trState->getTenantInfo() : TenantInfo();
 			req.options = trState->readOptions;
@@ -4631,7 +4944,7 @@ Future<RangeResultFamily> getRange(Reference<TransactionState> trState,
 					    .detail("RowsReturned", rep.data.size());*/
 				}
 
-				ASSERT(!rep.more || rep.data.size());
+				ASSERT(!rep.more || rep.data.size() || rep.readThrough.present());
 				ASSERT(!limits.hasRowLimit() || rep.data.size() <= limits.rows);
 
 				limits.decrement(rep.data);
@@ -4641,7 +4954,9 @@ Future<RangeResultFamily> getRange(Reference<TransactionState> trState,
 					modifiedSelectors = false;
 				}
 
-				bool finished = limits.isReached() || (!modifiedSelectors && !rep.more) || limits.hasSatisfiedMinRows();
+				// A filtered read may return no rows but more, and then there is nothing to return yet
+				bool finished = limits.isReached() || (!modifiedSelectors && !rep.more) ||
+				                (limits.hasSatisfiedMinRows() && !(rep.more && rep.data.empty()));
 				bool readThrough = modifiedSelectors && !rep.more;
 
 				// optimization: first request got all data--just return it
@@ -4710,6 +5025,7 @@ Future<RangeResultFamily> getRange(Reference<TransactionState> trState,
 						        originalBegin,
 						        originalEnd,
 						        mapper,
+						        filter,
 						        originalLimits,
 						        matchIndex,
 						        reverse,
@@ -4725,7 +5041,13 @@ Future<RangeResultFamily> getRange(Reference<TransactionState> trState,
 						begin = firstGreaterOrEqual(shard.end);
 				} else {
 					CODE_PROBE(true, "GetKeyValuesFamilyReply.more in getRange");
-					if (reverse)
+					if (rep.readThrough.present()) {
+						// A filtered read examined rows past the last one it returned
+						if (reverse)
+							end = firstGreaterOrEqual(rep.readThrough.get());
+						else
+							begin = firstGreaterOrEqual(rep.readThrough.get());
+					} else if (reverse)
 						end = firstGreaterOrEqual(output[output.size() - 1].key);
 					else
 						begin = firstGreaterThan(output[output.size() - 1].key);
@@ -4749,6 +5071,7 @@ Future<RangeResultFamily> getRange(Reference<TransactionState> trState,
 						        originalBegin,
 						        originalEnd,
 						        mapper,
+						        filter,
 						        originalLimits,
 						        matchIndex,
 						        reverse,
@@ -5232,6 +5555,19 @@ static KeyRange intersect(KeyRangeRef lhs, KeyRangeRef rhs) {
 	return KeyRange(KeyRangeRef(std::max(lhs.begin, rhs.begin), std::min(lhs.end, rhs.end)));
 }
 
+// Returns the split points of the part of [b, e) in the first shard (the last, if reverse), which start at the
+// beginning of that part and end at its end
+ACTOR Future<Standalone<VectorRef<KeyRef>>> getRangeStreamShard(Reference<TransactionState> trState,
+                                                                Key b,
+                                                                Key e,
+                                                                Reverse reverse) {
+	KeyRangeLocationInfo locationInfo = wait(
+	    getKeyLocation(trState, reverse ? e : b, &StorageServerInterface::getKeyValuesStream, reverse, UseTenant::True));
+	Standalone<VectorRef<KeyRef>> splitPoints = wait(getRangeSplitPoints(
+	    trState, intersect(locationInfo.range, KeyRangeRef(b, e)), CLIENT_KNOBS->RANGESTREAM_FRAGMENT_SIZE));
+	return splitPoints;
+}
+
 // Divides the requested key range into 1MB fragments, create range streams for each fragment, and merges the results so
 // the client get them in order
 ACTOR Future<Void> getRangeStream(Reference<TransactionState> trState,
@@ -5273,13 +5609,21 @@ ACTOR Future<Void> getRangeStream(Reference<TransactionState> trState,
 	// or allKeys.begin exists in the database and will be part of the conflict range anyways
 
 	state std::vector<Future<Void>> outstandingRequests;
+	state Future<Standalone<VectorRef<KeyRef>>> nextShard = getRangeStreamShard(trState, b, e, reverse);
 	while (b < e) {
-		state KeyRangeLocationInfo locationInfo = wait(getKeyLocation(
-		    trState, reverse ? e : b, &StorageServerInterface::getKeyValuesStream, reverse, UseTenant::True));
-		state KeyRange shardIntersection = intersect(locationInfo.range, KeyRangeRef(b, e));
-		state Standalone<VectorRef<KeyRef>> splitPoints =
-		    wait(getRangeSplitPoints(trState, shardIntersection, CLIENT_KNOBS->RANGESTREAM_FRAGMENT_SIZE));
+		state Standalone<VectorRef<KeyRef>> splitPoints = wait(nextShard);
+		state KeyRange shardIntersection = KeyRangeRef(splitPoints.front(), splitPoints.back());
 		state std::vector<KeyRange> toSend;
+
+		// Look up the next shard while this one's fragments wait for room in the stream
+		if (reverse) {
+			e = shardIntersection.begin;
+		} else {
+			b = shardIntersection.end;
+		}
+		if (b < e) {
+			nextShard = getRangeStreamShard(trState, b, e, reverse);
+		}
 		// state std::vector<Future<std::list<KeyRangeRef>::iterator>> outstandingRequests;
 
 		if (!splitPoints.empty()) {
@@ -5303,11 +5647,6 @@ ACTOR Future<Void> getRangeStream(Reference<TransactionState> trState,
 			outstandingRequests.push_back(
 			    getRangeStreamFragment(trState, fragment, toSend[useIdx], limits, snapshot, reverse, span.context));
 		}
-		if (reverse) {
-			e = shardIntersection.begin;
-		} else {
-			b = shardIntersection.end;
-		}
 	}
 	wait(waitForAll(outstandingRequests) && results.finish());
 	return Void();
@@ -5323,6 +5662,7 @@ Future<RangeResult> getRange(Reference<TransactionState> const& trState,
 	                                                                     begin,
 	                                                                     end,
 	                                                                     ""_sr,
+	                                                                     ""_sr,
 	                                                                     limits,
 	                                                                     Promise<std::pair<Key, Key>>(),
 	                                                                     MATCH_INDEX_ALL,
@@ -5397,6 +5737,15 @@ void Transaction::flushTrLogsIfEnabled() {
 		    { trState->trLogInfo->identifier, std::move(trState->trLogInfo->trLogWriter) });
 		trState->trLogInfo->flushed = true;
 	}
+	if (trState && trState->trLogInfo && !trState->trLogInfo->capture.ops.empty()) {
+		auto& capture = trState->trLogInfo->capture;
+		if (!trState->cx->trafficCapture.failed) {
+			capture.finish();
+			trState->cx->trafficCapture.queue.push_back(std::move(capture));
+		}
+		capture = FdbClientLogEvents::CapturedTransaction();
+		trState->trLogInfo->flushed = true;
+	}
 }
 
 VersionVector Transaction::getVersionVector() const {
@@ -5414,6 +5763,15 @@ void Transaction::setVersion(Version v) {
 	trState->readVersionObtainedFromGrvProxy = false;
 }
 
+ACTOR Future<Optional<Value>> getAndCacheImmutableValue(Reference<TransactionState> trState, Key key) {
+	Optional<Value> value = wait(getValue(trState, key, UseTenant::True));
+	// A key that is not set yet may still be written, so only present values are cached
+	if (value.present()) {
+		trState->cx->addImmutableValue(key, value.get(), trState->readVersion());
+	}
+	return value;
+}
+
 Future<Optional<Value>> Transaction::get(const Key& key, Snapshot snapshot) {
 	++trState->cx->transactionLogicalReads;
 	++trState->cx->transactionGetValueRequests;
@@ -5471,6 +5829,18 @@ Future<Optional<Value>> Transaction::get(const Key& key, Snapshot snapshot) {
 		}
 	}
 
+	// The cache is keyed without a tenant prefix, so it is only used by transactions that are not using a tenant
+	if (!trState->cx->immutableKeyPrefixes.empty() && !trState->hasTenant() && trState->cx->isImmutableKey(key)) {
+		if (ver.isReady() && !ver.isError()) {
+			Optional<Value> cached = trState->cx->getImmutableValue(key, ver.get());
+			if (cached.present()) {
+				++trState->cx->transactionImmutableValueCacheHits;
+				return cached;
+			}
+		}
+		return getAndCacheImmutableValue(trState, key);
+	}
+
 	return getValue(trState, key, useTenant);
 }
 
@@ -5692,6 +6062,7 @@ template <class GetKeyValuesFamilyRequest, class GetKeyValuesFamilyReply, class
 Future<RangeResultFamily> Transaction::getRangeInternal(const KeySelector& begin,
                                                         const KeySelector& end,
                                                         const Key& mapper,
+                                                        const Key& filter,
                                                         GetRangeLimits limits,
                                                         int matchIndex,
                                                         Snapshot snapshot,
@@ -5736,7 +6107,7 @@ Future<RangeResultFamily> Transaction::getRangeInternal(const KeySelector& begin
 	}
 
 	return ::getRange<GetKeyValuesFamilyRequest, GetKeyValuesFamilyReply, RangeResultFamily>(
-	    trState, b, e, mapper, limits, conflictRange, matchIndex, snapshot, reverse);
+	    trState, b, e, mapper, filter, limits, conflictRange, matchIndex, snapshot, reverse);
 }
 
 Future<RangeResult> Transaction::getRange(const KeySelector& begin,
@@ -5745,7 +6116,17 @@ Future<RangeResult> Transaction::getRange(const KeySelector& begin,
                                           Snapshot snapshot,
                                           Reverse reverse) {
 	return getRangeInternal<GetKeyValuesRequest, GetKeyValuesReply, RangeResult>(
-	    begin, end, ""_sr, limits, MATCH_INDEX_ALL, snapshot, reverse);
+	    begin, end, ""_sr, ""_sr, limits, MATCH_INDEX_ALL, snapshot, reverse);
+}
+
+Future<RangeResult> Transaction::getFilteredRange(const KeySelector& begin,
+                                                  const KeySelector& end,
+                                                  const Key& filter,
+                                                  GetRangeLimits limits,
+                                                  Snapshot snapshot,
+                                                  Reverse reverse) {
+	return getRangeInternal<GetKeyValuesRequest, GetKeyValuesReply, RangeResult>(
+	    begin, end, ""_sr, filter, limits, MATCH_INDEX_ALL, snapshot, reverse);
 }
 
 Future<MappedRangeResult> Transaction::getMappedRange(const KeySelector& begin,
@@ -5754,9 +6135,10 @@ Future<MappedRangeResult> Transaction::getMappedRange(const KeySelector& begin,
                                                       GetRangeLimits limits,
                                                       int matchIndex,
                                                       Snapshot snapshot,
-                                                      Reverse reverse) {
+                                                      Reverse reverse,
+                                                      const Key& filter) {
 	return getRangeInternal<GetMappedKeyValuesRequest, GetMappedKeyValuesReply, MappedRangeResult>(
-	    begin, end, mapper, limits, matchIndex, snapshot, reverse);
+	    begin, end, mapper, filter, limits, matchIndex, snapshot, reverse);
 }
 
 Future<RangeResult> Transaction::getRange(const KeySelector& begin,
@@ -5951,6 +6333,28 @@ void Transaction::clear(const KeyRef& key, AddConflictRange addConflictRange) {
 	if (addConflictRange)
 		t.write_conflict_ranges.emplace_back(req.arena, KeyRef(data, key.size()), KeyRef(data, key.size() + 1));
 }
+std::pair<Standalone<VectorRef<MutationRef>>, Standalone<VectorRef<KeyRangeRef>>> Transaction::takeWrites() {
+	auto& t = tr.transaction;
+	std::pair<Standalone<VectorRef<MutationRef>>, Standalone<VectorRef<KeyRangeRef>>> writes(
+	    Standalone<VectorRef<MutationRef>>(t.mutations, tr.arena),
+	    Standalone<VectorRef<KeyRangeRef>>(t.write_conflict_ranges, tr.arena));
+
+	// Undo the costs charged by set(), atomicOp() and clear()
+	for (auto const& m : t.mutations) {
+		if (m.type == MutationRef::SetValue) {
+			trState->totalCost -= getWriteOperationCost(m.param1.expectedSize() + m.param2.expectedSize());
+		} else if (m.type == MutationRef::ClearRange) {
+			trState->totalCost -= CLIENT_KNOBS->TAG_THROTTLING_PAGE_SIZE;
+		} else {
+			trState->totalCost -= getWriteOperationCost(m.param1.expectedSize());
+		}
+	}
+
+	t.mutations = VectorRef<MutationRef>();
+	t.write_conflict_ranges = VectorRef<KeyRangeRef>();
+	return writes;
+}
+
 void Transaction::addWriteConflictRange(const KeyRangeRef& keys) {
 	ASSERT(!keys.empty());
 	auto& req = tr;
@@ -6456,6 +6860,102 @@ void applyTenantPrefix(CommitTransactionRequest& req, Key tenantPrefix) {
 	req.transaction.write_conflict_ranges = updatedWriteConflictRanges;
 }
 
+static void sendCommitBatch(DatabaseContext* cx, std::vector<DatabaseContext::CommitRequest>& requests) {
+	CommitTransactionBatchRequest batch;
+	for (auto& r : requests) {
+		// Skip commits that were abandoned while waiting for the batch
+		if (r.sent.getFutureReferenceCount() > 0) {
+			batch.transactions.push_back(r.request);
+			if (r.request.clientQueueTime.present()) {
+				batch.transactions.back().clientQueueTime = r.request.clientQueueTime.get() + now() - r.queued;
+			}
+		}
+	}
+	Reference<CommitProxyInfo> proxies = cx->getCommitProxies(UseProvisionalProxies::False);
+	if (batch.transactions.empty() || !proxies || !proxies->size()) {
+		// Dropping the requests breaks their promises, and the committers then wait for the proxies to change
+		return;
+	}
+
+	// Prefer a proxy that is not known to have failed
+	int chosen = deterministicRandom()->randomInt(0, proxies->size());
+	for (int i = 0; i < proxies->size(); i++) {
+		int alternative = (chosen + i) % proxies->size();
+		Endpoint endpoint = proxies->getInterface(alternative).commitBatch.getEndpoint();
+		if (!IFailureMonitor::failureMonitor().getState(endpoint).failed) {
+			chosen = alternative;
+			break;
+		}
+	}
+	const CommitProxyInterface& proxy = proxies->getInterface(chosen);
+	Reference<Peer> peer = FlowTransport::transport().sendUnreliable(
+	    SerializeSource<CommitTransactionBatchRequest>(batch), proxy.commitBatch.getEndpoint(), true);
+	for (auto& r : requests) {
+		r.sent.send(std::make_pair(proxy, peer));
+	}
+}
+
+ACTOR static Future<Void> commitBatcher(DatabaseContext* cx, FutureStream<DatabaseContext::CommitRequest> commits) {
+	state std::vector<DatabaseContext::CommitRequest> requests;
+	state int64_t bytes = 0;
+	state Future<Void> timeout;
+	state bool sendBatch;
+	loop {
+		sendBatch = false;
+		choose {
+			when(DatabaseContext::CommitRequest req = waitNext(commits)) {
+				bytes += getBytes(req.request);
+				requests.push_back(req);
+				if (requests.size() >= CLIENT_KNOBS->COMMIT_BATCH_MAX_SIZE ||
+				    bytes >= CLIENT_KNOBS->COMMIT_BATCH_MAX_BYTES) {
+					sendBatch = true;
+				} else if (!timeout.isValid()) {
+					// Collect the commits of the rest of this run loop iteration
+					timeout = delay(0, TaskPriority::DefaultPromiseEndpoint);
+				}
+			}
+			when(wait(timeout.isValid() ? timeout : Never())) {
+				sendBatch = true;
+			}
+		}
+		if (sendBatch) {
+			sendCommitBatch(cx, requests);
+			requests.clear();
+			bytes = 0;
+			timeout = Future<Void>();
+		}
+	}
+}
+
+// Sends req to a commit proxy in a batch with the other commits started by this client at about the same time, with
+// the same at most once semantics as tryGetReply()
+ACTOR static Future<ErrorOr<CommitID>> batchedCommit(DatabaseContext* cx, CommitTransactionRequest req) {
+	state DatabaseContext::CommitRequest request(req);
+
+	if (!cx->commitBatcher.actor.isValid()) {
+		cx->commitBatcher.actor = commitBatcher(cx, cx->commitBatcher.stream.getFuture());
+	}
+	req.reply.getEndpoint(TaskPriority::DefaultPromiseEndpoint);
+	cx->commitBatcher.stream.send(request);
+
+	state ErrorOr<std::pair<CommitProxyInterface, Reference<Peer>>> sent = wait(errorOr(request.sent.getFuture()));
+	if (sent.isError()) {
+		if (sent.getError().code() == error_code_broken_promise) {
+			// The batch was not sent, because there were no proxies
+			wait(Never());
+		}
+		throw sent.getError();
+	}
+
+	Endpoint endpoint = sent.get().first.commitBatch.getEndpoint();
+	ErrorOr<CommitID> reply = wait(waitValueOrSignal(req.reply.getFuture(),
+	                                                 IFailureMonitor::failureMonitor().onDisconnectOrFailure(endpoint),
+	                                                 endpoint,
+	                                                 req.reply,
+	                                                 sent.get().second));
+	return reply;
+}
+
 ACTOR static Future<Void> tryCommit(Reference<TransactionState> trState, CommitTransactionRequest req) {
 	state TraceInterval interval("TransactionCommit");
 	state double startTime = now();
@@ -6500,6 +7000,9 @@ ACTOR static Future<Void> tryCommit(Reference<TransactionState> trState, CommitT
 		}
 		CODE_PROBE(trState->skipApplyTenantPrefix, "Tenant prefix prepend skipped for dummy transaction");
 		req.tenantInfo = trState->getTenantInfo();
+		if (deterministicRandom()->random01() < CLIENT_KNOBS->LATENCY_BREAKDOWN_SAMPLE_RATE) {
+			req.clientQueueTime = now() - startTime;
+		}
 		startTime = now();
 		state Optional<UID> commitID = Optional<UID>();
 
@@ -6526,6 +7029,9 @@ ACTOR static Future<Void> tryCommit(Reference<TransactionState> trState, CommitT
 				reply = proxies.size() ? throwErrorOr(brokenPromiseToMaybeDelivered(proxies[0].commit.tryGetReply(req)))
 				                       : Never();
 			}
+		} else if (CLIENT_KNOBS->COMMIT_BATCHING && !trState->useProvisionalProxies &&
+		           !trState->automaticIdempotency) {
+			reply = throwErrorOr(brokenPromiseToMaybeDelivered(batchedCommit(trState->cx.getPtr(), req)));
 		} else {
 			proxiesUsed = trState->cx->getCommitProxies(trState->useProvisionalProxies);
 			reply = basicLoadBalance(proxiesUsed,
@@ -7307,6 +7813,9 @@ ACTOR Future<Version> extractReadVersion(Reference<TransactionState> trState,
 	double latency = replyTime - trState->startTime;
 	trState->cx->lastProxyRequestTime = trState->startTime;
 	trState->cx->updateCachedReadVersion(trState->startTime, rep.version);
+	if (rep.cacheLease.present()) {
+		trState->cx->grvCacheLease = rep.cacheLease;
+	}
 	trState->proxyTagThrottledDuration += rep.proxyTagThrottledDuration;
 	if (rep.rkBatchThrottled) {
 		trState->cx->lastRkBatchThrottleTime = replyTime;
@@ -7411,8 +7920,9 @@ Future<Version> TransactionState::getReadVersion(uint32_t flags) {
 		Version rv = cx->getCachedReadVersion();
 		double lastTime = cx->getLastGrvTime();
 		double requestTime = now();
-		if (requestTime - lastTime <= CLIENT_KNOBS->MAX_VERSION_CACHE_LAG && rv != Version(0)) {
+		if (requestTime - lastTime <= cx->getGrvCacheLease() && rv != Version(0)) {
 			ASSERT(!debug_checkVersionTime(rv, requestTime, "CheckStaleness"));
+			readVersionStaleness = requestTime - lastTime;
 			return rv;
 		} // else go through regular GRV path
 	}
@@ -7891,6 +8401,48 @@ ACTOR Future<Standalone<VectorRef<ReadHotRangeWithMetrics>>> getReadHotRanges(Da
 	}
 }
 
+ACTOR Future<Standalone<VectorRef<HotKeyRef>>> getHotKeys(Database cx, KeyRange keys) {
+	state Span span("NAPI:GetHotKeys"_loc);
+	std::vector<KeyRangeLocationInfo> locations = wait(getKeyRangeLocations(cx,
+	                                                                        TenantInfo(),
+	                                                                        keys,
+	                                                                        CLIENT_KNOBS->TOO_MANY,
+	                                                                        Reverse::False,
+	                                                                        &StorageServerInterface::getHotKeys,
+	                                                                        span.context,
+	                                                                        Optional<UID>(),
+	                                                                        UseProvisionalProxies::False,
+	                                                                        latestVersion));
+	// Every replica of a shard tracks the reads it serves, so ask all of them
+	state std::vector<Future<ErrorOr<GetHotKeysReply>>> replies;
+	for (auto& location : locations) {
+		GetHotKeysRequest req(location.range & keys);
+		for (int i = 0; i < location.locations->size(); i++) {
+			replies.push_back(errorOr(location.locations->getInterface(i).getHotKeys.getReply(req)));
+		}
+	}
+	wait(waitForAll(replies));
+
+	// Reads are spread over the replicas, so their rates add up, while every replica applies every write. Replicas
+	// that failed to answer are left out, since the rates are estimates anyway.
+	std::map<Key, std::pair<double, double>> rates;
+	for (auto const& reply : replies) {
+		if (reply.get().isError()) {
+			continue;
+		}
+		for (auto const& hotKey : reply.get().get().hotKeys) {
+			auto& rate = rates[Key(hotKey.key)];
+			rate.first += hotKey.readsPerSecond;
+			rate.second = std::max(rate.second, hotKey.writesPerSecond);
+		}
+	}
+	Standalone<VectorRef<HotKeyRef>> result;
+	for (auto const& [key, rate] : rates) {
+		result.push_back_deep(result.arena(), HotKeyRef(key, rate.first, rate.second));
+	}
+	return result;
+}
+
 ACTOR Future<Optional<StorageMetrics>> waitStorageMetricsWithLocation(TenantInfo tenantInfo,
                                                                       Version version,
                                                                       KeyRange keys,
@@ -8040,6 +8592,10 @@ Future<Standalone<VectorRef<ReadHotRangeWithMetrics>>> DatabaseContext::getReadH
 	return ::getReadHotRanges(Database(Reference<DatabaseContext>::addRef(this)), keys);
 }
 
+Future<Standalone<VectorRef<HotKeyRef>>> DatabaseContext::getHotKeys(KeyRange const& keys) {
+	return ::getHotKeys(Database(Reference<DatabaseContext>::addRef(this)), keys);
+}
+
 ACTOR Future<Standalone<VectorRef<KeyRef>>> getRangeSplitPoints(Reference<TransactionState> trState,
                                                                 KeyRange keys,
                                                                 int64_t chunkSize) {
@@ -8880,17 +9436,26 @@ void Transaction::checkDeferredError() const {
 }
 
 Reference<TransactionLogInfo> Transaction::createTrLogInfoProbabilistically(const Database& cx) {
+	Reference<TransactionLogInfo> trLogInfo;
 	if (!cx->isError()) {
 		double clientSamplingProbability =
 		    cx->globalConfig->get<double>(fdbClientInfoTxnSampleRate, CLIENT_KNOBS->CSI_SAMPLING_PROBABILITY);
 		if (((networkOptions.logClientInfo.present() && networkOptions.logClientInfo.get()) || BUGGIFY) &&
 		    deterministicRandom()->random01() < clientSamplingProbability &&
 		    (!g_network->isSimulated() || !g_simulator->speedUpSimulation)) {
-			return makeReference<TransactionLogInfo>(TransactionLogInfo::DATABASE);
+			trLogInfo = makeReference<TransactionLogInfo>(TransactionLogInfo::DATABASE);
 		}
 	}
 
-	return Reference<TransactionLogInfo>();
+	if (cx->trafficCapture.actor.isValid() && !cx->trafficCapture.failed &&
+	    deterministicRandom()->random01() < CLIENT_KNOBS->TRAFFIC_CAPTURE_SAMPLE_RATE) {
+		if (trLogInfo) {
+			trLogInfo->logTo(TransactionLogInfo::CAPTURE);
+		} else {
+			trLogInfo = makeReference<TransactionLogInfo>(TransactionLogInfo::CAPTURE);
+		}
+	}
+	return trLogInfo;
 }
 
 void Transaction::setTransactionID(UID id) {
@@ -10823,6 +11388,29 @@ Future<Void> DatabaseContext::popChangeFeedMutations(Key rangeID, Version versio
 	return popChangeFeedMutationsActor(Reference<DatabaseContext>::addRef(this), rangeID, version);
 }
 
+ACTOR Future<Version> watchChangeFeedRangeActor(Reference<DatabaseContext> db,
+                                                Key rangeID,
+                                                KeyRange range,
+                                                Version begin) {
+	state Reference<ChangeFeedData> results = makeReference<ChangeFeedData>();
+	state Future<Void> stream =
+	    db->getChangeFeedStream(results, rangeID, begin, std::numeric_limits<Version>::max(), range);
+	loop {
+		Standalone<VectorRef<MutationsAndVersionRef>> res = waitNext(results->mutations.getFuture());
+		for (auto& it : res) {
+			// Empty batches only advance the feed's version, and a rollback marker is not a change to the range
+			if (!it.mutations.empty() &&
+			    !(it.mutations.size() == 1 && it.mutations.back().param1 == lastEpochEndPrivateKey)) {
+				return it.version;
+			}
+		}
+	}
+}
+
+Future<Version> DatabaseContext::watchChangeFeedRange(Key rangeID, KeyRange range, Version begin) {
+	return watchChangeFeedRangeActor(Reference<DatabaseContext>::addRef(this), rangeID, range, begin);
+}
+
 Reference<DatabaseContext::TransactionT> DatabaseContext::createTransaction() {
 	return makeReference<ReadYourWritesTransaction>(Database(Reference<DatabaseContext>::addRef(this)));
 }
@@ -629,6 +629,49 @@ TEST_CASE("/fdbclient/WriteMap/addValue") {
 	return Void();
 }
 
+// Writes in increasing key order take a shortcut past the tree search, and must build the same map as writes in any
+// other order
+TEST_CASE("/fdbclient/WriteMap/sequentialWrites") {
+	Arena arena = Arena();
+	std::vector<KeyRef> keys;
+	for (int i = 0; i < 200; i++) {
+		keys.push_back(StringRef(arena, format("key%04d", i * 5)));
+	}
+	std::vector<KeyRef> shuffled = keys;
+	deterministicRandom()->randomShuffle(shuffled);
+
+	WriteMap sequential(&arena);
+	WriteMap shuffledWrites(&arena);
+	for (WriteMap* writes : { &sequential, &shuffledWrites }) {
+		writes->clear(KeyRangeRef("key0100"_sr, "key0300"_sr), true);
+		writes->addUnmodifiedAndUnreadableRange(KeyRangeRef("key0500"_sr, "key0600"_sr));
+		for (auto key : writes == &sequential ? keys : shuffled) {
+			bool addConflict = key < "key0700"_sr;
+			writes->mutate(key, MutationRef::AddValue, "1"_sr, addConflict);
+			if (key.endsWith("0"_sr)) {
+				writes->mutate(key, MutationRef::SetValue, key, addConflict);
+			}
+		}
+		writes->mutate("key0999"_sr, MutationRef::SetVersionstampedValue, metadataVersionRequiredValue, true);
+	}
+
+	WriteMap::iterator a(&sequential);
+	WriteMap::iterator b(&shuffledWrites);
+	a.skip(allKeys.begin);
+	b.skip(allKeys.begin);
+	for (; a.beginKey() < allKeys.end; ++a, ++b) {
+		ASSERT(a.beginKey() == b.beginKey() && a.endKey() == b.endKey());
+		ASSERT(a.type() == b.type());
+		ASSERT(a.is_conflict_range() == b.is_conflict_range() && a.is_unreadable() == b.is_unreadable());
+		if (a.is_operation()) {
+			ASSERT(a.op() == b.op());
+		}
+	}
+	ASSERT(b.beginKey() >= allKeys.end);
+
+	return Void();
+}
+
 TEST_CASE("/fdbclient/WriteMap/random") {
 	Arena arena = Arena();
 	WriteMap writes = WriteMap(&arena);
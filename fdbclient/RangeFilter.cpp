@@ -0,0 +1,198 @@
+/*
+ * RangeFilter.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fdbclient/RangeFilter.h"
+#include "fdbclient/Tuple.h"
+#include "flow/UnitTest.h"
+
+RangeFilter::RangeFilter(KeyRef spec) {
+	try {
+		Tuple t = Tuple::unpack(spec);
+		size_t i = 0;
+		auto next = [&]() {
+			if (i >= t.size())
+				throw range_filter_invalid();
+			return i++;
+		};
+		auto nextString = [&]() { return t.getString(next()); };
+		auto nextIndex = [&]() {
+			int64_t index = t.getInt(next());
+			if (index < 0 || index > std::numeric_limits<int>::max())
+				throw range_filter_invalid();
+			return (int)index;
+		};
+
+		while (i < t.size()) {
+			Standalone<StringRef> clause = nextString();
+			if (clause == "key_prefix"_sr || clause == "value_prefix"_sr) {
+				predicates.push_back(Predicate{ clause == "value_prefix"_sr, Op::Prefix, -1, nextString() });
+			} else if (clause == "key"_sr || clause == "value"_sr) {
+				int element = nextIndex();
+				Standalone<StringRef> op = nextString();
+				Op o;
+				if (op == "=="_sr)
+					o = Op::EQ;
+				else if (op == "!="_sr)
+					o = Op::NE;
+				else if (op == "<"_sr)
+					o = Op::LT;
+				else if (op == "<="_sr)
+					o = Op::LE;
+				else if (op == ">"_sr)
+					o = Op::GT;
+				else if (op == ">="_sr)
+					o = Op::GE;
+				else
+					throw range_filter_invalid();
+				predicates.push_back(
+				    Predicate{ clause == "value"_sr, o, element, Standalone<StringRef>(t.subTupleRawString(next())) });
+			} else if (clause == "project"_sr) {
+				if (projectValue)
+					throw range_filter_invalid();
+				projectValue = true;
+				int n = nextIndex();
+				for (int j = 0; j < n; j++)
+					valueElements.push_back(nextIndex());
+			} else if (clause == "keys_only"_sr) {
+				keysOnly = true;
+			} else {
+				throw range_filter_invalid();
+			}
+		}
+	} catch (Error& e) {
+		if (e.code() == error_code_range_filter_invalid)
+			throw;
+		throw range_filter_invalid();
+	}
+}
+
+bool RangeFilter::matches(KeyValueRef kv) const {
+	// Unpack each of the key and value at most once, and only if a predicate needs its elements
+	Optional<Tuple> key, value;
+	bool keyBad = false, valueBad = false;
+	for (const Predicate& p : predicates) {
+		StringRef bytes = p.onValue ? kv.value : kv.key;
+		if (p.op == Op::Prefix) {
+			if (!bytes.startsWith(p.operand))
+				return false;
+			continue;
+		}
+
+		Optional<Tuple>& t = p.onValue ? value : key;
+		bool& bad = p.onValue ? valueBad : keyBad;
+		if (!t.present() && !bad) {
+			try {
+				t = Tuple::unpack(bytes);
+			} catch (Error& e) {
+				bad = true;
+			}
+		}
+		if (bad || p.element >= t.get().size())
+			return false;
+
+		// The tuple encoding preserves the order of elements
+		int c = t.get().subTupleRawString(p.element).compare(p.operand);
+		bool ok;
+		switch (p.op) {
+		case Op::EQ:
+			ok = c == 0;
+			break;
+		case Op::NE:
+			ok = c != 0;
+			break;
+		case Op::LT:
+			ok = c < 0;
+			break;
+		case Op::LE:
+			ok = c <= 0;
+			break;
+		case Op::GT:
+			ok = c > 0;
+			break;
+		default:
+			ok = c >= 0;
+			break;
+		}
+		if (!ok)
+			return false;
+	}
+	return true;
+}
+
+KeyValueRef RangeFilter::project(Arena& arena, KeyValueRef kv) const {
+	if (keysOnly)
+		return KeyValueRef(kv.key, ValueRef());
+	if (!projectValue)
+		return kv;
+
+	Tuple value;
+	try {
+		value = Tuple::unpack(kv.value);
+	} catch (Error& e) {
+		return kv;
+	}
+	Tuple projected;
+	for (int i : valueElements) {
+		if (i < value.size())
+			projected.appendRaw(value.subTupleRawString(i));
+	}
+	return KeyValueRef(kv.key, ValueRef(arena, projected.pack()));
+}
+
+TEST_CASE("/fdbclient/RangeFilter/matches") {
+	Standalone<StringRef> k1 = Tuple::makeTuple("user"_sr, 5).pack();
+	Standalone<StringRef> v1 = Tuple::makeTuple("alice"_sr, 30, "x"_sr).pack();
+	KeyValueRef kv1(k1, v1);
+
+	ASSERT(RangeFilter(""_sr).matches(kv1));
+	ASSERT(RangeFilter(Tuple::makeTuple("key_prefix"_sr, k1.substr(0, 3)).pack()).matches(kv1));
+	ASSERT(!RangeFilter(Tuple::makeTuple("value_prefix"_sr, "z"_sr).pack()).matches(kv1));
+
+	ASSERT(RangeFilter(Tuple::makeTuple("key"_sr, 1, ">="_sr, 5).pack()).matches(kv1));
+	ASSERT(!RangeFilter(Tuple::makeTuple("key"_sr, 1, ">"_sr, 5).pack()).matches(kv1));
+	ASSERT(RangeFilter(Tuple::makeTuple("key"_sr, 1, ">"_sr, -100).pack()).matches(kv1));
+	ASSERT(RangeFilter(Tuple::makeTuple("value"_sr, 1, "<"_sr, 1000).pack()).matches(kv1));
+	ASSERT(RangeFilter(Tuple::makeTuple("value"_sr, 0, "=="_sr, "alice"_sr).pack()).matches(kv1));
+	ASSERT(RangeFilter(Tuple::makeTuple("value"_sr, 0, "!="_sr, "bob"_sr).pack()).matches(kv1));
+	ASSERT(!RangeFilter(Tuple::makeTuple("value"_sr, 0, "=="_sr, "alice"_sr, "value"_sr, 1, "<="_sr, 29).pack())
+	            .matches(kv1));
+	// Missing elements and rows that aren't tuples don't match
+	ASSERT(!RangeFilter(Tuple::makeTuple("value"_sr, 3, "!="_sr, 0).pack()).matches(kv1));
+	ASSERT(!RangeFilter(Tuple::makeTuple("value"_sr, 0, "!="_sr, 0).pack()).matches(KeyValueRef(k1, "\xff\xff"_sr)));
+
+	Arena arena;
+	RangeFilter project(Tuple::makeTuple("project"_sr, 2, 2, 0).pack());
+	ASSERT(project.project(arena, kv1).value == Tuple::makeTuple("x"_sr, "alice"_sr).pack());
+	ASSERT(project.project(arena, KeyValueRef(k1, "\xff"_sr)).value == "\xff"_sr);
+	ASSERT(RangeFilter(Tuple::makeTuple("keys_only"_sr).pack()).project(arena, kv1).value.empty());
+
+	for (Tuple bad : { Tuple::makeTuple("nope"_sr),
+	                   Tuple::makeTuple("key"_sr, 0, "~"_sr, 1),
+	                   Tuple::makeTuple("value"_sr, 0, "=="_sr),
+	                   Tuple::makeTuple("project"_sr, 2, 0) }) {
+		try {
+			RangeFilter f(bad.pack());
+			ASSERT(false);
+		} catch (Error& e) {
+			ASSERT(e.code() == error_code_range_filter_invalid);
+		}
+	}
+	return Void();
+}
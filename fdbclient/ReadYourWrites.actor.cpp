@@ -400,7 +400,9 @@ public:
 	                                                                 Snapshot snapshot) {
 		if (ryw->options.readYourWritesDisabled) {
 			return readWithConflictRangeThrough(ryw, req, snapshot);
-		} else if (snapshot && ryw->options.snapshotRywEnabled <= 0) {
+		}
+		ryw->endBlindWrites();
+		if (snapshot && ryw->options.snapshotRywEnabled <= 0) {
 			return readWithConflictRangeSnapshot(ryw, req);
 		}
 		return readWithConflictRangeRYW(ryw, req, snapshot);
@@ -1239,6 +1241,7 @@ public:
 			throw unsupported_operation();
 		}
 
+		ryw->endBlindWrites();
 		return readWithConflictRangeRYW(ryw, req, snapshot);
 	}
 
@@ -1477,7 +1480,8 @@ public:
 
 ReadYourWritesTransaction::ReadYourWritesTransaction(Database const& cx, Optional<Reference<Tenant>> const& tenant)
   : ISingleThreadTransaction(cx->deferredError), tr(cx, tenant), cache(&arena), writes(&arena), retries(0),
-    approximateSize(0), creationTime(now()), commitStarted(false), versionStampFuture(tr.getVersionstamp()),
+    approximateSize(0), creationTime(now()), commitStarted(false), blindWrites(CLIENT_KNOBS->RYW_BLIND_WRITES),
+    versionStampFuture(tr.getVersionstamp()),
     specialKeySpaceWriteMap(std::make_pair(false, Optional<Value>()), specialKeys.end), options(tr) {
 	std::copy(
 	    cx.getTransactionDefaults().begin(), cx.getTransactionDefaults().end(), std::back_inserter(persistentOptions));
@@ -1909,6 +1913,7 @@ void ReadYourWritesTransaction::addReadConflictRange(KeyRangeRef const& keys) {
 		return;
 	}
 
+	endBlindWrites();
 	WriteMap::iterator it(&writes);
 	KeyRangeRef readRange(arena, r);
 	it.skip(readRange.begin);
@@ -1923,6 +1928,32 @@ void ReadYourWritesTransaction::updateConflictMap(KeyRangeRef const& keys, Write
 	RYWImpl::updateConflictMap(this, keys, it);
 }
 
+void ReadYourWritesTransaction::endBlindWrites() {
+	if (!blindWrites) {
+		return;
+	}
+	blindWrites = false;
+
+	auto [mutations, conflictRanges] = tr.takeWrites();
+	if (mutations.empty() && conflictRanges.empty()) {
+		return;
+	}
+	CODE_PROBE(true, "RYW blind writes moved into the write map");
+
+	arena.dependsOn(mutations.arena());
+	arena.dependsOn(conflictRanges.arena());
+	for (auto const& m : mutations) {
+		if (m.type == MutationRef::ClearRange) {
+			writes.clear(KeyRangeRef(m.param1, m.param2), false);
+		} else {
+			writes.mutate(m.param1, (MutationRef::Type)m.type, m.param2, false);
+		}
+	}
+	for (auto const& r : conflictRanges) {
+		writes.addConflictRange(r);
+	}
+}
+
 void ReadYourWritesTransaction::writeRangeToNativeTransaction(KeyRangeRef const& keys) {
 	WriteMap::iterator it(&writes);
 	it.skip(keys.begin);
@@ -2018,6 +2049,7 @@ bool ReadYourWritesTransactionOptions::getAndResetWriteConflictDisabled() {
 }
 
 void ReadYourWritesTransaction::getWriteConflicts(KeyRangeMap<bool>* result) {
+	endBlindWrites();
 	WriteMap::iterator it(&writes);
 	it.skip(allKeys.begin);
 
@@ -2096,6 +2128,7 @@ RangeResult ReadYourWritesTransaction::getWriteConflictRangeIntersecting(KeyRang
 	CoalescedKeyRefRangeMap<ValueRef> writeConflicts{ "0"_sr, specialKeys.end };
 
 	if (!options.readYourWritesDisabled) {
+		endBlindWrites();
 		KeyRangeRef strippedWriteRangePrefix = kr.removePrefix(writeConflictRangeKeysRange.begin);
 		WriteMap::iterator it(&writes);
 		it.skip(strippedWriteRangePrefix.begin);
@@ -2191,6 +2224,8 @@ void ReadYourWritesTransaction::atomicOp(const KeyRef& key, const ValueRef& oper
 
 	if (operationType == MutationRef::SetVersionstampedKey) {
 		CODE_PROBE(options.readYourWritesDisabled, "SetVersionstampedKey without ryw enabled");
+		// The unreadable range is tracked in the write map
+		endBlindWrites();
 		// this does validation of the key and needs to be performed before the readYourWritesDisabled path
 		KeyRangeRef range = getVersionstampKeyRange(arena, k, tr.getCachedReadVersion().orDefault(0), getMaxReadKey());
 		versionStampKeys.push_back(arena, k);
@@ -2217,7 +2252,7 @@ void ReadYourWritesTransaction::atomicOp(const KeyRef& key, const ValueRef& oper
 
 	approximateSize += k.expectedSize() + v.expectedSize() + sizeof(MutationRef) +
 	                   (addWriteConflict ? sizeof(KeyRangeRef) + 2 * key.expectedSize() + 1 : 0);
-	if (options.readYourWritesDisabled) {
+	if (options.readYourWritesDisabled || blindWrites) {
 		return tr.atomicOp(k, v, (MutationRef::Type)operationType, addWriteConflict);
 	}
 
@@ -2265,7 +2300,7 @@ void ReadYourWritesTransaction::set(const KeyRef& key, const ValueRef& value) {
 
 	approximateSize += key.expectedSize() + value.expectedSize() + sizeof(MutationRef) +
 	                   (addWriteConflict ? sizeof(KeyRangeRef) + 2 * key.expectedSize() + 1 : 0);
-	if (options.readYourWritesDisabled) {
+	if (options.readYourWritesDisabled || blindWrites) {
 		return tr.set(key, value, addWriteConflict);
 	}
 
@@ -2302,7 +2337,7 @@ void ReadYourWritesTransaction::clear(const KeyRangeRef& range) {
 
 	approximateSize += range.expectedSize() + sizeof(MutationRef) +
 	                   (addWriteConflict ? sizeof(KeyRangeRef) + range.expectedSize() : 0);
-	if (options.readYourWritesDisabled) {
+	if (options.readYourWritesDisabled || blindWrites) {
 		return tr.clear(range, addWriteConflict);
 	}
 
@@ -2359,6 +2394,9 @@ void ReadYourWritesTransaction::clear(const KeyRef& key) {
 	KeyRangeRef r = singleKeyRange(key, arena);
 	approximateSize +=
 	    r.expectedSize() + sizeof(KeyRangeRef) + (addWriteConflict ? sizeof(KeyRangeRef) + r.expectedSize() : 0);
+	if (blindWrites) {
+		return tr.clear(r, addWriteConflict);
+	}
 
 	// SOMEDAY: add an optimized single key clear to write map
 	writes.clear(r, addWriteConflict);
@@ -2419,7 +2457,7 @@ void ReadYourWritesTransaction::addWriteConflictRange(KeyRangeRef const& keys) {
 	}
 
 	approximateSize += r.expectedSize() + sizeof(KeyRangeRef);
-	if (options.readYourWritesDisabled) {
+	if (options.readYourWritesDisabled || blindWrites) {
 		tr.addWriteConflictRange(r);
 		return;
 	}
@@ -2463,6 +2501,7 @@ void ReadYourWritesTransaction::setOptionImpl(FDBTransactionOptions::Option opti
 	case FDBTransactionOptions::READ_YOUR_WRITES_DISABLE:
 		validateOptionValueNotPresent(value);
 
+		endBlindWrites();
 		if (reading.getFutureCount() > 0 || !cache.empty() || !writes.empty())
 			throw client_invalid_operation();
 
@@ -2562,6 +2601,7 @@ void ReadYourWritesTransaction::operator=(ReadYourWritesTransaction&& r) noexcep
 	timeoutActor = r.timeoutActor;
 	creationTime = r.creationTime;
 	commitStarted = r.commitStarted;
+	blindWrites = r.blindWrites;
 	options = r.options;
 	transactionDebugInfo = r.transactionDebugInfo;
 	cache.arena = &arena;
@@ -2578,8 +2618,8 @@ ReadYourWritesTransaction::ReadYourWritesTransaction(ReadYourWritesTransaction&&
   : ISingleThreadTransaction(std::move(r.deferredError)), arena(std::move(r.arena)), cache(std::move(r.cache)),
     writes(std::move(r.writes)), resetPromise(std::move(r.resetPromise)), reading(std::move(r.reading)),
     retries(r.retries), approximateSize(r.approximateSize), timeoutActor(std::move(r.timeoutActor)),
-    creationTime(r.creationTime), commitStarted(r.commitStarted), transactionDebugInfo(r.transactionDebugInfo),
-    options(r.options) {
+    creationTime(r.creationTime), commitStarted(r.commitStarted), blindWrites(r.blindWrites),
+    transactionDebugInfo(r.transactionDebugInfo), options(r.options) {
 	cache.arena = &arena;
 	writes.arena = &arena;
 	tr = std::move(r.tr);
@@ -2638,6 +2678,7 @@ void ReadYourWritesTransaction::resetRyow() {
 	reading = AndFuture();
 	approximateSize = 0;
 	commitStarted = false;
+	blindWrites = CLIENT_KNOBS->RYW_BLIND_WRITES;
 
 	deferredError = Error();
 
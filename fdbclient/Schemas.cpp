@@ -279,6 +279,92 @@ const KeyRef JSONSchemas::statusSchema = R"statusSchema(
                      "p99":0.0,
                      "p99.9":0.0
                   },
+                  "latency_breakdown":{
+                     "client_queue":{
+                        "count":0,
+                        "min":0.0,
+                        "max":0.0,
+                        "median":0.0,
+                        "mean":0.0,
+                        "p25":0.0,
+                        "p90":0.0,
+                        "p95":0.0,
+                        "p99":0.0,
+                        "p99.9":0.0
+                     },
+                     "batch_wait":{
+                        "count":0,
+                        "min":0.0,
+                        "max":0.0,
+                        "median":0.0,
+                        "mean":0.0,
+                        "p25":0.0,
+                        "p90":0.0,
+                        "p95":0.0,
+                        "p99":0.0,
+                        "p99.9":0.0
+                     },
+                     "resolver":{
+                        "count":0,
+                        "min":0.0,
+                        "max":0.0,
+                        "median":0.0,
+                        "mean":0.0,
+                        "p25":0.0,
+                        "p90":0.0,
+                        "p95":0.0,
+                        "p99":0.0,
+                        "p99.9":0.0
+                     },
+                     "tlog":{
+                        "count":0,
+                        "min":0.0,
+                        "max":0.0,
+                        "median":0.0,
+                        "mean":0.0,
+                        "p25":0.0,
+                        "p90":0.0,
+                        "p95":0.0,
+                        "p99":0.0,
+                        "p99.9":0.0
+                     },
+                     "fsync":{
+                        "count":0,
+                        "min":0.0,
+                        "max":0.0,
+                        "median":0.0,
+                        "mean":0.0,
+                        "p25":0.0,
+                        "p90":0.0,
+                        "p95":0.0,
+                        "p99":0.0,
+                        "p99.9":0.0
+                     },
+                     "version_wait":{
+                        "count":0,
+                        "min":0.0,
+                        "max":0.0,
+                        "median":0.0,
+                        "mean":0.0,
+                        "p25":0.0,
+                        "p90":0.0,
+                        "p95":0.0,
+                        "p99":0.0,
+                        "p99.9":0.0
+                     },
+                     "engine_read":{
+                        "count":0,
+                        "min":0.0,
+                        "max":0.0,
+                        "median":0.0,
+                        "mean":0.0,
+                        "p25":0.0,
+                        "p90":0.0,
+                        "p95":0.0,
+                        "p99":0.0,
+                        "p99.9":0.0
+                     }
+                  },
                   "grv_latency_bands":{
                      "$map": 1
                   },
@@ -356,7 +442,8 @@ const KeyRef JSONSchemas::statusSchema = R"statusSchema(
             },
             "uptime_seconds":1234.2345,
             "cpu":{
-               "usage_cores":0.0
+               "usage_cores":0.0,
+               "affinity":"0-3"
             },
             "network":{
                "current_connections":0,
@@ -632,6 +719,12 @@ const KeyRef JSONSchemas::statusSchema = R"statusSchema(
          "description":"Recovery complete."
       },
       "workload":{
+         "conflicting_key_prefixes":[
+            {
+               "prefix":"app/",
+               "conflicts_per_second":0.0
+            }
+         ],
          "operations":{
             "writes":{
                "hz":0.0,
@@ -71,7 +71,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( TLOG_MESSAGE_BLOCK_BYTES,                             10e6 );
 	init( TLOG_MESSAGE_BLOCK_OVERHEAD_FACTOR,      double(TLOG_MESSAGE_BLOCK_BYTES) / (TLOG_MESSAGE_BLOCK_BYTES - MAX_MESSAGE_SIZE) ); //1.0121466709838096006362758832473
 	init( PEEK_TRACKER_EXPIRATION_TIME,                          600 ); if( randomize && BUGGIFY ) PEEK_TRACKER_EXPIRATION_TIME = 120; // Cannot be buggified lower without changing the following assert in LogSystemPeekCursor.actor.cpp: ASSERT_WE_THINK(e.code() == error_code_operation_obsolete || SERVER_KNOBS->PEEK_TRACKER_EXPIRATION_TIME < 10);
-	init( PEEK_USING_STREAMING,                                false ); if( randomize && isSimulated && BUGGIFY ) PEEK_USING_STREAMING = true;
+	init( PEEK_USING_STREAMING,                                 true ); if( randomize && isSimulated && BUGGIFY ) PEEK_USING_STREAMING = false;
 	init( PARALLEL_GET_MORE_REQUESTS,                             32 ); if( randomize && BUGGIFY ) PARALLEL_GET_MORE_REQUESTS = 2;
 	init( MULTI_CURSOR_PRE_FETCH_LIMIT,                           10 );
 	init( MAX_QUEUE_COMMIT_BYTES,                               15e6 ); if( randomize && BUGGIFY ) MAX_QUEUE_COMMIT_BYTES = 5000;
@@ -84,9 +84,13 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( TLOG_SPILL_REFERENCE_MAX_PEEK_MEMORY_BYTES,            2e9 ); if ( randomize && BUGGIFY ) TLOG_SPILL_REFERENCE_MAX_PEEK_MEMORY_BYTES = 2e6;
 	init( TLOG_SPILL_REFERENCE_MAX_BATCHES_PER_PEEK,           100 ); if ( randomize && BUGGIFY ) TLOG_SPILL_REFERENCE_MAX_BATCHES_PER_PEEK = 1;
 	init( TLOG_SPILL_REFERENCE_MAX_BYTES_PER_BATCH,           16<<10 ); if ( randomize && BUGGIFY ) TLOG_SPILL_REFERENCE_MAX_BYTES_PER_BATCH = 500;
+	init( TLOG_SPILL_COMPRESSION_FILTER,                      "NONE" );
 	init( DISK_QUEUE_FILE_EXTENSION_BYTES,                    10<<20 ); // BUGGIFYd per file within the DiskQueue
 	init( DISK_QUEUE_FILE_SHRINK_BYTES,                      100<<20 ); // BUGGIFYd per file within the DiskQueue
 	init( DISK_QUEUE_MAX_TRUNCATE_BYTES,                     2LL<<30 ); if ( randomize && BUGGIFY ) DISK_QUEUE_MAX_TRUNCATE_BYTES = 0;
+	init( DISK_QUEUE_MAX_OUTSTANDING_SYNCS,                        1 ); if ( randomize && BUGGIFY ) DISK_QUEUE_MAX_OUTSTANDING_SYNCS = deterministicRandom()->randomInt(1, 5);
+	init( DISK_QUEUE_RECOVERY_READ_BYTES,                    1 << 20 );
+	init( DISK_QUEUE_RECOVERY_READ_AHEAD,                           4 ); if ( randomize && BUGGIFY ) DISK_QUEUE_RECOVERY_READ_AHEAD = deterministicRandom()->randomInt(1, 9);
 	init( TLOG_DEGRADED_DURATION,                                5.0 );
 	init( MAX_CACHE_VERSIONS,                                   10e6 );
 	init( TLOG_IGNORE_POP_AUTO_ENABLE_DELAY,                   300.0 );
@@ -110,6 +114,8 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( PUSH_STATS_SLOW_AMOUNT,                                  2 );
 	init( PUSH_STATS_SLOW_RATIO,                                 0.5 );
 	init( TLOG_POP_BATCH_SIZE,                                  1000 ); if ( randomize && BUGGIFY ) TLOG_POP_BATCH_SIZE = 10;
+	init( TLOG_POP_COALESCE_DELAY,                               0.1 ); if ( randomize && BUGGIFY ) TLOG_POP_COALESCE_DELAY = deterministicRandom()->coinflip() ? 0.0 : 1.0;
+	init( TLOG_POP_COALESCE_PRESSURE_FRACTION,                   0.5 ); if ( randomize && BUGGIFY ) TLOG_POP_COALESCE_PRESSURE_FRACTION = deterministicRandom()->random01();
 	init( TLOG_POPPED_VER_LAG_THRESHOLD_FOR_TLOGPOP_TRACE,     250e6 );
 	init( BLOCKING_PEEK_TIMEOUT,                                 0.4 );
 	init( ENABLE_DETAILED_TLOG_POP_TRACE,                      false ); if ( randomize && BUGGIFY ) ENABLE_DETAILED_TLOG_POP_TRACE = true;
@@ -141,6 +147,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( RELOCATION_PARALLELISM_PER_SOURCE_SERVER,                2 ); if( randomize && BUGGIFY ) RELOCATION_PARALLELISM_PER_SOURCE_SERVER = 1;
 	init( RELOCATION_PARALLELISM_PER_DEST_SERVER,                 10 ); if( randomize && BUGGIFY ) RELOCATION_PARALLELISM_PER_DEST_SERVER = 1; // Note: if this is smaller than FETCH_KEYS_PARALLELISM, this will artificially reduce performance. The current default of 10 is probably too high but is set conservatively for now.
 	init( DD_QUEUE_MAX_KEY_SERVERS,                              100 ); // Do not buggify
+	init( DD_MOVE_BYTES_PER_SECOND,                                0 ); if( randomize && BUGGIFY ) DD_MOVE_BYTES_PER_SECOND = deterministicRandom()->randomInt(10e6, 100e6);
 	init( DD_REBALANCE_PARALLELISM,                               50 );
 	init( DD_REBALANCE_RESET_AMOUNT,                              30 );
 	init( INFLIGHT_PENALTY_HEALTHY,                              1.0 );
@@ -173,6 +180,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( MAX_PHYSICAL_SHARD_BYTES,                        500000000 ); // 500 MB; for ENABLE_DD_PHYSICAL_SHARD; smaller leads to larger number of physicalShard per storage server
  	init( PHYSICAL_SHARD_METRICS_DELAY,                        300.0 ); // 300 seconds; for ENABLE_DD_PHYSICAL_SHARD
 	init( ANONYMOUS_PHYSICAL_SHARD_TRANSITION_TIME,            600.0 ); if( randomize && BUGGIFY )  ANONYMOUS_PHYSICAL_SHARD_TRANSITION_TIME = 0.0; // 600 seconds; for ENABLE_DD_PHYSICAL_SHARD
+	init( DD_PHYSICAL_SHARD_COALESCE_MAX_SHARDS,                   8 ); if( randomize && BUGGIFY )  DD_PHYSICAL_SHARD_COALESCE_MAX_SHARDS = deterministicRandom()->randomInt(1, 20); // for ENABLE_DD_PHYSICAL_SHARD
 	init( READ_REBALANCE_CPU_THRESHOLD,                         15.0 );
 	init( READ_REBALANCE_SRC_PARALLELISM,                         20 );
 	init( READ_REBALANCE_SHARD_TOPK,  READ_REBALANCE_SRC_PARALLELISM * 2 );
@@ -202,6 +210,15 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 		Shard with a read bandwidth smaller than this value will never be too busy to handle the reads.
 	*/
 	init( SHARD_MAX_BYTES_READ_PER_KSEC_JITTER,     0.1 );
+	init( DD_CACHE_READ_HOT_RANGES,               false );
+	init( DD_READ_HOT_CACHE_DURATION,             600.0 ); if( randomize && BUGGIFY ) DD_READ_HOT_CACHE_DURATION = deterministicRandom()->randomInt(10, 120);
+	/*
+		If enabled, read-hot ranges are added to the storage cache so that storage cache servers (processes of class
+		storage_cache) serve reads for them alongside the storage servers. A range is removed from the cache once it
+		has not been reported read-hot for DD_READ_HOT_CACHE_DURATION seconds.
+		*/
+	init( STORAGE_CACHE_MEMORY_LIMIT,                 0 ); if( randomize && BUGGIFY ) STORAGE_CACHE_MEMORY_LIMIT = 1e6;
+	init( STORAGE_CACHE_EVICTION_INTERVAL,         10.0 ); if( randomize && BUGGIFY ) STORAGE_CACHE_EVICTION_INTERVAL = 1.0;
 	bool buggifySmallBandwidthSplit = randomize && BUGGIFY;
 	init( SHARD_MAX_BYTES_PER_KSEC,                 1LL*1000000*1000 ); if( buggifySmallBandwidthSplit ) SHARD_MAX_BYTES_PER_KSEC = 10LL*1000*1000;
 	/* 1*1MB/sec * 1000sec/ksec
@@ -241,6 +258,16 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 		If this value is too small relative to SHARD_MIN_BYTES_PER_KSEC immediate merging work will be generated.
 		*/
 
+	init( SHARD_WRITE_TREND_HORIZON,                             0.0 ); if( randomize && BUGGIFY ) SHARD_WRITE_TREND_HORIZON = deterministicRandom()->randomInt(10, 300);
+	/*
+		If positive, a shard whose write bandwidth is rising fast enough to pass SHARD_MAX_BYTES_PER_KSEC within this
+		many seconds is split before it gets there, as long as it already has enough bandwidth to be split into
+		pieces of SHARD_SPLIT_BYTES_PER_KSEC. This splits the tail shard of a sequential insert workload before it
+		becomes hot. The trend is an exponential moving average, weighted by SHARD_WRITE_TREND_SMOOTHING, of the
+		change in write bandwidth per second between metrics updates.
+		*/
+	init( SHARD_WRITE_TREND_SMOOTHING,                           0.3 );
+
 	init( STORAGE_METRIC_TIMEOUT,         isSimulated ? 60.0 : 600.0 ); if( randomize && BUGGIFY ) STORAGE_METRIC_TIMEOUT = deterministicRandom()->coinflip() ? 10.0 : 30.0;
 	init( METRIC_DELAY,                                          0.1 ); if( randomize && BUGGIFY ) METRIC_DELAY = 1.0;
 	init( ALL_DATA_REMOVED_DELAY,                                1.0 );
@@ -252,6 +279,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( PERPETUAL_WIGGLE_SMALL_LOAD_RATIO,                      10 );
 	init( PERPETUAL_WIGGLE_MIN_BYTES_BALANCE_RATIO,             0.85 );
 	init( PERPETUAL_WIGGLE_DISABLE_REMOVER,                     true );
+	init( PERPETUAL_WIGGLE_ZONE_SERVERS,                           0 ); if( randomize && BUGGIFY ) PERPETUAL_WIGGLE_ZONE_SERVERS = deterministicRandom()->randomInt(1, 4);
 	init( LOG_ON_COMPLETION_DELAY,         DD_QUEUE_LOGGING_INTERVAL );
 	init( BEST_TEAM_MAX_TEAM_TRIES,                               10 );
 	init( BEST_TEAM_OPTION_COUNT,                                  4 );
@@ -335,6 +363,8 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( SQLITE_CHUNK_SIZE_PAGES,                             25600 );  // 100MB
 	init( SQLITE_CHUNK_SIZE_PAGES_SIM,                          1024 );  // 4MB
 	init( SQLITE_READER_THREADS,                                  64 );  // number of read threads
+	init( SQLITE_READ_AHEAD_PAGES,                                 8 ); if( randomize && BUGGIFY ) SQLITE_READ_AHEAD_PAGES = deterministicRandom()->randomInt(0, 65);
+	init( SQLITE_READ_AHEAD_MIN_SEQUENTIAL_READS,                   2 );
 	init( SQLITE_WRITE_WINDOW_SECONDS,                            -1 );
 	init( SQLITE_CURSOR_MAX_LIFETIME_BYTES,                      1e6 ); if (buggifySmallShards || simulationMediumShards) SQLITE_CURSOR_MAX_LIFETIME_BYTES = MIN_SHARD_BYTES; if( randomize && BUGGIFY ) SQLITE_CURSOR_MAX_LIFETIME_BYTES = 0;
 	init( SQLITE_WRITE_WINDOW_LIMIT,                              -1 );
@@ -407,6 +437,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	// If rocksdb block cache size is 0, the default 8MB is used.
 	int64_t blockCacheSize = isSimulated ? 16 * 1024 * 1024 : 1024 * 1024 * 1024 /* 1GB */;
 	init( ROCKSDB_BLOCK_CACHE_SIZE,                   blockCacheSize );
+	init( ROCKSDB_SHARE_BLOCK_CACHE,                            false ); if( randomize && BUGGIFY ) ROCKSDB_SHARE_BLOCK_CACHE = deterministicRandom()->coinflip();
 	init( ROCKSDB_METRICS_DELAY,                                60.0 );
 	// ROCKSDB_READ_VALUE_TIMEOUT, ROCKSDB_READ_VALUE_PREFIX_TIMEOUT, ROCKSDB_READ_RANGE_TIMEOUT knobs:
 	// In simulation, increasing the read operation timeouts to 5 minutes, as some of the tests have
@@ -424,8 +455,12 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( ROCKSDB_HISTOGRAMS_SAMPLE_RATE,                      0.001 ); if( randomize && BUGGIFY ) ROCKSDB_HISTOGRAMS_SAMPLE_RATE = 0;
 	init( ROCKSDB_READ_RANGE_ITERATOR_REFRESH_TIME,             30.0 ); if( randomize && BUGGIFY ) ROCKSDB_READ_RANGE_ITERATOR_REFRESH_TIME = 0.1;
 	init( ROCKSDB_READ_RANGE_REUSE_ITERATORS,                   true ); if( randomize && BUGGIFY ) ROCKSDB_READ_RANGE_REUSE_ITERATORS = deterministicRandom()->coinflip();
+	init( ROCKSDB_MULTIGET,                                     true ); if( randomize && BUGGIFY ) ROCKSDB_MULTIGET = deterministicRandom()->coinflip();
 	init( ROCKSDB_READ_RANGE_REUSE_BOUNDED_ITERATORS,          false ); if( randomize && BUGGIFY ) ROCKSDB_READ_RANGE_REUSE_BOUNDED_ITERATORS = deterministicRandom()->coinflip();
 	init( ROCKSDB_READ_RANGE_BOUNDED_ITERATORS_MAX_LIMIT,        200 );
+	init( ROCKSDB_READ_RANGE_ASYNC_IO,                         false ); if( randomize && BUGGIFY ) ROCKSDB_READ_RANGE_ASYNC_IO = deterministicRandom()->coinflip();
+	init( ROCKSDB_READ_RANGE_ADAPTIVE_READAHEAD,                 true ); if( randomize && BUGGIFY ) ROCKSDB_READ_RANGE_ADAPTIVE_READAHEAD = deterministicRandom()->coinflip();
+	init( ROCKSDB_READ_RANGE_READAHEAD_SIZE,                       0 ); // 0 lets rocksdb grow the readahead automatically
 	// Set to 0 to disable rocksdb write rate limiting. Rate limiter unit: bytes per second.
 	init( ROCKSDB_WRITE_RATE_LIMITER_BYTES_PER_SEC,                0 );
 	// If true, enables dynamic adjustment of ROCKSDB_WRITE_RATE_LIMITER_BYTES according to the recent demand of background IO.
@@ -470,6 +505,9 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( ROCKSDB_MAX_TOTAL_WAL_SIZE,                              0 ); // RocksDB default.
 	init( ROCKSDB_MAX_BACKGROUND_JOBS,                             2 ); // RocksDB default.
 	init( ROCKSDB_DELETE_OBSOLETE_FILE_PERIOD,                 21600 ); // 6h, RocksDB default.
+	init( SHARDED_ROCKSDB_ENABLE_PIPELINED_WRITE,            false ); if( randomize && BUGGIFY ) SHARDED_ROCKSDB_ENABLE_PIPELINED_WRITE = deterministicRandom()->coinflip();
+	init( SHARDED_ROCKSDB_ALLOW_CONCURRENT_MEMTABLE_WRITE,     true ); if( randomize && BUGGIFY ) SHARDED_ROCKSDB_ALLOW_CONCURRENT_MEMTABLE_WRITE = deterministicRandom()->coinflip();
+	init( SHARDED_ROCKSDB_CHANGE_FEED_SHARD,                   false ); if( randomize && BUGGIFY ) SHARDED_ROCKSDB_CHANGE_FEED_SHARD = deterministicRandom()->coinflip();
 	init( ROCKSDB_PHYSICAL_SHARD_CLEAN_UP_DELAY, isSimulated ? 10.0 : 300.0 ); // Delays shard clean up, must be larger than ROCKSDB_READ_VALUE_TIMEOUT to prevent reading deleted shard.
 
 	// Leader election
@@ -494,6 +532,8 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( START_TRANSACTION_RATE_WINDOW,                         2.0 );
 	init( START_TRANSACTION_MAX_EMPTY_QUEUE_BUDGET,             10.0 );
 	init( START_TRANSACTION_MAX_QUEUE_SIZE,                      1e6 );
+	init( GRV_PROXY_SHARE_REPLY_SERIALIZATION,                  true ); if( randomize && BUGGIFY ) GRV_PROXY_SHARE_REPLY_SERIALIZATION = false;
+	init( GRV_CACHE_LEASE_DURATION,                              0.1 ); if( randomize && BUGGIFY ) GRV_CACHE_LEASE_DURATION = deterministicRandom()->random01() * 0.1;
 	init( KEY_LOCATION_MAX_QUEUE_SIZE,                           1e6 );
 	init( TENANT_ID_REQUEST_MAX_QUEUE_SIZE,                      1e6 );
 	init( BLOB_GRANULE_LOCATION_MAX_QUEUE_SIZE,                  1e5 ); if ( randomize && BUGGIFY ) BLOB_GRANULE_LOCATION_MAX_QUEUE_SIZE = 100;
@@ -504,6 +544,9 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( COMMIT_TRANSACTION_BATCH_INTERVAL_MAX,                0.020 );
 	init( COMMIT_TRANSACTION_BATCH_INTERVAL_LATENCY_FRACTION,     0.1 );
 	init( COMMIT_TRANSACTION_BATCH_INTERVAL_SMOOTHER_ALPHA,       0.1 );
+	init( COMMIT_BATCHING_TARGET_LATENCY,                         0.0 ); if( randomize && BUGGIFY ) COMMIT_BATCHING_TARGET_LATENCY = deterministicRandom()->random01() * 0.1;
+	init( COMMIT_BATCHING_CONTROLLER_GAIN,                        0.1 );
+	init( COMMIT_BATCHING_LATENCY_QUANTILE_STEP,                 0.01 );
 	init( COMMIT_TRANSACTION_BATCH_COUNT_MAX,                   32768 ); if( randomize && BUGGIFY ) COMMIT_TRANSACTION_BATCH_COUNT_MAX = 1000; // Do NOT increase this number beyond 32768, as CommitIds only budget 2 bytes for storing transaction id within each batch
 	init( COMMIT_BATCHES_MEM_BYTES_HARD_LIMIT,              8LL << 30 ); if (randomize && BUGGIFY) COMMIT_BATCHES_MEM_BYTES_HARD_LIMIT = deterministicRandom()->randomInt64(100LL << 20,  8LL << 30);
 	init( COMMIT_BATCHES_MEM_FRACTION_OF_TOTAL,                   0.5 );
@@ -534,11 +577,13 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( PROXY_COMPUTE_BUCKETS,                                20000 );
 	init( PROXY_COMPUTE_GROWTH_RATE,                             0.01 );
 	init( TXN_STATE_SEND_AMOUNT,                                    4 );
+	init( TXN_STATE_STORE_RADIX_TREE,                           false ); if( randomize && BUGGIFY ) TXN_STATE_STORE_RADIX_TREE = deterministicRandom()->coinflip();
 	init( REPORT_TRANSACTION_COST_ESTIMATION_DELAY,               0.1 );
 	init( PROXY_REJECT_BATCH_QUEUED_TOO_LONG,                    true );
 
 	bool buggfyUseResolverPrivateMutations = randomize && BUGGIFY && !ENABLE_VERSION_VECTOR_TLOG_UNICAST;
 	init( PROXY_USE_RESOLVER_PRIVATE_MUTATIONS,                 false ); if( buggfyUseResolverPrivateMutations ) PROXY_USE_RESOLVER_PRIVATE_MUTATIONS = deterministicRandom()->coinflip();
+	init( PROXY_ENCRYPT_DURING_RESOLUTION,                       true ); if( randomize && BUGGIFY ) PROXY_ENCRYPT_DURING_RESOLUTION = false;
 
 	init( RESET_MASTER_BATCHES,                                   200 );
 	init( RESET_RESOLVER_BATCHES,                                 200 );
@@ -572,6 +617,16 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( SAMPLE_EXPIRATION_TIME,                                1.0 );
 	init( SAMPLE_POLL_TIME,                                      0.1 );
 	init( RESOLVER_STATE_MEMORY_LIMIT,                           1e6 );
+	init( RESOLVER_CONFLICT_SET_THREADS,                           1 ); if( randomize && BUGGIFY ) RESOLVER_CONFLICT_SET_THREADS = deterministicRandom()->randomInt(2, 5);
+	init( RESOLVER_CONFLICT_SET_PARALLEL_MIN_POINTS,            2000 ); if( randomize && BUGGIFY ) RESOLVER_CONFLICT_SET_PARALLEL_MIN_POINTS = deterministicRandom()->randomInt(0, 100);
+	init( RESOLVER_USE_ART_CONFLICT_SET,                       false ); if( randomize && BUGGIFY ) RESOLVER_USE_ART_CONFLICT_SET = deterministicRandom()->coinflip();
+	init( RESOLVER_RECENT_WRITE_FILTER,                         true ); if( randomize && BUGGIFY ) RESOLVER_RECENT_WRITE_FILTER = deterministicRandom()->coinflip();
+	init( RESOLVER_RECENT_WRITE_FILTER_BITS_LOG2,                 20 ); if( randomize && BUGGIFY ) RESOLVER_RECENT_WRITE_FILTER_BITS_LOG2 = deterministicRandom()->randomInt(6, 21);
+	init( RESOLVER_RECENT_WRITE_FILTER_PREFIX_BYTES,              12 ); if( randomize && BUGGIFY ) RESOLVER_RECENT_WRITE_FILTER_PREFIX_BYTES = deterministicRandom()->randomInt(1, 33);
+	init( RESOLVER_RECENT_WRITE_FILTER_WINDOW_VERSIONS,       500000 ); if( randomize && BUGGIFY ) RESOLVER_RECENT_WRITE_FILTER_WINDOW_VERSIONS = deterministicRandom()->randomInt(1, 1000000);
+	init( RESOLVER_CONFLICT_SAMPLE_RATE,                         0.01 ); if( randomize && BUGGIFY ) RESOLVER_CONFLICT_SAMPLE_RATE = deterministicRandom()->coinflip() ? 1.0 : 0.0;
+	init( RESOLVER_CONFLICT_PREFIX_BYTES,                          16 ); if( randomize && BUGGIFY ) RESOLVER_CONFLICT_PREFIX_BYTES = deterministicRandom()->randomInt(1, 33);
+	init( RESOLVER_CONFLICT_PREFIXES_IN_STATUS,                    10 );
 	init( LAST_LIMITED_RATIO,                                    2.0 );
 
 	// Backup Worker
@@ -580,6 +635,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( BACKUP_FILE_BLOCK_BYTES,                       1024 * 1024 );
 	init( BACKUP_LOCK_BYTES,                                     3e9 ); if(randomize && BUGGIFY) BACKUP_LOCK_BYTES = deterministicRandom()->randomInt(1024, 4096) * 256 * 1024;
 	init( BACKUP_UPLOAD_DELAY,                                  10.0 ); if(randomize && BUGGIFY) BACKUP_UPLOAD_DELAY = deterministicRandom()->random01() * 60;
+	init( BACKUP_MAX_OUTSTANDING_UPLOADS,                          4 ); if(randomize && BUGGIFY) BACKUP_MAX_OUTSTANDING_UPLOADS = deterministicRandom()->randomInt(1, 5);
 
 	//Cluster Controller
 	init( CLUSTER_CONTROLLER_LOGGING_DELAY,                      5.0 );
@@ -609,6 +665,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( FORCE_RECOVERY_CHECK_DELAY,                            5.0 );
 	init( RATEKEEPER_FAILURE_TIME,                               1.0 );
 	init( CONSISTENCYSCAN_FAILURE_TIME,                          1.0 );
+	init( CONSISTENCYSCAN_USE_DIGESTS,                          true ); if( randomize && BUGGIFY ) CONSISTENCYSCAN_USE_DIGESTS = false;
 	init( BLOB_MANAGER_FAILURE_TIME,                             1.0 );
 	init( BLOB_MIGRATOR_FAILURE_TIME,                            1.0 );
 	init( REPLACE_INTERFACE_DELAY,                              60.0 );
@@ -646,6 +703,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( POLICY_GENERATIONS,                                    100 ); if( randomize && BUGGIFY ) POLICY_GENERATIONS = 10;
 	init( DBINFO_SEND_AMOUNT,                                      5 );
 	init( DBINFO_BATCH_DELAY,                                    0.1 );
+	init( DBINFO_DELTA_BROADCAST,                              false ); if( randomize && BUGGIFY ) DBINFO_DELTA_BROADCAST = deterministicRandom()->coinflip();
 	init( SINGLETON_RECRUIT_BME_DELAY,                          10.0 );
 
 	//Move Keys
@@ -674,6 +732,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( SMOOTHING_AMOUNT,                                      1.0 ); if( slowRatekeeper ) SMOOTHING_AMOUNT = 5.0;
 	init( SLOW_SMOOTHING_AMOUNT,                                10.0 ); if( slowRatekeeper ) SLOW_SMOOTHING_AMOUNT = 50.0;
 	init( METRIC_UPDATE_RATE,                                     .1 ); if( slowRatekeeper ) METRIC_UPDATE_RATE = 0.5;
+	init( RATEKEEPER_FAST_METRIC_UPDATE_RATE,                   .025 ); if( randomize && BUGGIFY ) RATEKEEPER_FAST_METRIC_UPDATE_RATE = deterministicRandom()->coinflip() ? 0 : 0.01; if( slowRatekeeper ) RATEKEEPER_FAST_METRIC_UPDATE_RATE = 0;
 	init( DETAILED_METRIC_UPDATE_RATE,                           5.0 );
 	init( RATEKEEPER_DEFAULT_LIMIT,                              1e6 ); if( randomize && BUGGIFY ) RATEKEEPER_DEFAULT_LIMIT = 0;
 	init( RATEKEEPER_LIMIT_REASON_SAMPLE_RATE,                   0.1 );
@@ -723,6 +782,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( MAX_TL_SS_VERSION_DIFFERENCE,                         1e99 ); // if( randomize && BUGGIFY ) MAX_TL_SS_VERSION_DIFFERENCE = std::max(1.0, 0.25 * VERSIONS_PER_SECOND); // spring starts at half this value //FIXME: this knob causes ratekeeper to clamp on idle cluster in simulation that have a large number of logs
 	init( MAX_TL_SS_VERSION_DIFFERENCE_BATCH,                   1e99 );
 	init( MAX_MACHINES_FALLING_BEHIND,                             1 );
+	init( MAX_TAG_THROTTLED_SERVERS_IGNORED,                       1 ); if( randomize && BUGGIFY ) MAX_TAG_THROTTLED_SERVERS_IGNORED = deterministicRandom()->randomInt(0, 3);
 
 	init( MAX_TPS_HISTORY_SAMPLES,                               600 );
 	init( NEEDED_TPS_HISTORY_SAMPLES,                            200 );
@@ -787,6 +847,9 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( EMPTY_READ_PENALTY,                                   20 ); // 20 bytes
 	init( DD_SHARD_COMPARE_LIMIT,                               1000 );
 	init( READ_SAMPLING_ENABLED,                                false ); if ( randomize && BUGGIFY ) READ_SAMPLING_ENABLED = true;// enable/disable read sampling
+	init( HOT_KEY_TRACKER_CAPACITY,                               100 ); if( randomize && BUGGIFY ) HOT_KEY_TRACKER_CAPACITY = deterministicRandom()->randomInt(1, 10);
+	init( HOT_KEY_SAMPLE_RATE,                                   0.01 ); if( randomize && BUGGIFY ) HOT_KEY_SAMPLE_RATE = deterministicRandom()->coinflip() ? 1.0 : 0.0;
+	init( HOT_KEY_WINDOW,                                        30.0 ); if( randomize && BUGGIFY ) HOT_KEY_WINDOW = 1.0;
 
 	//Storage Server
 	init( STORAGE_LOGGING_DELAY,                                 5.0 );
@@ -800,9 +863,14 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( FETCH_KEYS_PARALLELISM_BYTES,                          4e6 ); if( randomize && BUGGIFY ) FETCH_KEYS_PARALLELISM_BYTES = 3e6;
 	init( FETCH_KEYS_PARALLELISM,                                  2 );
 	init( FETCH_KEYS_PARALLELISM_FULL,                             6 );
+	init( FETCH_KEYS_PARALLEL_RANGES,                              4 ); if( randomize && BUGGIFY ) FETCH_KEYS_PARALLEL_RANGES = deterministicRandom()->randomInt(1, 6);
+	init( FETCH_KEYS_PARALLEL_RANGE_BYTES,                       10e6 ); if( randomize && BUGGIFY ) FETCH_KEYS_PARALLEL_RANGE_BYTES = deterministicRandom()->randomInt(1000, 100000);
+	init( FETCH_KEYS_USE_CHECKPOINT,                            true ); if( randomize && BUGGIFY ) FETCH_KEYS_USE_CHECKPOINT = false;
+	init( FETCH_KEYS_CHECKPOINT_TIMEOUT,                        30.0 ); if( randomize && BUGGIFY ) FETCH_KEYS_CHECKPOINT_TIMEOUT = 1.0;
 	init( FETCH_KEYS_LOWER_PRIORITY,                               0 );
 	init( SERVE_FETCH_CHECKPOINT_PARALLELISM,                      4 );
 	init( SERVE_AUDIT_STORAGE_PARALLELISM,                         1 );
+	init( AUDIT_STORAGE_USE_DIGESTS,                            true ); if( randomize && BUGGIFY ) AUDIT_STORAGE_USE_DIGESTS = false;
 	init( BUGGIFY_BLOCK_BYTES,                                 10000 );
 	init( STORAGE_RECOVERY_VERSION_LAG_LIMIT,				2 * MAX_READ_TRANSACTION_LIFE_VERSIONS );
 	init( STORAGE_COMMIT_BYTES,                             10000000 ); if( randomize && BUGGIFY ) STORAGE_COMMIT_BYTES = 2000000;
@@ -810,14 +878,19 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( STORAGE_DURABILITY_LAG_REJECT_THRESHOLD,              0.25 );
 	init( STORAGE_DURABILITY_LAG_MIN_RATE,                       0.1 );
 	init( STORAGE_COMMIT_INTERVAL,                               0.5 ); if( randomize && BUGGIFY ) STORAGE_COMMIT_INTERVAL = 2.0;
+	init( STORAGE_PIPELINE_COMMITS,                            false ); if( randomize && BUGGIFY ) STORAGE_PIPELINE_COMMITS = true;
 	init( BYTE_SAMPLING_FACTOR,                                  250 ); //cannot buggify because of differences in restarting tests
 	init( BYTE_SAMPLING_OVERHEAD,                                100 );
 	init( MAX_STORAGE_SERVER_WATCH_BYTES,                      100e6 ); if( randomize && BUGGIFY ) MAX_STORAGE_SERVER_WATCH_BYTES = 10e3;
 	init( MAX_BYTE_SAMPLE_CLEAR_MAP_SIZE,                        1e9 ); if( randomize && BUGGIFY ) MAX_BYTE_SAMPLE_CLEAR_MAP_SIZE = 1e3;
+	init( STORAGE_DEFERRED_BYTE_SAMPLE_BATCH,                   1000 ); if( randomize && BUGGIFY ) STORAGE_DEFERRED_BYTE_SAMPLE_BATCH = deterministicRandom()->randomInt(0, 10);
 	init( LONG_BYTE_SAMPLE_RECOVERY_DELAY,                      60.0 );
 	init( BYTE_SAMPLE_LOAD_PARALLELISM,                            8 ); if( randomize && BUGGIFY ) BYTE_SAMPLE_LOAD_PARALLELISM = 1;
 	init( BYTE_SAMPLE_LOAD_DELAY,                                0.0 ); if( randomize && BUGGIFY ) BYTE_SAMPLE_LOAD_DELAY = 0.1;
 	init( BYTE_SAMPLE_START_DELAY,                               1.0 ); if( randomize && BUGGIFY ) BYTE_SAMPLE_START_DELAY = 0.0;
+	init( STORAGE_WARM_KEYS,                                       0 ); if( randomize && BUGGIFY ) STORAGE_WARM_KEYS = deterministicRandom()->randomInt(1, 100);
+	init( STORAGE_WARM_KEYS_INTERVAL,                           60.0 ); if( randomize && BUGGIFY ) STORAGE_WARM_KEYS_INTERVAL = 1.0;
+	init( STORAGE_WARM_KEYS_PARALLELISM,                          32 ); if( randomize && BUGGIFY ) STORAGE_WARM_KEYS_PARALLELISM = 1;
 	init( BEHIND_CHECK_DELAY,                                    2.0 );
 	init( BEHIND_CHECK_COUNT,                                      2 );
 	init( BEHIND_CHECK_VERSIONS,             5 * VERSIONS_PER_SECOND );
@@ -832,6 +905,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( MAX_STORAGE_COMMIT_TIME,                             120.0 ); //The max fsync stall time on the storage server and tlog before marking a disk as failed
 	init( RANGESTREAM_LIMIT_BYTES,                               2e6 ); if( randomize && BUGGIFY ) RANGESTREAM_LIMIT_BYTES = 1;
 	init( CHANGEFEEDSTREAM_LIMIT_BYTES,                          1e6 ); if( randomize && BUGGIFY ) CHANGEFEEDSTREAM_LIMIT_BYTES = 1;
+	init( CHANGE_FEED_SHARED_FILTER_VERSIONS,                    100 ); if( randomize && BUGGIFY ) CHANGE_FEED_SHARED_FILTER_VERSIONS = deterministicRandom()->randomInt(0, 3);
 	init( BLOBWORKERSTATUSSTREAM_LIMIT_BYTES,                    1e4 ); if( randomize && BUGGIFY ) BLOBWORKERSTATUSSTREAM_LIMIT_BYTES = 1;
 	init( ENABLE_CLEAR_RANGE_EAGER_READS,                       true ); if( randomize && BUGGIFY ) ENABLE_CLEAR_RANGE_EAGER_READS = deterministicRandom()->coinflip();
 	init( CHECKPOINT_TRANSFER_BLOCK_BYTES,                      40e6 );
@@ -840,6 +914,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( STRICTLY_ENFORCE_BYTE_LIMIT,                          false); if( randomize && BUGGIFY ) STRICTLY_ENFORCE_BYTE_LIMIT = deterministicRandom()->coinflip();
 	init( FRACTION_INDEX_BYTELIMIT_PREFETCH,                      0.2); if( randomize && BUGGIFY ) FRACTION_INDEX_BYTELIMIT_PREFETCH = 0.01 + deterministicRandom()->random01();
 	init( MAX_PARALLEL_QUICK_GET_VALUE,                           10 ); if ( randomize && BUGGIFY ) MAX_PARALLEL_QUICK_GET_VALUE = deterministicRandom()->randomInt(1, 100);
+	init( MAPPED_RANGE_LOCAL_BATCH_ROWS,                         100 ); if ( randomize && BUGGIFY ) MAPPED_RANGE_LOCAL_BATCH_ROWS = deterministicRandom()->randomInt(0, 200);
 	init( QUICK_GET_KEY_VALUES_LIMIT,                           2000 );
 	init( QUICK_GET_KEY_VALUES_LIMIT_BYTES,                      1e7 );
 	init( STORAGE_FEED_QUERY_HARD_LIMIT,                      100000 );
@@ -851,7 +926,18 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	// This exists for flexibility but assigning each ReadType to its own unique priority number makes the most sense
 	// The enumeration is currently: eager, fetch, low, normal, high
 	init( STORAGESERVER_READTYPE_PRIORITY_MAP,           "0,1,2,3,4" );
+	// While normal and high priority reads wait longer than this on average for a read slot, the weights of fetch and
+	// low priority reads are halved every STORAGESERVER_READ_WEIGHT_ADJUST_INTERVAL seconds, and otherwise they are
+	// doubled back towards their configured values.  An interval of 0 keeps the configured weights.
+	init( STORAGESERVER_READ_QUEUE_LATENCY_TARGET,             0.005 ); if( randomize && BUGGIFY ) STORAGESERVER_READ_QUEUE_LATENCY_TARGET = 0.0001;
+	init( STORAGESERVER_READ_WEIGHT_ADJUST_INTERVAL,             1.0 ); if( randomize && BUGGIFY ) STORAGESERVER_READ_WEIGHT_ADJUST_INTERVAL = deterministicRandom()->coinflip() ? 0.0 : 0.1;
 	init( SPLIT_METRICS_MAX_ROWS,                              10000 ); if( randomize && BUGGIFY ) SPLIT_METRICS_MAX_ROWS = 10;
+	init( STORAGE_PARALLEL_RANGE_READS,                            4 ); if( randomize && BUGGIFY ) STORAGE_PARALLEL_RANGE_READS = deterministicRandom()->randomInt(1, 10);
+	init( STORAGE_PARALLEL_RANGE_READ_MIN_BYTES,             1000000 ); if( randomize && BUGGIFY ) STORAGE_PARALLEL_RANGE_READ_MIN_BYTES = deterministicRandom()->randomInt(1, 100000);
+	init( STORAGE_FILTERED_RANGE_SCAN_BYTES,                10000000 ); if( randomize && BUGGIFY ) STORAGE_FILTERED_RANGE_SCAN_BYTES = deterministicRandom()->randomInt(1, 100000);
+	init( STORAGE_READ_RANGE_ARENA_PRESIZE,                     true ); if( randomize && BUGGIFY ) STORAGE_READ_RANGE_ARENA_PRESIZE = false;
+	init( STORAGE_HOT_ROW_CACHE_BYTES,                             0 ); if( randomize && BUGGIFY ) STORAGE_HOT_ROW_CACHE_BYTES = deterministicRandom()->randomInt(1, 1000) * 1000;
+	init( STORAGE_HOT_ROW_CACHE_MAX_VALUE_BYTES,               16384 ); if( randomize && BUGGIFY ) STORAGE_HOT_ROW_CACHE_MAX_VALUE_BYTES = deterministicRandom()->randomInt(0, 1000);
 
 	//Wait Failure
 	init( MAX_OUTSTANDING_WAIT_FAILURE_REQUESTS,                 250 ); if( randomize && BUGGIFY ) MAX_OUTSTANDING_WAIT_FAILURE_REQUESTS = 2;
@@ -904,6 +990,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	// Status
 	init( STATUS_MIN_TIME_BETWEEN_REQUESTS,                      0.0 );
 	init( MAX_STATUS_REQUESTS_PER_SECOND,                      256.0 );
+	init( STATUS_CACHE_MAX_STALENESS,                            0.0 ); if( randomize && BUGGIFY ) STATUS_CACHE_MAX_STALENESS = deterministicRandom()->random01() * 5.0;
 	init( CONFIGURATION_ROWS_TO_FETCH,                         20000 );
 	init( DISABLE_DUPLICATE_LOG_WARNING,                       false );
 	init( HISTOGRAM_REPORT_INTERVAL,                           300.0 );
@@ -964,19 +1051,27 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( REDWOOD_DEFAULT_EXTENT_READ_SIZE,              1024 * 1024 );
 	init( REDWOOD_EXTENT_CONCURRENT_READS,                         4 );
 	init( REDWOOD_KVSTORE_RANGE_PREFETCH,                       true );
+	init( REDWOOD_SCAN_READ_AHEAD_MAX_LEAVES,                     32 ); if( randomize && BUGGIFY ) { REDWOOD_SCAN_READ_AHEAD_MAX_LEAVES = deterministicRandom()->coinflip() ? 0 : deterministicRandom()->randomInt(1, 8); }
 	init( REDWOOD_PAGE_REBUILD_MAX_SLACK,                       0.33 );
 	init( REDWOOD_PAGE_REBUILD_SLACK_DISTRIBUTION,              0.50 );
 	init( REDWOOD_LAZY_CLEAR_BATCH_SIZE_PAGES,                    10 );
 	init( REDWOOD_LAZY_CLEAR_MIN_PAGES,                            0 );
 	init( REDWOOD_LAZY_CLEAR_MAX_PAGES,                          1e6 );
+	init( REDWOOD_LAZY_CLEAR_MAX_PAGES_PER_SECOND,             50000 ); if( randomize && BUGGIFY ) { REDWOOD_LAZY_CLEAR_MAX_PAGES_PER_SECOND = deterministicRandom()->coinflip() ? 0 : deterministicRandom()->randomInt(100, 10000); }
 	init( REDWOOD_REMAP_CLEANUP_WINDOW_BYTES, 4LL * 1024 * 1024 * 1024 );
 	init( REDWOOD_REMAP_CLEANUP_TOLERANCE_RATIO,                0.05 );
 	init( REDWOOD_PAGEFILE_GROWTH_SIZE_PAGES,                  20000 ); if( randomize && BUGGIFY ) { REDWOOD_PAGEFILE_GROWTH_SIZE_PAGES = deterministicRandom()->randomInt(200, 1000); }
 	init( REDWOOD_METRICS_INTERVAL,                              5.0 );
 	init( REDWOOD_HISTOGRAM_INTERVAL,                           30.0 );
 	init( REDWOOD_EVICT_UPDATED_PAGES,                          true ); if( randomize && BUGGIFY ) { REDWOOD_EVICT_UPDATED_PAGES = false; }
+	init( REDWOOD_PAGE_CACHE_PROBATION_FRACTION,                0.25 ); if( randomize && BUGGIFY ) { REDWOOD_PAGE_CACHE_PROBATION_FRACTION = deterministicRandom()->coinflip() ? 0 : deterministicRandom()->random01(); }
 	init( REDWOOD_DECODECACHE_REUSE_MIN_HEIGHT,                    2 ); if( randomize && BUGGIFY ) { REDWOOD_DECODECACHE_REUSE_MIN_HEIGHT = deterministicRandom()->randomInt(1, 7); }
+	init( REDWOOD_SEARCH_ACCELERATOR_LEVELS,                       4 ); if( randomize && BUGGIFY ) { REDWOOD_SEARCH_ACCELERATOR_LEVELS = deterministicRandom()->randomInt(0, 8); }
 	init( REDWOOD_NODE_MAX_UNBALANCE,                              2 );
+	init( REDWOOD_PAGE_COMPRESSION_FILTER,                    "NONE" ); if( randomize && BUGGIFY ) { REDWOOD_PAGE_COMPRESSION_FILTER = CompressionUtils::toString(CompressionUtils::getRandomFilter()); }
+	init( REDWOOD_PAGE_COMPRESSION_MAX_BLOCKS,                     4 ); if( randomize && BUGGIFY ) { REDWOOD_PAGE_COMPRESSION_MAX_BLOCKS = deterministicRandom()->randomInt(2, 9); }
+	init( REDWOOD_PAGE_COMPRESSION_MIN_SAVINGS,                 0.25 ); if( randomize && BUGGIFY ) { REDWOOD_PAGE_COMPRESSION_MIN_SAVINGS = deterministicRandom()->random01() * 0.5; }
+	init( REDWOOD_PAGE_COMPRESSION_PROBE_PROBABILITY,           0.02 );
 	init( REDWOOD_IO_PRIORITIES,                       "32,32,32,32" );
 
 	// Server request latency measurement
@@ -1005,6 +1100,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( BG_METADATA_SOURCE,                                "knobs" );
 	init( BG_SNAPSHOT_FILE_TARGET_BYTES,                    20000000 ); if ( buggifySmallShards ) BG_SNAPSHOT_FILE_TARGET_BYTES = 50000 * deterministicRandom()->randomInt(1, 4); else if (buggifyMediumGranules) BG_SNAPSHOT_FILE_TARGET_BYTES = 50000 * deterministicRandom()->randomInt(1, 20);
 	init( BG_SNAPSHOT_FILE_TARGET_CHUNK_BYTES,               64*1024 ); if ( randomize && BUGGIFY ) BG_SNAPSHOT_FILE_TARGET_CHUNK_BYTES = BG_SNAPSHOT_FILE_TARGET_BYTES / (1 << deterministicRandom()->randomInt(0, 8));
+	init( BG_SNAPSHOT_FILE_COLUMNAR,                           false );
 	init( BG_DELTA_BYTES_BEFORE_COMPACT, BG_SNAPSHOT_FILE_TARGET_BYTES/2 ); if ( randomize && BUGGIFY ) BG_DELTA_BYTES_BEFORE_COMPACT *= (1.0 + deterministicRandom()->random01() * 3.0)/2.0;
 	init( BG_DELTA_FILE_TARGET_BYTES,   BG_DELTA_BYTES_BEFORE_COMPACT/10 );
 	init( BG_DELTA_FILE_TARGET_CHUNK_BYTES,                  32*1024 ); if ( randomize && BUGGIFY ) BG_DELTA_FILE_TARGET_CHUNK_BYTES = BG_DELTA_FILE_TARGET_BYTES / (1 << deterministicRandom()->randomInt(0, 7));
@@ -1019,6 +1115,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( BG_RDC_BYTES_FACTOR,                                     2 ); if (randomize && BUGGIFY) BG_RDC_BYTES_FACTOR = deterministicRandom()->randomInt(1, 10);
 	init( BG_RDC_READ_FACTOR,                                      3 ); if (randomize && BUGGIFY) BG_RDC_READ_FACTOR = deterministicRandom()->randomInt(1, 10);
 	init( BG_WRITE_MULTIPART,                                  false ); if (randomize && BUGGIFY) BG_WRITE_MULTIPART = true;
+	init( BG_WRITE_MULTIPART_MIN_BYTES,                     10000000 ); if (randomize && BUGGIFY) BG_WRITE_MULTIPART_MIN_BYTES = deterministicRandom()->randomInt(1, 1e6);
 	init( BG_ENABLE_DYNAMIC_WRITE_AMP,                          true ); if (randomize && BUGGIFY) BG_ENABLE_DYNAMIC_WRITE_AMP = false;
 	init( BG_DYNAMIC_WRITE_AMP_MIN_FACTOR,                       0.5 );
 	init( BG_DYNAMIC_WRITE_AMP_DECREASE_FACTOR,                  0.8 );
@@ -1094,6 +1191,8 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
  	init( IDEMPOTENCY_IDS_CLEANER_POLLING_INTERVAL,                10);
 	// Don't clean idempotency ids younger than this
  	init( IDEMPOTENCY_IDS_MIN_AGE_SECONDS,              3600 * 24 * 7);
+	// Commit proxies write an idempotency id time index entry at most once per this many seconds. 0 disables the index.
+	init( IDEMPOTENCY_ID_TIME_INDEX_BUCKET_SECONDS,               60); if( randomize && BUGGIFY ) IDEMPOTENCY_ID_TIME_INDEX_BUCKET_SECONDS = deterministicRandom()->randomInt(0, 3);
 
 	// clang-format on
 
@@ -22,6 +22,7 @@
 #include "fdbclient/StorageServerInterface.h"
 #include "fdbclient/BlobWorkerInterface.h"
 #include "crc32/crc32c.h" // for crc32c_append, to checksum values in tss trace events
+#include "flow/xxhash.h"
 
 // Includes template specializations for all tss operations on storage server types.
 // New StorageServerInterface reply types must be added here or it won't compile.
@@ -55,6 +56,35 @@ void TSS_traceMismatch(TraceEvent& event,
 	    .detail("TSSReply", tss.value.present() ? traceChecksumValue(tss.value.get()) : "missing");
 }
 
+// batched point reads
+template <>
+bool TSS_doCompare(const GetValuesReply& src, const GetValuesReply& tss) {
+	return src.data == tss.data;
+}
+
+template <>
+const char* TSS_mismatchTraceName(const GetValuesRequest& req) {
+	return "TSSMismatchGetValues";
+}
+
+template <>
+void TSS_traceMismatch(TraceEvent& event,
+                       const GetValuesRequest& req,
+                       const GetValuesReply& src,
+                       const GetValuesReply& tss) {
+	// Report the first key the replies disagree on
+	int i = 0;
+	while (i < src.data.size() && i < tss.data.size() && src.data[i] == tss.data[i])
+		i++;
+	event.detail("Keys", req.keys.size())
+	    .detail("Tenant", req.tenantInfo.tenantId)
+	    .detail("Version", req.version)
+	    .detail("SSKey", i < src.data.size() ? src.data[i].key.printable() : "missing")
+	    .detail("SSReply", i < src.data.size() ? traceChecksumValue(src.data[i].value) : "missing")
+	    .detail("TSSKey", i < tss.data.size() ? tss.data[i].key.printable() : "missing")
+	    .detail("TSSReply", i < tss.data.size() ? traceChecksumValue(tss.data[i].value) : "missing");
+}
+
 // key selector reads
 template <>
 bool TSS_doCompare(const GetKeyReply& src, const GetKeyReply& tss) {
@@ -411,6 +441,9 @@ void TSSMetrics::recordLatency(const GetValueRequest& req, double ssLatency, dou
 	TSSgetValueLatency.addSample(tssLatency);
 }
 
+template <>
+void TSSMetrics::recordLatency(const GetValuesRequest& req, double ssLatency, double tssLatency) {}
+
 template <>
 void TSSMetrics::recordLatency(const GetKeyRequest& req, double ssLatency, double tssLatency) {
 	SSgetKeyLatency.addSample(ssLatency);
@@ -456,6 +489,38 @@ void TSSMetrics::recordLatency(const BlobGranuleFileRequest& req, double ssLaten
 
 // -------------------
 
+uint64_t getKeyValuesDigest(VectorRef<KeyValueRef> data) {
+	XXH3_state_t state;
+	XXH3_64bits_reset(&state);
+	for (auto const& kv : data) {
+		// The lengths keep rows whose concatenations are equal from hashing alike
+		uint32_t lengths[2] = { static_cast<uint32_t>(kv.key.size()), static_cast<uint32_t>(kv.value.size()) };
+		XXH3_64bits_update(&state, lengths, sizeof(lengths));
+		XXH3_64bits_update(&state, kv.key.begin(), kv.key.size());
+		XXH3_64bits_update(&state, kv.value.begin(), kv.value.size());
+	}
+	return XXH3_64bits_digest(&state);
+}
+
+TEST_CASE("/StorageServerInterface/KeyValuesDigest") {
+	Arena arena;
+	VectorRef<KeyValueRef> a, b, c, d;
+	a.push_back(arena, KeyValueRef("a"_sr, "1"_sr));
+	a.push_back(arena, KeyValueRef("b"_sr, "2"_sr));
+	b.push_back(arena, KeyValueRef("a"_sr, "1"_sr));
+	b.push_back(arena, KeyValueRef("b"_sr, "2"_sr));
+	c.push_back(arena, KeyValueRef("a"_sr, "1b"_sr));
+	c.push_back(arena, KeyValueRef(""_sr, "2"_sr));
+	d.push_back(arena, KeyValueRef("a"_sr, "1"_sr));
+
+	ASSERT(getKeyValuesDigest(a) == getKeyValuesDigest(b));
+	ASSERT(getKeyValuesDigest(a) != getKeyValuesDigest(c));
+	ASSERT(getKeyValuesDigest(a) != getKeyValuesDigest(d));
+	ASSERT(getKeyValuesDigest(VectorRef<KeyValueRef>()) != getKeyValuesDigest(d));
+
+	return Void();
+}
+
 TEST_CASE("/StorageServerInterface/TSSCompare/TestComparison") {
 	printf("testing tss comparisons\n");
 
@@ -496,6 +561,18 @@ TEST_CASE("/StorageServerInterface/TSSCompare/TestComparison") {
 	ASSERT(!TSS_doCompare(gkvReplyEmpty, gkvReplyOne));
 	ASSERT(!TSS_doCompare(gkvReplyOne, gkvReplyOneMore));
 
+	// test GetValues
+	GetValuesReply gvsReplyEmpty;
+	GetValuesReply gvsReplyOne;
+	gvsReplyOne.data.push_back_deep(gvsReplyOne.arena, v);
+	GetValuesReply gvsReplyOther;
+	gvsReplyOther.data.push_back_deep(gvsReplyOther.arena, KeyValueRef(StringRef(s_a), StringRef(s_c)));
+
+	ASSERT(TSS_doCompare(gvsReplyEmpty, gvsReplyEmpty));
+	ASSERT(TSS_doCompare(gvsReplyOne, gvsReplyOne));
+	ASSERT(!TSS_doCompare(gvsReplyEmpty, gvsReplyOne));
+	ASSERT(!TSS_doCompare(gvsReplyOne, gvsReplyOther));
+
 	GetKeyReply gkReplyA(KeySelectorRef(StringRef(a, s_a), false, 20), false);
 	GetKeyReply gkReplyB(KeySelectorRef(StringRef(a, s_b), false, 10), false);
 	GetKeyReply gkReplyC(KeySelectorRef(StringRef(a, s_c), true, 0), false);
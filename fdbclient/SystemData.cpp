@@ -337,6 +337,20 @@ AuditStorageState decodeAuditStorageState(const ValueRef& value) {
 	return auditState;
 }
 
+const KeyRangeRef bulkLoadKeys = KeyRangeRef("\xff/bulkLoad/"_sr, "\xff/bulkLoad0"_sr);
+const KeyRef bulkLoadPrefix = bulkLoadKeys.begin;
+
+const Value bulkLoadStateValue(const BulkLoadState& bulkLoadState) {
+	return ObjectWriter::toValue(bulkLoadState, IncludeVersion());
+}
+
+BulkLoadState decodeBulkLoadState(const ValueRef& value) {
+	BulkLoadState bulkLoadState;
+	ObjectReader reader(value.begin(), IncludeVersion());
+	reader.deserialize(bulkLoadState);
+	return bulkLoadState;
+}
+
 const KeyRef checkpointPrefix = "\xff/checkpoint/"_sr;
 
 const Key checkpointKeyFor(UID checkpointID) {
@@ -411,6 +425,7 @@ const Value storageCacheServerValue(const StorageServerInterface& ssi) {
 
 const KeyRangeRef ddStatsRange =
     KeyRangeRef("\xff\xff/metrics/data_distribution_stats/"_sr, "\xff\xff/metrics/data_distribution_stats/\xff\xff"_sr);
+const KeyRangeRef hotKeysRange("\xff\xff/metrics/hot_keys/"_sr, "\xff\xff/metrics/hot_keys/\xff\xff"_sr);
 
 //    "\xff/storageCache/[[begin]]" := "[[vector<uint16_t>]]"
 const KeyRangeRef storageCacheKeys("\xff/storageCache/"_sr, "\xff/storageCache0"_sr);
@@ -1746,6 +1761,7 @@ const Key blobGranulesLastFlushKey = "\xff\x02/blobGranulesLastFlushTs"_sr;
 
 const KeyRangeRef idempotencyIdKeys("\xff\x02/idmp/"_sr, "\xff\x02/idmp0"_sr);
 const KeyRef idempotencyIdsExpiredVersion("\xff\x02/idmpExpiredVersion"_sr);
+const KeyRangeRef idempotencyIdTimeIndexKeys("\xff\x02/idmpIndex/"_sr, "\xff\x02/idmpIndex0"_sr);
 
 // for tests
 void testSSISerdes(StorageServerInterface const& ssi) {
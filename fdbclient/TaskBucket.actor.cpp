@@ -245,8 +245,100 @@ public:
 		}
 
 		// Now we know the task key is present and we have the available space for the task's priority
-		state Tuple t = availableSpace.unpack(taskKey.get());
-		state Key taskUID = t.getString(0);
+		Tuple t = availableSpace.unpack(taskKey.get());
+		Reference<Task> task = wait(claimTask(tr, taskBucket, availableSpace, t.getString(0)));
+		tr->set(taskBucket->active.key(), deterministicRandom()->randomUniqueID().toString());
+
+		return task;
+	}
+
+	// Finds up to maxTasks distinct available tasks at a priority.  The search starts from a random point in the
+	// priority's keyspace so that agents claiming at the same time mostly find different tasks.
+	ACTOR static Future<std::vector<Key>> getTaskUIDs(Reference<ReadYourWritesTransaction> tr,
+	                                                  Reference<TaskBucket> taskBucket,
+	                                                  int priority,
+	                                                  int maxTasks) {
+		state Subspace space = taskBucket->getAvailableSpace(priority);
+		state Key start = space.pack(StringRef(deterministicRandom()->randomUniqueID().toString()));
+		// From the start to the end of the keyspace, then from its beginning back to the start
+		state std::vector<KeyRange> ranges = { KeyRangeRef(start, space.range().end),
+			                                   KeyRangeRef(space.range().begin, start) };
+		state std::vector<Key> uids;
+		state int r = 0;
+		for (; r < ranges.size() && uids.size() < maxTasks; ++r) {
+			state KeyRange remaining = ranges[r];
+			loop {
+				RangeResult values =
+				    wait(tr->getRange(remaining, CLIENT_KNOBS->TASKBUCKET_CLAIM_SCAN_ROWS, Snapshot::True));
+				for (int i = 0; i < values.size() && uids.size() < maxTasks; ++i) {
+					Key uid = space.unpack(values[i].key).getString(0);
+					// A task's parameters are adjacent, but a task straddling the start is seen from both ends
+					if (std::find(uids.begin(), uids.end(), uid) == uids.end()) {
+						uids.push_back(uid);
+					}
+				}
+				if (uids.size() >= maxTasks || !values.more) {
+					break;
+				}
+				remaining = KeyRangeRef(keyAfter(values.back().key), remaining.end);
+			}
+		}
+		return uids;
+	}
+
+	// Claims up to maxTasks tasks, highest priority first, in one transaction
+	ACTOR static Future<std::vector<Reference<Task>>> getMany(Reference<ReadYourWritesTransaction> tr,
+	                                                          Reference<TaskBucket> taskBucket,
+	                                                          int maxTasks) {
+		if (taskBucket->priority_batch)
+			tr->setOption(FDBTransactionOptions::PRIORITY_BATCH);
+
+		taskBucket->setOptions(tr);
+
+		// As in getOne()
+		if (deterministicRandom()->random01() < CLIENT_KNOBS->TASKBUCKET_CHECK_TIMEOUT_CHANCE) {
+			bool anyTimeouts = wait(requeueTimedOutTasks(tr, taskBucket));
+			CODE_PROBE(anyTimeouts, "Found a task that timed out while claiming a batch");
+		}
+
+		state std::vector<Future<std::vector<Key>>> uidFutures(CLIENT_KNOBS->TASKBUCKET_MAX_PRIORITY + 1);
+		state int pri;
+		for (pri = CLIENT_KNOBS->TASKBUCKET_MAX_PRIORITY; pri >= 0; --pri)
+			uidFutures[pri] = getTaskUIDs(tr, taskBucket, pri, maxTasks);
+
+		state std::vector<Future<Reference<Task>>> claims;
+		for (pri = CLIENT_KNOBS->TASKBUCKET_MAX_PRIORITY; pri >= 0; --pri) {
+			if (claims.size() >= maxTasks)
+				uidFutures[pri].cancel();
+			else {
+				std::vector<Key> uids = wait(uidFutures[pri]);
+				Subspace availableSpace = taskBucket->getAvailableSpace(pri);
+				for (int i = 0; i < uids.size() && claims.size() < maxTasks; ++i) {
+					claims.push_back(claimTask(tr, taskBucket, availableSpace, uids[i]));
+				}
+			}
+		}
+
+		if (claims.empty()) {
+			bool anyTimeouts = wait(requeueTimedOutTasks(tr, taskBucket));
+			if (anyTimeouts) {
+				CODE_PROBE(true, "Try to get a batch of tasks from timeouts subspace");
+				std::vector<Reference<Task>> tasks = wait(getMany(tr, taskBucket, maxTasks));
+				return tasks;
+			}
+			return std::vector<Reference<Task>>();
+		}
+
+		std::vector<Reference<Task>> tasks = wait(getAll(claims));
+		tr->set(taskBucket->active.key(), deterministicRandom()->randomUniqueID().toString());
+		return tasks;
+	}
+
+	// Moves an available task into the timeout space, which gives it to the caller until it times out
+	ACTOR static Future<Reference<Task>> claimTask(Reference<ReadYourWritesTransaction> tr,
+	                                               Reference<TaskBucket> taskBucket,
+	                                               Subspace availableSpace,
+	                                               Key taskUID) {
 		state Subspace taskAvailableSpace = availableSpace.get(taskUID);
 
 		state Reference<Task> task(new Task());
@@ -269,7 +361,6 @@ public:
 
 		// Clear task definition in the available keyspace
 		tr->clear(taskAvailableSpace.range());
-		tr->set(taskBucket->active.key(), deterministicRandom()->randomUniqueID().toString());
 
 		return task;
 	}
@@ -495,33 +586,33 @@ public:
 		for (int i = 0; i < tasks.size(); ++i)
 			availableSlots.push_back(i);
 
-		state std::vector<Future<Reference<Task>>> getTasks;
+		state Future<std::vector<Reference<Task>>> getTasks;
 		state unsigned int getBatchSize = 1;
+		state unsigned int requested;
 
 		loop {
 			// Start running tasks while slots are available and we keep finding work to do
 			++taskBucket->dispatchSlotChecksStarted;
 			while (!availableSlots.empty()) {
-				getTasks.clear();
-				for (int i = 0, imax = std::min<unsigned int>(getBatchSize, availableSlots.size()); i < imax; ++i)
-					getTasks.push_back(taskBucket->getOne(cx));
-				wait(waitForAllReady(getTasks));
+				// A batch is claimed in one transaction, rather than in a transaction per task that could conflict
+				// with the others
+				requested = std::min<unsigned int>(getBatchSize, availableSlots.size());
+				getTasks = taskBucket->getMany(cx, requested);
+				wait(ready(getTasks));
 
 				bool done = false;
-				for (int i = 0; i < getTasks.size(); ++i) {
-					if (getTasks[i].isError()) {
-						++taskBucket->dispatchErrors;
-						done = true;
-						continue;
-					}
-					Reference<Task> task = getTasks[i].get();
-					if (task) {
+				if (getTasks.isError()) {
+					++taskBucket->dispatchErrors;
+					done = true;
+				} else {
+					for (auto const& task : getTasks.get()) {
 						// Start the task
 						++taskBucket->dispatchDoTasks;
 						int slot = availableSlots.back();
 						availableSlots.pop_back();
 						tasks[slot] = taskBucket->doTask(cx, futureBucket, task);
-					} else {
+					}
+					if (getTasks.get().size() < requested) {
 						++taskBucket->dispatchEmptyTasks;
 						done = true;
 					}
@@ -969,6 +1060,10 @@ Future<Reference<Task>> TaskBucket::getOne(Reference<ReadYourWritesTransaction>
 	return TaskBucketImpl::getOne(tr, Reference<TaskBucket>::addRef(this));
 }
 
+Future<std::vector<Reference<Task>>> TaskBucket::getMany(Reference<ReadYourWritesTransaction> tr, int maxTasks) {
+	return TaskBucketImpl::getMany(tr, Reference<TaskBucket>::addRef(this), maxTasks);
+}
+
 Future<bool> TaskBucket::doOne(Database cx, Reference<FutureBucket> futureBucket) {
 	return TaskBucketImpl::doOne(cx, Reference<TaskBucket>::addRef(this), futureBucket);
 }
@@ -433,6 +433,31 @@ ThreadFuture<Optional<Value>> ThreadSafeTransaction::get(const KeyRef& key, bool
 	});
 }
 
+ThreadFuture<RangeResult> ThreadSafeTransaction::getMulti(const VectorRef<KeyRef>& keys, bool snapshot) {
+	Standalone<VectorRef<KeyRef>> k;
+	k.append_deep(k.arena(), keys.begin(), keys.size());
+
+	ISingleThreadTransaction* tr = this->tr;
+	return onMainThread([tr, k, snapshot]() -> Future<RangeResult> {
+		tr->checkDeferredError();
+		// The reads are issued together, so the ones that land on the same shard share a storage server request
+		std::vector<Future<Optional<Value>>> values;
+		values.reserve(k.size());
+		for (auto const& key : k) {
+			values.push_back(tr->get(key, Snapshot{ snapshot }));
+		}
+		return map(getAll(values), [k](std::vector<Optional<Value>> const& values) {
+			RangeResult result;
+			for (int i = 0; i < k.size(); i++) {
+				if (values[i].present()) {
+					result.push_back_deep(result.arena(), KeyValueRef(k[i], values[i].get()));
+				}
+			}
+			return result;
+		});
+	});
+}
+
 ThreadFuture<Key> ThreadSafeTransaction::getKey(const KeySelectorRef& key, bool snapshot) {
 	KeySelector k = key;
 
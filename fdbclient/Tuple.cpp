@@ -38,15 +38,28 @@ static double bigEndianDouble(double orig) {
 	return *(double*)&big;
 }
 
+// Jumps between nulls with memchr, which is vectorized, rather than testing every byte
 static size_t findStringTerminator(const StringRef data, size_t offset) {
 	size_t i = offset;
-	while (i < data.size() - 1 && !(data[i] == '\x00' && data[i + 1] != (uint8_t)'\xff')) {
-		i += (data[i] == '\x00' ? 2 : 1);
+	while (i < data.size() - 1) {
+		const uint8_t* zero = (const uint8_t*)memchr(data.begin() + i, 0, data.size() - 1 - i);
+		if (zero == nullptr) {
+			return data.size() - 1;
+		}
+		i = zero - data.begin();
+		if (data[i + 1] != (uint8_t)'\xff') {
+			return i;
+		}
+		i += 2;
 	}
 
 	return i;
 }
 
+static bool isUserTypeCode(uint8_t code) {
+	return code >= USER_TYPE_START && code <= USER_TYPE_END;
+}
+
 // If encoding and the sign bit is 1 (the number is negative), flip all the bits.
 // If decoding and the sign bit is 0 (the number is negative), flip all the bits.
 // Otherwise, the number is positive, so flip the sign bit.
@@ -67,27 +80,7 @@ Tuple::Tuple(StringRef const& str, bool exclude_incomplete, bool include_user_ty
 	size_t i = 0;
 	while (i < data.size()) {
 		offsets.push_back(i);
-
-		if (data[i] == '\x01' || data[i] == '\x02') {
-			i = findStringTerminator(str, i + 1) + 1;
-		} else if (data[i] >= '\x0c' && data[i] <= '\x1c') {
-			i += abs(data[i] - '\x14') + 1;
-		} else if (data[i] == 0x20) {
-			i += sizeof(float) + 1;
-		} else if (data[i] == 0x21) {
-			i += sizeof(double) + 1;
-		} else if (data[i] == 0x26 || data[i] == 0x27) {
-			i += 1;
-		} else if (data[i] == '\x00') {
-			i += 1;
-		} else if (data[i] == VERSIONSTAMP_96_CODE) {
-			i += VERSIONSTAMP_TUPLE_SIZE + 1;
-		} else if (include_user_type && isUserType(data[i])) {
-			// User defined codes must come at the end of a Tuple and are not delimited.
-			i = data.size();
-		} else {
-			throw invalid_tuple_data_type();
-		}
+		i = TupleView::elementEnd(str, i, include_user_type);
 	}
 	// If incomplete tuples are allowed, remove the last offset if i is now beyond size()
 	// Strings will never be considered incomplete due to the way the string end is found.
@@ -146,7 +139,7 @@ Tuple Tuple::unpackUserType(StringRef const& str, bool exclude_incomplete) {
 }
 
 bool Tuple::isUserType(uint8_t code) const {
-	return code >= USER_TYPE_START && code <= USER_TYPE_END;
+	return isUserTypeCode(code);
 }
 
 Tuple& Tuple::append(Tuple const& tuple) {
@@ -171,20 +164,26 @@ Tuple& Tuple::append(TupleVersionstamp const& vs) {
 Tuple& Tuple::append(StringRef const& str, bool utf8) {
 	offsets.push_back(data.size());
 
+	// Most strings have no nulls to escape, so this is usually the only allocation
+	data.reserve(data.arena(), data.size() + str.size() + 2);
+
 	const uint8_t utfChar = uint8_t(utf8 ? '\x02' : '\x01');
-	data.append(data.arena(), &utfChar, 1);
-
-	size_t lastPos = 0;
-	for (size_t pos = 0; pos < str.size(); ++pos) {
-		if (str[pos] == '\x00') {
-			data.append(data.arena(), str.begin() + lastPos, pos - lastPos);
-			data.push_back(data.arena(), (uint8_t)'\x00');
-			data.push_back(data.arena(), (uint8_t)'\xff');
-			lastPos = pos + 1;
+	data.push_back(data.arena(), utfChar);
+
+	const uint8_t* begin = str.begin();
+	const uint8_t* end = str.end();
+	while (begin != end) {
+		const uint8_t* zero = (const uint8_t*)memchr(begin, 0, end - begin);
+		if (zero == nullptr) {
+			break;
 		}
+		data.append(data.arena(), begin, zero - begin);
+		data.push_back(data.arena(), (uint8_t)'\x00');
+		data.push_back(data.arena(), (uint8_t)'\xff');
+		begin = zero + 1;
 	}
 
-	data.append(data.arena(), str.begin() + lastPos, str.size() - lastPos);
+	data.append(data.arena(), begin, end - begin);
 	data.push_back(data.arena(), (uint8_t)'\x00');
 
 	return *this;
@@ -282,87 +281,222 @@ Tuple& Tuple::append(Tuple::UserTypeStr const& udt) {
 	return *this;
 }
 
-Tuple::ElementType Tuple::getType(size_t index) const {
+StringRef Tuple::elementAt(size_t index) const {
 	if (index >= offsets.size()) {
 		throw invalid_tuple_index();
 	}
+	ASSERT_LT(offsets[index], data.size());
+	size_t end = index + 1 < offsets.size() ? offsets[index + 1] : data.size();
+	return StringRef(data.begin() + offsets[index], end - offsets[index]);
+}
 
-	uint8_t code = data[offsets[index]];
+Tuple::ElementType Tuple::getType(size_t index) const {
+	return TupleView::Element(elementAt(index)).getType();
+}
 
-	if (code == '\x00') {
-		return ElementType::NULL_TYPE;
-	} else if (code == '\x01') {
-		return ElementType::BYTES;
-	} else if (code == '\x02') {
-		return ElementType::UTF8;
-	} else if (code >= '\x0c' && code <= '\x1c') {
-		return ElementType::INT;
-	} else if (code == 0x20) {
-		return ElementType::FLOAT;
-	} else if (code == 0x21) {
-		return ElementType::DOUBLE;
-	} else if (code == 0x26 || code == 0x27) {
-		return ElementType::BOOL;
-	} else if (code == VERSIONSTAMP_96_CODE) {
-		return ElementType::VERSIONSTAMP;
-	} else if (isUserType(code)) {
-		return ElementType::USER_TYPE;
-	} else {
-		throw invalid_tuple_data_type();
+Standalone<StringRef> Tuple::getString(size_t index) const {
+	StringRef element = elementAt(index);
+	Standalone<StringRef> result;
+	StringRef str = TupleView::Element(element).getString(result.arena());
+	if (str.begin() >= element.begin() && str.end() <= element.end()) {
+		// Nothing was unescaped, so share the tuple's memory instead of copying it
+		return Standalone<StringRef>(str, data.arena());
 	}
+	result.StringRef::operator=(str);
+	return result;
 }
 
-Standalone<StringRef> Tuple::getString(size_t index) const {
+int64_t Tuple::getInt(size_t index, bool allow_incomplete) const {
+	return TupleView::Element(elementAt(index)).getInt(allow_incomplete);
+}
+
+// TODO: Combine with bindings/flow/Tuple.*. This code is copied from there.
+bool Tuple::getBool(size_t index) const {
+	return TupleView::Element(elementAt(index)).getBool();
+}
+
+float Tuple::getFloat(size_t index) const {
+	return TupleView::Element(elementAt(index)).getFloat();
+}
+
+double Tuple::getDouble(size_t index) const {
+	return TupleView::Element(elementAt(index)).getDouble();
+}
+
+TupleVersionstamp Tuple::getVersionstamp(size_t index) const {
+	return TupleView::Element(elementAt(index)).getVersionstamp();
+}
+
+Tuple::UserTypeStr Tuple::getUserType(size_t index) const {
+	// Valid index.
 	if (index >= offsets.size()) {
 		throw invalid_tuple_index();
 	}
 
+	// Valid user type code.
+	ASSERT_LT(offsets[index], data.size());
 	uint8_t code = data[offsets[index]];
-	if (code != '\x01' && code != '\x02') {
+	if (!isUserType(code)) {
 		throw invalid_tuple_data_type();
 	}
 
-	size_t b = offsets[index] + 1;
-	size_t e;
-	if (offsets.size() > index + 1) {
-		e = offsets[index + 1];
+	size_t start = offsets[index] + 1;
+
+	Standalone<StringRef> str;
+	VectorRef<uint8_t> staging;
+	staging.append(str.arena(), data.begin() + start, data.size() - start);
+	str.StringRef::operator=(StringRef(staging.begin(), staging.size()));
+
+	return Tuple::UserTypeStr(code, str);
+}
+
+KeyRange Tuple::range(Tuple const& tuple) const {
+	VectorRef<uint8_t> begin;
+	VectorRef<uint8_t> end;
+
+	KeyRange keyRange;
+
+	begin.reserve(keyRange.arena(), data.size() + tuple.pack().size() + 1);
+	begin.append(keyRange.arena(), data.begin(), data.size());
+	begin.append(keyRange.arena(), tuple.pack().begin(), tuple.pack().size());
+	begin.push_back(keyRange.arena(), uint8_t('\x00'));
+
+	end.reserve(keyRange.arena(), data.size() + tuple.pack().size() + 1);
+	end.append(keyRange.arena(), data.begin(), data.size());
+	end.append(keyRange.arena(), tuple.pack().begin(), tuple.pack().size());
+	end.push_back(keyRange.arena(), uint8_t('\xff'));
+
+	keyRange.KeyRangeRef::operator=(
+	    KeyRangeRef(StringRef(begin.begin(), begin.size()), StringRef(end.begin(), end.size())));
+	return keyRange;
+}
+
+Tuple Tuple::subTuple(size_t start, size_t end) const {
+	if (start >= offsets.size() || end <= start) {
+		return Tuple();
+	}
+
+	size_t endPos = end < offsets.size() ? offsets[end] : data.size();
+	return Tuple(StringRef(data.begin() + offsets[start], endPos - offsets[start]));
+}
+
+StringRef Tuple::subTupleRawString(size_t index) const {
+	if (index >= offsets.size()) {
+		return StringRef();
+	}
+	size_t end = index + 1;
+	size_t endPos = end < offsets.size() ? offsets[end] : data.size();
+	return StringRef(data.begin() + offsets[index], endPos - offsets[index]);
+}
+
+size_t TupleView::elementEnd(StringRef data, size_t offset, bool include_user_type) {
+	uint8_t code = data[offset];
+	if (code == '\x01' || code == '\x02') {
+		return findStringTerminator(data, offset + 1) + 1;
+	} else if (code >= '\x0c' && code <= '\x1c') {
+		return offset + abs(code - '\x14') + 1;
+	} else if (code == 0x20) {
+		return offset + sizeof(float) + 1;
+	} else if (code == 0x21) {
+		return offset + sizeof(double) + 1;
+	} else if (code == 0x26 || code == 0x27) {
+		return offset + 1;
+	} else if (code == '\x00') {
+		return offset + 1;
+	} else if (code == VERSIONSTAMP_96_CODE) {
+		return offset + VERSIONSTAMP_TUPLE_SIZE + 1;
+	} else if (include_user_type && isUserTypeCode(code)) {
+		// User defined codes must come at the end of a Tuple and are not delimited.
+		return data.size();
 	} else {
-		e = data.size();
+		throw invalid_tuple_data_type();
 	}
+}
 
-	Standalone<StringRef> result;
-	VectorRef<uint8_t> staging;
+TupleView::const_iterator::const_iterator(const TupleView* view, size_t offset) : view(view), offset(offset) {
+	next = offset < view->data.size()
+	           ? std::min<size_t>(elementEnd(view->data, offset, view->include_user_type), view->data.size())
+	           : offset;
+}
+
+TupleView::const_iterator& TupleView::const_iterator::operator++() {
+	*this = const_iterator(view, next);
+	return *this;
+}
 
-	for (size_t i = b; i < e; ++i) {
-		if (data[i] == '\x00') {
-			staging.append(result.arena(), data.begin() + b, i - b);
-			++i;
-			b = i + 1;
+size_t TupleView::size() const {
+	return std::distance(begin(), end());
+}
 
-			if (i < e) {
-				staging.push_back(result.arena(), '\x00');
-			}
+TupleView::Element TupleView::at(size_t index) const {
+	for (auto element : *this) {
+		if (index-- == 0) {
+			return element;
 		}
 	}
+	throw invalid_tuple_index();
+}
 
-	if (b < e) {
-		staging.append(result.arena(), data.begin() + b, e - b);
-	}
+Tuple::ElementType TupleView::Element::getType() const {
+	uint8_t code = encoded[0];
 
-	result.StringRef::operator=(StringRef(staging.begin(), staging.size()));
-	return result;
+	if (code == '\x00') {
+		return Tuple::NULL_TYPE;
+	} else if (code == '\x01') {
+		return Tuple::BYTES;
+	} else if (code == '\x02') {
+		return Tuple::UTF8;
+	} else if (code >= '\x0c' && code <= '\x1c') {
+		return Tuple::INT;
+	} else if (code == 0x20) {
+		return Tuple::FLOAT;
+	} else if (code == 0x21) {
+		return Tuple::DOUBLE;
+	} else if (code == 0x26 || code == 0x27) {
+		return Tuple::BOOL;
+	} else if (code == VERSIONSTAMP_96_CODE) {
+		return Tuple::VERSIONSTAMP;
+	} else if (isUserTypeCode(code)) {
+		return Tuple::USER_TYPE;
+	} else {
+		throw invalid_tuple_data_type();
+	}
 }
 
-int64_t Tuple::getInt(size_t index, bool allow_incomplete) const {
-	if (index >= offsets.size()) {
-		throw invalid_tuple_index();
+StringRef TupleView::Element::getString(Arena& arena) const {
+	uint8_t code = encoded[0];
+	if (code != '\x01' && code != '\x02') {
+		throw invalid_tuple_data_type();
+	}
+
+	const uint8_t* begin = encoded.begin() + 1;
+	const uint8_t* end = encoded.end();
+	// The terminator, if present, is the last null of the element and isn't followed by \xff
+	if (begin != end && end[-1] == '\x00') {
+		--end;
+	}
+	const uint8_t* zero = begin != end ? (const uint8_t*)memchr(begin, 0, end - begin) : nullptr;
+	if (zero == nullptr) {
+		return StringRef(begin, end - begin);
 	}
 
+	// Each escaped null is followed by \xff, which is dropped
+	VectorRef<uint8_t> staging;
+	staging.reserve(arena, end - begin);
+	do {
+		staging.append(arena, begin, zero + 1 - begin);
+		begin = std::min(zero + 2, end);
+		zero = begin != end ? (const uint8_t*)memchr(begin, 0, end - begin) : nullptr;
+	} while (zero != nullptr);
+	staging.append(arena, begin, end - begin);
+	return StringRef(staging.begin(), staging.size());
+}
+
+int64_t TupleView::Element::getInt(bool allow_incomplete) const {
 	int64_t swap;
 	bool neg = false;
 
-	ASSERT(offsets[index] < data.size());
-	uint8_t code = data[offsets[index]];
+	uint8_t code = encoded[0];
 	if (code < '\x0c' || code > '\x1c') {
 		throw invalid_tuple_data_type();
 	}
@@ -376,9 +510,9 @@ int64_t Tuple::getInt(size_t index, bool allow_incomplete) const {
 
 	memset(&swap, neg ? '\xff' : 0, 8 - len);
 	// presentLen is how many of len bytes are actually present, it will be < len if the encoded tuple was truncated
-	int presentLen = std::min<int8_t>(len, data.size() - offsets[index] - 1);
+	int presentLen = std::min<int8_t>(len, encoded.size() - 1);
 	ASSERT(len == presentLen || allow_incomplete);
-	memcpy(((uint8_t*)&swap) + 8 - len, data.begin() + offsets[index] + 1, presentLen);
+	memcpy(((uint8_t*)&swap) + 8 - len, encoded.begin() + 1, presentLen);
 	if (presentLen < len) {
 		int suffix = len - presentLen;
 		if (presentLen == 0) {
@@ -401,13 +535,8 @@ int64_t Tuple::getInt(size_t index, bool allow_incomplete) const {
 	return swap;
 }
 
-// TODO: Combine with bindings/flow/Tuple.*. This code is copied from there.
-bool Tuple::getBool(size_t index) const {
-	if (index >= offsets.size()) {
-		throw invalid_tuple_index();
-	}
-	ASSERT_LT(offsets[index], data.size());
-	uint8_t code = data[offsets[index]];
+bool TupleView::Element::getBool() const {
+	uint8_t code = encoded[0];
 	if (code == 0x26) {
 		return false;
 	} else if (code == 0x27) {
@@ -417,116 +546,42 @@ bool Tuple::getBool(size_t index) const {
 	}
 }
 
-float Tuple::getFloat(size_t index) const {
-	if (index >= offsets.size()) {
-		throw invalid_tuple_index();
-	}
-	ASSERT_LT(offsets[index], data.size());
-	uint8_t code = data[offsets[index]];
+float TupleView::Element::getFloat() const {
+	uint8_t code = encoded[0];
 	if (code != 0x20) {
 		throw invalid_tuple_data_type();
 	}
 
 	float swap;
 	uint8_t* bytes = (uint8_t*)&swap;
-	ASSERT_LE(offsets[index] + 1 + sizeof(float), data.size());
-	swap = *(float*)(data.begin() + offsets[index] + 1);
+	ASSERT_LE(1 + sizeof(float), encoded.size());
+	memcpy(&swap, encoded.begin() + 1, sizeof(float));
 	adjustFloatingPoint(bytes, sizeof(float), false);
 
 	return bigEndianFloat(swap);
 }
 
-double Tuple::getDouble(size_t index) const {
-	if (index >= offsets.size()) {
-		throw invalid_tuple_index();
-	}
-	ASSERT_LT(offsets[index], data.size());
-	uint8_t code = data[offsets[index]];
+double TupleView::Element::getDouble() const {
+	uint8_t code = encoded[0];
 	if (code != 0x21) {
 		throw invalid_tuple_data_type();
 	}
 
 	double swap;
 	uint8_t* bytes = (uint8_t*)&swap;
-	ASSERT_LE(offsets[index] + 1 + sizeof(double), data.size());
-	swap = *(double*)(data.begin() + offsets[index] + 1);
+	ASSERT_LE(1 + sizeof(double), encoded.size());
+	memcpy(&swap, encoded.begin() + 1, sizeof(double));
 	adjustFloatingPoint(bytes, sizeof(double), false);
 
 	return bigEndianDouble(swap);
 }
 
-TupleVersionstamp Tuple::getVersionstamp(size_t index) const {
-	if (index >= offsets.size()) {
-		throw invalid_tuple_index();
-	}
-	ASSERT_LT(offsets[index], data.size());
-	uint8_t code = data[offsets[index]];
+TupleVersionstamp TupleView::Element::getVersionstamp() const {
+	uint8_t code = encoded[0];
 	if (code != VERSIONSTAMP_96_CODE) {
 		throw invalid_tuple_data_type();
 	}
-	return TupleVersionstamp(StringRef(data.begin() + offsets[index] + 1, VERSIONSTAMP_TUPLE_SIZE));
-}
-
-Tuple::UserTypeStr Tuple::getUserType(size_t index) const {
-	// Valid index.
-	if (index >= offsets.size()) {
-		throw invalid_tuple_index();
-	}
-
-	// Valid user type code.
-	ASSERT_LT(offsets[index], data.size());
-	uint8_t code = data[offsets[index]];
-	if (!isUserType(code)) {
-		throw invalid_tuple_data_type();
-	}
-
-	size_t start = offsets[index] + 1;
-
-	Standalone<StringRef> str;
-	VectorRef<uint8_t> staging;
-	staging.append(str.arena(), data.begin() + start, data.size() - start);
-	str.StringRef::operator=(StringRef(staging.begin(), staging.size()));
-
-	return Tuple::UserTypeStr(code, str);
-}
-
-KeyRange Tuple::range(Tuple const& tuple) const {
-	VectorRef<uint8_t> begin;
-	VectorRef<uint8_t> end;
-
-	KeyRange keyRange;
-
-	begin.reserve(keyRange.arena(), data.size() + tuple.pack().size() + 1);
-	begin.append(keyRange.arena(), data.begin(), data.size());
-	begin.append(keyRange.arena(), tuple.pack().begin(), tuple.pack().size());
-	begin.push_back(keyRange.arena(), uint8_t('\x00'));
-
-	end.reserve(keyRange.arena(), data.size() + tuple.pack().size() + 1);
-	end.append(keyRange.arena(), data.begin(), data.size());
-	end.append(keyRange.arena(), tuple.pack().begin(), tuple.pack().size());
-	end.push_back(keyRange.arena(), uint8_t('\xff'));
-
-	keyRange.KeyRangeRef::operator=(
-	    KeyRangeRef(StringRef(begin.begin(), begin.size()), StringRef(end.begin(), end.size())));
-	return keyRange;
-}
-
-Tuple Tuple::subTuple(size_t start, size_t end) const {
-	if (start >= offsets.size() || end <= start) {
-		return Tuple();
-	}
-
-	size_t endPos = end < offsets.size() ? offsets[end] : data.size();
-	return Tuple(StringRef(data.begin() + offsets[start], endPos - offsets[start]));
-}
-
-StringRef Tuple::subTupleRawString(size_t index) const {
-	if (index >= offsets.size()) {
-		return StringRef();
-	}
-	size_t end = index + 1;
-	size_t endPos = end < offsets.size() ? offsets[end] : data.size();
-	return StringRef(data.begin() + offsets[index], endPos - offsets[index]);
+	return TupleVersionstamp(StringRef(encoded.begin() + 1, VERSIONSTAMP_TUPLE_SIZE));
 }
 
 TEST_CASE("/fdbclient/Tuple/makeTuple") {
@@ -601,3 +656,62 @@ TEST_CASE("/fdbclient/Tuple/unpack") {
 
 	return Void();
 }
+
+TEST_CASE("/fdbclient/Tuple/escapedStrings") {
+	const StringRef strings[] = { ""_sr, "plain"_sr, "\x00"_sr, "a\x00z\x00\x00"_sr, "\x00\xff\x00"_sr, "end\xff"_sr };
+	for (StringRef str : strings) {
+		Tuple t = Tuple::makeTuple(str, 7, str);
+		ASSERT(t.getString(0) == str && t.getString(2) == str);
+		Tuple unpacked = Tuple::unpack(t.pack());
+		ASSERT(unpacked.size() == 3 && unpacked.getString(0) == str && unpacked.getString(2) == str);
+	}
+	return Void();
+}
+
+TEST_CASE("/fdbclient/Tuple/view") {
+	Tuple t = Tuple::makeTuple(-12345,
+	                           1.5f,
+	                           2.5,
+	                           true,
+	                           "byte\x00Str"_sr,
+	                           Tuple::UnicodeStr("str"_sr),
+	                           nullptr,
+	                           TupleVersionstamp("000000000000"_sr));
+	Standalone<StringRef> packed = t.pack();
+	TupleView view(packed);
+	ASSERT(view.size() == t.size());
+
+	size_t i = 0;
+	for (auto element : view) {
+		ASSERT(element.getType() == t.getType(i));
+		ASSERT(element.raw() == t.subTupleRawString(i));
+		++i;
+	}
+	ASSERT(i == t.size());
+
+	Arena arena;
+	ASSERT(view.at(0).getInt() == -12345);
+	ASSERT(view.at(1).getFloat() == 1.5f);
+	ASSERT(view.at(2).getDouble() == 2.5);
+	ASSERT(view.at(3).getBool());
+	ASSERT(view.at(4).getString(arena) == "byte\x00Str"_sr);
+	// A string without escaped nulls isn't copied
+	StringRef str = view.at(5).getString(arena);
+	ASSERT(str == "str"_sr && str.begin() > packed.begin() && str.end() < packed.end());
+	ASSERT(view.at(7).getVersionstamp() == t.getVersionstamp(7));
+
+	try {
+		view.at(8);
+		ASSERT(false);
+	} catch (Error& e) {
+		ASSERT(e.code() == error_code_invalid_tuple_index);
+	}
+
+	try {
+		TupleView(Tuple::makeTuple(Tuple::UserTypeStr(0x41, "1"_sr)).pack()).size();
+		ASSERT(false);
+	} catch (Error& e) {
+		ASSERT(e.code() == error_code_invalid_tuple_data_type);
+	}
+	return Void();
+}
@@ -88,6 +88,13 @@ TEST_CASE("/fdbclient/VersionVector/simpleVV") {
 
 	ASSERT(serializedVV.compare(deserializedVV));
 
+	// Loading caches the encoded size, and a vector loaded into a non-empty one replaces it
+	ASSERT(deserializedVV.isEncodedSizeCached() && deserializedVV.getCachedEncodedSize() == size);
+	VersionVector reloadedVV;
+	reloadedVV.setVersion(Tag(1, 7), 1);
+	dynamic_size_traits<VersionVector>::load(buf, size, reloadedVV, context);
+	ASSERT(serializedVV.compare(reloadedVV));
+
 	return Void();
 }
 
@@ -19,12 +19,13 @@
  */
 
 #include "fdbclient/VersionedMap.h"
+#include "fdbclient/VersionedWideMap.h"
 #include "flow/TreeBenchmark.h"
 #include "flow/UnitTest.h"
 
-template <typename K>
+template <typename K, template <class, class> class Map = VersionedMap>
 struct VersionedMapHarness {
-	using map = VersionedMap<K, int>;
+	using map = Map<K, int>;
 	using key_type = K;
 
 	struct result {
@@ -74,4 +75,116 @@ TEST_CASE("performance/map/StringRef/VersionedMap") {
 	return Void();
 }
 
+TEST_CASE("performance/map/int/VersionedWideMap") {
+	VersionedMapHarness<int, VersionedWideMap> tree;
+
+	treeBenchmark(tree, *randomInt);
+
+	return Void();
+}
+
+TEST_CASE("performance/map/StringRef/VersionedWideMap") {
+	Arena arena;
+	VersionedMapHarness<StringRef, VersionedWideMap> tree;
+
+	treeBenchmark(tree, [&arena]() { return randomStr(arena); });
+
+	return Void();
+}
+
+template <class A, class B>
+static void checkSameView(A const& a, B const& b, int keys) {
+	auto i = a.begin();
+	auto j = b.begin();
+	for (; i != a.end(); ++i, ++j) {
+		ASSERT(j != b.end());
+		ASSERT(i.key() == j.key() && *i == *j && i.insertVersion() == j.insertVersion());
+	}
+	ASSERT(j == b.end());
+
+	for (int t = 0; t < 10; t++) {
+		int k = deterministicRandom()->randomInt(-1, keys + 1);
+		auto sameAt = [](auto x, auto const& endX, auto y, auto const& endY) {
+			ASSERT((x == endX) == (y == endY));
+			ASSERT(x == endX || (x.key() == y.key() && *x == *y));
+		};
+		sameAt(a.find(k), a.end(), b.find(k), b.end());
+		sameAt(a.lower_bound(k), a.end(), b.lower_bound(k), b.end());
+		sameAt(a.upper_bound(k), a.end(), b.upper_bound(k), b.end());
+		sameAt(a.lastLessOrEqual(k), a.end(), b.lastLessOrEqual(k), b.end());
+		sameAt(a.lastLess(k), a.end(), b.lastLess(k), b.end());
+
+		auto x = a.lower_bound(k);
+		auto y = b.lower_bound(k);
+		--x;
+		--y;
+		sameAt(x, a.end(), y, b.end());
+	}
+}
+
+// Checks VersionedWideMap against VersionedMap, including views of old versions that are held while later versions are
+// written and forgotten, as the storage server holds them across waits.
+TEST_CASE("/fdbclient/VersionedWideMap/Model") {
+	VersionedMap<int, int> model;
+	VersionedWideMap<int, int> map;
+	std::vector<std::pair<VersionedMap<int, int>::ViewAtVersion, VersionedWideMap<int, int>::ViewAtVersion>> held;
+	const int keys = deterministicRandom()->randomInt(10, 2000);
+	const int writes = deterministicRandom()->randomInt(1, 200);
+
+	for (Version v = 1; v <= 300; v++) {
+		model.createNewVersion(v);
+		map.createNewVersion(v);
+		for (int w = deterministicRandom()->randomInt(0, writes); w > 0; w--) {
+			int k = deterministicRandom()->randomInt(0, keys);
+			if (deterministicRandom()->random01() < 0.7) {
+				int value = deterministicRandom()->randomInt(0, 1000);
+				Version insertAt = deterministicRandom()->coinflip() ? v : deterministicRandom()->randomInt(1, v + 1);
+				model.insert(k, value, insertAt);
+				map.insert(k, value, insertAt);
+			} else if (deterministicRandom()->coinflip()) {
+				int end = k + deterministicRandom()->randomInt(1, 20);
+				model.erase(k, end);
+				map.erase(k, end);
+			} else if (model.atLatest().find(k) != model.atLatest().end()) {
+				model.erase(k);
+				auto i = map.atLatest().find(k);
+				map.erase(i);
+			}
+		}
+		checkSameView(model.atLatest(), map.atLatest(), keys);
+
+		if (deterministicRandom()->random01() < 0.1) {
+			Version at = deterministicRandom()->randomInt(map.oldestVersion, v + 1);
+			held.emplace_back(model.at(at), map.at(at));
+		}
+		if (!held.empty() && deterministicRandom()->random01() < 0.05) {
+			held.erase(held.begin() + deterministicRandom()->randomInt(0, held.size()));
+		}
+		for (auto& [a, b] : held) {
+			checkSameView(a, b, keys);
+		}
+		if (deterministicRandom()->random01() < 0.2) {
+			Version oldest = deterministicRandom()->randomInt(map.oldestVersion, v + 1);
+			model.forgetVersionsBefore(oldest);
+			map.forgetVersionsBefore(oldest);
+			Version at = deterministicRandom()->randomInt(oldest, v + 1);
+			checkSameView(model.at(at), map.at(at), keys);
+		}
+		map.atLatest().validate();
+	}
+
+	held.clear();
+	model.forgetVersionsBefore(300);
+	map.forgetVersionsBefore(300);
+	checkSameView(model.atLatest(), map.atLatest(), keys);
+	int64_t count = 0;
+	for (auto i = map.atLatest().begin(); i != map.atLatest().end(); ++i) {
+		count++;
+	}
+	// Once every older version is forgotten, erased keys no longer take entries
+	ASSERT(map.size() == count);
+
+	return Void();
+}
+
 void forceLinkVersionedMapTests() {}
@@ -81,11 +81,31 @@ WriteMap& WriteMap::operator=(WriteMap&& r) noexcept {
 	ver = r.ver;
 	scratch_iterator = std::move(r.scratch_iterator);
 	arena = r.arena;
+	lastWrite = r.lastWrite;
 	return *this;
 }
 
 void WriteMap::mutate(KeyRef key, MutationRef::Type operation, ValueRef param, bool addConflict) {
 	writeMapEmpty = false;
+	bool is_versionstamp =
+	    operation == MutationRef::SetVersionstampedValue || operation == MutationRef::SetVersionstampedKey;
+	bool is_dependent = operation != MutationRef::SetValue && !is_versionstamp;
+
+	if (lastWrite.present() && key > lastWrite.get().key && key < allKeys.end) {
+		LastWrite& last = lastWrite.get();
+		insertWrite(key,
+		            operation,
+		            param,
+		            is_dependent,
+		            last.cleared,
+		            last.conflict,
+		            addConflict || last.conflict,
+		            last.unreadable,
+		            last.unreadable || is_versionstamp);
+		last.key = key;
+		return;
+	}
+
 	auto& it = scratch_iterator;
 	it.reset(writes, ver);
 	it.skip(key);
@@ -94,38 +114,27 @@ void WriteMap::mutate(KeyRef key, MutationRef::Type operation, ValueRef param, b
 	bool following_conflict = it.entry().following_keys_conflict;
 	bool is_conflict = addConflict || it.is_conflict_range();
 	bool following_unreadable = it.entry().following_keys_unreadable;
-	bool is_unreadable = it.is_unreadable() || operation == MutationRef::SetVersionstampedValue ||
-	                     operation == MutationRef::SetVersionstampedKey;
-	bool is_dependent = operation != MutationRef::SetValue && operation != MutationRef::SetVersionstampedValue &&
-	                    operation != MutationRef::SetVersionstampedKey;
+	bool is_unreadable = it.is_unreadable() || is_versionstamp;
 
 	if (it.entry().key != key) {
-		if (it.is_cleared_range() && is_dependent) {
-			it.tree.clear();
-			OperationStack op(RYWMutation(Optional<StringRef>(), MutationRef::SetValue));
-			coalesceOver(op, RYWMutation(param, operation), *arena);
-			PTreeImpl::insert(
-			    writes,
-			    ver,
-			    WriteMapEntry(
-			        key, std::move(op), true, following_conflict, is_conflict, following_unreadable, is_unreadable));
-		} else {
-			it.tree.clear();
-			PTreeImpl::insert(writes,
-			                  ver,
-			                  WriteMapEntry(key,
-			                                OperationStack(RYWMutation(param, operation)),
-			                                is_cleared,
-			                                following_conflict,
-			                                is_conflict,
-			                                following_unreadable,
-			                                is_unreadable));
+		if (it.nextEntry().key == allKeys.end) {
+			lastWrite = LastWrite{ key, is_cleared, following_conflict, following_unreadable };
 		}
+		it.tree.clear();
+		insertWrite(key,
+		            operation,
+		            param,
+		            is_dependent,
+		            is_cleared,
+		            following_conflict,
+		            is_conflict,
+		            following_unreadable,
+		            is_unreadable);
 	} else {
+		// PTreeImpl::insert() replaces the entry with an equal key
 		if (!it.is_unreadable() &&
 		    (operation == MutationRef::SetValue || operation == MutationRef::SetVersionstampedValue)) {
 			it.tree.clear();
-			PTreeImpl::remove(writes, ver, key);
 			PTreeImpl::insert(writes,
 			                  ver,
 			                  WriteMapEntry(key,
@@ -148,17 +157,45 @@ void WriteMap::mutate(KeyRef key, MutationRef::Type operation, ValueRef param, b
 				e.stack.push(RYWMutation(param, operation));
 
 			it.tree.clear();
-			PTreeImpl::remove(
-			    writes,
-			    ver,
-			    e.key); // FIXME: Make PTreeImpl::insert do this automatically (see also VersionedMap.h FIXME)
 			PTreeImpl::insert(writes, ver, std::move(e));
 		}
 	}
 }
 
+// Inserts a write to a key that has no entry yet, in a range with the given flags
+void WriteMap::insertWrite(KeyRef key,
+                           MutationRef::Type operation,
+                           ValueRef param,
+                           bool is_dependent,
+                           bool is_cleared,
+                           bool following_conflict,
+                           bool is_conflict,
+                           bool following_unreadable,
+                           bool is_unreadable) {
+	if (is_cleared && is_dependent) {
+		OperationStack op(RYWMutation(Optional<StringRef>(), MutationRef::SetValue));
+		coalesceOver(op, RYWMutation(param, operation), *arena);
+		PTreeImpl::insert(
+		    writes,
+		    ver,
+		    WriteMapEntry(
+		        key, std::move(op), true, following_conflict, is_conflict, following_unreadable, is_unreadable));
+	} else {
+		PTreeImpl::insert(writes,
+		                  ver,
+		                  WriteMapEntry(key,
+		                                OperationStack(RYWMutation(param, operation)),
+		                                is_cleared,
+		                                following_conflict,
+		                                is_conflict,
+		                                following_unreadable,
+		                                is_unreadable));
+	}
+}
+
 void WriteMap::clear(KeyRangeRef keys, bool addConflict) {
 	writeMapEmpty = false;
+	lastWrite.reset();
 	if (!addConflict) {
 		clearNoConflict(keys);
 		return;
@@ -203,6 +240,7 @@ void WriteMap::clear(KeyRangeRef keys, bool addConflict) {
 }
 
 void WriteMap::addUnmodifiedAndUnreadableRange(KeyRangeRef keys) {
+	lastWrite.reset();
 	auto& it = scratch_iterator;
 	it.reset(writes, ver);
 	it.skip(keys.begin);
@@ -243,6 +281,7 @@ void WriteMap::addUnmodifiedAndUnreadableRange(KeyRangeRef keys) {
 
 void WriteMap::addConflictRange(KeyRangeRef keys) {
 	writeMapEmpty = false;
+	lastWrite.reset();
 	auto& it = scratch_iterator;
 	it.reset(writes, ver);
 	it.skip(keys.begin);
@@ -525,6 +564,7 @@ void WriteMap::dump() {
 }
 
 void WriteMap::clearNoConflict(KeyRangeRef keys) {
+	lastWrite.reset();
 	auto& it = scratch_iterator;
 	it.reset(writes, ver);
 
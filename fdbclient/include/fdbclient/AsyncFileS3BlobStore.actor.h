@@ -292,9 +292,12 @@ public:
 	std::string m_bucket;
 	std::string m_object;
 	mutable Future<int64_t> m_size;
+	// Limits the ranged GETs in flight when a large read is split into read_block_size pieces
+	FlowLock m_concurrentReads;
 
 	AsyncFileS3BlobStoreRead(Reference<S3BlobStoreEndpoint> bstore, std::string bucket, std::string object)
-	  : m_bstore(bstore), m_bucket(bucket), m_object(object) {}
+	  : m_bstore(bstore), m_bucket(bucket), m_object(object),
+	    m_concurrentReads(bstore->knobs.concurrent_reads_per_file) {}
 };
 
 #include "flow/unactorcompiler.h"
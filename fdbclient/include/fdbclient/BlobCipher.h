@@ -52,6 +52,7 @@
 #include <openssl/sha.h>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <variant>
 #include <vector>
 #if defined(HAVE_WOLFSSL)
@@ -640,6 +641,21 @@ public:
 		return now() + INetwork::TIME_EPS >= expireAtTS ? true : false;
 	}
 
+	// Whether the key will need a refresh within the given number of seconds
+	inline bool needsRefreshWithin(int64_t seconds) {
+		if (refreshAtTS == std::numeric_limits<int64_t>::max()) {
+			return false;
+		}
+		return now() + seconds + INetwork::TIME_EPS >= refreshAtTS;
+	}
+
+	// The key is immutable, but when it is fetched again and is still the latest key for its domain, its refresh and
+	// expire times move forward
+	void extendRefreshAndExpireAt(const int64_t refreshAt, const int64_t expireAt) {
+		refreshAtTS = std::max(refreshAtTS, refreshAt);
+		expireAtTS = std::max(expireAtTS, expireAt);
+	}
+
 	BlobCipherDetails details() const { return BlobCipherDetails{ encryptDomainId, baseCipherId, randomSalt }; }
 
 	void reset();
@@ -833,6 +849,10 @@ public:
 	// Total number of cipher keys in the cache.
 	size_t getSize() const { return size; }
 
+	// Marks domainId's latest cipher key as being refetched ahead of its refresh time. Returns false if it already is.
+	bool startRefreshAhead(const EncryptCipherDomainId domainId) { return refreshingAhead.insert(domainId).second; }
+	void finishRefreshAhead(const EncryptCipherDomainId domainId) { refreshingAhead.erase(domainId); }
+
 	static Reference<BlobCipherKeyCache> getInstance() {
 		static bool cleanupRegistered = false;
 		if (!cleanupRegistered) {
@@ -857,6 +877,7 @@ public:
 private:
 	BlobCipherDomainCacheMap domainCacheMap;
 	size_t size = 0;
+	std::unordered_set<EncryptCipherDomainId> refreshingAhead;
 
 	BlobCipherKeyCache() {}
 };
@@ -894,6 +915,11 @@ public:
 	                           BlobCipherMetrics::UsageType usageType);
 	~EncryptBlobCipherAes265Ctr();
 
+	// Replaces the IV used by the following encrypt() call, keeping the cipher context and its expanded key. This lets
+	// one cipher encrypt many small buffers of the same domain, each with its own IV and header, without paying for
+	// the context setup per buffer.
+	void resetIV(const uint8_t* iv, const int ivLen);
+
 	Reference<EncryptBuf> encrypt(const uint8_t* plaintext,
 	                              const int plaintextLen,
 	                              BlobCipherEncryptHeader* header,
@@ -32,7 +32,8 @@ Value serializeChunkedSnapshot(const Standalone<StringRef>& fileNameRef,
                                int chunkSize,
                                Optional<CompressionFilter> compressFilter,
                                Optional<BlobGranuleCipherKeysCtx> cipherKeysCtx = {},
-                               bool isSnapshotSorted = true);
+                               bool isSnapshotSorted = true,
+                               bool columnar = false);
 
 Value serializeChunkedDeltaFile(const Standalone<StringRef>& fileNameRef,
                                 const Standalone<GranuleDeltas>& deltas,
@@ -0,0 +1,70 @@
+/*
+ * BulkLoading.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FDBCLIENT_BULKLOADING_H
+#define FDBCLIENT_BULKLOADING_H
+#pragma once
+
+#include "fdbclient/FDBTypes.h"
+
+// A range file in the format written by backup, of blocks of sorted key-value pairs
+struct BulkLoadFile {
+	constexpr static FileIdentifier file_identifier = 10025729;
+
+	BulkLoadFile() = default;
+	BulkLoadFile(std::string fileName, int64_t fileSize, uint32_t blockSize)
+	  : fileName(fileName), fileSize(fileSize), blockSize(blockSize) {}
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar, fileName, fileSize, blockSize);
+	}
+
+	std::string fileName;
+	int64_t fileSize = 0;
+	uint32_t blockSize = 0;
+};
+
+// The files that hold all of the data of a bulk loaded range.  Storage servers that are assigned part of the range read
+// it from these files instead of copying it from the servers that already have it, so the data never passes through
+// the commit proxies or the logs.
+struct BulkLoadState {
+	constexpr static FileIdentifier file_identifier = 15447360;
+
+	BulkLoadState() = default;
+	BulkLoadState(std::string containerUrl, std::vector<BulkLoadFile> files)
+	  : containerUrl(containerUrl), files(files) {}
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar, containerUrl, files);
+	}
+
+	std::string toString() const {
+		return "BulkLoadState: [Container]: " + containerUrl + ", [Files]: " + std::to_string(files.size());
+	}
+
+	// The backup container that holds the files
+	std::string containerUrl;
+	// In key order, without overlaps
+	std::vector<BulkLoadFile> files;
+};
+
+#endif
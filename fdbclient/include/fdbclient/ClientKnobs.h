@@ -48,6 +48,7 @@ public:
 	double COORDINATOR_RECONNECTION_DELAY;
 	int CLIENT_EXAMPLE_AMOUNT;
 	double MAX_CLIENT_STATUS_AGE;
+	double SPECIAL_KEY_SHARED_RESULT_AGE;
 	int MAX_COMMIT_PROXY_CONNECTIONS;
 	int MAX_GRV_PROXY_CONNECTIONS;
 	double STATUS_IDLE_TIMEOUT;
@@ -73,7 +74,9 @@ public:
 	int64_t SYSTEM_KEY_SIZE_LIMIT;
 	int64_t VALUE_SIZE_LIMIT;
 	int64_t SPLIT_KEY_SIZE_LIMIT;
+	bool RYW_BLIND_WRITES; // Writes of a transaction that has not read go straight to the native transaction
 	int METADATA_VERSION_CACHE_SIZE;
+	int64_t IMMUTABLE_VALUE_CACHE_BYTES; // Bytes of values cached for keys under the IMMUTABLE_KEY_PREFIX option
 	int64_t CHANGE_FEED_LOCATION_LIMIT;
 	int64_t CHANGE_FEED_CACHE_SIZE;
 	double CHANGE_FEED_POP_TIMEOUT;
@@ -84,6 +87,9 @@ public:
 	int MAX_BATCH_SIZE;
 	double GRV_BATCH_TIMEOUT;
 	int BROADCAST_BATCH_SIZE;
+	bool COMMIT_BATCHING; // Commits started in the same run loop iteration are sent to one commit proxy together
+	int COMMIT_BATCH_MAX_SIZE;
+	int COMMIT_BATCH_MAX_BYTES;
 	double TRANSACTION_TIMEOUT_DELAY_INTERVAL;
 
 	// When locationCache in DatabaseContext gets to be this size, items will be evicted
@@ -91,7 +97,10 @@ public:
 	int LOCATION_CACHE_EVICTION_SIZE_SIM;
 	double LOCATION_CACHE_ENDPOINT_FAILURE_GRACE_PERIOD;
 	double LOCATION_CACHE_FAILED_ENDPOINT_RETRY_INTERVAL;
+	int LOCATION_CACHE_PREFETCH_SHARDS; // Shards, starting with the one containing the key, cached by a forward lookup
 
+	bool COALESCE_GET_VALUES; // Send the point reads a transaction issues to one shard in the same tick as one request
+	int GET_VALUES_MAX_KEYS; // The most keys coalesced into one GetValuesRequest
 	int GET_RANGE_SHARD_LIMIT;
 	int WARM_RANGE_SHARD_LIMIT;
 	int STORAGE_METRICS_SHARD_LIMIT;
@@ -143,6 +152,7 @@ public:
 	int TASKBUCKET_CHECK_ACTIVE_AMOUNT;
 	int TASKBUCKET_TIMEOUT_VERSIONS;
 	int TASKBUCKET_MAX_TASK_KEYS;
+	int TASKBUCKET_CLAIM_SCAN_ROWS; // Rows read at a time while looking for tasks to claim in a batch
 
 	// Backup
 	int BACKUP_LOCAL_FILE_WRITE_BLOCK;
@@ -150,6 +160,8 @@ public:
 	int BACKUP_SIMULATED_LIMIT_BYTES;
 	int BACKUP_GET_RANGE_LIMIT_BYTES;
 	int BACKUP_LOCK_BYTES;
+	int BACKUP_RANGE_READ_PARALLELISM; // parts of a backup range task's range read at once
+	int64_t BACKUP_RANGE_READ_SPLIT_BYTES;
 	double BACKUP_RANGE_TIMEOUT;
 	double BACKUP_RANGE_MINWAIT;
 	int BACKUP_SNAPSHOT_DISPATCH_INTERVAL_SEC;
@@ -180,6 +192,7 @@ public:
 	int RESTORE_DISPATCH_ADDTASK_SIZE;
 	int RESTORE_DISPATCH_BATCH_SIZE;
 	int RESTORE_WRITE_TX_SIZE;
+	bool RESTORE_SKIP_UNNEEDED_BLOCKS; // partial restores check a range block's key range before reading all of it
 	int APPLY_MAX_LOCK_BYTES;
 	int APPLY_MIN_LOCK_BYTES;
 	int APPLY_BLOCK_SIZE;
@@ -214,6 +227,15 @@ public:
 	int64_t CSI_SIZE_LIMIT;
 	double CSI_STATUS_DELAY;
 
+	// Traffic capture, see TrafficCapture.h
+	std::string TRAFFIC_CAPTURE_FILE; // Captures nothing if empty
+	double TRAFFIC_CAPTURE_SAMPLE_RATE; // Fraction of transactions captured
+	double TRAFFIC_CAPTURE_FLUSH_INTERVAL;
+
+	// Fraction of commits and point reads that carry their client queue time to the servers, which then record where
+	// the rest of their latency went in the latency_breakdown of their role in status
+	double LATENCY_BREAKDOWN_SAMPLE_RATE;
+
 	bool HTTP_REQUEST_AWS_V4_HEADER; // setting this knob to true will enable AWS V4 style header.
 	std::string BLOBSTORE_ENCRYPTION_TYPE;
 	int BLOBSTORE_CONNECT_TRIES;
@@ -276,7 +298,9 @@ public:
 
 	// Blob Granules
 	int BG_MAX_GRANULE_PARALLELISM;
+	int BG_MATERIALIZE_THREADS; // threads shared by all blob granule reads in the process
 	int BG_TOO_MANY_GRANULES;
+	int64_t BG_FILE_CACHE_BYTES; // per process, for blob granule files read through BlobGranuleReader
 	int64_t BLOB_METADATA_REFRESH_INTERVAL;
 
 	// The coordinator key/value in storage server might be inconsistent to the value stored in the cluster file.
@@ -310,6 +334,8 @@ public:
 	int ENCRYPT_HEADER_AES_CTR_NO_AUTH_VERSION;
 	int ENCRYPT_HEADER_AES_CTR_AES_CMAC_AUTH_VERSION;
 	int ENCRYPT_HEADER_AES_CTR_HMAC_SHA_AUTH_VERSION;
+	// Seconds before a cached latest cipher key needs a refresh that it is refetched in the background, 0 to disable
+	int ENCRYPT_CIPHER_KEY_REFRESH_AHEAD;
 
 	ClientKnobs(Randomize randomize);
 	void initialize(Randomize randomize);
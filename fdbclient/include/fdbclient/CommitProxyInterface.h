@@ -65,6 +65,7 @@ struct CommitProxyInterface {
 	PublicRequestStream<struct ExpireIdempotencyIdRequest> expireIdempotencyId;
 	PublicRequestStream<struct GetTenantIdRequest> getTenantId;
 	PublicRequestStream<struct GetBlobGranuleLocationsRequest> getBlobGranuleLocations;
+	PublicRequestStream<struct CommitTransactionBatchRequest> commitBatch;
 
 	UID id() const { return commit.getEndpoint().token; }
 	std::string toString() const { return id().shortString(); }
@@ -96,6 +97,8 @@ struct CommitProxyInterface {
 			getTenantId = PublicRequestStream<struct GetTenantIdRequest>(commit.getEndpoint().getAdjustedEndpoint(11));
 			getBlobGranuleLocations = PublicRequestStream<struct GetBlobGranuleLocationsRequest>(
 			    commit.getEndpoint().getAdjustedEndpoint(12));
+			commitBatch =
+			    PublicRequestStream<struct CommitTransactionBatchRequest>(commit.getEndpoint().getAdjustedEndpoint(13));
 		}
 	}
 
@@ -115,6 +118,7 @@ struct CommitProxyInterface {
 		streams.push_back(expireIdempotencyId.getReceiver());
 		streams.push_back(getTenantId.getReceiver());
 		streams.push_back(getBlobGranuleLocations.getReceiver());
+		streams.push_back(commitBatch.getReceiver(TaskPriority::ReadSocket));
 		FlowTransport::transport().addEndpoints(streams);
 	}
 };
@@ -225,6 +229,9 @@ struct CommitTransactionRequest : TimedRequest {
 
 	TenantInfo tenantInfo;
 
+	// Set on commits sampled for latency breakdown, to the seconds the client spent on the commit before sending it
+	Optional<double> clientQueueTime;
+
 	CommitTransactionRequest() : CommitTransactionRequest(SpanContext()) {}
 	CommitTransactionRequest(SpanContext const& context) : spanContext(context), flags(0) {}
 
@@ -242,10 +249,27 @@ struct CommitTransactionRequest : TimedRequest {
 		           spanContext,
 		           tenantInfo,
 		           idempotencyId,
+		           clientQueueTime,
 		           arena);
 	}
 };
 
+// Several commits sent to a proxy in one message, each of which is committed and replied to as if it had been sent on
+// its own
+struct CommitTransactionBatchRequest {
+	constexpr static FileIdentifier file_identifier = 2287316;
+
+	std::vector<CommitTransactionRequest> transactions;
+
+	// Each transaction is verified as it is forwarded, so that it can be answered with its own error
+	bool verify() const { return true; }
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar, transactions);
+	}
+};
+
 static inline int getBytes(CommitTransactionRequest const& r) {
 	// SOMEDAY: Optimize
 	// return r.arena.getSize(); // NOT correct because arena can be shared!
@@ -273,6 +297,9 @@ struct GetReadVersionReply : public BasicLoadBalancedReply {
 
 	VersionVector ssVersionVectorDelta;
 	UID proxyId; // GRV proxy ID to detect old GRV proxies at client side
+	// If present, the number of seconds after the request was sent for which clients may start transactions at this
+	// version from their GRV cache. Zero means the version must not be cached.
+	Optional<double> cacheLease;
 
 	GetReadVersionReply() : version(invalidVersion), locked(false) {}
 
@@ -289,7 +316,8 @@ struct GetReadVersionReply : public BasicLoadBalancedReply {
 		           rkBatchThrottled,
 		           ssVersionVectorDelta,
 		           proxyId,
-		           proxyTagThrottledDuration);
+		           proxyTagThrottledDuration,
+		           cacheLease);
 	}
 };
 
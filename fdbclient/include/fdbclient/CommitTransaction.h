@@ -214,6 +214,14 @@ struct MutationRef {
 	                    const EncryptCipherDomainId& domainId,
 	                    Arena& arena,
 	                    BlobCipherMetrics::UsageType usageType) const {
+		return encryptWithCipher(*encryptCipher(cipherKeys, domainId, usageType), arena);
+	}
+
+	// Returns a cipher, with a random IV, for encrypting mutations of domainId with encrypt(cipher, arena)
+	static Reference<EncryptBlobCipherAes265Ctr> encryptCipher(
+	    const std::unordered_map<EncryptCipherDomainId, Reference<BlobCipherKey>>& cipherKeys,
+	    const EncryptCipherDomainId& domainId,
+	    BlobCipherMetrics::UsageType usageType) {
 		ASSERT_NE(domainId, INVALID_ENCRYPT_DOMAIN_ID);
 		auto getCipherKey = [&](const EncryptCipherDomainId& domainId) {
 			auto iter = cipherKeys.find(domainId);
@@ -225,18 +233,25 @@ struct MutationRef {
 		if (FLOW_KNOBS->ENCRYPT_HEADER_AUTH_TOKEN_ENABLED) {
 			headerCipherKey = getCipherKey(ENCRYPT_HEADER_DOMAIN_ID);
 		}
-		uint8_t iv[AES_256_IV_LENGTH] = { 0 };
-		deterministicRandom()->randomBytes(iv, AES_256_IV_LENGTH);
-		BinaryWriter bw(AssumeVersion(ProtocolVersion::withEncryptionAtRest()));
-		bw << *this;
-
-		EncryptBlobCipherAes265Ctr cipher(
+		return makeReference<EncryptBlobCipherAes265Ctr>(
 		    textCipherKey,
 		    headerCipherKey,
-		    iv,
-		    AES_256_IV_LENGTH,
 		    getEncryptAuthTokenMode(EncryptAuthTokenMode::ENCRYPT_HEADER_AUTH_TOKEN_MODE_SINGLE),
 		    usageType);
+	}
+
+	// Like the above, but with a cipher shared by many mutations of the same domain, which is given a new random IV
+	// for each. Encrypting small mutations is dominated by the cipher context and key setup, which this pays only once.
+	MutationRef encrypt(EncryptBlobCipherAes265Ctr& cipher, Arena& arena) const {
+		uint8_t iv[AES_256_IV_LENGTH] = { 0 };
+		deterministicRandom()->randomBytes(iv, AES_256_IV_LENGTH);
+		cipher.resetIV(iv, AES_256_IV_LENGTH);
+		return encryptWithCipher(cipher, arena);
+	}
+
+	MutationRef encryptWithCipher(EncryptBlobCipherAes265Ctr& cipher, Arena& arena) const {
+		BinaryWriter bw(AssumeVersion(ProtocolVersion::withEncryptionAtRest()));
+		bw << *this;
 
 		if (CLIENT_KNOBS->ENABLE_CONFIGURABLE_ENCRYPTION) {
 			BlobCipherEncryptHeaderRef header;
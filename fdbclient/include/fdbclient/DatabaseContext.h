@@ -28,6 +28,8 @@
 #include "fdbclient/StorageServerInterface.h"
 #include "flow/IRandom.h"
 #include "flow/genericactors.actor.h"
+#include <deque>
+#include <map>
 #include <vector>
 #include <unordered_map>
 #pragma once
@@ -313,6 +315,8 @@ public:
 	                                                          Optional<int> const& minSplitBytes = {});
 
 	Future<Standalone<VectorRef<ReadHotRangeWithMetrics>>> getReadHotRanges(KeyRange const& keys);
+	// The keys in the range that storage servers count among their most frequently read or written, in key order
+	Future<Standalone<VectorRef<HotKeyRef>>> getHotKeys(KeyRange const& keys);
 
 	// Returns the protocol version reported by the coordinator this client is connected to
 	// If an expected version is given, the future won't return until the protocol version is different than expected
@@ -397,6 +401,9 @@ public:
 
 	Future<OverlappingChangeFeedsInfo> getOverlappingChangeFeeds(KeyRangeRef ranges, Version minVersion);
 	Future<Void> popChangeFeedMutations(Key rangeID, Version version);
+	// Returns the version of the first mutation to range at or after begin in the change feed rangeID, which must cover
+	// range. This watches a whole range without writers having to bump a shared version key.
+	Future<Version> watchChangeFeedRange(Key rangeID, KeyRange range, Version begin);
 
 	// BlobGranule API.
 	Future<Key> purgeBlobGranules(KeyRange keyRange,
@@ -477,6 +484,21 @@ public:
 	};
 	std::map<uint32_t, VersionBatcher> versionBatcher;
 
+	// Commit batching across transactions, see COMMIT_BATCHING
+	struct CommitRequest {
+		CommitTransactionRequest request;
+		double queued;
+		// The proxy the request was sent to, and the peer it was sent through
+		Promise<std::pair<CommitProxyInterface, Reference<Peer>>> sent;
+
+		explicit CommitRequest(CommitTransactionRequest const& request) : request(request), queued(now()) {}
+	};
+	struct CommitBatcher {
+		PromiseStream<CommitRequest> stream;
+		Future<Void> actor;
+	};
+	CommitBatcher commitBatcher;
+
 	AsyncTrigger connectionFileChangedTrigger;
 
 	// Disallow any reads at a read version lower than minAcceptableReadVersion.  This way the client does not have to
@@ -493,6 +515,14 @@ public:
 	};
 	ClientStatusUpdater clientStatusUpdater;
 
+	// Captured transactions waiting to be appended to CLIENT_KNOBS->TRAFFIC_CAPTURE_FILE, see TrafficCapture.h
+	struct TrafficCaptureWriter {
+		std::vector<FdbClientLogEvents::CapturedTransaction> queue;
+		bool failed = false; // Set if the file can't be written, after which nothing more is queued
+		Future<Void> actor;
+	};
+	TrafficCaptureWriter trafficCapture;
+
 	// Cache of location information
 	int locationCacheSize;
 	CoalescedKeyRangeMap<Reference<LocationInfo>> locationCache;
@@ -549,6 +579,7 @@ public:
 	Counter transactionBytesRead;
 	Counter transactionKeysRead;
 	Counter transactionMetadataVersionReads;
+	Counter transactionImmutableValueCacheHits;
 	Counter transactionCommittedMutations;
 	Counter transactionCommittedMutationBytes;
 	Counter transactionSetMutations;
@@ -613,6 +644,10 @@ public:
 	void updateCachedReadVersion(double t, Version v);
 	Version getCachedReadVersion();
 	double getLastGrvTime();
+	// The staleness bound of cached read versions: the lease granted by the last GRV reply which carried one, or
+	// MAX_VERSION_CACHE_LAG
+	Optional<double> grvCacheLease;
+	double getGrvCacheLease() const;
 	double lastRkBatchThrottleTime;
 	double lastRkDefaultThrottleTime;
 	// Cached RVs can be updated through commits, and using cached RVs avoids the proxies altogether
@@ -650,6 +685,35 @@ public:
 	int mvCacheInsertLocation;
 	std::vector<std::pair<Version, Optional<Value>>> metadataVersionCache;
 
+	// Keys under these prefixes are never changed or cleared once written (see the IMMUTABLE_KEY_PREFIX option), so a
+	// value read at some version is the value at every later version. The cache maps each key to its value and the
+	// version it was read at, and evicts in insertion order once it holds more than IMMUTABLE_VALUE_CACHE_BYTES.
+	std::vector<Key> immutableKeyPrefixes;
+	std::map<Key, std::pair<Value, Version>, std::less<>> immutableValueCache;
+	std::deque<Key> immutableValueCacheOrder;
+	int64_t immutableValueCacheBytes = 0;
+	bool isImmutableKey(KeyRef key) const;
+	Optional<Value> getImmutableValue(KeyRef key, Version readVersion) const;
+	void addImmutableValue(Key const& key, Value const& value, Version version);
+
+	// Results of special key reads that make cluster-wide requests, such as \xff\xff/status/json, shared by the
+	// transactions of this database for SPECIAL_KEY_SHARED_RESULT_AGE seconds after they are requested.  A failed
+	// request is not shared once it completes.
+	template <class T>
+	static Future<T> getSharedResult(Future<T>& shared, double& requestTime, std::function<Future<T>()> const& fetch) {
+		if (CLIENT_KNOBS->SPECIAL_KEY_SHARED_RESULT_AGE <= 0) {
+			return fetch();
+		}
+		bool expired = now() - requestTime > CLIENT_KNOBS->SPECIAL_KEY_SHARED_RESULT_AGE;
+		if (!shared.isValid() || (shared.isReady() && (shared.isError() || expired))) {
+			shared = fetch();
+			requestTime = now();
+		}
+		return shared;
+	}
+	Future<Optional<Value>> sharedStatusJson;
+	double sharedStatusJsonTime = 0;
+
 	HealthMetrics healthMetrics;
 	double healthMetricsLastUpdated;
 	double detailedHealthMetricsLastUpdated;
@@ -1656,6 +1656,8 @@ struct ReadOptions {
 	bool lockAware = false;
 	Optional<UID> debugID;
 	Optional<Version> consistencyCheckStartVersion;
+	// Set on reads sampled for latency breakdown, to the seconds the client spent on the read before sending it
+	Optional<double> clientQueueTime;
 
 	ReadOptions(Optional<UID> debugID = Optional<UID>(),
 	            ReadType type = ReadType::NORMAL,
@@ -1667,7 +1669,7 @@ struct ReadOptions {
 
 	template <class Ar>
 	void serialize(Ar& ar) {
-		serializer(ar, type, cacheResult, debugID, consistencyCheckStartVersion, lockAware);
+		serializer(ar, type, cacheResult, debugID, consistencyCheckStartVersion, lockAware, clientQueueTime);
 	}
 };
 
@@ -90,6 +90,42 @@ Future<EKPGetLatestBaseCipherKeysReply> getUncachedLatestEncryptCipherKeys(Refer
 	}
 }
 
+// Refetches the latest cipher keys of the domains in request, whose cached keys are about to need a refresh, so that
+// callers keep hitting the cache instead of all waiting on EncryptKeyProxy at once when the keys' refreshAt passes.
+// Runs detached; if it does not finish within the refresh-ahead window, the callers' own fetches take over.
+ACTOR template <class T>
+void refreshLatestEncryptCipherKeysAhead(Reference<AsyncVar<T> const> db,
+                                         EKPGetLatestBaseCipherKeysRequest request,
+                                         BlobCipherMetrics::UsageType usageType) {
+	state Reference<BlobCipherKeyCache> cipherKeyCache = BlobCipherKeyCache::getInstance();
+	state Future<Void> deadline = delay(CLIENT_KNOBS->ENCRYPT_CIPHER_KEY_REFRESH_AHEAD);
+	try {
+		loop choose {
+			when(EKPGetLatestBaseCipherKeysReply reply =
+			         wait(getUncachedLatestEncryptCipherKeys(db, request, usageType))) {
+				for (const EKPBaseCipherDetails& details : reply.baseCipherDetails) {
+					cipherKeyCache->insertCipherKey(details.encryptDomainId,
+					                                details.baseCipherId,
+					                                details.baseCipherKey.begin(),
+					                                details.baseCipherKey.size(),
+					                                details.refreshAt,
+					                                details.expireAt);
+				}
+				break;
+			}
+			when(wait(onEncryptKeyProxyChange(db))) {}
+			when(wait(deadline)) {
+				break;
+			}
+		}
+	} catch (Error& e) {
+		TraceEvent(SevWarn, "RefreshLatestEncryptCipherKeysAheadFailed").error(e);
+	}
+	for (auto domainId : request.encryptDomainIds) {
+		cipherKeyCache->finishRefreshAhead(domainId);
+	}
+}
+
 // Get latest cipher keys for given encryption domains. It tries to get the cipher keys from local cache.
 // In case of cache miss, it fetches the cipher keys from EncryptKeyProxy and put the result in the local cache
 // before return.
@@ -107,15 +143,24 @@ Future<std::unordered_map<EncryptCipherDomainId, Reference<BlobCipherKey>>> getL
 		throw encrypt_ops_error();
 	}
 
-	// Collect cached cipher keys.
+	// Collect cached cipher keys, and batch the ones that will soon need a refresh into one background fetch.
+	EKPGetLatestBaseCipherKeysRequest refreshAheadRequest;
 	for (auto& domainId : domainIds) {
 		Reference<BlobCipherKey> cachedCipherKey = cipherKeyCache->getLatestCipherKey(domainId);
 		if (cachedCipherKey.isValid()) {
 			cipherKeys[domainId] = cachedCipherKey;
+			if (CLIENT_KNOBS->ENCRYPT_CIPHER_KEY_REFRESH_AHEAD > 0 &&
+			    cachedCipherKey->needsRefreshWithin(CLIENT_KNOBS->ENCRYPT_CIPHER_KEY_REFRESH_AHEAD) &&
+			    cipherKeyCache->startRefreshAhead(domainId)) {
+				refreshAheadRequest.encryptDomainIds.emplace_back(domainId);
+			}
 		} else {
 			request.encryptDomainIds.emplace_back(domainId);
 		}
 	}
+	if (!refreshAheadRequest.encryptDomainIds.empty()) {
+		refreshLatestEncryptCipherKeysAhead(db, refreshAheadRequest, usageType);
+	}
 	if (request.encryptDomainIds.empty()) {
 		return cipherKeys;
 	}
@@ -189,6 +189,13 @@ KeyRangeRef makeIdempotencySingleKeyRange(Arena& arena, Version version, uint8_t
 
 void decodeIdempotencyKey(KeyRef key, Version& commitVersion, uint8_t& highOrderBatchIndex);
 
+// The idempotency id time index has a key per time bucket, set by a commit proxy to the version and time of its first
+// batch with idempotency ids in that bucket. Every id at a lower version was committed before that time, so the cleaner
+// can find the ids old enough to clear without searching them.
+Key idempotencyIdTimeIndexKeyFor(int64_t bucketTime);
+Value idempotencyIdTimeIndexValue(Version version, int64_t time);
+void decodeIdempotencyIdTimeIndexValue(ValueRef value, Version& version, int64_t& time);
+
 ACTOR Future<JsonBuilderObject> getIdmpKeyStatus(Database db);
 
 // Delete zero or more idempotency ids older than minAgeSeconds
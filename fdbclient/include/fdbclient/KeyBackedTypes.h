@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <utility>
 #include <vector>
 
@@ -704,6 +705,101 @@ public:
 	KeyRange subspace;
 };
 
+// A queue of values ordered by the versionstamp of the transaction that pushed them. A queue keyed by versionstamp
+// alone makes every push write to the end of its keyspace, so one storage server takes all of them and the shard keeps
+// splitting. This queue puts each push under one of `salts` sub-ranges of prefix, chosen at random, and reads merge
+// the sub-ranges back into versionstamp order.
+//
+// Each item is at prefix/salt/versionstamp/order, where versionstamp is the 10 byte commit versionstamp and order is a
+// 2 byte big-endian number that orders the items pushed by one transaction. The position of an item is its 12 bytes of
+// versionstamp and order, and positions compare in queue order.
+class KeyBackedSaltedQueue {
+public:
+	static constexpr int POSITION_SIZE = 12;
+
+	KeyBackedSaltedQueue(KeyRef prefix, int salts) : subspace(prefixRange(prefix)), salts(salts) {
+		ASSERT(salts > 0 && salts <= 256);
+	}
+
+	typedef std::pair<Key, Value> PairType; // The position of an item and its value
+	typedef KeyBackedRangeResult<PairType> RangeResultType;
+
+	// Items pushed by the same transaction must have different orders
+	template <class Transaction>
+	void push(Transaction tr, ValueRef const& value, uint16_t order = 0) {
+		uint8_t salt = deterministicRandom()->randomInt(0, salts);
+		BinaryWriter wr(Unversioned());
+		wr.serializeBytes(subspace.begin);
+		wr << salt;
+		int32_t versionstampOffset = wr.getLength();
+		wr.serializeBytes(std::string(10, '\x00'));
+		wr << bigEndian16(order);
+		wr << versionstampOffset;
+		tr->atomicOp(wr.toValue(), value, MutationRef::SetVersionstampedKey);
+	}
+
+	// Returns up to limit items at or after begin, in queue order. Reads the first limit items of every salt, since any
+	// of them could be among the first limit items of the queue.
+	template <class Transaction>
+	Future<RangeResultType> getRange(Transaction tr,
+	                                 Optional<Key> const& begin,
+	                                 int limit,
+	                                 Snapshot snapshot = Snapshot::False) const {
+		std::vector<Future<RangeResult>> reads;
+		for (int salt = 0; salt < salts; ++salt) {
+			Key saltPrefix = saltSubspace(salt);
+			Key beginKey = begin.present() ? saltPrefix.withSuffix(begin.get()) : saltPrefix;
+			typename transaction_future_type<Transaction, RangeResult>::type getRangeFuture =
+			    tr->getRange(KeyRangeRef(beginKey, strinc(saltPrefix)), GetRangeLimits(limit), snapshot);
+			reads.push_back(holdWhile(getRangeFuture, safeThreadFutureToFuture(getRangeFuture)));
+		}
+
+		int prefixSize = subspace.begin.size() + 1;
+		return map(getAll(reads), [prefixSize, limit](std::vector<RangeResult> const& results) -> RangeResultType {
+			RangeResultType rangeResult;
+			rangeResult.more = false;
+			for (auto const& kvs : results) {
+				for (auto const& kv : kvs) {
+					rangeResult.results.emplace_back(kv.key.substr(prefixSize), kv.value);
+				}
+				rangeResult.more = rangeResult.more || kvs.more;
+			}
+			std::sort(rangeResult.results.begin(),
+			          rangeResult.results.end(),
+			          [](PairType const& a, PairType const& b) { return a.first < b.first; });
+			if (rangeResult.results.size() > size_t(limit)) {
+				rangeResult.results.resize(limit);
+				rangeResult.more = true;
+			}
+			return rangeResult;
+		});
+	}
+
+	// Removes every item before position end
+	template <class Transaction>
+	void pop(Transaction tr, KeyRef const& end) {
+		for (int salt = 0; salt < salts; ++salt) {
+			Key saltPrefix = saltSubspace(salt);
+			tr->clear(KeyRangeRef(saltPrefix, saltPrefix.withSuffix(end)));
+		}
+	}
+
+	template <class Transaction>
+	void clear(Transaction tr) {
+		tr->clear(subspace);
+	}
+
+	KeyRange subspace;
+
+private:
+	Key saltSubspace(int salt) const {
+		uint8_t saltByte = salt;
+		return subspace.begin.withSuffix(StringRef(&saltByte, 1));
+	}
+
+	int salts;
+};
+
 // all fields are under prefix, the schema is like prefix/"packed key"/"packed key2"
 class KeyBackedStruct {
 public:
@@ -34,6 +34,7 @@ standard API and some knowledge of the contents of the system key space.
 
 #include <string>
 #include <map>
+#include "fdbclient/BulkLoading.h"
 #include "fdbclient/GenericManagementAPI.actor.h"
 #include "fdbclient/NativeAPI.actor.h"
 #include "fdbclient/ReadYourWrites.h"
@@ -144,6 +145,12 @@ ACTOR Future<UID> auditStorage(Reference<IClusterConnectionRecord> clusterFile,
                                AuditType type,
                                bool async = false);
 
+// Marks range, which must be empty, as held by the given files.  Storage servers that are assigned any part of the
+// range load it from the files rather than from its current servers.  Nothing may write to the range until
+// clearBulkLoad() has been called for it, or a later relocation would load the files again over the writes.
+ACTOR Future<Void> setBulkLoad(Database cx, KeyRange range, BulkLoadState bulkLoadState);
+ACTOR Future<Void> clearBulkLoad(Database cx, KeyRange range);
+
 ACTOR Future<Void> printHealthyZone(Database cx);
 ACTOR Future<bool> clearHealthyZone(Database cx, bool printWarning = false, bool clearSSFailureZoneString = false);
 ACTOR Future<bool> setHealthyZone(Database cx, StringRef zoneId, double seconds, bool printWarning = false);
@@ -25,8 +25,13 @@
 #include "flow/ThreadHelper.actor.h"
 
 template <class T>
-class AbortableSingleAssignmentVar final : public ThreadSingleAssignmentVar<T>, public ThreadCallback {
+class AbortableSingleAssignmentVar final : public ThreadSingleAssignmentVar<T>,
+                                           public ThreadCallback,
+                                           public FastAllocated<AbortableSingleAssignmentVar<T>> {
 public:
+	using FastAllocated<AbortableSingleAssignmentVar<T>>::operator new;
+	using FastAllocated<AbortableSingleAssignmentVar<T>>::operator delete;
+
 	AbortableSingleAssignmentVar(ThreadFuture<T> future, ThreadFuture<Void> abortSignal)
 	  : future(future), abortSignal(abortSignal), hasBeenSet(false), callbacksCleared(true) {
 		int userParam;
@@ -143,12 +148,22 @@ private:
 
 template <class T>
 ThreadFuture<T> abortableFuture(ThreadFuture<T> f, ThreadFuture<Void> abortSignal) {
+	// A result that is already known can't be aborted, so it is passed through without another future. The abort
+	// signal is checked first to match AbortableSingleAssignmentVar, which reports cluster_version_changed if both are
+	// ready.
+	if (f.isReady() && !abortSignal.isReady()) {
+		return f;
+	}
 	return ThreadFuture<T>(new AbortableSingleAssignmentVar<T>(f, abortSignal));
 }
 
 template <class T>
-class DLThreadSingleAssignmentVar final : public ThreadSingleAssignmentVar<T> {
+class DLThreadSingleAssignmentVar final : public ThreadSingleAssignmentVar<T>,
+                                          public FastAllocated<DLThreadSingleAssignmentVar<T>> {
 public:
+	using FastAllocated<DLThreadSingleAssignmentVar<T>>::operator new;
+	using FastAllocated<DLThreadSingleAssignmentVar<T>>::operator delete;
+
 	DLThreadSingleAssignmentVar(Reference<FdbCApi> api,
 	                            FdbCApi::FDBFuture* f,
 	                            std::function<T(FdbCApi::FDBFuture*, FdbCApi*)> extractValue)
@@ -249,8 +264,13 @@ ThreadFuture<T> toThreadFuture(Reference<FdbCApi> api,
 }
 
 template <class S, class T>
-class MapSingleAssignmentVar final : public ThreadSingleAssignmentVar<T>, ThreadCallback {
+class MapSingleAssignmentVar final : public ThreadSingleAssignmentVar<T>,
+                                     ThreadCallback,
+                                     public FastAllocated<MapSingleAssignmentVar<S, T>> {
 public:
+	using FastAllocated<MapSingleAssignmentVar<S, T>>::operator new;
+	using FastAllocated<MapSingleAssignmentVar<S, T>>::operator delete;
+
 	MapSingleAssignmentVar(ThreadFuture<S> source, std::function<ErrorOr<T>(ErrorOr<S>)> mapValue)
 	  : source(source), mapValue(mapValue) {
 		ThreadSingleAssignmentVar<T>::addref();
@@ -309,8 +329,13 @@ ThreadFuture<T> mapThreadFuture(ThreadFuture<S> source, std::function<ErrorOr<T>
 }
 
 template <class S, class T>
-class FlatMapSingleAssignmentVar final : public ThreadSingleAssignmentVar<T>, ThreadCallback {
+class FlatMapSingleAssignmentVar final : public ThreadSingleAssignmentVar<T>,
+                                         ThreadCallback,
+                                         public FastAllocated<FlatMapSingleAssignmentVar<S, T>> {
 public:
+	using FastAllocated<FlatMapSingleAssignmentVar<S, T>>::operator new;
+	using FastAllocated<FlatMapSingleAssignmentVar<S, T>>::operator delete;
+
 	FlatMapSingleAssignmentVar(ThreadFuture<S> source, std::function<ErrorOr<ThreadFuture<T>>(ErrorOr<S>)> mapValue)
 	  : source(source), cancelled(false), released(false), mapValue(mapValue) {
 		ThreadSingleAssignmentVar<T>::addref();
@@ -292,6 +292,11 @@ struct FdbCApi : public ThreadSafeReferenceCounted<FdbCApi> {
 	FDBFuture* (*transactionGetReadVersion)(FDBTransaction* tr);
 
 	FDBFuture* (*transactionGet)(FDBTransaction* tr, uint8_t const* keyName, int keyNameLength, fdb_bool_t snapshot);
+	FDBFuture* (*transactionGetMulti)(FDBTransaction* tr,
+	                                  uint8_t const* const* keyNames,
+	                                  int const* keyNameLengths,
+	                                  int keyCount,
+	                                  fdb_bool_t snapshot);
 	FDBFuture* (*transactionGetKey)(FDBTransaction* tr,
 	                                uint8_t const* keyName,
 	                                int keyNameLength,
@@ -469,6 +474,7 @@ public:
 	ThreadFuture<Version> getReadVersion() override;
 
 	ThreadFuture<Optional<Value>> get(const KeyRef& key, bool snapshot = false) override;
+	ThreadFuture<RangeResult> getMulti(const VectorRef<KeyRef>& keys, bool snapshot = false) override;
 	ThreadFuture<Key> getKey(const KeySelectorRef& key, bool snapshot = false) override;
 	ThreadFuture<RangeResult> getRange(const KeySelectorRef& begin,
 	                                   const KeySelectorRef& end,
@@ -705,6 +711,7 @@ public:
 	ThreadFuture<Version> getReadVersion() override;
 
 	ThreadFuture<Optional<Value>> get(const KeyRef& key, bool snapshot = false) override;
+	ThreadFuture<RangeResult> getMulti(const VectorRef<KeyRef>& keys, bool snapshot = false) override;
 	ThreadFuture<Key> getKey(const KeySelectorRef& key, bool snapshot = false) override;
 	ThreadFuture<RangeResult> getRange(const KeySelectorRef& begin,
 	                                   const KeySelectorRef& end,
@@ -814,7 +821,7 @@ private:
 	ThreadSpinLock timeoutLock;
 
 	// A single assignment var (i.e. promise) that gets set with an error when the timeout elapses or the transaction
-	// is reset or destroyed.
+	// is reset or destroyed. Created on first use by getTimeoutTsavUnsafe().
 	Reference<ThreadSingleAssignmentVar<Void>> timeoutTsav;
 
 	// A reference to the current actor waiting for the timeout. This actor will set the timeoutTsav promise.
@@ -826,6 +833,8 @@ private:
 
 	void resetTimeout();
 
+	Reference<ThreadSingleAssignmentVar<Void>> getTimeoutTsavUnsafe();
+
 	// Creates a ThreadFuture<T> that will signal an error if the transaction times out.
 	template <class T>
 	ThreadFuture<T> makeTimeout();
@@ -1156,6 +1165,8 @@ public:
 	};
 
 	const Reference<DatabaseState> dbState;
+	// The client thread this database was assigned by MultiVersionApi::createDatabase, or -1 if it was not assigned one
+	int assignedThread = -1;
 	friend class MultiVersionTransaction;
 };
 
@@ -1183,6 +1194,8 @@ public:
 	static MultiVersionApi* api;
 
 	Reference<ClientInfo> getLocalClient();
+	// Release a client thread picked by assignDatabaseThread() when its database is destroyed
+	void releaseDatabaseThread(int threadIdx);
 	void runOnExternalClients(int threadId,
 	                          std::function<void(Reference<ClientInfo>)>,
 	                          bool runOnFailedClients = false,
@@ -1242,7 +1255,9 @@ private:
 	bool retainClientLibCopies;
 	ApiVersion apiVersion;
 
-	int nextThread = 0;
+	int assignDatabaseThread();
+
+	std::vector<int> threadDatabases; // Number of live databases assigned to each client thread
 	int threadCount;
 	std::string tmpDir;
 	bool traceShareBaseNameAmongThreads;
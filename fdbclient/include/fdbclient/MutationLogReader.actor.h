@@ -132,6 +132,8 @@ private:
 	Key prefix; // "\xff\x02/alog/UID/" for restore, or "\xff\x02/blog/UID/" for backup
 	unsigned pipelineDepth;
 	unsigned finished;
+	// The reader whose next block must be in the heap before the next result can be chosen, or -1
+	int waitingHash = -1;
 };
 
 #include "flow/unactorcompiler.h"
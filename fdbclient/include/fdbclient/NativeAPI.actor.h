@@ -38,6 +38,7 @@
 #include "fdbclient/CoordinationInterface.h"
 #include "fdbclient/ClusterInterface.h"
 #include "fdbclient/ClientLogEvents.h"
+#include "fdbclient/TrafficCapture.h"
 #include "fdbclient/KeyRangeMap.h"
 #include "flow/actorcompiler.h" // has to be last include
 
@@ -184,7 +185,7 @@ private:
 class ReadYourWritesTransaction; // workaround cyclic dependency
 
 struct TransactionLogInfo : public ReferenceCounted<TransactionLogInfo>, NonCopyable {
-	enum LoggingLocation { DONT_LOG = 0, TRACE_LOG = 1, DATABASE = 2 };
+	enum LoggingLocation { DONT_LOG = 0, TRACE_LOG = 1, DATABASE = 2, CAPTURE = 4 };
 
 	TransactionLogInfo() : logLocation(DONT_LOG), maxFieldLength(0) {}
 	TransactionLogInfo(LoggingLocation location) : logLocation(location), maxFieldLength(0) {}
@@ -205,6 +206,10 @@ struct TransactionLogInfo : public ReferenceCounted<TransactionLogInfo>, NonCopy
 			return;
 		}
 
+		if (logLocation & CAPTURE) {
+			capture.add(event);
+		}
+
 		if (logLocation & DATABASE) {
 			logsAdded = true;
 			static_assert(std::is_base_of<FdbClientLogEvents::Event, T>::value,
@@ -214,6 +219,7 @@ struct TransactionLogInfo : public ReferenceCounted<TransactionLogInfo>, NonCopy
 	}
 
 	BinaryWriter trLogWriter{ IncludeVersion() };
+	FdbClientLogEvents::CapturedTransaction capture;
 	bool logsAdded{ false };
 	bool flushed{ false };
 	int logLocation;
@@ -288,6 +294,9 @@ struct TransactionState : ReferenceCounted<TransactionState> {
 
 	double proxyTagThrottledDuration = 0.0;
 
+	// How old the read version was when the transaction took it from the GRV cache, zero if it came from a GRV proxy
+	double readVersionStaleness = 0.0;
+
 	// Special flag to skip prepending tenant prefix to mutations and conflict ranges
 	// when a dummy, internal transaction gets commited. The sole purpose of commitDummyTransaction() is to
 	// resolve the state of earlier transaction that returned commit_unknown_result or request_maybe_delivered.
@@ -310,6 +319,9 @@ struct TransactionState : ReferenceCounted<TransactionState> {
 
 	Future<Void> startFuture;
 
+	// Point reads waiting to be sent to their shard together, created by the first read that is coalesced
+	std::shared_ptr<struct GetValuesCoalescer> getValuesCoalescer;
+
 	// Only available so that Transaction can have a default constructor, for use in state variables
 	TransactionState(TaskPriority taskID, SpanContext spanContext)
 	  : taskID(taskID), spanContext(spanContext), tenantSet(false) {}
@@ -356,6 +368,9 @@ public:
 	}
 	Future<Version> getRawReadVersion();
 	Optional<Version> getCachedReadVersion() const;
+	// Seconds by which the read version may trail the latest committed version when the transaction started. Zero
+	// unless the read version came from the GRV cache.
+	double getReadVersionStaleness() const { return trState->readVersionStaleness; }
 
 	[[nodiscard]] Future<Optional<Value>> get(const Key& key, Snapshot = Snapshot::False);
 	[[nodiscard]] Future<Void> watch(Reference<Watch> watch);
@@ -392,19 +407,31 @@ public:
 		                reverse);
 	}
 
+	// Like getRange, but storage servers return only the rows that match filter, a packed RangeFilter, as the filter
+	// projects them.  The limits count the rows returned.
+	[[nodiscard]] Future<RangeResult> getFilteredRange(const KeySelector& begin,
+	                                                   const KeySelector& end,
+	                                                   const Key& filter,
+	                                                   GetRangeLimits limits,
+	                                                   Snapshot = Snapshot::False,
+	                                                   Reverse = Reverse::False);
+
+	// A non-empty filter is applied as in getFilteredRange to the rows of the range before they are mapped
 	[[nodiscard]] Future<MappedRangeResult> getMappedRange(const KeySelector& begin,
 	                                                       const KeySelector& end,
 	                                                       const Key& mapper,
 	                                                       GetRangeLimits limits,
 	                                                       int matchIndex = MATCH_INDEX_ALL,
 	                                                       Snapshot = Snapshot::False,
-	                                                       Reverse = Reverse::False);
+	                                                       Reverse = Reverse::False,
+	                                                       const Key& filter = Key());
 
 private:
 	template <class GetKeyValuesFamilyRequest, class GetKeyValuesFamilyReply, class RangeResultFamily>
 	Future<RangeResultFamily> getRangeInternal(const KeySelector& begin,
 	                                           const KeySelector& end,
 	                                           const Key& mapper,
+	                                           const Key& filter,
 	                                           GetRangeLimits limits,
 	                                           int matchIndex,
 	                                           Snapshot snapshot,
@@ -544,6 +571,9 @@ public:
 	Standalone<VectorRef<KeyRangeRef>> writeConflictRanges() const {
 		return Standalone<VectorRef<KeyRangeRef>>(tr.transaction.write_conflict_ranges, tr.arena);
 	}
+	// Removes the mutations and write conflict ranges added so far, along with their cost, so that the caller can add
+	// them again later. Clears are assumed to have been added with clear(KeyRangeRef).
+	std::pair<Standalone<VectorRef<MutationRef>>, Standalone<VectorRef<KeyRangeRef>>> takeWrites();
 
 	Optional<Reference<Tenant>> getTenant() { return trState->tenant(); }
 
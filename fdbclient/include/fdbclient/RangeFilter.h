@@ -0,0 +1,71 @@
+/*
+ * RangeFilter.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FDBCLIENT_RANGEFILTER_H
+#define FDBCLIENT_RANGEFILTER_H
+#pragma once
+
+#include <vector>
+
+#include "fdbclient/FDBTypes.h"
+
+// A filter and projection that storage servers apply to the rows of a range read, so that rows a client would discard
+// never leave the server.  Like a mapper, it is sent as a packed tuple, here of clauses that follow each other:
+//
+//   "key_prefix", p               the key starts with the bytes p
+//   "value_prefix", p             the value starts with the bytes p
+//   "key", i, op, x               element i of the key, unpacked as a tuple, compares to x by op
+//   "value", i, op, x             the same for the value
+//   "project", n, i1, ..., in     return the value as the tuple of its elements i1, ..., in
+//   "keys_only"                   return empty values
+//
+// op is one of "==", "!=", "<", "<=", ">" and ">=", and x is any single tuple element.  Elements compare in tuple
+// order.  A row matches if it satisfies every predicate; a row whose key or value doesn't unpack, or lacks an element a
+// predicate names, doesn't match.  Projection skips elements the value doesn't have, and leaves values that aren't
+// tuples unchanged.  Row limits of a filtered read count the rows that match.
+class RangeFilter {
+public:
+	// Throws range_filter_invalid if spec isn't a filter as described above
+	explicit RangeFilter(KeyRef spec);
+
+	bool matches(KeyValueRef kv) const;
+
+	// Returns the row as it should be returned, allocating any new value in arena
+	KeyValueRef project(Arena& arena, KeyValueRef kv) const;
+
+private:
+	enum class Op { Prefix, EQ, NE, LT, LE, GT, GE };
+
+	struct Predicate {
+		bool onValue;
+		Op op;
+		// The tuple element compared, or -1 to match a prefix of the raw bytes
+		int element;
+		// The packed element, or the prefix
+		Standalone<StringRef> operand;
+	};
+
+	std::vector<Predicate> predicates;
+	bool keysOnly = false;
+	bool projectValue = false;
+	std::vector<int> valueElements;
+};
+
+#endif
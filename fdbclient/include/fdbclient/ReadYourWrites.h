@@ -238,6 +238,7 @@ private:
 	Future<Void> timeoutActor;
 	double creationTime;
 	bool commitStarted;
+	bool blindWrites; // Until the first read, writes go straight to tr instead of the write map
 
 	// For reading conflict ranges from the special key space
 	VectorRef<KeyRef> versionStampKeys;
@@ -258,6 +259,7 @@ private:
 	    KeyRangeRef const& keys,
 	    WriteMap::iterator& it); // pre: it.segmentContains(keys.begin), keys are already inside this->arena
 	void writeRangeToNativeTransaction(KeyRangeRef const& keys);
+	void endBlindWrites(); // Moves the writes added to tr while blindWrites is set into the write map
 
 	void resetRyow(); // doesn't reset the encapsulated transaction, or creation time/retry state
 	KeyRef getMaxReadKey();
@@ -47,7 +47,7 @@ public:
 	bool ENABLE_VERSION_VECTOR_HA_OPTIMIZATION;
 
 	// TLogs
-	bool PEEK_USING_STREAMING;
+	bool PEEK_USING_STREAMING; // Whether tagged peek cursors use peek streams rather than request/response peeks
 	double TLOG_TIMEOUT; // tlog OR commit proxy failure - master's reaction time
 	double TLOG_SLOW_REJOIN_WARN_TIMEOUT_SECS; // Warns if a tlog takes too long to rejoin
 	double TLOG_STORAGE_MIN_UPDATE_INTERVAL;
@@ -86,9 +86,15 @@ public:
 	int64_t TLOG_SPILL_REFERENCE_MAX_PEEK_MEMORY_BYTES;
 	int64_t TLOG_SPILL_REFERENCE_MAX_BATCHES_PER_PEEK;
 	int64_t TLOG_SPILL_REFERENCE_MAX_BYTES_PER_BATCH;
+	std::string TLOG_SPILL_COMPRESSION_FILTER; // Compression filter for messages spilled by value, "NONE" to disable.
+	                                           // Older binaries cannot read compressed spilled messages.
 	int64_t DISK_QUEUE_FILE_EXTENSION_BYTES; // When we grow the disk queue, by how many bytes should it grow?
 	int64_t DISK_QUEUE_FILE_SHRINK_BYTES; // When we shrink the disk queue, by how many bytes should it shrink?
 	int64_t DISK_QUEUE_MAX_TRUNCATE_BYTES; // A truncate larger than this will cause the file to be replaced instead.
+	int DISK_QUEUE_MAX_OUTSTANDING_SYNCS; // Syncs of one DiskQueue file which may be in flight at once, beyond which
+	                                      // commits share the most recently queued sync
+	int DISK_QUEUE_RECOVERY_READ_BYTES; // Size of each DiskQueue recovery read
+	int DISK_QUEUE_RECOVERY_READ_AHEAD; // Recovery reads kept in flight ahead of the page being replayed
 	double TLOG_DEGRADED_DURATION;
 	int64_t MAX_CACHE_VERSIONS;
 	double TXS_POPPED_MAX_DELAY;
@@ -107,6 +113,11 @@ public:
 	double PUSH_STATS_SLOW_AMOUNT;
 	double PUSH_STATS_SLOW_RATIO;
 	int TLOG_POP_BATCH_SIZE;
+	// Pops that arrive while the TLog is below TLOG_POP_COALESCE_PRESSURE_FRACTION of TLOG_SPILL_THRESHOLD worth of
+	// unspilled bytes have their in-memory erasure deferred by up to TLOG_POP_COALESCE_DELAY seconds and applied once
+	// per tag. 0 disables coalescing.
+	double TLOG_POP_COALESCE_DELAY;
+	double TLOG_POP_COALESCE_PRESSURE_FRACTION;
 	double BLOCKING_PEEK_TIMEOUT;
 	bool PEEK_BATCHING_EMPTY_MSG;
 	double PEEK_BATCHING_EMPTY_MSG_INTERVAL;
@@ -128,6 +139,7 @@ public:
 	double RELOCATION_PARALLELISM_PER_SOURCE_SERVER;
 	double RELOCATION_PARALLELISM_PER_DEST_SERVER;
 	int DD_QUEUE_MAX_KEY_SERVERS;
+	int64_t DD_MOVE_BYTES_PER_SECOND; // Target rate of data movement below PRIORITY_TEAM_UNHEALTHY, or 0 for no limit
 	int DD_REBALANCE_PARALLELISM;
 	int DD_REBALANCE_RESET_AMOUNT;
 	double INFLIGHT_PENALTY_HEALTHY;
@@ -166,6 +178,7 @@ public:
 	int64_t MAX_PHYSICAL_SHARD_BYTES;
 	double PHYSICAL_SHARD_METRICS_DELAY;
 	double ANONYMOUS_PHYSICAL_SHARD_TRANSITION_TIME;
+	int DD_PHYSICAL_SHARD_COALESCE_MAX_SHARDS; // Max adjacent shards of an unhealthy team moved by one relocation
 
 	double READ_REBALANCE_CPU_THRESHOLD; // read rebalance only happens if the source servers' CPU > threshold
 	int READ_REBALANCE_SRC_PARALLELISM; // the max count a server become a source server within a certain interval
@@ -180,8 +193,15 @@ public:
 	int64_t SHARD_MAX_BYTES_PER_KSEC, // Shards with more than this bandwidth will be split immediately
 	    SHARD_MIN_BYTES_PER_KSEC, // Shards with more than this bandwidth will not be merged
 	    SHARD_SPLIT_BYTES_PER_KSEC; // When splitting a shard, it is split into pieces with less than this bandwidth
+	double SHARD_WRITE_TREND_HORIZON; // Seconds ahead that a shard's write bandwidth trend is projected for splitting
+	double SHARD_WRITE_TREND_SMOOTHING;
 	double SHARD_MAX_READ_DENSITY_RATIO;
 	int64_t SHARD_READ_HOT_BANDWIDTH_MIN_PER_KSECONDS;
+	bool DD_CACHE_READ_HOT_RANGES; // Add read-hot ranges to the storage cache
+	double DD_READ_HOT_CACHE_DURATION; // Seconds a cached read-hot range stays cached after it was last read-hot
+	int64_t STORAGE_CACHE_MEMORY_LIMIT; // Resident bytes above which a storage cache server evicts its least read
+	                                    // range, or 0 for no limit
+	double STORAGE_CACHE_EVICTION_INTERVAL; // Seconds between checks of a storage cache server's memory
 	double SHARD_MAX_BYTES_READ_PER_KSEC_JITTER;
 	double STORAGE_METRIC_TIMEOUT;
 	double METRIC_DELAY;
@@ -195,6 +215,7 @@ public:
 	                                                 // before perpetual wiggle will start the next wiggle
 	double PERPETUAL_WIGGLE_DELAY; // The max interval between the last wiggle finish and the next wiggle start
 	bool PERPETUAL_WIGGLE_DISABLE_REMOVER; // Whether the start of perpetual wiggle replace team remover
+	int PERPETUAL_WIGGLE_ZONE_SERVERS; // Max other servers in the wiggling server's zone wiggled with it
 	double LOG_ON_COMPLETION_DELAY;
 	int BEST_TEAM_MAX_TEAM_TRIES;
 	int BEST_TEAM_OPTION_COUNT;
@@ -299,6 +320,8 @@ public:
 	int SQLITE_CHUNK_SIZE_PAGES;
 	int SQLITE_CHUNK_SIZE_PAGES_SIM;
 	int SQLITE_READER_THREADS;
+	int SQLITE_READ_AHEAD_PAGES; // Pages to load ahead of sequential reads of the sqlite file, 0 to disable
+	int SQLITE_READ_AHEAD_MIN_SEQUENTIAL_READS;
 	int SQLITE_WRITE_WINDOW_LIMIT;
 	double SQLITE_WRITE_WINDOW_SECONDS;
 	int64_t SQLITE_CURSOR_MAX_LIFETIME_BYTES;
@@ -336,6 +359,7 @@ public:
 	int64_t ROCKSDB_PERIODIC_COMPACTION_SECONDS;
 	int ROCKSDB_PREFIX_LEN;
 	int64_t ROCKSDB_BLOCK_CACHE_SIZE;
+	bool ROCKSDB_SHARE_BLOCK_CACHE; // All RocksDB stores in a process use one block cache of ROCKSDB_BLOCK_CACHE_SIZE
 	double ROCKSDB_METRICS_DELAY;
 	double ROCKSDB_READ_VALUE_TIMEOUT;
 	double ROCKSDB_READ_VALUE_PREFIX_TIMEOUT;
@@ -352,8 +376,12 @@ public:
 	double ROCKSDB_HISTOGRAMS_SAMPLE_RATE;
 	double ROCKSDB_READ_RANGE_ITERATOR_REFRESH_TIME;
 	bool ROCKSDB_READ_RANGE_REUSE_ITERATORS;
+	bool ROCKSDB_MULTIGET; // Serve batches of unthrottled point reads with a single MultiGet
 	bool ROCKSDB_READ_RANGE_REUSE_BOUNDED_ITERATORS;
 	int ROCKSDB_READ_RANGE_BOUNDED_ITERATORS_MAX_LIMIT;
+	bool ROCKSDB_READ_RANGE_ASYNC_IO; // Prefetch the next blocks of a range read asynchronously
+	bool ROCKSDB_READ_RANGE_ADAPTIVE_READAHEAD; // Carry the readahead size across the files of a range read
+	int64_t ROCKSDB_READ_RANGE_READAHEAD_SIZE;
 	int64_t ROCKSDB_WRITE_RATE_LIMITER_BYTES_PER_SEC;
 	bool ROCKSDB_WRITE_RATE_LIMITER_AUTO_TUNE;
 	std::string DEFAULT_FDB_ROCKSDB_COLUMN_FAMILY;
@@ -384,6 +412,9 @@ public:
 	int64_t ROCKSDB_MAX_TOTAL_WAL_SIZE;
 	int64_t ROCKSDB_MAX_BACKGROUND_JOBS;
 	int64_t ROCKSDB_DELETE_OBSOLETE_FILE_PERIOD;
+	bool SHARDED_ROCKSDB_ENABLE_PIPELINED_WRITE; // Write the WAL of one commit while the previous one is applied
+	bool SHARDED_ROCKSDB_ALLOW_CONCURRENT_MEMTABLE_WRITE; // Insert into the memtables of a write group in parallel
+	bool SHARDED_ROCKSDB_CHANGE_FEED_SHARD; // New stores keep durable change feed data in its own column family
 	double ROCKSDB_PHYSICAL_SHARD_CLEAN_UP_DELAY;
 
 	// Leader election
@@ -407,6 +438,10 @@ public:
 	double START_TRANSACTION_RATE_WINDOW;
 	double START_TRANSACTION_MAX_EMPTY_QUEUE_BUDGET;
 	int START_TRANSACTION_MAX_QUEUE_SIZE;
+	bool GRV_PROXY_SHARE_REPLY_SERIALIZATION; // Serialize identical GRV replies of a batch once for all clients
+	// How long clients may serve a read version from their GRV cache, unless the GRV proxy is being throttled. If
+	// zero, GRV proxies leave the staleness bound to the clients' MAX_VERSION_CACHE_LAG.
+	double GRV_CACHE_LEASE_DURATION;
 	int KEY_LOCATION_MAX_QUEUE_SIZE;
 	int TENANT_ID_REQUEST_MAX_QUEUE_SIZE;
 	int BLOB_GRANULE_LOCATION_MAX_QUEUE_SIZE;
@@ -417,6 +452,11 @@ public:
 	double COMMIT_TRANSACTION_BATCH_INTERVAL_MAX;
 	double COMMIT_TRANSACTION_BATCH_INTERVAL_LATENCY_FRACTION;
 	double COMMIT_TRANSACTION_BATCH_INTERVAL_SMOOTHER_ALPHA;
+	// If positive, the commit batch interval is chosen by a feedback loop which aims to keep the p99 commit latency
+	// at this many seconds, instead of following a fraction of the observed latency
+	double COMMIT_BATCHING_TARGET_LATENCY;
+	double COMMIT_BATCHING_CONTROLLER_GAIN; // Change of the interval per second of p99 latency error, per batch
+	double COMMIT_BATCHING_LATENCY_QUANTILE_STEP; // Fraction of the target by which the p99 estimate moves per batch
 	int COMMIT_TRANSACTION_BATCH_COUNT_MAX;
 	int COMMIT_TRANSACTION_BATCH_BYTES_MIN;
 	int COMMIT_TRANSACTION_BATCH_BYTES_MAX;
@@ -443,9 +483,13 @@ public:
 	int PROXY_COMPUTE_BUCKETS;
 	double PROXY_COMPUTE_GROWTH_RATE;
 	int TXN_STATE_SEND_AMOUNT;
+	bool TXN_STATE_STORE_RADIX_TREE; // Keep txnStateStore in a radix tree, which shares the long system key prefixes
 	double REPORT_TRANSACTION_COST_ESTIMATION_DELAY;
 	bool PROXY_REJECT_BATCH_QUEUED_TOO_LONG;
 	bool PROXY_USE_RESOLVER_PRIVATE_MUTATIONS;
+	// Encrypt the mutations of a commit batch while its resolution is outstanding, rather than after it has been
+	// ordered behind the previous batch
+	bool PROXY_ENCRYPT_DURING_RESOLUTION;
 
 	int RESET_MASTER_BATCHES;
 	int RESET_RESOLVER_BATCHES;
@@ -476,6 +520,16 @@ public:
 	double SAMPLE_EXPIRATION_TIME;
 	double SAMPLE_POLL_TIME;
 	int64_t RESOLVER_STATE_MEMORY_LIMIT;
+	int RESOLVER_CONFLICT_SET_THREADS; // Number of key range partitions (and threads) used for conflict detection
+	int RESOLVER_CONFLICT_SET_PARALLEL_MIN_POINTS; // Batches with fewer conflict range endpoints are not partitioned
+	bool RESOLVER_USE_ART_CONFLICT_SET; // Keep the conflict history in an adaptive radix tree instead of a SkipList
+	bool RESOLVER_RECENT_WRITE_FILTER; // Rule out read conflict ranges with a filter of recent writes before the history
+	int RESOLVER_RECENT_WRITE_FILTER_BITS_LOG2; // Bloom filter bits per version window of the recent write filter
+	int RESOLVER_RECENT_WRITE_FILTER_PREFIX_BYTES; // Key prefix length the recent write filter tracks writes by
+	int64_t RESOLVER_RECENT_WRITE_FILTER_WINDOW_VERSIONS; // Versions of writes summarized by one filter window
+	double RESOLVER_CONFLICT_SAMPLE_RATE; // Fraction of transactions whose conflicts are counted by prefix, 0 disables
+	int RESOLVER_CONFLICT_PREFIX_BYTES; // Longest key prefix that sampled conflicts are counted by
+	int RESOLVER_CONFLICT_PREFIXES_IN_STATUS; // Most conflicting key prefixes reported in status
 
 	// Backup Worker
 	double BACKUP_TIMEOUT; // master's reaction time for backup failure
@@ -483,6 +537,7 @@ public:
 	int BACKUP_FILE_BLOCK_BYTES;
 	int64_t BACKUP_LOCK_BYTES;
 	double BACKUP_UPLOAD_DELAY;
+	int BACKUP_MAX_OUTSTANDING_UPLOADS; // mutation log saves whose files may still be uploading at once
 
 	// Cluster Controller
 	double CLUSTER_CONTROLLER_LOGGING_DELAY;
@@ -515,6 +570,7 @@ public:
 	double FORCE_RECOVERY_CHECK_DELAY;
 	double RATEKEEPER_FAILURE_TIME;
 	double CONSISTENCYSCAN_FAILURE_TIME;
+	bool CONSISTENCYSCAN_USE_DIGESTS; // Compare replicas by range digest, reading the rows from only one of them
 	double BLOB_MANAGER_FAILURE_TIME;
 	double BLOB_MIGRATOR_FAILURE_TIME;
 	double REPLACE_INTERFACE_DELAY;
@@ -569,6 +625,9 @@ public:
 	double RECRUITMENT_TIMEOUT;
 	int DBINFO_SEND_AMOUNT;
 	double DBINFO_BATCH_DELAY;
+	// Broadcast ServerDBInfo changes as deltas from the previous broadcast when possible. Workers that predate deltas
+	// would read one as a full ServerDBInfo, so only enable this once every worker understands them.
+	bool DBINFO_DELTA_BROADCAST;
 	double SINGLETON_RECRUIT_BME_DELAY;
 
 	// Move Keys
@@ -597,6 +656,7 @@ public:
 	double SMOOTHING_AMOUNT;
 	double SLOW_SMOOTHING_AMOUNT;
 	double METRIC_UPDATE_RATE;
+	double RATEKEEPER_FAST_METRIC_UPDATE_RATE; // Used instead of METRIC_UPDATE_RATE near the limit, or 0 to disable
 	double DETAILED_METRIC_UPDATE_RATE;
 	double LAST_LIMITED_RATIO;
 	double RATEKEEPER_DEFAULT_LIMIT;
@@ -683,6 +743,7 @@ public:
 	double MAX_TL_SS_VERSION_DIFFERENCE; // spring starts at half this value
 	double MAX_TL_SS_VERSION_DIFFERENCE_BATCH;
 	int MAX_MACHINES_FALLING_BEHIND;
+	int MAX_TAG_THROTTLED_SERVERS_IGNORED; // Storage servers left to auto tag throttling before limiting the cluster
 
 	int MAX_TPS_HISTORY_SAMPLES;
 	int NEEDED_TPS_HISTORY_SAMPLES;
@@ -736,6 +797,11 @@ public:
 	int64_t EMPTY_READ_PENALTY;
 	int DD_SHARD_COMPARE_LIMIT; // when read-aware DD is enabled, at most how many shards are compared together
 	bool READ_SAMPLING_ENABLED;
+	// Storage servers track their most frequently read and written keys, and resolvers the read conflict ranges of
+	// conflicting transactions, in Space-Saving sketches of this many keys fed with a sample of the operations
+	int HOT_KEY_TRACKER_CAPACITY;
+	double HOT_KEY_SAMPLE_RATE; // 0 disables hot key tracking
+	double HOT_KEY_WINDOW; // Hot key rates cover the last one to two windows of this many seconds
 
 	// Storage Server
 	double STORAGE_LOGGING_DELAY;
@@ -749,9 +815,14 @@ public:
 	int FETCH_KEYS_PARALLELISM_BYTES;
 	int FETCH_KEYS_PARALLELISM;
 	int FETCH_KEYS_PARALLELISM_FULL;
+	int FETCH_KEYS_PARALLEL_RANGES; // Max pieces of a shard fetched at once, each using a fetch permit
+	int64_t FETCH_KEYS_PARALLEL_RANGE_BYTES; // Smallest piece of a shard worth fetching concurrently with the others
+	bool FETCH_KEYS_USE_CHECKPOINT; // Sharded RocksDB destinations ingest moved shards as SST files when sources can
+	double FETCH_KEYS_CHECKPOINT_TIMEOUT; // How long to wait for sources to create checkpoints before fetching keys
 	int FETCH_KEYS_LOWER_PRIORITY;
 	int SERVE_FETCH_CHECKPOINT_PARALLELISM;
 	int SERVE_AUDIT_STORAGE_PARALLELISM;
+	bool AUDIT_STORAGE_USE_DIGESTS; // Audits fetch a digest of each batch from the remote server instead of its rows
 	int BUGGIFY_BLOCK_BYTES;
 	int64_t STORAGE_RECOVERY_VERSION_LAG_LIMIT;
 	double STORAGE_DURABILITY_LAG_REJECT_THRESHOLD;
@@ -759,14 +830,20 @@ public:
 	int STORAGE_COMMIT_BYTES;
 	int STORAGE_FETCH_BYTES;
 	double STORAGE_COMMIT_INTERVAL;
+	bool STORAGE_PIPELINE_COMMITS; // Write the next versions to Redwood or RocksDB while a commit is in progress
 	int BYTE_SAMPLING_FACTOR;
 	int BYTE_SAMPLING_OVERHEAD;
 	int MAX_STORAGE_SERVER_WATCH_BYTES;
 	int MAX_BYTE_SAMPLE_CLEAR_MAP_SIZE;
+	int STORAGE_DEFERRED_BYTE_SAMPLE_BATCH; // Byte sample updates deferred off the update path are applied in batches
+	                                        // of this many mutations, 0 to apply them as mutations are applied
 	double LONG_BYTE_SAMPLE_RECOVERY_DELAY;
 	int BYTE_SAMPLE_LOAD_PARALLELISM;
 	double BYTE_SAMPLE_LOAD_DELAY;
 	double BYTE_SAMPLE_START_DELAY;
+	int STORAGE_WARM_KEYS; // Hottest read keys persisted to be read back into the engine's cache on restart, 0 disables
+	double STORAGE_WARM_KEYS_INTERVAL; // Seconds between rewrites of the persisted hottest read keys
+	int STORAGE_WARM_KEYS_PARALLELISM; // Persisted hottest read keys read back at once on restart
 	double BEHIND_CHECK_DELAY;
 	int BEHIND_CHECK_COUNT;
 	int64_t BEHIND_CHECK_VERSIONS;
@@ -781,6 +858,7 @@ public:
 	double MAX_STORAGE_COMMIT_TIME;
 	int64_t RANGESTREAM_LIMIT_BYTES;
 	int64_t CHANGEFEEDSTREAM_LIMIT_BYTES;
+	int CHANGE_FEED_SHARED_FILTER_VERSIONS; // Versions per feed whose filtered batches are shared across streams
 	int64_t BLOBWORKERSTATUSSTREAM_LIMIT_BYTES;
 	bool ENABLE_CLEAR_RANGE_EAGER_READS;
 	bool QUICK_GET_VALUE_FALLBACK;
@@ -788,6 +866,7 @@ public:
 	bool STRICTLY_ENFORCE_BYTE_LIMIT;
 	double FRACTION_INDEX_BYTELIMIT_PREFETCH;
 	int MAX_PARALLEL_QUICK_GET_VALUE;
+	int MAPPED_RANGE_LOCAL_BATCH_ROWS; // Rows of getMappedRange whose lookups are local are read together, 0 to disable
 	int CHECKPOINT_TRANSFER_BLOCK_BYTES;
 	int QUICK_GET_KEY_VALUES_LIMIT;
 	int QUICK_GET_KEY_VALUES_LIMIT_BYTES;
@@ -795,7 +874,15 @@ public:
 	std::string STORAGESERVER_READ_PRIORITIES;
 	int STORAGE_SERVER_READ_CONCURRENCY;
 	std::string STORAGESERVER_READTYPE_PRIORITY_MAP;
+	double STORAGESERVER_READ_QUEUE_LATENCY_TARGET;
+	double STORAGESERVER_READ_WEIGHT_ADJUST_INTERVAL;
 	int SPLIT_METRICS_MAX_ROWS;
+	int STORAGE_PARALLEL_RANGE_READS; // Large storage engine range reads are split into up to this many concurrent reads
+	int STORAGE_PARALLEL_RANGE_READ_MIN_BYTES;
+	int64_t STORAGE_FILTERED_RANGE_SCAN_BYTES; // Filtered range reads examine about this much data per request
+	bool STORAGE_READ_RANGE_ARENA_PRESIZE; // Start readRange replies with an arena sized from recent replies
+	int64_t STORAGE_HOT_ROW_CACHE_BYTES; // Memory for caching point reads from the storage engine, 0 to disable
+	int STORAGE_HOT_ROW_CACHE_MAX_VALUE_BYTES; // Larger values are read from the storage engine every time
 
 	// Wait Failure
 	int MAX_OUTSTANDING_WAIT_FAILURE_REQUESTS;
@@ -860,6 +947,9 @@ public:
 	// Status
 	double STATUS_MIN_TIME_BETWEEN_REQUESTS;
 	double MAX_STATUS_REQUESTS_PER_SECOND;
+	// Status requests are answered with the last status if it was started at most this many seconds ago, so that
+	// frequent polling does not recompute status, and its fan out to every worker, for each request
+	double STATUS_CACHE_MAX_STALENESS;
 	int CONFIGURATION_ROWS_TO_FETCH;
 	bool DISABLE_DUPLICATE_LOG_WARNING;
 	double HISTOGRAM_REPORT_INTERVAL;
@@ -926,6 +1016,8 @@ public:
 	int REDWOOD_DEFAULT_EXTENT_READ_SIZE; // Extent read size for Redwood files
 	int REDWOOD_EXTENT_CONCURRENT_READS; // Max number of simultaneous extent disk reads in progress.
 	bool REDWOOD_KVSTORE_RANGE_PREFETCH; // Whether to use range read prefetching
+	int REDWOOD_SCAN_READ_AHEAD_MAX_LEAVES; // Most sibling leaves a cursor moving sequentially across leaves will read
+	                                        // ahead of its position, 0 to disable
 	double REDWOOD_PAGE_REBUILD_MAX_SLACK; // When rebuilding pages, max slack to allow in page before extending it
 	double REDWOOD_PAGE_REBUILD_SLACK_DISTRIBUTION; // When rebuilding pages, use this ratio of slack distribution
 	                                                // between the rightmost (new) page and the previous page. Defaults
@@ -940,6 +1032,8 @@ public:
 	                                  // queue is empty
 	int REDWOOD_LAZY_CLEAR_MAX_PAGES; // Maximum number of pages to free before ending a lazy clear cycle, unless the
 	                                  // queue is empty
+	double REDWOOD_LAZY_CLEAR_MAX_PAGES_PER_SECOND; // Rate limit for freeing cleared pages in the background, 0 for no
+	                                                // limit
 	int64_t REDWOOD_REMAP_CLEANUP_WINDOW_BYTES; // Total size of remapped pages to keep before being removed by
 	                                            // remap cleanup
 	double REDWOOD_REMAP_CLEANUP_TOLERANCE_RATIO; // Maximum ratio of the remap cleanup window that remap cleanup is
@@ -948,8 +1042,18 @@ public:
 	double REDWOOD_METRICS_INTERVAL;
 	double REDWOOD_HISTOGRAM_INTERVAL;
 	bool REDWOOD_EVICT_UPDATED_PAGES; // Whether to prioritize eviction of updated pages from cache.
+	double REDWOOD_PAGE_CACHE_PROBATION_FRACTION; // Fraction of the page cache that pages not hit since they were read
+	                                              // can fill before they are evicted first, 0 for a single LRU order
 	int REDWOOD_DECODECACHE_REUSE_MIN_HEIGHT; // Minimum height for which to keep and reuse page decode caches
+	int REDWOOD_SEARCH_ACCELERATOR_LEVELS; // Top levels of a reused page decode cache that seeks descend through by
+	                                       // comparing key prefixes, 0 to disable
 	int REDWOOD_NODE_MAX_UNBALANCE; // Maximum imbalance in a node before it should be rebuilt instead of updated
+	std::string REDWOOD_PAGE_COMPRESSION_FILTER; // Compression filter for leaf pages, "NONE" to disable compression
+	int REDWOOD_PAGE_COMPRESSION_MAX_BLOCKS; // Most blocks of records to build a leaf from before compressing it
+	double REDWOOD_PAGE_COMPRESSION_MIN_SAVINGS; // Fraction of a leaf's blocks compression must save for a leaf to be
+	                                             // written compressed
+	double REDWOOD_PAGE_COMPRESSION_PROBE_PROBABILITY; // Chance of building a multi-block leaf to sample compression
+	                                                   // while recent leaves have not compressed well
 
 	std::string REDWOOD_IO_PRIORITIES;
 
@@ -981,6 +1085,7 @@ public:
 
 	int BG_SNAPSHOT_FILE_TARGET_BYTES;
 	int BG_SNAPSHOT_FILE_TARGET_CHUNK_BYTES;
+	bool BG_SNAPSHOT_FILE_COLUMNAR; // Columnar snapshot chunks need a format version 2 reader
 	int BG_DELTA_FILE_TARGET_BYTES;
 	int BG_DELTA_FILE_TARGET_CHUNK_BYTES;
 	int BG_DELTA_BYTES_BEFORE_COMPACT;
@@ -997,6 +1102,7 @@ public:
 	int BG_RDC_BYTES_FACTOR;
 	int BG_RDC_READ_FACTOR;
 	bool BG_WRITE_MULTIPART;
+	int64_t BG_WRITE_MULTIPART_MIN_BYTES; // files at least this large are always written with a multipart upload
 	bool BG_ENABLE_DYNAMIC_WRITE_AMP;
 	double BG_DYNAMIC_WRITE_AMP_MIN_FACTOR;
 	double BG_DYNAMIC_WRITE_AMP_DECREASE_FACTOR;
@@ -1058,6 +1164,7 @@ public:
 	double IDEMPOTENCY_ID_IN_MEMORY_LIFETIME;
 	double IDEMPOTENCY_IDS_CLEANER_POLLING_INTERVAL;
 	double IDEMPOTENCY_IDS_MIN_AGE_SECONDS;
+	int64_t IDEMPOTENCY_ID_TIME_INDEX_BUCKET_SECONDS;
 
 	ServerKnobs(Randomize, ClientKnobs*, IsSimulated);
 	void initialize(Randomize, ClientKnobs*, IsSimulated);
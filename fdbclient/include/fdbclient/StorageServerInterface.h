@@ -123,6 +123,9 @@ struct StorageServerInterface {
 	RequestStream<struct FetchCheckpointKeyValuesRequest> fetchCheckpointKeyValues;
 	RequestStream<struct UpdateCommitCostRequest> updateCommitCostRequest;
 	RequestStream<struct AuditStorageRequest> auditStorage;
+	// Point reads of many keys at one version, served in one pass
+	PublicRequestStream<struct GetValuesRequest> getValues;
+	RequestStream<struct GetHotKeysRequest> getHotKeys;
 
 private:
 	bool acceptingRequests;
@@ -198,6 +201,10 @@ public:
 				    RequestStream<struct UpdateCommitCostRequest>(getValue.getEndpoint().getAdjustedEndpoint(22));
 				auditStorage =
 				    RequestStream<struct AuditStorageRequest>(getValue.getEndpoint().getAdjustedEndpoint(23));
+				getValues =
+				    PublicRequestStream<struct GetValuesRequest>(getValue.getEndpoint().getAdjustedEndpoint(24));
+				getHotKeys =
+				    RequestStream<struct GetHotKeysRequest>(getValue.getEndpoint().getAdjustedEndpoint(25));
 			}
 		} else {
 			ASSERT(Ar::isDeserializing);
@@ -250,6 +257,8 @@ public:
 		streams.push_back(fetchCheckpointKeyValues.getReceiver());
 		streams.push_back(updateCommitCostRequest.getReceiver());
 		streams.push_back(auditStorage.getReceiver());
+		streams.push_back(getValues.getReceiver(TaskPriority::LoadBalancedEndpoint));
+		streams.push_back(getHotKeys.getReceiver());
 		FlowTransport::transport().addEndpoints(streams);
 	}
 };
@@ -325,6 +334,54 @@ struct GetValueRequest : TimedRequest {
 	}
 };
 
+struct GetValuesReply : public LoadBalancedReply {
+	constexpr static FileIdentifier file_identifier = 1378931;
+	Arena arena;
+	// The requested keys that have a value, in the order of the request
+	VectorRef<KeyValueRef, VecSerStrategy::String> data;
+	bool cached = false;
+
+	GetValuesReply() = default;
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar, LoadBalancedReply::penalty, LoadBalancedReply::error, data, cached, arena);
+	}
+};
+
+struct GetValuesRequest : TimedRequest {
+	constexpr static FileIdentifier file_identifier = 8454532;
+	SpanContext spanContext;
+	TenantInfo tenantInfo;
+	Arena arena;
+	VectorRef<KeyRef> keys;
+	Version version;
+	Optional<TagSet> tags;
+	ReplyPromise<GetValuesReply> reply;
+	Optional<ReadOptions> options;
+	VersionVector ssLatestCommitVersions; // includes the latest commit versions, as known
+	                                      // to this client, of all storage replicas that
+	                                      // serve the given keys
+	GetValuesRequest() {}
+
+	bool verify() const { return tenantInfo.isAuthorized(); }
+
+	GetValuesRequest(SpanContext spanContext,
+	                 const TenantInfo& tenantInfo,
+	                 Standalone<VectorRef<KeyRef>> keys,
+	                 Version ver,
+	                 Optional<TagSet> tags,
+	                 Optional<ReadOptions> options,
+	                 VersionVector latestCommitVersions)
+	  : spanContext(spanContext), tenantInfo(tenantInfo), arena(keys.arena()), keys(keys), version(ver), tags(tags),
+	    options(options), ssLatestCommitVersions(latestCommitVersions) {}
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar, keys, version, tags, reply, spanContext, tenantInfo, options, ssLatestCommitVersions, arena);
+	}
+};
+
 struct WatchValueReply {
 	constexpr static FileIdentifier file_identifier = 3;
 
@@ -377,17 +434,35 @@ struct GetKeyValuesReply : public LoadBalancedReply {
 	Version version; // useful when latestVersion was requested
 	bool more;
 	bool cached = false;
+	// Set by filtered reads that stop before finding enough matching rows.  Every key before readThrough (or, for a
+	// reverse read, at or after it) has been examined, so the read resumes there rather than after the last row in data.
+	Optional<KeyRef> readThrough;
+	// Set instead of data for a digest-only request, to getKeyValuesDigest() of the rows that would have been returned
+	Optional<uint64_t> digest;
 
 	GetKeyValuesReply() : version(invalidVersion), more(false), cached(false) {}
 
 	template <class Ar>
 	void serialize(Ar& ar) {
-		serializer(ar, LoadBalancedReply::penalty, LoadBalancedReply::error, data, version, more, cached, arena);
+		serializer(ar,
+		           LoadBalancedReply::penalty,
+		           LoadBalancedReply::error,
+		           data,
+		           version,
+		           more,
+		           cached,
+		           readThrough,
+		           digest,
+		           arena);
 	}
 };
 
+// A hash of the keys and values of a range read, in order, so that replicas can compare a range without sending it
+uint64_t getKeyValuesDigest(VectorRef<KeyValueRef> data);
+
 struct GetKeyValuesRequest : TimedRequest {
 	constexpr static FileIdentifier file_identifier = 6795746;
+	constexpr static bool cancellable = true;
 	SpanContext spanContext;
 	Arena arena;
 	TenantInfo tenantInfo;
@@ -395,6 +470,8 @@ struct GetKeyValuesRequest : TimedRequest {
 	// This is a dummy field there has never been used.
 	// TODO: Get rid of this by constexpr or other template magic in getRange
 	KeyRef mapper = KeyRef();
+	// A packed RangeFilter applied to the rows read, or empty to return every row
+	KeyRef filter;
 	Version version; // or latestVersion
 	int limit, limitBytes;
 	Optional<TagSet> tags;
@@ -403,6 +480,8 @@ struct GetKeyValuesRequest : TimedRequest {
 	VersionVector ssLatestCommitVersions; // includes the latest commit versions, as known
 	                                      // to this client, of all storage replicas that
 	                                      // serve the given key
+	// Reply with the digest of the rows read and no data
+	bool digestOnly = false;
 
 	GetKeyValuesRequest() {}
 
@@ -422,6 +501,8 @@ struct GetKeyValuesRequest : TimedRequest {
 		           tenantInfo,
 		           options,
 		           ssLatestCommitVersions,
+		           filter,
+		           digestOnly,
 		           arena);
 	}
 };
@@ -435,22 +516,28 @@ struct GetMappedKeyValuesReply : public LoadBalancedReply {
 	Version version; // useful when latestVersion was requested
 	bool more;
 	bool cached = false;
+	// As in GetKeyValuesReply
+	Optional<KeyRef> readThrough;
 
 	GetMappedKeyValuesReply() : version(invalidVersion), more(false), cached(false) {}
 
 	template <class Ar>
 	void serialize(Ar& ar) {
-		serializer(ar, LoadBalancedReply::penalty, LoadBalancedReply::error, data, version, more, cached, arena);
+		serializer(
+		    ar, LoadBalancedReply::penalty, LoadBalancedReply::error, data, version, more, cached, readThrough, arena);
 	}
 };
 
 struct GetMappedKeyValuesRequest : TimedRequest {
 	constexpr static FileIdentifier file_identifier = 6795747;
+	constexpr static bool cancellable = true;
 	SpanContext spanContext;
 	Arena arena;
 	TenantInfo tenantInfo;
 	KeySelectorRef begin, end;
 	KeyRef mapper;
+	// A packed RangeFilter applied to the rows read before they are mapped, or empty to map every row
+	KeyRef filter;
 	Version version; // or latestVersion
 	int limit, limitBytes;
 	int matchIndex;
@@ -481,6 +568,7 @@ struct GetMappedKeyValuesRequest : TimedRequest {
 		           options,
 		           ssLatestCommitVersions,
 		           matchIndex,
+		           filter,
 		           arena);
 	}
 };
@@ -828,6 +916,53 @@ struct ReadHotSubRangeRequest {
 	}
 };
 
+// A key among the most frequently read or written keys of a storage server, with its estimated rates
+struct HotKeyRef {
+	KeyRef key;
+	double readsPerSecond = 0;
+	double writesPerSecond = 0;
+
+	HotKeyRef() = default;
+	HotKeyRef(KeyRef key, double readsPerSecond, double writesPerSecond)
+	  : key(key), readsPerSecond(readsPerSecond), writesPerSecond(writesPerSecond) {}
+	HotKeyRef(Arena& arena, const HotKeyRef& rhs)
+	  : key(arena, rhs.key), readsPerSecond(rhs.readsPerSecond), writesPerSecond(rhs.writesPerSecond) {}
+
+	int expectedSize() const { return key.expectedSize() + sizeof(readsPerSecond) + sizeof(writesPerSecond); }
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar, key, readsPerSecond, writesPerSecond);
+	}
+};
+
+struct GetHotKeysReply {
+	constexpr static FileIdentifier file_identifier = 6107233;
+	// In key order
+	Standalone<VectorRef<HotKeyRef>> hotKeys;
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar, hotKeys);
+	}
+};
+
+// Asks for the keys in a range that the storage server's hot key trackers count among its most frequent
+struct GetHotKeysRequest {
+	constexpr static FileIdentifier file_identifier = 13350187;
+	Arena arena;
+	KeyRangeRef keys;
+	ReplyPromise<GetHotKeysReply> reply;
+
+	GetHotKeysRequest() {}
+	GetHotKeysRequest(KeyRangeRef const& keys) : keys(arena, keys) {}
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar, keys, reply, arena);
+	}
+};
+
 struct SplitRangeReply {
 	constexpr static FileIdentifier file_identifier = 11813134;
 	// If the given range can be divided, contains the split points.
@@ -26,6 +26,7 @@
 
 #include "fdbclient/FDBTypes.h"
 #include "fdbclient/BlobGranuleCommon.h"
+#include "fdbclient/BulkLoading.h"
 #include "fdbclient/BlobWorkerInterface.h" // TODO move the functions that depend on this out of here and into BlobWorkerInterface.h to remove this depdendency
 #include "fdbclient/StorageServerInterface.h"
 #include "fdbclient/Tenant.h"
@@ -106,6 +107,13 @@ const Key auditRangePrefixFor(const UID& auditId);
 const Value auditStorageStateValue(const AuditStorageState& auditStorageState);
 AuditStorageState decodeAuditStorageState(const ValueRef& value);
 
+// "\xff/bulkLoad/[[begin]]" := "[[BulkLoadState]]", a key range map in which ranges that aren't bulk loaded map to ""
+extern const KeyRangeRef bulkLoadKeys;
+extern const KeyRef bulkLoadPrefix;
+
+const Value bulkLoadStateValue(const BulkLoadState& bulkLoadState);
+BulkLoadState decodeBulkLoadState(const ValueRef& value);
+
 // "\xff/checkpoint/[[UID]] := [[CheckpointMetaData]]"
 extern const KeyRef checkpointPrefix;
 const Key checkpointKeyFor(UID checkpointID);
@@ -161,6 +169,7 @@ extern const ValueRef conflictingKeysTrue, conflictingKeysFalse;
 extern const KeyRangeRef writeConflictRangeKeysRange;
 extern const KeyRangeRef readConflictRangeKeysRange;
 extern const KeyRangeRef ddStatsRange;
+extern const KeyRangeRef hotKeysRange;
 
 extern const KeyRef cacheKeysPrefix;
 
@@ -737,6 +746,7 @@ extern const Key blobGranulesLastFlushKey;
 
 extern const KeyRangeRef idempotencyIdKeys;
 extern const KeyRef idempotencyIdsExpiredVersion;
+extern const KeyRangeRef idempotencyIdTimeIndexKeys;
 
 #pragma clang diagnostic pop
 
@@ -0,0 +1,143 @@
+/*
+ * TrafficCapture.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#ifndef FDBCLIENT_TRAFFICCAPTURE_H
+#define FDBCLIENT_TRAFFICCAPTURE_H
+
+#include <algorithm>
+
+#include "fdbclient/ClientLogEvents.h"
+#include "flow/xxhash.h"
+
+// A compact, replayable record of the transactions a client runs, written to CLIENT_KNOBS->TRAFFIC_CAPTURE_FILE for
+// a TRAFFIC_CAPTURE_SAMPLE_RATE fraction of transactions. It is built from the same FdbClientLogEvents as transaction
+// profiling, but keeps only the shape of the traffic: every key is replaced by a 64-bit hash, so the same key always
+// maps to the same hash and hot keys stay hot on replay, and values are reduced to their sizes.
+//
+// The file starts with TRAFFIC_CAPTURE_MAGIC and TRAFFIC_CAPTURE_FORMAT_VERSION (both little endian), followed by
+// records of a little endian uint32_t length and a CapturedTransaction serialized with BinaryWriter(Unversioned()).
+namespace FdbClientLogEvents {
+
+constexpr uint64_t TRAFFIC_CAPTURE_MAGIC = 0x50414354434246ULL; // "FBCTCAP"
+constexpr uint32_t TRAFFIC_CAPTURE_FORMAT_VERSION = 1;
+
+inline uint64_t captureKeyHash(KeyRef key) {
+	return XXH3_64bits(key.begin(), key.size());
+}
+
+struct CapturedOp {
+	enum Type : uint8_t { GET_VERSION, GET, GET_RANGE, COMMIT, ERROR_GET, ERROR_GET_RANGE, ERROR_COMMIT };
+
+	uint8_t type = GET_VERSION;
+	double start = 0; // Seconds since the transaction's first operation started
+	double latency = 0; // Zero for errors
+	uint64_t keyHash = 0; // Key of a get, or begin of a range
+	uint64_t endKeyHash = 0;
+	int32_t bytes = 0; // Value bytes of a get, result bytes of a range read, or commit bytes
+	int32_t count = 0; // Mutations of a commit, or the error code of a failed operation
+	std::vector<uint64_t> mutationKeyHashes; // In order, for commits
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar, type, start, latency, keyHash, endKeyHash, bytes, count, mutationKeyHashes);
+	}
+};
+
+struct CapturedTransaction {
+	double startTime = 0; // now() when the first operation started
+	std::vector<CapturedOp> ops;
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar, startTime, ops);
+	}
+
+	// Events are added as they complete, which is not always the order they started in, so start times are kept
+	// absolute until the transaction is finished
+	void add(const EventGetVersion_V3& e) { push(CapturedOp::GET_VERSION, e.startTs, e.latency); }
+	void add(const EventGet& e) {
+		CapturedOp& op = push(CapturedOp::GET, e.startTs, e.latency);
+		op.keyHash = captureKeyHash(e.key);
+		op.bytes = e.valueSize;
+	}
+	void add(const EventGetRange& e) {
+		CapturedOp& op = push(CapturedOp::GET_RANGE, e.startTs, e.latency);
+		op.keyHash = captureKeyHash(e.startKey);
+		op.endKeyHash = captureKeyHash(e.endKey);
+		op.bytes = e.rangeSize;
+	}
+	void add(const EventCommit_V2& e) {
+		CapturedOp& op = push(CapturedOp::COMMIT, e.startTs, e.latency);
+		op.bytes = e.commitBytes;
+		op.count = e.numMutations;
+		addMutations(op, e.req.transaction.mutations);
+	}
+	void add(const EventGetError& e) {
+		CapturedOp& op = push(CapturedOp::ERROR_GET, e.startTs, 0);
+		op.keyHash = captureKeyHash(e.key);
+		op.count = e.errCode;
+	}
+	void add(const EventGetRangeError& e) {
+		CapturedOp& op = push(CapturedOp::ERROR_GET_RANGE, e.startTs, 0);
+		op.keyHash = captureKeyHash(e.startKey);
+		op.endKeyHash = captureKeyHash(e.endKey);
+		op.count = e.errCode;
+	}
+	void add(const EventCommitError& e) {
+		CapturedOp& op = push(CapturedOp::ERROR_COMMIT, e.startTs, 0);
+		op.count = e.errCode;
+		addMutations(op, e.req.transaction.mutations);
+	}
+
+	// Makes op start times relative to the first operation and puts the operations in start order
+	void finish() {
+		if (ops.empty()) {
+			return;
+		}
+		std::stable_sort(ops.begin(), ops.end(), [](const CapturedOp& a, const CapturedOp& b) {
+			return a.start < b.start;
+		});
+		startTime = ops.front().start;
+		for (auto& op : ops) {
+			op.start -= startTime;
+		}
+	}
+
+private:
+	CapturedOp& push(CapturedOp::Type type, double start, double latency) {
+		CapturedOp& op = ops.emplace_back();
+		op.type = type;
+		op.start = start;
+		op.latency = latency;
+		return op;
+	}
+
+	static void addMutations(CapturedOp& op, VectorRef<MutationRef> const& mutations) {
+		op.mutationKeyHashes.reserve(mutations.size());
+		for (auto const& m : mutations) {
+			op.mutationKeyHashes.push_back(captureKeyHash(m.param1));
+		}
+	}
+};
+
+} // namespace FdbClientLogEvents
+
+#endif
@@ -124,6 +124,77 @@ private:
 	Tuple(const StringRef& data, bool exclude_incomplete = false, bool exclude_user_type = false);
 	Standalone<VectorRef<uint8_t>> data;
 	std::vector<size_t> offsets;
+
+	// Returns the encoding of the element at index, including its type code
+	StringRef elementAt(size_t index) const;
+};
+
+// A read-only view of a packed tuple that decodes its elements in place as it iterates over them. Unlike
+// Tuple::unpack, it neither copies the data nor computes the offsets of all of the elements up front, so it suits
+// code that reads a few elements of many tuples. The data must outlive the view and its elements.
+class TupleView {
+public:
+	explicit TupleView(StringRef data, bool include_user_type = false)
+	  : data(data), include_user_type(include_user_type) {}
+
+	class Element {
+	public:
+		explicit Element(StringRef encoded) : encoded(encoded) {}
+
+		// The encoding of the element, including its type code, which can be passed to Tuple::appendRaw
+		StringRef raw() const { return encoded; }
+
+		Tuple::ElementType getType() const;
+		int64_t getInt(bool allow_incomplete = false) const;
+		bool getBool() const;
+		float getFloat() const;
+		double getDouble() const;
+		TupleVersionstamp getVersionstamp() const;
+		// Returns a string that points into the tuple, unless it has escaped nulls, in which case it is unescaped
+		// into arena
+		StringRef getString(Arena& arena) const;
+
+	private:
+		StringRef encoded;
+	};
+
+	class const_iterator {
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = Element;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const Element*;
+		using reference = Element;
+
+		Element operator*() const { return Element(view->data.substr(offset, next - offset)); }
+		const_iterator& operator++();
+		bool operator==(const_iterator const& other) const { return offset == other.offset; }
+		bool operator!=(const_iterator const& other) const { return offset != other.offset; }
+
+	private:
+		friend class TupleView;
+		const_iterator(const TupleView* view, size_t offset);
+
+		const TupleView* view;
+		size_t offset;
+		size_t next;
+	};
+
+	// Throws invalid_tuple_data_type when it reaches an element with an unknown type code
+	const_iterator begin() const { return const_iterator(this, 0); }
+	const_iterator end() const { return const_iterator(this, data.size()); }
+
+	// These scan the whole tuple, so they cost as much as unpacking it
+	size_t size() const;
+	Element at(size_t index) const;
+
+	// Returns the offset just past the element that starts at offset, which is beyond data.size() if the element is
+	// incomplete
+	static size_t elementEnd(StringRef data, size_t offset, bool include_user_type);
+
+private:
+	StringRef data;
+	bool include_user_type;
 };
 
 #endif /* FDBCLIENT_TUPLE_H */
@@ -46,7 +46,7 @@ struct VersionVector {
 	VersionVector(Version version) : maxVersion(version), cachedEncodedSize(InvalidEncodedSize) {}
 
 private:
-	// Only invoked by getDelta() and applyDelta(), where tag has been validated
+	// Only invoked by applyDelta(), where tag has been validated
 	// and version is guaranteed to be larger than the existing value.
 	inline void setVersionNoCheck(const Tag& tag, Version version) {
 		versions[tag] = version;
@@ -127,9 +127,10 @@ public:
 		if (CLIENT_KNOBS->SEND_ENTIRE_VERSION_VECTOR) {
 			delta = *this;
 		} else {
+			// The entries are visited in tag order, so each one is appended without a search
 			for (const auto& [tag, version] : versions) {
 				if (version > refVersion) {
-					delta.setVersionNoCheck(tag, version);
+					delta.versions.emplace_hint(delta.versions.end(), tag, version);
 				}
 			}
 			delta.maxVersion = maxVersion;
@@ -424,6 +425,7 @@ public:
 
 		size_t pairCount; // number of serialized <tag id, commit version> pairs
 		deserialize<size_t>(data, pairCount);
+		versions.reserve(pairCount);
 
 		T tagId;
 		V versionDelta;
@@ -435,8 +437,8 @@ public:
 				// Deserialize commit version delta.
 				deserialize<V>(data, versionDelta);
 
-				Tag tag(localities[i], tagId);
-				setVersionNoCheck(tag, minCommitVersion + versionDelta);
+				// Entries were serialized in tag order, so each one is appended without a search
+				versions.emplace_hint(versions.end(), Tag(localities[i], tagId), minCommitVersion + versionDelta);
 			}
 		}
 	}
@@ -505,8 +507,7 @@ struct dynamic_size_traits<VersionVector> : std::true_type {
 		size_t encodedSize;
 		if (vv.isEncodedSizeCached()) {
 			encodedSize = vv.getCachedEncodedSize();
-			// @todo remove this assert before doing performance tests
-			ASSERT(encodedSize == vv.getEncodedSize());
+			ASSERT_WE_THINK(encodedSize == vv.getEncodedSize());
 		} else {
 			encodedSize = vv.getEncodedSize();
 			const_cast<VersionVector&>(vv).setCachedEncodedSize(encodedSize);
@@ -532,14 +533,14 @@ struct dynamic_size_traits<VersionVector> : std::true_type {
 		// Serialize vv::maxVersion.
 		vv.serialize<Version>(out, (vv.getMaxVersion()));
 
-		// @todo remove this assert before doing performance tests
-		ASSERT(out - begin == vv.getEncodedSize());
+		ASSERT_WE_THINK(out - begin == vv.getEncodedSize());
 	}
 
 	template <class Context>
 	static void load(const uint8_t* data, size_t size, VersionVector& vv, Context& context) {
 		auto* p = data;
 
+		vv.clear();
 		size_t utlCount;
 		std::vector<int8_t> localities;
 		std::vector<uint16_t> localityCounts;
@@ -554,6 +555,8 @@ struct dynamic_size_traits<VersionVector> : std::true_type {
 		vv.setMaxVersion(maxVersion);
 
 		ASSERT(data - p == size);
+		// Loaded vectors are often sent on (e.g. whole vectors from a GRV proxy's cache), so keep the size
+		vv.setCachedEncodedSize(size);
 	}
 };
 
@@ -0,0 +1,697 @@
+/*
+ * VersionedWideMap.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FDBCLIENT_VERSIONEDWIDEMAP_H
+#define FDBCLIENT_VERSIONEDWIDEMAP_H
+#pragma once
+
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <vector>
+
+#include "flow/flow.h"
+#include "fdbclient/FDBTypes.h"
+
+// VersionedWideMap has the interface of VersionedMap, but instead of a persistent tree with a node per key version it
+// is a single B+tree with wide nodes, each entry of which keeps the states of its key within the MVCC window as a
+// chain, newest first. A key whose state changes once in the window costs one entry in a leaf array rather than several
+// tree nodes, and iterating scans leaf arrays.
+//
+// A view may read any version from oldestVersion up, and so may its iterators. They remain valid while the latest
+// version is modified and while versions are forgotten: an iterator finds its place again by key after the tree is
+// restructured, and the states that a view could read are kept until it is destroyed. As with VersionedMap, insert()
+// and erase() invalidate iterators into atLatest().
+template <class K, class T>
+class VersionedWideMap : NonCopyable {
+	static constexpr int leafCapacity = 64;
+	static constexpr int innerCapacity = 64;
+
+	// A state of a key before the newest one
+	struct Older : FastAllocated<Older> {
+		Version version;
+		Version insertVersion;
+		Optional<T> value;
+		Older* next;
+
+		Older(Version version, Version insertVersion, Optional<T> const& value, Older* next)
+		  : version(version), insertVersion(insertVersion), value(value), next(next) {}
+	};
+
+	struct Entry {
+		K key;
+		// The newest state of key, which holds from version on. The value is absent if key was erased at version.
+		Version version;
+		Version insertVersion;
+		Optional<T> value;
+		Older* older;
+	};
+
+	struct Node {
+		explicit Node(bool isLeaf) : isLeaf(isLeaf) {}
+		const bool isLeaf;
+	};
+
+	struct Leaf : Node, FastAllocated<Leaf> {
+		Leaf() : Node(true) {}
+		std::vector<Entry> entries;
+		Leaf* prev = nullptr;
+		Leaf* next = nullptr;
+	};
+
+	struct Inner : Node, FastAllocated<Inner> {
+		Inner() : Node(false) {}
+		// Every key in children[i] is at least keys[i], and less than keys[i + 1]. keys[0] is not used.
+		std::vector<K> keys;
+		std::vector<Node*> children;
+	};
+
+	// The entries at positions with a null leaf are past the end
+	struct Position {
+		Leaf* leaf = nullptr;
+		int index = 0;
+	};
+
+	struct PinRegistry : ReferenceCounted<PinRegistry> {
+		std::map<Version, int> pinned;
+	};
+
+	// Views hold a pin of their version so that the states they can read aren't forgotten
+	struct Pin : ReferenceCounted<Pin>, FastAllocated<Pin> {
+		Pin(Reference<PinRegistry> const& registry, Version version) : registry(registry), version(version) {
+			++registry->pinned[version];
+		}
+		~Pin() {
+			auto it = registry->pinned.find(version);
+			if (--it->second == 0) {
+				registry->pinned.erase(it);
+			}
+		}
+
+		Reference<PinRegistry> registry;
+		Version version;
+	};
+
+public:
+	// An entry, and the slack of the leaf array it is in
+	static const int overheadPerItem = sizeof(Entry) * 3 / 2;
+
+	Version oldestVersion, latestVersion;
+
+	struct iterator;
+	class ViewAtVersion;
+
+	VersionedWideMap() : oldestVersion(0), latestVersion(0), pins(makeReference<PinRegistry>()) {
+		root = firstLeaf = lastLeaf = new Leaf;
+	}
+	VersionedWideMap(VersionedWideMap&& v) noexcept : VersionedWideMap() { swap(v); }
+	void operator=(VersionedWideMap&& v) noexcept { swap(v); }
+	~VersionedWideMap() {
+		for (Leaf* l = firstLeaf; l; l = l->next) {
+			for (Entry& e : l->entries) {
+				freeChain(e.older);
+			}
+		}
+		freeNode(root);
+	}
+
+	Version getLatestVersion() const { return latestVersion; }
+	Version getOldestVersion() const { return oldestVersion; }
+
+	// Sets and erases that follow are into version, which may now be passed to at(). Must be called in monotonically
+	// increasing order.
+	void createNewVersion(Version version) {
+		if (version > latestVersion) {
+			latestVersion = version;
+			cachedPin.clear();
+		} else {
+			ASSERT(version == latestVersion);
+		}
+	}
+
+	void forgetVersionsBefore(Version newOldestVersion) {
+		ASSERT(newOldestVersion <= latestVersion);
+		oldestVersion = std::max(oldestVersion, newOldestVersion);
+		cachedPin.clear();
+		Version forgettable = oldestVersion;
+		if (!pins->pinned.empty()) {
+			forgettable = std::min(forgettable, pins->pinned.begin()->first);
+		}
+		forget(forgettable);
+	}
+
+	// Forgetting is incremental, so there is nothing to defer
+	Future<Void> forgetVersionsBeforeAsync(Version newOldestVersion, TaskPriority taskID = TaskPriority::DefaultYield) {
+		forgetVersionsBefore(newOldestVersion);
+		return Void();
+	}
+
+	// insert() and erase() invalidate atLatest() and all iterators into it
+	void insert(const K& k, const T& t) { insert(k, t, latestVersion); }
+	void insert(const K& k, const T& t, Version insertAt) {
+		Position p = lowerBoundRaw(k);
+		if (p.leaf && p.leaf->entries[p.index].key == k) {
+			setState(p.leaf->entries[p.index], t, insertAt);
+			return;
+		}
+
+		K separator;
+		Node* split = insertEntry(root, Entry{ k, latestVersion, insertAt, t, nullptr }, &separator);
+		if (split) {
+			Inner* newRoot = new Inner;
+			newRoot->keys = { K(), separator };
+			newRoot->children = { root, split };
+			root = newRoot;
+		}
+		++structureVersion;
+	}
+
+	void erase(const K& begin, const K& end) {
+		Position p = lowerBoundRaw(begin);
+		while (p.leaf && p.leaf->entries[p.index].key < end) {
+			p = eraseAt(p);
+		}
+	}
+	void erase(const K& key) { // key must be present
+		Position p = lowerBoundRaw(key);
+		ASSERT(p.leaf && p.leaf->entries[p.index].key == key);
+		eraseAt(p);
+	}
+	void erase(iterator const& item) { // iterator must be in latest version!
+		ASSERT_EQ(item.at, latestVersion);
+		K key = item.key();
+		erase(key);
+	}
+
+	struct iterator {
+		explicit iterator(const VersionedWideMap* map, Version at, Reference<Pin> const& pin)
+		  : map(map), at(at), pin(pin) {}
+
+		K const& key() const {
+			refresh();
+			return pos.leaf->entries[pos.index].key;
+		}
+		// Returns the version at which the current item was inserted
+		Version insertVersion() const {
+			refresh();
+			Version v;
+			map->stateAt(pos.leaf->entries[pos.index], at, &v);
+			return v;
+		}
+		operator bool() const {
+			refresh();
+			return pos.leaf != nullptr;
+		}
+		bool operator<(const K& key) const { return this->key() < key; }
+
+		T const& operator*() const {
+			refresh();
+			return map->stateAt(pos.leaf->entries[pos.index], at, nullptr)->get();
+		}
+		T const* operator->() const { return &**this; }
+		void operator++() {
+			refresh();
+			moveTo(pos.leaf ? map->seekForward(map->step(pos), at) : map->seekForward(map->beginRaw(), at));
+		}
+		void operator--() {
+			refresh();
+			moveTo(map->previousVisible(pos, at));
+		}
+		bool operator==(const iterator& r) const {
+			refresh();
+			r.refresh();
+			if (pos.leaf && r.pos.leaf)
+				return pos.leaf == r.pos.leaf && pos.index == r.pos.index;
+			else
+				return pos.leaf == r.pos.leaf;
+		}
+		bool operator!=(const iterator& r) const { return !(*this == r); }
+
+	private:
+		friend class VersionedWideMap<K, T>;
+
+		void moveTo(Position p) const {
+			pos = p;
+			structureVersion = map->structureVersion;
+			if (pos.leaf) {
+				savedKey = pos.leaf->entries[pos.index].key;
+			}
+		}
+
+		// Finds the position of the key again if the tree has been restructured
+		void refresh() const {
+			if (pos.leaf && structureVersion != map->structureVersion) {
+				moveTo(map->seekForward(map->lowerBoundRaw(savedKey), at));
+			}
+		}
+
+		const VersionedWideMap* map;
+		Version at;
+		Reference<Pin> pin;
+		mutable Position pos;
+		mutable uint64_t structureVersion = 0;
+		mutable K savedKey;
+	};
+
+	class ViewAtVersion {
+	public:
+		ViewAtVersion(const VersionedWideMap* map, Version at) : map(map), at(at), pin(map->pin(at)) {}
+
+		iterator begin() const { return make(map->seekForward(map->beginRaw(), at)); }
+		iterator end() const { return iterator(map, at, pin); }
+
+		// Returns x such that key==*x, or end()
+		template <class X>
+		iterator find(const X& key) const {
+			iterator i = lower_bound(key);
+			if (i && i.key() == key)
+				return i;
+			else
+				return end();
+		}
+
+		// Returns the smallest x such that *x>=key, or end()
+		template <class X>
+		iterator lower_bound(const X& key) const {
+			return make(map->seekForward(map->lowerBoundRaw(key), at));
+		}
+
+		// Returns the smallest x such that *x>key, or end()
+		template <class X>
+		iterator upper_bound(const X& key) const {
+			return make(map->seekForward(map->upperBoundRaw(key), at));
+		}
+
+		// Returns the largest x such that *x<=key, or end()
+		template <class X>
+		iterator lastLessOrEqual(const X& key) const {
+			return make(map->previousVisible(map->upperBoundRaw(key), at));
+		}
+
+		// Returns the largest x such that *x<key, or end()
+		template <class X>
+		iterator lastLess(const X& key) const {
+			return make(map->previousVisible(map->lowerBoundRaw(key), at));
+		}
+
+		void validate() {
+			int count = 0;
+			map->validateNode(map->root, nullptr, nullptr, count);
+			int linked = 0;
+			for (Leaf* l = map->firstLeaf; l; l = l->next) {
+				ASSERT(l->next || l == map->lastLeaf);
+				ASSERT(!l->next || l->next->prev == l);
+				linked += l->entries.size();
+			}
+			ASSERT(linked == count);
+		}
+
+	private:
+		iterator make(Position p) const {
+			iterator i(map, at, pin);
+			i.moveTo(p);
+			return i;
+		}
+
+		const VersionedWideMap* map;
+		Version at;
+		Reference<Pin> pin;
+	};
+
+	ViewAtVersion at(Version v) const {
+		if (v == ::latestVersion) {
+			return atLatest();
+		}
+		ASSERT(v >= oldestVersion && v <= latestVersion);
+		return ViewAtVersion(this, v);
+	}
+	ViewAtVersion atLatest() const { return ViewAtVersion(this, latestVersion); }
+
+	bool isClearContaining(ViewAtVersion const& view, KeyRef key) {
+		auto i = view.lastLessOrEqual(key);
+		return i && i->isClearTo() && i->getEndKey() > key;
+	}
+
+	// The number of entries, including those only older versions can see
+	int64_t size() const { return entryCount; }
+
+private:
+	Node* root;
+	Leaf* firstLeaf;
+	Leaf* lastLeaf;
+	int64_t entryCount = 0;
+	// Changes whenever entries move, so that iterators know to find their place again
+	uint64_t structureVersion = 1;
+	// The keys whose older states, or whose erasure, can be forgotten once no view reads before each version
+	std::deque<std::pair<Version, K>> forgettableAt;
+	Reference<PinRegistry> pins;
+	// Many views are made at each version, so they share a pin until the versions they may read change
+	mutable Reference<Pin> cachedPin;
+
+	void swap(VersionedWideMap& v) {
+		std::swap(oldestVersion, v.oldestVersion);
+		std::swap(latestVersion, v.latestVersion);
+		std::swap(root, v.root);
+		std::swap(firstLeaf, v.firstLeaf);
+		std::swap(lastLeaf, v.lastLeaf);
+		std::swap(entryCount, v.entryCount);
+		std::swap(forgettableAt, v.forgettableAt);
+		std::swap(pins, v.pins);
+		std::swap(cachedPin, v.cachedPin);
+		++structureVersion;
+		++v.structureVersion;
+	}
+
+	Reference<Pin> pin(Version v) const {
+		if (!cachedPin || cachedPin->version != v) {
+			cachedPin = makeReference<Pin>(pins, v);
+		}
+		return cachedPin;
+	}
+
+	static void freeChain(Older* o) {
+		while (o) {
+			Older* next = o->next;
+			delete o;
+			o = next;
+		}
+	}
+
+	static void freeNode(Node* n) {
+		if (n->isLeaf) {
+			delete static_cast<Leaf*>(n);
+			return;
+		}
+		Inner* in = static_cast<Inner*>(n);
+		for (Node* c : in->children) {
+			freeNode(c);
+		}
+		delete in;
+	}
+
+	// Returns the state of e at version v, which has an absent value if key was erased, or nullptr if key didn't exist
+	static const Optional<T>* stateAt(const Entry& e, Version v, Version* insertVersion) {
+		if (e.version <= v) {
+			if (insertVersion)
+				*insertVersion = e.insertVersion;
+			return &e.value;
+		}
+		for (const Older* o = e.older; o; o = o->next) {
+			if (o->version <= v) {
+				if (insertVersion)
+					*insertVersion = o->insertVersion;
+				return &o->value;
+			}
+		}
+		return nullptr;
+	}
+
+	static bool visibleAt(const Entry& e, Version v) {
+		const Optional<T>* state = stateAt(e, v, nullptr);
+		return state && state->present();
+	}
+
+	// Makes value the state of e in the latest version
+	void setState(Entry& e, Optional<T> const& value, Version insertVersion) {
+		if (e.version != latestVersion) {
+			e.older = new Older(e.version, e.insertVersion, e.value, e.older);
+			e.version = latestVersion;
+			forgettableAt.emplace_back(latestVersion, e.key);
+		}
+		e.value = value;
+		e.insertVersion = insertVersion;
+	}
+
+	template <class X>
+	static int childIndex(const Inner* in, const X& key) {
+		return std::upper_bound(in->keys.begin() + 1, in->keys.end(), key, [](const X& k, const K& s) {
+			       return k < s;
+		       }) -
+		       in->keys.begin() - 1;
+	}
+
+	template <class X>
+	Leaf* findLeaf(const X& key) const {
+		Node* n = root;
+		while (!n->isLeaf) {
+			const Inner* in = static_cast<const Inner*>(n);
+			n = in->children[childIndex(in, key)];
+		}
+		return static_cast<Leaf*>(n);
+	}
+
+	static Position normalize(Leaf* l, int index) {
+		while (l && index >= (int)l->entries.size()) {
+			l = l->next;
+			index = 0;
+		}
+		return Position{ l, index };
+	}
+
+	Position beginRaw() const { return normalize(firstLeaf, 0); }
+	static Position step(Position p) { return normalize(p.leaf, p.index + 1); }
+	Position stepBack(Position p) const {
+		Leaf* l = p.leaf;
+		if (l && p.index > 0) {
+			return Position{ l, p.index - 1 };
+		}
+		l = l ? l->prev : lastLeaf;
+		while (l && l->entries.empty()) {
+			l = l->prev;
+		}
+		return l ? Position{ l, (int)l->entries.size() - 1 } : Position();
+	}
+
+	// The first entry at least key, visible or not
+	template <class X>
+	Position lowerBoundRaw(const X& key) const {
+		Leaf* l = findLeaf(key);
+		auto it = std::lower_bound(
+		    l->entries.begin(), l->entries.end(), key, [](const Entry& e, const X& k) { return e.key < k; });
+		return normalize(l, it - l->entries.begin());
+	}
+
+	// The first entry greater than key, visible or not
+	template <class X>
+	Position upperBoundRaw(const X& key) const {
+		Leaf* l = findLeaf(key);
+		auto it = std::upper_bound(
+		    l->entries.begin(), l->entries.end(), key, [](const X& k, const Entry& e) { return k < e.key; });
+		return normalize(l, it - l->entries.begin());
+	}
+
+	// The first entry from p on that is visible at v
+	Position seekForward(Position p, Version v) const {
+		while (p.leaf && !visibleAt(p.leaf->entries[p.index], v)) {
+			p = step(p);
+		}
+		return p;
+	}
+
+	// The last entry before p that is visible at v, where the end comes after every entry
+	Position previousVisible(Position p, Version v) const {
+		p = stepBack(p);
+		while (p.leaf && !visibleAt(p.leaf->entries[p.index], v)) {
+			p = stepBack(p);
+		}
+		return p;
+	}
+
+	// Inserts e, which is a new key, into the subtree at n. If n has to split, returns the new right sibling and sets
+	// *separator to its lower bound.
+	Node* insertEntry(Node* n, Entry&& e, K* separator) {
+		if (n->isLeaf) {
+			Leaf* l = static_cast<Leaf*>(n);
+			auto it = std::lower_bound(
+			    l->entries.begin(), l->entries.end(), e.key, [](const Entry& a, const K& k) { return a.key < k; });
+			l->entries.insert(it, std::move(e));
+			++entryCount;
+			if (l->entries.size() <= leafCapacity) {
+				return nullptr;
+			}
+
+			Leaf* right = new Leaf;
+			int half = l->entries.size() / 2;
+			right->entries.reserve(leafCapacity + 1);
+			right->entries.assign(l->entries.begin() + half, l->entries.end());
+			l->entries.resize(half);
+			right->prev = l;
+			right->next = l->next;
+			if (l->next) {
+				l->next->prev = right;
+			} else {
+				lastLeaf = right;
+			}
+			l->next = right;
+			*separator = right->entries[0].key;
+			return right;
+		}
+
+		Inner* in = static_cast<Inner*>(n);
+		int i = childIndex(in, e.key);
+		K childSeparator;
+		Node* split = insertEntry(in->children[i], std::move(e), &childSeparator);
+		if (!split) {
+			return nullptr;
+		}
+		in->keys.insert(in->keys.begin() + i + 1, childSeparator);
+		in->children.insert(in->children.begin() + i + 1, split);
+		if (in->children.size() <= innerCapacity) {
+			return nullptr;
+		}
+
+		Inner* right = new Inner;
+		int half = in->children.size() / 2;
+		right->keys.assign(in->keys.begin() + half, in->keys.end());
+		right->children.assign(in->children.begin() + half, in->children.end());
+		in->keys.resize(half);
+		in->children.resize(half);
+		*separator = right->keys[0];
+		return right;
+	}
+
+	// Erases the entry at p from the latest version, and returns the position of the entry after it
+	Position eraseAt(Position p) {
+		Entry& e = p.leaf->entries[p.index];
+		if (e.version == latestVersion && !e.older) {
+			// No view can see an entry that was created in the latest version, except those that insert() and
+			// erase() invalidate
+			return removeAt(p);
+		}
+		if (e.value.present()) {
+			setState(e, Optional<T>(), e.insertVersion);
+		}
+		return step(p);
+	}
+
+	// Removes the entry at p from the tree, and returns the position of the entry after it
+	Position removeAt(Position p) {
+		Leaf* l = p.leaf;
+		ASSERT(!l->entries[p.index].older);
+		++structureVersion;
+		--entryCount;
+		if (l->entries.size() > 1 || l == root) {
+			l->entries.erase(l->entries.begin() + p.index);
+			return normalize(l, p.index);
+		}
+
+		K key = l->entries[0].key;
+		Leaf* next = l->next;
+		if (l->prev) {
+			l->prev->next = l->next;
+		} else {
+			firstLeaf = l->next;
+		}
+		if (l->next) {
+			l->next->prev = l->prev;
+		} else {
+			lastLeaf = l->prev;
+		}
+		if (removeLeaf(root, key, l)) {
+			delete static_cast<Inner*>(root);
+			root = firstLeaf = lastLeaf = new Leaf;
+		}
+		delete l;
+		while (!root->isLeaf && static_cast<Inner*>(root)->children.size() == 1) {
+			Inner* oldRoot = static_cast<Inner*>(root);
+			root = oldRoot->children[0];
+			delete oldRoot;
+		}
+		return normalize(next, 0);
+	}
+
+	// Removes the empty leaf target, which key belongs in, from the subtree at inner node n. Returns true if n is left
+	// without children, for the caller to remove it too.
+	bool removeLeaf(Node* n, const K& key, Leaf* target) {
+		Inner* in = static_cast<Inner*>(n);
+		int i = childIndex(in, key);
+		Node* child = in->children[i];
+		if (child != target) {
+			if (!removeLeaf(child, key, target)) {
+				return false;
+			}
+			delete static_cast<Inner*>(child);
+		}
+		in->children.erase(in->children.begin() + i);
+		// keys[0] stays the unused one
+		in->keys.erase(in->keys.begin() + (i == 0 ? std::min<int>(1, in->keys.size() - 1) : i));
+		return in->children.empty();
+	}
+
+	// Forgets the states that no view at or after version can see
+	void forget(Version version) {
+		while (!forgettableAt.empty() && forgettableAt.front().first <= version) {
+			K key = forgettableAt.front().second;
+			forgettableAt.pop_front();
+			Position p = lowerBoundRaw(key);
+			if (!p.leaf || !(p.leaf->entries[p.index].key == key)) {
+				continue;
+			}
+			Entry& e = p.leaf->entries[p.index];
+			if (e.version <= version) {
+				freeChain(e.older);
+				e.older = nullptr;
+				if (!e.value.present()) {
+					removeAt(p);
+				}
+				continue;
+			}
+			for (Older* o = e.older; o; o = o->next) {
+				if (o->version <= version) {
+					freeChain(o->next);
+					o->next = nullptr;
+					break;
+				}
+			}
+		}
+	}
+
+	void validateNode(const Node* n, const K* lower, const K* upper, int& count) const {
+		if (n->isLeaf) {
+			const Leaf* l = static_cast<const Leaf*>(n);
+			ASSERT(l->entries.size() <= leafCapacity);
+			ASSERT(!l->entries.empty() || l == root);
+			for (int i = 0; i < l->entries.size(); i++) {
+				const K& k = l->entries[i].key;
+				ASSERT(!lower || !(k < *lower));
+				ASSERT(!upper || k < *upper);
+				ASSERT(i == 0 || l->entries[i - 1].key < k);
+				Version newer = l->entries[i].version;
+				for (const Older* o = l->entries[i].older; o; o = o->next) {
+					ASSERT(o->version < newer);
+					newer = o->version;
+				}
+			}
+			count += l->entries.size();
+			return;
+		}
+		const Inner* in = static_cast<const Inner*>(n);
+		ASSERT(!in->children.empty() && in->children.size() <= innerCapacity);
+		ASSERT(in->keys.size() == in->children.size());
+		for (int i = 0; i < in->children.size(); i++) {
+			validateNode(in->children[i],
+			             i ? &in->keys[i] : lower,
+			             i + 1 < in->keys.size() ? &in->keys[i + 1] : upper,
+			             count);
+		}
+	}
+};
+
+#endif
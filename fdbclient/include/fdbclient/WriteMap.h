@@ -126,7 +126,9 @@ private:
 	typedef Reference<PTreeT> Tree;
 
 public:
-	explicit WriteMap(Arena* arena) : arena(arena), writeMapEmpty(true), ver(-1), scratch_iterator(this) {
+	explicit WriteMap(Arena* arena)
+	  : arena(arena), writeMapEmpty(true), ver(-1), scratch_iterator(this),
+	    lastWrite(LastWrite{ allKeys.begin, false, false, false }) {
 		PTreeImpl::insert(
 		    writes, ver, WriteMapEntry(allKeys.begin, OperationStack(), false, false, false, false, false));
 		PTreeImpl::insert(writes, ver, WriteMapEntry(allKeys.end, OperationStack(), false, false, false, false, false));
@@ -136,7 +138,7 @@ public:
 
 	WriteMap(WriteMap&& r) noexcept
 	  : arena(r.arena), writeMapEmpty(r.writeMapEmpty), writes(std::move(r.writes)), ver(r.ver),
-	    scratch_iterator(std::move(r.scratch_iterator)) {}
+	    scratch_iterator(std::move(r.scratch_iterator)), lastWrite(r.lastWrite) {}
 
 	WriteMap& operator=(WriteMap&& r) noexcept;
 
@@ -221,8 +223,29 @@ private:
 	Version ver;
 	iterator scratch_iterator; // Avoid unnecessary memory allocation in write operations
 
+	// The greatest key written by mutate(), and the flags of the range after it, while nothing else has changed the
+	// map past it. A write beyond it lands in that range, so writes in increasing key order (as bulk loaders do) can be
+	// inserted without searching the tree for their range first.
+	struct LastWrite {
+		KeyRef key;
+		bool cleared;
+		bool conflict;
+		bool unreadable;
+	};
+	Optional<LastWrite> lastWrite;
+
 	void dump();
 
+	void insertWrite(KeyRef key,
+	                 MutationRef::Type operation,
+	                 ValueRef param,
+	                 bool is_dependent,
+	                 bool is_cleared,
+	                 bool following_conflict,
+	                 bool is_conflict,
+	                 bool following_unreadable,
+	                 bool is_unreadable);
+
 	// SOMEDAY: clearNoConflict replaces cleared sets with two map entries for everyone one item cleared
 	void clearNoConflict(KeyRangeRef keys);
 };
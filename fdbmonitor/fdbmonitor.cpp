@@ -26,6 +26,7 @@
 #include <random>
 
 #ifdef __linux__
+#include <sched.h>
 #include <sys/prctl.h>
 #endif
 
@@ -441,6 +442,93 @@ uint64_t parseWithSuffix(const char* to_parse, const char* default_unit = nullpt
 	return ret;
 }
 
+// Parses a CPU list in the format of /sys/devices/system/cpu/online, such as "0-3,8,10-11". Returns false if the
+// list is malformed.
+bool parseCPUList(const std::string& list, std::vector<int>& cpus) {
+	std::stringstream ss(list);
+	std::string range;
+	while (std::getline(ss, range, ',')) {
+		int first, last;
+		char* end;
+		first = last = strtol(range.c_str(), &end, 10);
+		if (end == range.c_str() || first < 0) {
+			return false;
+		}
+		if (*end == '-') {
+			const char* lastBegin = end + 1;
+			last = strtol(lastBegin, &end, 10);
+			if (end == lastBegin || last < first) {
+				return false;
+			}
+		}
+		if (*end != 0 && *end != '\n') {
+			return false;
+		}
+		for (int cpu = first; cpu <= last; cpu++) {
+			cpus.push_back(cpu);
+		}
+	}
+	return true;
+}
+
+#ifdef __linux__
+// Reads a CPU list from sysfs, returning an empty list if it can't be read
+std::vector<int> readCPUList(const std::string& path) {
+	std::vector<int> cpus;
+	FILE* f = fopen(path.c_str(), "r");
+	if (f == nullptr) {
+		return cpus;
+	}
+	char line[4096];
+	if (fgets(line, sizeof(line), f) == nullptr || !parseCPUList(line, cpus)) {
+		cpus.clear();
+	}
+	fclose(f);
+	return cpus;
+}
+
+// Resolves the cpu-affinity of the process with the given ID number to the CPUs it may run on. "numa" spreads
+// processes round robin across the NUMA nodes and allows each every CPU of its node, "core" gives each process one
+// physical core (with its hyperthreads) round robin, and anything else is an explicit CPU list. Returns an empty list
+// if the value can't be resolved.
+std::vector<int> resolveCPUAffinity(const std::string& affinity, int idNumber) {
+	std::vector<std::vector<int>> groups;
+	if (affinity == "numa") {
+		for (int node : readCPUList("/sys/devices/system/node/online")) {
+			std::vector<int> cpus = readCPUList("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+			if (!cpus.empty()) {
+				groups.push_back(cpus);
+			}
+		}
+		if (groups.empty()) {
+			// Not a NUMA system, so every CPU is local
+			groups.push_back(readCPUList("/sys/devices/system/cpu/online"));
+		}
+	} else if (affinity == "core") {
+		for (int cpu : readCPUList("/sys/devices/system/cpu/online")) {
+			std::vector<int> siblings = readCPUList("/sys/devices/system/cpu/cpu" + std::to_string(cpu) +
+			                                        "/topology/thread_siblings_list");
+			// Count each core once, as its first hyperthread
+			if (siblings.empty()) {
+				groups.push_back({ cpu });
+			} else if (siblings[0] == cpu) {
+				groups.push_back(siblings);
+			}
+		}
+	} else {
+		std::vector<int> cpus;
+		if (parseCPUList(affinity, cpus)) {
+			return cpus;
+		}
+		return std::vector<int>();
+	}
+	if (groups.empty()) {
+		return std::vector<int>();
+	}
+	return groups[std::abs(idNumber) % groups.size()];
+}
+#endif
+
 struct Command {
 private:
 	std::vector<std::string> commands;
@@ -461,6 +549,7 @@ public:
 	bool deconfigured;
 	bool kill_on_configuration_change;
 	uint64_t memory_rss;
+	std::vector<int> cpu_affinity; // Empty to let the process run on any CPU
 
 	// one pair for each of stdout and stderr
 	int pipes[2][2];
@@ -597,6 +686,20 @@ public:
 
 		const char* id_s = ssection.c_str() + strlen(section.c_str()) + 1;
 
+		const char* affinity =
+		    get_value_multi(ini, "cpu-affinity", ssection.c_str(), section.c_str(), "general", nullptr);
+		if (affinity && strcmp(affinity, "none")) {
+#ifdef __linux__
+			cpu_affinity = resolveCPUAffinity(affinity, atoi(id_s));
+			if (cpu_affinity.empty()) {
+				log_msg(SevError, "Unable to resolve cpu-affinity '%s' for %s\n", affinity, ssection.c_str());
+				return;
+			}
+#else
+			log_msg(SevWarn, "CPU affinity is not supported by current system\n");
+#endif
+		}
+
 		for (auto i : keys) {
 			// For "memory" option, despite they are handled by fdbmonitor, we still pass it to fdbserver.
 			if (isParameterNameEqual(i.pItem, "command") || isParameterNameEqual(i.pItem, "restart-delay") ||
@@ -605,7 +708,8 @@ public:
 			    isParameterNameEqual(i.pItem, "restart-delay-reset-interval") ||
 			    isParameterNameEqual(i.pItem, "disable-lifecycle-logging") ||
 			    isParameterNameEqual(i.pItem, "delete-envvars") ||
-			    isParameterNameEqual(i.pItem, "kill-on-configuration-change")) {
+			    isParameterNameEqual(i.pItem, "kill-on-configuration-change") ||
+			    isParameterNameEqual(i.pItem, "cpu-affinity")) {
 				continue;
 			}
 
@@ -665,7 +769,7 @@ public:
 		current_restart_delay = std::max<double>(initial_restart_delay, current_restart_delay);
 	}
 	bool operator!=(const Command& rhs) {
-		if (rhs.commands.size() != commands.size())
+		if (rhs.commands.size() != commands.size() || rhs.cpu_affinity != cpu_affinity)
 			return true;
 
 		for (size_t i = 0; i < commands.size(); i++) {
@@ -814,6 +918,25 @@ void start_process(Command* cmd, ProcessID id, uid_t uid, gid_t gid, int delay,
 			exit(0);
 #endif
 
+#ifdef __linux__
+		// Pinning before exec also keeps the process's memory on the local NUMA node, since Linux allocates pages on
+		// the node of the CPU that first touches them
+		if (!cmd->cpu_affinity.empty()) {
+			cpu_set_t cpus;
+			CPU_ZERO(&cpus);
+			for (int cpu : cmd->cpu_affinity) {
+				CPU_SET(cpu, &cpus);
+			}
+			if (sched_setaffinity(0, sizeof(cpus), &cpus) != 0) {
+				fprintf(stderr,
+				        "Unable to set CPU affinity for %s (sched_setaffinity error %d: %s)\n",
+				        cmd->ssection.c_str(),
+				        errno,
+				        strerror(errno));
+			}
+		}
+#endif
+
 		if (!cmd->quiet) {
 			fprintf(stdout, "Launching %s (%d) for %s\n", cmd->argv[0], getpid(), cmd->ssection.c_str());
 			fflush(stdout);
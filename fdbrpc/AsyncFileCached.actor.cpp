@@ -31,7 +31,7 @@ EvictablePage::~EvictablePage() {
 	if (data) {
 		freeFast4kAligned(pageCache->pageSize, data);
 	}
-	if (EvictablePageCache::RANDOM == pageCache->cacheEvictionType) {
+	if (EvictablePageCache::LRU != pageCache->cacheEvictionType) {
 		if (index > -1) {
 			pageCache->pages[index] = pageCache->pages.back();
 			pageCache->pages[index]->index = index;
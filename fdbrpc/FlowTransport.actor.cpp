@@ -38,8 +38,10 @@
 #include "fdbrpc/genericactors.actor.h"
 #include "fdbrpc/IPAllowList.h"
 #include "fdbrpc/TokenCache.h"
+#include "fdbrpc/WellKnownEndpoints.h"
 #include "fdbrpc/simulator.h"
 #include "flow/ActorCollection.h"
+#include "flow/CompressionUtils.h"
 #include "flow/Error.h"
 #include "flow/flow.h"
 #include "flow/Net2Packet.h"
@@ -67,6 +69,9 @@ Future<Void> g_currentDeliveryPeerDisconnect;
 } // namespace
 
 constexpr int PACKET_LEN_WIDTH = sizeof(uint32_t);
+// Set in a packet's length when its body (token and message) is a zstd frame. Only sent to peers whose ConnectPacket
+// had FLAG_COMPRESSION.
+constexpr uint32_t PACKET_COMPRESSED_FLAG = 1u << 31;
 const uint64_t TOKEN_STREAM_FLAG = 1;
 
 FDB_BOOLEAN_PARAM(InReadSocket);
@@ -270,6 +275,26 @@ struct UnauthorizedEndpointReceiver final : NetworkMessageReceiver {
 	bool isPublic() const override { return true; }
 };
 
+struct CancelRequestReceiver final : NetworkMessageReceiver {
+	explicit CancelRequestReceiver(std::unordered_map<UID, Promise<Void>>& cancellableRequests)
+	  : cancellableRequests(cancellableRequests) {}
+
+	void receive(ArenaObjectReader& reader) override {
+		// Remote machine no longer wants the reply to token
+		UID token;
+		reader.deserialize(token);
+		auto it = cancellableRequests.find(token);
+		if (it != cancellableRequests.end()) {
+			Promise<Void> cancelled = it->second;
+			cancellableRequests.erase(it);
+			cancelled.send(Void());
+		}
+	}
+	bool isPublic() const override { return true; }
+
+	std::unordered_map<UID, Promise<Void>>& cancellableRequests;
+};
+
 // NetworkAddressCachedString retains a cached Standalone<StringRef> of
 // a NetworkAddressList.address.toString() value. This cached value is useful
 // for features in the hot path (i.e. Tracing), which need the String formatted value
@@ -307,6 +332,7 @@ public:
 		bytesSent.init("Net2.BytesSent"_sr);
 		countPacketsReceived.init("Net2.CountPacketsReceived"_sr);
 		countPacketsGenerated.init("Net2.CountPacketsGenerated"_sr);
+		bytesSavedByCompression.init("Net2.BytesSavedByCompression"_sr);
 		countConnEstablished.init("Net2.CountConnEstablished"_sr);
 		countConnClosedWithError.init("Net2.CountConnClosedWithError"_sr);
 		countConnClosedWithoutError.init("Net2.CountConnClosedWithoutError"_sr);
@@ -314,6 +340,8 @@ public:
 
 	Reference<struct Peer> getPeer(NetworkAddress const& address);
 	Reference<struct Peer> getOrOpenPeer(NetworkAddress const& address, bool startConnectionKeeper = true);
+	Reference<struct Peer> getPeerForEndpoint(Endpoint const& destination, bool openConnection);
+	int stripeOf(Endpoint const& destination) const;
 
 	// Returns true if given network address 'address' is one of the address we are listening on.
 	bool isLocalAddress(const NetworkAddress& address) const;
@@ -322,6 +350,8 @@ public:
 	NetworkAddressCachedString localAddresses;
 	std::vector<Future<Void>> listeners;
 	std::unordered_map<NetworkAddress, Reference<struct Peer>> peers;
+	// Stripes 1 and up of each peer's connections, indexed by stripe - 1. Only clients use these.
+	std::unordered_map<NetworkAddress, std::vector<Reference<struct Peer>>> peerStripes;
 	std::unordered_map<NetworkAddress, std::pair<double, double>> closedPeers;
 	HealthMonitor healthMonitor;
 	std::set<NetworkAddress> orderedAddresses;
@@ -331,10 +361,14 @@ public:
 	EndpointNotFoundReceiver endpointNotFoundReceiver{ endpoints };
 	PingReceiver pingReceiver{ endpoints };
 	UnauthorizedEndpointReceiver unauthorizedEndpointReceiver{ endpoints };
+	// Reply tokens of requests being served here that the requester can cancel, see FlowTransport::onRequestCancelled
+	std::unordered_map<UID, Promise<Void>> cancellableRequests;
+	CancelRequestReceiver cancelRequestReceiver{ cancellableRequests };
 
 	Int64MetricHandle bytesSent;
 	Int64MetricHandle countPacketsReceived;
 	Int64MetricHandle countPacketsGenerated;
+	Int64MetricHandle bytesSavedByCompression;
 	Int64MetricHandle countConnEstablished;
 	Int64MetricHandle countConnClosedWithError;
 	Int64MetricHandle countConnClosedWithoutError;
@@ -418,6 +452,10 @@ TransportData::TransportData(uint64_t transportId, int maxWellKnownEndpoints, IP
     allowList(allowList == nullptr ? IPAllowList() : *allowList) {
 	degraded = makeReference<AsyncVar<bool>>(false);
 	pingLogger = pingLatencyLogger(this);
+	if (maxWellKnownEndpoints > WLTOKEN_CANCEL_REQUEST) {
+		endpoints.insertWellKnown(
+		    &cancelRequestReceiver, Endpoint::wellKnownToken(WLTOKEN_CANCEL_REQUEST), TaskPriority::ReadSocket);
+	}
 }
 
 #define CONNECT_PACKET_V0 0x0FDB00A444020001LL
@@ -437,7 +475,8 @@ struct ConnectPacket {
 	// IP Address to reconnect to the originating process. Only one of these must be populated.
 	uint32_t canonicalRemoteIp4 = 0;
 
-	enum ConnectPacketFlags { FLAG_IPV6 = 1 };
+	// FLAG_COMPRESSION means the sender accepts compressed packets. Older versions ignore it and never set it.
+	enum ConnectPacketFlags { FLAG_IPV6 = 1, FLAG_COMPRESSION = 2 };
 	uint16_t flags = 0;
 	uint8_t canonicalRemoteIp6[16] = { 0 };
 
@@ -504,6 +543,8 @@ static ReliablePacket* sendPacket(TransportData* self,
 
 ACTOR Future<Void> connectionMonitor(Reference<Peer> peer) {
 	state Endpoint remotePingEndpoint({ peer->destination }, Endpoint::wellKnownToken(WLTOKEN_PING_PACKET));
+	state int64_t lastPingBytes = peer->bytesReceived;
+	state int skippedPings = 0;
 	loop {
 		if (!FlowTransport::isClient() && !peer->destination.isPublic() && peer->compatible) {
 			// Don't send ping messages to clients unless necessary. Instead monitor incoming client pings.
@@ -530,7 +571,7 @@ ACTOR Future<Void> connectionMonitor(Reference<Peer> peer) {
 		// cancelled.
 		wait(delay(0, TaskPriority::ReadSocket));
 
-		if (peer->reliable.empty() && peer->unsent.empty() && peer->outstandingReplies == 0) {
+		if (peer->reliable.empty() && !peer->hasUnsent() && peer->outstandingReplies == 0) {
 			if (peer->peerReferences == 0 &&
 			    (peer->lastDataPacketSentTime < now() - FLOW_KNOBS->CONNECTION_MONITOR_UNREFERENCED_CLOSE_DELAY)) {
 				// TODO: What about when peerReference == -1?
@@ -545,9 +586,19 @@ ACTOR Future<Void> connectionMonitor(Reference<Peer> peer) {
 
 		wait(delayJittered(FLOW_KNOBS->CONNECTION_MONITOR_LOOP_TIME, TaskPriority::ReadSocket));
 
+		// Anything received from the peer since the last ping already shows that it is alive, so most pings to a busy
+		// peer are skipped. Every CONNECTION_MONITOR_ACTIVE_PING_INTERVAL'th is still sent to keep sampling latency.
+		if (peer->bytesReceived > lastPingBytes &&
+		    ++skippedPings < FLOW_KNOBS->CONNECTION_MONITOR_ACTIVE_PING_INTERVAL) {
+			lastPingBytes = peer->bytesReceived;
+			continue;
+		}
+		skippedPings = 0;
+
 		// TODO: Stop monitoring and close the connection with no onDisconnect requests outstanding
+		// Ping over this connection in particular, which may be one of several stripes to the destination
 		state PingRequest pingRequest;
-		FlowTransport::transport().sendUnreliable(SerializeSource<PingRequest>(pingRequest), remotePingEndpoint, true);
+		sendPacket(peer->transport, peer, SerializeSource<PingRequest>(pingRequest), remotePingEndpoint, false);
 		state int64_t startingBytes = peer->bytesReceived;
 		state int timeouts = 0;
 		state double startTime = now();
@@ -582,6 +633,8 @@ ACTOR Future<Void> connectionMonitor(Reference<Peer> peer) {
 				}
 			}
 		}
+		// Don't count the ping reply as traffic from the peer
+		lastPingBytes = peer->bytesReceived;
 	}
 }
 
@@ -599,15 +652,37 @@ ACTOR Future<Void> connectionWriter(Reference<Peer> self, Reference<IConnection>
 		loop {
 			lastWriteTime = now();
 
-			int sent = conn->write(self->unsent.getUnsent(), /* limit= */ FLOW_KNOBS->MAX_PACKET_SEND_BYTES);
-			if (sent) {
-				self->bytesSent += sent;
-				self->transport->bytesSent += sent;
-				self->unsent.sent(sent);
-			}
+			// A bulk packet is only started when nothing else is waiting, but once started it must be finished
+			if (self->writingBulk()) {
+				int packetRemaining = self->bulkPackets.front().first - self->bulkPacketBytesSent;
+				int limit = std::min(packetRemaining, FLOW_KNOBS->MAX_PACKET_SEND_BYTES);
+				int sent = conn->write(self->bulkUnsent.getUnsent(), limit);
+				if (sent) {
+					self->bytesSent += sent;
+					self->transport->bytesSent += sent;
+					self->bulkSent(sent);
+				}
+				if (!self->hasUnsent()) {
+					break;
+				}
+				if (sent == packetRemaining) {
+					// Check for other packets between bulk packets, rather than waiting for the connection
+					continue;
+				}
+			} else {
+				int sent = conn->write(self->unsent.getUnsent(), /* limit= */ FLOW_KNOBS->MAX_PACKET_SEND_BYTES);
+				if (sent) {
+					self->bytesSent += sent;
+					self->transport->bytesSent += sent;
+					self->unsent.sent(sent);
+				}
 
-			if (self->unsent.empty()) {
-				break;
+				if (!self->hasUnsent()) {
+					break;
+				}
+				if (self->unsent.empty()) {
+					continue;
+				}
 			}
 
 			CODE_PROBE(
@@ -617,7 +692,7 @@ ACTOR Future<Void> connectionWriter(Reference<Peer> self, Reference<IConnection>
 		}
 
 		// Wait until there is something to send
-		while (self->unsent.empty())
+		while (!self->hasUnsent())
 			wait(self->dataToSend.onTrigger());
 	}
 }
@@ -664,7 +739,7 @@ ACTOR Future<Void> connectionKeeper(Reference<Peer> self,
 			if (!conn) { // Always, except for the first loop with an incoming connection
 				self->outgoingConnectionIdle = true;
 				// Wait until there is something to send.
-				while (self->unsent.empty()) {
+				while (!self->hasUnsent()) {
 					// Override waiting, if we are in failed state to update failure monitoring status.
 					Future<Void> retryConnectF = Never();
 					if (retryConnect) {
@@ -703,10 +778,10 @@ ACTOR Future<Void> connectionKeeper(Reference<Peer> self,
 							conn = _conn;
 							wait(conn->connectHandshake());
 							self->connectLatencies.addSample(now() - self->lastConnectTime);
-							if (FlowTransport::isClient()) {
+							if (FlowTransport::isClient() && self->stripe == 0) {
 								IFailureMonitor::failureMonitor().setStatus(self->destination, FailureStatus(false));
 							}
-							if (self->unsent.empty()) {
+							if (!self->hasUnsent() && self->stripe == 0) {
 								delayedHealthUpdateF =
 								    delayedHealthUpdate(self->destination, &tooManyConnectionsClosed);
 								choose {
@@ -749,7 +824,7 @@ ACTOR Future<Void> connectionKeeper(Reference<Peer> self,
 			firstConnFailedTime.reset();
 			try {
 				self->transport->countConnEstablished++;
-				if (!delayedHealthUpdateF.isValid())
+				if (!delayedHealthUpdateF.isValid() && self->stripe == 0)
 					delayedHealthUpdateF = delayedHealthUpdate(self->destination, &tooManyConnectionsClosed);
 				self->connected = true;
 				wait(connectionWriter(self, conn) || reader || connectionMonitor(self) ||
@@ -791,8 +866,10 @@ ACTOR Future<Void> connectionKeeper(Reference<Peer> self,
 
 			// Don't immediately mark connection as failed. To stay closed to earlier behaviour of centralized
 			// failure monitoring, wait until connection stays failed for FLOW_KNOBS->FAILURE_DETECTION_DELAY timeout.
+			// Only the first of a client's connections to an address decides whether the address has failed; the
+			// others fail just the requests sent over them, through their disconnect promise.
 			retryConnect = true;
-			if (e.code() == error_code_connection_failed) {
+			if (e.code() == error_code_connection_failed && self->stripe == 0) {
 				if (!self->destination.isPublic()) {
 					// Can't connect back to non-public addresses.
 					IFailureMonitor::failureMonitor().setStatus(self->destination, FailureStatus(true));
@@ -839,7 +916,7 @@ ACTOR Future<Void> connectionKeeper(Reference<Peer> self,
 			}
 
 			if (conn) {
-				if (self->destination.isPublic() && e.code() == error_code_connection_failed) {
+				if (self->destination.isPublic() && e.code() == error_code_connection_failed && self->stripe == 0) {
 					FlowTransport::transport().healthMonitor()->reportPeerClosed(self->destination);
 					if (FLOW_KNOBS->HEALTH_MONITOR_MARK_FAILED_UNSTABLE_CONNECTIONS &&
 					    FlowTransport::transport().healthMonitor()->tooManyConnectionsClosed(self->destination) &&
@@ -866,7 +943,9 @@ ACTOR Future<Void> connectionKeeper(Reference<Peer> self,
 			}
 
 			// Clients might send more packets in response, which needs to go out on the next connection
-			IFailureMonitor::failureMonitor().notifyDisconnect(self->destination);
+			if (self->stripe == 0) {
+				IFailureMonitor::failureMonitor().notifyDisconnect(self->destination);
+			}
 			Promise<Void> disconnect = self->disconnect;
 			self->disconnect = Promise<Void>();
 			disconnect.send(Void());
@@ -875,10 +954,21 @@ ACTOR Future<Void> connectionKeeper(Reference<Peer> self,
 				throw;
 			// Try to recover, even from serious errors, by retrying
 
-			if (self->peerReferences <= 0 && self->reliable.empty() && self->unsent.empty() &&
+			if (self->peerReferences <= 0 && self->reliable.empty() && !self->hasUnsent() &&
 			    self->outstandingReplies == 0) {
 				TraceEvent("PeerDestroy").errorUnsuppressed(e).suppressFor(1.0).detail("PeerAddr", self->destination);
 				self->connect.cancel();
+				if (self->stripe) {
+					auto stripes = self->transport->peerStripes.find(self->destination);
+					if (stripes != self->transport->peerStripes.end()) {
+						auto& v = stripes->second;
+						v[self->stripe - 1] = Reference<Peer>();
+						if (std::none_of(v.begin(), v.end(), [](auto& p) { return p.isValid(); })) {
+							self->transport->peerStripes.erase(stripes);
+						}
+					}
+					return Void();
+				}
 				self->transport->peers.erase(self->destination);
 				self->transport->orderedAddresses.erase(self->destination);
 				return Void();
@@ -887,16 +977,19 @@ ACTOR Future<Void> connectionKeeper(Reference<Peer> self,
 	}
 }
 
-Peer::Peer(TransportData* transport, NetworkAddress const& destination)
-  : transport(transport), destination(destination), compatible(true), connected(false), outgoingConnectionIdle(true),
-    lastConnectTime(0.0), reconnectionDelay(FLOW_KNOBS->INITIAL_RECONNECTION_TIME), peerReferences(-1),
-    bytesReceived(0), bytesSent(0), lastDataPacketSentTime(now()), outstandingReplies(0),
+Peer::Peer(TransportData* transport, NetworkAddress const& destination, int stripe)
+  : transport(transport), destination(destination), stripe(stripe), bulkPacketBytesSent(0), compatible(true),
+    compressPackets(false), connected(false),
+    outgoingConnectionIdle(true), lastConnectTime(0.0), reconnectionDelay(FLOW_KNOBS->INITIAL_RECONNECTION_TIME),
+    peerReferences(-1), bytesReceived(0), bytesSent(0), lastDataPacketSentTime(now()), outstandingReplies(0),
     pingLatencies(destination.isPublic() ? FLOW_KNOBS->PING_SKETCH_ACCURACY : 0.1), lastLoggedTime(0.0),
     lastLoggedBytesReceived(0), lastLoggedBytesSent(0), timeoutCount(0),
     protocolVersion(Reference<AsyncVar<Optional<ProtocolVersion>>>(new AsyncVar<Optional<ProtocolVersion>>())),
     connectOutgoingCount(0), connectIncomingCount(0), connectFailedCount(0),
     connectLatencies(destination.isPublic() ? FLOW_KNOBS->PING_SKETCH_ACCURACY : 0.1) {
-	IFailureMonitor::failureMonitor().setStatus(destination, FailureStatus(false));
+	if (stripe == 0) {
+		IFailureMonitor::failureMonitor().setStatus(destination, FailureStatus(false));
+	}
 }
 
 void Peer::send(PacketBuffer* pb, ReliablePacket* rp, bool firstUnsent) {
@@ -907,6 +1000,29 @@ void Peer::send(PacketBuffer* pb, ReliablePacket* rp, bool firstUnsent) {
 		dataToSend.trigger();
 }
 
+void Peer::sendBulk(PacketBuffer* pb, int packetSize, UID const& token, bool firstUnsent) {
+	bulkUnsent.setWriteBuffer(pb);
+	bulkPackets.emplace_back(packetSize, token);
+	++bulkTokens[token];
+	if (firstUnsent)
+		dataToSend.trigger();
+}
+
+void Peer::bulkSent(int bytes) {
+	bulkUnsent.sent(bytes);
+	bulkPacketBytesSent += bytes;
+	auto const& [packetSize, token] = bulkPackets.front();
+	ASSERT(bulkPacketBytesSent <= packetSize);
+	if (bulkPacketBytesSent == packetSize) {
+		auto t = bulkTokens.find(token);
+		if (--t->second == 0) {
+			bulkTokens.erase(t);
+		}
+		bulkPackets.pop_front();
+		bulkPacketBytesSent = 0;
+	}
+}
+
 void Peer::prependConnectPacket() {
 	// Send the ConnectPacket expected at the beginning of a new connection
 	ConnectPacket pkt;
@@ -921,6 +1037,9 @@ void Peer::prependConnectPacket() {
 		pkt.canonicalRemotePort = 0;
 		pkt.setCanonicalRemoteIp(IPAddress(0));
 	}
+	if (CompressionUtils::supportedFilters.count(CompressionFilter::ZSTD)) {
+		pkt.flags |= ConnectPacket::FLAG_COMPRESSION;
+	}
 
 	pkt.connectPacketLength = sizeof(pkt) - sizeof(pkt.connectPacketLength);
 	pkt.protocolVersion = g_network->protocolVersion();
@@ -947,6 +1066,12 @@ void Peer::discardUnreliablePackets() {
 	// Throw away the current unsent list, dropping the reference count on each PacketBuffer that accounts for presence
 	// in the unsent list
 	unsent.discardAll();
+	bulkUnsent.discardAll();
+	bulkPackets.clear();
+	bulkPacketBytesSent = 0;
+	bulkTokens.clear();
+	// Until the next connection tells us otherwise
+	compressPackets = false;
 
 	// If there are reliable packets, compact reliable packets into a new unsent range
 	if (!reliable.empty()) {
@@ -1002,6 +1127,13 @@ TransportData::~TransportData() {
 	for (auto& p : peers) {
 		p.second->connect.cancel();
 	}
+	for (auto& p : peerStripes) {
+		for (auto& stripe : p.second) {
+			if (stripe) {
+				stripe->connect.cancel();
+			}
+		}
+	}
 }
 
 static bool checkCompatible(const PeerCompatibilityPolicy& policy, ProtocolVersion version) {
@@ -1016,28 +1148,14 @@ static bool checkCompatible(const PeerCompatibilityPolicy& policy, ProtocolVersi
 	}
 }
 
-// This actor looks up the task associated with an endpoint
-// and sends the message to it. The actual deserialization will
-// be done by that task (see NetworkMessageReceiver).
-ACTOR static void deliver(TransportData* self,
-                          Endpoint destination,
-                          TaskPriority priority,
-                          ArenaReader reader,
-                          NetworkAddress peerAddress,
-                          bool isTrustedPeer,
-                          InReadSocket inReadSocket,
-                          Future<Void> disconnect) {
-	// We want to run the task at the right priority. If the priority is higher than the current priority (which is
-	// ReadSocket) we can just upgrade. Otherwise we'll context switch so that we don't block other tasks that might run
-	// with a higher priority. ReplyPromiseStream needs to guarantee that messages are received in the order they were
-	// sent, so we are using orderedDelay.
-	// NOTE: don't skip delay(0) when it's local deliver since it could cause out of order object deconstruction.
-	if (priority < TaskPriority::ReadSocket || !inReadSocket) {
-		wait(orderedDelay(0, priority));
-	} else {
-		g_network->setCurrentTask(priority);
-	}
-
+// Looks up the receiver of a message that is due now and hands it over. The actual deserialization will be done by
+// the receiver (see NetworkMessageReceiver).
+static void deliverMessage(TransportData* self,
+                           Endpoint const& destination,
+                           ArenaReader& reader,
+                           NetworkAddress const& peerAddress,
+                           bool isTrustedPeer,
+                           Future<Void> const& disconnect) {
 	auto receiver = self->endpoints.get(destination.token);
 	if (receiver && (isTrustedPeer || receiver->isPublic())) {
 		if (!checkCompatible(receiver->peerCompatibilityPolicy(), reader.protocolVersion())) {
@@ -1102,6 +1220,107 @@ ACTOR static void deliver(TransportData* self,
 	}
 }
 
+// This actor looks up the task associated with an endpoint
+// and sends the message to it. The actual deserialization will
+// be done by that task (see NetworkMessageReceiver).
+ACTOR static void deliver(TransportData* self,
+                          Endpoint destination,
+                          TaskPriority priority,
+                          ArenaReader reader,
+                          NetworkAddress peerAddress,
+                          bool isTrustedPeer,
+                          InReadSocket inReadSocket,
+                          Future<Void> disconnect) {
+	// We want to run the task at the right priority. If the priority is higher than the current priority (which is
+	// ReadSocket) we can just upgrade. Otherwise we'll context switch so that we don't block other tasks that might run
+	// with a higher priority. ReplyPromiseStream needs to guarantee that messages are received in the order they were
+	// sent, so we are using orderedDelay.
+	// NOTE: don't skip delay(0) when it's local deliver since it could cause out of order object deconstruction.
+	if (priority < TaskPriority::ReadSocket || !inReadSocket) {
+		wait(orderedDelay(0, priority));
+	} else {
+		g_network->setCurrentTask(priority);
+	}
+
+	deliverMessage(self, destination, reader, peerAddress, isTrustedPeer, disconnect);
+}
+
+// Like deliver(), for a run of packets to the same low priority endpoint that arrived together, so that they are
+// delivered in one task instead of one each. The receiver is looked up again for every packet, since an earlier one
+// may remove it.
+ACTOR static void deliverBatch(TransportData* self,
+                               Endpoint destination,
+                               TaskPriority priority,
+                               std::vector<ArenaReader> readers,
+                               NetworkAddress peerAddress,
+                               bool isTrustedPeer,
+                               Future<Void> disconnect) {
+	wait(orderedDelay(0, priority));
+	for (auto& reader : readers) {
+		g_network->setCurrentTask(priority);
+		deliverMessage(self, destination, reader, peerAddress, isTrustedPeer, disconnect);
+	}
+}
+
+// Collects consecutive packets for the same endpoint that scanPackets() finds below ReadSocket priority, and starts a
+// single deliverBatch() for them. Packets for any other endpoint end the run first, so the order in which packets are
+// delivered is unchanged.
+class PacketRun : NonCopyable {
+public:
+	PacketRun(TransportData* self, NetworkAddress const& peerAddress, bool isTrustedPeer, Future<Void> const& disconnect)
+	  : self(self), peerAddress(peerAddress), isTrustedPeer(isTrustedPeer), disconnect(disconnect),
+	    priority(TaskPriority::UnknownEndpoint) {}
+	~PacketRun() { flush(); }
+
+	// Returns false, after ending the current run, if the packet can't join it and must be delivered by itself
+	bool add(UID const& token, TaskPriority packetPriority, ArenaReader& reader) {
+		if (!readers.empty() && (token != this->token || packetPriority != priority)) {
+			flush();
+		}
+		if (packetPriority >= TaskPriority::ReadSocket || packetPriority == TaskPriority::UnknownEndpoint) {
+			return false;
+		}
+		this->token = token;
+		priority = packetPriority;
+		readers.push_back(std::move(reader));
+		return true;
+	}
+
+	void flush() {
+		if (readers.empty()) {
+			return;
+		}
+		if (readers.size() == 1) {
+			deliver(self,
+			        Endpoint({ peerAddress }, token),
+			        priority,
+			        std::move(readers[0]),
+			        peerAddress,
+			        isTrustedPeer,
+			        InReadSocket::True,
+			        disconnect);
+		} else {
+			deliverBatch(self,
+			             Endpoint({ peerAddress }, token),
+			             priority,
+			             std::move(readers),
+			             peerAddress,
+			             isTrustedPeer,
+			             disconnect);
+		}
+		readers.clear();
+	}
+
+private:
+	TransportData* self;
+	NetworkAddress peerAddress;
+	bool isTrustedPeer;
+	Future<Void> disconnect;
+	UID token;
+	TaskPriority priority;
+	std::vector<ArenaReader> readers;
+};
+
 static void scanPackets(TransportData* transport,
                         uint8_t*& unprocessed_begin,
                         const uint8_t* e,
@@ -1117,6 +1336,7 @@ static void scanPackets(TransportData* transport,
 	uint8_t* p = unprocessed_begin;
 
 	const bool checksumEnabled = !peerAddress.isTLS();
+	PacketRun run(transport, peerAddress, isTrustedPeer, disconnect);
 	loop {
 		uint32_t packetLen;
 		XXH64_hash_t packetChecksum;
@@ -1126,6 +1346,8 @@ static void scanPackets(TransportData* transport,
 			break;
 		packetLen = *(uint32_t*)p;
 		p += PACKET_LEN_WIDTH;
+		const bool compressed = packetLen & PACKET_COMPRESSED_FLAG;
+		packetLen &= ~PACKET_COMPRESSED_FLAG;
 
 		// Read checksum if present
 		if (checksumEnabled) {
@@ -1210,7 +1432,13 @@ static void scanPackets(TransportData* transport,
 #endif
 		// remove object serializer flag to account for flat buffer
 		peerProtocolVersion.removeObjectSerializerFlag();
-		ArenaReader reader(arena, StringRef(p, packetLen), AssumeVersion(peerProtocolVersion));
+		StringRef packet(p, packetLen);
+		Arena packetArena = arena;
+		if (compressed) {
+			packetArena = Arena();
+			packet = CompressionUtils::decompress(CompressionFilter::ZSTD, packet, packetArena);
+		}
+		ArenaReader reader(packetArena, packet, AssumeVersion(peerProtocolVersion));
 		UID token;
 		reader >> token;
 
@@ -1232,7 +1460,8 @@ static void scanPackets(TransportData* transport,
 		// It would be slightly more elegant/readable to put this if-block into the deliver actor, but if
 		// we have many messages to UnknownEndpoint we want to optimize earlier. As deliver is an actor it
 		// will allocate some state on the heap and this prevents it from doing that.
-		if (priority != TaskPriority::UnknownEndpoint || (token.first() & TOKEN_STREAM_FLAG) != 0) {
+		if (!run.add(token, priority, reader) &&
+		    (priority != TaskPriority::UnknownEndpoint || (token.first() & TOKEN_STREAM_FLAG) != 0)) {
 			deliver(transport,
 			        Endpoint({ peerAddress }, token),
 			        priority,
@@ -1402,6 +1631,8 @@ ACTOR static Future<Void> connectionReader(TransportData* transport,
 							    .suppressFor(1.0)
 							    .detail("PeerAddr", NetworkAddress(pkt.canonicalRemoteIp(), pkt.canonicalRemotePort));
 							peer->compatible = compatible;
+							peer->compressPackets = (pkt.flags & ConnectPacket::FLAG_COMPRESSION) &&
+							                        FLOW_KNOBS->PACKET_COMPRESSION_THRESHOLD > 0;
 							if (!compatible) {
 								peer->transport->numIncompatibleConnections++;
 								incompatiblePeerCounted = true;
@@ -1419,6 +1650,8 @@ ACTOR static Future<Void> connectionReader(TransportData* transport,
 							}
 							peer = transport->getOrOpenPeer(peerAddress, false);
 							peer->compatible = compatible;
+							peer->compressPackets = (pkt.flags & ConnectPacket::FLAG_COMPRESSION) &&
+							                        FLOW_KNOBS->PACKET_COMPRESSION_THRESHOLD > 0;
 							if (!compatible) {
 								peer->transport->numIncompatibleConnections++;
 								incompatiblePeerCounted = true;
@@ -1553,6 +1786,50 @@ Reference<Peer> TransportData::getOrOpenPeer(NetworkAddress const& address, bool
 	return peer;
 }
 
+// A client can spread its messages to a peer over FLOW_KNOBS->PEER_CONNECTION_STRIPES connections, so that one large
+// reply does not hold up the small ones queued behind it. Each endpoint always uses the same connection, which keeps its
+// messages in order. Well known endpoints stay on the first connection.
+int TransportData::stripeOf(Endpoint const& destination) const {
+	int stripes = FLOW_KNOBS->PEER_CONNECTION_STRIPES;
+	if (stripes <= 1 || !FlowTransport::isClient() || destination.token.first() == -1 ||
+	    !destination.getPrimaryAddress().isPublic()) {
+		return 0;
+	}
+	uint64_t h = destination.token.first() ^ (destination.token.second() * 0x9e3779b97f4a7c15ULL);
+	return (h >> 32) % stripes;
+}
+
+Reference<Peer> TransportData::getPeerForEndpoint(Endpoint const& destination, bool openConnection) {
+	NetworkAddress const& address = destination.getPrimaryAddress();
+	int stripe = stripeOf(destination);
+	if (stripe == 0) {
+		return openConnection ? getOrOpenPeer(address) : getPeer(address);
+	}
+
+	// The first connection does the peer's failure monitoring and bookkeeping, so it must exist whenever a stripe does
+	Reference<Peer> primary = openConnection ? getOrOpenPeer(address) : getPeer(address);
+	if (!primary) {
+		return primary;
+	}
+	if (!openConnection) {
+		auto stripes = peerStripes.find(address);
+		if (stripes == peerStripes.end() || stripes->second.size() < size_t(stripe)) {
+			return Reference<Peer>();
+		}
+		return stripes->second[stripe - 1];
+	}
+	auto& stripes = peerStripes[address];
+	if (stripes.size() < size_t(stripe)) {
+		stripes.resize(stripe);
+	}
+	Reference<Peer>& peer = stripes[stripe - 1];
+	if (!peer) {
+		peer = makeReference<Peer>(this, address, stripe);
+		peer->connect = connectionKeeper(peer);
+	}
+	return peer;
+}
+
 bool TransportData::isLocalAddress(const NetworkAddress& address) const {
 	return address == localAddresses.getAddressList().address ||
 	       (localAddresses.getAddressList().secondaryAddress.present() &&
@@ -1713,7 +1990,7 @@ void FlowTransport::removePeerReference(const Endpoint& endpoint, bool isStream)
 			    .detail("Address", endpoint.getPrimaryAddress())
 			    .detail("Token", endpoint.token);
 		}
-		if (peer->peerReferences == 0 && peer->reliable.empty() && peer->unsent.empty() &&
+		if (peer->peerReferences == 0 && peer->reliable.empty() && !peer->hasUnsent() &&
 		    peer->outstandingReplies == 0 &&
 		    peer->lastDataPacketSentTime < now() - FLOW_KNOBS->CONNECTION_MONITOR_UNREFERENCED_CLOSE_DELAY) {
 			peer->resetPing.trigger();
@@ -1773,6 +2050,51 @@ static void sendLocal(TransportData* self, ISerializeSource const& what, const E
 	}
 }
 
+// Replaces the body of the packet that starts at offset begin of first, and runs to the end of its chain, with a zstd
+// frame if that is smaller. Returns the new last buffer of the chain, or nullptr if the packet was left as it was.
+static PacketBuffer* compressPacket(TransportData* self,
+                                    PacketBuffer* first,
+                                    int begin,
+                                    int packetInfoSize,
+                                    uint32_t& len,
+                                    SplitBuffer& packetInfoBuffer) {
+	Standalone<StringRef> body = makeString(len);
+	uint8_t* out = mutateString(body);
+	PacketBuffer* pb = first;
+	int offset = begin + packetInfoSize;
+	for (uint32_t copied = 0; copied < len;) {
+		while (offset >= pb->bytes_written) {
+			offset -= pb->bytes_written;
+			pb = pb->nextPacketBuffer();
+		}
+		int n = std::min<uint32_t>(len - copied, pb->bytes_written - offset);
+		memcpy(out + copied, pb->data() + offset, n);
+		copied += n;
+		offset += n;
+	}
+
+	Arena arena;
+	StringRef compressed = CompressionUtils::compress(CompressionFilter::ZSTD, body, arena);
+	if (compressed.size() >= len || compressed.size() < sizeof(UID)) {
+		return nullptr;
+	}
+
+	// Nothing else refers to the buffers this packet added, so they can be dropped and the packet rewritten in place
+	for (PacketBuffer* next = first->nextPacketBuffer(); next;) {
+		PacketBuffer* n = next->nextPacketBuffer();
+		next->delref();
+		next = n;
+	}
+	first->next = nullptr;
+	first->bytes_written = begin;
+	PacketWriter wr(first, nullptr, Unversioned());
+	wr.writeAhead(packetInfoSize, &packetInfoBuffer);
+	wr.serializeBytes(compressed);
+	self->bytesSavedByCompression += len - compressed.size();
+	len = compressed.size();
+	return wr.finish();
+}
+
 static ReliablePacket* sendPacket(TransportData* self,
                                   Reference<Peer> peer,
                                   ISerializeSource const& what,
@@ -1788,9 +2110,13 @@ static ReliablePacket* sendPacket(TransportData* self,
 		return nullptr;
 	}
 
-	bool firstUnsent = peer->unsent.empty();
+	bool firstUnsent = !peer->hasUnsent();
 
-	PacketBuffer* pb = peer->unsent.getWriteBuffer();
+	// Replies from low priority work go in their own lane, so that a large one can't delay everything behind it
+	const bool bulk =
+	    !reliable && peer->useBulkLane(destination.token,
+	                                   g_network->getCurrentTask() < TaskPriority(FLOW_KNOBS->PEER_BULK_LANE_PRIORITY));
+	PacketBuffer* pb = (bulk ? peer->bulkUnsent : peer->unsent).getWriteBuffer();
 	ReliablePacket* rp = reliable ? new ReliablePacket : 0;
 
 	int prevBytesWritten = pb->bytes_written;
@@ -1822,6 +2148,17 @@ static ReliablePacket* sendPacket(TransportData* self,
 	pb = wr.finish();
 	len = wr.size() - packetInfoSize;
 
+	// Only unreliable packets, because reliable ones may be resent on a later connection that can't decompress them
+	uint32_t compressedFlag = 0;
+	if (!reliable && peer->compressPackets && len >= FLOW_KNOBS->PACKET_COMPRESSION_THRESHOLD) {
+		PacketBuffer* last =
+		    compressPacket(self, checksumPb, prevBytesWritten, packetInfoSize, len, packetInfoBuffer);
+		if (last) {
+			pb = last;
+			compressedFlag = PACKET_COMPRESSED_FLAG;
+		}
+	}
+
 	if (checksumEnabled) {
 		// Find the correct place to start calculating checksum
 		uint32_t checksumUnprocessedLength = len;
@@ -1870,7 +2207,8 @@ static ReliablePacket* sendPacket(TransportData* self,
 	}
 
 	// Write packet length and checksum into packet buffer
-	packetInfoBuffer.write(&len, sizeof(len));
+	uint32_t lenAndFlags = len | compressedFlag;
+	packetInfoBuffer.write(&lenAndFlags, sizeof(lenAndFlags));
 	if (checksumEnabled) {
 		packetInfoBuffer.write(&checksum, sizeof(checksum), sizeof(len));
 	}
@@ -1899,7 +2237,11 @@ static ReliablePacket* sendPacket(TransportData* self,
 	}
 #endif
 
-	peer->send(pb, rp, firstUnsent);
+	if (bulk) {
+		peer->sendBulk(pb, packetInfoSize + len, destination.token, firstUnsent);
+	} else {
+		peer->send(pb, rp, firstUnsent);
+	}
 	if (destination.token != Endpoint::wellKnownToken(WLTOKEN_PING_PACKET)) {
 		peer->lastDataPacketSentTime = now();
 	}
@@ -1911,7 +2253,7 @@ ReliablePacket* FlowTransport::sendReliable(ISerializeSource const& what, const
 		sendLocal(self, what, destination);
 		return nullptr;
 	}
-	Reference<Peer> peer = self->getOrOpenPeer(destination.getPrimaryAddress());
+	Reference<Peer> peer = self->getPeerForEndpoint(destination, true);
 	return sendPacket(self, peer, what, destination, true);
 }
 
@@ -1929,17 +2271,38 @@ Reference<Peer> FlowTransport::sendUnreliable(ISerializeSource const& what,
 		sendLocal(self, what, destination);
 		return Reference<Peer>();
 	}
-	Reference<Peer> peer;
-	if (openConnection) {
-		peer = self->getOrOpenPeer(destination.getPrimaryAddress());
-	} else {
-		peer = self->getPeer(destination.getPrimaryAddress());
-	}
-
+	Reference<Peer> peer = self->getPeerForEndpoint(destination, openConnection);
 	sendPacket(self, peer, what, destination, false);
 	return peer;
 }
 
+void FlowTransport::cancelRequest(Reference<Peer> peer, UID replyToken) {
+	if (!peer || !FLOW_KNOBS->CANCEL_ABANDONED_REQUESTS) {
+		return;
+	}
+	sendPacket(self,
+	           peer,
+	           SerializeSource<UID>(replyToken),
+	           Endpoint::wellKnown(NetworkAddressList{ peer->destination }, WLTOKEN_CANCEL_REQUEST),
+	           false);
+}
+
+ACTOR static Future<Void> requestCancelled(TransportData* self, UID replyToken) {
+	state Promise<Void> cancelled;
+	self->cancellableRequests[replyToken] = cancelled;
+	try {
+		wait(cancelled.getFuture());
+		return Void();
+	} catch (Error& e) {
+		self->cancellableRequests.erase(replyToken);
+		throw e;
+	}
+}
+
+Future<Void> FlowTransport::onRequestCancelled(UID replyToken) {
+	return requestCancelled(self, replyToken);
+}
+
 Reference<AsyncVar<bool>> FlowTransport::getDegraded() {
 	return self->degraded;
 }
@@ -1965,6 +2328,14 @@ void FlowTransport::resetConnection(NetworkAddress address) {
 	if (peer) {
 		peer->resetConnection.trigger();
 	}
+	auto stripes = self->peerStripes.find(address);
+	if (stripes != self->peerStripes.end()) {
+		for (auto& stripe : stripes->second) {
+			if (stripe) {
+				stripe->resetConnection.trigger();
+			}
+		}
+	}
 }
 
 bool FlowTransport::incompatibleOutgoingConnectionsPresent() {
@@ -2074,3 +2445,70 @@ ACTOR static Future<Void> watchPublicKeyJwksFile(std::string filePath, Transport
 void FlowTransport::watchPublicKeyFile(const std::string& publicKeyFilePath) {
 	self->publicKeyFileWatch = watchPublicKeyJwksFile(publicKeyFilePath, self);
 }
+
+// Sends packets to a few endpoints from tasks of mixed priority, and checks that each endpoint's packets are written to
+// the connection in the order they were sent
+TEST_CASE("/fdbrpc/FlowTransport/BulkLaneOrder") {
+	Reference<Peer> peer = makeReference<Peer>(nullptr, NetworkAddress(), 1);
+	std::vector<UID> tokens;
+	for (int i = 0; i < 3; ++i) {
+		tokens.push_back(deterministicRandom()->randomUniqueID());
+	}
+	std::vector<uint32_t> sentCount(tokens.size(), 0);
+	std::vector<uint8_t> wire;
+
+	auto sendOne = [&]() {
+		uint32_t t = deterministicRandom()->randomInt(0, tokens.size());
+		bool firstUnsent = !peer->hasUnsent();
+		bool bulk = peer->useBulkLane(tokens[t], deterministicRandom()->coinflip());
+		PacketBuffer* pb = (bulk ? peer->bulkUnsent : peer->unsent).getWriteBuffer();
+		PacketWriter wr(pb, nullptr, Unversioned());
+		wr << t << sentCount[t]++;
+		pb = wr.finish();
+		if (bulk) {
+			peer->sendBulk(pb, 2 * sizeof(uint32_t), tokens[t], firstUnsent);
+		} else {
+			peer->send(pb, nullptr, firstUnsent);
+		}
+	};
+
+	// Writes a few bytes the way connectionWriter chooses them
+	auto writeSome = [&]() {
+		bool bulk = peer->writingBulk();
+		PacketBuffer* pb = (bulk ? peer->bulkUnsent : peer->unsent).getUnsent();
+		int n = std::min(pb->bytes_unsent(), deterministicRandom()->randomInt(1, 20));
+		if (bulk) {
+			n = std::min(n, peer->bulkPackets.front().first - peer->bulkPacketBytesSent);
+		}
+		wire.insert(wire.end(), pb->data() + pb->bytes_sent, pb->data() + pb->bytes_sent + n);
+		if (bulk) {
+			peer->bulkSent(n);
+		} else {
+			peer->unsent.sent(n);
+		}
+	};
+
+	for (int i = 0; i < 1000; ++i) {
+		if (peer->hasUnsent() && deterministicRandom()->coinflip()) {
+			writeSome();
+		} else {
+			sendOne();
+		}
+	}
+	while (peer->hasUnsent()) {
+		writeSome();
+	}
+	ASSERT(peer->bulkTokens.empty());
+
+	std::vector<uint32_t> receivedCount(tokens.size(), 0);
+	ASSERT(wire.size() % (2 * sizeof(uint32_t)) == 0);
+	for (int offset = 0; offset < wire.size(); offset += 2 * sizeof(uint32_t)) {
+		uint32_t t, seq;
+		memcpy(&t, &wire[offset], sizeof(uint32_t));
+		memcpy(&seq, &wire[offset + sizeof(uint32_t)], sizeof(uint32_t));
+		ASSERT(t < tokens.size());
+		ASSERT(seq == receivedCount[t]++);
+	}
+	ASSERT(receivedCount == sentCount);
+	return Void();
+}
@@ -37,6 +37,7 @@
 #include "fdbrpc/AsyncFileEncrypted.h"
 #include "fdbrpc/AsyncFileWinASIO.actor.h"
 #include "fdbrpc/AsyncFileKAIO.actor.h"
+#include "fdbrpc/AsyncFileIOUring.actor.h"
 #include "flow/AsioReactor.h"
 #include "flow/Platform.h"
 #include "fdbrpc/AsyncFileWriteChecker.h"
@@ -68,9 +69,14 @@ Future<Reference<class IAsyncFile>> Net2FileSystem::open(const std::string& file
 	// of Kernel AIO. And EIO_USE_ODIRECT can be used to turn on or off O_DIRECT within
 	// EIO.
 	if ((flags & IAsyncFile::OPEN_UNBUFFERED) && !(flags & IAsyncFile::OPEN_NO_AIO) &&
-	    !FLOW_KNOBS->DISABLE_POSIX_KERNEL_AIO)
-		f = AsyncFileKAIO::open(filename, flags, mode, nullptr);
-	else
+	    !FLOW_KNOBS->DISABLE_POSIX_KERNEL_AIO) {
+#ifdef WITH_LIBURING
+		if (AsyncFileIOUring::isInitialized())
+			f = AsyncFileIOUring::open(filename, flags, mode, nullptr);
+		else
+#endif
+			f = AsyncFileKAIO::open(filename, flags, mode, nullptr);
+	} else
 #endif
 		f = Net2AsyncFile::open(
 		    filename,
@@ -113,8 +119,15 @@ void Net2FileSystem::newFileSystem(double ioTimeout, const std::string& fileSyst
 Net2FileSystem::Net2FileSystem(double ioTimeout, const std::string& fileSystemPath) {
 	Net2AsyncFile::init();
 #ifdef __linux__
-	if (!FLOW_KNOBS->DISABLE_POSIX_KERNEL_AIO)
-		AsyncFileKAIO::init(Reference<IEventFD>(N2::ASIOReactor::getEventFD()), ioTimeout);
+	// io_uring and KAIO share the network's eventfd and run cycle hook, so only one of them is ever initialized
+	if (!FLOW_KNOBS->DISABLE_POSIX_KERNEL_AIO) {
+#ifdef WITH_LIBURING
+		if (FLOW_KNOBS->ENABLE_IO_URING)
+			AsyncFileIOUring::init(Reference<IEventFD>(N2::ASIOReactor::getEventFD()), ioTimeout);
+		else
+#endif
+			AsyncFileKAIO::init(Reference<IEventFD>(N2::ASIOReactor::getEventFD()), ioTimeout);
+	}
 
 	if (fileSystemPath.empty()) {
 		checkFileSystem = false;
@@ -20,6 +20,7 @@
 
 #include "fdbrpc/QueueModel.h"
 #include "fdbrpc/LoadBalance.h"
+#include "flow/UnitTest.h"
 
 void QueueModel::endRequest(uint64_t id, double latency, double penalty, double delta, bool clean, bool futureVersion) {
 	auto& d = data[id];
@@ -29,6 +30,7 @@ void QueueModel::endRequest(uint64_t id, double latency, double penalty, double
 
 	if (clean) {
 		d.latency = latency;
+		d.updateLatencyEstimates(latency);
 	} else {
 		d.latency = std::max(d.latency, latency);
 	}
@@ -50,6 +52,14 @@ void QueueModel::endRequest(uint64_t id, double latency, double penalty, double
 	}
 }
 
+void QueueData::updateLatencyEstimates(double sample) {
+	double rate = FLOW_KNOBS->LOAD_BALANCE_LATENCY_SMOOTHING;
+	smoothLatency += rate * (sample - smoothLatency);
+	// Frugal streaming quantile estimate: it settles where 5% of samples move it up by 0.95 * rate and 95% move it
+	// down by 0.05 * rate, and because the steps are relative it tracks latencies of any scale
+	latencyP95 *= sample > latencyP95 ? 1.0 + 0.95 * rate : 1.0 - 0.05 * rate;
+}
+
 QueueData const& QueueModel::getMeasurement(uint64_t id) {
 	return data[id]; // return smoothed penalty
 }
@@ -90,6 +100,21 @@ Optional<BasicLoadBalancedReply> getBasicLoadBalancedReply(const void*) {
 	return Optional<BasicLoadBalancedReply>();
 }
 
+TEST_CASE("/fdbrpc/QueueModel/LatencyEstimates") {
+	// Latencies uniform in [1ms, 3ms), with one in ten a 10x outlier: the 95th percentile is in the outliers
+	QueueData qd;
+	for (int i = 0; i < 100000; i++) {
+		double sample = 0.001 + 0.002 * deterministicRandom()->random01();
+		if (deterministicRandom()->random01() < 0.1) {
+			sample *= 10;
+		}
+		qd.updateLatencyEstimates(sample);
+	}
+	ASSERT(qd.smoothLatency > 0.001 && qd.smoothLatency < 0.03);
+	ASSERT(qd.latencyP95 > 0.01 && qd.latencyP95 < 0.03);
+	return Void();
+}
+
 /*
 void QueueModel::addMeasurement( uint64_t id, QueueDetails qd ){
     if (data[new_index].count(id))
@@ -90,12 +90,17 @@ void Counter::clear() {
 }
 
 void CounterCollection::logToTraceEvent(TraceEvent& te) {
-	NetworkAddress addr = g_network->getLocalAddress();
+	// Looked up once per collection rather than once per counter, since this runs on the network thread for every
+	// collection at every logging interval
+	MetricCollection* metrics = MetricCollection::getMetricCollection();
+	std::string ip_str, port_str;
+	if (metrics != nullptr) {
+		NetworkAddress addr = g_network->getLocalAddress();
+		ip_str = addr.ip.toString();
+		port_str = std::to_string(addr.port);
+	}
 	for (ICounter* c : counters) {
-		MetricCollection* metrics = MetricCollection::getMetricCollection();
 		if (metrics != nullptr) {
-			std::string ip_str = addr.ip.toString();
-			std::string port_str = std::to_string(addr.port);
 			uint64_t val = c->getValue();
 			switch (c->model) {
 			case MetricsDataModel::OTLP: {
@@ -42,36 +42,40 @@ namespace bi = boost::intrusive;
 struct EvictablePage {
 	void* data;
 	int index;
+	bool referenced; // Set on a hit, and cleared as the CLOCK hand passes the page
 	class Reference<struct EvictablePageCache> pageCache;
 	bi::list_member_hook<> member_hook;
 
 	virtual bool evict() = 0; // true if page was evicted, false if it isn't immediately evictable (but will be evicted
 	                          // regardless if possible)
 
-	EvictablePage(Reference<EvictablePageCache> pageCache) : data(0), index(-1), pageCache(pageCache) {}
+	EvictablePage(Reference<EvictablePageCache> pageCache)
+	  : data(0), index(-1), referenced(false), pageCache(pageCache) {}
 	virtual ~EvictablePage();
 };
 
 struct EvictablePageCache : ReferenceCounted<EvictablePageCache> {
 	using List =
 	    bi::list<EvictablePage, bi::member_hook<EvictablePage, bi::list_member_hook<>, &EvictablePage::member_hook>>;
-	enum CacheEvictionType { RANDOM = 0, LRU = 1 };
+	enum CacheEvictionType { RANDOM = 0, LRU = 1, CLOCK = 2 };
 
 	static CacheEvictionType evictionPolicyStringToEnum(const std::string& policy) {
 		std::string cep = policy;
 		std::transform(cep.begin(), cep.end(), cep.begin(), ::tolower);
-		if (cep != "random" && cep != "lru")
+		if (cep != "random" && cep != "lru" && cep != "clock")
 			throw invalid_cache_eviction_policy();
 
 		if (cep == "random")
 			return RANDOM;
+		if (cep == "clock")
+			return CLOCK;
 		return LRU;
 	}
 
-	EvictablePageCache() : pageSize(0), maxPages(0), cacheEvictionType(RANDOM) {}
+	EvictablePageCache() : pageSize(0), maxPages(0), clockHand(0), cacheEvictionType(RANDOM) {}
 
 	explicit EvictablePageCache(int pageSize, int64_t maxSize)
-	  : pageSize(pageSize), maxPages(maxSize / pageSize),
+	  : pageSize(pageSize), maxPages(maxSize / pageSize), clockHand(0),
 	    cacheEvictionType(evictionPolicyStringToEnum(FLOW_KNOBS->CACHE_EVICTION_POLICY)) {
 		cacheEvictions.init("EvictablePageCache.CacheEvictions"_sr);
 	}
@@ -82,7 +86,7 @@ struct EvictablePageCache : ReferenceCounted<EvictablePageCache> {
 
 		page->data = allocateFast4kAligned(pageSize);
 
-		if (RANDOM == cacheEvictionType) {
+		if (LRU != cacheEvictionType) {
 			page->index = pages.size();
 			pages.push_back(page);
 		} else {
@@ -91,7 +95,9 @@ struct EvictablePageCache : ReferenceCounted<EvictablePageCache> {
 	}
 
 	void updateHit(EvictablePage* page) {
-		if (RANDOM != cacheEvictionType) {
+		if (CLOCK == cacheEvictionType) {
+			page->referenced = true;
+		} else if (LRU == cacheEvictionType) {
 			// on a hit, update page's location in the LRU so that it's most recent (tail)
 			lruPages.erase(List::s_iterator_to(*page));
 			lruPages.push_back(*page);
@@ -110,8 +116,30 @@ struct EvictablePageCache : ReferenceCounted<EvictablePageCache> {
 					}
 				}
 			}
+		} else if (CLOCK == cacheEvictionType) {
+			if (pages.size() >= (uint64_t)maxPages && !pages.empty()) {
+				// Sweep the hand, giving each referenced page a second chance. After one revolution every reference
+				// bit is clear, which bounds the sweep.
+				int attempts = 0;
+				for (size_t swept = 0; swept <= pages.size() && attempts < FLOW_KNOBS->MAX_EVICT_ATTEMPTS; ++swept) {
+					if (clockHand >= pages.size()) {
+						clockHand = 0;
+					}
+					EvictablePage* page = pages[clockHand];
+					if (page->referenced) {
+						page->referenced = false;
+					} else {
+						++attempts;
+						// An evicted page's slot is refilled with the last page, which the hand then looks at next
+						if (page->evict()) {
+							++cacheEvictions;
+							break;
+						}
+					}
+					++clockHand;
+				}
+			}
 		} else {
-			// For now, LRU is the only other CACHE_EVICTION option
 			if (lruPages.size() >= (uint64_t)maxPages) {
 				int i = 0;
 				// try the least recently used pages first (starting at head of the LRU list)
@@ -126,8 +154,9 @@ struct EvictablePageCache : ReferenceCounted<EvictablePageCache> {
 		}
 	}
 
-	std::vector<EvictablePage*> pages;
+	std::vector<EvictablePage*> pages; // RANDOM and CLOCK
 	List lruPages;
+	size_t clockHand;
 	int pageSize;
 	int64_t maxPages;
 	Int64MetricHandle cacheEvictions;
@@ -0,0 +1,692 @@
+/*
+ * AsyncFileIOUring.actor.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#if defined(__linux__) && defined(WITH_LIBURING)
+
+// When actually compiled (NO_INTELLISENSE), include the generated version of this file.  In intellisense use the source
+// version.
+#if defined(NO_INTELLISENSE) && !defined(FLOW_ASYNCFILEIOURING_ACTOR_G_H)
+#define FLOW_ASYNCFILEIOURING_ACTOR_G_H
+#include "fdbrpc/AsyncFileIOUring.actor.g.h"
+#elif !defined(FLOW_ASYNCFILEIOURING_ACTOR_H)
+#define FLOW_ASYNCFILEIOURING_ACTOR_H
+
+#include "flow/IAsyncFile.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <liburing.h>
+#include "flow/Knobs.h"
+#include "fdbrpc/Stats.h"
+#include "fdbrpc/AsyncFileEIO.actor.h"
+#include "flow/UnitTest.h"
+#include "flow/genericactors.actor.h"
+#include "flow/actorcompiler.h" // This must be the last #include.
+
+// An unbuffered file backed by a single io_uring shared by every file in the process. It follows the structure of
+// AsyncFileKAIO: operations are queued by priority and submitted in one batch per run loop cycle by launch(), and
+// completions are signalled through the network's eventfd and collected by poll().
+//
+// Each file's descriptor is installed in the ring's fixed file table when a slot is free, which saves the kernel a
+// file table lookup and reference count per operation. sync() is an IORING_OP_FSYNC submitted with IOSQE_IO_DRAIN, so
+// it is ordered after every write previously submitted to the ring instead of racing them on a thread pool.
+class AsyncFileIOUring final : public IAsyncFile, public ReferenceCounted<AsyncFileIOUring> {
+public:
+	struct AsyncFileIOUringMetrics {
+		LatencySample readLatencySample = { "AsyncFileIOUringReadLatency",
+			                                UID(),
+			                                FLOW_KNOBS->KAIO_LATENCY_LOGGING_INTERVAL,
+			                                FLOW_KNOBS->KAIO_LATENCY_SKETCH_ACCURACY };
+		LatencySample writeLatencySample = { "AsyncFileIOUringWriteLatency",
+			                                 UID(),
+			                                 FLOW_KNOBS->KAIO_LATENCY_LOGGING_INTERVAL,
+			                                 FLOW_KNOBS->KAIO_LATENCY_SKETCH_ACCURACY };
+		LatencySample syncLatencySample = { "AsyncFileIOUringSyncLatency",
+			                                UID(),
+			                                FLOW_KNOBS->KAIO_LATENCY_LOGGING_INTERVAL,
+			                                FLOW_KNOBS->KAIO_LATENCY_SKETCH_ACCURACY };
+	};
+
+	static AsyncFileIOUringMetrics& getMetrics() {
+		static AsyncFileIOUringMetrics metrics;
+		return metrics;
+	}
+
+	static bool isInitialized() { return ctx.initialized; }
+
+	static Future<Reference<IAsyncFile>> open(std::string filename, int flags, int mode, void* ignore) {
+		ASSERT(ctx.initialized);
+		ASSERT(flags & OPEN_UNBUFFERED);
+
+		if (flags & OPEN_LOCK)
+			mode |= 02000; // Enable mandatory locking for this file if it is supported by the filesystem
+
+		std::string open_filename = filename;
+		if (flags & OPEN_ATOMIC_WRITE_AND_CREATE) {
+			ASSERT((flags & OPEN_CREATE) && (flags & OPEN_READWRITE) && !(flags & OPEN_EXCLUSIVE));
+			open_filename = filename + ".part";
+		}
+
+		int fd = ::open(open_filename.c_str(), openFlags(flags), mode);
+		if (fd < 0) {
+			Error e = errno == ENOENT ? file_not_found() : io_error();
+			TraceEvent("AsyncFileIOUringOpenFailed")
+			    .error(e)
+			    .detail("Filename", filename)
+			    .detailf("Flags", "%x", flags)
+			    .detailf("OSFlags", "%x", openFlags(flags))
+			    .detailf("Mode", "0%o", mode)
+			    .GetLastError();
+			return e;
+		}
+
+		Reference<AsyncFileIOUring> r(new AsyncFileIOUring(fd, flags, filename));
+
+		if (flags & OPEN_LOCK) {
+			// Acquire a "write" lock for the entire file
+			flock lockDesc;
+			lockDesc.l_type = F_WRLCK;
+			lockDesc.l_whence = SEEK_SET;
+			lockDesc.l_start = 0;
+			lockDesc.l_len = 0;
+			lockDesc.l_pid = 0;
+			if (fcntl(fd, F_SETLK, &lockDesc) == -1) {
+				TraceEvent(SevWarn, "UnableToLockFile").detail("Filename", filename).GetLastError();
+				return lock_file_failure();
+			}
+		}
+
+		struct stat buf;
+		if (fstat(fd, &buf)) {
+			TraceEvent("AsyncFileIOUringFStatError").detail("Fd", fd).detail("Filename", filename).GetLastError();
+			return io_error();
+		}
+
+		r->lastFileSize = r->nextFileSize = buf.st_size;
+		TraceEvent("AsyncFileIOUringOpen")
+		    .detail("Filename", filename)
+		    .detail("Flags", flags)
+		    .detail("Mode", mode)
+		    .detail("Fd", fd)
+		    .detail("FixedFileSlot", r->fixedSlot);
+		return Reference<IAsyncFile>(std::move(r));
+	}
+
+	static void init(Reference<IEventFD> ev, double ioTimeout) {
+		ASSERT(!ctx.initialized);
+		if (!g_network->isSimulated()) {
+			ctx.countSubmit.init("AsyncFile.CountIOUringSubmit"_sr);
+			ctx.countCollect.init("AsyncFile.CountIOUringCollect"_sr);
+			ctx.countFixedFileMiss.init("AsyncFile.CountIOUringFixedFileMiss"_sr);
+			ctx.countPreSubmitTruncate.init("AsyncFile.CountPreIOUringSubmitTruncate"_sr);
+		}
+
+		int rc = io_uring_queue_init(FLOW_KNOBS->IO_URING_QUEUE_DEPTH, &ctx.ring, 0);
+		if (rc < 0) {
+			errno = -rc;
+			TraceEvent("IOUringSetupError").GetLastError();
+			throw io_error();
+		}
+
+		rc = io_uring_register_eventfd(&ctx.ring, ev->getFD());
+		if (rc < 0) {
+			errno = -rc;
+			TraceEvent("IOUringRegisterEventFDError").GetLastError();
+			throw io_error();
+		}
+
+		// Reserve an empty fixed file table which files are installed into as they are opened. Kernels which do not
+		// support sparse tables simply leave every file using its normal descriptor.
+		if (FLOW_KNOBS->IO_URING_FIXED_FILES > 0) {
+			std::vector<int> empty(FLOW_KNOBS->IO_URING_FIXED_FILES, -1);
+			rc = io_uring_register_files(&ctx.ring, empty.data(), empty.size());
+			if (rc == 0) {
+				for (int i = empty.size() - 1; i >= 0; --i) {
+					ctx.freeFixedSlots.push_back(i);
+				}
+			} else {
+				TraceEvent(SevWarn, "IOUringRegisterFilesUnsupported").detail("Error", -rc);
+			}
+		}
+
+		setTimeout(ioTimeout);
+		ctx.initialized = true;
+		poll(ev);
+
+		g_network->setGlobal(INetwork::enRunCycleFunc, (flowGlobalType)&AsyncFileIOUring::launch);
+	}
+
+	static void setTimeout(double ioTimeout) { ctx.setIOTimeout(ioTimeout); }
+
+	void addref() override { ReferenceCounted<AsyncFileIOUring>::addref(); }
+	void delref() override { ReferenceCounted<AsyncFileIOUring>::delref(); }
+
+	Future<int> read(void* data, int length, int64_t offset) override {
+		++countFileLogicalReads;
+		++countLogicalReads;
+
+		if (failed) {
+			return io_timeout();
+		}
+
+		IOBlock* io = new IOBlock(IORING_OP_READ, data, length, offset);
+		enqueue(io);
+		return io->result.getFuture();
+	}
+
+	Future<Void> write(void const* data, int length, int64_t offset) override {
+		++countFileLogicalWrites;
+		++countLogicalWrites;
+
+		if (failed) {
+			return io_timeout();
+		}
+
+		IOBlock* io = new IOBlock(IORING_OP_WRITE, (void*)data, length, offset);
+		nextFileSize = std::max(nextFileSize, offset + length);
+		enqueue(io);
+		return success(io->result.getFuture());
+	}
+
+#ifndef FALLOC_FL_ZERO_RANGE
+#define FALLOC_FL_ZERO_RANGE 0x10
+#endif
+	Future<Void> zeroRange(int64_t offset, int64_t length) override {
+		bool success = false;
+		if (ctx.fallocateZeroSupported) {
+			int rc = fallocate(fd, FALLOC_FL_ZERO_RANGE, offset, length);
+			if (rc == EOPNOTSUPP) {
+				ctx.fallocateZeroSupported = false;
+			}
+			if (rc == 0) {
+				success = true;
+			}
+		}
+		return success ? Void() : IAsyncFile::zeroRange(offset, length);
+	}
+
+	Future<Void> truncate(int64_t size) override {
+		++countFileLogicalWrites;
+		++countLogicalWrites;
+
+		if (failed) {
+			return io_timeout();
+		}
+
+		int result = -1;
+		bool completed = false;
+		if (ctx.fallocateSupported && size >= lastFileSize) {
+			result = fallocate(fd, 0, 0, size);
+			if (result != 0) {
+				int fallocateErrCode = errno;
+				TraceEvent("AsyncFileIOUringAllocateError")
+				    .detail("Fd", fd)
+				    .detail("Filename", filename)
+				    .detail("Size", size)
+				    .GetLastError();
+				if (fallocateErrCode == EOPNOTSUPP) {
+					// Mark fallocate as unsupported. Try again with truncate.
+					ctx.fallocateSupported = false;
+				} else {
+					return io_error();
+				}
+			} else {
+				completed = true;
+			}
+		}
+		if (!completed)
+			result = ftruncate(fd, size);
+
+		if (result != 0) {
+			TraceEvent("AsyncFileIOUringTruncateError").detail("Fd", fd).detail("Filename", filename).GetLastError();
+			return io_error();
+		}
+
+		lastFileSize = nextFileSize = size;
+		return Void();
+	}
+
+	ACTOR static Future<Void> finishSync(Reference<AsyncFileIOUring> self, Future<int> fsync, double startTime) {
+		wait(success(fsync));
+		if (self->failed) {
+			throw io_timeout();
+		}
+		getMetrics().syncLatencySample.addMeasurement(timer() - startTime);
+		return Void();
+	}
+
+	Future<Void> sync() override {
+		++countFileLogicalWrites;
+		++countLogicalWrites;
+
+		if (failed) {
+			return io_timeout();
+		}
+
+		IOBlock* io = new IOBlock(IORING_OP_FSYNC, nullptr, 0, 0);
+		enqueue(io);
+		Future<Void> fsync = finishSync(Reference<AsyncFileIOUring>::addRef(this), io->result.getFuture(), timer());
+
+		if (flags & OPEN_ATOMIC_WRITE_AND_CREATE) {
+			flags &= ~OPEN_ATOMIC_WRITE_AND_CREATE;
+
+			return AsyncFileEIO::waitAndAtomicRename(fsync, filename + ".part", filename);
+		}
+
+		return fsync;
+	}
+
+	Future<int64_t> size() const override { return nextFileSize; }
+	int64_t debugFD() const override { return fd; }
+	std::string getFilename() const override { return filename; }
+
+	~AsyncFileIOUring() override {
+		// Every queued or in flight operation holds a reference to its file, so the slot is unused by now.
+		if (fixedSlot >= 0) {
+			int empty = -1;
+			io_uring_register_files_update(&ctx.ring, fixedSlot, &empty, 1);
+			ctx.freeFixedSlots.push_back(fixedSlot);
+		}
+		close(fd);
+	}
+
+	// Called once per run loop cycle. Moves as many queued operations as the ring allows into submission queue
+	// entries and hands them all to the kernel with a single io_uring_submit().
+	static void launch() {
+		if ((ctx.queue.empty() && !io_uring_sq_ready(&ctx.ring)) || ctx.outstanding >= FLOW_KNOBS->IO_URING_QUEUE_DEPTH - FLOW_KNOBS->MIN_SUBMIT) {
+			return;
+		}
+
+		double begin = timer_monotonic();
+		if (!ctx.outstanding)
+			ctx.ioStallBegin = begin;
+
+		double start = timer();
+		int n = 0;
+		while (!ctx.queue.empty() && ctx.outstanding + n < FLOW_KNOBS->IO_URING_QUEUE_DEPTH) {
+			io_uring_sqe* sqe = io_uring_get_sqe(&ctx.ring);
+			if (sqe == nullptr) {
+				break;
+			}
+
+			IOBlock* io = ctx.queue.top();
+			ctx.queue.pop();
+			io->startTime = start;
+
+			if (ctx.ioTimeout > 0) {
+				ctx.appendToRequestList(io);
+			}
+
+			AsyncFileIOUring* owner = io->owner.getPtr();
+			if (owner->lastFileSize != owner->nextFileSize) {
+				++ctx.countPreSubmitTruncate;
+				owner->truncate(owner->nextFileSize);
+			}
+
+			int target = owner->fixedSlot >= 0 ? owner->fixedSlot : owner->fd;
+			switch (io->opcode) {
+			case IORING_OP_READ:
+				io_uring_prep_read(sqe, target, io->buf, io->nbytes, io->offset);
+				break;
+			case IORING_OP_WRITE:
+				io_uring_prep_write(sqe, target, io->buf, io->nbytes, io->offset);
+				break;
+			case IORING_OP_FSYNC:
+				io_uring_prep_fsync(sqe, target, IORING_FSYNC_DATASYNC);
+				break;
+			default:
+				UNREACHABLE();
+			}
+
+			unsigned sqeFlags = owner->fixedSlot >= 0 ? IOSQE_FIXED_FILE : 0;
+			if (io->opcode == IORING_OP_FSYNC) {
+				sqeFlags |= IOSQE_IO_DRAIN;
+			}
+			io_uring_sqe_set_flags(sqe, sqeFlags);
+			io_uring_sqe_set_data(sqe, io);
+			++n;
+		}
+
+		int rc = io_uring_submit(&ctx.ring);
+		double end = timer_monotonic();
+		++ctx.countSubmit;
+
+		double elapsed = end - begin;
+		g_network->networkInfo.metrics.secSquaredSubmit += elapsed * elapsed / 2;
+		if (elapsed > FLOW_KNOBS->SLOW_LOOP_CUTOFF && nondeterministicRandom()->random01() < elapsed) {
+			TraceEvent("SlowIOUringLaunch").detail("SubmitTime", elapsed).detail("Submitted", n);
+		}
+
+		// Entries which were prepared but not consumed by the kernel stay in the submission ring and are picked up by
+		// the next io_uring_submit(), so they still count as outstanding.
+		if (rc < 0 && rc != -EAGAIN && rc != -EBUSY && rc != -EINTR) {
+			errno = -rc;
+			TraceEvent(SevError, "IOUringSubmitError").GetLastError();
+			throw io_error();
+		}
+		ctx.outstanding += n;
+	}
+
+	bool failed;
+
+private:
+	int fd, flags;
+	int fixedSlot;
+	int64_t lastFileSize, nextFileSize;
+	std::string filename;
+	Int64MetricHandle countFileLogicalWrites;
+	Int64MetricHandle countFileLogicalReads;
+
+	Int64MetricHandle countLogicalWrites;
+	Int64MetricHandle countLogicalReads;
+
+	struct IOBlock : FastAllocated<IOBlock> {
+		uint8_t opcode;
+		void* buf;
+		int nbytes;
+		int64_t offset;
+		Promise<int> result;
+		Reference<AsyncFileIOUring> owner;
+		int64_t prio;
+		IOBlock* prev;
+		IOBlock* next;
+		double startTime;
+
+		struct indirect_order_by_priority {
+			bool operator()(IOBlock* a, IOBlock* b) { return a->prio < b->prio; }
+		};
+
+		IOBlock(uint8_t opcode, void* buf, int nbytes, int64_t offset)
+		  : opcode(opcode), buf(buf), nbytes(nbytes), offset(offset), prev(nullptr), next(nullptr), startTime(0) {}
+
+		TaskPriority getTask() const { return static_cast<TaskPriority>((prio >> 32) + 1); }
+
+		ACTOR static void deliver(Promise<int> result, bool failed, int r, TaskPriority task) {
+			wait(delay(0, task));
+			if (failed)
+				result.sendError(io_timeout());
+			else if (r < 0)
+				result.sendError(io_error());
+			else
+				result.send(r);
+		}
+
+		void setResult(int r) {
+			if (r < 0) {
+				errno = -r;
+				TraceEvent("AsyncFileIOUringIOError")
+				    .GetLastError()
+				    .detail("Fd", owner->fd)
+				    .detail("Op", opcode)
+				    .detail("Nbytes", nbytes)
+				    .detail("Offset", offset)
+				    .detail("Ptr", int64_t(buf))
+				    .detail("Filename", owner->filename);
+			}
+			deliver(result, owner->failed, r, getTask());
+			delete this;
+		}
+
+		void timeout(bool warnOnly) {
+			TraceEvent(SevWarnAlways, "AsyncFileIOUringTimeout")
+			    .detail("Fd", owner->fd)
+			    .detail("Op", opcode)
+			    .detail("Nbytes", nbytes)
+			    .detail("Offset", offset)
+			    .detail("Ptr", int64_t(buf))
+			    .detail("Filename", owner->filename);
+			g_network->setGlobal(INetwork::enASIOTimedOut, (flowGlobalType) true);
+
+			if (!warnOnly)
+				owner->failed = true;
+		}
+	};
+
+	struct Context {
+		io_uring ring;
+		bool initialized;
+		int outstanding;
+		double ioStallBegin;
+		bool fallocateSupported;
+		bool fallocateZeroSupported;
+		std::priority_queue<IOBlock*, std::vector<IOBlock*>, IOBlock::indirect_order_by_priority> queue;
+		std::vector<int> freeFixedSlots;
+		Int64MetricHandle countSubmit;
+		Int64MetricHandle countCollect;
+		Int64MetricHandle countFixedFileMiss;
+		Int64MetricHandle countPreSubmitTruncate;
+
+		double ioTimeout;
+		bool timeoutWarnOnly;
+		IOBlock* submittedRequestList;
+
+		uint32_t opsIssued;
+		Context()
+		  : initialized(false), outstanding(0), ioStallBegin(0), fallocateSupported(true), fallocateZeroSupported(true),
+		    submittedRequestList(nullptr), opsIssued(0) {
+			setIOTimeout(0);
+		}
+
+		void setIOTimeout(double timeout) {
+			ioTimeout = fabs(timeout);
+			timeoutWarnOnly = timeout < 0;
+		}
+
+		void appendToRequestList(IOBlock* io) {
+			ASSERT(!io->next && !io->prev);
+
+			if (submittedRequestList) {
+				io->prev = submittedRequestList->prev;
+				io->prev->next = io;
+
+				submittedRequestList->prev = io;
+				io->next = submittedRequestList;
+			} else {
+				submittedRequestList = io;
+				io->next = io->prev = io;
+			}
+		}
+
+		void removeFromRequestList(IOBlock* io) {
+			if (io->next == nullptr) {
+				ASSERT(io->prev == nullptr);
+				return;
+			}
+
+			ASSERT(io->prev != nullptr);
+
+			if (io == io->next) {
+				ASSERT(io == submittedRequestList && io == io->prev);
+				submittedRequestList = nullptr;
+			} else {
+				io->next->prev = io->prev;
+				io->prev->next = io->next;
+
+				if (submittedRequestList == io) {
+					submittedRequestList = io->next;
+				}
+			}
+
+			io->next = io->prev = nullptr;
+		}
+	};
+	static Context ctx;
+
+	explicit AsyncFileIOUring(int fd, int flags, std::string const& filename)
+	  : failed(false), fd(fd), flags(flags), fixedSlot(-1), filename(filename) {
+		if (!g_network->isSimulated()) {
+			countFileLogicalWrites.init("AsyncFile.CountFileLogicalWrites"_sr, filename);
+			countFileLogicalReads.init("AsyncFile.CountFileLogicalReads"_sr, filename);
+			countLogicalWrites.init("AsyncFile.CountLogicalWrites"_sr);
+			countLogicalReads.init("AsyncFile.CountLogicalReads"_sr);
+		}
+
+		if (!ctx.freeFixedSlots.empty()) {
+			int slot = ctx.freeFixedSlots.back();
+			if (io_uring_register_files_update(&ctx.ring, slot, &this->fd, 1) == 1) {
+				ctx.freeFixedSlots.pop_back();
+				fixedSlot = slot;
+			}
+		} else {
+			++ctx.countFixedFileMiss;
+		}
+	}
+
+	void enqueue(IOBlock* io) {
+		ASSERT(int64_t(io->buf) % 4096 == 0 && io->offset % 4096 == 0 && io->nbytes % 4096 == 0);
+
+		io->prio = (int64_t(g_network->getCurrentTask()) << 32) - (++ctx.opsIssued);
+		io->owner = Reference<AsyncFileIOUring>::addRef(this);
+
+		ctx.queue.push(io);
+	}
+
+	static int openFlags(int flags) {
+		int oflags = O_DIRECT | O_CLOEXEC;
+		ASSERT(bool(flags & OPEN_READONLY) != bool(flags & OPEN_READWRITE)); // readonly xor readwrite
+		if (flags & OPEN_EXCLUSIVE)
+			oflags |= O_EXCL;
+		if (flags & OPEN_CREATE)
+			oflags |= O_CREAT;
+		if (flags & OPEN_READONLY)
+			oflags |= O_RDONLY;
+		if (flags & OPEN_READWRITE)
+			oflags |= O_RDWR;
+		if (flags & OPEN_ATOMIC_WRITE_AND_CREATE)
+			oflags |= O_TRUNC;
+		return oflags;
+	}
+
+	ACTOR static void poll(Reference<IEventFD> ev) {
+		loop {
+			wait(success(ev->read()));
+
+			wait(delay(0, TaskPriority::DiskIOComplete));
+
+			io_uring_cqe* cqes[FLOW_KNOBS->IO_URING_QUEUE_DEPTH];
+			double currentTime = timer();
+			++ctx.countCollect;
+
+			if (ctx.ioTimeout > 0) {
+				while (ctx.submittedRequestList && currentTime - ctx.submittedRequestList->startTime > ctx.ioTimeout) {
+					ctx.submittedRequestList->timeout(ctx.timeoutWarnOnly);
+					ctx.removeFromRequestList(ctx.submittedRequestList);
+				}
+			}
+
+			// One eventfd wakeup can cover more completions than fit in a batch, so drain the completion ring
+			int n;
+			do {
+				n = io_uring_peek_batch_cqe(&ctx.ring, cqes, FLOW_KNOBS->IO_URING_QUEUE_DEPTH);
+
+				if (n) {
+					double t = timer_monotonic();
+					double elapsed = t - ctx.ioStallBegin;
+					ctx.ioStallBegin = t;
+					g_network->networkInfo.metrics.secSquaredDiskStall += elapsed * elapsed / 2;
+				}
+
+				ctx.outstanding -= n;
+
+				for (int i = 0; i < n; i++) {
+					IOBlock* iob = static_cast<IOBlock*>(io_uring_cqe_get_data(cqes[i]));
+					int res = cqes[i]->res;
+
+					if (ctx.ioTimeout > 0) {
+						ctx.removeFromRequestList(iob);
+					}
+
+					switch (iob->opcode) {
+					case IORING_OP_READ:
+						getMetrics().readLatencySample.addMeasurement(currentTime - iob->startTime);
+						break;
+					case IORING_OP_WRITE:
+						getMetrics().writeLatencySample.addMeasurement(currentTime - iob->startTime);
+						break;
+					}
+
+					iob->setResult(res);
+				}
+				io_uring_cq_advance(&ctx.ring, n);
+			} while (n == FLOW_KNOBS->IO_URING_QUEUE_DEPTH);
+		}
+	}
+};
+
+TEST_CASE("/fdbrpc/AsyncFileIOUring/ReadWrite") {
+	// This test does nothing in simulation, or when the ring was not enabled by ENABLE_IO_URING
+	if (!g_network->isSimulated() && AsyncFileIOUring::isInitialized()) {
+		state Reference<IAsyncFile> f;
+		state int pageSize = 4096;
+		state int pages = 256;
+		state uint8_t* buf = (uint8_t*)aligned_alloc(pageSize, pageSize * pages);
+		state uint8_t* readBuf = (uint8_t*)aligned_alloc(pageSize, pageSize * pages);
+		try {
+			Reference<IAsyncFile> f_ =
+			    wait(AsyncFileIOUring::open("/tmp/__IOURING_TEST_FILE__",
+			                                IAsyncFile::OPEN_UNBUFFERED | IAsyncFile::OPEN_READWRITE |
+			                                    IAsyncFile::OPEN_CREATE,
+			                                0666,
+			                                nullptr));
+			f = f_;
+			wait(f->truncate(pageSize * pages));
+
+			// Many independent page writes are issued before any is waited on so they are submitted as a batch
+			state std::vector<Future<Void>> writes;
+			for (int i = 0; i < pages; ++i) {
+				memset(buf + i * pageSize, i, pageSize);
+				writes.push_back(f->write(buf + i * pageSize, pageSize, (int64_t)i * pageSize));
+			}
+			wait(waitForAll(writes));
+			wait(f->sync());
+
+			state std::vector<Future<int>> reads;
+			for (int i = 0; i < pages; ++i) {
+				reads.push_back(f->read(readBuf + i * pageSize, pageSize, (int64_t)i * pageSize));
+			}
+			wait(waitForAll(reads));
+			for (int i = 0; i < pages; ++i) {
+				ASSERT(reads[i].get() == pageSize);
+			}
+			ASSERT(memcmp(buf, readBuf, pageSize * pages) == 0);
+		} catch (Error& e) {
+			state Error err = e;
+			free(buf);
+			free(readBuf);
+			if (f) {
+				wait(AsyncFileEIO::deleteFile(f->getFilename(), true));
+			}
+			throw err;
+		}
+
+		free(buf);
+		free(readBuf);
+		wait(AsyncFileEIO::deleteFile(f->getFilename(), true));
+	}
+
+	return Void();
+}
+
+AsyncFileIOUring::Context AsyncFileIOUring::ctx;
+
+#include "flow/unactorcompiler.h"
+#endif
+#endif
@@ -23,6 +23,8 @@
 #pragma once
 
 #include <algorithm>
+#include <deque>
+#include <unordered_map>
 
 #include "fdbrpc/DDSketch.h"
 #include "fdbrpc/HealthMonitor.h"
@@ -146,13 +148,22 @@ class TransportData;
 struct Peer : public ReferenceCounted<Peer> {
 	TransportData* transport;
 	NetworkAddress destination;
+	int stripe; // Which of a client's connections to destination this is; only stripe 0 is in TransportData::peers
 	UnsentPacketQueue unsent;
+	// Unreliable packets sent by low priority tasks, such as fetchKeys replies. connectionWriter only sends these while
+	// unsent is empty, and switches back to unsent between whole packets.
+	UnsentPacketQueue bulkUnsent;
+	// Size on the wire and destination token of each packet in bulkUnsent, oldest first
+	std::deque<std::pair<int, UID>> bulkPackets;
+	int bulkPacketBytesSent; // Bytes of the packet at bulkPackets.front() already written to the connection
+	std::unordered_map<UID, int> bulkTokens; // Number of packets in bulkUnsent for each destination token
 	ReliablePacketList reliable;
-	AsyncTrigger dataToSend; // Triggered when unsent.empty() becomes false
+	AsyncTrigger dataToSend; // Triggered when hasUnsent() becomes true
 	Future<Void> connect;
 	AsyncTrigger resetPing;
 	AsyncTrigger resetConnection;
 	bool compatible;
+	bool compressPackets; // The remote end of the current connection accepts compressed packets
 	bool connected;
 	bool outgoingConnectionIdle; // We don't actually have a connection open and aren't trying to open one because we
 	                             // don't have anything to send
@@ -178,10 +189,24 @@ struct Peer : public ReferenceCounted<Peer> {
 	DDSketch<double> connectLatencies;
 	Promise<Void> disconnect;
 
-	explicit Peer(TransportData* transport, NetworkAddress const& destination);
+	explicit Peer(TransportData* transport, NetworkAddress const& destination, int stripe = 0);
+
+	bool hasUnsent() const { return !unsent.empty() || !bulkUnsent.empty(); }
 
 	void send(PacketBuffer* pb, ReliablePacket* rp, bool firstUnsent);
 
+	// Whether an unreliable packet to token goes in bulkUnsent. While any packet to the same token is still in
+	// bulkUnsent, the next one follows it there even from a high priority task, so an endpoint's packets stay in order.
+	bool useBulkLane(UID const& token, bool lowPriority) const { return lowPriority || bulkTokens.count(token); }
+
+	// Whether connectionWriter writes from bulkUnsent next
+	bool writingBulk() const { return bulkPacketBytesSent > 0 || (unsent.empty() && !bulkUnsent.empty()); }
+
+	void sendBulk(PacketBuffer* pb, int packetSize, UID const& token, bool firstUnsent);
+
+	// Call after writing bytes from bulkUnsent, which must not be more than the rest of the current packet
+	void bulkSent(int bytes);
+
 	void prependConnectPacket();
 
 	void discardUnreliablePackets();
@@ -272,6 +297,14 @@ public:
 	                               const Endpoint& destination,
 	                               bool openConnection); // { cancelReliable(sendReliable(what,destination)); }
 
+	// Tells the process at the other end of peer, which a request was sent to with sendUnreliable(), that its reply
+	// (replyToken) is no longer wanted, so that it can stop serving the request.
+	void cancelRequest(Reference<Peer> peer, UID replyToken);
+
+	// Returns a future that is set when the requester of the reply replyToken calls cancelRequest() for it. Dropping
+	// the future stops listening for the cancellation.
+	Future<Void> onRequestCancelled(UID replyToken);
+
 	bool incompatibleOutgoingConnectionsPresent();
 
 	// Returns the protocol version of the peer at the specified address. The result is returned as an AsyncVar that
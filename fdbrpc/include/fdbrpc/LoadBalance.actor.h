@@ -266,10 +266,11 @@ struct RequestData : NonCopyable {
 	                                     Reference<MultiInterface<Multi>> alternatives,
 	                                     RequestStream<Request, P> Interface::*channel) {
 		if (model) {
-			// Send parallel request to TSS pair, if it exists
+			// Send parallel request to TSS pair, if it exists and this request is sampled
 			Optional<TSSEndpointData> tssData = model->getTssData(stream->getEndpoint().token.first());
 
-			if (tssData.present()) {
+			if (tssData.present() && (FLOW_KNOBS->LOAD_BALANCE_TSS_SAMPLE_RATE >= 1.0 ||
+			                          deterministicRandom()->random01() < FLOW_KNOBS->LOAD_BALANCE_TSS_SAMPLE_RATE)) {
 				CODE_PROBE(true, "duplicating request to TSS");
 				resetReply(request);
 				// FIXME: optimize to avoid creating new netNotifiedQueue for each message
@@ -432,6 +433,55 @@ struct RequestData : NonCopyable {
 	}
 };
 
+// Power of two choices: picks two random usable alternatives, from the best locality if any are usable, and makes the
+// one with the lower smoothed latency times outstanding requests bestAlt and the other nextAlt. Returns when to send
+// a hedged request to nextAlt, which is once bestAlt's reply is later than its observed 95th percentile latency.
+template <class Interface, class Request, class Multi, bool P>
+Future<Void> powerOfTwoChoices(Reference<MultiInterface<Multi>> const& alternatives,
+                               RequestStream<Request, P> Interface::*channel,
+                               QueueModel* model,
+                               int& bestAlt,
+                               int& nextAlt) {
+	auto measurement = [&](int i) -> QueueData const& {
+		return model->getMeasurement(alternatives->get(i, channel).getEndpoint().token.first());
+	};
+	auto score = [&](int i) {
+		auto const& qd = measurement(i);
+		return qd.smoothLatency * (1.0 + qd.smoothOutstanding.smoothTotal());
+	};
+
+	std::vector<int> local, remote;
+	for (int i = 0; i < alternatives->size(); i++) {
+		if (!IFailureMonitor::failureMonitor().getState(alternatives->get(i, channel).getEndpoint()).failed &&
+		    now() > measurement(i).failedUntil) {
+			(i < alternatives->countBest() ? local : remote).push_back(i);
+		}
+	}
+	std::vector<int> const& pool = local.empty() ? remote : local;
+	if (pool.empty()) {
+		return Never();
+	}
+
+	if (pool.size() == 1) {
+		bestAlt = pool[0];
+		if (&pool == &remote || remote.empty()) {
+			return Never();
+		}
+		nextAlt = *std::min_element(remote.begin(), remote.end(), [&](int a, int b) { return score(a) < score(b); });
+	} else {
+		int a = deterministicRandom()->randomInt(0, pool.size());
+		int b = deterministicRandom()->randomInt(0, pool.size() - 1);
+		if (b >= a) {
+			b++;
+		}
+		bool aFirst = score(pool[a]) <= score(pool[b]);
+		bestAlt = aFirst ? pool[a] : pool[b];
+		nextAlt = aFirst ? pool[b] : pool[a];
+	}
+	double hedgeTime = model->secondMultiplier * measurement(bestAlt).latencyP95;
+	return delay(std::max(FLOW_KNOBS->BASE_SECOND_REQUEST_TIME, hedgeTime));
+}
+
 // Try to get a reply from one of the alternatives until success, cancellation, or certain errors.
 // Load balancing has a budget to race requests to a second alternative if the first request is slow.
 // Tries to take into account failMon's information for load balancing and avoiding failed servers.
@@ -471,7 +521,9 @@ Future<REPLY_TYPE(Request)> loadBalance(
 	if (nextAlt >= bestAlt)
 		nextAlt++;
 
-	if (model) {
+	if (model && FLOW_KNOBS->LOAD_BALANCE_POWER_OF_TWO_CHOICES) {
+		secondDelay = powerOfTwoChoices(alternatives, channel, model, bestAlt, nextAlt);
+	} else if (model) {
 		double bestMetric = 1e9; // Storage server with the least outstanding requests.
 		double nextMetric = 1e9;
 		double bestTime = 1e9; // The latency to the server with the least outstanding requests.
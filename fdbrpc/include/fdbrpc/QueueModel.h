@@ -50,6 +50,11 @@ struct QueueData {
 	// The last client perceived latency to this storage server.
 	double latency;
 
+	// Exponentially smoothed client perceived latency, and a running estimate of its 95th percentile. Both only count
+	// replies without errors.
+	double smoothLatency;
+	double latencyP95;
+
 	// Represents the "cost" of each storage request. By default, the penalty is
 	// 1 indicating that each outstanding request corresponds 1 outstanding
 	// request. However, storage server can also increase the penalty if it
@@ -75,8 +80,11 @@ struct QueueData {
 	Optional<TSSEndpointData> tssData;
 
 	QueueData()
-	  : smoothOutstanding(FLOW_KNOBS->QUEUE_MODEL_SMOOTHING_AMOUNT), latency(0.001), penalty(1.0), failedUntil(0),
+	  : smoothOutstanding(FLOW_KNOBS->QUEUE_MODEL_SMOOTHING_AMOUNT), latency(0.001), smoothLatency(0.001),
+	    latencyP95(0.001), penalty(1.0), failedUntil(0),
 	    futureVersionBackoff(FLOW_KNOBS->FUTURE_VERSION_INITIAL_BACKOFF), increaseBackoffTime(0) {}
+
+	void updateLatencyEstimates(double sample);
 };
 
 typedef double TimeEstimate;
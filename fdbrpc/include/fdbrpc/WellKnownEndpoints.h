@@ -50,7 +50,8 @@ enum WellKnownEndpoints {
 	WLTOKEN_CONFIGFOLLOWER_GETCOMMITTEDVERSION, // 22
 	WLTOKEN_PROCESS, // 23
 	WLTOKEN_CONFIGFOLLOWER_LOCK, // 24
-	WLTOKEN_RESERVED_COUNT // 25
+	WLTOKEN_CANCEL_REQUEST, // 25
+	WLTOKEN_RESERVED_COUNT // 26
 };
 
 static_assert(WLTOKEN_PROTOCOL_INFO ==
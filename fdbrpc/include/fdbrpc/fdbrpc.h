@@ -144,6 +144,8 @@ public:
 	}
 	bool isSet() const { return sav->isSet(); }
 	bool isValid() const { return sav != nullptr; }
+	// True if the promise was received from another process, so that its reply goes over the network
+	bool isRemoteEndpoint() const { return sav->isRemoteEndpoint(); }
 	ReplyPromise() : sav(new NetSAV<T>(0, 1)) {}
 	explicit ReplyPromise(const PeerCompatibilityPolicy& policy) : ReplyPromise() {
 		sav->setPeerCompatibilityPolicy(policy);
@@ -677,6 +679,17 @@ struct HasVerify_t<T, decltype(void(std::declval<T>().verify()), 0)> : std::true
 template <class T>
 constexpr bool HasVerify = HasVerify_t<T>::value;
 
+// Requests declaring `constexpr static bool cancellable = true` are cancelled on the server (see
+// FlowTransport::cancelRequest) when their tryGetReply() is abandoned
+template <class T, class = int>
+struct IsCancellable_t : std::false_type {};
+
+template <class T>
+struct IsCancellable_t<T, decltype((void)T::cancellable, 0)> : std::bool_constant<T::cancellable> {};
+
+template <class T>
+constexpr bool IsCancellable = IsCancellable_t<T>::value;
+
 template <class T, bool IsPublic>
 struct NetNotifiedQueue final : NotifiedQueue<T>, FlowReceiver, FastAllocated<NetNotifiedQueue<T, IsPublic>> {
 	using FastAllocated<NetNotifiedQueue<T, IsPublic>>::operator new;
@@ -786,7 +799,7 @@ public:
 			Reference<Peer> peer =
 			    FlowTransport::transport().sendUnreliable(SerializeSource<T>(value), getEndpoint(taskID), true);
 			auto& p = getReplyPromise(value);
-			return waitValueOrSignal(p.getFuture(), disc, getEndpoint(taskID), p, peer);
+			return waitValueOrSignal(p.getFuture(), disc, getEndpoint(taskID), p, peer, IsCancellable<T>);
 		}
 		send(value);
 		auto& p = getReplyPromise(value);
@@ -807,7 +820,7 @@ public:
 			Reference<Peer> peer =
 			    FlowTransport::transport().sendUnreliable(SerializeSource<T>(value), getEndpoint(), true);
 			auto& p = getReplyPromise(value);
-			return waitValueOrSignal(p.getFuture(), disc, getEndpoint(), p, peer);
+			return waitValueOrSignal(p.getFuture(), disc, getEndpoint(), p, peer, IsCancellable<T>);
 		} else {
 			send(value);
 			auto& p = getReplyPromise(value);
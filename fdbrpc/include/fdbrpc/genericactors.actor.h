@@ -364,7 +364,8 @@ Future<ErrorOr<X>> waitValueOrSignal(Future<X> value,
                                      Future<Void> signal,
                                      Endpoint endpoint,
                                      ReplyPromise<X> holdme = ReplyPromise<X>(),
-                                     Reference<Peer> peer = Reference<Peer>()) {
+                                     Reference<Peer> peer = Reference<Peer>(),
+                                     bool cancellable = false) {
 	state PeerHolder holder = PeerHolder(peer);
 	loop {
 		try {
@@ -377,6 +378,10 @@ Future<ErrorOr<X>> waitValueOrSignal(Future<X> value,
 					                      ? unauthorized_attempt()
 					                      : request_maybe_delivered());
 				}
+				// A client's extra connections to an address don't notify the failure monitor when they close
+				when(wait(peer.isValid() && peer->stripe ? peer->disconnect.getFuture() : Never())) {
+					return ErrorOr<X>(request_maybe_delivered());
+				}
 			}
 		} catch (Error& e) {
 			if (signal.isError()) {
@@ -384,8 +389,13 @@ Future<ErrorOr<X>> waitValueOrSignal(Future<X> value,
 				return ErrorOr<X>(internal_error());
 			}
 
-			if (e.code() == error_code_actor_cancelled)
+			if (e.code() == error_code_actor_cancelled) {
+				// The requester lost interest before the reply came, so let the server stop working on it
+				if (cancellable && peer && !holdme.isSet()) {
+					FlowTransport::transport().cancelRequest(peer, holdme.getEndpoint().token);
+				}
 				throw e;
+			}
 
 			// broken_promise error normally means an endpoint failure, which in tryGetReply has the same semantics as
 			// receiving the failure signal
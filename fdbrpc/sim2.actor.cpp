@@ -329,8 +329,8 @@ struct Sim2Conn final : IConnection, ReferenceCounted<Sim2Conn> {
 		int64_t avail = receivedBytes.get() - readBytes.get(); // SOMEDAY: random?
 		int toRead = std::min<int64_t>(end - begin, avail);
 		ASSERT(toRead >= 0 && toRead <= recvBuf.size() && toRead <= end - begin);
-		for (int i = 0; i < toRead; i++)
-			begin[i] = recvBuf[i];
+		// std::copy copies a deque one contiguous block at a time, rather than indexing it byte by byte
+		std::copy(recvBuf.begin(), recvBuf.begin() + toRead, begin);
 		recvBuf.erase(recvBuf.begin(), recvBuf.begin() + toRead);
 		readBytes.set(readBytes.get() + toRead);
 		return toRead;
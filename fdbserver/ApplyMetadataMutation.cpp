@@ -86,7 +86,8 @@ public:
 	    commit(proxyCommitData_.commit), cx(proxyCommitData_.cx), committedVersion(&proxyCommitData_.committedVersion),
 	    storageCache(&proxyCommitData_.storageCache), tag_popped(&proxyCommitData_.tag_popped),
 	    tssMapping(&proxyCommitData_.tssMapping), tenantMap(&proxyCommitData_.tenantMap),
-	    tenantNameIndex(&proxyCommitData_.tenantNameIndex), lockedTenants(&proxyCommitData_.lockedTenants),
+	    tenantNameIndex(&proxyCommitData_.tenantNameIndex), tenantIdIndex(&proxyCommitData_.tenantIdIndex),
+	    lockedTenants(&proxyCommitData_.lockedTenants),
 	    initialCommit(initialCommit_), provisionalCommitProxy(provisionalCommitProxy_) {
 		if (encryptMode.isEncryptionEnabled()) {
 			ASSERT(cipherKeys != nullptr);
@@ -155,6 +156,7 @@ private:
 
 	std::map<int64_t, TenantName>* tenantMap = nullptr;
 	std::unordered_map<TenantName, int64_t>* tenantNameIndex = nullptr;
+	std::unordered_set<int64_t>* tenantIdIndex = nullptr;
 	std::set<int64_t>* lockedTenants = nullptr;
 	EncryptionAtRestMode encryptMode;
 
@@ -711,6 +713,9 @@ private:
 				if (tenantNameIndex) {
 					(*tenantNameIndex)[tenantEntry.tenantName] = tenantEntry.id;
 				}
+				if (tenantIdIndex) {
+					tenantIdIndex->insert(tenantEntry.id);
+				}
 			}
 			if (lockedTenants) {
 				if (tenantEntry.tenantLockState == TenantAPI::TenantLockState::UNLOCKED) {
@@ -1147,6 +1152,9 @@ private:
 				auto itr = startItr;
 				while (itr != endItr) {
 					tenantNameIndex->erase(itr->second);
+					if (tenantIdIndex) {
+						tenantIdIndex->erase(itr->first);
+					}
 					itr++;
 				}
 
@@ -0,0 +1,701 @@
+/*
+ * ArtVersionHistory.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "flow/Platform.h"
+#include "flow/UnitTest.h"
+#include "fdbserver/ArtVersionHistory.h"
+
+// A node is reached from its parent through one key byte, and then covers the bytes of its (path compressed) prefix.
+// The key of a node is the concatenation of those bytes along its path from the root, whose prefix is always empty.
+//
+// Children are kept the way an adaptive radix tree keeps them: up to 48 children are stored as a sorted array of key
+// bytes searched with SSE compares, beyond that as a direct array of 256 pointers.
+//
+// The tree is kept canonical: every node other than the root is either a boundary or has at least two children.  Nodes
+// holding a boundary are only freed when their boundary is erased, so pointers to other boundaries stay valid.
+struct ArtVersionHistory::Node {
+	Node* parent = nullptr;
+	std::string prefix;
+	Version version = invalidVersion; // The version of the boundary at this node's key, if isBoundary
+	Version maxVersion = invalidVersion; // The max version of any boundary in this node's subtree
+	bool isBoundary = false;
+	uint8_t byteInParent = 0;
+	int16_t numChildren = 0;
+	int16_t capacity = 0; // 0, 4, 16 or 48 sorted children, or 256 children indexed by key byte
+	uint8_t* keys = nullptr; // Sorted key bytes of the children, padded to a multiple of 16 bytes
+	Node** children = nullptr; // In the same allocation as keys, right after them
+	uint64_t present[4] = {}; // With 256 children, a bit set for each key byte that has a child
+
+	~Node() { delete[] storage(); }
+
+	uint8_t* storage() const { return capacity == 256 ? (uint8_t*)children : keys; }
+
+	int childIndex(uint8_t c) const {
+		// keys is padded to a multiple of 16 bytes
+		__m128i target = _mm_set1_epi8((char)c);
+		for (int i = 0; i < numChildren; i += 16) {
+			unsigned mask =
+			    _mm_movemask_epi8(_mm_cmpeq_epi8(target, _mm_loadu_si128((const __m128i*)(keys + i))));
+			if (numChildren - i < 16)
+				mask &= (1u << (numChildren - i)) - 1;
+			if (mask)
+				return i + __builtin_ctz(mask);
+		}
+		return -1;
+	}
+
+	// Returns the smallest key byte >= c (for c in [0, 256]) that has a child, or 256
+	int nextPresent(int c) const {
+		for (int w = c >> 6; w < 4; w++) {
+			uint64_t bits = present[w];
+			if (w == c >> 6)
+				bits &= ~0ULL << (c & 63);
+			if (bits)
+				return (w << 6) + __builtin_ctzll(bits);
+		}
+		return 256;
+	}
+
+	// Returns the greatest key byte < c (for c in [0, 256]) that has a child, or -1
+	int prevPresent(int c) const {
+		for (int w = (c - 1) >> 6; w >= 0; w--) {
+			uint64_t bits = present[w];
+			if (w == (c - 1) >> 6 && (c & 63))
+				bits &= ~0ULL >> (64 - (c & 63));
+			if (bits)
+				return (w << 6) + 63 - __builtin_clzll(bits);
+		}
+		return -1;
+	}
+
+	Node* child(uint8_t c) const {
+		if (capacity == 256)
+			return children[c];
+		int i = childIndex(c);
+		return i < 0 ? nullptr : children[i];
+	}
+
+	// Returns the child with the smallest key byte greater than c, for c in [-1, 255]
+	Node* firstChildAbove(int c) const {
+		if (capacity == 256) {
+			int b = nextPresent(c + 1);
+			return b < 256 ? children[b] : nullptr;
+		}
+		for (int i = 0; i < numChildren; i++)
+			if (keys[i] > c)
+				return children[i];
+		return nullptr;
+	}
+
+	// Returns the child with the greatest key byte less than c, for c in [0, 256]
+	Node* lastChildBelow(int c) const {
+		if (capacity == 256) {
+			int b = prevPresent(c);
+			return b >= 0 ? children[b] : nullptr;
+		}
+		for (int i = numChildren - 1; i >= 0; i--)
+			if (keys[i] < c)
+				return children[i];
+		return nullptr;
+	}
+
+	// Returns true if f(child) is true for any child with a key byte in (lo, hi), visiting them in key order
+	template <class F>
+	bool anyChild(int lo, int hi, F f) const {
+		if (capacity == 256) {
+			for (int b = nextPresent(lo + 1); b < hi; b = nextPresent(b + 1))
+				if (f(children[b]))
+					return true;
+			return false;
+		}
+		for (int i = 0; i < numChildren && keys[i] < hi; i++)
+			if (keys[i] > lo && f(children[i]))
+				return true;
+		return false;
+	}
+
+	void resize(int newCapacity) {
+		uint8_t* newKeys = nullptr;
+		Node** newChildren;
+		if (newCapacity == 256) {
+			newChildren = (Node**)new uint8_t[256 * sizeof(Node*)]();
+			for (int i = 0; i < numChildren; i++) {
+				newChildren[keys[i]] = children[i];
+				present[keys[i] >> 6] |= 1ULL << (keys[i] & 63);
+			}
+		} else {
+			const int keyBytes = std::max(newCapacity, 16);
+			newKeys = new uint8_t[keyBytes + newCapacity * sizeof(Node*)]();
+			newChildren = (Node**)(newKeys + keyBytes);
+			if (capacity == 256) {
+				int i = 0;
+				for (int b = nextPresent(0); b < 256; b = nextPresent(b + 1)) {
+					newKeys[i] = b;
+					newChildren[i++] = children[b];
+				}
+				memset(present, 0, sizeof(present));
+			} else {
+				memcpy(newKeys, keys, numChildren);
+				memcpy(newChildren, children, numChildren * sizeof(Node*));
+			}
+		}
+		delete[] storage();
+		keys = newKeys;
+		children = newChildren;
+		capacity = newCapacity;
+	}
+
+	void addChild(uint8_t c, Node* n) {
+		if (numChildren == capacity)
+			resize(capacity == 0 ? 4 : capacity == 4 ? 16 : capacity == 16 ? 48 : 256);
+		n->parent = this;
+		n->byteInParent = c;
+		numChildren++;
+		if (capacity == 256) {
+			children[c] = n;
+			present[c >> 6] |= 1ULL << (c & 63);
+			return;
+		}
+		int i = numChildren - 1;
+		for (; i > 0 && keys[i - 1] > c; i--) {
+			keys[i] = keys[i - 1];
+			children[i] = children[i - 1];
+		}
+		keys[i] = c;
+		children[i] = n;
+	}
+
+	void removeChild(uint8_t c) {
+		if (capacity == 256) {
+			children[c] = nullptr;
+			present[c >> 6] &= ~(1ULL << (c & 63));
+			if (--numChildren < 32)
+				resize(48);
+			return;
+		}
+		int i = childIndex(c);
+		numChildren--;
+		memmove(keys + i, keys + i + 1, numChildren - i);
+		memmove(children + i, children + i + 1, (numChildren - i) * sizeof(Node*));
+	}
+
+	void replaceChild(uint8_t c, Node* n) {
+		n->parent = this;
+		n->byteInParent = c;
+		if (capacity == 256)
+			children[c] = n;
+		else
+			children[childIndex(c)] = n;
+	}
+
+	Node* leftmost() {
+		Node* n = this;
+		while (!n->isBoundary)
+			n = n->firstChildAbove(-1);
+		return n;
+	}
+
+	Node* rightmost() {
+		Node* n = this;
+		while (n->numChildren)
+			n = n->lastChildBelow(256);
+		return n;
+	}
+
+	// Returns the next boundary in key order, or nullptr
+	Node* successor() {
+		if (numChildren)
+			return firstChildAbove(-1)->leftmost();
+		for (Node* n = this; n->parent; n = n->parent) {
+			Node* next = n->parent->firstChildAbove(n->byteInParent);
+			if (next)
+				return next->leftmost();
+		}
+		return nullptr;
+	}
+
+	Version childrenMaxVersion() const {
+		Version v = invalidVersion;
+		anyChild(-1, 256, [&v](const Node* c) {
+			v = std::max(v, c->maxVersion);
+			return false;
+		});
+		return v;
+	}
+
+	// All keys in the subtree start with key[0, depth) + prefix.  Returns -1 (or 1) if they are all less (or greater)
+	// than key, and 0 if key continues on into the subtree.
+	int compare(const KeyRef& key, int depth) const {
+		int available = key.size() - depth;
+		int c = memcmp(prefix.data(), key.begin() + depth, std::min<int>(prefix.size(), available));
+		if (c)
+			return c < 0 ? -1 : 1;
+		return (int)prefix.size() <= available ? 0 : 1;
+	}
+};
+
+ArtVersionHistory::ArtVersionHistory(Version version) : root(nullptr), boundaryCount(0) {
+	clear(version);
+}
+
+ArtVersionHistory::~ArtVersionHistory() {
+	destroy();
+}
+
+void ArtVersionHistory::destroy() {
+	if (!root)
+		return;
+	std::vector<Node*> stack{ root };
+	while (!stack.empty()) {
+		Node* n = stack.back();
+		stack.pop_back();
+		n->anyChild(-1, 256, [&stack](Node* c) {
+			stack.push_back(c);
+			return false;
+		});
+		delete n;
+	}
+	root = nullptr;
+}
+
+void ArtVersionHistory::clear(Version version) {
+	destroy();
+	root = new Node;
+	root->isBoundary = true;
+	root->version = root->maxVersion = version;
+	boundaryCount = 1;
+}
+
+// Returns the boundary with the greatest key <= key (or < key if !inclusive), or the root if there is none
+ArtVersionHistory::Node* ArtVersionHistory::floorNode(KeyRef key, bool inclusive) const {
+	// The best candidate so far, either a boundary itself or a subtree that is entirely less than key
+	Node* candidate = nullptr;
+	bool candidateIsSubtree = false;
+	Node* n = root;
+	int depth = 0;
+	while (true) {
+		int c = n->compare(key, depth);
+		if (c < 0)
+			return n->rightmost();
+		if (c > 0)
+			break;
+		depth += n->prefix.size();
+		if (depth == key.size()) {
+			if (inclusive && n->isBoundary)
+				return n;
+			break;
+		}
+		if (n->isBoundary) {
+			candidate = n;
+			candidateIsSubtree = false;
+		}
+		if (Node* below = n->lastChildBelow(key[depth])) {
+			candidate = below;
+			candidateIsSubtree = true;
+		}
+		n = n->child(key[depth++]);
+		if (!n)
+			break;
+	}
+	if (!candidate)
+		return root;
+	return candidateIsSubtree ? candidate->rightmost() : candidate;
+}
+
+// Returns the boundary with the smallest key >= key (or > key if !inclusive), or nullptr if there is none
+ArtVersionHistory::Node* ArtVersionHistory::ceilNode(KeyRef key, bool inclusive) const {
+	Node* candidate = nullptr;
+	Node* n = root;
+	int depth = 0;
+	while (true) {
+		int c = n->compare(key, depth);
+		if (c > 0)
+			return n->leftmost();
+		if (c < 0)
+			break;
+		depth += n->prefix.size();
+		if (depth == key.size()) {
+			if (inclusive && n->isBoundary)
+				return n;
+			if (Node* first = n->firstChildAbove(-1))
+				return first->leftmost();
+			break;
+		}
+		if (Node* above = n->firstChildAbove(key[depth]))
+			candidate = above;
+		n = n->child(key[depth++]);
+		if (!n)
+			break;
+	}
+	return candidate ? candidate->leftmost() : nullptr;
+}
+
+// Returns true if any boundary strictly between begin and end is newer than readVersion
+bool ArtVersionHistory::newerBetween(KeyRef begin, KeyRef end, Version readVersion) const {
+	auto newer = [readVersion](const Node* c) { return c->maxVersion > readVersion; };
+
+	// Boundaries > begin in the subtree of n, whose path matches begin up to depth
+	auto newerAbove = [&](const Node* n, int depth) {
+		while (true) {
+			int c = n->compare(begin, depth);
+			if (c)
+				return c > 0 && n->maxVersion > readVersion;
+			depth += n->prefix.size();
+			if (depth == begin.size())
+				return n->anyChild(-1, 256, newer);
+			if (n->anyChild(begin[depth], 256, newer))
+				return true;
+			n = n->child(begin[depth++]);
+			if (!n)
+				return false;
+		}
+	};
+
+	// Boundaries < end in the subtree of n, whose path matches end up to depth
+	auto newerBelow = [&](const Node* n, int depth) {
+		while (true) {
+			int c = n->compare(end, depth);
+			if (c)
+				return c < 0 && n->maxVersion > readVersion;
+			depth += n->prefix.size();
+			if (depth == end.size())
+				return false;
+			if (n->isBoundary && n->version > readVersion)
+				return true;
+			if (n->anyChild(-1, end[depth], newer))
+				return true;
+			n = n->child(end[depth++]);
+			if (!n)
+				return false;
+		}
+	};
+
+	// Follow the common path of begin and end until they part
+	const Node* n = root;
+	int depth = 0;
+	while (true) {
+		int cb = n->compare(begin, depth);
+		int ce = n->compare(end, depth);
+		if (cb < 0 || ce > 0)
+			return false;
+		if (cb > 0)
+			return ce < 0 ? n->maxVersion > readVersion : newerBelow(n, depth);
+		if (ce < 0)
+			return newerAbove(n, depth);
+		depth += n->prefix.size();
+		// begin < end, so end can't end here
+		ASSERT(depth < end.size());
+		if (depth == begin.size()) {
+			if (n->anyChild(-1, end[depth], newer))
+				return true;
+			const Node* e = n->child(end[depth]);
+			return e && newerBelow(e, depth + 1);
+		}
+		uint8_t bc = begin[depth], ec = end[depth];
+		if (bc == ec) {
+			n = n->child(bc);
+			if (!n)
+				return false;
+			depth++;
+			continue;
+		}
+		if (n->anyChild(bc, ec, newer))
+			return true;
+		const Node* b = n->child(bc);
+		if (b && newerAbove(b, depth + 1))
+			return true;
+		const Node* e = n->child(ec);
+		return e && newerBelow(e, depth + 1);
+	}
+}
+
+bool ArtVersionHistory::hasConflict(KeyRef begin, KeyRef end, Version readVersion) const {
+	// Like the SkipList, check an empty range against the boundary before it
+	if (begin == end)
+		return floorNode(begin, false)->version > readVersion;
+	if (begin > end)
+		return false;
+	return floorNode(begin, true)->version > readVersion || newerBetween(begin, end, readVersion);
+}
+
+// Returns the node for key, making it a boundary with the given version if it isn't already one (or if overwrite)
+ArtVersionHistory::Node* ArtVersionHistory::insert(KeyRef key, Version version, bool overwrite) {
+	Node* n = root;
+	int depth = 0;
+	Node* target;
+	while (true) {
+		int length = std::min<int>(n->prefix.size(), key.size() - depth);
+		int i = 0;
+		while (i < length && (uint8_t)n->prefix[i] == key[depth + i])
+			i++;
+		if (i < (int)n->prefix.size()) {
+			// key leaves the path of n inside its prefix, so split n
+			Node* split = new Node;
+			split->prefix = n->prefix.substr(0, i);
+			split->maxVersion = n->maxVersion;
+			n->parent->replaceChild(n->byteInParent, split);
+			uint8_t c = n->prefix[i];
+			n->prefix.erase(0, i + 1);
+			split->addChild(c, n);
+			depth += i;
+			target = split;
+			if (depth < key.size()) {
+				target = new Node;
+				target->prefix = key.substr(depth + 1).toString();
+				split->addChild(key[depth], target);
+			}
+			break;
+		}
+		depth += n->prefix.size();
+		if (depth == key.size()) {
+			target = n;
+			break;
+		}
+		Node* next = n->child(key[depth]);
+		if (!next) {
+			target = new Node;
+			target->prefix = key.substr(depth + 1).toString();
+			n->addChild(key[depth], target);
+			break;
+		}
+		n = next;
+		depth++;
+	}
+
+	if (target->isBoundary && !overwrite)
+		return target;
+	Version oldVersion = target->isBoundary ? target->version : invalidVersion;
+	if (!target->isBoundary)
+		boundaryCount++;
+	target->isBoundary = true;
+	target->version = version;
+	if (version >= oldVersion) {
+		for (Node* p = target; p && p->maxVersion < version; p = p->parent)
+			p->maxVersion = version;
+	} else {
+		for (Node* p = target; p; p = p->parent) {
+			Version v = std::max(p->isBoundary ? p->version : invalidVersion, p->childrenMaxVersion());
+			if (v == p->maxVersion)
+				break;
+			p->maxVersion = v;
+		}
+	}
+	return target;
+}
+
+void ArtVersionHistory::eraseBoundary(Node* n) {
+	ASSERT(n->isBoundary);
+	n->isBoundary = false;
+	boundaryCount--;
+
+	// Remove the nodes that are no longer needed
+	while (n != root && !n->isBoundary && n->numChildren <= 1) {
+		Node* parent = n->parent;
+		if (n->numChildren == 0) {
+			parent->removeChild(n->byteInParent);
+			delete n;
+			n = parent;
+			continue;
+		}
+		// The only child takes the place of n, which leaves the shape of parent unchanged
+		Node* child = n->firstChildAbove(-1);
+		child->prefix = n->prefix + (char)child->byteInParent + child->prefix;
+		parent->replaceChild(n->byteInParent, child);
+		delete n;
+		n = parent;
+		break;
+	}
+
+	for (; n; n = n->parent) {
+		Version v = std::max(n->isBoundary ? n->version : invalidVersion, n->childrenMaxVersion());
+		if (v == n->maxVersion)
+			break;
+		n->maxVersion = v;
+	}
+}
+
+void ArtVersionHistory::addConflictRange(KeyRef begin, KeyRef end, Version version) {
+	if (begin >= end)
+		return;
+	// The keys from end on keep whatever version they had
+	Node* endNode = insert(end, floorNode(end, true)->version, false);
+	for (Node* n = ceilNode(begin, true); n != endNode;) {
+		Node* next = n->successor();
+		eraseBoundary(n);
+		n = next;
+	}
+	insert(begin, version, true);
+}
+
+Key ArtVersionHistory::keyOf(const Node* n) const {
+	std::vector<const Node*> path;
+	for (; n != root; n = n->parent)
+		path.push_back(n);
+	std::string key;
+	for (auto p = path.rbegin(); p != path.rend(); ++p) {
+		key.push_back((char)(*p)->byteInParent);
+		key += (*p)->prefix;
+	}
+	return Key(StringRef(key));
+}
+
+Key ArtVersionHistory::removeBefore(Version oldestVersion, KeyRef from, int nodeCount) {
+	// The boundary at the empty key is never removed, like the header of the SkipList
+	bool wasAbove = true;
+	Node* n = from.size() ? ceilNode(from, true) : root->successor();
+	for (; n && nodeCount > 0; nodeCount--) {
+		Node* next = n->successor();
+		bool isAbove = n->version >= oldestVersion;
+		if (!isAbove && !wasAbove)
+			eraseBoundary(n);
+		wasAbove = isAbove;
+		n = next;
+	}
+	return n ? keyOf(n) : Key();
+}
+
+void ArtVersionHistory::checkInvariants() const {
+	ASSERT(root->prefix.empty() && root->isBoundary);
+	int boundaries = 0;
+	std::vector<const Node*> stack{ root };
+	while (!stack.empty()) {
+		const Node* n = stack.back();
+		stack.pop_back();
+		ASSERT(n == root || n->isBoundary || n->numChildren >= 2);
+		ASSERT(n->maxVersion == std::max(n->isBoundary ? n->version : invalidVersion, n->childrenMaxVersion()));
+		boundaries += n->isBoundary;
+		int children = 0, last = -1;
+		n->anyChild(-1, 256, [&](const Node* c) {
+			ASSERT(c->parent == n && c->byteInParent > last);
+			last = c->byteInParent;
+			children++;
+			stack.push_back(c);
+			return false;
+		});
+		ASSERT(children == n->numChildren);
+	}
+	ASSERT(boundaries == boundaryCount);
+}
+
+namespace {
+// The same version history kept in a std::map, for testing
+struct VersionHistoryModel {
+	std::map<std::string, Version> boundaries{ { std::string(), 0 } };
+
+	std::map<std::string, Version>::iterator floor(const std::string& key) {
+		return std::prev(boundaries.upper_bound(key));
+	}
+
+	bool hasConflict(const std::string& begin, const std::string& end, Version readVersion) {
+		if (begin == end) {
+			auto it = boundaries.lower_bound(begin);
+			return (it == boundaries.begin() ? it : std::prev(it))->second > readVersion;
+		}
+		if (begin > end)
+			return false;
+		for (auto it = floor(begin); it != boundaries.end() && it->first < end; ++it)
+			if (it->second > readVersion)
+				return true;
+		return false;
+	}
+
+	void addConflictRange(const std::string& begin, const std::string& end, Version version) {
+		if (begin >= end)
+			return;
+		if (!boundaries.count(end))
+			boundaries[end] = floor(end)->second;
+		boundaries.erase(boundaries.lower_bound(begin), boundaries.find(end));
+		boundaries[begin] = version;
+	}
+
+	std::string removeBefore(Version oldestVersion, const std::string& from, int nodeCount) {
+		bool wasAbove = true;
+		auto it = boundaries.upper_bound(from);
+		if (from.size())
+			it = boundaries.lower_bound(from);
+		for (; it != boundaries.end() && nodeCount > 0; nodeCount--) {
+			bool isAbove = it->second >= oldestVersion;
+			if (!isAbove && !wasAbove)
+				it = boundaries.erase(it);
+			else
+				++it;
+			wasAbove = isAbove;
+		}
+		return it == boundaries.end() ? std::string() : it->first;
+	}
+};
+} // namespace
+
+TEST_CASE("/fdbserver/ArtVersionHistory/Model") {
+	ArtVersionHistory art;
+	VersionHistoryModel model;
+
+	// Mostly short keys over a tiny alphabet, so that keys are often prefixes of each other, and some long keys
+	// sharing a prefix with arbitrary bytes after it, so that nodes grow to all sizes.
+	const uint8_t alphabet[] = { 0, 1, 'a', 0xff };
+	const std::string sharedPrefix(deterministicRandom()->randomInt(0, 40), 't');
+	auto randomKey = [&]() {
+		std::string key;
+		if (deterministicRandom()->random01() < 0.3) {
+			key = sharedPrefix;
+			for (int i = deterministicRandom()->randomInt(0, 3); i > 0; i--)
+				key.push_back((char)deterministicRandom()->randomInt(0, 256));
+		} else {
+			for (int i = deterministicRandom()->randomInt(0, 6); i > 0; i--)
+				key.push_back((char)alphabet[deterministicRandom()->randomInt(0, sizeof(alphabet))]);
+		}
+		return key;
+	};
+
+	Version version = 1;
+	std::string removalKey;
+	for (int i = 0; i < 50000; i++) {
+		std::string begin = randomKey(), end = randomKey();
+		if (deterministicRandom()->coinflip() && begin > end)
+			std::swap(begin, end);
+		double op = deterministicRandom()->random01();
+		if (op < 0.4) {
+			Version readVersion = version - deterministicRandom()->randomInt(0, 20);
+			ASSERT_EQ(art.hasConflict(StringRef(begin), StringRef(end), readVersion),
+			          model.hasConflict(begin, end, readVersion));
+		} else if (op < 0.9) {
+			version += deterministicRandom()->randomInt(0, 2);
+			art.addConflictRange(StringRef(begin), StringRef(end), version);
+			model.addConflictRange(begin, end, version);
+		} else {
+			Version oldestVersion = version - deterministicRandom()->randomInt(0, 30);
+			int nodeCount = deterministicRandom()->randomInt(1, 20);
+			Key next = art.removeBefore(oldestVersion, StringRef(removalKey), nodeCount);
+			removalKey = model.removeBefore(oldestVersion, removalKey, nodeCount);
+			ASSERT(next == StringRef(removalKey));
+		}
+		ASSERT_EQ(art.count(), model.boundaries.size());
+		if (i % 1000 == 0)
+			art.checkInvariants();
+	}
+	art.checkInvariants();
+	return Void();
+}
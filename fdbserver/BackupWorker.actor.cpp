@@ -723,13 +723,37 @@ ACTOR static Future<Void> updateLogBytesWritten(BackupData* self,
 	}
 }
 
-// Saves messages in the range of [0, numMsg) to a file and then remove these
-// messages. The file content format is a sequence of (Version, sub#, msgSize, message).
+// Finishes the upload of mutation log files written by saveMutationsToFile().
+ACTOR static Future<Void> finishMutationFiles(BackupData* self,
+                                              std::vector<UID> activeUids,
+                                              std::vector<Reference<IBackupFile>> logFiles) {
+	std::vector<Future<Void>> finished;
+	std::transform(logFiles.begin(), logFiles.end(), std::back_inserter(finished), [](const Reference<IBackupFile>& f) {
+		return f->finish();
+	});
+
+	wait(waitForAll(finished));
+
+	for (const auto& file : logFiles) {
+		TraceEvent("CloseMutationFile", self->myId)
+		    .detail("FileSize", file->size())
+		    .detail("TagId", self->tag.id)
+		    .detail("File", file->getFileName());
+	}
+
+	wait(updateLogBytesWritten(self, activeUids, logFiles));
+	return Void();
+}
+
+// Saves messages in the range of [0, numMsg) to a file, after which the caller can remove these messages. The files
+// finish uploading in the background, and *uploaded is set to a future for that.
+// The file content format is a sequence of (Version, sub#, msgSize, message).
 // Note only ready backups are saved.
 ACTOR Future<Void> saveMutationsToFile(BackupData* self,
                                        Version popVersion,
                                        int numMsg,
-                                       std::unordered_set<BlobCipherDetails> cipherDetails) {
+                                       std::unordered_set<BlobCipherDetails> cipherDetails,
+                                       Future<Void>* uploaded) {
 	state int blockSize = SERVER_KNOBS->BACKUP_FILE_BLOCK_BYTES;
 	state std::vector<Future<Reference<IBackupFile>>> logFileFutures;
 	state std::vector<Reference<IBackupFile>> logFiles;
@@ -840,30 +864,21 @@ ACTOR Future<Void> saveMutationsToFile(BackupData* self,
 		mutations.clear();
 	}
 
-	std::vector<Future<Void>> finished;
-	std::transform(logFiles.begin(), logFiles.end(), std::back_inserter(finished), [](const Reference<IBackupFile>& f) {
-		return f->finish();
-	});
-
-	wait(waitForAll(finished));
-
-	for (const auto& file : logFiles) {
-		TraceEvent("CloseMutationFile", self->myId)
-		    .detail("FileSize", file->size())
-		    .detail("TagId", self->tag.id)
-		    .detail("File", file->getFileName());
-	}
+	// The next files begin where these end, so they can be written while these are still uploading
 	for (const UID& uid : activeUids) {
 		self->backups[uid].lastSavedVersion = popVersion + 1;
 	}
 
-	wait(updateLogBytesWritten(self, activeUids, logFiles));
+	*uploaded = finishMutationFiles(self, activeUids, logFiles);
 	return Void();
 }
 
 // Uploads self->messages to cloud storage and updates savedVersion.
 ACTOR Future<Void> uploadData(BackupData* self) {
 	state Version popVersion = invalidVersion;
+	// Files still uploading in the background, with the pop version each of them was saved up to
+	state std::deque<std::pair<Version, Future<Void>>> uploads;
+	state Version uploadedVersion = invalidVersion;
 
 	loop {
 		// Too large uploadDelay will delay popping tLog data for too long.
@@ -871,6 +886,7 @@ ACTOR Future<Void> uploadData(BackupData* self) {
 
 		state int numMsg = 0;
 		state std::unordered_set<BlobCipherDetails> cipherDetails;
+		state bool saved = false;
 		Version lastPopVersion = popVersion;
 		// index of last version's end position in self->messages
 		int lastVersionIndex = 0;
@@ -916,22 +932,36 @@ ACTOR Future<Void> uploadData(BackupData* self) {
 			    .detail("NumMsg", numMsg)
 			    .detail("MsgQ", self->messages.size());
 			// save an empty file for old epochs so that log file versions are continuous
-			wait(saveMutationsToFile(self, popVersion, numMsg, cipherDetails));
+			state Future<Void> uploaded;
+			wait(saveMutationsToFile(self, popVersion, numMsg, cipherDetails, &uploaded));
 			self->eraseMessages(numMsg);
+			uploads.emplace_back(popVersion, uploaded);
+			saved = true;
 		}
 
+		// Progress can only be saved up to the last file that finished uploading. Wait for everything once pulling is
+		// finished, so that the final progress covers the end version.
+		while (!uploads.empty() && (uploads.front().second.isReady() || self->pullFinished() ||
+		                            uploads.size() >= (size_t)SERVER_KNOBS->BACKUP_MAX_OUTSTANDING_UPLOADS)) {
+			wait(uploads.front().second);
+			uploadedVersion = uploads.front().first;
+			uploads.pop_front();
+		}
+		state Version progressVersion = uploads.empty() ? popVersion : uploadedVersion;
+
 		// If transition into NOOP mode, should clear messages
 		if (!self->pulling && self->backupEpoch == self->recruitedEpoch) {
 			self->eraseMessages(self->messages.size());
 		}
 
-		if (popVersion > self->savedVersion && popVersion > self->popVersion) {
-			wait(saveProgress(self, popVersion));
+		if (progressVersion > self->savedVersion && progressVersion > self->popVersion) {
+			wait(saveProgress(self, progressVersion));
 			TraceEvent("BackupWorkerSavedProgress", self->myId)
 			    .detail("Tag", self->tag.toString())
-			    .detail("Version", popVersion)
-			    .detail("MsgQ", self->messages.size());
-			self->savedVersion = std::max(popVersion, self->savedVersion);
+			    .detail("Version", progressVersion)
+			    .detail("MsgQ", self->messages.size())
+			    .detail("Uploads", uploads.size());
+			self->savedVersion = std::max(progressVersion, self->savedVersion);
 			self->pop();
 		}
 
@@ -940,7 +970,8 @@ ACTOR Future<Void> uploadData(BackupData* self) {
 			return Void();
 		}
 
-		if (!self->pullFinished()) {
+		// When pulling is blocked on memory, start the next file right away rather than waiting out the delay
+		if (!self->pullFinished() && !(saved && self->lock->waiters() > 0)) {
 			wait(uploadDelay || self->doneTrigger.onTrigger());
 		}
 	}
@@ -522,6 +522,10 @@ private:
 						dprint("Unsupported ReadHotSubRange\n");
 						req.reply.sendError(unsupported_operation());
 					}
+					when(GetHotKeysRequest req = waitNext(ssi.getHotKeys.getFuture())) {
+						dprint("Unsupported GetHotKeysRequest\n");
+						req.reply.sendError(unsupported_operation());
+					}
 					when(GetKeyValuesStreamRequest req = waitNext(ssi.getKeyValuesStream.getFuture())) {
 						dprint("Unsupported GetKeyValuesStreamRequest\n");
 						req.reply.sendError(unsupported_operation());
@@ -544,6 +548,10 @@ private:
 						dprint("Unsupported GetValueRequest\n");
 						req.reply.sendError(unsupported_operation());
 					}
+					when(GetValuesRequest req = waitNext(ssi.getValues.getFuture())) {
+						dprint("Unsupported GetValuesRequest\n");
+						req.reply.sendError(unsupported_operation());
+					}
 					when(GetCheckpointRequest req = waitNext(ssi.checkpoint.getFuture())) {
 						dprint("Unsupported GetCheckpoint \n");
 						req.reply.sendError(unsupported_operation());
@@ -793,9 +793,10 @@ ACTOR Future<std::pair<BlobGranuleSplitState, Version>> getGranuleSplitState(Tra
 	}
 }
 
-// tries to use writeEntireFile if possible, but if too big falls back to multi-part upload
+// Small files are written with a single request. Large files go straight to a multipart upload, which sends its parts in
+// parallel instead of as one long PUT.
 ACTOR Future<Void> writeFile(Reference<BackupContainerFileSystem> writeBStore, std::string fname, Value serialized) {
-	if (!SERVER_KNOBS->BG_WRITE_MULTIPART) {
+	if (!SERVER_KNOBS->BG_WRITE_MULTIPART && serialized.size() < SERVER_KNOBS->BG_WRITE_MULTIPART_MIN_BYTES) {
 		try {
 			state std::string fileContents = serialized.toString();
 			wait(writeBStore->writeEntireFile(fname, fileContents));
@@ -1144,7 +1145,9 @@ ACTOR Future<BlobFileIndex> writeSnapshot(Reference<BlobWorkerData> bwData,
 	                                                  snapshot,
 	                                                  SERVER_KNOBS->BG_SNAPSHOT_FILE_TARGET_CHUNK_BYTES,
 	                                                  compressFilter,
-	                                                  cipherKeysCtx);
+	                                                  cipherKeysCtx,
+	                                                  true,
+	                                                  SERVER_KNOBS->BG_SNAPSHOT_FILE_COLUMNAR);
 	state size_t serializedSize = serialized.size();
 	bwData->stats.compressionBytesRaw += snapshot.expectedSize();
 	bwData->stats.compressionBytesFinal += serializedSize;
@@ -1343,11 +1343,21 @@ ACTOR Future<Void> statusServer(FutureStream<StatusRequest> requests,
 	// Place to accumulate a batch of requests to respond to
 	state std::vector<StatusRequest> requests_batch;
 
+	// The last successful GetStatus, and when it began
+	state Optional<StatusReply> cachedStatus;
+	state double cachedStatusTime = 0.0;
+	state double statusStartTime;
+
 	loop {
 		try {
 			// Wait til first request is ready
 			StatusRequest req = waitNext(requests);
 			++self->statusRequests;
+			if (cachedStatus.present() && now() - cachedStatusTime <= SERVER_KNOBS->STATUS_CACHE_MAX_STALENESS) {
+				++self->statusRequestsFromCache;
+				req.reply.send(cachedStatus.get());
+				continue;
+			}
 			requests_batch.push_back(req);
 
 			// Earliest time at which we may begin a new request
@@ -1396,6 +1406,7 @@ ACTOR Future<Void> statusServer(FutureStream<StatusRequest> requests,
 				}
 			}
 
+			statusStartTime = now();
 			state ErrorOr<StatusReply> result = wait(errorOr(clusterGetStatus(self->db.serverInfo,
 			                                                                  self->cx,
 			                                                                  workers,
@@ -1414,6 +1425,10 @@ ACTOR Future<Void> statusServer(FutureStream<StatusRequest> requests,
 			// Update last_request_time now because GetStatus is finished and the delay is to be measured between
 			// requests
 			last_request_time = now();
+			if (result.present()) {
+				cachedStatus = result.get();
+				cachedStatusTime = statusStartTime;
+			}
 
 			while (!requests_batch.empty()) {
 				if (result.isError())
@@ -2657,6 +2672,9 @@ ACTOR Future<Void> monitorBlobManager(ClusterControllerData* self) {
 ACTOR Future<Void> dbInfoUpdater(ClusterControllerData* self) {
 	state Future<Void> dbInfoChange = self->db.serverInfo->onChange();
 	state Future<Void> updateDBInfo = self->updateDBInfo.onTrigger();
+	// The latest serialized ServerDBInfo broadcast, the base of the next delta
+	state UID lastPayloadID;
+	state Standalone<StringRef> lastPayload;
 	loop {
 		choose {
 			when(wait(updateDBInfo)) {
@@ -2666,7 +2684,9 @@ ACTOR Future<Void> dbInfoUpdater(ClusterControllerData* self) {
 		}
 
 		UpdateServerDBInfoRequest req;
-		if (dbInfoChange.isReady()) {
+		// Only a broadcast to every worker can be a delta; the others go to workers that may not have its base
+		bool toAllWorkers = dbInfoChange.isReady();
+		if (toAllWorkers) {
 			for (auto& it : self->id_worker) {
 				req.broadcastInfo.push_back(it.second.details.interf.updateServerDBInfo.getEndpoint());
 			}
@@ -2686,6 +2706,22 @@ ACTOR Future<Void> dbInfoUpdater(ClusterControllerData* self) {
 
 		req.serializedDbInfo =
 		    BinaryWriter::toValue(self->db.serverInfo->get(), AssumeVersion(g_network->protocolVersion()));
+		if (req.serializedDbInfo != lastPayload) {
+			Optional<Standalone<StringRef>> delta;
+			if (SERVER_KNOBS->DBINFO_DELTA_BROADCAST && toAllWorkers && lastPayload.size() &&
+			    lastPayload.size() == req.serializedDbInfo.size()) {
+				delta = encodeDBInfoDelta(lastPayload, req.serializedDbInfo);
+			}
+			if (delta.present()) {
+				req.deltaBaseID = lastPayloadID;
+			}
+			lastPayloadID = deterministicRandom()->randomUniqueID();
+			lastPayload = req.serializedDbInfo;
+			if (delta.present()) {
+				req.serializedDbInfo = delta.get();
+			}
+		}
+		req.payloadID = lastPayloadID;
 
 		TraceEvent("DBInfoStartBroadcast", self->id).log();
 		choose {
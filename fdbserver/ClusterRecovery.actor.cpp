@@ -497,6 +497,7 @@ ACTOR Future<Void> trackTlogRecovery(Reference<ClusterRecoveryData> self,
 			           self->dbgid)
 			    .detail("StatusCode", RecoveryStatus::fully_recovered)
 			    .detail("Status", RecoveryStatus::names[RecoveryStatus::fully_recovered])
+			    .detail("PreviousPhaseDuration", self->endRecoveryPhase())
 			    .trackLatest(self->clusterRecoveryStateEventHolder->trackingKey);
 
 			TraceEvent(getRecoveryEventName(ClusterRecoveryEventType::CLUSTER_RECOVERY_GENERATION_EVENT_NAME).c_str(),
@@ -509,6 +510,7 @@ ACTOR Future<Void> trackTlogRecovery(Reference<ClusterRecoveryData> self,
 			           self->dbgid)
 			    .detail("StatusCode", RecoveryStatus::storage_recovered)
 			    .detail("Status", RecoveryStatus::names[RecoveryStatus::storage_recovered])
+			    .detail("PreviousPhaseDuration", self->endRecoveryPhase())
 			    .trackLatest(self->clusterRecoveryStateEventHolder->trackingKey);
 		} else if (allLogs && self->recoveryState < RecoveryState::ALL_LOGS_RECRUITED) {
 			self->recoveryState = RecoveryState::ALL_LOGS_RECRUITED;
@@ -516,6 +518,7 @@ ACTOR Future<Void> trackTlogRecovery(Reference<ClusterRecoveryData> self,
 			           self->dbgid)
 			    .detail("StatusCode", RecoveryStatus::all_logs_recruited)
 			    .detail("Status", RecoveryStatus::names[RecoveryStatus::all_logs_recruited])
+			    .detail("PreviousPhaseDuration", self->endRecoveryPhase())
 			    .trackLatest(self->clusterRecoveryStateEventHolder->trackingKey);
 		}
 
@@ -958,6 +961,7 @@ ACTOR Future<std::vector<Standalone<CommitTransactionRef>>> recruitEverything(
 		           self->dbgid)
 		    .detail("StatusCode", status)
 		    .detail("Status", RecoveryStatus::names[status])
+		    .detail("PreviousPhaseDuration", self->endRecoveryPhase())
 		    .trackLatest(self->clusterRecoveryStateEventHolder->trackingKey);
 		return Never();
 	} else {
@@ -965,6 +969,7 @@ ACTOR Future<std::vector<Standalone<CommitTransactionRef>>> recruitEverything(
 		           self->dbgid)
 		    .detail("StatusCode", RecoveryStatus::recruiting_transaction_servers)
 		    .detail("Status", RecoveryStatus::names[RecoveryStatus::recruiting_transaction_servers])
+		    .detail("PreviousPhaseDuration", self->endRecoveryPhase())
 		    .detail("Conf", self->configuration.toString())
 		    .detail("RequiredCommitProxies", 1)
 		    .detail("RequiredGrvProxies", 1)
@@ -1014,6 +1019,7 @@ ACTOR Future<std::vector<Standalone<CommitTransactionRef>>> recruitEverything(
 	TraceEvent(getRecoveryEventName(ClusterRecoveryEventType::CLUSTER_RECOVERY_STATE_EVENT_NAME).c_str(), self->dbgid)
 	    .detail("StatusCode", RecoveryStatus::initializing_transaction_servers)
 	    .detail("Status", RecoveryStatus::names[RecoveryStatus::initializing_transaction_servers])
+	    .detail("PreviousPhaseDuration", self->endRecoveryPhase())
 	    .detail("CommitProxies", recruits.commitProxies.size())
 	    .detail("GrvProxies", recruits.grvProxies.size())
 	    .detail("TLogs", recruits.tLogs.size())
@@ -1027,12 +1033,13 @@ ACTOR Future<std::vector<Standalone<CommitTransactionRef>>> recruitEverything(
 	    .trackLatest(self->clusterRecoveryStateEventHolder->trackingKey);
 
 	// Actually, newSeedServers does both the recruiting and initialization of the seed servers; so if this is a brand
-	// new database we are sort of lying that we are past the recruitment phase.  In a perfect world we would split that
-	// up so that the recruitment part happens above (in parallel with recruiting the transaction servers?).
-	wait(newSeedServers(self, recruits, seedServers));
+	// new database we are sort of lying that we are past the recruitment phase.  Only the log servers depend on the
+	// seed servers (through dcId_locality), so the stateless roles are initialized while the seed servers are.
 	state std::vector<Standalone<CommitTransactionRef>> confChanges;
-	wait(newCommitProxies(self, recruits) && newGrvProxies(self, recruits) && newResolvers(self, recruits) &&
-	     newTLogServers(self, recruits, oldLogSystem, &confChanges));
+	state Future<Void> statelessRoles =
+	    newCommitProxies(self, recruits) && newGrvProxies(self, recruits) && newResolvers(self, recruits);
+	wait(newSeedServers(self, recruits, seedServers));
+	wait(statelessRoles && newTLogServers(self, recruits, oldLogSystem, &confChanges));
 
 	// Update recovery related information to the newly elected sequencer (master) process.
 	wait(brokenPromiseToNever(
@@ -1102,10 +1109,22 @@ ACTOR Future<Void> readTransactionSystemState(Reference<ClusterRecoveryData> sel
 	                                             true,
 	                                             enableEncryptionForTxnStateStore);
 
+	// Issue every read at once: they all wait for the store to recover from the log system, and are then answered
+	// together instead of one per trip through the run loop
+	state Future<Optional<Value>> versionEpochRead = self->txnStateStore->readValue(versionEpochKey);
+	state Future<Optional<Value>> requiredCommitVersionRead =
+	    self->txnStateStore->readValue(minRequiredCommitVersionKey);
+	state Future<RangeResult> confRead = self->txnStateStore->readRange(configKeys);
+	state Future<RangeResult> localitiesRead = self->txnStateStore->readRange(tagLocalityListKeys);
+	state Future<RangeResult> tagsRead = self->txnStateStore->readRange(serverTagKeys);
+	state Future<RangeResult> historyTagsRead = self->txnStateStore->readRange(serverTagHistoryKeys);
+	state Future<Optional<Value>> metaclusterRegistrationRead =
+	    self->txnStateStore->readValue(MetaclusterMetadata::metaclusterRegistration().key);
+
 	// Version 0 occurs at the version epoch. The version epoch is the number
 	// of microseconds since the Unix epoch. It can be set through fdbcli.
 	self->versionEpoch.reset();
-	Optional<Standalone<StringRef>> versionEpochValue = wait(self->txnStateStore->readValue(versionEpochKey));
+	Optional<Standalone<StringRef>> versionEpochValue = wait(versionEpochRead);
 	if (versionEpochValue.present()) {
 		self->versionEpoch = BinaryReader::fromStringRef<int64_t>(versionEpochValue.get(), Unversioned());
 	}
@@ -1113,8 +1132,7 @@ ACTOR Future<Void> readTransactionSystemState(Reference<ClusterRecoveryData> sel
 	// Versionstamped operations (particularly those applied from DR) define a minimum commit version
 	// that we may recover to, as they embed the version in user-readable data and require that no
 	// transactions will be committed at a lower version.
-	Optional<Standalone<StringRef>> requiredCommitVersion =
-	    wait(self->txnStateStore->readValue(minRequiredCommitVersionKey));
+	Optional<Standalone<StringRef>> requiredCommitVersion = wait(requiredCommitVersionRead);
 	Version minRequiredCommitVersion = -1;
 	if (requiredCommitVersion.present()) {
 		minRequiredCommitVersion = BinaryReader::fromStringRef<Version>(requiredCommitVersion.get(), Unversioned());
@@ -1153,7 +1171,7 @@ ACTOR Future<Void> readTransactionSystemState(Reference<ClusterRecoveryData> sel
 	    .detail("LastEpochEnd", self->lastEpochEnd)
 	    .detail("RecoveryTransactionVersion", self->recoveryTransactionVersion);
 
-	RangeResult rawConf = wait(self->txnStateStore->readRange(configKeys));
+	RangeResult rawConf = wait(confRead);
 	self->configuration.fromKeyValues(rawConf.castTo<VectorRef<KeyValueRef>>());
 	self->originalConfiguration = self->configuration;
 	self->hasConfiguration = true;
@@ -1165,13 +1183,13 @@ ACTOR Future<Void> readTransactionSystemState(Reference<ClusterRecoveryData> sel
 	    .detail("Conf", self->configuration.toString())
 	    .trackLatest(self->recoveredConfigEventHolder->trackingKey);
 
-	RangeResult rawLocalities = wait(self->txnStateStore->readRange(tagLocalityListKeys));
+	RangeResult rawLocalities = wait(localitiesRead);
 	self->dcId_locality.clear();
 	for (auto& kv : rawLocalities) {
 		self->dcId_locality[decodeTagLocalityListKey(kv.key)] = decodeTagLocalityListValue(kv.value);
 	}
 
-	RangeResult rawTags = wait(self->txnStateStore->readRange(serverTagKeys));
+	RangeResult rawTags = wait(tagsRead);
 	self->allTags.clear();
 	if (self->lastEpochEnd > 0) {
 		self->allTags.push_back(cacheTag);
@@ -1191,13 +1209,12 @@ ACTOR Future<Void> readTransactionSystemState(Reference<ClusterRecoveryData> sel
 		}
 	}
 
-	RangeResult rawHistoryTags = wait(self->txnStateStore->readRange(serverTagHistoryKeys));
+	RangeResult rawHistoryTags = wait(historyTagsRead);
 	for (auto& kv : rawHistoryTags) {
 		self->allTags.push_back(decodeServerTagValue(kv.value));
 	}
 
-	Optional<Value> metaclusterRegistrationVal =
-	    wait(self->txnStateStore->readValue(MetaclusterMetadata::metaclusterRegistration().key));
+	Optional<Value> metaclusterRegistrationVal = wait(metaclusterRegistrationRead);
 	Optional<MetaclusterRegistrationEntry> metaclusterRegistration =
 	    MetaclusterRegistrationEntry::decode(metaclusterRegistrationVal);
 	Optional<ClusterName> metaclusterName;
@@ -1389,6 +1406,7 @@ ACTOR Future<Void> recoverFrom(Reference<ClusterRecoveryData> self,
 	TraceEvent(getRecoveryEventName(ClusterRecoveryEventType::CLUSTER_RECOVERY_STATE_EVENT_NAME).c_str(), self->dbgid)
 	    .detail("StatusCode", RecoveryStatus::reading_transaction_system_state)
 	    .detail("Status", RecoveryStatus::names[RecoveryStatus::reading_transaction_system_state])
+	    .detail("PreviousPhaseDuration", self->endRecoveryPhase())
 	    .trackLatest(self->clusterRecoveryStateEventHolder->trackingKey);
 	self->hasConfiguration = false;
 
@@ -1479,6 +1497,7 @@ ACTOR Future<Void> clusterRecoveryCore(Reference<ClusterRecoveryData> self) {
 	TraceEvent(getRecoveryEventName(ClusterRecoveryEventType::CLUSTER_RECOVERY_STATE_EVENT_NAME).c_str(), self->dbgid)
 	    .detail("StatusCode", RecoveryStatus::reading_coordinated_state)
 	    .detail("Status", RecoveryStatus::names[RecoveryStatus::reading_coordinated_state])
+	    .detail("PreviousPhaseDuration", self->endRecoveryPhase())
 	    .trackLatest(self->clusterRecoveryStateEventHolder->trackingKey);
 
 	wait(self->cstate.read());
@@ -1498,6 +1517,7 @@ ACTOR Future<Void> clusterRecoveryCore(Reference<ClusterRecoveryData> self) {
 	TraceEvent(getRecoveryEventName(ClusterRecoveryEventType::CLUSTER_RECOVERY_STATE_EVENT_NAME).c_str(), self->dbgid)
 	    .detail("StatusCode", RecoveryStatus::locking_coordinated_state)
 	    .detail("Status", RecoveryStatus::names[RecoveryStatus::locking_coordinated_state])
+	    .detail("PreviousPhaseDuration", self->endRecoveryPhase())
 	    .detail("TLogs", self->cstate.prevDBState.tLogs.size())
 	    .detail("ActiveGenerations", self->cstate.myDBState.oldTLogData.size() + 1)
 	    .detail("MyRecoveryCount", self->cstate.prevDBState.recoveryCount + 2)
@@ -1618,6 +1638,7 @@ ACTOR Future<Void> clusterRecoveryCore(Reference<ClusterRecoveryData> self) {
 	TraceEvent(getRecoveryEventName(ClusterRecoveryEventType::CLUSTER_RECOVERY_STATE_EVENT_NAME).c_str(), self->dbgid)
 	    .detail("StatusCode", RecoveryStatus::recovery_transaction)
 	    .detail("Status", RecoveryStatus::names[RecoveryStatus::recovery_transaction])
+	    .detail("PreviousPhaseDuration", self->endRecoveryPhase())
 	    .detail("PrimaryLocality", self->primaryLocality)
 	    .detail("DcId", self->masterInterface.locality.dcId())
 	    .trackLatest(self->clusterRecoveryStateEventHolder->trackingKey);
@@ -1745,6 +1766,7 @@ ACTOR Future<Void> clusterRecoveryCore(Reference<ClusterRecoveryData> self) {
 	TraceEvent(getRecoveryEventName(ClusterRecoveryEventType::CLUSTER_RECOVERY_STATE_EVENT_NAME).c_str(), self->dbgid)
 	    .detail("StatusCode", RecoveryStatus::writing_coordinated_state)
 	    .detail("Status", RecoveryStatus::names[RecoveryStatus::writing_coordinated_state])
+	    .detail("PreviousPhaseDuration", self->endRecoveryPhase())
 	    .detail("TLogList", self->logSystem->describe())
 	    .trackLatest(self->clusterRecoveryStateEventHolder->trackingKey);
 
@@ -1788,6 +1810,7 @@ ACTOR Future<Void> clusterRecoveryCore(Reference<ClusterRecoveryData> self) {
 	TraceEvent(getRecoveryEventName(ClusterRecoveryEventType::CLUSTER_RECOVERY_STATE_EVENT_NAME).c_str(), self->dbgid)
 	    .detail("StatusCode", RecoveryStatus::accepting_commits)
 	    .detail("Status", RecoveryStatus::names[RecoveryStatus::accepting_commits])
+	    .detail("PreviousPhaseDuration", self->endRecoveryPhase())
 	    .detail("StoreType", self->configuration.storageServerStoreType)
 	    .detail("RecoveryDuration", recoveryDuration)
 	    .trackLatest(self->clusterRecoveryStateEventHolder->trackingKey);
@@ -262,8 +262,7 @@ struct ResolutionRequestBuilder {
 
 bool checkTenantNoWait(ProxyCommitData* commitData, int64_t tenant, const char* context, bool logOnFailure) {
 	if (tenant != TenantInfo::INVALID_TENANT) {
-		auto itr = commitData->tenantMap.find(tenant);
-		if (itr == commitData->tenantMap.end()) {
+		if (!commitData->tenantIdIndex.count(tenant)) {
 			if (logOnFailure) {
 				TraceEvent(SevWarn, "CommitProxyTenantNotFound", commitData->dbgid)
 				    .detail("Tenant", tenant)
@@ -569,6 +568,7 @@ ACTOR Future<Void> addBackupMutations(ProxyCommitData* self,
 			auto& tags = self->tagsForKey(backupMutation.param1);
 			toCommit->addTags(tags);
 			toCommit->writeTypedMessage(backupMutation);
+			self->stats.backupMutationBytes += backupMutation.expectedSize();
 
 			//			if (DEBUG_MUTATION("BackupProxyCommit", commitVersion, backupMutation)) {
 			//				TraceEvent("BackupProxyCommitTo", self->dbgid).detail("To",
@@ -589,16 +589,41 @@ ACTOR Future<Void> releaseResolvingAfter(ProxyCommitData* self, Future<Void> rel
 	return Void();
 }
 
+// Samples the round trip of a resolution request, and raises *maxRtt to it
 ACTOR static Future<ResolveTransactionBatchReply> trackResolutionMetrics(Reference<Histogram> dist,
+                                                                         double* maxRtt,
                                                                          Future<ResolveTransactionBatchReply> in) {
 	state double startTime = now();
 	ResolveTransactionBatchReply reply = wait(in);
 	dist->sampleSeconds(now() - startTime);
+	*maxRtt = std::max(*maxRtt, now() - startTime);
 	return reply;
 }
 
 namespace CommitBatch {
 
+// Counts a commit batch in one of the ProxyStats phase occupancy gauges, and moves it out again when the batch moves on
+// to the next phase or is destroyed.
+class PhaseGauge : NonCopyable {
+	int64_t* gauge = nullptr;
+
+public:
+	void enter(int64_t& phase) {
+		leave();
+		gauge = &phase;
+		++*gauge;
+	}
+
+	void leave() {
+		if (gauge) {
+			--*gauge;
+			gauge = nullptr;
+		}
+	}
+
+	~PhaseGauge() { leave(); }
+};
+
 struct CommitBatchContext {
 	using StoreCommit_t = std::vector<std::pair<Future<LogSystemDiskQueueAdapter::CommitMessage>, Future<Void>>>;
 
@@ -635,6 +660,8 @@ struct CommitBatchContext {
 	Future<Void> releaseFuture;
 
 	std::vector<ResolveTransactionBatchReply> resolution;
+	double resolverRtt = 0; // Round trip of the slowest resolver
+	double tlogRtt = 0;
 
 	double computeStart;
 	double computeDuration = 0;
@@ -685,6 +712,12 @@ struct CommitBatchContext {
 	// Cipher keys to be used to encrypt mutations
 	std::unordered_map<EncryptCipherDomainId, Reference<BlobCipherKey>> cipherKeys;
 
+	// Mutations encrypted while waiting for resolution, indexed by transaction and mutation. A transaction has no
+	// entries if none of its mutations could be encrypted before post-resolution processing.
+	std::vector<VectorRef<Optional<MutationRef>>> preEncryptedMutations;
+
+	PhaseGauge phase;
+
 	IdempotencyIdKVBuilder idempotencyKVBuilder;
 
 	CommitBatchContext(ProxyCommitData*, const std::vector<CommitTransactionRequest>*, const int);
@@ -693,6 +726,13 @@ struct CommitBatchContext {
 
 	std::set<Tag> getWrittenTagsPreResolution();
 
+	Optional<MutationRef> getPreEncryptedMutation(int transactionNum, int mutationNum) const {
+		if (transactionNum < preEncryptedMutations.size() && mutationNum < preEncryptedMutations[transactionNum].size()) {
+			return preEncryptedMutations[transactionNum][mutationNum];
+		}
+		return Optional<MutationRef>();
+	}
+
 private:
 	void evaluateBatchSize();
 };
@@ -925,7 +965,7 @@ EncryptCipherDomainId getEncryptDetailsFromMutationRef(ProxyCommitData* commitDa
 			// Parse mutation key to determine mutation encryption domain
 			StringRef prefix = m.param1.substr(0, TenantAPI::PREFIX_SIZE);
 			int64_t tenantId = TenantAPI::prefixToId(prefix, EnforceValidTenantId::False);
-			if (commitData->tenantMap.count(tenantId)) {
+			if (commitData->tenantIdIndex.count(tenantId)) {
 				domainId = tenantId;
 			} else {
 				// Leverage 'default encryption domain'
@@ -955,6 +995,54 @@ EncryptCipherDomainId getEncryptDetailsFromMutationRef(ProxyCommitData* commitDa
 
 } // namespace
 
+// Encrypts the mutations of the batch whose encryption domain is known before resolution, so that the work overlaps
+// the resolver round trip instead of delaying post-resolution processing, which is done by one batch at a time. Raw
+// access mutations are left for assignMutationsToStorageServers(), since their domain is looked up in the tenant map
+// as of the previous batch. The mutations of transactions which turn out to conflict are encrypted for nothing.
+ACTOR Future<Void> preEncryptMutations(CommitBatchContext* self) {
+	state std::vector<CommitTransactionRequest>& trs = self->trs;
+	state int transactionNum = 0;
+	state int mutationNum = 0;
+	state int64_t domainId;
+	state Reference<EncryptBlobCipherAes265Ctr> cipher;
+	state int yieldBytes = 0;
+
+	self->preEncryptedMutations.resize(trs.size());
+	for (; transactionNum < trs.size(); transactionNum++) {
+		domainId = trs[transactionNum].tenantInfo.tenantId;
+		if (self->pProxyCommitData->encryptMode.mode == EncryptionAtRestMode::CLUSTER_AWARE &&
+		    domainId != SYSTEM_KEYSPACE_ENCRYPT_DOMAIN_ID) {
+			domainId = FDB_DEFAULT_ENCRYPT_DOMAIN_ID;
+		}
+		if (domainId == INVALID_ENCRYPT_DOMAIN_ID || self->cipherKeys.count(domainId) == 0) {
+			continue;
+		}
+
+		self->preEncryptedMutations[transactionNum].resize(self->arena,
+		                                                   trs[transactionNum].transaction.mutations.size());
+		// One cipher for all the mutations of the transaction, since they share a domain
+		cipher = MutationRef::encryptCipher(self->cipherKeys, domainId, BlobCipherMetrics::TLOG);
+		for (mutationNum = 0; mutationNum < trs[transactionNum].transaction.mutations.size(); mutationNum++) {
+			if (yieldBytes > SERVER_KNOBS->DESIRED_TOTAL_BYTES) {
+				yieldBytes = 0;
+				if (g_network->check_yield(TaskPriority::ProxyCommitYield1)) {
+					wait(delay(0, TaskPriority::ProxyCommitYield1));
+				}
+			}
+
+			CommitTransactionRef const& tr = trs[transactionNum].transaction;
+			MutationRef const& m = tr.mutations[mutationNum];
+			if (m.type == MutationRef::NoOp ||
+			    (!tr.encryptedMutations.empty() && tr.encryptedMutations[mutationNum].present())) {
+				continue;
+			}
+			yieldBytes += m.expectedSize();
+			self->preEncryptedMutations[transactionNum][mutationNum] = m.encrypt(*cipher, self->arena);
+		}
+	}
+	return Void();
+}
+
 ACTOR Future<Void> getResolution(CommitBatchContext* self) {
 	state double resolutionStart = now();
 	// Sending these requests is the fuzzy border between phase 1 and phase 2; it could conceivably overlap with
@@ -982,11 +1070,12 @@ ACTOR Future<Void> getResolution(CommitBatchContext* self) {
 		ASSERT(requests.requests[r].txnStateTransactions.size() == requests.requests[0].txnStateTransactions.size());
 
 	pProxyCommitData->stats.txnCommitResolving += trs.size();
-	std::vector<Future<ResolveTransactionBatchReply>> replies;
+	state std::vector<Future<ResolveTransactionBatchReply>> replies;
 	for (int r = 0; r < pProxyCommitData->resolvers.size(); r++) {
 		requests.requests[r].debugID = self->debugID;
 		requests.requests[r].writtenTags = self->writtenTagsPreResolution;
 		replies.push_back(trackResolutionMetrics(pProxyCommitData->stats.resolverDist[r],
+		                                         &self->resolverRtt,
 		                                         brokenPromiseToNever(pProxyCommitData->resolvers[r].resolve.getReply(
 		                                             requests.requests[r], TaskPriority::ProxyResolverReply))));
 	}
@@ -1031,6 +1120,14 @@ ACTOR Future<Void> getResolution(CommitBatchContext* self) {
 		self->pProxyCommitData->lastResolverReset = now();
 	}
 
+	if (pProxyCommitData->encryptMode.isEncryptionEnabled()) {
+		std::unordered_map<EncryptCipherDomainId, Reference<BlobCipherKey>> cipherKeys = wait(getCipherKeys);
+		self->cipherKeys = cipherKeys;
+		if (SERVER_KNOBS->PROXY_ENCRYPT_DURING_RESOLUTION) {
+			wait(preEncryptMutations(self));
+		}
+	}
+
 	// Wait for the final resolution
 	std::vector<ResolveTransactionBatchReply> resolutionResp = wait(getAll(replies));
 	self->resolution.swap(*const_cast<std::vector<ResolveTransactionBatchReply>*>(&resolutionResp));
@@ -1040,10 +1137,6 @@ ACTOR Future<Void> getResolution(CommitBatchContext* self) {
 		g_traceBatch.addEvent(
 		    "CommitDebug", self->debugID.get().first(), "CommitProxyServer.commitBatch.AfterResolution");
 	}
-	if (pProxyCommitData->encryptMode.isEncryptionEnabled()) {
-		std::unordered_map<EncryptCipherDomainId, Reference<BlobCipherKey>> cipherKeys = wait(getCipherKeys);
-		self->cipherKeys = cipherKeys;
-	}
 
 	return Void();
 }
@@ -1061,10 +1154,10 @@ void assertResolutionStateMutationsSizeConsistent(const std::vector<ResolveTrans
 }
 
 // Return true if a single-key mutation is associated with a valid tenant id or a system key
-bool validTenantAccess(MutationRef m, std::map<int64_t, TenantName> const& tenantMap, Optional<int64_t>& tenantId) {
+bool validTenantAccess(MutationRef m, std::unordered_set<int64_t> const& tenantIds, Optional<int64_t>& tenantId) {
 	if (isSingleKeyMutation((MutationRef::Type)m.type)) {
 		tenantId = TenantAPI::extractTenantIdFromMutation(m);
-		return tenantMap.count(tenantId.get()) > 0;
+		return tenantIds.count(tenantId.get()) > 0;
 	}
 	return true;
 }
@@ -1354,6 +1447,34 @@ TEST_CASE("/CommitProxy/SplitRange/replaceRawClearRanges") {
 	return Void();
 }
 
+TEST_CASE("/CommitProxy/CommitBatchingController") {
+	// Each batch takes the batching interval plus a resolver and a TLog round trip drawn from [rtt, 2 * rtt)
+	state double target = 0.03;
+	state double rtt = 0.004;
+	state CommitBatchingController controller;
+	state double interval = SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_MIN;
+	state int i = 0;
+	for (; i < 20000; i++) {
+		double resolverRtt = rtt * (1 + deterministicRandom()->random01());
+		double tlogRtt = rtt * (1 + deterministicRandom()->random01());
+		interval = controller.update(target, interval, interval + resolverRtt + tlogRtt, resolverRtt, tlogRtt);
+		ASSERT_GE(interval, SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_MIN);
+		ASSERT_LE(interval, std::max(SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_MIN,
+		                             std::min(SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_MAX, target - 2 * rtt)));
+		if (i % 1000 == 0) {
+			wait(yield());
+		}
+	}
+
+	// Unless the interval is pinned by the knobs, the p99 latency settles near the target
+	if (target - 4 * rtt > SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_MIN &&
+	    target - 2 * rtt < SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_MAX) {
+		ASSERT(std::abs(controller.getLatencyP99() - target) < 0.1 * target);
+		ASSERT(std::abs(controller.getResolverRtt() - 1.5 * rtt) < 0.5 * rtt);
+	}
+	return Void();
+}
+
 // Return success and properly split clear range mutations if all tenant check pass. Otherwise, return corresponding
 // error
 Error validateAndProcessTenantAccess(Arena& arena,
@@ -1389,7 +1510,7 @@ Error validateAndProcessTenantAccess(Arena& arena,
 				    .detail("NewClears", newClearSize);
 			}
 		} else if (!isSystemKey(mutation.param1)) {
-			validAccess = validTenantAccess(mutation, pProxyCommitData->tenantMap, tenantId);
+			validAccess = validTenantAccess(mutation, pProxyCommitData->tenantIdIndex, tenantId);
 			writeNormalKey = true;
 		}
 
@@ -1492,7 +1613,7 @@ void applyMetadataEffect(CommitBatchContext* self) {
 				// check if all tenant ids are valid if committed == true
 				committed = committed &&
 				            std::all_of(tenantIds.get().begin(), tenantIds.get().end(), [self](const int64_t& tid) {
-					            return self->pProxyCommitData->tenantMap.count(tid);
+					            return self->pProxyCommitData->tenantIdIndex.count(tid);
 				            });
 
 				if (self->debugID.present()) {
@@ -1725,7 +1846,8 @@ Future<WriteMutationRefVar> writeMutation(CommitBatchContext* self,
                                           int64_t domainId,
                                           const MutationRef* mutation,
                                           Optional<MutationRef>* encryptedMutationOpt,
-                                          Arena* arena) {
+                                          Arena* arena,
+                                          Optional<MutationRef> preEncryptedMutation = Optional<MutationRef>()) {
 	static_assert(TenantInfo::INVALID_TENANT == INVALID_ENCRYPT_DOMAIN_ID);
 
 	// WriteMutation routine is responsible for appending mutations to be persisted in TLog, the operation
@@ -1757,6 +1879,9 @@ Future<WriteMutationRefVar> writeMutation(CommitBatchContext* self,
 			if (g_network && g_network->isSimulated()) {
 				return writeMutationEncryptedMutation(self, domainId, mutation, encryptedMutationOpt, arena);
 			}
+		} else if (preEncryptedMutation.present()) {
+			CODE_PROBE(true, "using mutation encrypted during resolution");
+			encryptedMutation = preEncryptedMutation.get();
 		} else {
 			if (domainId == INVALID_ENCRYPT_DOMAIN_ID) {
 				domainId = getEncryptDetailsFromMutationRef(self->pProxyCommitData, *mutation);
@@ -1950,7 +2075,13 @@ ACTOR Future<Void> assignMutationsToStorageServers(CommitBatchContext* self) {
 				if (encryptedMutation.present()) {
 					ASSERT(encryptedMutation.get().isEncrypted());
 				}
-				WriteMutationRefVar var = wait(writeMutation(self, encryptDomain, &m, &encryptedMutation, &arena));
+				WriteMutationRefVar var =
+				    wait(writeMutation(self,
+				                       encryptDomain,
+				                       &m,
+				                       &encryptedMutation,
+				                       &arena,
+				                       self->getPreEncryptedMutation(self->transactionNum, mutationNum)));
 				// FIXME: Remove assert once ClearRange RAW_ACCESS usecase handling is done
 				ASSERT(std::holds_alternative<MutationRef>(var));
 				writtenMutation = std::get<MutationRef>(var);
@@ -2006,7 +2137,13 @@ ACTOR Future<Void> assignMutationsToStorageServers(CommitBatchContext* self) {
 				if (pProxyCommitData->needsCacheTag(clearRange)) {
 					self->toCommit.addTag(cacheTag);
 				}
-				WriteMutationRefVar var = wait(writeMutation(self, encryptDomain, &m, &encryptedMutation, &arena));
+				WriteMutationRefVar var =
+				    wait(writeMutation(self,
+				                       encryptDomain,
+				                       &m,
+				                       &encryptedMutation,
+				                       &arena,
+				                       self->getPreEncryptedMutation(self->transactionNum, mutationNum)));
 				// FIXME: Remove assert once ClearRange RAW_ACCESS usecase handling is done
 				ASSERT(std::holds_alternative<MutationRef>(var));
 				writtenMutation = std::get<MutationRef>(var);
@@ -2055,6 +2192,7 @@ ACTOR Future<Void> postResolution(CommitBatchContext* self) {
 	wait(pProxyCommitData->latestLocalCommitBatchLogging.whenAtLeast(localBatchNumber - 1));
 	state double postResolutionQueuing = now();
 	pProxyCommitData->stats.postResolutionDist->sampleSeconds(postResolutionQueuing - postResolutionStart);
+	self->phase.enter(pProxyCommitData->stats.batchesPostResolution);
 	wait(yield(TaskPriority::ProxyCommitYield1));
 
 	self->computeStart = g_network->timer();
@@ -2069,6 +2207,14 @@ ACTOR Future<Void> postResolution(CommitBatchContext* self) {
 	self->isMyFirstBatch = !pProxyCommitData->version.get();
 	self->previousCoordinators = pProxyCommitData->txnStateStore->readValue(coordinatorsKey).get();
 
+	// Size the TLog messages like those of the previous batch, but for no more than this batch can write, so that the
+	// mutations of a large batch are not copied again and again as the message buffers grow
+	pProxyCommitData->lastTLogMessageBytes.resize(pProxyCommitData->localTLogCount, 0);
+	for (int loc = 0; loc < pProxyCommitData->localTLogCount; loc++) {
+		int64_t bound = self->batchBytes + 64 * self->batchOperations;
+		self->toCommit.reserveMessageBytes(loc, std::min<int64_t>(pProxyCommitData->lastTLogMessageBytes[loc], bound));
+	}
+
 	assertResolutionStateMutationsSizeConsistent(self->resolution);
 
 	applyMetadataEffect(self);
@@ -2114,6 +2260,24 @@ ACTOR Future<Void> postResolution(CommitBatchContext* self) {
 		                        &self->computeStart));
 	}
 
+	auto writeIdempotencyIdSet = [&](const KeyValue& kv) {
+		MutationRef idempotencyIdSet;
+		idempotencyIdSet.type = MutationRef::Type::SetValue;
+		idempotencyIdSet.param1 = kv.key;
+		idempotencyIdSet.param2 = kv.value;
+		auto& tags = pProxyCommitData->tagsForKey(kv.key);
+		self->toCommit.addTags(tags);
+		if (self->pProxyCommitData->encryptMode.isEncryptionEnabled()) {
+			CODE_PROBE(true, "encrypting idempotency mutation");
+			EncryptCipherDomainId domainId = getEncryptDetailsFromMutationRef(self->pProxyCommitData, idempotencyIdSet);
+			MutationRef encryptedMutation =
+			    idempotencyIdSet.encrypt(self->cipherKeys, domainId, self->arena, BlobCipherMetrics::TLOG);
+			self->toCommit.writeTypedMessage(encryptedMutation);
+		} else {
+			self->toCommit.writeTypedMessage(idempotencyIdSet);
+		}
+	};
+	bool wroteIdempotencyIds = false;
 	buildIdempotencyIdMutations(self->trs,
 	                            self->idempotencyKVBuilder,
 	                            self->commitVersion,
@@ -2121,23 +2285,20 @@ ACTOR Future<Void> postResolution(CommitBatchContext* self) {
 	                            ConflictBatch::TransactionCommitted,
 	                            self->locked,
 	                            [&](const KeyValue& kv) {
-		                            MutationRef idempotencyIdSet;
-		                            idempotencyIdSet.type = MutationRef::Type::SetValue;
-		                            idempotencyIdSet.param1 = kv.key;
-		                            idempotencyIdSet.param2 = kv.value;
-		                            auto& tags = pProxyCommitData->tagsForKey(kv.key);
-		                            self->toCommit.addTags(tags);
-		                            if (self->pProxyCommitData->encryptMode.isEncryptionEnabled()) {
-			                            CODE_PROBE(true, "encrypting idempotency mutation");
-			                            EncryptCipherDomainId domainId =
-			                                getEncryptDetailsFromMutationRef(self->pProxyCommitData, idempotencyIdSet);
-			                            MutationRef encryptedMutation = idempotencyIdSet.encrypt(
-			                                self->cipherKeys, domainId, self->arena, BlobCipherMetrics::TLOG);
-			                            self->toCommit.writeTypedMessage(encryptedMutation);
-		                            } else {
-			                            self->toCommit.writeTypedMessage(idempotencyIdSet);
-		                            }
+		                            writeIdempotencyIdSet(kv);
+		                            wroteIdempotencyIds = true;
 	                            });
+	// The first batch with idempotency ids in each time bucket records its version in the time index, which lets the
+	// cleaner find old ids without searching them
+	if (wroteIdempotencyIds && SERVER_KNOBS->IDEMPOTENCY_ID_TIME_INDEX_BUCKET_SECONDS > 0) {
+		int64_t time = int64_t(now());
+		int64_t bucket = time - time % SERVER_KNOBS->IDEMPOTENCY_ID_TIME_INDEX_BUCKET_SECONDS;
+		if (bucket != pProxyCommitData->idempotencyIdTimeIndexBucket) {
+			pProxyCommitData->idempotencyIdTimeIndexBucket = bucket;
+			writeIdempotencyIdSet(KeyValue(KeyValueRef(idempotencyIdTimeIndexKeyFor(bucket),
+			                                           idempotencyIdTimeIndexValue(self->commitVersion, time))));
+		}
+	}
 	state int i = 0;
 	for (i = 0; i < pProxyCommitData->idempotencyClears.size(); i++) {
 		auto& tags = pProxyCommitData->tagsForKey(pProxyCommitData->idempotencyClears[i].param1);
@@ -2244,6 +2405,9 @@ ACTOR Future<Void> postResolution(CommitBatchContext* self) {
 
 	float ratio = self->toCommit.getEmptyMessageRatio();
 	pProxyCommitData->stats.commitBatchingEmptyMessageRatio.addMeasurement(ratio);
+	for (int loc = 0; loc < pProxyCommitData->lastTLogMessageBytes.size(); loc++) {
+		pProxyCommitData->lastTLogMessageBytes[loc] = self->toCommit.getMessageBytes(loc);
+	}
 
 	if (!self->forceRecovery) {
 		ASSERT(pProxyCommitData->latestLocalCommitBatchLogging.get() == self->localBatchNumber - 1);
@@ -2310,6 +2474,7 @@ ACTOR Future<Void> transactionLogging(CommitBatchContext* self) {
 	}
 
 	pProxyCommitData->lastCommitLatency = now() - self->commitStartTime;
+	self->tlogRtt = pProxyCommitData->lastCommitLatency;
 	pProxyCommitData->lastCommitTime = std::max(pProxyCommitData->lastCommitTime.get(), self->commitStartTime);
 
 	wait(yield(TaskPriority::ProxyCommitYield2));
@@ -2444,6 +2609,13 @@ ACTOR Future<Void> reply(CommitBatchContext* self) {
 		// TODO: filter if pipelined with large commit
 		const double duration = endTime - tr.requestTime();
 		pProxyCommitData->stats.commitLatencySample.addMeasurement(duration);
+		if (tr.clientQueueTime.present()) {
+			ProxyStats& stats = pProxyCommitData->stats;
+			stats.clientQueueBreakdown.addMeasurement(tr.clientQueueTime.get());
+			stats.batchWaitBreakdown.addMeasurement(std::max(0.0, self->startTime - tr.requestTime()));
+			stats.resolverBreakdown.addMeasurement(self->resolverRtt);
+			stats.tlogBreakdown.addMeasurement(self->tlogRtt);
+		}
 		if (pProxyCommitData->latencyBandConfig.present()) {
 			bool filter = self->maxTransactionBytes >
 			              pProxyCommitData->latencyBandConfig.get().commitConfig.maxCommitBytes.orDefault(
@@ -2492,14 +2664,25 @@ ACTOR Future<Void> reply(CommitBatchContext* self) {
 	}
 
 	// Dynamic batching for commits
-	double target_latency =
-	    (now() - self->startTime) * SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_LATENCY_FRACTION;
-	pProxyCommitData->commitBatchInterval =
-	    std::max(SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_MIN,
-	             std::min(SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_MAX,
-	                      target_latency * SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_SMOOTHER_ALPHA +
-	                          pProxyCommitData->commitBatchInterval *
-	                              (1 - SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_SMOOTHER_ALPHA)));
+	if (SERVER_KNOBS->COMMIT_BATCHING_TARGET_LATENCY > 0) {
+		// A transaction of this batch waited for up to the batch interval before the batch started
+		double latency = now() - self->startTime + pProxyCommitData->commitBatchInterval;
+		pProxyCommitData->commitBatchInterval =
+		    pProxyCommitData->commitBatchingController.update(SERVER_KNOBS->COMMIT_BATCHING_TARGET_LATENCY,
+		                                                      pProxyCommitData->commitBatchInterval,
+		                                                      latency,
+		                                                      self->resolverRtt,
+		                                                      self->tlogRtt);
+	} else {
+		double target_latency =
+		    (now() - self->startTime) * SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_LATENCY_FRACTION;
+		pProxyCommitData->commitBatchInterval =
+		    std::max(SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_MIN,
+		             std::min(SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_MAX,
+		                      target_latency * SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_SMOOTHER_ALPHA +
+		                          pProxyCommitData->commitBatchInterval *
+		                              (1 - SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_SMOOTHER_ALPHA)));
+	}
 
 	pProxyCommitData->stats.commitBatchingWindowSize.addMeasurement(pProxyCommitData->commitBatchInterval);
 	pProxyCommitData->commitBatchesMemBytesCount -= self->currentBatchMemBytesCount;
@@ -2527,6 +2710,7 @@ ACTOR Future<Void> commitBatch(ProxyCommitData* self,
 	context.pProxyCommitData->lastVersionTime = context.startTime;
 	++context.pProxyCommitData->stats.commitBatchIn;
 	context.setupTraceBatch();
+	context.phase.enter(self->stats.batchesPreresolution);
 
 	/////// Phase 1: Pre-resolution processing (CPU bound except waiting for a version # which is separately pipelined
 	/// and *should* be available by now (unless empty commit); ordered; currently atomic but could yield)
@@ -2537,17 +2721,21 @@ ACTOR Future<Void> commitBatch(ProxyCommitData* self,
 	}
 
 	/////// Phase 2: Resolution (waiting on the network; pipelined)
+	context.phase.enter(self->stats.batchesResolving);
 	wait(CommitBatch::getResolution(&context));
 
 	////// Phase 3: Post-resolution processing (CPU bound except for very rare situations; ordered; currently atomic but
 	/// doesn't need to be)
+	context.phase.enter(self->stats.batchesPostResolutionQueued);
 	wait(CommitBatch::postResolution(&context));
 
 	/////// Phase 4: Logging (network bound; pipelined up to MAX_READ_TRANSACTION_LIFE_VERSIONS (limited by loop above))
+	context.phase.enter(self->stats.batchesLogging);
 	wait(CommitBatch::transactionLogging(&context));
 
 	/////// Phase 5: Replies (CPU bound; no particular order required, though ordered execution would be best for
 	/// latency)
+	context.phase.enter(self->stats.batchesReplying);
 	wait(CommitBatch::reply(&context));
 
 	return Void();
@@ -2639,6 +2827,23 @@ ACTOR static Future<Void> tenantIdServer(CommitProxyInterface proxy,
 	}
 }
 
+// Hands each transaction of a client's commit batch to the commit stream, where it is batched like any other commit
+ACTOR static Future<Void> commitBatchServer(CommitProxyInterface proxy) {
+	loop {
+		CommitTransactionBatchRequest batch = waitNext(proxy.commitBatch.getFuture());
+		for (auto& req : batch.transactions) {
+			if (!req.verify()) {
+				req.reply.sendError(permission_denied());
+				TraceEvent(SevWarnAlways, "UnauthorizedAccessPrevented")
+				    .detail("RequestType", "CommitTransactionBatchRequest")
+				    .log();
+				continue;
+			}
+			proxy.commit.send(std::move(req));
+		}
+	}
+}
+
 ACTOR static Future<Void> doKeyServerLocationRequest(GetKeyServerLocationsRequest req, ProxyCommitData* commitData) {
 	// We can't respond to these requests until we have valid txnStateStore
 	getCurrentLineage()->modify(&TransactionLineage::operation) = TransactionLineage::Operation::GetKeyServersLocations;
@@ -3349,6 +3554,10 @@ struct TransactionStateResolveContext {
 ACTOR Future<Void> processCompleteTransactionStateRequest(TransactionStateResolveContext* pContext) {
 	state KeyRange txnKeys = allKeys;
 	state std::map<Tag, UID> tag_uid;
+	// Shards on the same team have identical keyServers values, so each distinct value is decoded and resolved to
+	// its storage servers only once per recovery.
+	state Arena teamInfoArena;
+	state std::unordered_map<StringRef, ServerCacheInfo> teamInfo;
 
 	RangeResult UIDtoTagMap = pContext->pTxnStateStore->readRange(serverTagKeys).get();
 	for (const KeyValueRef& kv : UIDtoTagMap) {
@@ -3374,10 +3583,11 @@ ACTOR Future<Void> processCompleteTransactionStateRequest(TransactionStateResolv
 
 		((KeyRangeRef&)txnKeys) = KeyRangeRef(keyAfter(data.back().key, txnKeys.arena()), txnKeys.end);
 
+		// The metadata mutations point into the range read instead of copying every key and value again
 		MutationsVec mutations;
+		mutations.arena().dependsOn(data.arena());
 		std::vector<std::pair<MapPair<Key, ServerCacheInfo>, int>> keyInfoData;
 		std::vector<UID> src, dest;
-		ServerCacheInfo info;
 		// NOTE: An ACTOR will be compiled into several classes, the this pointer is from one of them.
 		auto updateTagInfo = [pContext = pContext](const std::vector<UID>& uids,
 		                                           std::vector<Tag>& tags,
@@ -3391,7 +3601,7 @@ ACTOR Future<Void> processCompleteTransactionStateRequest(TransactionStateResolv
 		};
 		for (auto& kv : data) {
 			if (!kv.key.startsWith(keyServersPrefix)) {
-				mutations.emplace_back(mutations.arena(), MutationRef::SetValue, kv.key, kv.value);
+				mutations.push_back(mutations.arena(), MutationRef(MutationRef::SetValue, kv.key, kv.value));
 				continue;
 			}
 
@@ -3399,18 +3609,17 @@ ACTOR Future<Void> processCompleteTransactionStateRequest(TransactionStateResolv
 			if (k == allKeys.end) {
 				continue;
 			}
-			decodeKeyServersValue(tag_uid, kv.value, src, dest);
+			auto team = teamInfo.find(kv.value);
+			if (team == teamInfo.end()) {
+				decodeKeyServersValue(tag_uid, kv.value, src, dest);
 
-			info.tags.clear();
-
-			info.src_info.clear();
-			updateTagInfo(src, info.tags, info.src_info);
-
-			info.dest_info.clear();
-			updateTagInfo(dest, info.tags, info.dest_info);
-
-			uniquify(info.tags);
-			keyInfoData.emplace_back(MapPair<Key, ServerCacheInfo>(k, info), 1);
+				ServerCacheInfo info;
+				updateTagInfo(src, info.tags, info.src_info);
+				updateTagInfo(dest, info.tags, info.dest_info);
+				uniquify(info.tags);
+				team = teamInfo.emplace(StringRef(teamInfoArena, kv.value), std::move(info)).first;
+			}
+			keyInfoData.emplace_back(MapPair<Key, ServerCacheInfo>(k, team->second), 1);
 		}
 
 		// insert keyTag data separately from metadata mutations so that we can do one bulk insert which
@@ -3578,6 +3787,7 @@ ACTOR Future<Void> commitProxyServerCore(CommitProxyInterface proxy,
 
 	addActor.send(monitorRemoteCommitted(&commitData));
 	addActor.send(tenantIdServer(proxy, addActor, &commitData));
+	addActor.send(commitBatchServer(proxy));
 	addActor.send(readRequestServer(proxy, addActor, &commitData));
 	addActor.send(bgReadRequestServer(proxy, addActor, &commitData));
 	addActor.send(rejoinServer(proxy, &commitData));
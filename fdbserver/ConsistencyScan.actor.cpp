@@ -550,22 +550,66 @@ ACTOR Future<bool> checkDataConsistency(Database cx,
 					req.limitBytes = CLIENT_KNOBS->REPLY_BYTE_LIMIT;
 					req.version = version;
 					req.tags = TagSet();
+					// A scan touches each row once, so its reads shouldn't evict the storage engines' caches
+					req.options = ReadOptions(ReadType::LOW, CacheResult::False);
 
 					// Try getting the entries in the specified range
 					state std::vector<Future<ErrorOr<GetKeyValuesReply>>> keyValueFutures;
 					state int j = 0;
-					TraceEvent("ConsistencyCheck_StoringGetFutures").detail("SSISize", storageServerInterfaces.size());
-					for (j = 0; j < storageServerInterfaces.size(); j++) {
-						resetReply(req);
-						if (SERVER_KNOBS->ENABLE_VERSION_VECTOR) {
-							cx->getLatestCommitVersion(
-							    storageServerInterfaces[j], req.version, req.ssLatestCommitVersions);
+					state bool digestsMatched = false;
+					if (SERVER_KNOBS->CONSISTENCYSCAN_USE_DIGESTS && storageServerInterfaces.size() > 1) {
+						// Read the rows from the first server and only their digest from the others.  When every
+						// replica answers and agrees, the first server's rows are all the checks below need;
+						// otherwise every replica is read in full to find and report the differences.
+						for (j = 0; j < storageServerInterfaces.size(); j++) {
+							resetReply(req);
+							req.digestOnly = j > 0;
+							if (SERVER_KNOBS->ENABLE_VERSION_VECTOR) {
+								cx->getLatestCommitVersion(
+								    storageServerInterfaces[j], req.version, req.ssLatestCommitVersions);
+							}
+							keyValueFutures.push_back(
+							    storageServerInterfaces[j].getKeyValues.getReplyUnlessFailedFor(req, 2, 0));
+						}
+						req.digestOnly = false;
+
+						wait(waitForAll(keyValueFutures));
+
+						digestsMatched = keyValueFutures[0].get().present() &&
+						                 !keyValueFutures[0].get().get().error.present();
+						if (digestsMatched) {
+							GetKeyValuesReply const& rows = keyValueFutures[0].get().get();
+							uint64_t digest = getKeyValuesDigest(rows.data);
+							for (j = 1; j < keyValueFutures.size() && digestsMatched; j++) {
+								ErrorOr<GetKeyValuesReply> const& reply = keyValueFutures[j].get();
+								digestsMatched = reply.present() && !reply.get().error.present() &&
+								                 reply.get().digest == digest && reply.get().more == rows.more;
+							}
+						}
+						if (!digestsMatched) {
+							TraceEvent("ConsistencyCheck_DigestMismatch")
+							    .detail("ShardBegin", req.begin.getKey())
+							    .detail("ShardEnd", req.end.getKey())
+							    .detail("VersionNumber", req.version);
+							keyValueFutures.clear();
 						}
-						keyValueFutures.push_back(
-						    storageServerInterfaces[j].getKeyValues.getReplyUnlessFailedFor(req, 2, 0));
 					}
 
-					wait(waitForAll(keyValueFutures));
+					if (!digestsMatched) {
+						TraceEvent("ConsistencyCheck_StoringGetFutures")
+						    .detail("SSISize", storageServerInterfaces.size());
+						for (j = 0; j < storageServerInterfaces.size(); j++) {
+							resetReply(req);
+							if (SERVER_KNOBS->ENABLE_VERSION_VECTOR) {
+								cx->getLatestCommitVersion(
+								    storageServerInterfaces[j], req.version, req.ssLatestCommitVersions);
+							}
+							keyValueFutures.push_back(
+							    storageServerInterfaces[j].getKeyValues.getReplyUnlessFailedFor(req, 2, 0));
+						}
+
+						wait(waitForAll(keyValueFutures));
+					}
 
 					// Read the resulting entries
 					state int firstValidServer = -1;
@@ -579,7 +623,9 @@ ACTOR Future<bool> checkDataConsistency(Database cx,
 							TraceEvent("ConsistencyCheck_GetKeyValuesStream")
 							    .detail("DataSize", current.data.size())
 							    .detail(format("StorageServer%d", j).c_str(), storageServers[j].toString());
-							totalReadAmount += current.data.expectedSize();
+							// A replica that sent a digest still read the same rows as the first server
+							totalReadAmount += digestsMatched ? keyValueFutures[0].get().get().data.expectedSize()
+							                                  : current.data.expectedSize();
 							// If we haven't encountered a valid storage server yet, then mark this as the baseline
 							// to compare against
 							if (firstValidServer == -1) {
@@ -589,7 +635,8 @@ ACTOR Future<bool> checkDataConsistency(Database cx,
 							} else {
 								GetKeyValuesReply reference = keyValueFutures[firstValidServer].get().get();
 
-								if (current.data != reference.data || current.more != reference.more) {
+								if (!digestsMatched &&
+								    (current.data != reference.data || current.more != reference.more)) {
 									// Be especially verbose if in simulation
 									if (g_network->isSimulated()) {
 										int invalidIndex = -1;
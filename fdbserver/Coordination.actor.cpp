@@ -215,58 +215,98 @@ TEST_CASE("/fdbserver/Coordination/localGenerationReg/simple") {
 	return Void();
 }
 
-ACTOR Future<Void> openDatabase(ClientData* db,
-                                int* clientCount,
-                                Reference<AsyncVar<bool>> hasConnectedClients,
-                                OpenDatabaseCoordRequest req,
-                                Future<Void> checkStuck) {
-	state ErrorOr<CachedSerialization<ClientDBInfo>> replyContents;
-	state Future<Void> clientInfoOnChange = db->clientInfo->onChange();
-
-	++(*clientCount);
-	hasConnectedClients->set(true);
-
+static void finishOpenDatabase(ClientData* db,
+                               int* clientCount,
+                               Reference<AsyncVar<bool>> const& hasConnectedClients,
+                               OpenDatabaseCoordRequest const& req) {
 	if (req.supportedVersions.size() > 0 && !req.internal) {
-		db->clientStatusInfoMap[req.reply.getEndpoint().getPrimaryAddress()] =
-		    ClientStatusInfo(req.traceLogGroup, req.supportedVersions, req.issues);
+		db->clientStatusInfoMap.erase(req.reply.getEndpoint().getPrimaryAddress());
 	}
+	if (--(*clientCount) == 0) {
+		hasConnectedClients->set(false);
+	}
+}
 
-	while (!db->clientInfo->get().read().id.isValid() || (db->clientInfo->get().read().id == req.knownClientInfoID &&
-	                                                      !db->clientInfo->get().read().forward.present())) {
+// Answers the clients waiting for a ClientDBInfo newer than the one they know. All of a register's waiters are served
+// by this one actor, with one timer and one liveness check between them, so that when the ClientDBInfo changes during
+// a stampede of clients they are all answered in one pass with the same serialized reply.
+ACTOR Future<Void> openDatabaseWaiters(ClientData* db,
+                                       int* clientCount,
+                                       Reference<AsyncVar<bool>> hasConnectedClients,
+                                       LivenessChecker const* canConnectToLeader,
+                                       FutureStream<OpenDatabaseCoordRequest> requests) {
+	// Keyed by when each client is answered even if the ClientDBInfo hasn't changed; the client might be long gone
+	state std::multimap<double, OpenDatabaseCoordRequest> waiting;
+	state Future<Void> clientInfoOnChange = db->clientInfo->onChange();
+	state Future<Void> stuck = Never();
+	state Future<Void> timeout = Never();
+	state double timeoutAt = std::numeric_limits<double>::max();
+
+	loop {
 		choose {
-			when(wait(checkStuck)) {
-				replyContents = failed_to_progress();
-				break;
+			when(OpenDatabaseCoordRequest req = waitNext(requests)) {
+				if (db->clientInfo->get().read().id.isValid() && db->clientInfo->get().read().forward.present()) {
+					req.reply.sendError(default_error_or());
+				} else {
+					++(*clientCount);
+					hasConnectedClients->set(true);
+					if (req.supportedVersions.size() > 0 && !req.internal) {
+						db->clientStatusInfoMap[req.reply.getEndpoint().getPrimaryAddress()] =
+						    ClientStatusInfo(req.traceLogGroup, req.supportedVersions, req.issues);
+					}
+					if (waiting.empty()) {
+						stuck = canConnectToLeader->checkStuck();
+					}
+					double jitter = FLOW_KNOBS->DELAY_JITTER_OFFSET +
+					                FLOW_KNOBS->DELAY_JITTER_RANGE * deterministicRandom()->random01();
+					waiting.emplace(now() + SERVER_KNOBS->CLIENT_REGISTER_INTERVAL * jitter, req);
+				}
 			}
 			when(wait(yieldedFuture(clientInfoOnChange))) {
 				clientInfoOnChange = db->clientInfo->onChange();
-				replyContents = db->clientInfo->get();
+				ClientDBInfo const& info = db->clientInfo->get().read();
+				if (info.id.isValid()) {
+					for (auto it = waiting.begin(); it != waiting.end();) {
+						if (info.id != it->second.knownClientInfoID || info.forward.present()) {
+							it->second.reply.send(db->clientInfo->get());
+							finishOpenDatabase(db, clientCount, hasConnectedClients, it->second);
+							it = waiting.erase(it);
+						} else {
+							++it;
+						}
+					}
+				}
 			}
-			when(wait(delayJittered(SERVER_KNOBS->CLIENT_REGISTER_INTERVAL))) {
-				if (db->clientInfo->get().read().id.isValid()) {
-					replyContents = db->clientInfo->get();
+			when(wait(stuck)) {
+				for (auto& w : waiting) {
+					w.second.reply.sendError(failed_to_progress());
+					finishOpenDatabase(db, clientCount, hasConnectedClients, w.second);
 				}
-				// Otherwise, we still break out of the loop and return a default_error_or.
-				break;
-			} // The client might be long gone!
+				waiting.clear();
+			}
+			when(wait(timeout)) {
+				while (!waiting.empty() && waiting.begin()->first <= now()) {
+					OpenDatabaseCoordRequest& req = waiting.begin()->second;
+					if (db->clientInfo->get().read().id.isValid()) {
+						req.reply.send(db->clientInfo->get());
+					} else {
+						req.reply.sendError(default_error_or());
+					}
+					finishOpenDatabase(db, clientCount, hasConnectedClients, req);
+					waiting.erase(waiting.begin());
+				}
+			}
 		}
-	}
 
-	if (req.supportedVersions.size() > 0 && !req.internal) {
-		db->clientStatusInfoMap.erase(req.reply.getEndpoint().getPrimaryAddress());
-	}
-
-	if (replyContents.present()) {
-		req.reply.send(replyContents.get());
-	} else {
-		req.reply.sendError(replyContents.getError());
-	}
-
-	if (--(*clientCount) == 0) {
-		hasConnectedClients->set(false);
+		if (waiting.empty()) {
+			stuck = Never();
+			timeout = Never();
+			timeoutAt = std::numeric_limits<double>::max();
+		} else if (waiting.begin()->first != timeoutAt) {
+			timeoutAt = waiting.begin()->first;
+			timeout = delayUntil(timeoutAt);
+		}
 	}
-
-	return Void();
 }
 
 ACTOR Future<Void> remoteMonitorLeader(int* clientCount,
@@ -320,6 +360,9 @@ ACTOR Future<Void> leaderRegister(LeaderElectionRegInterface interf, Key key) {
 	    makeReference<AsyncVar<Optional<LeaderInfo>>>();
 	state LivenessChecker canConnectToLeader(SERVER_KNOBS->COORDINATOR_LEADER_CONNECTION_TIMEOUT);
 	state Future<Void> hasConnectedClientsOnChange = hasConnectedClients->onChange();
+	state PromiseStream<OpenDatabaseCoordRequest> openDatabaseRequests;
+	actors.add(openDatabaseWaiters(
+	    &clientData, &clientCount, hasConnectedClients, &canConnectToLeader, openDatabaseRequests.getFuture()));
 
 	loop choose {
 		when(OpenDatabaseCoordRequest req = waitNext(interf.openDatabase.getFuture())) {
@@ -332,8 +375,7 @@ ACTOR Future<Void> leaderRegister(LeaderElectionRegInterface interf, Key key) {
 					leaderMon = monitorLeaderAndGetClientInfo(
 					    req.clusterKey, req.hostnames, req.coordinators, &clientData, currentElectedLeader);
 				}
-				actors.add(
-				    openDatabase(&clientData, &clientCount, hasConnectedClients, req, canConnectToLeader.checkStuck()));
+				openDatabaseRequests.send(req);
 			}
 		}
 		when(ElectionResultRequest req = waitNext(interf.electionResult.getFuture())) {
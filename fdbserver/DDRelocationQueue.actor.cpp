@@ -24,6 +24,7 @@
 
 #include "flow/ActorCollection.h"
 #include "flow/FastRef.h"
+#include "flow/IRateControl.h"
 #include "flow/Trace.h"
 #include "flow/Util.h"
 #include "fdbrpc/sim_validation.h"
@@ -519,6 +520,14 @@ ACTOR Future<Void> dataDistributionRelocator(struct DDQueue* self,
                                              Future<Void> prevCleanup,
                                              const DDEnabledState* ddEnabledState);
 
+static Reference<IRateControl> makeMoveBytesLimit() {
+	if (SERVER_KNOBS->DD_MOVE_BYTES_PER_SECOND <= 0) {
+		return Reference<IRateControl>(new Unlimited());
+	}
+	int64_t limit = std::min<int64_t>(SERVER_KNOBS->DD_MOVE_BYTES_PER_SECOND, std::numeric_limits<int>::max());
+	return Reference<IRateControl>(new SpeedLimit(limit, 1.0));
+}
+
 struct DDQueue : public IDDRelocationQueue {
 	struct DDDataMove {
 		DDDataMove() = default;
@@ -639,6 +648,8 @@ struct DDQueue : public IDDRelocationQueue {
 	FlowLock finishMoveKeysParallelismLock;
 	FlowLock cleanUpDataMoveParallelismLock;
 	Reference<FlowLock> fetchSourceLock;
+	// Paces the shard bytes of relocations that are not repairing unhealthy teams to DD_MOVE_BYTES_PER_SECOND
+	Reference<IRateControl> moveBytesLimit;
 
 	int activeRelocations;
 	int queuedRelocations;
@@ -763,7 +774,8 @@ struct DDQueue : public IDDRelocationQueue {
 	    startMoveKeysParallelismLock(SERVER_KNOBS->DD_MOVE_KEYS_PARALLELISM),
 	    finishMoveKeysParallelismLock(SERVER_KNOBS->DD_MOVE_KEYS_PARALLELISM),
 	    cleanUpDataMoveParallelismLock(SERVER_KNOBS->DD_MOVE_KEYS_PARALLELISM),
-	    fetchSourceLock(new FlowLock(SERVER_KNOBS->DD_FETCH_SOURCE_PARALLELISM)), activeRelocations(0),
+	    fetchSourceLock(new FlowLock(SERVER_KNOBS->DD_FETCH_SOURCE_PARALLELISM)),
+	    moveBytesLimit(makeMoveBytesLimit()), activeRelocations(0),
 	    queuedRelocations(0), bytesWritten(0), teamSize(teamSize), singleRegionTeamSize(singleRegionTeamSize),
 	    output(output), input(input), getShardMetrics(getShardMetrics), getTopKMetrics(getTopKMetrics), lastInterval(0),
 	    suppressIntervals(0), rawProcessingUnhealthy(new AsyncVar<bool>(false)),
@@ -1478,6 +1490,11 @@ ACTOR Future<Void> dataDistributionRelocator(DDQueue* self,
 		state StorageMetrics metrics =
 		    wait(brokenPromiseToNever(self->getShardMetrics.getReply(GetMetricsRequest(rd.keys))));
 
+		if (rd.priority < SERVER_KNOBS->PRIORITY_TEAM_UNHEALTHY && !rd.isRestore()) {
+			wait(self->moveBytesLimit->getAllowance(
+			    std::min<int64_t>(metrics.bytes, std::numeric_limits<unsigned int>::max())));
+		}
+
 		state std::unordered_set<uint64_t> excludedDstPhysicalShards;
 
 		ASSERT(rd.src.size());
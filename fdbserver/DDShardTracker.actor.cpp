@@ -19,6 +19,7 @@
  */
 
 #include "fdbclient/FDBTypes.h"
+#include "fdbclient/ManagementAPI.actor.h"
 #include "fdbclient/StorageServerInterface.h"
 #include "fdbrpc/FailureMonitor.h"
 #include "fdbclient/SystemData.h"
@@ -100,6 +101,8 @@ struct DataDistributionTracker : public IDDShardTracker {
 
 	// Read hot detection
 	PromiseStream<KeyRange> readHotShard;
+	// Read-hot ranges added to the storage cache, by begin key, with their end key and when they were last read-hot
+	std::map<Key, std::pair<Key, double>> cachedReadHotRanges;
 
 	// The reference to trackerCancelled must be extracted by actors,
 	// because by the time (trackerCancelled == true) this memory cannot
@@ -227,6 +230,13 @@ std::pair<ShardSizeBounds, bool> calculateShardSizeBounds(
 			bounds.max.bytesWrittenPerKSecond = SERVER_KNOBS->SHARD_MAX_BYTES_PER_KSEC;
 			bounds.min.bytesWrittenPerKSecond = SERVER_KNOBS->SHARD_MIN_BYTES_PER_KSEC;
 			bounds.permittedError.bytesWrittenPerKSecond = bounds.min.bytesWrittenPerKSecond / 4;
+			if (SERVER_KNOBS->SHARD_WRITE_TREND_HORIZON > 0) {
+				// Narrower bounds around the current bandwidth give the write trend enough samples
+				auto bandwidth = shardMetrics->get().get().metrics.bytesWrittenPerKSecond;
+				auto& maxBandwidth = bounds.max.bytesWrittenPerKSecond;
+				maxBandwidth = std::min(maxBandwidth, std::max(bandwidth * 3 / 2, bounds.min.bytesWrittenPerKSecond));
+				bounds.min.bytesWrittenPerKSecond = std::max(bounds.min.bytesWrittenPerKSecond, bandwidth * 2 / 3);
+			}
 		} else if (bandwidthStatus == BandwidthStatusHigh) { // > 10MB/sec for 100MB shard, proportionally lower
 			                                                 // for smaller shard, > 200KB/sec no matter what
 			bounds.max.bytesWrittenPerKSecond = bounds.max.infinity;
@@ -273,6 +283,10 @@ ACTOR Future<Void> trackShardMetrics(DataDistributionTracker::SafeAccessor self,
 	    shardMetrics->get().present() ? shardMetrics->get().get().lastLowBandwidthStartTime : now();
 	state int shardCount = shardMetrics->get().present() ? shardMetrics->get().get().shardCount : 1;
 	state bool initWithNewMetrics = whenDDInit;
+	state double lastWriteSampleTime = now();
+	state int64_t lastWriteBandwidth =
+	    shardMetrics->get().present() ? shardMetrics->get().get().metrics.bytesWrittenPerKSecond : 0;
+	state double writeBandwidthSlope = 0; // Smoothed change in bytesWrittenPerKSecond per second
 	wait(delay(0, TaskPriority::DataDistribution));
 
 	/*TraceEvent("TrackShardMetricsStarting")
@@ -351,7 +365,21 @@ ACTOR Future<Void> trackShardMetrics(DataDistributionTracker::SafeAccessor self,
 						}
 					}
 
-					shardMetrics->set(ShardMetrics(metrics.first.get(), lastLowBandwidthStartTime, shardCount));
+					ShardMetrics newMetrics(metrics.first.get(), lastLowBandwidthStartTime, shardCount);
+					if (SERVER_KNOBS->SHARD_WRITE_TREND_HORIZON > 0) {
+						int64_t bandwidth = metrics.first.get().bytesWrittenPerKSecond;
+						double elapsed = now() - lastWriteSampleTime;
+						if (elapsed > 0) {
+							writeBandwidthSlope =
+							    SERVER_KNOBS->SHARD_WRITE_TREND_SMOOTHING * (bandwidth - lastWriteBandwidth) / elapsed +
+							    (1 - SERVER_KNOBS->SHARD_WRITE_TREND_SMOOTHING) * writeBandwidthSlope;
+						}
+						lastWriteSampleTime = now();
+						lastWriteBandwidth = bandwidth;
+						newMetrics.projectedBytesWrittenPerKSecond =
+						    bandwidth + std::max(writeBandwidthSlope, 0.0) * SERVER_KNOBS->SHARD_WRITE_TREND_HORIZON;
+					}
+					shardMetrics->set(newMetrics);
 					break;
 				} else {
 					shardCount = metrics.second;
@@ -373,11 +401,65 @@ ACTOR Future<Void> trackShardMetrics(DataDistributionTracker::SafeAccessor self,
 	}
 }
 
+// Adds read-hot ranges to the storage cache, or keeps them there if they already overlap a cached read-hot range.
+ACTOR Future<Void> cacheReadHotRanges(DataDistributionTracker* self,
+                                      Standalone<VectorRef<ReadHotRangeWithMetrics>> readHotRanges) {
+	state int i;
+	for (i = 0; i < readHotRanges.size(); i++) {
+		state KeyRange keys = readHotRanges[i].keys;
+		bool alreadyCached = false;
+		for (auto& [begin, cached] : self->cachedReadHotRanges) {
+			if (begin < keys.end && keys.begin < cached.first) {
+				cached.second = now();
+				alreadyCached = true;
+			}
+		}
+		if (alreadyCached) {
+			continue;
+		}
+
+		wait(ManagementAPI::addCachedRange(self->db->context().getReference(), keys));
+		self->cachedReadHotRanges[keys.begin] = std::make_pair(keys.end, now());
+		TraceEvent("DDCachedReadHotRange", self->distributorId).detail("Range", keys);
+	}
+	return Void();
+}
+
+// Removes read-hot ranges from the storage cache once they have not been read-hot for DD_READ_HOT_CACHE_DURATION.
+ACTOR Future<Void> uncacheCooledReadHotRanges(DataDistributionTracker* self) {
+	try {
+		loop {
+			wait(delay(SERVER_KNOBS->DD_READ_HOT_CACHE_DURATION / 2, TaskPriority::DataDistribution));
+
+			state std::vector<KeyRange> cooled;
+			for (auto it = self->cachedReadHotRanges.begin(); it != self->cachedReadHotRanges.end();) {
+				if (now() - it->second.second > SERVER_KNOBS->DD_READ_HOT_CACHE_DURATION) {
+					cooled.push_back(KeyRangeRef(it->first, it->second.first));
+					it = self->cachedReadHotRanges.erase(it);
+				} else {
+					++it;
+				}
+			}
+
+			state int i;
+			for (i = 0; i < cooled.size(); i++) {
+				wait(ManagementAPI::removeCachedRange(self->db->context().getReference(), cooled[i]));
+				TraceEvent("DDUncachedReadHotRange", self->distributorId).detail("Range", cooled[i]);
+			}
+		}
+	} catch (Error& e) {
+		if (e.code() != error_code_actor_cancelled) {
+			self->output.sendError(e); // Propagate failure to dataDistributionTracker
+		}
+		throw e;
+	}
+}
+
 ACTOR Future<Void> readHotDetector(DataDistributionTracker* self) {
 	try {
 		loop {
 			state KeyRange keys = waitNext(self->readHotShard.getFuture());
-			Standalone<VectorRef<ReadHotRangeWithMetrics>> readHotRanges = wait(self->db->getReadHotRanges(keys));
+			state Standalone<VectorRef<ReadHotRangeWithMetrics>> readHotRanges = wait(self->db->getReadHotRanges(keys));
 
 			for (const auto& keyRange : readHotRanges) {
 				TraceEvent("ReadHotRangeLog")
@@ -387,6 +469,10 @@ ACTOR Future<Void> readHotDetector(DataDistributionTracker* self) {
 				    .detail("KeyRangeBegin", keyRange.keys.begin)
 				    .detail("KeyRangeEnd", keyRange.keys.end);
 			}
+
+			if (SERVER_KNOBS->DD_CACHE_READ_HOT_RANGES && !self->db->isMocked()) {
+				wait(cacheReadHotRanges(self, readHotRanges));
+			}
 		}
 	} catch (Error& e) {
 		if (e.code() != error_code_actor_cancelled) {
@@ -1138,8 +1224,14 @@ ACTOR Future<Void> shardEvaluator(DataDistributionTracker* self,
 	StorageMetrics const& stats = shardSize->get().get().metrics;
 	auto bandwidthStatus = getBandwidthStatus(stats);
 
+	// A shard that is not hot yet, but soon will be by its write trend, is split early if it already has enough
+	// bandwidth to be split by it
+	bool trendSplit = SERVER_KNOBS->SHARD_WRITE_TREND_HORIZON > 0 && bandwidthStatus == BandwidthStatusNormal &&
+	                  shardSize->get().get().projectedBytesWrittenPerKSecond > SERVER_KNOBS->SHARD_MAX_BYTES_PER_KSEC &&
+	                  stats.bytesWrittenPerKSecond > 2 * SERVER_KNOBS->SHARD_SPLIT_BYTES_PER_KSEC;
+	CODE_PROBE(trendSplit, "Shard split by its write bandwidth trend");
 	bool sizeSplit = stats.bytes > shardBounds.max.bytes,
-	     writeSplit = bandwidthStatus == BandwidthStatusHigh && keys.begin < keyServersKeys.begin;
+	     writeSplit = (bandwidthStatus == BandwidthStatusHigh || trendSplit) && keys.begin < keyServersKeys.begin;
 	bool shouldSplit = sizeSplit || writeSplit;
 
 	auto prevIter = self->shards->rangeContaining(keys.begin);
@@ -1492,6 +1584,9 @@ ACTOR Future<Void> dataDistributionTracker(Reference<InitialDataDistribution> in
 	                                   ddTenantCache);
 	state Future<Void> loggingTrigger = Void();
 	state Future<Void> readHotDetect = readHotDetector(&self);
+	state Future<Void> readHotUncache = SERVER_KNOBS->DD_CACHE_READ_HOT_RANGES && !self.db->isMocked()
+	                                        ? uncacheCooledReadHotRanges(&self)
+	                                        : Never();
 	state Reference<EventCacheHolder> ddTrackerStatsEventHolder = makeReference<EventCacheHolder>("DDTrackerStats");
 	try {
 		wait(trackInitialShards(&self, initData));
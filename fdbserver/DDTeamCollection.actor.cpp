@@ -266,29 +266,32 @@ public:
 				int bestIndex = startIndex;
 				for (int i = 0; i < self->teams.size(); i++) {
 					int currentIndex = (startIndex + i) % self->teams.size();
-					if (self->teams[currentIndex]->isHealthy() &&
-					    (!req.preferLowerDiskUtil ||
-					     self->teams[currentIndex]->hasHealthyAvailableSpace(self->medianAvailableSpace))) {
-						int64_t loadBytes = self->teams[currentIndex]->getLoadBytes(true, req.inflightPenalty);
-						if ((!req.teamMustHaveShards ||
-						     self->shardsAffectedByTeamFailure->hasShards(ShardsAffectedByTeamFailure::Team(
-						         self->teams[currentIndex]->getServerIDs(), self->primary))) &&
-						    // sort conditions
-						    (!bestOption.present() ||
-						     req.lessCompare(bestOption.get(), self->teams[currentIndex], bestLoadBytes, loadBytes))) {
-
-							// bestOption doesn't contain wiggling SS while current team does. Don't replace bestOption
-							// in this case
-							if (bestOption.present() && !wigglingBestOption &&
-							    self->teams[currentIndex]->hasWigglePausedServer()) {
-								continue;
-							}
-							bestLoadBytes = loadBytes;
-							bestOption = self->teams[currentIndex];
-							bestIndex = currentIndex;
-							wigglingBestOption = self->teams[bestIndex]->hasWigglePausedServer();
-						}
+					const Reference<TCTeamInfo>& team = self->teams[currentIndex];
+					if (!team->isHealthy() ||
+					    (req.preferLowerDiskUtil && !team->hasHealthyAvailableSpace(self->medianAvailableSpace))) {
+						continue;
+					}
+					int64_t loadBytes = team->getLoadBytes(true, req.inflightPenalty);
+					// sort conditions
+					if (bestOption.present() && !req.lessCompare(bestOption.get(), team, bestLoadBytes, loadBytes)) {
+						continue;
+					}
+					// bestOption doesn't contain wiggling SS while current team does. Don't replace bestOption in this
+					// case
+					if (bestOption.present() && !wigglingBestOption && team->hasWigglePausedServer()) {
+						continue;
+					}
+					// Looking up the team's shards is the most expensive check, so only do it for a team that would
+					// otherwise become the best option
+					if (req.teamMustHaveShards &&
+					    !self->shardsAffectedByTeamFailure->hasShards(
+					        ShardsAffectedByTeamFailure::Team(team->getServerIDs(), self->primary))) {
+						continue;
 					}
+					bestLoadBytes = loadBytes;
+					bestOption = team;
+					bestIndex = currentIndex;
+					wigglingBestOption = team->hasWigglePausedServer();
 				}
 
 				startIndex = bestIndex;
@@ -883,6 +886,13 @@ public:
 						    .detail("TeamID", team->getTeamID())
 						    .detail("Shards", shards.size());
 
+						// With physical shards, adjacent shards that share their teams and priority are moved together
+						// so that each data move can ship the physical shard's files instead of many small ranges
+						int maxCoalescedShards = SERVER_KNOBS->ENABLE_DD_PHYSICAL_SHARD
+						                             ? std::max(1, SERVER_KNOBS->DD_PHYSICAL_SHARD_COALESCE_MAX_SHARDS)
+						                             : 1;
+						std::vector<RelocateShard> relocations;
+						int coalescedShards = 0;
 						for (int i = 0; i < shards.size(); i++) {
 							// Make it high priority to move keys off failed server or else RelocateShards may never be
 							// addressed
@@ -946,9 +956,23 @@ public:
 								}
 							}
 
-							RelocateShard rs(
-							    shards[i], maxPriority, RelocateReason::OTHER, deterministicRandom()->randomUniqueID());
+							if (!relocations.empty() && coalescedShards < maxCoalescedShards &&
+							    relocations.back().keys.end == shards[i].begin &&
+							    relocations.back().priority == maxPriority &&
+							    self->shardsAffectedByTeamFailure->getTeamsForFirstShard(relocations.back().keys) ==
+							        self->shardsAffectedByTeamFailure->getTeamsForFirstShard(shards[i])) {
+								relocations.back().keys = KeyRangeRef(relocations.back().keys.begin, shards[i].end);
+								coalescedShards++;
+							} else {
+								relocations.emplace_back(shards[i],
+								                         maxPriority,
+								                         RelocateReason::OTHER,
+								                         deterministicRandom()->randomUniqueID());
+								coalescedShards = 1;
+							}
+						}
 
+						for (auto const& rs : relocations) {
 							self->output.send(rs);
 							TraceEvent("SendRelocateToDDQueue", self->distributorId)
 							    .suppressFor(1.0)
@@ -1112,7 +1136,9 @@ public:
 				// wiggler.
 				auto invalidWiggleServer =
 				    [](const AddressExclusion& addr, const DDTeamCollection* tc, const TCServerInfo* server) {
-					    return !tc->wigglingId.present() || server->getId() != tc->wigglingId.get();
+					    return (!tc->wigglingId.present() || server->getId() != tc->wigglingId.get()) &&
+					           std::find(tc->zoneWigglingIds.begin(), tc->zoneWigglingIds.end(), server->getId()) ==
+					               tc->zoneWigglingIds.end();
 				    };
 				// If the storage server is in the excluded servers list, it is undesired
 				NetworkAddress a = server->getLastKnownInterface().address();
@@ -2102,12 +2128,17 @@ public:
 						when(wait(self->waitUntilHealthy())) {
 							CODE_PROBE(true, "start wiggling");
 							wait(self->storageWiggler->startWiggle());
-							auto fv = self->excludeStorageServersForWiggle(id);
-							moveFinishFuture = fv;
+							std::vector<Future<Void>> moves{ self->excludeStorageServersForWiggle(id) };
+							self->zoneWigglingIds = self->getZoneServersToWiggle(id);
+							for (auto const& zoneServer : self->zoneWigglingIds) {
+								moves.push_back(self->excludeStorageServersForWiggle(zoneServer));
+							}
+							moveFinishFuture = waitForAll(moves);
 							self->storageWiggler->setWiggleState(StorageWiggler::RUN);
 							TraceEvent("PerpetualStorageWiggleStart", self->distributorId)
 							    .detail("Primary", self->primary)
 							    .detail("ServerId", id)
+							    .detail("ZoneServers", describe(self->zoneWigglingIds))
 							    .detail("ExtraHealthyTeamCount", extraTeamCount)
 							    .detail("HealthyTeamCount", self->healthyTeamCount);
 						}
@@ -2140,6 +2171,7 @@ public:
 					wait(self->eraseStorageWiggleMap(&metadataMap, self->wigglingId.get()) &&
 					     self->storageWiggler->finishWiggle());
 					self->wigglingId.reset();
+					self->zoneWigglingIds.clear();
 					nextFuture = waitAndForward(nextStream);
 					finishStorageWiggleSignal.send(Void());
 					extraTeamCount = std::max(0, extraTeamCount - 1);
@@ -2158,6 +2190,7 @@ public:
 			    .detail("Primary", self->primary)
 			    .detail("ServerId", self->wigglingId.get());
 			self->wigglingId.reset();
+			self->zoneWigglingIds.clear();
 		}
 
 		return Void();
@@ -3740,7 +3773,9 @@ void DDTeamCollection::removeLaggingStorageServer(Key zoneId) {
 }
 
 bool DDTeamCollection::isWigglePausedServer(const UID& server) const {
-	return pauseWiggle && pauseWiggle->get() && wigglingId == server;
+	return pauseWiggle && pauseWiggle->get() &&
+	       (wigglingId == server ||
+	        std::find(zoneWigglingIds.begin(), zoneWigglingIds.end(), server) != zoneWigglingIds.end());
 }
 
 std::vector<UID> DDTeamCollection::getRandomHealthyTeam(const UID& excludeServer) {
@@ -5139,6 +5174,28 @@ Future<Void> DDTeamCollection::excludeStorageServersForWiggle(const UID& id) {
 	return moveFuture;
 }
 
+std::vector<UID> DDTeamCollection::getZoneServersToWiggle(const UID& id) const {
+	std::vector<UID> result;
+	auto it = server_info.find(id);
+	if (SERVER_KNOBS->PERPETUAL_WIGGLE_ZONE_SERVERS <= 0 || it == server_info.end()) {
+		return result;
+	}
+	auto zoneId = it->second->getLastKnownInterface().locality.zoneId();
+	if (!zoneId.present()) {
+		return result;
+	}
+	for (auto const& [serverId, server] : server_info) {
+		if ((int)result.size() >= SERVER_KNOBS->PERPETUAL_WIGGLE_ZONE_SERVERS) {
+			break;
+		}
+		if (serverId != id && server->getLastKnownInterface().locality.zoneId() == zoneId &&
+		    storageWiggler->isDue(serverId) && !server_status.get(serverId).isUnhealthy()) {
+			result.push_back(serverId);
+		}
+	}
+	return result;
+}
+
 void DDTeamCollection::includeStorageServersForWiggle() {
 	bool included = false;
 	for (auto& address : this->wiggleAddresses) {
@@ -166,6 +166,11 @@ bool StorageWiggler::necessary(const UID& serverId, const StorageMetadataType& m
 	return metadata.wrongConfigured || (now() - metadata.createdTime > SERVER_KNOBS->DD_STORAGE_WIGGLE_MIN_SS_AGE_SEC);
 }
 
+bool StorageWiggler::isDue(const UID& serverId) const {
+	auto it = pq_handles.find(serverId);
+	return it != pq_handles.end() && necessary(serverId, (*it->second).first);
+}
+
 Optional<UID> StorageWiggler::getNextServerId(bool necessaryOnly) {
 	if (!wiggle_pq.empty()) {
 		auto [metadata, id] = wiggle_pq.top();
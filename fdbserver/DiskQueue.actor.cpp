@@ -91,12 +91,21 @@ struct StringBuffer {
 				    .detail("Reserved", reserved)
 				    .backtrace();
 			}
-			uint8_t* b = new (str.arena()) uint8_t[reserved + alignment - 1];
-			uint8_t* e = b + (reserved + alignment - 1);
+			uint8_t* p;
+			if (4096 % alignment == 0) {
+				// Page aligned buffers come from the shared aligned buffer cache, which also backs pager pages, so
+				// the large read and push buffers are recycled rather than over-allocated and aligned by hand.
+				reserved = (reserved + 4095) & ~4095;
+				p = (uint8_t*)str.arena().allocate4kAlignedBuffer(reserved);
+				ASSERT(int64_t(p) % alignment == 0);
+			} else {
+				uint8_t* b = new (str.arena()) uint8_t[reserved + alignment - 1];
+				uint8_t* e = b + (reserved + alignment - 1);
 
-			uint8_t* p = (uint8_t*)(int64_t(b + alignment - 1) &
-			                        ~(alignment - 1)); // first multiple of alignment greater than or equal to b
-			ASSERT(p >= b && p + reserved <= e && int64_t(p) % alignment == 0);
+				p = (uint8_t*)(int64_t(b + alignment - 1) &
+				               ~(alignment - 1)); // first multiple of alignment greater than or equal to b
+				ASSERT(p >= b && p + reserved <= e && int64_t(p) % alignment == 0);
+			}
 
 			if (str.size() > 0) {
 				memcpy(p, str.begin(), str.size());
@@ -173,7 +182,8 @@ public:
 	  : basename(basename), fileExtension(fileExtension), dbgid(dbgid), dbg_file0BeginSeq(0),
 	    fileSizeWarningLimit(fileSizeWarningLimit), onError(delayed(error.getFuture())), onStopped(stopped.getFuture()),
 	    readyToPush(Void()), lastCommit(Void()), isFirstCommit(true), readingBuffer(dbgid), readingFile(-1),
-	    readingPage(-1), writingPos(-1), fileExtensionBytes(SERVER_KNOBS->DISK_QUEUE_FILE_EXTENSION_BYTES),
+	    readingPage(-1), readAheadFile(-1), readAheadPage(-1), writingPos(-1),
+	    fileExtensionBytes(SERVER_KNOBS->DISK_QUEUE_FILE_EXTENSION_BYTES),
 	    fileShrinkBytes(SERVER_KNOBS->DISK_QUEUE_FILE_SHRINK_BYTES) {
 		if (BUGGIFY)
 			fileExtensionBytes = _PAGE_SIZE * deterministicRandom()->randomSkewedUInt32(1, 10 << 10);
@@ -183,13 +193,13 @@ public:
 		files[1].dbgFilename = filename(1);
 		// We issue reads into firstPages, so it needs to be 4k aligned.
 		firstPages.reserve(firstPages.arena(), 2);
-		void* pageMemory = operator new(sizeof(Page) * 3, firstPages.arena());
+		void* pageMemory = firstPages.arena().allocate4kAlignedBuffer(sizeof(Page) * 2);
 		// firstPages is assumed to always be a valid page, and our initialization here is the only
 		// time that it would not contain a valid page.  Whenever DiskQueue reaches in to look at
 		// these bytes, it only cares about `seq`, and having that be all 0xFF's means uninitialized
 		// pages will look like the ultimate end of the disk queue, rather than the beginning of it.
 		// This makes code fail in more immediate and obvious ways.
-		firstPages[0] = (Page*)((((uintptr_t)pageMemory + 4095) / 4096) * 4096);
+		firstPages[0] = (Page*)pageMemory;
 		memset(firstPages[0], 0xFF, sizeof(Page));
 		firstPages[1] = (Page*)((uintptr_t)firstPages[0] + 4096);
 		memset(firstPages[1], 0xFF, sizeof(Page));
@@ -216,6 +226,8 @@ public:
 		    .detail("File0Name", files[0].dbgFilename);
 		readingFile = file;
 		readingPage = page;
+		readAheadFile = file;
+		readAheadPage = page;
 	}
 
 	Future<Void> setPoppedPage(int file, int64_t page, int64_t debugSeq) {
@@ -261,7 +273,7 @@ public:
 
 		void setFile(Reference<IAsyncFile> f) {
 			this->f = f;
-			this->syncQueue = makeReference<SyncQueue>(1, f);
+			this->syncQueue = makeReference<SyncQueue>(SERVER_KNOBS->DISK_QUEUE_MAX_OUTSTANDING_SYNCS, f);
 		}
 	};
 	File files[2]; // After readFirstAndLastPages(), files[0] is logically before files[1] (pushes are always into
@@ -288,6 +300,16 @@ public:
 	                 // files[readingFile]. readingFile = 2 if recovery is complete (all files have been read).
 	int64_t readingPage; // Page within readingFile that is the next page after readingBuffer
 
+	struct ReadAhead {
+		int file;
+		int64_t page;
+		Standalone<StringRef> buffer;
+		Future<int> read;
+	};
+	std::deque<ReadAhead> readAhead; // Recovery reads issued past readingBuffer, in queue order
+	int readAheadFile; // File and page where the next read ahead will start
+	int64_t readAheadPage;
+
 	int64_t writingPos; // Position within files[1] that will be next written
 
 	int64_t fileExtensionBytes;
@@ -760,31 +782,62 @@ public:
 		return result;
 	}
 
-	Future<int> fillReadingBuffer() {
-		// If we're right at the end of a file...
-		if (readingPage * sizeof(Page) >= (size_t)files[readingFile].size) {
-			readingFile++;
-			readingPage = 0;
-			if (readingFile >= 2) {
-				// Recovery complete
-				readingBuffer.clear();
-				writingPos = files[1].size;
-				return 0;
+	// The read owns its buffer and is tracked, so a read ahead can be dropped without waiting for it and shutdown
+	// still waits for the IO before the files go away.
+	ACTOR static UNCANCELLABLE Future<int> readChunk(RawDiskQueue_TwoFiles* self,
+	                                                 int file,
+	                                                 int64_t pos,
+	                                                 Standalone<StringRef> buffer) {
+		state TrackMe trackMe(self);
+		int bytesRead = wait(self->files[file].f->read(mutateString(buffer), buffer.size(), pos));
+		return bytesRead;
+	}
+
+	// Keeps up to DISK_QUEUE_RECOVERY_READ_AHEAD reads outstanding past readingBuffer, so recovery is not waiting on
+	// one read at a time.
+	void issueReadAhead() {
+		while (readAheadFile < 2 && readAhead.size() < SERVER_KNOBS->DISK_QUEUE_RECOVERY_READ_AHEAD) {
+			// If we're right at the end of a file...
+			if (readAheadPage * sizeof(Page) >= (size_t)files[readAheadFile].size) {
+				readAheadFile++;
+				readAheadPage = 0;
+				continue;
 			}
+
+			int len = std::min<int64_t>((files[readAheadFile].size / sizeof(Page) - readAheadPage) * sizeof(Page),
+			                            BUGGIFY_WITH_PROB(1.0)
+			                                ? sizeof(Page) * deterministicRandom()->randomInt(1, 4)
+			                                : SERVER_KNOBS->DISK_QUEUE_RECOVERY_READ_BYTES / sizeof(Page) * sizeof(Page));
+			ReadAhead r;
+			r.file = readAheadFile;
+			r.page = readAheadPage;
+			r.buffer = makeAlignedString(sizeof(Page), len);
+			r.read = readChunk(this, readAheadFile, readAheadPage * sizeof(Page), r.buffer);
+			readAheadPage += len / sizeof(Page);
+			readAhead.push_back(std::move(r));
 		}
+	}
 
-		// Read up to 1MB into readingBuffer
-		int len = std::min<int64_t>((files[readingFile].size / sizeof(Page) - readingPage) * sizeof(Page),
-		                            BUGGIFY_WITH_PROB(1.0) ? sizeof(Page) * deterministicRandom()->randomInt(1, 4)
-		                                                   : (1 << 20));
+	Future<int> fillReadingBuffer() {
 		readingBuffer.clear();
-		readingBuffer.alignReserve(sizeof(Page), len);
-		void* p = readingBuffer.append(len);
+		issueReadAhead();
+		if (readAhead.empty()) {
+			// Recovery complete
+			readingFile = 2;
+			writingPos = files[1].size;
+			return 0;
+		}
+
+		ReadAhead next = std::move(readAhead.front());
+		readAhead.pop_front();
+		readingFile = next.file;
+		readingPage = next.page + next.buffer.size() / sizeof(Page);
+		readingBuffer.str = next.buffer;
+		readingBuffer.reserved = next.buffer.size();
+		ASSERT(int64_t(readingBuffer.str.begin()) % sizeof(Page) == 0);
 
-		auto pos = readingPage * sizeof(Page);
-		readingPage += len / sizeof(Page);
-		ASSERT(int64_t(p) % sizeof(Page) == 0);
-		return files[readingFile].f->read(p, len, pos);
+		issueReadAhead();
+		return next.read;
 	}
 
 	ACTOR static UNCANCELLABLE Future<Standalone<StringRef>> readNextPage(RawDiskQueue_TwoFiles* self) {
@@ -850,6 +903,8 @@ public:
 
 			self->readingFile = 2;
 			self->readingBuffer.clear();
+			self->readAhead.clear();
+			self->readAheadFile = 2;
 			self->writingPos = pos;
 
 			while (file < 2) {
@@ -702,6 +702,12 @@ ACTOR Future<Void> sendGrvReplies(Future<GetReadVersionReply> replyFuture,
 	GetReadVersionReply reply = _reply;
 	Version replyVersion = reply.version;
 
+	// Untagged requests to remote clients which get the same reply, grouped by the version, the version vector base and
+	// the throttled duration, which are the only parts of the reply that differ between them
+	std::map<std::tuple<Version, Version, double>,
+	         std::pair<GetReadVersionReply, std::vector<ReplyPromise<GetReadVersionReply>>>>
+	    sharedReplies;
+
 	double end = g_network->timer();
 	for (GetReadVersionRequest const& request : requests) {
 		double duration = end - request.requestTime() - request.proxyTagThrottledDuration;
@@ -731,6 +737,12 @@ ACTOR Future<Void> sendGrvReplies(Future<GetReadVersionReply> replyFuture,
 		}
 		reply.proxyId = grvProxyData->dbgid;
 		reply.proxyTagThrottledDuration = request.proxyTagThrottledDuration;
+		if (SERVER_KNOBS->GRV_CACHE_LEASE_DURATION > 0) {
+			// Versions handed out from a cache would bypass the throttling
+			reply.cacheLease = stats->lastDefaultQueueThrottled || stats->lastBatchQueueThrottled
+			                       ? 0.0
+			                       : SERVER_KNOBS->GRV_CACHE_LEASE_DURATION;
+		}
 
 		if (request.isTagged()) {
 			auto& priorityThrottledTags = clientThrottledTags[request.priority];
@@ -769,10 +781,38 @@ ACTOR Future<Void> sendGrvReplies(Future<GetReadVersionReply> replyFuture,
 				reply.rkDefaultThrottled = true;
 			}
 		}
-		request.reply.send(reply);
+		if (SERVER_KNOBS->GRV_PROXY_SHARE_REPLY_SERIALIZATION && !request.isTagged() &&
+		    request.reply.isRemoteEndpoint()) {
+			auto& shared = sharedReplies[std::make_tuple(reply.version,
+			                                             SERVER_KNOBS->ENABLE_VERSION_VECTOR ? request.maxVersion : 0,
+			                                             reply.proxyTagThrottledDuration)];
+			if (shared.second.empty()) {
+				shared.first = reply;
+			}
+			shared.second.push_back(request.reply);
+		} else {
+			request.reply.send(reply);
+		}
 		++stats->txnRequestOut;
 	}
 
+	// Where several clients get the same reply, serialize it once and send its bytes to each of them, and then
+	// release their promises without sending anything more
+	for (auto& [_, shared] : sharedReplies) {
+		auto& [sharedReply, promises] = shared;
+		if (promises.size() == 1) {
+			promises[0].send(sharedReply);
+			continue;
+		}
+		CODE_PROBE(true, "GRV proxy shares the serialization of a reply");
+		ErrorOr<EnsureTable<GetReadVersionReply>> message(sharedReply);
+		PreserializedSource<ErrorOr<EnsureTable<GetReadVersionReply>>> source(message, g_network->protocolVersion());
+		for (auto& promise : promises) {
+			FlowTransport::transport().sendUnreliable(source, promise.getEndpoint(), false);
+			promise.send(Never());
+		}
+	}
+
 	return Void();
 }
 
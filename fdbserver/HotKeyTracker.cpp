@@ -0,0 +1,173 @@
+/*
+ * HotKeyTracker.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <map>
+
+#include "flow/UnitTest.h"
+#include "fdbserver/HotKeyTracker.h"
+
+HotKeySketch::HotKeySketch(int capacity) : capacity(std::max(capacity, 1)) {
+	heap.reserve(this->capacity);
+}
+
+void HotKeySketch::add(KeyRef key, int64_t count) {
+	total += count;
+	auto it = positions.find(key);
+	if (it != positions.end()) {
+		int i = it->second;
+		heap[i].count += count;
+		siftDown(i);
+		return;
+	}
+
+	if (heap.size() < capacity) {
+		heap.push_back(Entry{ Key(key), count });
+		int i = heap.size() - 1;
+		positions[heap[i].key] = i;
+		while (i > 0 && heap[(i - 1) / 2].count > heap[i].count) {
+			swapEntries(i, (i - 1) / 2);
+			i = (i - 1) / 2;
+		}
+		return;
+	}
+
+	// Replace the least frequent key
+	positions.erase(heap[0].key);
+	heap[0].key = Key(key);
+	heap[0].count += count;
+	positions[heap[0].key] = 0;
+	siftDown(0);
+}
+
+int64_t HotKeySketch::getCount(KeyRef key) const {
+	auto it = positions.find(key);
+	return it == positions.end() ? 0 : heap[it->second].count;
+}
+
+void HotKeySketch::clear() {
+	positions.clear();
+	heap.clear();
+	total = 0;
+}
+
+void HotKeySketch::siftDown(int i) {
+	int n = heap.size();
+	loop {
+		int smallest = i;
+		for (int c = 2 * i + 1; c <= 2 * i + 2 && c < n; c++) {
+			if (heap[c].count < heap[smallest].count)
+				smallest = c;
+		}
+		if (smallest == i)
+			return;
+		swapEntries(i, smallest);
+		i = smallest;
+	}
+}
+
+void HotKeySketch::swapEntries(int i, int j) {
+	std::swap(heap[i], heap[j]);
+	positions[heap[i].key] = i;
+	positions[heap[j].key] = j;
+}
+
+HotKeyTracker::HotKeyTracker(int capacity, double sampleRate, double windowSeconds)
+  : sampleRate(sampleRate), windowSeconds(windowSeconds), current(capacity), previous(capacity),
+    currentStart(now()) {}
+
+void HotKeyTracker::roll() {
+	double elapsed = now() - currentStart;
+	if (elapsed < windowSeconds)
+		return;
+	if (elapsed < 2 * windowSeconds) {
+		std::swap(current, previous);
+		previousDuration = elapsed;
+	} else {
+		// Nothing was sampled for a whole window, so the current counts are too old to keep either
+		previous.clear();
+		previousDuration = 0;
+	}
+	current.clear();
+	currentStart = now();
+}
+
+void HotKeyTracker::addSample(KeyRef key) {
+	roll();
+	current.add(key);
+}
+
+std::vector<std::pair<Key, double>> HotKeyTracker::getHotKeys(KeyRangeRef range) {
+	roll();
+	std::map<Key, int64_t> counts;
+	auto addCounts = [&](KeyRef key, int64_t count) {
+		if (range.contains(key))
+			counts[Key(key)] += count;
+	};
+	current.forEach(addCounts);
+	previous.forEach(addCounts);
+
+	double seconds = std::max(previousDuration + now() - currentStart, 1e-3);
+	std::vector<std::pair<Key, double>> result;
+	result.reserve(counts.size());
+	for (auto const& [key, count] : counts) {
+		result.emplace_back(key, count / sampleRate / seconds);
+	}
+	return result;
+}
+
+TEST_CASE("/fdbserver/HotKeyTracker/Sketch") {
+	HotKeySketch sketch(4);
+	// Zipf-like: key i is added 64 >> i times, interleaved with many keys seen once
+	for (int round = 0; round < 64; round++) {
+		for (int i = 0; i < 4; i++) {
+			if (round % (1 << i) == 0)
+				sketch.add(StringRef(format("hot%d", i)));
+		}
+		sketch.add(StringRef(format("cold%d", round)));
+	}
+	ASSERT(sketch.size() == 4);
+	ASSERT(sketch.getTotal() == 64 + 32 + 16 + 8 + 64);
+	// Keys seen more than total / capacity times must be tracked, with a count no lower than their true count
+	ASSERT(sketch.getCount("hot0"_sr) >= 64);
+
+	int64_t sum = 0;
+	sketch.forEach([&](KeyRef, int64_t count) { sum += count; });
+	ASSERT(sum == sketch.getTotal());
+
+	sketch.clear();
+	ASSERT(sketch.size() == 0 && sketch.getCount("hot0"_sr) == 0);
+	return Void();
+}
+
+TEST_CASE("/fdbserver/HotKeyTracker/Rates") {
+	HotKeyTracker tracker(8, 1.0, 1e6);
+	for (int i = 0; i < 100; i++) {
+		tracker.add("a"_sr);
+		tracker.add("b"_sr);
+		tracker.add("b"_sr);
+	}
+	tracker.add("z"_sr);
+
+	auto hot = tracker.getHotKeys(KeyRangeRef("a"_sr, "c"_sr));
+	ASSERT(hot.size() == 2);
+	ASSERT(hot[0].first == "a"_sr && hot[1].first == "b"_sr);
+	ASSERT(hot[1].second > hot[0].second * 1.9 && hot[1].second < hot[0].second * 2.1);
+	return Void();
+}
@@ -0,0 +1,229 @@
+/*
+ * HotRowCache.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <deque>
+#include <vector>
+
+#include "flow/UnitTest.h"
+#include "fdbserver/HotRowCache.h"
+
+namespace {
+// A rough count of the memory used by a map node, its entry and the arenas of its key and value
+constexpr int64_t entryOverheadBytes = 128;
+} // namespace
+
+HotRowCache::HotRowCache(int64_t capacityBytes, int maxValueBytes)
+  : capacityBytes(capacityBytes), maxValueBytes(maxValueBytes) {}
+
+Optional<Optional<Value>> HotRowCache::get(KeyRef key) {
+	auto it = entries.find(key);
+	if (it == entries.end() || it->second.fillToken)
+		return Optional<Optional<Value>>();
+	lru.splice(lru.end(), lru, lru.iterator_to(it->second));
+	return it->second.value;
+}
+
+uint64_t HotRowCache::beginFill(KeyRef key) {
+	if (key.size() + entryOverheadBytes > capacityBytes)
+		return 0;
+	auto [it, inserted] = entries.try_emplace(Key(key));
+	if (!inserted)
+		return 0;
+
+	Entry& e = it->second;
+	e.key = it->first;
+	e.fillToken = nextFillToken++;
+	lru.push_back(e);
+	setSize(e, key.size() + entryOverheadBytes);
+	uint64_t token = e.fillToken;
+	evict();
+	return token;
+}
+
+void HotRowCache::endFill(KeyRef key, uint64_t token, const Optional<Value>& value) {
+	if (!token)
+		return;
+	auto it = entries.find(key);
+	// The key was invalidated or evicted while it was being read
+	if (it == entries.end() || it->second.fillToken != token)
+		return;
+	if (value.present() && value.get().size() > maxValueBytes) {
+		erase(it);
+		return;
+	}
+
+	Entry& e = it->second;
+	e.fillToken = 0;
+	// Copy the value so that the entry doesn't keep alive whatever arena storage returned it in
+	if (value.present())
+		e.value = Value(StringRef(value.get()));
+	lru.splice(lru.end(), lru, lru.iterator_to(e));
+	setSize(e, key.size() + e.value.expectedSize() + entryOverheadBytes);
+	evict();
+}
+
+void HotRowCache::abandonFill(KeyRef key, uint64_t token) {
+	auto it = entries.find(key);
+	if (token && it != entries.end() && it->second.fillToken == token)
+		erase(it);
+}
+
+void HotRowCache::invalidate(KeyRangeRef range) {
+	uncommitted.push_back_deep(uncommitted.arena(), range);
+	eraseRange(range);
+}
+
+void HotRowCache::invalidate(KeyRef key) {
+	uncommitted.push_back(uncommitted.arena(), singleKeyRange(key, uncommitted.arena()));
+	auto it = entries.find(key);
+	if (it != entries.end())
+		erase(it);
+}
+
+uint64_t HotRowCache::beginCommit() {
+	uint64_t commitId = nextCommitId++;
+	committing[commitId] = std::move(uncommitted);
+	uncommitted = Standalone<VectorRef<KeyRangeRef>>();
+	return commitId;
+}
+
+void HotRowCache::endCommit(uint64_t commitId) {
+	auto it = committing.find(commitId);
+	ASSERT(it != committing.end());
+	for (const KeyRangeRef& range : it->second)
+		eraseRange(range);
+	committing.erase(it);
+}
+
+void HotRowCache::clear() {
+	lru.clear();
+	entries.clear();
+	bytes = 0;
+}
+
+void HotRowCache::erase(std::map<Key, Entry, std::less<>>::iterator it) {
+	lru.erase(lru.iterator_to(it->second));
+	bytes -= it->second.size;
+	entries.erase(it);
+}
+
+void HotRowCache::eraseRange(KeyRangeRef range) {
+	if (entries.empty())
+		return;
+	if (range.singleKeyRange()) {
+		auto it = entries.find(range.begin);
+		if (it != entries.end())
+			erase(it);
+		return;
+	}
+	auto it = entries.lower_bound(range.begin);
+	while (it != entries.end() && it->first < range.end)
+		erase(it++);
+}
+
+void HotRowCache::setSize(Entry& e, int64_t size) {
+	bytes += size - e.size;
+	e.size = size;
+}
+
+void HotRowCache::evict() {
+	while (bytes > capacityBytes) {
+		ASSERT(!lru.empty());
+		erase(entries.find(lru.front().key));
+		++evictions;
+	}
+}
+
+// Checks the cache against a storage engine model whose reads see only committed writes, with reads that complete out
+// of order and commits interleaved with writes, so that fills race with invalidations.
+TEST_CASE("/fdbserver/HotRowCache/Model") {
+	HotRowCache cache(deterministicRandom()->randomInt(200, 4000), deterministicRandom()->randomInt(0, 10));
+	std::map<std::string, std::string> committed;
+	// Writes to [begin, end), which set a value if end is the key after begin and value is present
+	struct Write {
+		std::string begin, end;
+		Optional<std::string> value;
+	};
+	std::vector<Write> uncommitted;
+	std::deque<std::pair<uint64_t, std::vector<Write>>> committing;
+
+	struct Read {
+		std::string key;
+		uint64_t token;
+		Optional<Value> value;
+	};
+	std::vector<Read> reads;
+
+	auto randomKey = []() { return std::string(1, 'a' + deterministicRandom()->randomInt(0, 20)); };
+	auto committedValue = [&](const std::string& key) {
+		auto it = committed.find(key);
+		return it == committed.end() ? Optional<Value>() : Optional<Value>(Value(it->second));
+	};
+
+	int hits = 0;
+	for (int i = 0; i < 20000; i++) {
+		int op = deterministicRandom()->randomInt(0, 10);
+		if (op < 3) {
+			std::string key = randomKey();
+			Optional<Optional<Value>> cached = cache.get(StringRef(key));
+			if (cached.present()) {
+				ASSERT(cached.get() == committedValue(key));
+				hits++;
+			} else {
+				reads.push_back(Read{ key, cache.beginFill(StringRef(key)), committedValue(key) });
+			}
+		} else if (op < 6 && !reads.empty()) {
+			int r = deterministicRandom()->randomInt(0, reads.size());
+			cache.endFill(StringRef(reads[r].key), reads[r].token, reads[r].value);
+			reads[r] = reads.back();
+			reads.pop_back();
+		} else if (op < 8) {
+			std::string key = randomKey();
+			Optional<std::string> value;
+			if (deterministicRandom()->coinflip())
+				value = std::string(deterministicRandom()->randomInt(0, 12), 'v' + i % 3);
+			if (!value.present() && deterministicRandom()->random01() < 0.1) {
+				std::string end = randomKey();
+				if (end < key)
+					std::swap(key, end);
+				cache.invalidate(KeyRangeRef(StringRef(key), StringRef(end)));
+				uncommitted.push_back(Write{ key, end, value });
+			} else {
+				cache.invalidate(StringRef(key));
+				uncommitted.push_back(Write{ key, key + '\0', value });
+			}
+		} else if (op < 9) {
+			committing.emplace_back(cache.beginCommit(), std::move(uncommitted));
+			uncommitted.clear();
+		} else if (!committing.empty()) {
+			for (const Write& w : committing.front().second) {
+				if (w.value.present())
+					committed[w.begin] = w.value.get();
+				else
+					committed.erase(committed.lower_bound(w.begin), committed.lower_bound(w.end));
+			}
+			cache.endCommit(committing.front().first);
+			committing.pop_front();
+		}
+		ASSERT(cache.getBytes() >= 0);
+	}
+	ASSERT(hits > 0);
+	return Void();
+}
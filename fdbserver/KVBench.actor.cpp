@@ -0,0 +1,445 @@
+/*
+ * KVBench.actor.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// The 'kvbench' role: replays a mutation/read trace, or runs a YCSB style workload, against a single IKeyValueStore and
+// prints throughput, latency percentiles, write amplification and space amplification as one JSON object on stdout.
+
+#include <fstream>
+#include <map>
+
+#include "fdbclient/JsonBuilder.h"
+#include "fdbclient/NativeAPI.actor.h"
+#include "fdbclient/zipf.h"
+#include "fdbserver/IKeyValueStore.h"
+#include "flow/Platform.h"
+#include "flow/actorcompiler.h" // This must be the last #include.
+
+namespace {
+
+struct KVBenchOp {
+	enum Type { Set, Clear, Get, Range, Commit };
+	Type type = Commit;
+	Key a;
+	Key b;
+	int limit = 0;
+};
+
+// Trace files are text, one operation per line, with fields separated by tabs and keys and values escaped the way
+// printable() escapes them:
+//   set <key> <value>
+//   clear <begin> <end>
+//   get <key>
+//   range <begin> <end> <limit>
+//   commit
+// Empty lines and lines starting with '#' are ignored.
+class KVBenchTraceSource {
+public:
+	explicit KVBenchTraceSource(std::string const& filename) : in(filename), filename(filename) {
+		if (!in.is_open()) {
+			throw file_not_found();
+		}
+	}
+
+	bool next(KVBenchOp& op) {
+		std::string line;
+		while (std::getline(in, line)) {
+			++lineNumber;
+			if (line.empty() || line[0] == '#') {
+				continue;
+			}
+			std::vector<std::string> fields;
+			size_t start = 0;
+			while (true) {
+				size_t tab = line.find('\t', start);
+				fields.push_back(unprintable(line.substr(start, tab == std::string::npos ? tab : tab - start)));
+				if (tab == std::string::npos) {
+					break;
+				}
+				start = tab + 1;
+			}
+
+			std::string const& verb = fields[0];
+			if (verb == "set" && fields.size() == 3) {
+				op = KVBenchOp{ KVBenchOp::Set, Key(fields[1]), Key(fields[2]) };
+			} else if (verb == "clear" && fields.size() == 3) {
+				op = KVBenchOp{ KVBenchOp::Clear, Key(fields[1]), Key(fields[2]) };
+			} else if (verb == "get" && fields.size() == 2) {
+				op = KVBenchOp{ KVBenchOp::Get, Key(fields[1]) };
+			} else if (verb == "range" && fields.size() == 4) {
+				op = KVBenchOp{ KVBenchOp::Range, Key(fields[1]), Key(fields[2]), atoi(fields[3].c_str()) };
+			} else if (verb == "commit" && fields.size() == 1) {
+				op = KVBenchOp{ KVBenchOp::Commit };
+			} else {
+				fprintf(stderr, "ERROR: %s:%d: unrecognized trace line\n", filename.c_str(), lineNumber);
+				throw io_error();
+			}
+			return true;
+		}
+		return false;
+	}
+
+private:
+	std::ifstream in;
+	std::string filename;
+	int lineNumber = 0;
+};
+
+// Generates the core YCSB workloads over keys "user<n>" chosen with YCSB's zipfian distribution:
+//   a: 50% reads, 50% updates
+//   b: 95% reads, 5% updates
+//   c: 100% reads
+//   e: 95% short scans, 5% inserts
+// A commit is issued after every batchSize mutations.
+class KVBenchYCSBSource {
+public:
+	KVBenchYCSBSource(char workload, int records, int operations, int valueBytes, int batchSize)
+	  : workload(workload), records(records), operations(operations), valueBytes(valueBytes), batchSize(batchSize),
+	    inserted(records) {
+		zipfian_generator(records);
+	}
+
+	static bool validWorkload(char w) { return w == 'a' || w == 'b' || w == 'c' || w == 'e'; }
+
+	static Key makeKey(int64_t n) { return Key(fmt::format("user{:012}", n)); }
+
+	Key makeValue() const { return Key(deterministicRandom()->randomAlphaNumeric(valueBytes)); }
+
+	// The load phase inserts every record in key order
+	bool nextLoad(KVBenchOp& op) {
+		if (loadMutations == batchSize || (loaded == records && loadMutations > 0)) {
+			loadMutations = 0;
+			op = KVBenchOp{ KVBenchOp::Commit };
+			return true;
+		}
+		if (loaded == records) {
+			return false;
+		}
+		++loadMutations;
+		op = KVBenchOp{ KVBenchOp::Set, makeKey(loaded++), makeValue() };
+		return true;
+	}
+
+	bool next(KVBenchOp& op) {
+		if (mutations == batchSize || (done == operations && mutations > 0)) {
+			mutations = 0;
+			op = KVBenchOp{ KVBenchOp::Commit };
+			return true;
+		}
+		if (done == operations) {
+			return false;
+		}
+		++done;
+		double r = deterministicRandom()->random01();
+		double readFraction = workload == 'a' ? 0.5 : workload == 'c' ? 1.0 : 0.95;
+		if (r < readFraction) {
+			Key key = makeKey(zipfian_next());
+			if (workload == 'e') {
+				op = KVBenchOp{ KVBenchOp::Range, key, allKeys.end, deterministicRandom()->randomInt(1, 101) };
+			} else {
+				op = KVBenchOp{ KVBenchOp::Get, key };
+			}
+		} else {
+			++mutations;
+			Key key = workload == 'e' ? makeKey(inserted++) : makeKey(zipfian_next());
+			op = KVBenchOp{ KVBenchOp::Set, key, makeValue() };
+		}
+		return true;
+	}
+
+private:
+	char workload;
+	int records;
+	int operations;
+	int valueBytes;
+	int batchSize;
+	int64_t inserted;
+	int loaded = 0;
+	int loadMutations = 0;
+	int done = 0;
+	int mutations = 0;
+};
+
+class KVBenchLatencies {
+public:
+	void add(double seconds) { samples.push_back(seconds); }
+
+	JsonBuilderObject toJson() {
+		JsonBuilderObject obj;
+		obj["count"] = (int64_t)samples.size();
+		if (samples.empty()) {
+			return obj;
+		}
+		std::sort(samples.begin(), samples.end());
+		double sum = 0;
+		for (double s : samples) {
+			sum += s;
+		}
+		obj["mean"] = sum / samples.size();
+		obj["p50"] = percentile(0.5);
+		obj["p90"] = percentile(0.9);
+		obj["p99"] = percentile(0.99);
+		obj["p99.9"] = percentile(0.999);
+		obj["max"] = samples.back();
+		return obj;
+	}
+
+private:
+	double percentile(double p) const { return samples[std::min<size_t>(samples.size() * p, samples.size() - 1)]; }
+
+	std::vector<double> samples;
+};
+
+struct KVBenchStats {
+	KVBenchLatencies get;
+	KVBenchLatencies range;
+	KVBenchLatencies commit;
+	int64_t operations = 0; // Every operation but commits
+	int64_t sets = 0;
+	int64_t clears = 0;
+	int64_t logicalBytesWritten = 0;
+
+	// Key and value bytes of every live key, kept to compute space amplification
+	std::map<Key, int64_t> live;
+	int64_t liveBytes = 0;
+
+	void applySet(KeyRef key, ValueRef value) {
+		++sets;
+		logicalBytesWritten += key.size() + value.size();
+		auto [it, inserted] = live.try_emplace(Key(key), 0);
+		liveBytes += key.size() + value.size() - it->second;
+		it->second = key.size() + value.size();
+	}
+
+	void applyClear(KeyRangeRef range) {
+		++clears;
+		auto begin = live.lower_bound(range.begin);
+		auto end = live.lower_bound(range.end);
+		for (auto it = begin; it != end; ++it) {
+			liveBytes -= it->second;
+		}
+		live.erase(begin, end);
+	}
+};
+
+// Bytes this process caused to be sent to the storage layer, or -1 where that isn't available
+int64_t processDiskBytesWritten() {
+#ifdef __linux__
+	std::ifstream io("/proc/self/io");
+	std::string name;
+	int64_t value;
+	while (io >> name >> value) {
+		if (name == "write_bytes:") {
+			return value;
+		}
+	}
+#endif
+	return -1;
+}
+
+int64_t directoryBytes(std::string const& directory) {
+	std::vector<std::string> files;
+	platform::findFilesRecursively(directory, files);
+	int64_t total = 0;
+	for (auto const& f : files) {
+		total += fileSize(f);
+	}
+	return total;
+}
+
+int envInt(const char* name, int defaultValue) {
+	const char* value = getenv(name);
+	return value != nullptr ? atoi(value) : defaultValue;
+}
+
+// Runs ops from source until it is exhausted, recording latencies and the logical effect of mutations in stats
+ACTOR template <class Source>
+Future<Void> kvBenchRun(IKeyValueStore* store, Source* source, bool load, KVBenchStats* stats) {
+	state KVBenchOp op;
+	state double start;
+	loop {
+		if (!(load ? source->nextLoad(op) : source->next(op))) {
+			break;
+		}
+		start = timer();
+		stats->operations += op.type != KVBenchOp::Commit;
+		if (op.type == KVBenchOp::Set) {
+			store->set(KeyValueRef(op.a, op.b));
+			stats->applySet(op.a, op.b);
+		} else if (op.type == KVBenchOp::Clear) {
+			store->clear(KeyRangeRef(op.a, op.b));
+			stats->applyClear(KeyRangeRef(op.a, op.b));
+		} else if (op.type == KVBenchOp::Get) {
+			wait(success(store->readValue(op.a)));
+			stats->get.add(timer() - start);
+		} else if (op.type == KVBenchOp::Range) {
+			wait(success(store->readRange(KeyRangeRef(op.a, op.b), op.limit)));
+			stats->range.add(timer() - start);
+		} else {
+			wait(store->commit());
+			stats->commit.add(timer() - start);
+		}
+	}
+	return Void();
+}
+
+// Adapts the trace source to kvBenchRun, which also drives the YCSB load phase
+struct KVBenchTraceRunner : KVBenchTraceSource {
+	using KVBenchTraceSource::KVBenchTraceSource;
+	bool nextLoad(KVBenchOp& op) { return false; }
+};
+
+Optional<KeyValueStoreType> kvBenchStoreType(std::string const& engine) {
+	for (int t = 0; t < KeyValueStoreType::END; ++t) {
+		if (KeyValueStoreType::getStoreTypeStr(KeyValueStoreType::StoreType(t)) == engine) {
+			return KeyValueStoreType(KeyValueStoreType::StoreType(t));
+		}
+	}
+	if (engine == "ssd") {
+		return KeyValueStoreType(KeyValueStoreType::SSD_BTREE_V2);
+	}
+	return Optional<KeyValueStoreType>();
+}
+
+} // namespace
+
+ACTOR Future<Void> KVBench(std::string dataFolder) {
+	state std::string engine = getenv("FDB_KVBENCH_ENGINE") ? getenv("FDB_KVBENCH_ENGINE") : "ssd-2";
+	state std::string traceFile = getenv("FDB_KVBENCH_TRACE") ? getenv("FDB_KVBENCH_TRACE") : "";
+	state std::string workload = getenv("FDB_KVBENCH_WORKLOAD") ? getenv("FDB_KVBENCH_WORKLOAD") : "a";
+	state int records = envInt("FDB_KVBENCH_RECORDS", 100000);
+	state int operations = envInt("FDB_KVBENCH_OPERATIONS", 100000);
+	state int valueBytes = envInt("FDB_KVBENCH_VALUE_BYTES", 100);
+	state int batchSize = envInt("FDB_KVBENCH_BATCH", 100);
+	state bool keep = getenv("FDB_KVBENCH_KEEP") != nullptr;
+
+	state Optional<KeyValueStoreType> storeType = kvBenchStoreType(engine);
+	if (!storeType.present()) {
+		fprintf(stderr, "ERROR: Unknown storage engine `%s'\n", engine.c_str());
+		throw invalid_option_value();
+	}
+	if (traceFile.empty() &&
+	    (workload.size() != 1 || !KVBenchYCSBSource::validWorkload(workload[0]) || records <= 0 || batchSize <= 0)) {
+		fprintf(stderr, "ERROR: Invalid YCSB workload `%s'\n", workload.c_str());
+		throw invalid_option_value();
+	}
+
+	state UID id = deterministicRandom()->randomUniqueID();
+	state std::string directory = joinPath(dataFolder.empty() ? "." : dataFolder, "kvbench-" + id.toString());
+	platform::createDirectory(directory);
+	std::string filename = joinPath(directory, "kvbench");
+	if (storeType.get() == KeyValueStoreType::SSD_BTREE_V1) {
+		filename += ".fdb";
+	} else if (storeType.get() == KeyValueStoreType::SSD_BTREE_V2) {
+		filename += ".sqlite";
+	} else if (storeType.get() == KeyValueStoreType::MEMORY ||
+	           storeType.get() == KeyValueStoreType::MEMORY_RADIXTREE) {
+		filename += "-";
+	}
+	state IKeyValueStore* store = openKVStore(storeType.get(), filename, id, 2e9);
+	wait(store->init());
+
+	state KVBenchStats stats;
+	state int64_t diskBytesBefore = processDiskBytesWritten();
+	state double loadSeconds = 0;
+	state int64_t loadOperations = 0;
+	state double runStart;
+	state Future<Void> run;
+	if (traceFile.empty()) {
+		state KVBenchYCSBSource ycsb(workload[0], records, operations, valueBytes, batchSize);
+		runStart = timer();
+		run = kvBenchRun(store, &ycsb, true, &stats);
+		choose {
+			when(wait(run)) {}
+			when(wait(store->getError())) {}
+		}
+		loadSeconds = timer() - runStart;
+		loadOperations = stats.operations;
+		runStart = timer();
+		run = kvBenchRun(store, &ycsb, false, &stats);
+		choose {
+			when(wait(run)) {}
+			when(wait(store->getError())) {}
+		}
+	} else {
+		state KVBenchTraceRunner trace(traceFile);
+		runStart = timer();
+		run = kvBenchRun(store, &trace, false, &stats);
+		choose {
+			when(wait(run)) {}
+			when(wait(store->getError())) {}
+		}
+	}
+	state double runSeconds = timer() - runStart;
+
+	// Anything not committed by the workload itself is committed here, so that both amplification figures describe
+	// durable state
+	wait(store->commit());
+	int64_t diskBytesAfter = processDiskBytesWritten();
+	int64_t storeBytes = directoryBytes(directory);
+
+	JsonBuilderObject result;
+	result["engine"] = storeType.get().toString();
+	result["source"] = traceFile.empty() ? "ycsb-" + workload : traceFile;
+	if (traceFile.empty()) {
+		result["records"] = records;
+		result["load_seconds"] = loadSeconds;
+	}
+	result["run_seconds"] = runSeconds;
+	result["run_operations"] = stats.operations - loadOperations;
+	if (runSeconds > 0) {
+		result["operations_per_second"] = (stats.operations - loadOperations) / runSeconds;
+	}
+	result["sets"] = stats.sets;
+	result["clears"] = stats.clears;
+	result["logical_bytes_written"] = stats.logicalBytesWritten;
+	result["live_logical_bytes"] = stats.liveBytes;
+	result["store_bytes"] = storeBytes;
+	if (stats.liveBytes > 0) {
+		result["space_amplification"] = double(storeBytes) / stats.liveBytes;
+	}
+	if (diskBytesBefore >= 0 && diskBytesAfter >= 0) {
+		result["disk_bytes_written"] = diskBytesAfter - diskBytesBefore;
+		if (stats.logicalBytesWritten > 0) {
+			result["write_amplification"] = double(diskBytesAfter - diskBytesBefore) / stats.logicalBytesWritten;
+		}
+	}
+	JsonBuilderObject latency;
+	latency["get"] = stats.get.toJson();
+	latency["range"] = stats.range.toJson();
+	latency["commit"] = stats.commit.toJson();
+	result["latency_seconds"] = latency;
+	fmt::print("{}\n", result.getJson());
+	fflush(stdout);
+
+	if (store->getError().isError()) {
+		wait(store->getError());
+	}
+	state Future<Void> closed = store->onClosed();
+	if (keep) {
+		store->close();
+	} else {
+		store->dispose();
+	}
+	wait(closed);
+	if (!keep) {
+		platform::eraseDirectoryRecursive(directory);
+	}
+	return Void();
+}
@@ -618,6 +618,20 @@ private:
 		return Standalone<StringRef>(plaintext, arena);
 	}
 
+	// Queues a run of ascending snapshot items recovered from the log, which replace everything from runBegin through
+	// the last item
+	static void flushSnapshotRun(OpQueue& queue, Key const& runBegin, std::vector<std::pair<KeyValueRef, Arena>>& run) {
+		if (run.empty()) {
+			return;
+		}
+		KeyRange range = KeyRangeRef(runBegin, keyAfter(run.back().first.key));
+		queue.clear(range, &range.arena());
+		for (auto& [kv, arena] : run) {
+			queue.set(kv, &arena);
+		}
+		run.clear();
+	}
+
 	ACTOR static Future<Void> recover(KeyValueStoreMemory* self, bool exactRecovery) {
 		loop {
 			// 'uncommitted' variables track something that might be rolled back by an OpRollback, and are copied into
@@ -643,6 +657,8 @@ private:
 			state OpHeader h;
 			state Standalone<StringRef> lastSnapshotKey;
 			state bool isZeroFilled;
+			state Key snapshotRunBegin;
+			state std::vector<std::pair<KeyValueRef, Arena>> snapshotRun;
 
 			TraceEvent("KVSMemRecoveryStarted", self->id).detail("SnapshotEndLocation", uncommittedSnapshotEnd);
 
@@ -696,6 +712,9 @@ private:
 						StringRef p1 = data.substr(0, h.len1);
 						StringRef p2 = data.substr(h.len1, h.len2);
 
+						if (h.op != OpSnapshotItem && h.op != OpSnapshotItemDelta) {
+							flushSnapshotRun(recoveryQueue, snapshotRunBegin, snapshotRun);
+						}
 						if (h.op == OpSnapshotItem || h.op == OpSnapshotItemDelta) { // snapshot data item
 							/*if (p1 < uncommittedNextKey) {
 							    TraceEvent(SevError, "RecSnapshotBack", self->id)
@@ -719,12 +738,17 @@ private:
 								// Copy the suffix into the new reconstituted key
 								memcpy(mutateString(p1) + borrowed, suffix.begin(), suffix.size());
 							}
-							if (p1 >= uncommittedNextKey)
-								recoveryQueue.clear(
-								    KeyRangeRef(uncommittedNextKey, p1),
-								    &uncommittedNextKey
-								         .arena()); // FIXME: Not sure what this line is for, is it necessary?
-							recoveryQueue.set(KeyValueRef(p1, p2), &data.arena());
+							if (p1 >= uncommittedNextKey) {
+								// Each item clears the gap after the previous one, so a run of items is queued as one
+								// clear followed by its sets instead of a clear per item
+								if (snapshotRun.empty()) {
+									snapshotRunBegin = uncommittedNextKey;
+								}
+								snapshotRun.emplace_back(KeyValueRef(p1, p2), data.arena());
+							} else {
+								flushSnapshotRun(recoveryQueue, snapshotRunBegin, snapshotRun);
+								recoveryQueue.set(KeyValueRef(p1, p2), &data.arena());
+							}
 							uncommittedNextKey = keyAfter(p1);
 							++dbgSnapshotItemCount;
 							lastSnapshotKey = Key(p1, data.arena());
@@ -832,6 +856,7 @@ private:
 				}
 				self->data.clear();
 				self->dataSets.clear();
+				snapshotRun.clear();
 			}
 		}
 	}
@@ -1080,9 +1105,9 @@ KeyValueStoreMemory<Container>::KeyValueStoreMemory(IDiskQueue* log,
     previousSnapshotEnd(-1), committedDataSize(0), transactionSize(0), transactionIsLarge(false), resetSnapshot(false),
     disableSnapshot(disableSnapshot), replaceContent(replaceContent), firstCommitWithSnapshot(true), snapshotCount(0),
     memoryLimit(memoryLimit), enableEncryption(enableEncryption) {
-	// create reserved buffer for radixtree store type
+	// create reserved buffer for the radixtree container, which is also used for txnStateStore with a MEMORY type
 	this->reserved_buffer =
-	    (storeType == KeyValueStoreType::MEMORY) ? nullptr : new uint8_t[CLIENT_KNOBS->SYSTEM_KEY_SIZE_LIMIT];
+	    std::is_same_v<Container, IKeyValueContainer> ? nullptr : new uint8_t[CLIENT_KNOBS->SYSTEM_KEY_SIZE_LIMIT];
 	if (this->reserved_buffer != nullptr)
 		memset(this->reserved_buffer, 0, CLIENT_KNOBS->SYSTEM_KEY_SIZE_LIMIT);
 
@@ -1125,6 +1150,18 @@ IKeyValueStore* keyValueStoreLogSystem(class IDiskQueue* queue,
                                        bool enableEncryption) {
 	// ServerDBInfo is required if encryption is to be enabled, or the KV store instance have been encrypted.
 	ASSERT(!enableEncryption || db.isValid());
+	// The log format does not depend on the container, so either one can recover the other's log
+	if (SERVER_KNOBS->TXN_STATE_STORE_RADIX_TREE) {
+		return new KeyValueStoreMemory<radix_tree>(queue,
+		                                           db,
+		                                           logID,
+		                                           memoryLimit,
+		                                           KeyValueStoreType::MEMORY,
+		                                           disableSnapshot,
+		                                           replaceContent,
+		                                           exactRecovery,
+		                                           enableEncryption);
+	}
 	return new KeyValueStoreMemory<IKeyValueContainer>(queue,
 	                                                   db,
 	                                                   logID,
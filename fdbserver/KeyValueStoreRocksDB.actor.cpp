@@ -206,7 +206,14 @@ rocksdb::ColumnFamilyOptions SharedRocksDBState::initialCfOptions() {
 	}
 
 	if (SERVER_KNOBS->ROCKSDB_BLOCK_CACHE_SIZE > 0) {
-		bbOpts.block_cache = rocksdb::NewLRUCache(SERVER_KNOBS->ROCKSDB_BLOCK_CACHE_SIZE);
+		if (SERVER_KNOBS->ROCKSDB_SHARE_BLOCK_CACHE) {
+			// Every store in this process draws on one cache, so an idle store does not hold memory a busy one needs.
+			static std::shared_ptr<rocksdb::Cache> sharedBlockCache =
+			    rocksdb::NewLRUCache(SERVER_KNOBS->ROCKSDB_BLOCK_CACHE_SIZE);
+			bbOpts.block_cache = sharedBlockCache;
+		} else {
+			bbOpts.block_cache = rocksdb::NewLRUCache(SERVER_KNOBS->ROCKSDB_BLOCK_CACHE_SIZE);
+		}
 	}
 
 	if (SERVER_KNOBS->ROCKSDB_BLOCK_SIZE > 0) {
@@ -476,13 +483,19 @@ public:
 	  : db(db), cf(cf), index(0), deletedUptoIndex(0), iteratorsReuseCount(0), readRangeOptions(readOptions) {
 		readRangeOptions.background_purge_on_iterator_cleanup = true;
 		readRangeOptions.auto_prefix_mode = (SERVER_KNOBS->ROCKSDB_PREFIX_LEN > 0);
+		readRangeOptions.async_io = SERVER_KNOBS->ROCKSDB_READ_RANGE_ASYNC_IO;
+		readRangeOptions.adaptive_readahead = SERVER_KNOBS->ROCKSDB_READ_RANGE_ADAPTIVE_READAHEAD;
+		readRangeOptions.readahead_size = SERVER_KNOBS->ROCKSDB_READ_RANGE_READAHEAD_SIZE;
 		TraceEvent("ReadIteratorPool", id)
 		    .detail("KnobRocksDBReadRangeReuseIterators", SERVER_KNOBS->ROCKSDB_READ_RANGE_REUSE_ITERATORS)
 		    .detail("KnobRocksDBReadRangeReuseBoundedIterators",
 		            SERVER_KNOBS->ROCKSDB_READ_RANGE_REUSE_BOUNDED_ITERATORS)
 		    .detail("KnobRocksDBReadRangeBoundedIteratorsMaxLimit",
 		            SERVER_KNOBS->ROCKSDB_READ_RANGE_BOUNDED_ITERATORS_MAX_LIMIT)
-		    .detail("KnobRocksDBPrefixLen", SERVER_KNOBS->ROCKSDB_PREFIX_LEN);
+		    .detail("KnobRocksDBPrefixLen", SERVER_KNOBS->ROCKSDB_PREFIX_LEN)
+		    .detail("KnobRocksDBReadRangeAsyncIO", SERVER_KNOBS->ROCKSDB_READ_RANGE_ASYNC_IO)
+		    .detail("KnobRocksDBReadRangeAdaptiveReadahead", SERVER_KNOBS->ROCKSDB_READ_RANGE_ADAPTIVE_READAHEAD)
+		    .detail("KnobRocksDBReadRangeReadaheadSize", SERVER_KNOBS->ROCKSDB_READ_RANGE_READAHEAD_SIZE);
 		if (SERVER_KNOBS->ROCKSDB_READ_RANGE_REUSE_ITERATORS &&
 		    SERVER_KNOBS->ROCKSDB_READ_RANGE_REUSE_BOUNDED_ITERATORS) {
 			TraceEvent(SevWarn, "ReadIteratorKnobsMismatch");
@@ -1652,6 +1665,74 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 			sharedState->readLatency[threadIndex]->addMeasurement(endTime - readBeginTime);
 		}
 
+		struct ReadValuePrefixesAction : TypedAction<Reader, ReadValuePrefixesAction> {
+			Arena arena;
+			std::vector<std::pair<KeyRef, int>> keys;
+			double startTime;
+			ThreadReturnPromise<std::vector<Optional<Value>>> result;
+			ReadValuePrefixesAction(std::vector<std::pair<KeyRef, int>> const& keys) : startTime(timer_monotonic()) {
+				this->keys.reserve(keys.size());
+				for (auto const& [key, maxLength] : keys) {
+					this->keys.emplace_back(KeyRef(arena, key), maxLength);
+				}
+			}
+			double getTimeEstimate() const override { return SERVER_KNOBS->READ_VALUE_TIME_ESTIMATE * keys.size(); }
+		};
+		void action(ReadValuePrefixesAction& a) {
+			bool doPerfContextMetrics =
+			    SERVER_KNOBS->ROCKSDB_PERFCONTEXT_ENABLE &&
+			    (deterministicRandom()->random01() < SERVER_KNOBS->ROCKSDB_PERFCONTEXT_SAMPLE_RATE);
+			if (doPerfContextMetrics) {
+				perfContextMetrics->reset();
+			}
+			const double readBeginTime = timer_monotonic();
+			sharedState->readQueueLatency[threadIndex]->addMeasurement(readBeginTime - a.startTime);
+			if (SERVER_KNOBS->ROCKSDB_SET_READ_TIMEOUT && readBeginTime - a.startTime > readValuePrefixTimeout) {
+				TraceEvent(SevWarn, "KVSTimeout", id)
+				    .detail("Error", "Read value prefixes request timedout")
+				    .detail("Method", "ReadValuePrefixesAction")
+				    .detail("TimeoutValue", readValuePrefixTimeout);
+				a.result.sendError(transaction_too_old());
+				return;
+			}
+
+			auto& options = sharedState->getReadOptions();
+			if (SERVER_KNOBS->ROCKSDB_SET_READ_TIMEOUT) {
+				uint64_t deadlineMircos =
+				    db->GetEnv()->NowMicros() + (readValuePrefixTimeout - (readBeginTime - a.startTime)) * 1000000;
+				std::chrono::seconds deadlineSeconds(deadlineMircos / 1000000);
+				options.deadline = std::chrono::duration_cast<std::chrono::microseconds>(deadlineSeconds);
+			}
+
+			// The keys are sorted, which lets MultiGet look up the whole batch in one pass over each level
+			std::vector<rocksdb::Slice> keys;
+			keys.reserve(a.keys.size());
+			for (auto const& [key, maxLength] : a.keys) {
+				keys.push_back(toSlice(key));
+			}
+			std::vector<rocksdb::PinnableSlice> values(keys.size());
+			std::vector<rocksdb::Status> statuses(keys.size());
+			db->MultiGet(options, cf, keys.size(), keys.data(), values.data(), statuses.data(), true);
+
+			std::vector<Optional<Value>> result(keys.size());
+			for (int i = 0; i < keys.size(); i++) {
+				if (statuses[i].ok()) {
+					result[i] = Value(StringRef(reinterpret_cast<const uint8_t*>(values[i].data()),
+					                            std::min(values[i].size(), size_t(a.keys[i].second))));
+				} else if (!statuses[i].IsNotFound()) {
+					logRocksDBError(id, statuses[i], "ReadValuePrefixes");
+					a.result.sendError(statusToError(statuses[i]));
+					return;
+				}
+			}
+			a.result.send(std::move(result));
+
+			if (doPerfContextMetrics) {
+				perfContextMetrics->set(threadIndex);
+			}
+			sharedState->readLatency[threadIndex]->addMeasurement(timer_monotonic() - readBeginTime);
+		}
+
 		struct ReadRangeAction : TypedAction<Reader, ReadRangeAction>, FastAllocated<ReadRangeAction> {
 			KeyRange keys;
 			int rowLimit, byteLimit;
@@ -2172,6 +2253,23 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 		return read(a.release(), &semaphore, readThreads.getPtr(), &counters.failedToAcquire);
 	}
 
+	Future<std::vector<Optional<Value>>> readValuePrefixes(std::vector<std::pair<KeyRef, int>> const& keys,
+	                                                       Optional<ReadOptions> options) override {
+		ReadType type = options.present() ? options.get().type : ReadType::NORMAL;
+
+		// Throttled reads keep going through the read semaphore one key at a time
+		bool throttled = std::any_of(
+		    keys.begin(), keys.end(), [type](auto const& key) { return shouldThrottle(type, key.first); });
+		if (!SERVER_KNOBS->ROCKSDB_MULTIGET || keys.size() <= 1 || throttled) {
+			return IKeyValueStore::readValuePrefixes(keys, options);
+		}
+
+		auto a = new Reader::ReadValuePrefixesAction(keys);
+		auto res = a->result.getFuture();
+		readThreads->post(a);
+		return res;
+	}
+
 	ACTOR static Future<Standalone<RangeResultRef>> read(Reader::ReadRangeAction* action,
 	                                                     FlowLock* semaphore,
 	                                                     IThreadPool* pool,
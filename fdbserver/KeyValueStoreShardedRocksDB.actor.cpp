@@ -51,6 +51,7 @@ static_assert((ROCKSDB_MAJOR == 7 && ROCKSDB_MINOR == 7 && ROCKSDB_PATCH == 3),
 const std::string rocksDataFolderSuffix = "-data";
 const std::string METADATA_SHARD_ID = "kvs-metadata";
 const std::string DEFAULT_CF_NAME = "default"; // `specialKeys` is stored in this culoumn family.
+const std::string CHANGE_FEED_SHARD_ID = "kvs-changefeed"; // `changeFeedDurableKeys`, if split from `specialKeys`.
 const KeyRef shardMappingPrefix("\xff\xff/ShardMapping/"_sr);
 // TODO: move constants to a header file.
 const KeyRef persistVersion = "\xff\xffVersion"_sr;
@@ -364,6 +365,10 @@ rocksdb::Options getOptions() {
 
 	options.db_write_buffer_size = SERVER_KNOBS->ROCKSDB_WRITE_BUFFER_SIZE;
 	options.write_buffer_size = SERVER_KNOBS->ROCKSDB_CF_WRITE_BUFFER_SIZE;
+	// A commit batch usually spans many column families. Pipelining lets the WAL write and sync of one write group
+	// proceed while the previous group is still being inserted into the memtables.
+	options.enable_pipelined_write = SERVER_KNOBS->SHARDED_ROCKSDB_ENABLE_PIPELINED_WRITE;
+	options.allow_concurrent_memtable_write = SERVER_KNOBS->SHARDED_ROCKSDB_ALLOW_CONCURRENT_MEMTABLE_WRITE;
 	options.statistics = rocksdb::CreateDBStatistics();
 	options.statistics->set_stats_level(rocksdb::kExceptHistogramOrTimers);
 	options.db_log_dir = g_network->isSimulated() ? "" : SERVER_KNOBS->LOG_DIRECTORY;
@@ -418,6 +423,9 @@ public:
 		ASSERT(cf);
 		readRangeOptions.background_purge_on_iterator_cleanup = true;
 		readRangeOptions.auto_prefix_mode = (SERVER_KNOBS->ROCKSDB_PREFIX_LEN > 0);
+		readRangeOptions.async_io = SERVER_KNOBS->ROCKSDB_READ_RANGE_ASYNC_IO;
+		readRangeOptions.adaptive_readahead = SERVER_KNOBS->ROCKSDB_READ_RANGE_ADAPTIVE_READAHEAD;
+		readRangeOptions.readahead_size = SERVER_KNOBS->ROCKSDB_READ_RANGE_READAHEAD_SIZE;
 		TraceEvent(SevVerbose, "ShardedRocksReadIteratorPool")
 		    .detail("Path", path)
 		    .detail("KnobRocksDBReadRangeReuseIterators", SERVER_KNOBS->ROCKSDB_READ_RANGE_REUSE_ITERATORS)
@@ -750,6 +758,22 @@ public:
 					ASSERT(shard->db->GetProperty(shard->cf, rocksdb::DB::Properties::kCFStats, &propValue));
 					TraceEvent(SevInfo, "PhysicalShardCFStats").detail("ShardId", id).detail("Detail", propValue);
 
+					// Compaction debt of the shard, so hot shards falling behind on compaction can be told apart from
+					// empty shards that are only waiting to be dropped.
+					uint64_t estPendCompactBytes = 0, numL0Files = 0;
+					shard->db->GetIntProperty(
+					    shard->cf, rocksdb::DB::Properties::kEstimatePendingCompactionBytes, &estPendCompactBytes);
+					std::string numL0FilesProp;
+					if (shard->db->GetProperty(
+					        shard->cf, rocksdb::DB::Properties::kNumFilesAtLevelPrefix + "0", &numL0FilesProp)) {
+						numL0Files = std::stoull(numL0FilesProp);
+					}
+					TraceEvent(SevInfo, "PhysicalShardCompactionDebt")
+					    .detail("ShardId", id)
+					    .detail("EstPendCompactBytes", estPendCompactBytes)
+					    .detail("NumL0Files", numL0Files)
+					    .detail("PendingDeletion", shard->dataShards.empty());
+
 					// Get compression ratio for each level.
 					rocksdb::ColumnFamilyMetaData cfMetadata;
 					shard->db->GetColumnFamilyMetaData(shard->cf, &cfMetadata);
@@ -774,6 +798,9 @@ public:
 		return Void();
 	}
 
+	// Flushes and compactions of every physical shard share this limiter, so background writes cannot starve reads.
+	void setRateLimiter(std::shared_ptr<rocksdb::RateLimiter> rateLimiter) { dbOptions.rate_limiter = rateLimiter; }
+
 	rocksdb::Status init() {
 		// Open instance.
 		TraceEvent(SevInfo, "ShardedRocksShardManagerInitBegin", this->logId).detail("DataPath", path);
@@ -898,10 +925,32 @@ public:
 			std::shared_ptr<PhysicalShard> defaultShard =
 			    std::make_shared<PhysicalShard>(db, DEFAULT_CF_NAME, handles[0]);
 			columnFamilyMap[defaultShard->cf->GetID()] = defaultShard->cf;
-			std::unique_ptr<DataShard> dataShard = std::make_unique<DataShard>(specialKeys, defaultShard.get());
-			dataShardMap.insert(specialKeys, dataShard.get());
-			defaultShard->dataShards[specialKeys.begin.toString()] = std::move(dataShard);
 			physicalShards[defaultShard->id] = defaultShard;
+			auto addSpecialKeysShard = [&](KeyRangeRef range, PhysicalShard* shard) {
+				std::unique_ptr<DataShard> dataShard = std::make_unique<DataShard>(range, shard);
+				dataShardMap.insert(range, dataShard.get());
+				shard->dataShards[range.begin.toString()] = std::move(dataShard);
+			};
+
+			if (SERVER_KNOBS->SHARDED_ROCKSDB_CHANGE_FEED_SHARD) {
+				// Durable change feed data is appended in version order and popped with range deletes. Keeping it in
+				// its own column family gives it separate memtables and compactions, so feed throughput does not add
+				// write amplification to the rest of the storage server's metadata. The split is persisted with the
+				// range mapping below, so it is only decided when the store is created.
+				auto feedShard =
+				    std::make_shared<PhysicalShard>(db, CHANGE_FEED_SHARD_ID, rocksdb::ColumnFamilyOptions(dbOptions));
+				status = feedShard->init();
+				if (!status.ok()) {
+					return status;
+				}
+				columnFamilyMap[feedShard->cf->GetID()] = feedShard->cf;
+				physicalShards[CHANGE_FEED_SHARD_ID] = feedShard;
+				addSpecialKeysShard(KeyRangeRef(specialKeys.begin, changeFeedDurableKeys.begin), defaultShard.get());
+				addSpecialKeysShard(changeFeedDurableKeys, feedShard.get());
+				addSpecialKeysShard(KeyRangeRef(changeFeedDurableKeys.end, specialKeys.end), defaultShard.get());
+			} else {
+				addSpecialKeysShard(specialKeys, defaultShard.get());
+			}
 
 			// Create metadata shard.
 			auto metadataShard =
@@ -1956,6 +2005,9 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 		};
 
 		void action(OpenAction& a) {
+			if (rateLimiter) {
+				a.shardManager->setRateLimiter(rateLimiter);
+			}
 			auto status = a.shardManager->init();
 
 			if (!status.ok()) {
@@ -3076,16 +3128,33 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 	Future<Void> restore(const std::string& shardId,
 	                     const std::vector<KeyRange>& ranges,
 	                     const std::vector<CheckpointMetaData>& checkpoints) override {
+		// Each range must either be unassigned, or be entirely assigned to the target shard already, as a range moving
+		// into a storage server is
+		std::vector<KeyRange> newRanges;
 		for (const KeyRange& range : ranges) {
 			std::vector<DataShard*> shards = shardManager.getDataShardsByRange(range);
-			if (!shards.empty()) {
+			if (shards.empty()) {
+				newRanges.push_back(range);
+				continue;
+			}
+			std::sort(shards.begin(), shards.end(), [](const DataShard* a, const DataShard* b) {
+				return a->range.begin < b->range.begin;
+			});
+			KeyRef covered = range.begin;
+			for (const DataShard* shard : shards) {
+				if (shard->physicalShard->id != shardId || shard->range.begin > covered) {
+					break;
+				}
+				covered = std::max(covered, shard->range.end);
+			}
+			if (covered < range.end) {
 				TraceEvent(SevWarnAlways, "RestoreRangesNotEmpty", id)
 				    .detail("Range", range)
 				    .detail("RestoreShardID", shardId);
 				throw failed_to_restore_checkpoint();
 			}
 		}
-		for (const KeyRange& range : ranges) {
+		for (const KeyRange& range : newRanges) {
 			shardManager.addRange(range, shardId);
 		}
 		auto a = new Writer::RestoreAction(&shardManager, path, shardId, ranges, checkpoints);
@@ -3407,7 +3476,15 @@ TEST_CASE("noSim/ShardedRocksDB/ShardOps") {
 	mapping.push_back(std::make_pair(KeyRange(KeyRangeRef("m"_sr, "n"_sr)), "shard-3"));
 	mapping.push_back(std::make_pair(KeyRange(KeyRangeRef("u"_sr, "v"_sr)), "shard-3"));
 	mapping.push_back(std::make_pair(KeyRange(KeyRangeRef("x"_sr, "z"_sr)), "shard-1"));
-	mapping.push_back(std::make_pair(specialKeys, DEFAULT_CF_NAME));
+	if (SERVER_KNOBS->SHARDED_ROCKSDB_CHANGE_FEED_SHARD) {
+		mapping.push_back(std::make_pair(KeyRange(KeyRangeRef(specialKeys.begin, changeFeedDurableKeys.begin)),
+		                                 DEFAULT_CF_NAME));
+		mapping.push_back(std::make_pair(KeyRange(changeFeedDurableKeys), CHANGE_FEED_SHARD_ID));
+		mapping.push_back(std::make_pair(KeyRange(KeyRangeRef(changeFeedDurableKeys.end, specialKeys.end)),
+		                                 DEFAULT_CF_NAME));
+	} else {
+		mapping.push_back(std::make_pair(specialKeys, DEFAULT_CF_NAME));
+	}
 
 	for (auto it = dataMap.begin(); it != dataMap.end(); ++it) {
 		std::cout << "Begin " << it->first.begin.toString() << ", End " << it->first.end.toString() << ", id "
@@ -3446,7 +3523,7 @@ TEST_CASE("noSim/ShardedRocksDB/ShardOps") {
 	}
 	{
 		auto dataMap = rocksdbStore->getDataMapping();
-		ASSERT_EQ(dataMap.size(), 2);
+		ASSERT_EQ(dataMap.size(), SERVER_KNOBS->SHARDED_ROCKSDB_CHANGE_FEED_SHARD ? 4 : 2);
 		ASSERT(dataMap[0].second == "shard-2");
 	}
 
@@ -409,6 +409,21 @@ void peekMessagesFromMemory(LogRouterData* self, Tag tag, Version begin, BinaryW
 	                           std::make_pair(begin, LengthPrefixedStringRef()),
 	                           [](const auto& l, const auto& r) -> bool { return l.first < r.first; });
 
+	// Size the reply first so each message is copied into it once, as the TLog does.
+	int replyBytes = 0;
+	Version sizedVersion = -1;
+	for (auto sizeIt = it; sizeIt != deque.end(); ++sizeIt) {
+		if (sizeIt->first != sizedVersion) {
+			if (replyBytes >= SERVER_KNOBS->DESIRED_TOTAL_BYTES) {
+				break;
+			}
+			sizedVersion = sizeIt->first;
+			replyBytes += sizeof(VERSION_HEADER) + sizeof(Version);
+		}
+		replyBytes += sizeof(uint32_t) + sizeIt->second.expectedSize();
+	}
+	messages.reserve(replyBytes);
+
 	Version currentVersion = -1;
 	for (; it != deque.end(); ++it) {
 		if (it->first != currentVersion) {
@@ -639,12 +639,18 @@ void ILogSystem::MergedPeekCursor::calcHasMessage() {
 			currentCursor = bestServer;
 			hasNextMessage = true;
 
-			for (auto& c : serverCursors)
-				c->advanceTo(messageVersion);
+			// Messages only come from bestServer here, and its replies end on version boundaries, so the other
+			// cursors only need to be brought up to each new version rather than to every message within it.
+			if (messageVersion.version != othersAdvancedVersion) {
+				for (auto& c : serverCursors)
+					c->advanceTo(messageVersion);
+				othersAdvancedVersion = messageVersion.version;
+			}
 
 			return;
 		}
 
+		othersAdvancedVersion = invalidVersion;
 		auto bestVersion = serverCursors[bestServer]->version();
 		for (auto& c : serverCursors)
 			c->advanceTo(bestVersion);
@@ -922,15 +928,20 @@ void ILogSystem::SetPeekCursor::calcHasMessage() {
 
 			//TraceEvent("LPC_Calc1").detail("Ver", messageVersion.toString()).detail("Tag", tag.toString()).detail("HasNextMessage", hasNextMessage);
 
-			for (auto& cursors : serverCursors) {
-				for (auto& c : cursors) {
-					c->advanceTo(messageVersion);
+			// As in MergedPeekCursor, only bring the other cursors up to each new version of the best server.
+			if (messageVersion.version != othersAdvancedVersion) {
+				for (auto& cursors : serverCursors) {
+					for (auto& c : cursors) {
+						c->advanceTo(messageVersion);
+					}
 				}
+				othersAdvancedVersion = messageVersion.version;
 			}
 
 			return;
 		}
 
+		othersAdvancedVersion = invalidVersion;
 		auto bestVersion = serverCursors[bestSet][bestServer]->version();
 		for (auto& cursors : serverCursors) {
 			for (auto& c : cursors) {
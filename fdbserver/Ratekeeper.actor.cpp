@@ -77,6 +77,23 @@ ACTOR static Future<Void> splitError(Future<Void> in, Promise<Void> errOut) {
 	}
 }
 
+// Returns true if one of the storage server's busiest tags is busy enough for the tag throttler to auto-throttle it
+static bool hasThrottleableBusyTag(StorageQueueInfo const& ss) {
+	if (ss.getStorageQueueBytes() <= SERVER_KNOBS->AUTO_TAG_THROTTLE_STORAGE_QUEUE_BYTES &&
+	    ss.getDurabilityLag() <= SERVER_KNOBS->AUTO_TAG_THROTTLE_DURABILITY_LAG_VERSIONS) {
+		return false;
+	}
+	for (auto const* busyTags : { &ss.busiestWriteTags, &ss.busiestReadTags }) {
+		for (auto const& busyTag : *busyTags) {
+			if (busyTag.fractionalBusyness > SERVER_KNOBS->AUTO_THROTTLE_TARGET_TAG_BUSYNESS &&
+			    busyTag.rate > SERVER_KNOBS->MIN_TAG_COST) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
 class RatekeeperImpl {
 public:
 	ACTOR static Future<Void> configurationMonitor(Ratekeeper* self) {
@@ -155,6 +172,15 @@ public:
 		}
 	}
 
+	// Queue metrics are polled and the rate recomputed more often while the cluster is close to being limited, so
+	// that Ratekeeper reacts to a burst before the queues overshoot their targets
+	static double metricUpdateRate(bool underPressure) {
+		if (underPressure && SERVER_KNOBS->RATEKEEPER_FAST_METRIC_UPDATE_RATE > 0) {
+			return std::min(SERVER_KNOBS->METRIC_UPDATE_RATE, SERVER_KNOBS->RATEKEEPER_FAST_METRIC_UPDATE_RATE);
+		}
+		return SERVER_KNOBS->METRIC_UPDATE_RATE;
+	}
+
 	ACTOR static Future<Void> trackStorageServerQueueInfo(ActorWeakSelfRef<Ratekeeper> self,
 	                                                      StorageServerInterface ssi) {
 		self->storageQueueInfo.insert(mapPair(ssi.id(), StorageQueueInfo(self->id, ssi.id(), ssi.locality)));
@@ -166,9 +192,12 @@ public:
 				ErrorOr<StorageQueuingMetricsReply> reply = wait(ssi.getQueuingMetrics.getReplyUnlessFailedFor(
 				    StorageQueuingMetricsRequest(), 0, 0)); // SOMEDAY: or tryGetReply?
 				Map<UID, StorageQueueInfo>::iterator myQueueInfo = self->storageQueueInfo.find(ssi.id());
+				bool underPressure = false;
 				if (reply.present()) {
 					myQueueInfo->value.update(reply.get(), self->smoothTotalDurableBytes);
 					myQueueInfo->value.acceptingRequests = ssi.isAcceptingRequests();
+					underPressure = myQueueInfo->value.getStorageQueueBytes() >
+					                self->normalLimits.storageTargetBytes - self->normalLimits.storageSpringBytes;
 				} else {
 					if (myQueueInfo->value.valid) {
 						TraceEvent("RkStorageServerDidNotRespond", self->id).detail("StorageServer", ssi.id());
@@ -176,7 +205,7 @@ public:
 					myQueueInfo->value.valid = false;
 				}
 
-				wait(delayJittered(SERVER_KNOBS->METRIC_UPDATE_RATE) &&
+				wait(delayJittered(metricUpdateRate(underPressure)) &&
 				     IFailureMonitor::failureMonitor().onStateEqual(ssi.getQueuingMetrics.getEndpoint(),
 				                                                    FailureStatus(false)));
 			}
@@ -196,8 +225,12 @@ public:
 			loop {
 				ErrorOr<TLogQueuingMetricsReply> reply = wait(tli.getQueuingMetrics.getReplyUnlessFailedFor(
 				    TLogQueuingMetricsRequest(), 0, 0)); // SOMEDAY: or tryGetReply?
+				bool underPressure = false;
 				if (reply.present()) {
 					myQueueInfo->value.update(reply.get(), self->smoothTotalDurableBytes);
+					underPressure =
+					    myQueueInfo->value.lastReply.bytesInput - myQueueInfo->value.getSmoothDurableBytes() >
+					    self->normalLimits.logTargetBytes - self->normalLimits.logSpringBytes;
 				} else {
 					if (myQueueInfo->value.valid) {
 						TraceEvent("RkTLogDidNotRespond", self->id).detail("TransactionLog", tli.id());
@@ -205,7 +238,7 @@ public:
 					myQueueInfo->value.valid = false;
 				}
 
-				wait(delayJittered(SERVER_KNOBS->METRIC_UPDATE_RATE) &&
+				wait(delayJittered(metricUpdateRate(underPressure)) &&
 				     IFailureMonitor::failureMonitor().onStateEqual(tli.getQueuingMetrics.getEndpoint(),
 				                                                    FailureStatus(false)));
 			}
@@ -470,7 +503,7 @@ public:
 						else
 							++p;
 					}
-					timeout = delayJittered(SERVER_KNOBS->METRIC_UPDATE_RATE);
+					timeout = delayJittered(metricUpdateRate(lastLimited));
 				}
 				when(GetRateInfoRequest req = waitNext(rkInterf.getRateInfo.getFuture())) {
 					GetRateInfoReply reply;
@@ -697,6 +730,7 @@ void Ratekeeper::updateRate(RatekeeperLimits* limits) {
 	std::multimap<int64_t, StorageQueueInfo const*> storageDurabilityLagReverseIndex;
 
 	std::map<UID, limitReason_t> ssReasons;
+	std::set<UID> tagThrottledServers;
 
 	bool printRateKeepLimitReasonDetails =
 	    SERVER_KNOBS->RATEKEEPER_PRINT_LIMIT_REASON &&
@@ -832,6 +866,15 @@ void Ratekeeper::updateRate(RatekeeperLimits* limits) {
 
 		storageTpsLimitReverseIndex.insert(std::make_pair(limitTps, &ss));
 
+		// A server that is only behind because of a busy tag is left to auto tag throttling, which slows just the
+		// transactions with that tag, as long as its queue and MVCC lag are still within their targets
+		if (limits->priority == TransactionPriority::DEFAULT && tagThrottler->isAutoThrottlingEnabled() &&
+		    ssLimitReason != limitReason_t::storage_server_min_free_space &&
+		    ssLimitReason != limitReason_t::storage_server_min_free_space_ratio && storageQueue < targetBytes &&
+		    storageDurabilityLag < SERVER_KNOBS->MAX_READ_TRANSACTION_LIFE_VERSIONS && hasThrottleableBusyTag(ss)) {
+			tagThrottledServers.insert(ss.id);
+		}
+
 		if (limitTps < limits->tpsLimit && (ssLimitReason == limitReason_t::storage_server_min_free_space ||
 		                                    ssLimitReason == limitReason_t::storage_server_min_free_space_ratio)) {
 			reasonID = ss.id;
@@ -843,9 +886,19 @@ void Ratekeeper::updateRate(RatekeeperLimits* limits) {
 	}
 
 	std::set<Optional<Standalone<StringRef>>> ignoredMachines;
+	int ignoredTagThrottledServers = 0;
 	for (auto ss = storageTpsLimitReverseIndex.begin();
 	     ss != storageTpsLimitReverseIndex.end() && ss->first < limits->tpsLimit;
 	     ++ss) {
+		if (ignoredTagThrottledServers < SERVER_KNOBS->MAX_TAG_THROTTLED_SERVERS_IGNORED &&
+		    tagThrottledServers.count(ss->second->id)) {
+			++ignoredTagThrottledServers;
+			TraceEvent("RatekeeperIgnoreTagThrottledServer", id)
+			    .suppressFor(1.0)
+			    .detail("SSID", ss->second->id)
+			    .detail("LimitTps", ss->first);
+			continue;
+		}
 		if (ignoredMachines.size() <
 		    std::min(configuration.storageTeamSize - 1, SERVER_KNOBS->MAX_MACHINES_FALLING_BEHIND)) {
 			ignoredMachines.insert(ss->second->locality.zoneId());
@@ -0,0 +1,260 @@
+/*
+ * RecentWriteFilter.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+#include <algorithm>
+#include <map>
+
+#include "flow/UnitTest.h"
+#include "flow/xxhash.h"
+#include "fdbserver/RecentWriteFilter.h"
+
+namespace {
+// Beyond this many windows the two oldest are merged, so a stalled oldest version can't grow the filter without bound
+constexpr int maxWindows = 16;
+// Beyond this many write ranges spanning several prefixes a window stops trying to rule anything out
+constexpr int maxWideRanges = 32;
+
+bool testBit(const std::vector<uint64_t>& bits, uint64_t i) {
+	return (bits[i >> 6] >> (i & 63)) & 1;
+}
+} // namespace
+
+RecentWriteFilter::RecentWriteFilter(int bitsLog2, int prefixBytes, Version windowVersions)
+  : bitsLog2(std::max(6, std::min(bitsLog2, 32))), prefixBytes(std::max(prefixBytes, 1)),
+    windowVersions(std::max<Version>(windowVersions, 1)) {}
+
+// Returns the prefix that every key in [begin, end) is filtered under, if they all share one.  A key is filtered under
+// its first prefixBytes bytes, or under the whole key if it is shorter.
+Optional<StringRef> RecentWriteFilter::sharedPrefix(KeyRef begin, KeyRef end) const {
+	// A single key
+	if (end.size() == begin.size() + 1 && end.startsWith(begin) && end[begin.size()] == 0)
+		return begin.substr(0, std::min(begin.size(), prefixBytes));
+	if (begin.size() < prefixBytes)
+		return Optional<StringRef>();
+
+	// Every key in the range starts with prefix exactly when end <= strinc(prefix).  If the prefix is all \xff bytes,
+	// no key after it can have a different prefix.
+	StringRef prefix = begin.substr(0, prefixBytes);
+	int n = prefix.size();
+	while (n > 0 && prefix[n - 1] == 0xff)
+		n--;
+	for (int i = 0; i < n && i < end.size(); i++) {
+		uint8_t limit = i < n - 1 ? prefix[i] : prefix[i] + 1;
+		if (end[i] != limit)
+			return end[i] < limit ? prefix : Optional<StringRef>();
+	}
+	return end.size() <= n ? prefix : Optional<StringRef>();
+}
+
+bool RecentWriteFilter::mayConflict(KeyRef begin, KeyRef end, Version readVersion) const {
+	// An empty range is checked by the history against the keys before it, which the filter doesn't track
+	if (begin >= end)
+		return true;
+
+	Optional<StringRef> prefix;
+	uint64_t hash = 0;
+	bool hashed = false;
+	for (auto w = windows.rbegin(); w != windows.rend() && w->maxVersion > readVersion; ++w) {
+		if (w->coversAll)
+			return true;
+		for (const KeyRangeRef& range : w->wideRanges) {
+			if (range.begin < end && begin < range.end)
+				return true;
+		}
+		if (!hashed) {
+			prefix = sharedPrefix(begin, end);
+			if (!prefix.present())
+				return true;
+			hash = XXH3_64bits(prefix.get().begin(), prefix.get().size());
+			hashed = true;
+		}
+		const uint64_t mask = (uint64_t(1) << bitsLog2) - 1;
+		if (testBit(w->bits, hash & mask) && testBit(w->bits, (hash >> 32) & mask))
+			return true;
+	}
+	return false;
+}
+
+RecentWriteFilter::Window& RecentWriteFilter::newWindow(Version version) {
+	if (spare.empty()) {
+		windows.emplace_back();
+		windows.back().bits.assign(size_t(1) << (bitsLog2 - 6), 0);
+	} else {
+		windows.push_back(std::move(spare.back()));
+		spare.pop_back();
+		std::fill(windows.back().bits.begin(), windows.back().bits.end(), 0);
+	}
+	Window& w = windows.back();
+	w.minVersion = w.maxVersion = version;
+	w.setBits = 0;
+	w.coversAll = false;
+	return w;
+}
+
+void RecentWriteFilter::addRange(Window& w, KeyRef begin, KeyRef end) {
+	Optional<StringRef> prefix = sharedPrefix(begin, end);
+	if (!prefix.present()) {
+		if (w.wideRanges.size() >= maxWideRanges)
+			w.coversAll = true;
+		else
+			w.wideRanges.push_back(KeyRangeRef(w.arena, KeyRangeRef(begin, end)));
+		return;
+	}
+
+	const uint64_t hash = XXH3_64bits(prefix.get().begin(), prefix.get().size());
+	const uint64_t mask = (uint64_t(1) << bitsLog2) - 1;
+	for (uint64_t i : { hash & mask, (hash >> 32) & mask }) {
+		if (!testBit(w.bits, i)) {
+			w.bits[i >> 6] |= uint64_t(1) << (i & 63);
+			w.setBits++;
+		}
+	}
+	// Once half of the bits are set most probes would hit anyway
+	if (w.setBits * 2 > (int64_t(1) << bitsLog2))
+		w.coversAll = true;
+}
+
+void RecentWriteFilter::addWrites(const std::vector<std::pair<StringRef, StringRef>>& ranges, Version version) {
+	if (ranges.empty())
+		return;
+	if (windows.empty() || version - windows.back().minVersion >= windowVersions)
+		newWindow(version);
+
+	Window& w = windows.back();
+	ASSERT(version >= w.maxVersion);
+	w.maxVersion = version;
+	for (auto it = ranges.begin(); it != ranges.end() && !w.coversAll; ++it)
+		addRange(w, it->first, it->second);
+
+	if (windows.size() > maxWindows)
+		mergeOldestWindows();
+}
+
+void RecentWriteFilter::mergeOldestWindows() {
+	Window& oldest = windows[0];
+	Window& next = windows[1];
+	next.minVersion = oldest.minVersion;
+	next.coversAll = next.coversAll || oldest.coversAll;
+	if (!next.coversAll) {
+		for (int i = 0; i < next.bits.size(); i++)
+			next.bits[i] |= oldest.bits[i];
+		// An upper bound, which can only make the window give up early
+		next.setBits += oldest.setBits;
+		if (next.setBits * 2 > (int64_t(1) << bitsLog2) ||
+		    next.wideRanges.size() + oldest.wideRanges.size() > maxWideRanges) {
+			next.coversAll = true;
+		} else {
+			for (const KeyRangeRef& range : oldest.wideRanges)
+				next.wideRanges.push_back(KeyRangeRef(next.arena, range));
+		}
+	}
+
+	windows.front().wideRanges.clear();
+	windows.front().arena = Arena();
+	if (spare.size() < maxWindows)
+		spare.push_back(std::move(windows.front()));
+	windows.pop_front();
+}
+
+void RecentWriteFilter::removeBefore(Version oldestVersion) {
+	while (!windows.empty() && windows.front().maxVersion <= oldestVersion) {
+		windows.front().wideRanges.clear();
+		windows.front().arena = Arena();
+		if (spare.size() < maxWindows)
+			spare.push_back(std::move(windows.front()));
+		windows.pop_front();
+	}
+}
+
+void RecentWriteFilter::clear(Version version) {
+	removeBefore(MAX_VERSION);
+	newWindow(version).coversAll = true;
+}
+
+// Checks the filter against a model that keeps every write, with short keys and few bits so that prefixes collide,
+// windows fill up and get merged.
+TEST_CASE("/fdbserver/RecentWriteFilter/Model") {
+	const int prefixBytes = deterministicRandom()->randomInt(1, 4);
+	RecentWriteFilter filter(deterministicRandom()->randomInt(6, 12), prefixBytes, deterministicRandom()->randomInt(1, 20));
+	std::multimap<Version, std::pair<std::string, std::string>> writes;
+
+	Arena arena;
+	auto randomKey = [&]() {
+		std::string key;
+		for (int i = deterministicRandom()->randomInt(0, 5); i > 0; i--)
+			key += "ab\xff"[deterministicRandom()->randomInt(0, 3)];
+		return key;
+	};
+	auto randomRange = [&]() {
+		std::string begin = randomKey(), end;
+		if (deterministicRandom()->coinflip()) {
+			end = begin + '\0';
+		} else {
+			end = randomKey();
+			if (end < begin)
+				std::swap(begin, end);
+		}
+		return std::make_pair(begin, end);
+	};
+
+	Version version = 0, oldestVersion = 0;
+	int filtered = 0;
+	for (int b = 0; b < 2000; b++) {
+		version += deterministicRandom()->randomInt(1, 5);
+		if (deterministicRandom()->random01() < 0.001) {
+			filter.clear(version);
+			writes.clear();
+			writes.emplace(version, std::make_pair(std::string(), std::string("\xff\xff\xff\xff\xff\xff")));
+		}
+
+		for (int r = 0; r < 20; r++) {
+			auto [begin, end] = randomRange();
+			Version readVersion = version - deterministicRandom()->randomInt(1, 40);
+			if (readVersion < oldestVersion)
+				continue;
+			bool conflict = false;
+			for (auto w = writes.upper_bound(readVersion); w != writes.end() && !conflict; ++w)
+				conflict = begin < end && w->second.first < end && begin < w->second.second;
+			bool mayConflict = filter.mayConflict(StringRef(begin), StringRef(end), readVersion);
+			ASSERT(mayConflict || !conflict);
+			filtered += !mayConflict;
+		}
+
+		std::vector<std::pair<StringRef, StringRef>> ranges;
+		for (int w = deterministicRandom()->randomInt(0, 3); w > 0; w--) {
+			auto range = randomRange();
+			if (range.first == range.second)
+				continue;
+			writes.emplace(version, range);
+			ranges.emplace_back(StringRef(arena, range.first), StringRef(arena, range.second));
+		}
+		filter.addWrites(ranges, version);
+
+		if (deterministicRandom()->coinflip()) {
+			oldestVersion = version - 30;
+			filter.removeBefore(oldestVersion);
+			writes.erase(writes.begin(), writes.upper_bound(oldestVersion));
+		}
+		ASSERT(filter.windowCount() <= maxWindows);
+	}
+	ASSERT(filtered > 0);
+	return Void();
+}
@@ -118,6 +118,23 @@ ACTOR Future<Void> runIKVS(OpenKVStoreRequest openReq, IKVSInterface ikvsInterfa
 					    readPrefixReq.reply,
 					    kvStore->readValuePrefix(readPrefixReq.key, readPrefixReq.maxLength, readPrefixReq.options)));
 				}
+				when(IKVSReadValuePrefixesRequest readPrefixesReq =
+				         waitNext(ikvsInterface.readValuePrefixes.getFuture())) {
+					std::vector<std::pair<KeyRef, int>> keys;
+					keys.reserve(readPrefixesReq.keys.size());
+					for (int i = 0; i < readPrefixesReq.keys.size(); i++) {
+						keys.emplace_back(readPrefixesReq.keys[i], readPrefixesReq.maxLengths[i]);
+					}
+					// The keys live in the request's arena, which is held until the reads finish
+					actors.add(cancellableForwardPromise(
+					    readPrefixesReq.reply,
+					    fmap(
+					        [](const std::vector<Optional<Value>>& values) {
+						        return IKVSReadValuePrefixesReply{ values };
+					        },
+					        holdWhile(readPrefixesReq.arena,
+					                  kvStore->readValuePrefixes(keys, readPrefixesReq.options)))));
+				}
 				when(IKVSReadRangeRequest readRangeReq = waitNext(ikvsInterface.readRange.getFuture())) {
 					actors.add(cancellableForwardPromise(
 					    readRangeReq.reply,
@@ -26,6 +26,7 @@
 #include "fdbclient/SystemData.h"
 #include "fdbserver/ApplyMetadataMutation.h"
 #include "fdbserver/ConflictSet.h"
+#include "fdbserver/HotKeyTracker.h"
 #include "fdbserver/IKeyValueStore.h"
 #include "fdbserver/Knobs.h"
 #include "fdbserver/LogSystem.h"
@@ -131,6 +132,8 @@ struct Resolver : ReferenceCounted<Resolver> {
 	std::map<NetworkAddress, ProxyRequestsInfo> proxyInfoMap;
 	ConflictSet* conflictSet;
 	TransientStorageMetricSample iopsSample;
+	// Key prefixes of the read conflict ranges that conflicted, in a sample of the transactions
+	HotKeyTracker conflictingKeyPrefixes;
 
 	// Use LogSystem as backend for txnStateStore. However, the real commit
 	// happens at commit proxies and we never "write" to the LogSystem at
@@ -157,6 +160,8 @@ struct Resolver : ReferenceCounted<Resolver> {
 	Counter resolvedBytes;
 	Counter resolvedReadConflictRanges;
 	Counter resolvedWriteConflictRanges;
+	Counter filteredReadConflictRanges;
+	Counter checkedReadConflictRanges;
 	Counter transactionsAccepted;
 	Counter transactionsTooOld;
 	Counter transactionsConflicted;
@@ -174,11 +179,19 @@ struct Resolver : ReferenceCounted<Resolver> {
 
 	Resolver(UID dbgid, int commitProxyCount, int resolverCount, EncryptionAtRestMode encryptMode)
 	  : dbgid(dbgid), commitProxyCount(commitProxyCount), resolverCount(resolverCount), encryptMode(encryptMode),
-	    version(-1), conflictSet(newConflictSet()), iopsSample(SERVER_KNOBS->KEY_BYTES_PER_SAMPLE),
+	    version(-1), conflictSet(newConflictSet(SERVER_KNOBS->RESOLVER_CONFLICT_SET_THREADS,
+	                                            SERVER_KNOBS->RESOLVER_USE_ART_CONFLICT_SET,
+	                                            SERVER_KNOBS->RESOLVER_RECENT_WRITE_FILTER)),
+	    iopsSample(SERVER_KNOBS->KEY_BYTES_PER_SAMPLE),
+	    conflictingKeyPrefixes(SERVER_KNOBS->HOT_KEY_TRACKER_CAPACITY,
+	                           SERVER_KNOBS->RESOLVER_CONFLICT_SAMPLE_RATE,
+	                           SERVER_KNOBS->HOT_KEY_WINDOW),
 	    cc("Resolver", dbgid.toString()), resolveBatchIn("ResolveBatchIn", cc),
 	    resolveBatchStart("ResolveBatchStart", cc), resolvedTransactions("ResolvedTransactions", cc),
 	    resolvedBytes("ResolvedBytes", cc), resolvedReadConflictRanges("ResolvedReadConflictRanges", cc),
 	    resolvedWriteConflictRanges("ResolvedWriteConflictRanges", cc),
+	    filteredReadConflictRanges("FilteredReadConflictRanges", cc),
+	    checkedReadConflictRanges("CheckedReadConflictRanges", cc),
 	    transactionsAccepted("TransactionsAccepted", cc), transactionsTooOld("TransactionsTooOld", cc),
 	    transactionsConflicted("TransactionsConflicted", cc),
 	    resolvedStateTransactions("ResolvedStateTransactions", cc),
@@ -291,8 +304,14 @@ ACTOR Future<Void> resolveBatch(Reference<Resolver> self,
 		double expire = now() + SERVER_KNOBS->SAMPLE_EXPIRATION_TIME;
 		ConflictBatch conflictBatch(self->conflictSet, &reply.conflictingKeyRangeMap, &reply.arena);
 		const Version newOldestVersion = req.version - SERVER_KNOBS->MAX_WRITE_TRANSACTION_LIFE_VERSIONS;
+		const double sampleRate = SERVER_KNOBS->RESOLVER_CONFLICT_SAMPLE_RATE;
+		std::vector<int> sampled;
 		for (int t = 0; t < req.transactions.size(); t++) {
-			conflictBatch.addTransaction(req.transactions[t], newOldestVersion);
+			bool sample = sampleRate >= 1.0 || (sampleRate > 0 && deterministicRandom()->random01() < sampleRate);
+			if (sample) {
+				sampled.push_back(t);
+			}
+			conflictBatch.addTransaction(req.transactions[t], newOldestVersion, sample);
 			self->resolvedReadConflictRanges += req.transactions[t].read_conflict_ranges.size();
 			self->resolvedWriteConflictRanges += req.transactions[t].write_conflict_ranges.size();
 
@@ -306,6 +325,8 @@ ACTOR Future<Void> resolveBatch(Reference<Resolver> self,
 			}
 		}
 		conflictBatch.detectConflicts(req.version, newOldestVersion, commitList, &tooOldList);
+		self->filteredReadConflictRanges += conflictBatch.filteredReadConflictRanges();
+		self->checkedReadConflictRanges += conflictBatch.checkedReadConflictRanges();
 
 		reply.debugID = req.debugID;
 		reply.committed.resize(reply.arena, req.transactions.size());
@@ -320,6 +341,23 @@ ACTOR Future<Void> resolveBatch(Reference<Resolver> self,
 		self->transactionsAccepted += commitList.size();
 		self->transactionsTooOld += tooOldList.size();
 		self->transactionsConflicted += req.transactions.size() - commitList.size() - tooOldList.size();
+		for (int t : sampled) {
+			if (reply.committed[t] != ConflictBatch::TransactionConflict)
+				continue;
+			// Transactions that asked for their conflicting keys have them in the reply instead of the sample
+			auto conflicting = reply.conflictingKeyRangeMap.find(t);
+			if (conflicting == reply.conflictingKeyRangeMap.end()) {
+				conflicting = conflictBatch.sampledConflictingKeyRanges().find(t);
+				if (conflicting == conflictBatch.sampledConflictingKeyRanges().end())
+					continue;
+			}
+			for (int r : conflicting->second) {
+				KeyRangeRef range = req.transactions[t].read_conflict_ranges[r];
+				int prefixLength = std::min<int>(commonPrefixLength(range.begin, range.end),
+				                                 SERVER_KNOBS->RESOLVER_CONFLICT_PREFIX_BYTES);
+				self->conflictingKeyPrefixes.addSample(range.begin.substr(0, prefixLength));
+			}
+		}
 
 		ASSERT(req.prevVersion >= 0 ||
 		       req.txnStateTransactions.size() == 0); // The master's request should not have any state transactions
@@ -530,6 +568,10 @@ ACTOR Future<Void> processCompleteTransactionStateRequest(
     std::unordered_map<EncryptCipherDomainId, Reference<BlobCipherKey>>* cipherKeys) {
 	state KeyRange txnKeys = allKeys;
 	state std::map<Tag, UID> tag_uid;
+	// Shards on the same team have identical keyServers values, so each distinct value is decoded and resolved to
+	// its storage servers only once per recovery.
+	state Arena teamInfoArena;
+	state std::unordered_map<StringRef, ServerCacheInfo> teamInfo;
 
 	RangeResult UIDtoTagMap = pContext->pTxnStateStore->readRange(serverTagKeys).get();
 	for (const KeyValueRef& kv : UIDtoTagMap) {
@@ -548,10 +590,11 @@ ACTOR Future<Void> processCompleteTransactionStateRequest(
 
 		((KeyRangeRef&)txnKeys) = KeyRangeRef(keyAfter(data.back().key, txnKeys.arena()), txnKeys.end);
 
+		// The metadata mutations point into the range read instead of copying every key and value again
 		MutationsVec mutations;
+		mutations.arena().dependsOn(data.arena());
 		std::vector<std::pair<MapPair<Key, ServerCacheInfo>, int>> keyInfoData;
 		std::vector<UID> src, dest;
-		ServerCacheInfo info;
 		// NOTE: An ACTOR will be compiled into several classes, the this pointer is from one of them.
 		auto updateTagInfo = [pContext = pContext](const std::vector<UID>& uids,
 		                                           std::vector<Tag>& tags,
@@ -565,7 +608,7 @@ ACTOR Future<Void> processCompleteTransactionStateRequest(
 		};
 		for (auto& kv : data) {
 			if (!kv.key.startsWith(keyServersPrefix)) {
-				mutations.emplace_back(mutations.arena(), MutationRef::SetValue, kv.key, kv.value);
+				mutations.push_back(mutations.arena(), MutationRef(MutationRef::SetValue, kv.key, kv.value));
 				continue;
 			}
 
@@ -573,18 +616,17 @@ ACTOR Future<Void> processCompleteTransactionStateRequest(
 			if (k == allKeys.end) {
 				continue;
 			}
-			decodeKeyServersValue(tag_uid, kv.value, src, dest);
-
-			info.tags.clear();
-
-			info.src_info.clear();
-			updateTagInfo(src, info.tags, info.src_info);
-
-			info.dest_info.clear();
-			updateTagInfo(dest, info.tags, info.dest_info);
-
-			uniquify(info.tags);
-			keyInfoData.emplace_back(MapPair<Key, ServerCacheInfo>(k, info), 1);
+			auto team = teamInfo.find(kv.value);
+			if (team == teamInfo.end()) {
+				decodeKeyServersValue(tag_uid, kv.value, src, dest);
+
+				ServerCacheInfo info;
+				updateTagInfo(src, info.tags, info.src_info);
+				updateTagInfo(dest, info.tags, info.dest_info);
+				uniquify(info.tags);
+				team = teamInfo.emplace(StringRef(teamInfoArena, kv.value), std::move(info)).first;
+			}
+			keyInfoData.emplace_back(MapPair<Key, ServerCacheInfo>(k, team->second), 1);
 		}
 
 		// insert keyTag data separately from metadata mutations so that we can do one bulk insert which
@@ -657,6 +699,22 @@ ACTOR Future<Void> processTransactionStateRequestPart(Reference<Resolver> self,
 
 } // anonymous namespace
 
+// Status reads the latest of these events from each resolver
+ACTOR Future<Void> traceConflictingKeyPrefixes(Reference<Resolver> self) {
+	loop {
+		wait(delay(SERVER_KNOBS->WORKER_LOGGING_INTERVAL));
+		std::vector<std::pair<Key, double>> prefixes = self->conflictingKeyPrefixes.getHotKeys(allKeys);
+		std::sort(prefixes.begin(), prefixes.end(), [](auto const& a, auto const& b) { return a.second > b.second; });
+		int count = std::min<int>(prefixes.size(), SERVER_KNOBS->RESOLVER_CONFLICT_PREFIXES_IN_STATUS);
+		TraceEvent e("ResolverConflictingKeyPrefixes", self->dbgid);
+		e.detail("Prefixes", count);
+		for (int i = 0; i < count; i++) {
+			e.detail(format("Prefix%d", i), prefixes[i].first).detail(format("Rate%d", i), prefixes[i].second);
+		}
+		e.trackLatest(self->dbgid.toString() + "/ResolverConflictingKeyPrefixes");
+	}
+}
+
 ACTOR Future<Void> resolverCore(ResolverInterface resolver,
                                 InitializeResolverRequest initReq,
                                 Reference<AsyncVar<ServerDBInfo> const> db) {
@@ -667,6 +725,7 @@ ACTOR Future<Void> resolverCore(ResolverInterface resolver,
 	state PromiseStream<Future<Void>> addActor;
 	actors.add(waitFailureServer(resolver.waitFailure.getFuture()));
 	actors.add(traceRole(Role::RESOLVER, resolver.id()));
+	actors.add(traceConflictingKeyPrefixes(self));
 
 	TraceEvent("ResolverInit", resolver.id())
 	    .detail("RecoveryCount", initReq.recoveryCount)
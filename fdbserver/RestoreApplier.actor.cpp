@@ -505,6 +505,8 @@ ACTOR static Future<Void> shouldReleaseTransaction(double* targetMB,
 }
 
 // Apply mutations in batchData->stagingKeys [begin, end).
+// The transaction only writes, so it skips ReadYourWritesTransaction and the per key write conflict ranges: the whole
+// batch is covered by a single write conflict range.
 ACTOR static Future<Void> applyStagingKeysBatch(std::map<Key, StagingKey>::iterator begin,
                                                 std::map<Key, StagingKey>::iterator end,
                                                 Database cx,
@@ -521,7 +523,7 @@ ACTOR static Future<Void> applyStagingKeysBatch(std::map<Key, StagingKey>::itera
 	}
 	wait(shouldReleaseTransaction(targetMB, applyingDataBytes, releaseTxnTrigger));
 
-	state Reference<ReadYourWritesTransaction> tr(new ReadYourWritesTransaction(cx));
+	state Transaction tr(cx);
 	state int sets = 0;
 	state int clears = 0;
 	state Key endKey = begin->first;
@@ -532,12 +534,12 @@ ACTOR static Future<Void> applyStagingKeysBatch(std::map<Key, StagingKey>::itera
 		try {
 			txnSize = 0;
 			txnSizeUsed = 0;
-			tr->setOption(FDBTransactionOptions::ACCESS_SYSTEM_KEYS);
-			tr->setOption(FDBTransactionOptions::LOCK_AWARE);
+			tr.setOption(FDBTransactionOptions::ACCESS_SYSTEM_KEYS);
+			tr.setOption(FDBTransactionOptions::LOCK_AWARE);
 			std::map<Key, StagingKey>::iterator iter = begin;
 			while (iter != end) {
 				if (iter->second.type == MutationRef::SetValue) {
-					tr->set(iter->second.key, iter->second.val);
+					tr.set(iter->second.key, iter->second.val, AddConflictRange::False);
 					txnSize += iter->second.totalSize();
 					cc->appliedMutations += 1;
 					TraceEvent(SevFRMutationInfo, "FastRestoreApplierPhaseApplyStagingKeysBatch", applierID)
@@ -551,7 +553,7 @@ ACTOR static Future<Void> applyStagingKeysBatch(std::map<Key, StagingKey>::itera
 						    .detail("Version", iter->second.version.version)
 						    .detail("SubVersion", iter->second.version.sub);
 					}
-					tr->clear(singleKeyRange(iter->second.key));
+					tr.clear(singleKeyRange(iter->second.key), AddConflictRange::False);
 					txnSize += iter->second.totalSize();
 					cc->appliedMutations += 1;
 					TraceEvent(SevFRMutationInfo, "FastRestoreApplierPhaseApplyStagingKeysBatch", applierID)
@@ -574,10 +576,10 @@ ACTOR static Future<Void> applyStagingKeysBatch(std::map<Key, StagingKey>::itera
 			    .detail("End", endKey)
 			    .detail("Sets", sets)
 			    .detail("Clears", clears);
-			tr->addWriteConflictRange(KeyRangeRef(begin->first, keyAfter(endKey))); // Reduce resolver load
+			tr.addWriteConflictRange(KeyRangeRef(begin->first, keyAfter(endKey))); // Reduce resolver load
 			txnSizeUsed = txnSize;
 			*applyingDataBytes += txnSizeUsed; // Must account for applying bytes before wait for write traffic control
-			wait(tr->commit());
+			wait(tr.commit());
 			cc->appliedTxns += 1;
 			cc->appliedBytes += txnSize;
 			*appliedBytes += txnSize;
@@ -588,7 +590,7 @@ ACTOR static Future<Void> applyStagingKeysBatch(std::map<Key, StagingKey>::itera
 			break;
 		} catch (Error& e) {
 			cc->appliedTxnRetries += 1;
-			wait(tr->onError(e));
+			wait(tr.onError(e));
 			*applyingDataBytes -= txnSizeUsed;
 		}
 	}
@@ -22,17 +22,24 @@
 #include <memory.h>
 #include <stdio.h>
 #include <algorithm>
+#include <functional>
+#include <memory>
 #include <numeric>
 #include <string>
 #include <vector>
 
 #include "flow/Platform.h"
+#include "flow/ThreadPrimitives.h"
+#include "flow/UnitTest.h"
 #include "fdbrpc/fdbrpc.h"
 #include "fdbrpc/PerfMetric.h"
 #include "fdbclient/FDBTypes.h"
 #include "fdbclient/KeyRangeMap.h"
 #include "fdbclient/SystemData.h"
+#include "fdbserver/ArtVersionHistory.h"
 #include "fdbserver/ConflictSet.h"
+#include "fdbserver/Knobs.h"
+#include "fdbserver/RecentWriteFilter.h"
 
 static std::vector<PerfDoubleCounter*> skc;
 
@@ -219,6 +226,55 @@ void sortPoints(std::vector<KeyInfo>& points) {
 	}
 }
 
+// The first KeyPrefix::Size bytes of a key, zero padded, kept inline in SkipList nodes and fingers so that most
+// comparisons in a search are decided by a single 16 byte vector compare that never touches the key bytes
+// stored at the end of the node.
+struct KeyPrefix {
+	static constexpr int Size = 16;
+	uint8_t bytes[Size];
+
+	KeyPrefix() = default;
+	explicit KeyPrefix(const StringRef& key) { set(key.begin(), key.size()); }
+
+	void set(const uint8_t* key, int length) {
+		memset(bytes, 0, Size);
+		if (length > 0)
+			memcpy(bytes, key, std::min(length, Size));
+	}
+
+	// Returns <0, 0 or >0 as memcmp() would for the two padded prefixes
+	force_inline int compare(const KeyPrefix& other) const {
+		__m128i a = _mm_loadu_si128((const __m128i*)bytes);
+		__m128i b = _mm_loadu_si128((const __m128i*)other.bytes);
+		unsigned int diff = _mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) ^ 0xffff;
+		if (!diff)
+			return 0;
+		int i = __builtin_ctz(diff);
+		return (int)bytes[i] - (int)other.bytes[i];
+	}
+};
+
+// Returns true if key a sorts before key b, using their inline prefixes first.
+// The zero padding of a short key compares the same way as its end would: if the padded prefixes differ, the first
+// difference is either a real byte difference or the end of the shorter key, which must then be a prefix of the
+// longer one.  If they are equal and either key fits in the prefix, the shorter key is a prefix of the longer.
+static force_inline bool prefixLess(const KeyPrefix& aPrefix,
+                                    const uint8_t* a,
+                                    int aLen,
+                                    const KeyPrefix& bPrefix,
+                                    const uint8_t* b,
+                                    int bLen) {
+	int c = aPrefix.compare(bPrefix);
+	if (c != 0)
+		return c < 0;
+	if (std::min(aLen, bLen) <= KeyPrefix::Size)
+		return aLen < bLen;
+	c = memcmp(a + KeyPrefix::Size, b + KeyPrefix::Size, std::min(aLen, bLen) - KeyPrefix::Size);
+	if (c != 0)
+		return c < 0;
+	return aLen < bLen;
+}
+
 class SkipList : NonCopyable {
 private:
 	static constexpr int MaxLevels = 26;
@@ -240,6 +296,7 @@ private:
 		int level() const { return nPointers - 1; }
 		uint8_t* value() { return end() + nPointers * (sizeof(Node*) + sizeof(Version)); }
 		int length() const { return valueLength; }
+		const KeyPrefix& getPrefix() const { return prefix; }
 
 		// Returns the next node pointer at the given level.
 		Node* getNext(int level) { return *((Node**)end() + level); }
@@ -252,7 +309,7 @@ private:
 		void setMaxVersion(int i, Version v) { ((Version*)(end() + nPointers * sizeof(Node*)))[i] = v; }
 
 		// Return a node with initialized value but uninitialized pointers
-		// Memory layout: *this, (level+1) Node*, (level+1) Version, value
+		// Memory layout: *this (including the key prefix), (level+1) Node*, (level+1) Version, value
 		static Node* create(const StringRef& value, int level) {
 			int nodeSize = sizeof(Node) + value.size() + (level + 1) * (sizeof(Node*) + sizeof(Version));
 
@@ -271,6 +328,7 @@ private:
 			n->nPointers = level + 1;
 
 			n->valueLength = value.size();
+			n->prefix.set(value.begin(), value.size());
 			if (value.size() > 0) {
 				memcpy(n->value(), value.begin(), value.size());
 			}
@@ -306,17 +364,9 @@ private:
 		uint8_t* end() { return (uint8_t*)(this + 1); }
 		uint8_t const* end() const { return (uint8_t const*)(this + 1); }
 		int nPointers, valueLength;
+		KeyPrefix prefix;
 	};
 
-	static force_inline bool less(const uint8_t* a, int aLen, const uint8_t* b, int bLen) {
-		int c = memcmp(a, b, std::min(aLen, bLen));
-		if (c < 0)
-			return true;
-		if (c > 0)
-			return false;
-		return aLen < bLen;
-	}
-
 	Node* header;
 
 	void destroy() {
@@ -338,17 +388,28 @@ public:
 		Node* x = nullptr;
 		Node* alreadyChecked = nullptr;
 		StringRef value;
+		KeyPrefix prefix;
 
 		Finger() = default;
-		Finger(Node* header, const StringRef& ptr) : x(header), value(ptr) {}
+		Finger(Node* header, const StringRef& ptr) : x(header), value(ptr), prefix(ptr) {}
 
 		void init(const StringRef& value, Node* header) {
-			this->value = value;
+			setValue(value);
 			x = header;
 			alreadyChecked = nullptr;
 			level = MaxLevels;
 		}
 
+		void setValue(const StringRef& value) {
+			this->value = value;
+			prefix.set(value.begin(), value.size());
+		}
+
+		// Returns true if the node sorts before this finger's value
+		force_inline bool isAfter(Node* n) const {
+			return prefixLess(n->getPrefix(), n->value(), n->length(), prefix, value.begin(), value.size());
+		}
+
 		// pre: !finished()
 		force_inline void prefetch() {
 			Node* next = x->getNext(level - 1);
@@ -365,7 +426,7 @@ public:
 		force_inline bool advance() {
 			Node* next = x->getNext(level - 1);
 
-			if (next == alreadyChecked || !less(next->value(), next->length(), value.begin(), value.size())) {
+			if (next == alreadyChecked || !isAfter(next)) {
 				alreadyChecked = next;
 				level--;
 				finger[level] = x;
@@ -490,8 +551,8 @@ public:
 	//   partitions.  In between, operations on each partition must not touch any keys outside
 	//   the partition.  Specifically, the partition to the left of 'key' must not have a range
 	//	 [...,key) inserted, since that would insert an entry at 'key'.
-	// Note this function is not used.
-	void partition(StringRef* begin, int splitCount, SkipList* output) {
+	// Each output SkipList must be empty.
+	void partition(const StringRef* begin, int splitCount, SkipList* output) {
 		for (int i = splitCount - 1; i >= 0; i--) {
 			Finger f(header, begin[i]);
 			while (!f.finished())
@@ -501,8 +562,7 @@ public:
 		swap(output[0]);
 	}
 
-	// Concatenates multiple SkipList objects into one and stores in input[0].
-	// Note this function is not used.
+	// Concatenates multiple SkipList objects into this one, leaving all of the inputs empty.
 	void concatenate(SkipList* input, int count) {
 		std::vector<Finger> ends(count - 1);
 		for (int i = 0; i < ends.size(); i++)
@@ -526,10 +586,11 @@ public:
 		// vtune: 11 parts
 		results[0].init(values[0], header);
 		const StringRef& endValue = values[count - 1];
+		const KeyPrefix endPrefix(endValue);
 		while (results[0].level > 1) {
 			results[0].nextLevel();
 			Node* ac = results[0].alreadyChecked;
-			if (ac && less(ac->value(), ac->length(), endValue.begin(), endValue.size()))
+			if (ac && prefixLess(ac->getPrefix(), ac->value(), ac->length(), endPrefix, endValue.begin(), endValue.size()))
 				break;
 		}
 
@@ -544,7 +605,7 @@ public:
 			results[i].level = startLevel;
 			results[i].x = x;
 			results[i].alreadyChecked = nullptr;
-			results[i].value = values[i];
+			results[i].setValue(values[i]);
 			for (int j = startLevel; j < MaxLevels; j++)
 				results[i].finger[j] = results[0].finger[j];
 		}
@@ -767,6 +828,12 @@ private:
 			right.header->setNext(l, f.finger[l]->getNext(l));
 			f.finger[l]->setNext(l, nullptr);
 		}
+		// The max versions of the upper levels now span different nodes on both sides of the split, so they
+		// have to be recomputed bottom up for the detached fingers and for the new header.
+		for (int l = 1; l < MaxLevels; l++) {
+			f.finger[l]->calcVersionForLevel(l);
+			right.header->calcVersionForLevel(l);
+		}
 	}
 
 	// Sets end's finger to the last nodes at all levels.
@@ -782,20 +849,110 @@ private:
 	}
 };
 
+// Runs the per-partition work of a ConflictBatch on helper threads.  The calling thread always runs the
+// first partition itself, so a pool for N partitions owns N-1 threads.  In simulation no threads are
+// started and all partitions run sequentially on the calling thread, which keeps runs deterministic
+// while still exercising the partitioned code path.
+class ConflictSetWorkers : NonCopyable {
+	struct Worker {
+		THREAD_HANDLE handle;
+		Event wake, done;
+		std::function<void()> task;
+		bool stopping = false;
+	};
+
+	std::vector<std::unique_ptr<Worker>> workers;
+
+	THREAD_FUNC workerMain(void* arg) {
+		Worker* w = (Worker*)arg;
+		while (true) {
+			w->wake.block();
+			if (w->stopping)
+				break;
+			w->task();
+			w->task = nullptr;
+			w->done.set();
+		}
+		THREAD_RETURN;
+	}
+
+public:
+	explicit ConflictSetWorkers(int partitionCount) : partitionCount(partitionCount) {
+		if (g_network && g_network->isSimulated())
+			return;
+		for (int i = 1; i < partitionCount; i++) {
+			workers.push_back(std::make_unique<Worker>());
+			workers.back()->handle = startThread(workerMain, workers.back().get(), 0, "fdb-conflictset");
+		}
+	}
+	~ConflictSetWorkers() {
+		for (auto& w : workers) {
+			w->stopping = true;
+			w->wake.set();
+			waitThread(w->handle);
+		}
+	}
+
+	// Calls task(i) for each i in [0, count) and returns once all of them have completed.
+	void run(int count, const std::function<void(int)>& task) {
+		ASSERT(count <= partitionCount);
+		int started = 0;
+		for (; started < count - 1 && started < workers.size(); started++) {
+			workers[started]->task = [&task, started]() { task(started + 1); };
+			workers[started]->wake.set();
+		}
+		task(0);
+		for (int i = started + 1; i < count; i++)
+			task(i);
+		for (int i = 0; i < started; i++)
+			workers[i]->done.block();
+	}
+
+	const int partitionCount;
+};
+
 struct ConflictSet {
-	ConflictSet() : removalKey(makeString(0)), oldestVersion(0) {}
+	ConflictSet(int partitionCount, bool useART, bool useWriteFilter) : removalKey(makeString(0)), oldestVersion(0) {
+		if (useWriteFilter) {
+			writeFilter = std::make_unique<RecentWriteFilter>(SERVER_KNOBS->RESOLVER_RECENT_WRITE_FILTER_BITS_LOG2,
+			                                                  SERVER_KNOBS->RESOLVER_RECENT_WRITE_FILTER_PREFIX_BYTES,
+			                                                  SERVER_KNOBS->RESOLVER_RECENT_WRITE_FILTER_WINDOW_VERSIONS);
+		}
+		if (useART) {
+			art = std::make_unique<ArtVersionHistory>();
+		} else if (partitionCount > 1) {
+			workers = std::make_unique<ConflictSetWorkers>(partitionCount);
+			partitions = std::vector<SkipList>(partitionCount);
+		}
+	}
 	~ConflictSet() {}
 
 	SkipList versionHistory;
 	Key removalKey;
 	Version oldestVersion;
+
+	// Only present when conflict detection is partitioned.  partitions are empty between batches and hold
+	// the pieces of versionHistory while a batch is being resolved.
+	std::unique_ptr<ConflictSetWorkers> workers;
+	std::vector<SkipList> partitions;
+
+	// When present, the version history is kept here and versionHistory stays empty
+	std::unique_ptr<ArtVersionHistory> art;
+
+	// When present, read ranges it rules out are not checked against the version history
+	std::unique_ptr<RecentWriteFilter> writeFilter;
 };
 
-ConflictSet* newConflictSet() {
-	return new ConflictSet;
+ConflictSet* newConflictSet(int partitionCount, bool useART, bool useWriteFilter) {
+	return new ConflictSet(partitionCount, useART, useWriteFilter);
 }
 void clearConflictSet(ConflictSet* cs, Version v) {
-	SkipList(v).swap(cs->versionHistory);
+	if (cs->writeFilter)
+		cs->writeFilter->clear(v);
+	if (cs->art)
+		cs->art->clear(v);
+	else
+		SkipList(v).swap(cs->versionHistory);
 }
 void destroyConflictSet(ConflictSet* cs) {
 	delete cs;
@@ -805,7 +962,7 @@ ConflictBatch::ConflictBatch(ConflictSet* cs,
                              std::map<int, VectorRef<int>>* conflictingKeyRangeMap,
                              Arena* resolveBatchReplyArena)
   : cs(cs), transactionCount(0), conflictingKeyRangeMap(conflictingKeyRangeMap),
-    resolveBatchReplyArena(resolveBatchReplyArena) {}
+    resolveBatchReplyArena(resolveBatchReplyArena), filteredReadRanges(0), checkedReadRanges(0) {}
 
 ConflictBatch::~ConflictBatch() {}
 
@@ -813,15 +970,28 @@ struct TransactionInfo {
 	VectorRef<std::pair<int, int>> readRanges;
 	VectorRef<std::pair<int, int>> writeRanges;
 	bool tooOld;
-	bool reportConflictingKeys;
+	// Where the indices of the conflicting read ranges go, nullptr if they aren't reported or sampled
+	VectorRef<int>* conflictingKeyRange;
+	Arena* cKRArena;
 };
 
-void ConflictBatch::addTransaction(const CommitTransactionRef& tr, Version newOldestVersion) {
+void ConflictBatch::addTransaction(const CommitTransactionRef& tr,
+                                   Version newOldestVersion,
+                                   bool sampleConflictingKeys) {
 	const int t = transactionCount++;
 
 	Arena& arena = transactionInfo.arena();
 	TransactionInfo* info = new (arena) TransactionInfo;
-	info->reportConflictingKeys = tr.report_conflicting_keys;
+	if (tr.report_conflicting_keys) {
+		info->conflictingKeyRange = &(*conflictingKeyRangeMap)[t];
+		info->cKRArena = resolveBatchReplyArena;
+	} else if (sampleConflictingKeys) {
+		info->conflictingKeyRange = &sampledConflictingKeyRangeMap[t];
+		info->cKRArena = &sampledConflictingKeyRangeArena;
+	} else {
+		info->conflictingKeyRange = nullptr;
+		info->cKRArena = nullptr;
+	}
 
 	if (tr.read_snapshot < newOldestVersion && tr.read_conflict_ranges.size()) {
 		info->tooOld = true;
@@ -839,9 +1009,8 @@ void ConflictBatch::addTransaction(const CommitTransactionRef& tr, Version newOl
 			                                        tr.read_snapshot,
 			                                        t,
 			                                        r,
-			                                        tr.report_conflicting_keys ? &(*conflictingKeyRangeMap)[t]
-			                                                                   : nullptr,
-			                                        tr.report_conflicting_keys ? resolveBatchReplyArena : nullptr);
+			                                        info->conflictingKeyRange,
+			                                        info->cKRArena);
 		}
 		for (int r = 0; r < tr.write_conflict_ranges.size(); r++) {
 			const KeyRangeRef& range = tr.write_conflict_ranges[r];
@@ -884,8 +1053,8 @@ void ConflictBatch::checkIntraBatchConflicts() {
 		bool conflict = tr.tooOld;
 		for (int i = 0; i < tr.readRanges.size(); i++) {
 			if (mcs.any(tr.readRanges[i].first, tr.readRanges[i].second)) {
-				if (tr.reportConflictingKeys) {
-					(*conflictingKeyRangeMap)[t].push_back(*resolveBatchReplyArena, i);
+				if (tr.conflictingKeyRange != nullptr) {
+					tr.conflictingKeyRange->push_back(*tr.cKRArena, i);
 				}
 				conflict = true;
 				break;
@@ -917,21 +1086,51 @@ void ConflictBatch::detectConflicts(Version now,
 	transactionConflictStatus = new bool[transactionCount];
 	memset(transactionConflictStatus, 0, transactionCount * sizeof(bool));
 
-	t = timer();
-	checkReadConflictRanges();
-	g_checkRead += timer() - t;
+	filterReadConflictRanges();
 
-	t = timer();
-	checkIntraBatchConflicts();
-	g_checkBatch += timer() - t;
+	std::vector<StringRef> partitionKeys;
+	if (cs->workers && points.size() >= SERVER_KNOBS->RESOLVER_CONFLICT_SET_PARALLEL_MIN_POINTS) {
+		partitionKeys = choosePartitionKeys(cs->workers->partitionCount);
+	}
 
-	t = timer();
-	combineWriteConflictRanges();
-	g_combine += timer() - t;
+	if (partitionKeys.empty()) {
+		t = timer();
+		checkReadConflictRanges();
+		g_checkRead += timer() - t;
 
-	t = timer();
-	mergeWriteConflictRanges(now);
-	g_merge += timer() - t;
+		t = timer();
+		checkIntraBatchConflicts();
+		g_checkBatch += timer() - t;
+
+		t = timer();
+		combineWriteConflictRanges();
+		g_combine += timer() - t;
+
+		t = timer();
+		mergeWriteConflictRanges(now);
+		g_merge += timer() - t;
+	} else {
+		SkipList* parts = cs->partitions.data();
+		t = timer();
+		cs->versionHistory.partition(partitionKeys.data(), partitionKeys.size(), parts);
+		checkReadConflictRangesPartitioned(partitionKeys, parts);
+		g_checkRead += timer() - t;
+
+		t = timer();
+		checkIntraBatchConflicts();
+		g_checkBatch += timer() - t;
+
+		t = timer();
+		combineWriteConflictRanges();
+		g_combine += timer() - t;
+
+		t = timer();
+		mergeWriteConflictRangesPartitioned(now, partitionKeys, parts);
+		cs->versionHistory.concatenate(parts, partitionKeys.size() + 1);
+		g_merge += timer() - t;
+	}
+	if (cs->writeFilter)
+		cs->writeFilter->addWrites(combinedWriteConflictRanges, now);
 
 	for (int i = 0; i < transactionCount; i++) {
 		if (tooOldTransactions && transactionInfo[i]->tooOld) {
@@ -946,23 +1145,152 @@ void ConflictBatch::detectConflicts(Version now,
 	t = timer();
 	if (newOldestVersion > cs->oldestVersion) {
 		cs->oldestVersion = newOldestVersion;
-		SkipList::Finger finger;
-		int temp;
-		cs->versionHistory.find(&cs->removalKey, &finger, &temp, 1);
-		cs->versionHistory.removeBefore(cs->oldestVersion, finger, combinedWriteConflictRanges.size() * 3 + 10);
-		cs->removalKey = finger.getValue();
+		if (cs->writeFilter)
+			cs->writeFilter->removeBefore(cs->oldestVersion);
+		const int nodeCount = combinedWriteConflictRanges.size() * 3 + 10;
+		if (cs->art) {
+			cs->removalKey = cs->art->removeBefore(cs->oldestVersion, cs->removalKey, nodeCount);
+		} else {
+			SkipList::Finger finger;
+			int temp;
+			cs->versionHistory.find(&cs->removalKey, &finger, &temp, 1);
+			cs->versionHistory.removeBefore(cs->oldestVersion, finger, nodeCount);
+			cs->removalKey = finger.getValue();
+		}
 	}
 	g_removeBefore += timer() - t;
 }
 
+// Drops the read ranges that the recent write filter proves conflict-free, so that only the rest are looked up in the
+// version history
+void ConflictBatch::filterReadConflictRanges() {
+	if (cs->writeFilter) {
+		auto kept = std::remove_if(
+		    combinedReadConflictRanges.begin(), combinedReadConflictRanges.end(), [this](const ReadConflictRange& range) {
+			    return !cs->writeFilter->mayConflict(range.begin, range.end, range.version);
+		    });
+		filteredReadRanges = combinedReadConflictRanges.end() - kept;
+		combinedReadConflictRanges.erase(kept, combinedReadConflictRanges.end());
+	}
+	checkedReadRanges = combinedReadConflictRanges.size();
+}
+
 void ConflictBatch::checkReadConflictRanges() {
 	if (combinedReadConflictRanges.empty())
 		return;
 
+	if (cs->art) {
+		for (const ReadConflictRange& range : combinedReadConflictRanges) {
+			if (cs->art->hasConflict(range.begin, range.end, range.version)) {
+				transactionConflictStatus[range.transaction] = true;
+				if (range.conflictingKeyRange != nullptr)
+					range.conflictingKeyRange->push_back(*range.cKRArena, range.indexInTx);
+			}
+		}
+		return;
+	}
+
 	cs->versionHistory.detectConflicts(
 	    &combinedReadConflictRanges[0], combinedReadConflictRanges.size(), transactionConflictStatus);
 }
 
+// Chooses up to partitionCount-1 keys splitting the batch into pieces with roughly the same number of points.
+// A key is only eligible if no write conflict range in the batch spans it and the nearest write range to its
+// left ends strictly before it, so that merging the combined write ranges never touches more than one partition.
+std::vector<StringRef> ConflictBatch::choosePartitionKeys(int partitionCount) {
+	std::vector<StringRef> keys;
+	const int pointsPerPartition = points.size() / partitionCount;
+	int activeWriteCount = 0;
+	int nextBoundary = pointsPerPartition;
+	Optional<StringRef> lastWriteEnd;
+	for (int p = 0; p < points.size() && keys.size() < partitionCount - 1; p++) {
+		const KeyInfo& point = points[p];
+		if (!point.write)
+			continue;
+		if (point.begin) {
+			if (activeWriteCount++ == 0 && p >= nextBoundary && point.key.size() &&
+			    (!lastWriteEnd.present() || compare(lastWriteEnd.get(), point.key) < 0) &&
+			    (keys.empty() || compare(keys.back(), point.key) < 0)) {
+				keys.push_back(point.key);
+				nextBoundary = p + pointsPerPartition;
+			}
+		} else if (--activeWriteCount == 0) {
+			lastWriteEnd = point.key;
+		}
+	}
+	return keys;
+}
+
+void ConflictBatch::checkReadConflictRangesPartitioned(const std::vector<StringRef>& partitionKeys, SkipList* parts) {
+	const int partitionCount = partitionKeys.size() + 1;
+	const int rangeCount = combinedReadConflictRanges.size();
+	if (!rangeCount)
+		return;
+
+	// Each read range is clipped to the partitions it overlaps.  The clipped pieces record conflicts by the index of
+	// the range they came from (in their transaction field), in a result array private to each partition, and the
+	// results are merged back once all partitions are done.
+	std::vector<std::vector<ReadConflictRange>> pieces(partitionCount);
+	for (int r = 0; r < rangeCount; r++) {
+		const ReadConflictRange& range = combinedReadConflictRanges[r];
+		int first = std::upper_bound(partitionKeys.begin(),
+		                             partitionKeys.end(),
+		                             range.begin,
+		                             [](const StringRef& a, const StringRef& b) { return compare(a, b) < 0; }) -
+		            partitionKeys.begin();
+		for (int i = first; i < partitionCount; i++) {
+			if (i > first && compare(partitionKeys[i - 1], range.end) >= 0)
+				break;
+			StringRef begin = i > first ? partitionKeys[i - 1] : range.begin;
+			StringRef end =
+			    i < partitionKeys.size() && compare(partitionKeys[i], range.end) < 0 ? partitionKeys[i] : range.end;
+			pieces[i].emplace_back(begin, end, range.version, r, range.indexInTx);
+		}
+	}
+
+	std::unique_ptr<bool[]> rangeConflicts(new bool[partitionCount * rangeCount]());
+	cs->workers->run(partitionCount, [&](int i) {
+		if (pieces[i].size())
+			parts[i].detectConflicts(&pieces[i][0], pieces[i].size(), rangeConflicts.get() + i * rangeCount);
+	});
+
+	for (int r = 0; r < rangeCount; r++) {
+		for (int i = 0; i < partitionCount; i++) {
+			if (rangeConflicts[i * rangeCount + r]) {
+				const ReadConflictRange& range = combinedReadConflictRanges[r];
+				transactionConflictStatus[range.transaction] = true;
+				if (range.conflictingKeyRange != nullptr)
+					range.conflictingKeyRange->push_back(*range.cKRArena, range.indexInTx);
+				break;
+			}
+		}
+	}
+}
+
+void ConflictBatch::mergeWriteConflictRangesPartitioned(Version now,
+                                                        const std::vector<StringRef>& partitionKeys,
+                                                        SkipList* parts) {
+	const int partitionCount = partitionKeys.size() + 1;
+	// combinedWriteConflictRanges is sorted and, by the choice of partitionKeys, no range crosses a partition
+	// boundary, so each partition gets a contiguous run of ranges.
+	std::vector<std::vector<std::pair<StringRef, StringRef>>::iterator> bounds(partitionCount + 1);
+	bounds[0] = combinedWriteConflictRanges.begin();
+	bounds[partitionCount] = combinedWriteConflictRanges.end();
+	for (int i = 1; i < partitionCount; i++) {
+		bounds[i] = std::lower_bound(bounds[i - 1],
+		                             combinedWriteConflictRanges.end(),
+		                             partitionKeys[i - 1],
+		                             [](const std::pair<StringRef, StringRef>& range, const StringRef& key) {
+			                             return compare(range.first, key) < 0;
+		                             });
+	}
+
+	cs->workers->run(partitionCount, [&](int i) {
+		if (bounds[i] != bounds[i + 1])
+			addConflictRanges(now, bounds[i], bounds[i + 1], &parts[i]);
+	});
+}
+
 void ConflictBatch::addConflictRanges(Version now,
                                       std::vector<std::pair<StringRef, StringRef>>::iterator begin,
                                       std::vector<std::pair<StringRef, StringRef>>::iterator end,
@@ -990,6 +1318,12 @@ void ConflictBatch::mergeWriteConflictRanges(Version now) {
 	if (combinedWriteConflictRanges.empty())
 		return;
 
+	if (cs->art) {
+		for (const auto& range : combinedWriteConflictRanges)
+			cs->art->addConflictRange(range.first, range.second, now);
+		return;
+	}
+
 	addConflictRanges(now, combinedWriteConflictRanges.begin(), combinedWriteConflictRanges.end(), &cs->versionHistory);
 }
 
@@ -1079,6 +1413,129 @@ void operatorLessThanTest() {
 }
 } // namespace
 
+TEST_CASE("/fdbserver/SkipList/KeyPrefixCompare") {
+	Arena arena;
+	const uint8_t alphabet[] = { 0, 1, 'a', 0xff };
+	auto randomKey = [&]() {
+		int length = deterministicRandom()->randomInt(0, 2 * KeyPrefix::Size + 4);
+		uint8_t* key = new (arena) uint8_t[length];
+		for (int i = 0; i < length; i++)
+			key[i] = alphabet[deterministicRandom()->randomInt(0, sizeof(alphabet))];
+		return StringRef(key, length);
+	};
+	// Returns a key sharing a random length prefix with key
+	auto similarKey = [&](StringRef key) {
+		StringRef suffix = randomKey();
+		int shared = deterministicRandom()->randomInt(0, key.size() + 1);
+		return key.substr(0, shared).withSuffix(suffix.substr(0, deterministicRandom()->randomInt(0, 3)), arena);
+	};
+	for (int i = 0; i < 100000; i++) {
+		StringRef a = randomKey();
+		StringRef b = deterministicRandom()->coinflip() ? similarKey(a) : randomKey();
+		bool expected = compare(a, b) < 0;
+		ASSERT_EQ(prefixLess(KeyPrefix(a), a.begin(), a.size(), KeyPrefix(b), b.begin(), b.size()), expected);
+	}
+	return Void();
+}
+
+namespace {
+// Resolves the same random batches with both conflict sets and checks that the results are identical
+void checkSameResults(ConflictSet* expected, ConflictSet* actual, std::function<StringRef(Arena&, int)> makeKey) {
+	const int keySpace = deterministicRandom()->randomInt(1000, 1000000);
+
+	Version version = 100;
+	for (int b = 0; b < 20; b++) {
+		Arena arena;
+		std::vector<CommitTransactionRef> trs(2000);
+		for (auto& tr : trs) {
+			tr.read_snapshot = version - deterministicRandom()->randomInt(0, 60);
+			tr.report_conflicting_keys = deterministicRandom()->coinflip();
+			for (int r = deterministicRandom()->randomInt(0, 4); r > 0; r--) {
+				int key = deterministicRandom()->randomInt(0, keySpace);
+				int key2 = key + deterministicRandom()->randomInt(0, 100);
+				tr.read_conflict_ranges.push_back(arena, KeyRangeRef(makeKey(arena, key), makeKey(arena, key2)));
+			}
+			for (int w = deterministicRandom()->randomInt(0, 3); w > 0; w--) {
+				int key = deterministicRandom()->randomInt(0, keySpace);
+				int key2 = key + 1 + deterministicRandom()->randomInt(0, 20);
+				tr.write_conflict_ranges.push_back(arena, KeyRangeRef(makeKey(arena, key), makeKey(arena, key2)));
+			}
+		}
+
+		const Version newOldestVersion = version - 50;
+		std::map<int, VectorRef<int>> expectedKeys, actualKeys;
+		Arena expectedArena, actualArena;
+		std::vector<int> expectedCommitted, actualCommitted, expectedTooOld, actualTooOld;
+		ConflictBatch expectedBatch(expected, &expectedKeys, &expectedArena);
+		ConflictBatch actualBatch(actual, &actualKeys, &actualArena);
+		for (const auto& tr : trs) {
+			expectedBatch.addTransaction(tr, newOldestVersion);
+			actualBatch.addTransaction(tr, newOldestVersion);
+		}
+		expectedBatch.detectConflicts(version, newOldestVersion, expectedCommitted, &expectedTooOld);
+		actualBatch.detectConflicts(version, newOldestVersion, actualCommitted, &actualTooOld);
+
+		ASSERT(expectedCommitted == actualCommitted);
+		ASSERT(expectedTooOld == actualTooOld);
+		ASSERT_EQ(expectedKeys.size(), actualKeys.size());
+		for (auto& [t, indices] : expectedKeys) {
+			auto it = actualKeys.find(t);
+			ASSERT(it != actualKeys.end());
+			std::vector<int> expectedIndices(indices.begin(), indices.end());
+			std::vector<int> actualIndices(it->second.begin(), it->second.end());
+			std::sort(expectedIndices.begin(), expectedIndices.end());
+			std::sort(actualIndices.begin(), actualIndices.end());
+			ASSERT(expectedIndices == actualIndices);
+		}
+		// The ART counts its boundary at the empty key, but the SkipList doesn't count its header
+		auto historySize = [](ConflictSet* cs) { return cs->art ? cs->art->count() - 1 : cs->versionHistory.count(); };
+		ASSERT_EQ(historySize(expected), historySize(actual));
+
+		version += deterministicRandom()->randomInt(1, 30);
+	}
+}
+} // namespace
+
+// Partitioned conflict detection must produce exactly the same results as the single SkipList.
+TEST_CASE("/fdbserver/SkipList/PartitionedConflictSet") {
+	ConflictSet* serial = newConflictSet();
+	ConflictSet* partitioned = newConflictSet(deterministicRandom()->randomInt(2, 9));
+	checkSameResults(serial, partitioned, setK);
+	destroyConflictSet(serial);
+	destroyConflictSet(partitioned);
+	return Void();
+}
+
+// So must a conflict set that rules out reads with the recent write filter first, here with a filter small enough to
+// fill up and with keys sharing tenant prefixes.
+TEST_CASE("/fdbserver/SkipList/RecentWriteFilter") {
+	ConflictSet* unfiltered = newConflictSet();
+	ConflictSet* filtered = newConflictSet(deterministicRandom()->coinflip() ? 1 : 4,
+	                                       deterministicRandom()->coinflip(),
+	                                       /* useWriteFilter */ true);
+	filtered->writeFilter = std::make_unique<RecentWriteFilter>(deterministicRandom()->randomInt(6, 21),
+	                                                            deterministicRandom()->randomInt(1, 20),
+	                                                            deterministicRandom()->randomInt(1, 100));
+	checkSameResults(unfiltered, filtered, [](Arena& arena, int i) {
+		return StringRef(format("tenant/%08d/", i >> 16)).withSuffix(setK(arena, i & 0xffff), arena);
+	});
+	destroyConflictSet(unfiltered);
+	destroyConflictSet(filtered);
+	return Void();
+}
+
+// So must the ART version history, here with keys spread over several tenant prefixes.
+TEST_CASE("/fdbserver/SkipList/ArtConflictSet") {
+	ConflictSet* skipList = newConflictSet();
+	ConflictSet* art = newConflictSet(1, true);
+	checkSameResults(skipList, art, [](Arena& arena, int i) {
+		return StringRef(format("tenant/%08d/", i >> 16)).withSuffix(setK(arena, i & 0xffff), arena);
+	});
+	destroyConflictSet(skipList);
+	destroyConflictSet(art);
+	return Void();
+}
+
 void skipListTest() {
 	printf("Skip list test\n");
 
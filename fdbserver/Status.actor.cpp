@@ -485,6 +485,20 @@ struct RolesInfo {
 		return latencyStats;
 	}
 
+	// Returns the statistics of each latency breakdown phase (see CLIENT_KNOBS->LATENCY_BREAKDOWN_SAMPLE_RATE) that the
+	// role has logged, keyed by phase name
+	JsonBuilderObject addLatencyBreakdown(EventMap const& metrics,
+	                                      std::vector<std::pair<std::string, std::string>> const& phases) {
+		JsonBuilderObject breakdown;
+		for (auto const& [eventName, phase] : phases) {
+			auto event = metrics.find(eventName);
+			if (event != metrics.end() && event->second.size()) {
+				breakdown[phase] = addLatencyStatistics(event->second);
+			}
+		}
+		return breakdown;
+	}
+
 	JsonBuilderObject addLatencyBandInfo(TraceEventFields const& metrics) {
 		JsonBuilderObject latencyBands;
 		std::map<std::string, JsonBuilderObject> bands;
@@ -581,6 +595,15 @@ struct RolesInfo {
 				obj["read_latency_bands"] = addLatencyBandInfo(readLatencyBands);
 			}
 
+			JsonBuilderObject latencyBreakdown =
+			    addLatencyBreakdown(metrics,
+			                        { { "LatencyBreakdownClientQueue", "client_queue" },
+			                          { "LatencyBreakdownVersionWait", "version_wait" },
+			                          { "LatencyBreakdownEngineRead", "engine_read" } });
+			if (!latencyBreakdown.empty()) {
+				obj["latency_breakdown"] = latencyBreakdown;
+			}
+
 			obj["data_lag"] = getLagObject(versionLag);
 			obj["durability_lag"] = getLagObject(version - durableVersion);
 			dataLagSeconds = versionLag / (double)SERVER_KNOBS->VERSIONS_PER_SECOND;
@@ -658,6 +681,12 @@ struct RolesInfo {
 			obj["durable_bytes"] = StatusCounter(tlogMetrics.getValue("BytesDurable")).getStatus();
 			metricVersion = tlogMetrics.getInt64("Version");
 			obj["data_version"] = metricVersion;
+
+			JsonBuilderObject latencyBreakdown =
+			    addLatencyBreakdown(metrics, { { "LatencyBreakdownFsync", "fsync" } });
+			if (!latencyBreakdown.empty()) {
+				obj["latency_breakdown"] = latencyBreakdown;
+			}
 		} catch (Error& e) {
 			if (e.code() != error_code_attribute_not_found)
 				throw e;
@@ -685,6 +714,16 @@ struct RolesInfo {
 			if (commitBatchingWindowSize.size()) {
 				obj["commit_batching_window_size"] = addLatencyStatistics(commitBatchingWindowSize);
 			}
+
+			JsonBuilderObject latencyBreakdown =
+			    addLatencyBreakdown(metrics,
+			                        { { "LatencyBreakdownClientQueue", "client_queue" },
+			                          { "LatencyBreakdownBatchWait", "batch_wait" },
+			                          { "LatencyBreakdownResolver", "resolver" },
+			                          { "LatencyBreakdownTLog", "tlog" } });
+			if (!latencyBreakdown.empty()) {
+				obj["latency_breakdown"] = latencyBreakdown;
+			}
 		} catch (Error& e) {
 			if (e.code() != error_code_attribute_not_found) {
 				throw e;
@@ -964,6 +1003,10 @@ ACTOR static Future<JsonBuilderObject> processStatusFetcher(
 				if (processMetricsElapsed > 0) {
 					JsonBuilderObject cpuObj;
 					cpuObj["usage_cores"] = std::max(0.0, cpuSeconds / processMetricsElapsed);
+					std::string affinity;
+					if (processMetrics.tryGetValue("CPUAffinity", affinity) && !affinity.empty()) {
+						cpuObj["affinity"] = affinity;
+					}
 					statusObj["cpu"] = cpuObj;
 
 					diskObj["busy"] =
@@ -2022,7 +2065,10 @@ const std::vector<std::string> STORAGE_SERVER_METRICS_LIST{ "StorageMetrics",
 	                                                        "ReadLatencyMetrics",
 	                                                        "ReadLatencyBands",
 	                                                        "BusiestReadTag",
-	                                                        "BusiestWriteTag" };
+	                                                        "BusiestWriteTag",
+	                                                        "LatencyBreakdownClientQueue",
+	                                                        "LatencyBreakdownVersionWait",
+	                                                        "LatencyBreakdownEngineRead" };
 
 } // namespace
 
@@ -2045,7 +2091,9 @@ ACTOR static Future<std::vector<std::pair<TLogInterface, EventMap>>> getTLogsAnd
     std::unordered_map<NetworkAddress, WorkerInterface> address_workers) {
 	std::vector<TLogInterface> servers = db->get().logSystemConfig.allPresentLogs();
 	std::vector<std::pair<TLogInterface, EventMap>> results =
-	    wait(getServerMetrics(servers, address_workers, std::vector<std::string>{ "TLogMetrics" }));
+	    wait(getServerMetrics(servers,
+	                          address_workers,
+	                          std::vector<std::string>{ "TLogMetrics", "LatencyBreakdownFsync" }));
 
 	return results;
 }
@@ -2057,7 +2105,13 @@ ACTOR static Future<std::vector<std::pair<CommitProxyInterface, EventMap>>> getC
 	std::vector<std::pair<CommitProxyInterface, EventMap>> results = wait(getServerMetrics(
 	    db->get().client.commitProxies,
 	    address_workers,
-	    std::vector<std::string>{ "CommitLatencyMetrics", "CommitLatencyBands", "CommitBatchingWindowSize" }));
+	    std::vector<std::string>{ "CommitLatencyMetrics",
+	                              "CommitLatencyBands",
+	                              "CommitBatchingWindowSize",
+	                              "LatencyBreakdownClientQueue",
+	                              "LatencyBreakdownBatchWait",
+	                              "LatencyBreakdownResolver",
+	                              "LatencyBreakdownTLog" }));
 
 	return results;
 }
@@ -2366,6 +2420,52 @@ ACTOR static Future<JsonBuilderObject> workloadStatusFetcher(
 		incomplete_reasons->insert("Unknown read state.");
 	}
 
+	// Conflicting key prefixes, summed over the resolvers
+	try {
+		state std::vector<Future<TraceEventFields>> resolverPrefixFutures;
+		std::map<NetworkAddress, WorkerDetails> workersMap;
+		for (auto const& w : workers) {
+			workersMap[w.interf.address()] = w;
+		}
+		for (auto& r : db->get().resolvers) {
+			auto worker = getWorker(workersMap, r.address());
+			if (!worker.present())
+				throw all_alternatives_failed();
+			resolverPrefixFutures.push_back(timeoutError(
+			    worker.get().interf.eventLogRequest.getReply(
+			        EventLogRequest(StringRef(r.id().toString() + "/ResolverConflictingKeyPrefixes"))),
+			    1.0));
+		}
+		std::vector<TraceEventFields> resolverPrefixes = wait(getAll(resolverPrefixFutures));
+
+		std::map<std::string, double> rates;
+		for (auto const& fields : resolverPrefixes) {
+			// A resolver that has just started hasn't logged its prefixes yet
+			if (fields.size() == 0)
+				continue;
+			int count = fields.getInt("Prefixes");
+			for (int i = 0; i < count; i++) {
+				rates[fields.getValue(format("Prefix%d", i))] += fields.getDouble(format("Rate%d", i));
+			}
+		}
+		std::vector<std::pair<std::string, double>> sorted(rates.begin(), rates.end());
+		std::sort(sorted.begin(), sorted.end(), [](auto const& a, auto const& b) { return a.second > b.second; });
+		sorted.resize(std::min<size_t>(sorted.size(), SERVER_KNOBS->RESOLVER_CONFLICT_PREFIXES_IN_STATUS));
+
+		JsonBuilderArray prefixesArr;
+		for (auto const& [prefix, rate] : sorted) {
+			JsonBuilderObject prefixObj;
+			prefixObj["prefix"] = prefix;
+			prefixObj["conflicts_per_second"] = rate;
+			prefixesArr.push_back(prefixObj);
+		}
+		statusObj["conflicting_key_prefixes"] = prefixesArr;
+	} catch (Error& e) {
+		if (e.code() == error_code_actor_cancelled)
+			throw;
+		incomplete_reasons->insert("Unknown conflicting key prefixes.");
+	}
+
 	statusObj["operations"] = operationsObj;
 	statusObj["keys"] = keysObj;
 	statusObj["bytes"] = bytesObj;
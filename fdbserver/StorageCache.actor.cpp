@@ -31,6 +31,7 @@
 #include "fdbclient/StorageServerInterface.h"
 #include "fdbclient/VersionedMap.h"
 #include "fdbclient/KeyRangeMap.h"
+#include "fdbclient/ManagementAPI.actor.h"
 #include "fdbclient/Atomic.h"
 #include "fdbclient/Notified.h"
 #include "fdbserver/LogProtocolMessage.h"
@@ -174,8 +175,8 @@ public:
 	KeyRangeMap<Reference<CacheRangeInfo>> cachedRangeMap; // map of cached key-ranges
 	uint64_t cacheRangeChangeCounter; // Max( CacheRangeInfo->changecounter )
 
-	// TODO Add cache metrics, such as available memory/in-use memory etc to help dat adistributor assign cached ranges
-	// StorageCacheMetrics metrics;
+	// Bytes read from each readable cached range since the last eviction check, by the begin of the range
+	std::map<Key, int64_t> bytesReadByRange;
 
 	// newestAvailableVersion[k]
 	//   == invalidVersion -> k is unavailable at all versions
@@ -224,6 +225,7 @@ public:
 		Counter updateBatches, updateVersions;
 		Counter loops;
 		Counter readsRejected;
+		Counter rangesEvicted;
 
 		// LatencyBands readLatencyBands;
 
@@ -235,10 +237,19 @@ public:
 		    bytesFetched("BytesFetched", cc), mutationBytes("MutationBytes", cc), mutations("Mutations", cc),
 		    setMutations("SetMutations", cc), clearRangeMutations("ClearRangeMutations", cc),
 		    atomicMutations("AtomicMutations", cc), updateBatches("UpdateBatches", cc),
-		    updateVersions("UpdateVersions", cc), loops("Loops", cc), readsRejected("ReadsRejected", cc) {
+		    updateVersions("UpdateVersions", cc), loops("Loops", cc), readsRejected("ReadsRejected", cc),
+		    rangesEvicted("RangesEvicted", cc) {
 			specialCounter(cc, "LastTLogVersion", [self]() { return self->lastTLogVersion; });
 			specialCounter(cc, "Version", [self]() { return self->version.get(); });
 			specialCounter(cc, "VersionLag", [self]() { return self->versionLag; });
+			specialCounter(cc, "CachedRanges", [self]() {
+				int64_t count = 0;
+				for (auto r : self->cachedRangeMap.ranges()) {
+					count += r.value()->isReadable();
+				}
+				return count;
+			});
+			specialCounter(cc, "ResidentMemory", []() { return getResidentMemoryUsage(); });
 		}
 	} counters;
 
@@ -258,6 +269,20 @@ public:
 		cx = openDBOnServer(db, TaskPriority::DefaultEndpoint, LockAware::True);
 	}
 
+	// Counts bytes read at key towards the cached range that holds it, to pick which range to evict
+	void addBytesRead(KeyRef key, int64_t bytes) {
+		auto r = cachedRangeMap.rangeContaining(key);
+		if (!r->value()->isReadable()) {
+			return;
+		}
+		auto it = bytesReadByRange.find(r->begin());
+		if (it == bytesReadByRange.end()) {
+			bytesReadByRange[r->begin()] = bytes;
+		} else {
+			it->second += bytes;
+		}
+	}
+
 	// Puts the given cacheRange into cachedRangeMap.  The caller is responsible for adding cacheRanges
 	//   for all ranges in cachedRangeMap.getAffectedRangesAfterInsertion(newCacheRange->keys)), because these
 	//   cacheRanges are invalidated by the call.
@@ -527,6 +552,7 @@ ACTOR Future<Void> getValueQ(StorageCacheData* data, GetValueRequest req) {
 			++data->counters.rowsQueried;
 			resultSize = v.get().size();
 			data->counters.bytesQueried += resultSize;
+			data->addBytesRead(req.key, resultSize);
 			//TraceEvent(SevDebug, "SCGetValueQPresent", data->thisServerID).detail("ResultSize",resultSize).detail("Version", version).detail("ReqKey",req.key).detail("Value",v);
 		}
 
@@ -838,6 +864,7 @@ ACTOR Future<Void> getKeyValues(StorageCacheData* data, GetKeyValuesRequest req)
 			resultSize = req.limitBytes - remainingLimitBytes;
 			data->counters.bytesQueried += resultSize;
 			data->counters.rowsQueried += r.data.size();
+			data->addBytesRead(begin, resultSize);
 		}
 	} catch (Error& e) {
 		TraceEvent(SevWarn, "SCGetKeyValuesError", data->thisServerID)
@@ -1840,6 +1867,52 @@ ACTOR Future<Void> compactCache(StorageCacheData* data) {
 	}
 }
 
+// Once the process uses more than STORAGE_CACHE_MEMORY_LIMIT, removes the cached range that was read the least since
+// the last check from the cache. At most one range is evicted per check, since memory is only given back after the
+// removal reaches this server and the versions holding the range's data are compacted away.
+ACTOR Future<Void> evictColdCacheRanges(StorageCacheData* data) {
+	loop {
+		wait(delay(SERVER_KNOBS->STORAGE_CACHE_EVICTION_INTERVAL, TaskPriority::CompactCache));
+
+		state int64_t residentMemory = getResidentMemoryUsage();
+		state int64_t memoryLimit = SERVER_KNOBS->STORAGE_CACHE_MEMORY_LIMIT;
+		if (memoryLimit <= 0 || residentMemory <= memoryLimit) {
+			data->bytesReadByRange.clear();
+			continue;
+		}
+
+		state Optional<KeyRange> coldest;
+		int64_t coldestBytesRead = 0;
+		for (auto r : data->cachedRangeMap.ranges()) {
+			if (!r.value()->isReadable()) {
+				continue;
+			}
+			// Ranges may have been coalesced since they were read, so sum everything read within this one
+			int64_t bytesRead = 0;
+			for (auto it = data->bytesReadByRange.lower_bound(r.begin());
+			     it != data->bytesReadByRange.end() && it->first < r.end();
+			     ++it) {
+				bytesRead += it->second;
+			}
+			if (!coldest.present() || bytesRead < coldestBytesRead) {
+				coldest = r.range();
+				coldestBytesRead = bytesRead;
+			}
+		}
+		data->bytesReadByRange.clear();
+
+		if (coldest.present()) {
+			TraceEvent("StorageCacheEvictRange", data->thisServerID)
+			    .detail("Range", coldest.get())
+			    .detail("BytesRead", coldestBytesRead)
+			    .detail("ResidentMemory", residentMemory)
+			    .detail("MemoryLimit", memoryLimit);
+			wait(ManagementAPI::removeCachedRange(data->cx.getReference(), coldest.get()));
+			++data->counters.rangesEvicted;
+		}
+	}
+}
+
 ACTOR Future<Void> pullAsyncData(StorageCacheData* data) {
 	state Future<Void> dbInfoChange = Void();
 	state Reference<ILogSystem::IPeekCursor> cursor;
@@ -2236,6 +2309,7 @@ ACTOR Future<Void> storageCacheServer(StorageServerInterface ssi,
 
 	// compactCache actor will periodically compact the cache when certain version condition is met
 	actors.add(compactCache(&self));
+	actors.add(evictColdCacheRanges(&self));
 
 	// pullAsyncData actor pulls mutations from the TLog and also applies them.
 	actors.add(pullAsyncData(&self));
@@ -2259,7 +2333,11 @@ ACTOR Future<Void> storageCacheServer(StorageServerInterface ssi,
 				actors.add(getKey(&self, req));
 			}
 			when(GetKeyValuesRequest req = waitNext(ssi.getKeyValues.getFuture())) {
-				actors.add(getKeyValues(&self, req));
+				// Filtered reads are not served from the cache either
+				if (!req.filter.empty())
+					req.reply.sendError(broken_promise());
+				else
+					actors.add(getKeyValues(&self, req));
 			}
 			when(GetShardStateRequest req = waitNext(ssi.getShardState.getFuture())) {
 				ASSERT(false);
@@ -2277,6 +2355,11 @@ ACTOR Future<Void> storageCacheServer(StorageServerInterface ssi,
 			when(GetMappedKeyValuesRequest req = waitNext(ssi.getMappedKeyValues.getFuture())) {
 				ASSERT(false);
 			}
+			when(GetValuesRequest req = waitNext(ssi.getValues.getFuture())) {
+				// Batched reads are not served from the cache. Simulate endpoint not found so that the requester will
+				// try a storage server instead.
+				req.reply.sendError(broken_promise());
+			}
 			when(WaitMetricsRequest req = waitNext(ssi.waitMetrics.getFuture())) {
 				ASSERT(false);
 			}
@@ -2289,6 +2372,10 @@ ACTOR Future<Void> storageCacheServer(StorageServerInterface ssi,
 			when(ReadHotSubRangeRequest req = waitNext(ssi.getReadHotRanges.getFuture())) {
 				ASSERT(false);
 			}
+			when(GetHotKeysRequest req = waitNext(ssi.getHotKeys.getFuture())) {
+				// Reads served by the cache are not tracked
+				req.reply.send(GetHotKeysReply());
+			}
 			when(SplitRangeRequest req = waitNext(ssi.getRangeSplitPoints.getFuture())) {
 				ASSERT(false);
 			}
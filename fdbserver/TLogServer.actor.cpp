@@ -18,6 +18,7 @@
  * limitations under the License.
  */
 
+#include "flow/CompressionUtils.h"
 #include "flow/Hash3.h"
 #include "flow/UnitTest.h"
 #include "fdbclient/NativeAPI.actor.h"
@@ -269,6 +270,36 @@ static Version decodeTagMessagesKey(StringRef key) {
 	return bigEndian64(BinaryReader::fromStringRef<Version>(stripTagMessagesKey(key), Unversioned()));
 }
 
+// A spilled by value message batch is the length prefixed messages of one version.  A compressed batch instead starts
+// with this marker, which can not be the length of a message, followed by the CompressionFilter and compressed batch.
+static const uint32_t compressedTagMessagesMarker = std::numeric_limits<uint32_t>::max();
+static const int compressedTagMessagesHeaderSize = sizeof(uint32_t) + sizeof(uint8_t);
+
+static Value encodeTagMessagesValue(Standalone<StringRef> messages, CompressionFilter filter) {
+	if (filter == CompressionFilter::NONE) {
+		return messages;
+	}
+	Arena arena;
+	StringRef compressed = CompressionUtils::compress(filter, messages, arena);
+	if (compressed.size() + compressedTagMessagesHeaderSize >= messages.size()) {
+		return messages;
+	}
+	BinaryWriter wr(Unversioned());
+	wr << compressedTagMessagesMarker << uint8_t(filter);
+	wr.serializeBytes(compressed);
+	return wr.toValue();
+}
+
+static StringRef decodeTagMessagesValue(StringRef value, Arena& arena) {
+	if (value.size() < compressedTagMessagesHeaderSize ||
+	    BinaryReader::fromStringRef<uint32_t>(value.substr(0, sizeof(uint32_t)), Unversioned()) !=
+	        compressedTagMessagesMarker) {
+		return value;
+	}
+	CompressionFilter filter = (CompressionFilter)value[sizeof(uint32_t)];
+	return CompressionUtils::decompress(filter, value.substr(compressedTagMessagesHeaderSize), arena);
+}
+
 struct SpilledData {
 	SpilledData() = default;
 	SpilledData(Version version, IDiskQueue::location start, uint32_t length, uint32_t mutationBytes)
@@ -545,8 +576,13 @@ struct LogData : NonCopyable, public ReferenceCounted<LogData> {
 	Counter blockingPeekTimeouts;
 	Counter emptyPeeks;
 	Counter nonEmptyPeeks;
+	Counter popsCoalesced;
+	LatencySample fsyncBreakdown; // Disk queue commits, for the latency breakdown in status
 	std::map<Tag, LatencySample> blockingPeekLatencies;
 	std::map<Tag, LatencySample> peekVersionCounts;
+	std::map<Tag, LatencySample> popLags; // versions between the newest version and each tag's popped version
+
+	std::set<Tag> popsToErase; // tags whose popped messages are still waiting in memory for erasePoppedMessages
 
 	UID logId;
 	ProtocolVersion protocolVersion;
@@ -634,7 +670,12 @@ struct LogData : NonCopyable, public ReferenceCounted<LogData> {
 	    unpoppedRecoveredTagCount(0), cc("TLog", interf.id().toString()), bytesInput("BytesInput", cc),
 	    bytesDurable("BytesDurable", cc), blockingPeeks("BlockingPeeks", cc),
 	    blockingPeekTimeouts("BlockingPeekTimeouts", cc), emptyPeeks("EmptyPeeks", cc),
-	    nonEmptyPeeks("NonEmptyPeeks", cc), logId(interf.id()), protocolVersion(protocolVersion),
+	    nonEmptyPeeks("NonEmptyPeeks", cc), popsCoalesced("PopsCoalesced", cc),
+	    fsyncBreakdown("LatencyBreakdownFsync",
+	                   interf.id(),
+	                   SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
+	                   SERVER_KNOBS->LATENCY_SKETCH_ACCURACY),
+	    logId(interf.id()), protocolVersion(protocolVersion),
 	    newPersistentDataVersion(invalidVersion), tLogData(tLogData), unrecoveredBefore(1), recoveredAt(1),
 	    recoveryTxnVersion(1), logSystem(new AsyncVar<Reference<ILogSystem>>()), remoteTag(remoteTag),
 	    isPrimary(isPrimary), logRouterTags(logRouterTags), logRouterPoppedVersion(0), logRouterPopToVersion(0),
@@ -1019,8 +1060,11 @@ ACTOR Future<Void> updatePersistentData(TLogData* self, Reference<LogData> logDa
 						for (; msg != tagData->versionMessages.end() && msg->first == currentVersion; ++msg) {
 							wr << msg->second.toStringRef();
 						}
-						self->persistentData->set(KeyValueRef(
-						    persistTagMessagesKey(logData->logId, tagData->tag, currentVersion), wr.toValue()));
+						self->persistentData->set(
+						    KeyValueRef(persistTagMessagesKey(logData->logId, tagData->tag, currentVersion),
+						                encodeTagMessagesValue(
+						                    wr.toValue(),
+						                    CompressionUtils::fromFilterString(SERVER_KNOBS->TLOG_SPILL_COMPRESSION_FILTER))));
 					} else {
 						// spill everything else by reference
 						const IDiskQueue::location begin = logData->versionLocation[currentVersion].first;
@@ -1169,6 +1213,31 @@ ACTOR Future<Void> updatePersistentData(TLogData* self, Reference<LogData> logDa
 	return Void();
 }
 
+bool shouldCoalescePops(TLogData* self) {
+	return SERVER_KNOBS->TLOG_POP_COALESCE_DELAY > 0 &&
+	       self->bytesInput - self->bytesDurable <
+	           SERVER_KNOBS->TLOG_SPILL_THRESHOLD * SERVER_KNOBS->TLOG_POP_COALESCE_PRESSURE_FRACTION;
+}
+
+// Erases the in-memory messages of every tag in popsToErase up to its current popped version. Pops that arrive while
+// this is pending only move the tag's popped version forward, so each tag is erased once per TLOG_POP_COALESCE_DELAY.
+ACTOR Future<Void> erasePoppedMessages(TLogData* self, Reference<LogData> logData) {
+	state std::vector<Tag> tags;
+	state int i;
+
+	wait(delay(SERVER_KNOBS->TLOG_POP_COALESCE_DELAY, TaskPriority::TLogPop));
+
+	tags.assign(logData->popsToErase.begin(), logData->popsToErase.end());
+	logData->popsToErase.clear();
+	for (i = 0; i < tags.size(); i++) {
+		auto tagData = logData->getTagData(tags[i]);
+		if (tagData && tagData->popped > logData->persistentDataDurableVersion) {
+			wait(tagData->eraseMessagesBefore(tagData->popped, self, logData, TaskPriority::TLogPop));
+		}
+	}
+	return Void();
+}
+
 ACTOR Future<Void> tLogPopCore(TLogData* self, Tag inputTag, Version to, Reference<LogData> logData) {
 	state Version upTo = to;
 	int8_t tagLocality = inputTag.locality;
@@ -1237,8 +1306,27 @@ ACTOR Future<Void> tLogPopCore(TLogData* self, Tag inputTag, Version to, Referen
 			    .detail("UnpoppedRecovered", tagData->unpoppedRecovered ? "True" : "False")
 			    .detail("NothingPersistent", tagData->nothingPersistent ? "True" : "False");
 		}
-		if (upTo > logData->persistentDataDurableVersion)
-			wait(tagData->eraseMessagesBefore(upTo, self, logData, TaskPriority::TLogPop));
+		if (logData->popLags.find(tag) == logData->popLags.end()) {
+			UID ssID = nondeterministicRandom()->randomUniqueID();
+			std::string s = "PopLag-" + tag.toString();
+			logData->popLags.try_emplace(
+			    tag, s, ssID, SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL, SERVER_KNOBS->LATENCY_SKETCH_ACCURACY);
+		}
+		logData->popLags.at(tag).addMeasurement(std::max<Version>(0, logData->version.get() - upTo));
+
+		if (upTo > logData->persistentDataDurableVersion) {
+			if (shouldCoalescePops(self)) {
+				// Far from the spill threshold, so let pops from this tag accumulate and erase them in one pass.
+				if (logData->popsToErase.empty()) {
+					logData->addActor.send(erasePoppedMessages(self, logData));
+				}
+				if (!logData->popsToErase.insert(tag).second) {
+					++logData->popsCoalesced;
+				}
+			} else {
+				wait(tagData->eraseMessagesBefore(upTo, self, logData, TaskPriority::TLogPop));
+			}
+		}
 		//TraceEvent("TLogPop", logData->logId).detail("Tag", tag.toString()).detail("To", upTo);
 	}
 	return Void();
@@ -1566,14 +1654,19 @@ void commitMessages(TLogData* self,
 	//TraceEvent("TLogPushed", self->dbgid).detail("Bytes", addedBytes).detail("MessageBytes", messages.size()).detail("Tags", tags.size()).detail("ExpectedBytes", expectedBytes).detail("MCount", mCount).detail("TCount", tCount);
 }
 
-void commitMessages(TLogData* self, Reference<LogData> logData, Version version, Arena arena, StringRef messages) {
+// Parses a commit blob into taggedMessages, which reference the blob's memory in arena
+void parseTagsAndMessages(Arena arena, StringRef messages, std::vector<TagsAndMessage>& taggedMessages) {
 	ArenaReader rd(arena, messages, Unversioned());
-	self->tempTagMessages.clear();
+	taggedMessages.clear();
 	while (!rd.empty()) {
 		TagsAndMessage tagsAndMsg;
 		tagsAndMsg.loadFromArena(&rd, nullptr);
-		self->tempTagMessages.push_back(std::move(tagsAndMsg));
+		taggedMessages.push_back(std::move(tagsAndMsg));
 	}
+}
+
+void commitMessages(TLogData* self, Reference<LogData> logData, Version version, Arena arena, StringRef messages) {
+	parseTagsAndMessages(arena, messages, self->tempTagMessages);
 	commitMessages(self, logData, version, self->tempTagMessages);
 }
 
@@ -1632,6 +1725,22 @@ void peekMessagesFromMemory(Reference<LogData> self,
 	                           std::make_pair(begin, LengthPrefixedStringRef()),
 	                           [](const auto& l, const auto& r) -> bool { return l.first < r.first; });
 
+	// Size the reply before serializing it, using the same stopping rule as below, so that each message is copied
+	// into the reply once rather than again every time the writer outgrows its buffer.
+	int replyBytes = 0;
+	Version sizedVersion = -1;
+	for (auto sizeIt = it; sizeIt != deque.end(); ++sizeIt) {
+		if (sizeIt->first != sizedVersion) {
+			if (replyBytes >= SERVER_KNOBS->DESIRED_TOTAL_BYTES) {
+				break;
+			}
+			sizedVersion = sizeIt->first;
+			replyBytes += sizeof(VERSION_HEADER) + sizeof(Version);
+		}
+		replyBytes += sizeof(uint32_t) + sizeIt->second.expectedSize();
+	}
+	messages.reserve(replyBytes);
+
 	Version currentVersion = -1;
 	for (; it != deque.end(); ++it) {
 		if (it->first != currentVersion) {
@@ -1930,7 +2039,7 @@ Future<Void> tLogPeekMessages(PromiseType replyPromise,
 				for (auto& kv : kvs) {
 					auto ver = decodeTagMessagesKey(kv.key);
 					messages << VERSION_HEADER << ver;
-					messages.serializeBytes(kv.value);
+					messages.serializeBytes(decodeTagMessagesValue(kv.value, kvs.arena()));
 				}
 
 				if (kvs.expectedSize() >= SERVER_KNOBS->DESIRED_TOTAL_BYTES) {
@@ -2177,12 +2286,14 @@ ACTOR Future<Void> doQueueCommit(TLogData* self,
 	logData->queueCommittingVersion = ver;
 
 	g_network->setCurrentTask(TaskPriority::TLogCommitReply);
+	state double fsyncStart = now();
 	Future<Void> c = self->persistentQueue->commit();
 	self->diskQueueCommitBytes = 0;
 	self->largeDiskQueueCommitBytes.set(false);
 
 	wait(ioDegradedOrTimeoutError(
 	    c, SERVER_KNOBS->MAX_STORAGE_COMMIT_TIME, self->degraded, SERVER_KNOBS->TLOG_DEGRADED_DURATION, "TLogCommit"));
+	logData->fsyncBreakdown.addMeasurement(now() - fsyncStart);
 	if (g_network->isSimulated() && !g_simulator->speedUpSimulation && BUGGIFY_WITH_PROB(0.0001)) {
 		wait(delay(6.0));
 	}
@@ -2305,6 +2416,13 @@ ACTOR Future<Void> tLogCommit(TLogData* self,
 
 	logData->minKnownCommittedVersion = std::max(logData->minKnownCommittedVersion, req.minKnownCommittedVersion);
 
+	// A commit which arrives before its prior version is parsed now, while it would otherwise sit idle, so that only
+	// indexing its messages by tag is left for the section that must run in version order.
+	state std::vector<TagsAndMessage> taggedMessages;
+	if (logData->version.get() < req.prevVersion) {
+		parseTagsAndMessages(req.arena, req.messages, taggedMessages);
+	}
+
 	wait(logData->version.whenAtLeast(req.prevVersion));
 
 	// Calling check_yield instead of yield to avoid a destruction ordering problem in simulation
@@ -2338,7 +2456,11 @@ ACTOR Future<Void> tLogCommit(TLogData* self,
 			g_traceBatch.addEvent("CommitDebug", tlogDebugID.get().first(), "TLog.tLogCommit.Before");
 
 		//TraceEvent("TLogCommit", logData->logId).detail("Version", req.version);
-		commitMessages(self, logData, req.version, req.arena, req.messages);
+		if (taggedMessages.empty()) {
+			commitMessages(self, logData, req.version, req.arena, req.messages);
+		} else {
+			commitMessages(self, logData, req.version, taggedMessages);
+		}
 
 		logData->knownCommittedVersion = std::max(logData->knownCommittedVersion, req.knownCommittedVersion);
 
@@ -3774,3 +3896,25 @@ TEST_CASE("Lfdbserver/tlogserver/VersionMessagesOverheadFactor") {
 
 	return Void();
 }
+
+TEST_CASE("/fdbserver/tlogserver/SpilledMessagesCompression") {
+	BinaryWriter wr(Unversioned());
+	for (int i = 0; i < 100; ++i) {
+		wr << StringRef(std::string(deterministicRandom()->randomInt(10, 100), 'a' + i % 3));
+	}
+	Standalone<StringRef> messages = wr.toValue();
+	Arena arena;
+
+	// Uncompressed values are stored and read back as is
+	Value plain = encodeTagMessagesValue(messages, CompressionFilter::NONE);
+	ASSERT(plain == messages);
+	ASSERT(decodeTagMessagesValue(plain, arena) == messages);
+
+#ifdef ZSTD_LIB_SUPPORTED
+	Value compressed = encodeTagMessagesValue(messages, CompressionFilter::ZSTD);
+	ASSERT(compressed.size() < messages.size());
+	ASSERT(decodeTagMessagesValue(compressed, arena) == messages);
+#endif
+
+	return Void();
+}
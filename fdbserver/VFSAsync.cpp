@@ -25,6 +25,7 @@
 #include "fdbrpc/fdbrpc.h"
 #include "flow/IAsyncFile.h"
 #include "fdbserver/CoroFlow.h"
+#include "fdbserver/Knobs.h"
 #include "fdbrpc/simulator.h"
 #include "fdbrpc/SimulatorProcessInfo.h"
 #include "fdbrpc/AsyncFileReadAhead.actor.h"
@@ -63,7 +64,7 @@ const uint32_t RESERVED_COUNT = 1U << 29;
 
 VFSAsyncFile::VFSAsyncFile(std::string const& filename, int flags)
   : flags(flags), filename(filename), pLockCount(&filename_lockCount_openCount[filename].first), debug_zcrefs(0),
-    debug_zcreads(0), debug_reads(0), chunkSize(0) {
+    debug_zcreads(0), debug_reads(0), chunkSize(0), nextReadOffset(-1), sequentialReads(0), readAheadEnd(0) {
 	filename_lockCount_openCount[filename].second++;
 
 	TraceEvent(SevDebug, "VFSAsyncFileConstruct")
@@ -75,6 +76,31 @@ VFSAsyncFile::VFSAsyncFile(std::string const& filename, int flags)
 
 std::map<std::string, std::pair<uint32_t, int>> VFSAsyncFile::filename_lockCount_openCount;
 
+void VFSAsyncFile::readAhead(int64_t offset, int length) {
+	if (!(flags & SQLITE_OPEN_MAIN_DB) || SERVER_KNOBS->SQLITE_READ_AHEAD_PAGES <= 0 || offset % length) {
+		return;
+	}
+	sequentialReads = offset == nextReadOffset ? sequentialReads + 1 : 0;
+	nextReadOffset = offset + length;
+	if (sequentialReads < SERVER_KNOBS->SQLITE_READ_AHEAD_MIN_SEQUENTIAL_READS) {
+		return;
+	}
+
+	// A zero copy read of a cached file starts loading the page, and releasing it right away leaves the load running
+	// in the page cache. Files which don't cache pages fail the read immediately, which is ignored.
+	int64_t end = nextReadOffset + (int64_t)length * SERVER_KNOBS->SQLITE_READ_AHEAD_PAGES;
+	for (int64_t pageOffset = std::max(nextReadOffset, readAheadEnd); pageOffset < end; pageOffset += length) {
+		void* data = nullptr;
+		int readBytes = length;
+		Future<Void> f = file->readZeroCopy(&data, &readBytes, pageOffset);
+		if (f.isReady() && f.isError()) {
+			break;
+		}
+		file->releaseZeroCopy(data, readBytes, pageOffset);
+	}
+	readAheadEnd = std::max(readAheadEnd, end);
+}
+
 static int asyncClose(sqlite3_file* pFile) {
 	VFSAsyncFile* p = (VFSAsyncFile*)pFile;
 
@@ -92,6 +118,7 @@ static int asyncRead(sqlite3_file* pFile, void* zBuf, int iAmt, sqlite_int64 iOf
 	VFSAsyncFile* p = (VFSAsyncFile*)pFile;
 	try {
 		++p->debug_reads;
+		p->readAhead(iOfst, iAmt);
 		int readBytes = waitForAndGet(p->file->read(zBuf, iAmt, iOfst));
 		if (readBytes < iAmt) {
 			memset((uint8_t*)zBuf + readBytes, 0, iAmt - readBytes); // When reading past the EOF, sqlite expects the
@@ -126,6 +153,7 @@ static int asyncReadZeroCopy(sqlite3_file* pFile, void** data, int iAmt, sqlite_
 	VFSAsyncFile* p = (VFSAsyncFile*)pFile;
 	try {
 		int readBytes = iAmt;
+		p->readAhead(iOfst, iAmt);
 		Future<Void> readFuture = p->file->readZeroCopy(data, &readBytes, iOfst);
 		if (pDataWasCached)
 			*pDataWasCached = readFuture.isReady() ? 1 : 0;
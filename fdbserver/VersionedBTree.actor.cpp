@@ -30,6 +30,7 @@
 #include "fdbserver/VersionedBTreeDebug.h"
 #include "fdbserver/WorkerInterface.actor.h"
 #include "flow/ActorCollection.h"
+#include "flow/CompressionUtils.h"
 #include "flow/Error.h"
 #include "flow/FastRef.h"
 #include "flow/flow.h"
@@ -1098,7 +1099,10 @@ public:
 
 	Future<Void> peekAllExt(PromiseStream<Standalone<VectorRef<T>>> resStream) { return peekAll_ext(this, resStream); }
 
-	ACTOR static Future<Standalone<VectorRef<T>>> peekAll_impl(FIFOQueue* self) {
+	// If onEntry is set it is called with each entry as soon as it is read, so callers can start acting on the front
+	// of the queue while its later pages are still being read.
+	ACTOR static Future<Standalone<VectorRef<T>>> peekAll_impl(FIFOQueue* self,
+	                                                          std::function<void(const T&)> onEntry) {
 		state Standalone<VectorRef<T>> results;
 		state Cursor c;
 		c.initReadOnly(self->headReader);
@@ -1111,6 +1115,9 @@ public:
 				break;
 			}
 			results.push_back(results.arena(), x.get());
+			if (onEntry) {
+				onEntry(x.get());
+			}
 
 			// yield periodically to avoid overflowing the stack
 			if (++sinceYield >= 100) {
@@ -1122,7 +1129,9 @@ public:
 		return results;
 	}
 
-	Future<Standalone<VectorRef<T>>> peekAll() { return peekAll_impl(this); }
+	Future<Standalone<VectorRef<T>>> peekAll(std::function<void(const T&)> onEntry = {}) {
+		return peekAll_impl(this, onEntry);
+	}
 
 	ACTOR static Future<Optional<T>> peek_impl(FIFOQueue* self) {
 		state Cursor c;
@@ -1451,12 +1460,18 @@ struct RedwoodMetrics {
 		unsigned int pagerRemapSkip;
 		unsigned int pagerCacheHit;
 		unsigned int pagerCacheMiss;
+		unsigned int pagerCacheScanHit;
+		unsigned int pagerCacheScanMiss;
+		unsigned int pagerCachePromote;
 		unsigned int pagerProbeHit;
 		unsigned int pagerProbeMiss;
 		unsigned int pagerEvictUnhit;
 		unsigned int pagerEvictFail;
 		unsigned int btreeLeafPreload;
 		unsigned int btreeLeafPreloadExt;
+		unsigned int btreePageCompress;
+		unsigned int btreePageCompressSkip;
+		unsigned int btreePageDecompress;
 	};
 
 	RedwoodMetrics() {
@@ -1637,6 +1652,8 @@ class ObjectCache : NonCopyable {
 		int hits;
 		int size;
 		bool ownedByEvictor;
+		// Whether the entry is in the Evictor's probation order, which holds entries not yet hit since they were added
+		bool probation = false;
 		CacheT* pCache;
 	};
 
@@ -1647,6 +1664,10 @@ public:
 	// Not all objects tracked by the Evictor are in its evictionOrder, as ObjectCaches
 	// using this Evictor can temporarily remove entries to an external order but they
 	// must eventually give them back with moveIn() or remove them with reclaim().
+	//
+	// If probationFraction is set, eviction is scan resistant in the manner of 2Q.  New entries start in a
+	// probation order and only move to the protected evictionOrder when they are hit again, so entries that a scan
+	// reads once are evicted first while the probation order holds more than probationFraction of sizeLimit.
 	class Evictor : NonCopyable {
 	public:
 		Evictor(int64_t sizeLimit = 0) : sizeLimit(sizeLimit) {}
@@ -1667,15 +1688,21 @@ public:
 		// but the entry size is still counted against the evictor
 		void moveOut(Entry& e, EvictionOrderT& dest) {
 			ASSERT(e.ownedByEvictor);
-			dest.splice(dest.end(), evictionOrder, EvictionOrderT::s_iterator_to(e));
+			dest.splice(dest.end(), orderOf(e), EvictionOrderT::s_iterator_to(e));
+			leaveProbation(e);
 			e.ownedByEvictor = false;
 			++movedOutCount;
 		}
 
-		// Move an entry to the back of the eviction order if it is in the eviction order
+		// Move an entry to the back of the eviction order if it is in the eviction order, promoting it out of
+		// probation
 		void moveToBack(Entry& e) {
 			ASSERT(e.ownedByEvictor);
-			evictionOrder.splice(evictionOrder.end(), evictionOrder, EvictionOrderT::s_iterator_to(e));
+			if (e.probation) {
+				++g_redwoodMetrics.metric.pagerCachePromote;
+			}
+			evictionOrder.splice(evictionOrder.end(), orderOf(e), EvictionOrderT::s_iterator_to(e));
+			leaveProbation(e);
 		}
 
 		// Move entire contents of an external eviction order containing entries whose size is part of
@@ -1689,10 +1716,16 @@ public:
 			evictionOrder.splice(evictionOrder.begin(), otherOrder);
 		}
 
-		// Add a new item to the back of the eviction order
+		// Add a new item to the back of the probation order, or of the eviction order if there is no probation
 		void addNew(Entry& e) {
 			sizeUsed += e.size;
-			evictionOrder.push_back(e);
+			if (probationFraction > 0) {
+				probationOrder.push_back(e);
+				probationSize += e.size;
+				e.probation = true;
+			} else {
+				evictionOrder.push_back(e);
+			}
 			e.ownedByEvictor = true;
 		}
 
@@ -1702,7 +1735,8 @@ public:
 			sizeUsed -= e.size;
 			// If e is in evictionOrder then remove it
 			if (e.ownedByEvictor) {
-				evictionOrder.erase(EvictionOrderT::s_iterator_to(e));
+				orderOf(e).erase(EvictionOrderT::s_iterator_to(e));
+				leaveProbation(e);
 				e.ownedByEvictor = false;
 			} else {
 				// Otherwise, it wasn't so it had to be a movedOut item so decrement the count
@@ -1714,12 +1748,17 @@ public:
 			int attemptsLeft = FLOW_KNOBS->MAX_EVICT_ATTEMPTS;
 			// While the cache is too big, evict the oldest entry until the oldest entry can't be evicted.
 			while (attemptsLeft-- > 0 && sizeUsed > (sizeLimit - reservedSize - additionalSpaceNeeded) &&
-			       !evictionOrder.empty()) {
-				Entry& toEvict = evictionOrder.front();
+			       !(evictionOrder.empty() && probationOrder.empty())) {
+				// Entries on probation go first while there are too many of them, or nothing else is left
+				EvictionOrderT& order =
+				    !probationOrder.empty() && (evictionOrder.empty() || probationSize > sizeLimit * probationFraction)
+				        ? probationOrder
+				        : evictionOrder;
+				Entry& toEvict = order.front();
 
 				debug_printf("Evictor count=%d sizeUsed=%" PRId64 " sizeLimit=%" PRId64 " sizePenalty=%" PRId64
 				             " needed=%d  Trying to evict %s evictable %d\n",
-				             (int)evictionOrder.size(),
+				             (int)(evictionOrder.size() + probationOrder.size()),
 				             sizeUsed,
 				             sizeLimit,
 				             reservedSize,
@@ -1729,7 +1768,7 @@ public:
 
 				if (!toEvict.item.evictable()) {
 					// shift the front to the back
-					evictionOrder.shift_forward(1);
+					order.shift_forward(1);
 					++g_redwoodMetrics.metric.pagerEvictFail;
 					break;
 				} else {
@@ -1738,13 +1777,15 @@ public:
 					}
 					sizeUsed -= toEvict.size;
 					debug_printf("Evicting %s\n", ::toString(toEvict.index).c_str());
-					evictionOrder.pop_front();
+					leaveProbation(toEvict);
+					order.pop_front();
 					toEvict.pCache->erase(toEvict.index);
 				}
 			}
 		}
 
-		int64_t getCountUsed() const { return evictionOrder.size() + movedOutCount; }
+		int64_t getCountUsed() const { return evictionOrder.size() + probationOrder.size() + movedOutCount; }
+		int64_t getProbationSize() const { return probationSize; }
 		int64_t getCountMoved() const { return movedOutCount; }
 		int64_t getSizeUsed() const { return sizeUsed + reservedSize; }
 
@@ -1759,11 +1800,14 @@ public:
 			                       getCountUsed(),
 			                       reservedSize,
 			                       movedOutCount);
-			for (auto& entry : evictionOrder) {
-				s += format("\n\tindex %s  size %d  evictable %d\n",
-				            ::toString(entry.index).c_str(),
-				            entry.size,
-				            entry.item.evictable());
+			for (auto* order : { &probationOrder, &evictionOrder }) {
+				for (auto& entry : *order) {
+					s += format("\n\tindex %s  size %d  evictable %d  probation %d\n",
+					            ::toString(entry.index).c_str(),
+					            entry.size,
+					            entry.item.evictable(),
+					            entry.probation);
+				}
 			}
 			s += "}\n";
 			return s;
@@ -1773,9 +1817,24 @@ public:
 		// budget should add their usage to this total and keep it updated.
 		int64_t reservedSize = 0;
 		int64_t sizeLimit;
+		// Fraction of sizeLimit that entries on probation may use before they are evicted ahead of others, or 0 to
+		// add new entries straight to the eviction order
+		double probationFraction = 0;
 
 	private:
+		EvictionOrderT& orderOf(Entry& e) { return e.probation ? probationOrder : evictionOrder; }
+
+		void leaveProbation(Entry& e) {
+			if (e.probation) {
+				probationSize -= e.size;
+				e.probation = false;
+			}
+		}
+
 		EvictionOrderT evictionOrder;
+		EvictionOrderT probationOrder;
+		// Size of all entries in the probation order
+		int64_t probationSize = 0;
 		// Size of all entries in the eviction order or held in external eviction orders
 		int64_t sizeUsed = 0;
 		// Number of items that have been moveOut()'d to other evictionOrders and aren't back yet
@@ -2023,8 +2082,9 @@ public:
 	    filename(filename), memoryOnly(memoryOnly), errorPromise(errorPromise),
 	    remapCleanupWindowBytes(remapCleanupWindowBytes), concurrentExtentReads(new FlowLock(concurrentExtentReads)) {
 
-		// This sets the page cache size for all PageCacheT instances using the same evictor
+		// This sets the page cache size and policy for all PageCacheT instances using the same evictor
 		pageCache.evictor().sizeLimit = pageCacheBytes;
+		pageCache.evictor().probationFraction = SERVER_KNOBS->REDWOOD_PAGE_CACHE_PROBATION_FRACTION;
 
 		g_redwoodMetrics.ioLock = ioLock.getPtr();
 		if (!g_redwoodMetricsActor.isValid()) {
@@ -2196,19 +2256,26 @@ public:
 			debug_printf("DWALPager(%s) Queue recovery complete.\n", self->filename.c_str());
 
 			// remapQueue entries are recovered using a fast path reading extents at a time
-			// we first issue disk reads for remapQueue extents obtained from extentUsedList
-			Standalone<VectorRef<ExtentUsedListEntry>> extents = wait(self->extentUsedList.peekAll());
+			// we first issue disk reads for remapQueue extents obtained from extentUsedList.
+			// The first and last remap extents are read by the queue cursor itself, so each extent read is issued as
+			// soon as the next extentUsedList entry shows it is not the last one, rather than after the whole
+			// extentUsedList has been read.
+			state double remapReplayStart = now();
+			Standalone<VectorRef<ExtentUsedListEntry>> extents = wait(self->extentUsedList.peekAll(
+			    [self, remapQueueID = self->remapQueue.queueID, seen = 0, prev = ExtentUsedListEntry()](
+			        const ExtentUsedListEntry& e) mutable {
+				    if (seen >= 2 && prev.queueID == remapQueueID) {
+					    debug_printf("DWALPager Extents: ID: %s ", toString(prev.extentID).c_str());
+					    self->readExtent(prev.extentID);
+				    }
+				    prev = e;
+				    ++seen;
+			    }));
 			debug_printf("DWALPager(%s) ExtentUsedList size: %d.\n", self->filename.c_str(), extents.size());
-			if (extents.size() > 1) {
-				QueueID remapQueueID = self->remapQueue.queueID;
-				for (int i = 1; i < extents.size() - 1; i++) {
-					if (extents[i].queueID == remapQueueID) {
-						LogicalPageID extID = extents[i].extentID;
-						debug_printf("DWALPager Extents: ID: %s ", toString(extID).c_str());
-						self->readExtent(extID);
-					}
-				}
-			}
+
+			// Every remap entry is for a distinct page at worst, so size the map up front instead of rehashing
+			// repeatedly while it is populated.
+			self->remappedPages.reserve(self->remapQueue.numEntries);
 
 			// And here we consume results of the disk reads and populate the remappedPages map
 			// Using a promiseStream for the peeked results ensures that we use the CPU to populate the map
@@ -2237,6 +2304,7 @@ public:
 				}
 			}
 
+			self->remapReplaySeconds = now() - remapReplayStart;
 			debug_printf("DWALPager(%s) recovery complete. RemappedPagesMap: %s\n",
 			             self->filename.c_str(),
 			             toString(self->remappedPages).c_str());
@@ -2333,6 +2401,8 @@ public:
 
 		TraceEvent e(SevInfo, "RedwoodRecoveredPager");
 		e.detail("OpenedExisting", exists);
+		e.detail("RemapReplaySeconds", self->remapReplaySeconds);
+		e.detail("RemappedPages", self->remappedPages.size());
 		self->toTraceEvent(e);
 		e.log();
 
@@ -2977,9 +3047,15 @@ public:
 			cacheEntry.writeFuture = Void();
 
 			++g_redwoodMetrics.metric.pagerCacheMiss;
+			if (noHit) {
+				++g_redwoodMetrics.metric.pagerCacheScanMiss;
+			}
 			eventReasons.addEventReason(PagerEvents::CacheMiss, reason);
 		} else {
 			++g_redwoodMetrics.metric.pagerCacheHit;
+			if (noHit) {
+				++g_redwoodMetrics.metric.pagerCacheScanHit;
+			}
 			eventReasons.addEventReason(PagerEvents::CacheHit, reason);
 		}
 		return cacheEntry.readFuture;
@@ -3027,9 +3103,15 @@ public:
 			cacheEntry.writeFuture = Void();
 
 			++g_redwoodMetrics.metric.pagerCacheMiss;
+			if (noHit) {
+				++g_redwoodMetrics.metric.pagerCacheScanMiss;
+			}
 			eventReasons.addEventReason(PagerEvents::CacheMiss, reason);
 		} else {
 			++g_redwoodMetrics.metric.pagerCacheHit;
+			if (noHit) {
+				++g_redwoodMetrics.metric.pagerCacheScanHit;
+			}
 			eventReasons.addEventReason(PagerEvents::CacheHit, reason);
 		}
 		return cacheEntry.readFuture;
@@ -3914,6 +3996,7 @@ private:
 
 	// TODO: Better data structure
 	PageToVersionedMapT remappedPages;
+	double remapReplaySeconds = 0;
 
 	// Readable snapshots in version order
 	std::deque<SnapshotEntry> snapshots;
@@ -4145,6 +4228,16 @@ struct RedwoodRecordRef {
 		return skipLen + commonPrefixLength(key, other.key, skipLen);
 	}
 
+	// Returns the 8 key bytes after skipLen as a big endian integer, padded with zeroes
+	uint64_t getSearchPrefix(int skipLen) const {
+		uint64_t prefix = 0;
+		int end = std::min(key.size(), skipLen + 8);
+		for (int i = skipLen; i < skipLen + 8; ++i) {
+			prefix = (prefix << 8) | (i < end ? key[i] : 0);
+		}
+		return prefix;
+	}
+
 	// Compares and orders by key, version, chunk.total, chunk.start, value
 	// This is the same order that delta compression uses for prefix borrowing
 	int compare(const RedwoodRecordRef& rhs, int skip = 0) const {
@@ -4640,6 +4733,25 @@ struct BTreePage {
 	}
 };
 
+// Payload of a BTree node written with the compressed page format.  The node is built as a BTreePage in a buffer of
+// logicalBlocks blocks and the BTreePage bytes are then compressed into a page of fewer blocks.
+struct CompressedBTreePage {
+	// ArenaPage pageFormat value for BTree nodes holding a CompressedBTreePage rather than a BTreePage
+	static constexpr uint8_t PageFormat = 1;
+
+#pragma pack(push, 1)
+	struct {
+		uint8_t filter;
+		uint8_t height;
+		uint16_t logicalBlocks;
+		uint32_t size;
+		uint32_t compressedSize;
+	};
+#pragma pack(pop)
+
+	uint8_t* data() const { return (uint8_t*)(this + 1); }
+};
+
 struct BoundaryRefAndPage {
 	Standalone<RedwoodRecordRef> lowerBound;
 	Reference<ArenaPage> firstPage;
@@ -5009,6 +5121,9 @@ public:
 	    m_enforceEncodingType(false), m_keyProvider(keyProvider), m_pBuffer(nullptr), m_mutationCount(0), m_name(name),
 	    m_logID(logID), m_pBoundaryVerifier(DecodeBoundaryVerifier::getVerifier(name)) {
 		m_pDecodeCacheMemory = m_pager->getPageCachePenaltySource();
+		m_compressionFilter = CompressionUtils::fromFilterString(SERVER_KNOBS->REDWOOD_PAGE_COMPRESSION_FILTER);
+		CompressionUtils::checkFilterSupported(m_compressionFilter);
+		m_compressionRatio = 1.0 / SERVER_KNOBS->REDWOOD_PAGE_COMPRESSION_MAX_BLOCKS;
 		m_lazyClearActor = 0;
 		m_init = init_impl(this);
 		m_latestCommit = m_init;
@@ -5038,6 +5153,8 @@ public:
 	ACTOR static Future<int> incrementalLazyClear(VersionedBTree* self) {
 		ASSERT(self->m_lazyClearActor.isReady());
 		self->m_lazyClearStop = false;
+		self->m_lazyClearStopSignal = Promise<Void>();
+		state double startTime = now();
 
 		// TODO: Is it contractually okay to always to read at the latest version?
 		state Reference<IPagerSnapshot> snapshot =
@@ -5121,6 +5238,19 @@ public:
 				metrics.lazyClearFreeExt += entry.pageID.size() - 1;
 			}
 
+			// Pace freeing so that a large cleared range is reclaimed gradually rather than in a burst of page reads
+			// and free list writes, but stop pacing as soon as a commit needs lazy clearing to stop.
+			if (toPop == 0 && !self->m_lazyClearStop && SERVER_KNOBS->REDWOOD_LAZY_CLEAR_MAX_PAGES_PER_SECOND > 0) {
+				double pause =
+				    freedPages / SERVER_KNOBS->REDWOOD_LAZY_CLEAR_MAX_PAGES_PER_SECOND - (now() - startTime);
+				if (pause > 0) {
+					choose {
+						when(wait(delay(pause))) {}
+						when(wait(self->m_lazyClearStopSignal.getFuture())) {}
+					}
+				}
+			}
+
 			// Stop if
 			//   - the poppable items in the queue have already been exhausted
 			//   - stop flag is set and we've freed the minimum number of pages required
@@ -5337,6 +5467,16 @@ public:
 		return m_latestCommit;
 	}
 
+	// Replace the contents of an empty tree with the key/value pairs from kvs and commit them at version v.
+	// Each batch must be sorted and without duplicates, and batches must arrive in key order.  The stream
+	// ends with end_of_stream.  No other mutations may be pending, and a tree that is not empty fails with
+	// operation_failed.
+	Future<Void> bulkBuild(Version v, FutureStream<Standalone<VectorRef<KeyValueRef>>> kvs) {
+		ASSERT(m_mutationCount == 0);
+		m_latestCommit = bulkBuild_impl(this, v, kvs, m_latestCommit);
+		return m_latestCommit;
+	}
+
 	// Clear all btree data, allow pager remap to fully process its queue, and verify final
 	// page counts in pager and queues.
 	ACTOR static Future<Void> clearAllAndCheckSanity_impl(VersionedBTree* self) {
@@ -5606,6 +5746,11 @@ private:
 	// Counter to update with DecodeCache memory usage
 	int64_t* m_pDecodeCacheMemory = nullptr;
 
+	// Filter used to compress new leaf pages, NONE if they are not compressed
+	CompressionFilter m_compressionFilter;
+	// Moving average of compressed to uncompressed size of recently compressed leaves
+	double m_compressionRatio;
+
 	// The mutation buffer currently being written to
 	std::unique_ptr<MutationBuffer> m_pBuffer;
 	int64_t m_mutationCount;
@@ -5632,6 +5777,7 @@ private:
 	LazyClearQueueT m_lazyClearQueue;
 	Future<int> m_lazyClearActor;
 	bool m_lazyClearStop;
+	Promise<Void> m_lazyClearStopSignal;
 
 	// Describes a range of a vector of records that should be built into a single BTreePage
 	struct PageToBuild {
@@ -5641,20 +5787,27 @@ private:
 		            unsigned int height,
 		            bool enableEncryptionDomain,
 		            bool splitByDomain,
-		            IPageEncryptionKeyProvider* keyProvider)
-		  : startIndex(index), count(0), pageSize(blockSize),
-		    largeDeltaTree(pageSize > BTreePage::BinaryTree::SmallSizeLimit), blockSize(blockSize), blockCount(1),
-		    kvBytes(0), encodingType(encodingType), height(height), enableEncryptionDomain(enableEncryptionDomain),
-		    splitByDomain(splitByDomain), keyProvider(keyProvider) {
+		            IPageEncryptionKeyProvider* keyProvider,
+		            int minBlocks = 1)
+		  : startIndex(index), count(0), pageSize(blockSize * minBlocks),
+		    largeDeltaTree(pageSize > BTreePage::BinaryTree::SmallSizeLimit), blockSize(blockSize),
+		    blockCount(minBlocks), minBlocks(minBlocks), kvBytes(0), encodingType(encodingType), height(height),
+		    enableEncryptionDomain(enableEncryptionDomain), splitByDomain(splitByDomain), keyProvider(keyProvider) {
 
 			// Subtrace Page header overhead, BTreePage overhead, and DeltaTree (BTreePage::BinaryTree) overhead.
 			bytesLeft =
-			    ArenaPage::getUsableSize(blockSize, encodingType) - sizeof(BTreePage) - sizeof(BTreePage::BinaryTree);
+			    ArenaPage::getUsableSize(pageSize, encodingType) - sizeof(BTreePage) - sizeof(BTreePage::BinaryTree);
 		}
 
 		PageToBuild next() {
-			return PageToBuild(
-			    endIndex(), blockSize, encodingType, height, enableEncryptionDomain, splitByDomain, keyProvider);
+			return PageToBuild(endIndex(),
+			                   blockSize,
+			                   encodingType,
+			                   height,
+			                   enableEncryptionDomain,
+			                   splitByDomain,
+			                   keyProvider,
+			                   minBlocks);
 		}
 
 		int startIndex; // Index of the first record
@@ -5665,6 +5818,7 @@ private:
 		bool largeDeltaTree; // Whether or not the tree in the generated page is in the 'large' size range
 		int blockSize; // Base block size by which pageSize can be incremented
 		int blockCount; // The number of blocks in pageSize
+		int minBlocks; // The number of blocks a page starts with, more than 1 if the page will be compressed
 		int kvBytes; // The amount of user key/value bytes added to the page
 
 		EncodingType encodingType;
@@ -5872,8 +6026,14 @@ private:
 			deltaSizes[i] = records[i].deltaSize(records[i - 1], prefixLen, true);
 		}
 
-		PageToBuild p(
-		    0, m_blockSize, m_encodingType, height, enableEncryptionDomain, splitByDomain, m_keyProvider.getPtr());
+		PageToBuild p(0,
+		              m_blockSize,
+		              m_encodingType,
+		              height,
+		              enableEncryptionDomain,
+		              splitByDomain,
+		              m_keyProvider.getPtr(),
+		              height == 1 ? leafBlocksToBuild() : 1);
 
 		for (int i = 0; i < records.size();) {
 			bool force = p.count < minRecords || p.slackFraction() > maxSlack;
@@ -6094,12 +6254,14 @@ private:
 			metrics.buildStoredPctSketch->samplePercentage(p->kvFraction());
 			metrics.buildItemCountSketch->sampleRecordCounter(p->count);
 
-			// Write this btree page, which is made of 1 or more pager pages.
+			// Write this btree page, which is made of 1 or more pager pages, or fewer if it compresses well.
+			page = self->maybeCompressPage(page, p->blockCount, height);
+			state int blocksToWrite = page->rawSize() / self->m_pager->getPhysicalPageSize();
 			state BTreeNodeLinkRef childPageID;
 
 			// If we are only writing 1 BTree node and its block count is 1 and the original node also had 1 block
 			// then try to update the page atomically so its logical page ID does not change
-			if (pagesToBuild.size() == 1 && p->blockCount == 1 && previousID.size() == 1) {
+			if (pagesToBuild.size() == 1 && blocksToWrite == 1 && previousID.size() == 1) {
 				page->setLogicalPageInfo(previousID.front(), parentID);
 				LogicalPageID id = wait(
 				    self->m_pager->atomicUpdatePage(PagerEventReasons::Commit, height, previousID.front(), page, v));
@@ -6133,7 +6295,7 @@ private:
 					self->freeBTreePage(height, previousID, v);
 				}
 
-				childPageID.resize(records.arena(), p->blockCount);
+				childPageID.resize(records.arena(), blocksToWrite);
 				state int i = 0;
 				for (i = 0; i < childPageID.size(); ++i) {
 					LogicalPageID id = wait(self->m_pager->newPageID());
@@ -6231,6 +6393,125 @@ private:
 		return records;
 	}
 
+	// Returns the number of blocks of records to build a new leaf from.  Without compression this is 1.  With
+	// compression it is about as many blocks as recent leaves needed to compress into 1 block, so leaves of data
+	// that does not compress well are built and written as single uncompressed blocks.
+	int leafBlocksToBuild() const {
+		if (m_compressionFilter == CompressionFilter::NONE) {
+			return 1;
+		}
+
+		int maxBlocks = SERVER_KNOBS->REDWOOD_PAGE_COMPRESSION_MAX_BLOCKS;
+		int blocks = std::clamp((int)(1.0 / m_compressionRatio), 1, maxBlocks);
+
+		// Single block leaves are never compressed, so occasionally build a larger leaf anyway to notice
+		// if the data has become more compressible.
+		if (blocks == 1 &&
+		    deterministicRandom()->random01() < SERVER_KNOBS->REDWOOD_PAGE_COMPRESSION_PROBE_PROBABILITY) {
+			blocks = maxBlocks;
+		}
+		return blocks;
+	}
+
+	// Returns a compressed copy of a newly built leaf page of the given logical block count if it would be written in
+	// sufficiently fewer blocks, otherwise returns page.  Must be called before the page's logical info is set.
+	Reference<ArenaPage> maybeCompressPage(Reference<ArenaPage> page, int blocks, unsigned int height) {
+		if (m_compressionFilter == CompressionFilter::NONE || height != 1 || blocks == 1) {
+			return page;
+		}
+
+		const BTreePage* btPage = (const BTreePage*)page->data();
+		Arena arena;
+		StringRef compressed =
+		    CompressionUtils::compress(m_compressionFilter, StringRef(page->data(), btPage->size()), arena);
+		m_compressionRatio = 0.9 * m_compressionRatio + 0.1 * ((double)compressed.size() / btPage->size());
+
+		int compressedBlocks = 1;
+		while (ArenaPage::getUsableSize(m_blockSize * compressedBlocks, m_encodingType) <
+		       (int)sizeof(CompressedBTreePage) + compressed.size()) {
+			++compressedBlocks;
+		}
+
+		if (compressedBlocks >= blocks ||
+		    compressedBlocks > blocks * (1.0 - SERVER_KNOBS->REDWOOD_PAGE_COMPRESSION_MIN_SAVINGS)) {
+			++g_redwoodMetrics.metric.btreePageCompressSkip;
+			return page;
+		}
+
+		Reference<ArenaPage> result = m_pager->newPageBuffer(compressedBlocks);
+		result->init(m_encodingType,
+		             (compressedBlocks == 1) ? PageType::BTreeNode : PageType::BTreeSuperNode,
+		             height,
+		             CompressedBTreePage::PageFormat);
+		result->encryptionKey = page->encryptionKey;
+
+		CompressedBTreePage* c = (CompressedBTreePage*)result->mutateData();
+		c->filter = (uint8_t)m_compressionFilter;
+		c->height = height;
+		c->logicalBlocks = blocks;
+		c->size = btPage->size();
+		c->compressedSize = compressed.size();
+		memcpy(c->data(), compressed.begin(), compressed.size());
+
+		++g_redwoodMetrics.metric.btreePageCompress;
+		return result;
+	}
+
+	// Uncompressed form of a compressed page, held by the compressed page while it is cached.  Its memory is charged
+	// to the page cache the same way DecodeCache memory is.
+	struct DecompressedPage : FastAllocated<DecompressedPage> {
+		DecompressedPage(Reference<ArenaPage> page, int64_t* pMemoryTracker)
+		  : page(page), pMemoryTracker(pMemoryTracker) {
+			if (pMemoryTracker != nullptr) {
+				*pMemoryTracker += page->rawSize();
+			}
+		}
+
+		~DecompressedPage() {
+			if (pMemoryTracker != nullptr) {
+				*pMemoryTracker -= page->rawSize();
+			}
+		}
+
+		Reference<ArenaPage> page;
+		int64_t* pMemoryTracker;
+	};
+
+	// Returns page if it is a BTreePage or the uncompressed BTreePage if it is a CompressedBTreePage
+	Reference<const ArenaPage> decompressPage(Reference<const ArenaPage> page) {
+		if (page->getPageFormat() != CompressedBTreePage::PageFormat) {
+			return page;
+		}
+
+		if (page->extra.valid()) {
+			return page->extra.getPtr<DecompressedPage>()->page;
+		}
+
+		const CompressedBTreePage* c = (const CompressedBTreePage*)page->data();
+		if (c->filter >= (uint8_t)CompressionFilter::LAST ||
+		    (int64_t)sizeof(CompressedBTreePage) + c->compressedSize > page->dataSize()) {
+			throw page_decoding_failed();
+		}
+
+		Reference<ArenaPage> result = m_pager->newPageBuffer(c->logicalBlocks);
+		result->init(page->getEncodingType(),
+		             (c->logicalBlocks == 1) ? PageType::BTreeNode : PageType::BTreeSuperNode,
+		             c->height);
+		result->encryptionKey = page->encryptionKey;
+
+		Arena arena;
+		StringRef uncompressed =
+		    CompressionUtils::decompress((CompressionFilter)c->filter, StringRef(c->data(), c->compressedSize), arena);
+		if (uncompressed.size() != c->size || uncompressed.size() > result->dataSize()) {
+			throw page_decoding_failed();
+		}
+		memcpy(result->mutateData(), uncompressed.begin(), uncompressed.size());
+
+		page->extra = new DecompressedPage(result, m_pDecodeCacheMemory);
+		++g_redwoodMetrics.metric.btreePageDecompress;
+		return result;
+	}
+
 	ACTOR static Future<Reference<const ArenaPage>> readPage(VersionedBTree* self,
 	                                                         PagerEventReasons reason,
 	                                                         unsigned int level,
@@ -6238,7 +6519,8 @@ private:
 	                                                         BTreeNodeLinkRef id,
 	                                                         int priority,
 	                                                         bool forLazyClear,
-	                                                         bool cacheable) {
+	                                                         bool cacheable,
+	                                                         bool noHit = false) {
 
 		debug_printf("readPage() op=read%s %s @%" PRId64 "\n",
 		             forLazyClear ? "ForDeferredClear" : "",
@@ -6248,15 +6530,16 @@ private:
 		state Reference<const ArenaPage> page;
 		if (id.size() == 1) {
 			Reference<const ArenaPage> p =
-			    wait(snapshot->getPhysicalPage(reason, level, id.front(), priority, cacheable, false));
+			    wait(snapshot->getPhysicalPage(reason, level, id.front(), priority, cacheable, noHit));
 			page = std::move(p);
 		} else {
 			ASSERT(!id.empty());
 			Reference<const ArenaPage> p =
-			    wait(snapshot->getMultiPhysicalPage(reason, level, id, priority, cacheable, false));
+			    wait(snapshot->getMultiPhysicalPage(reason, level, id, priority, cacheable, noHit));
 			page = std::move(p);
 		}
 		debug_printf("readPage() op=readComplete %s @%" PRId64 " \n", toString(id).c_str(), snapshot->getVersion());
+		page = self->decompressPage(page);
 		const BTreePage* btPage = (const BTreePage*)page->data();
 		auto& metrics = g_redwoodMetrics.level(btPage->height).metrics;
 		metrics.pageRead += 1;
@@ -6289,8 +6572,9 @@ private:
 			                            upperBound)
 			                 .c_str());
 
-			// Store decode cache into page based on height
+			// Store decode cache into page based on height.  Only a reused cache is worth a search accelerator.
 			if (((BTreePage*)page->data())->height >= SERVER_KNOBS->REDWOOD_DECODECACHE_REUSE_MIN_HEIGHT) {
+				cache->searchAcceleratorLevels = SERVER_KNOBS->REDWOOD_SEARCH_ACCELERATOR_LEVELS;
 				page->extra = cache;
 			}
 		}
@@ -6343,7 +6627,6 @@ private:
 	                                                      Reference<ArenaPage> page,
 	                                                      Version writeVersion) {
 		state BTreeNodeLinkRef newID;
-		newID.resize(*arena, oldID.size());
 
 		if (REDWOOD_DEBUG) {
 			const BTreePage* btPage = (const BTreePage*)page->mutateData();
@@ -6360,7 +6643,10 @@ private:
 		}
 
 		state unsigned int height = (unsigned int)((const BTreePage*)page->data())->height;
-		if (oldID.size() == 1) {
+		page = self->maybeCompressPage(page, page->rawSize() / self->m_pager->getPhysicalPageSize(), height);
+		newID.resize(*arena, page->rawSize() / self->m_pager->getPhysicalPageSize());
+
+		if (oldID.size() == 1 && newID.size() == 1) {
 			page->setLogicalPageInfo(oldID.front(), parentID);
 			LogicalPageID id = wait(
 			    self->m_pager->atomicUpdatePage(PagerEventReasons::Commit, height, oldID.front(), page, writeVersion));
@@ -6369,7 +6655,7 @@ private:
 		}
 
 		state int i = 0;
-		for (i = 0; i < oldID.size(); ++i) {
+		for (i = 0; i < newID.size(); ++i) {
 			LogicalPageID id = wait(self->m_pager->newPageID());
 			newID[i] = id;
 		}
@@ -7582,7 +7868,14 @@ private:
 		debug_printf("new root %s\n", toString(rootNodeLink).c_str());
 		self->m_header.root = rootNodeLink;
 
+		wait(commitHeader(self, writeVersion));
+		return Void();
+	}
+
+	// Pauses lazy clearing, persists the lazy clear queue state, and commits the pager with the current header
+	ACTOR static Future<Void> commitHeader(VersionedBTree* self, Version writeVersion) {
 		self->m_lazyClearStop = true;
+		self->m_lazyClearStopSignal.send(Void());
 		wait(success(self->m_lazyClearActor));
 		debug_printf("Lazy delete freed %u pages\n", self->m_lazyClearActor.get());
 
@@ -7599,6 +7892,108 @@ private:
 		return Void();
 	}
 
+	// Builds the tree bottom-up from kvs instead of applying mutations to the existing tree.  Each batch is
+	// written as a run of leaf pages packed by splitPages(), using the first key of the following batch as the
+	// upper bound, and the links to all leaves are then handed to buildNewRootsIfNeeded() to write the internal
+	// levels.  Nothing is read or rewritten besides the empty root, so a sorted initial load avoids the mutation
+	// buffer, repeated leaf rewrites, and page splits entirely.
+	ACTOR static Future<Void> bulkBuild_impl(VersionedBTree* self,
+	                                         Version writeVersion,
+	                                         FutureStream<Standalone<VectorRef<KeyValueRef>>> kvs,
+	                                         Future<Void> previousCommit) {
+		state double startTime = now();
+		state Standalone<VectorRef<RedwoodRecordRef>> leafLinks;
+		state Standalone<VectorRef<RedwoodRecordRef>> pending;
+		state Standalone<VectorRef<RedwoodRecordRef>> next;
+		state RedwoodRecordRef lowerBound = dbBegin;
+		state RedwoodRecordRef upperBound;
+		state Key lastKey;
+		state int64_t records = 0;
+		state int64_t kvBytes = 0;
+		state bool done = false;
+
+		wait(previousCommit);
+
+		ASSERT(writeVersion > self->m_pager->getLastCommittedVersion());
+		self->m_pager->setOldestReadableVersion(self->m_newOldestVersion);
+
+		// Only an empty tree, which is a single empty leaf root, can be bulk built
+		if (self->m_header.height != 1) {
+			throw operation_failed();
+		}
+		state Reference<IPagerSnapshot> snapshot =
+		    self->m_pager->getReadSnapshot(self->m_pager->getLastCommittedVersion());
+		Reference<const ArenaPage> rootPage = wait(readPage(
+		    self, PagerEventReasons::Commit, 1, snapshot.getPtr(), self->m_header.root, 1, false, true));
+		if (((const BTreePage*)rootPage->data())->tree()->numItems != 0) {
+			throw operation_failed();
+		}
+		snapshot.clear();
+
+		debug_printf("%s: Bulk building version %" PRId64 "\n", self->m_name.c_str(), writeVersion);
+
+		loop {
+			try {
+				Standalone<VectorRef<KeyValueRef>> batch = waitNext(kvs);
+				if (batch.empty()) {
+					continue;
+				}
+				next = Standalone<VectorRef<RedwoodRecordRef>>();
+				next.arena().dependsOn(batch.arena());
+				next.reserve(next.arena(), batch.size());
+				for (auto& kv : batch) {
+					ASSERT(records == 0 || kv.key > lastKey);
+					lastKey = kv.key;
+					next.push_back(next.arena(), RedwoodRecordRef(kv.key, kv.value));
+					kvBytes += kv.expectedSize();
+					++records;
+				}
+				lastKey = Key(lastKey, next.arena());
+				upperBound = RedwoodRecordRef(next.front().key);
+			} catch (Error& e) {
+				if (e.code() != error_code_end_of_stream) {
+					throw;
+				}
+				upperBound = dbEnd;
+				done = true;
+			}
+
+			if (!pending.empty()) {
+				Standalone<VectorRef<RedwoodRecordRef>> links = wait(writePages(
+				    self, &lowerBound, &upperBound, pending, 1, writeVersion, BTreeNodeLinkRef(), invalidLogicalPageID));
+				leafLinks.arena().dependsOn(links.arena());
+				leafLinks.append(leafLinks.arena(), links.begin(), links.size());
+			}
+
+			if (done) {
+				break;
+			}
+
+			// The lower bound of the next run of leaves lives in its own arena
+			pending = next;
+			lowerBound = upperBound;
+		}
+
+		if (!leafLinks.empty()) {
+			self->freeBTreePage(1, self->m_header.root, writeVersion);
+			Standalone<VectorRef<RedwoodRecordRef>> newRoot =
+			    wait(buildNewRootsIfNeeded(self, writeVersion, leafLinks, 1));
+			self->m_header.root = newRoot.front().getChildPage();
+		}
+
+		TraceEvent("RedwoodBulkBuild")
+		    .detail("Name", self->m_name)
+		    .detail("Version", writeVersion)
+		    .detail("Records", records)
+		    .detail("KVBytes", kvBytes)
+		    .detail("LeafPages", leafLinks.size())
+		    .detail("Height", self->m_header.height)
+		    .detail("Seconds", now() - startTime);
+
+		wait(commitHeader(self, writeVersion));
+		return Void();
+	}
+
 public:
 	// Cursor into BTree which enables seeking and iteration in the BTree as a whole, or
 	// iteration within a specific page and movement across levels for more efficient access.
@@ -7623,12 +8018,84 @@ public:
 		bool valid;
 		std::vector<PathEntry> path;
 
+		// Sequential leaf read-ahead state, see readAhead()
+		static constexpr int readAheadMinSequentialMoves = 2;
+		Reference<const ArenaPage> readAheadParent; // Height 2 page the preloaded leaves are children of
+		int readAheadIssued; // Leaves past the current one under readAheadParent which have been preloaded
+		int readAheadDepth; // Leaves to keep preloaded past the current one, 0 until read-ahead starts
+		int sequentialMoves; // Consecutive moves to a new leaf in the same direction, negative for backward
+		bool lastPushStalled; // Whether the most recent page push had to wait for a read
+
+		void resetReadAhead() {
+			readAheadParent.clear();
+			readAheadIssued = 0;
+			readAheadDepth = 0;
+			sequentialMoves = 0;
+			lastPushStalled = false;
+		}
+
+		// Called when a move lands on a different leaf.  Once the cursor has crossed a few leaves in a row in the same
+		// direction, keep the next readAheadDepth sibling leaves under the same parent preloaded so a scan has
+		// several leaf reads outstanding instead of one.  The depth doubles whenever the cursor still had to wait for
+		// a leaf read under the same parent, up to REDWOOD_SCAN_READ_AHEAD_MAX_LEAVES, so it grows until reads ahead
+		// cover the device latency at the rate the caller consumes leaves.
+		void readAhead(bool forward) {
+			int maxDepth = SERVER_KNOBS->REDWOOD_SCAN_READ_AHEAD_MAX_LEAVES;
+			if (maxDepth <= 0 || path.size() < 2) {
+				return;
+			}
+
+			if (sequentialMoves != 0 && forward != (sequentialMoves > 0)) {
+				sequentialMoves = 0;
+				readAheadDepth = 0;
+				readAheadParent.clear();
+			}
+			sequentialMoves += forward ? 1 : -1;
+
+			const PathEntry& parent = path[path.size() - 2];
+			bool sameParent = parent.page.getPtr() == readAheadParent.getPtr();
+			if (sameParent) {
+				readAheadIssued = std::max(readAheadIssued - 1, 0);
+			} else {
+				readAheadParent = parent.page;
+				readAheadIssued = 0;
+			}
+
+			if (std::abs(sequentialMoves) < readAheadMinSequentialMoves) {
+				return;
+			}
+			if (sameParent && lastPushStalled) {
+				readAheadDepth *= 2;
+			}
+			readAheadDepth = std::min(std::max(readAheadDepth, 2), maxDepth);
+
+			BTreePage::BinaryTree::Cursor c = parent.cursor;
+			int ahead = 0;
+			while (ahead < readAheadDepth && (forward ? c.moveNext() : c.movePrev())) {
+				if (!c.get().value.present()) {
+					continue;
+				}
+				if (++ahead > readAheadIssued) {
+					BTreeNodeLinkRef childPage = c.get().getChildPage();
+					if (childPage.size() > 0) {
+						preLoadPage(pager.getPtr(), childPage, ioLeafPriority);
+					}
+				}
+			}
+			readAheadIssued = ahead;
+		}
+
 	public:
-		BTreeCursor() : reason(PagerEventReasons::MAXEVENTREASONS) {}
+		BTreeCursor() : reason(PagerEventReasons::MAXEVENTREASONS) { resetReadAhead(); }
 
 		bool intialized() const { return pager.isValid(); }
 		bool isValid() const { return valid; }
 
+		// Scans read pages without counting as cache hits, so they do not promote pages out of cache probation
+		bool isScan() const {
+			return reason == PagerEventReasons::FetchRange || (options.present() && !options.get().cacheResult);
+		}
+
 		// path entries at dumpHeight or below will have their entire pages printed
 		std::string toString(int dumpHeight = 0) const {
 			std::string r = format("{ptr=%p reason=%s %s ",
@@ -7683,7 +8150,8 @@ public:
 			                    link.get().getChildPage(),
 			                    ioMaxPriority,
 			                    false,
-			                    !options.present() || options.get().cacheResult || path.back().btPage()->height != 2),
+			                    !options.present() || options.get().cacheResult || path.back().btPage()->height != 2,
+			                    isScan()),
 			           [=](Reference<const ArenaPage> p) {
 				           BTreePage::BinaryTree::Cursor cursor = btree->getCursor(p.getPtr(), link);
 #if REDWOOD_DEBUG
@@ -7710,7 +8178,15 @@ public:
 
 		Future<Void> pushPage(BTreeNodeLinkRef id) {
 			debug_printf("pushPage(root=%s)\n", ::toString(id).c_str());
-			return map(readPage(btree, reason, btree->m_header.height, pager.getPtr(), id, ioMaxPriority, false, true),
+			return map(readPage(btree,
+			                    reason,
+			                    btree->m_header.height,
+			                    pager.getPtr(),
+			                    id,
+			                    ioMaxPriority,
+			                    false,
+			                    true,
+			                    isScan()),
 			           [=](Reference<const ArenaPage> p) {
 #if REDWOOD_DEBUG
 				           path.push_back({ p, btree->getCursor(p.getPtr(), dbBegin, dbEnd), id });
@@ -7734,6 +8210,7 @@ public:
 			path.clear();
 			path.reserve(6);
 			valid = false;
+			resetReadAhead();
 			return root.empty() ? Void() : pushPage(root);
 		}
 
@@ -7749,6 +8226,7 @@ public:
 		ACTOR Future<int> seek_impl(BTreeCursor* self, RedwoodRecordRef query) {
 			state RedwoodRecordRef internalPageQuery = query.withMaxPageID();
 			self->path.resize(1);
+			self->resetReadAhead();
 			debug_printf("seek(%s) start cursor = %s\n", query.toString().c_str(), self->toString().c_str());
 
 			loop {
@@ -7818,6 +8296,7 @@ public:
 			// Note that only immediate siblings under the same parent are considered for prefetch so far.
 			BTreePage::BinaryTree::Cursor c = path[path.size() - 2].cursor;
 			ASSERT(path[path.size() - 2].btPage()->height == 2);
+			int siblingsLoaded = 0;
 
 			// The loop conditions are split apart into different if blocks for readability.
 			// While query limits are not exceeded
@@ -7843,11 +8322,16 @@ public:
 					BTreeNodeLinkRef childPage = c.get().getChildPage();
 					if (childPage.size() > 0)
 						preLoadPage(pager.getPtr(), childPage, ioLeafPriority);
+					++siblingsLoaded;
 					recordsRead += estRecordsPerPage;
 					// Use sibling node capacity as an estimate of bytes read.
 					bytesRead += childPage.size() * this->btree->m_blockSize;
 				}
 			}
+
+			// Let sequential read-ahead know these siblings are already on their way
+			readAheadParent = path[path.size() - 2].page;
+			readAheadIssued = siblingsLoaded;
 		}
 
 		ACTOR Future<Void> seekLT_impl(BTreeCursor* self, RedwoodRecordRef query) {
@@ -7862,6 +8346,7 @@ public:
 		Future<Void> seekLT(RedwoodRecordRef query) { return seekLT_impl(this, query); }
 
 		ACTOR Future<Void> move_impl(BTreeCursor* self, bool forward) {
+			state bool newLeaf = false;
 			// Try to the move cursor at the end of the path in the correct direction
 			debug_printf("move%s() start cursor=%s\n", forward ? "Next" : "Prev", self->toString().c_str());
 			while (1) {
@@ -7909,12 +8394,18 @@ public:
 					UNSTOPPABLE_ASSERT(entry.cursor.get().value.present());
 				}
 
-				wait(self->pushPage(entry.cursor));
+				Future<Void> f = self->pushPage(entry.cursor);
+				self->lastPushStalled = !f.isReady();
+				newLeaf = true;
+				wait(f);
 				auto& newEntry = self->path.back();
 				UNSTOPPABLE_ASSERT(forward ? newEntry.cursor.moveFirst() : newEntry.cursor.moveLast());
 			}
 
 			self->valid = true;
+			if (newLeaf) {
+				self->readAhead(forward);
+			}
 
 			debug_printf("move%s() exit cursor=%s\n", forward ? "Next" : "Prev", self->toString(1).c_str());
 			return Void();
@@ -8060,6 +8551,13 @@ public:
 		return m_lastCommit;
 	}
 
+	Future<Void> bulkLoad(FutureStream<Standalone<VectorRef<KeyValueRef>>> kvs) override {
+		m_lastCommit = catchError(m_tree->bulkBuild(m_nextCommitVersion, kvs));
+		m_tree->setOldestReadableVersion(m_nextCommitVersion);
+		++m_nextCommitVersion;
+		return m_lastCommit;
+	}
+
 	KeyValueStoreType getType() const override { return KeyValueStoreType::SSD_REDWOOD_V1; }
 
 	StorageBytes getStorageBytes() const override { return m_tree->getStorageBytes(); }
@@ -8711,6 +9209,10 @@ struct IntIntPair {
 		return 0;
 	}
 
+	uint64_t getSearchPrefix(int skip) const {
+		return ((uint64_t)((uint32_t)k ^ 0x80000000) << 32) | ((uint32_t)v ^ 0x80000000);
+	}
+
 	int compare(const IntIntPair& rhs, int skip = 0) const {
 		if (skip == 2) {
 			return 0;
@@ -8785,6 +9287,9 @@ RedwoodRecordRef randomRedwoodRecordRef(const std::string& keyBuffer, const std:
 void RedwoodMetrics::getFields(TraceEvent* e, std::string* s, bool skipZeroes) {
 	std::pair<const char*, unsigned int> metrics[] = { { "BTreePreload", metric.btreeLeafPreload },
 		                                               { "BTreePreloadExt", metric.btreeLeafPreloadExt },
+		                                               { "BTreePageCompress", metric.btreePageCompress },
+		                                               { "BTreePageCompressSkip", metric.btreePageCompressSkip },
+		                                               { "BTreePageDecompress", metric.btreePageDecompress },
 		                                               { "", 0 },
 		                                               { "OpSet", metric.opSet },
 		                                               { "OpSetKeyBytes", metric.opSetKeyBytes },
@@ -8800,6 +9305,9 @@ void RedwoodMetrics::getFields(TraceEvent* e, std::string* s, bool skipZeroes) {
 		                                               { "PagerDiskRead", metric.pagerDiskRead },
 		                                               { "PagerCacheHit", metric.pagerCacheHit },
 		                                               { "PagerCacheMiss", metric.pagerCacheMiss },
+		                                               { "PagerCacheScanHit", metric.pagerCacheScanHit },
+		                                               { "PagerCacheScanMiss", metric.pagerCacheScanMiss },
+		                                               { "PagerCachePromote", metric.pagerCachePromote },
 		                                               { "", 0 },
 		                                               { "PagerProbeHit", metric.pagerProbeHit },
 		                                               { "PagerProbeMiss", metric.pagerProbeMiss },
@@ -8839,6 +9347,7 @@ void RedwoodMetrics::getFields(TraceEvent* e, std::string* s, bool skipZeroes) {
 	std::pair<const char*, int64_t> cacheMetrics[] = { { "PageCacheCount", evictor->getCountUsed() },
 		                                               { "PageCacheMoved", evictor->getCountMoved() },
 		                                               { "PageCacheSize", evictor->getSizeUsed() },
+		                                               { "PageCacheProbationSize", evictor->getProbationSize() },
 		                                               { "DecodeCacheSize", evictor->reservedSize } };
 
 	if (e != nullptr) {
@@ -9294,7 +9803,9 @@ TEST_CASE("Lredwood/correctness/unit/deltaTree/RedwoodRecordRef2") {
 	       largeTree);
 	debug_printf("Data(%p): %s\n", tree, StringRef((uint8_t*)tree, tree->size()).toHexString().c_str());
 
-	DeltaTree2<RedwoodRecordRef>::Cursor c(makeReference<DeltaTree2<RedwoodRecordRef>::DecodeCache>(prev, next), tree);
+	auto cache = makeReference<DeltaTree2<RedwoodRecordRef>::DecodeCache>(prev, next);
+	cache->searchAcceleratorLevels = deterministicRandom()->randomInt(0, 6);
+	DeltaTree2<RedwoodRecordRef>::Cursor c(cache, tree);
 
 	// Test delete/insert behavior for each item, making no net changes
 	printf("Testing seek/delete/insert for existing keys with random values\n");
@@ -9474,6 +9985,7 @@ TEST_CASE("Lredwood/correctness/unit/deltaTree/IntIntPair") {
 	int builtSize2 = tree2->build(bufferSize, &items[0], &items[0] + items.size(), &lowerBound, &upperBound);
 	ASSERT(builtSize2 <= bufferSize);
 	auto cache = makeReference<DeltaTree2<IntIntPair>::DecodeCache>(lowerBound, upperBound);
+	cache->searchAcceleratorLevels = deterministicRandom()->randomInt(0, 6);
 	DeltaTree2<IntIntPair>::Cursor cur2(cache, tree2);
 
 	auto printItems = [&] {
@@ -11481,4 +11993,126 @@ TEST_CASE("/redwood/correctness/EnforceEncodingType") {
 		wait(closeKVS(kvs, true /*dispose*/));
 	}
 	return Void();
-}
\ No newline at end of file
+}
+
+TEST_CASE("/redwood/correctness/BulkBuild") {
+	state std::string file = "unittest_bulkbuild.redwood-v1";
+	state IKeyValueStore* kvs = nullptr;
+	state int count = params.getInt("count").orDefault(deterministicRandom()->randomInt(0, 20000));
+	state int batchSize = params.getInt("batchSize").orDefault(deterministicRandom()->randomInt(1, 2000));
+	state PromiseStream<Standalone<VectorRef<KeyValueRef>>> stream;
+	state Future<Void> load;
+	state int i = 0;
+
+	printf("count=%d batchSize=%d\n", count, batchSize);
+	deleteFile(file);
+	kvs = new KeyValueStoreRedwood(file,
+	                               UID(),
+	                               {}, // db
+	                               EncryptionAtRestMode::DISABLED,
+	                               EncodingType::XXHash64,
+	                               makeReference<NullEncryptionKeyProvider>());
+	wait(kvs->init());
+
+	load = kvs->bulkLoad(stream.getFuture());
+	while (i < count) {
+		Standalone<VectorRef<KeyValueRef>> batch;
+		for (int end = std::min(count, i + batchSize); i < end; ++i) {
+			batch.push_back_deep(batch.arena(),
+			                     KeyValueRef(StringRef(format("%08d", i)),
+			                                 StringRef(std::string(deterministicRandom()->randomInt(0, 300), 'v'))));
+		}
+		stream.send(batch);
+		wait(yield());
+	}
+	stream.sendError(end_of_stream());
+	wait(load);
+
+	// Reopen to verify the built tree was committed
+	wait(closeKVS(kvs));
+	kvs = new KeyValueStoreRedwood(file,
+	                               UID(),
+	                               {}, // db
+	                               EncryptionAtRestMode::DISABLED,
+	                               EncodingType::XXHash64,
+	                               makeReference<NullEncryptionKeyProvider>());
+	wait(kvs->init());
+
+	RangeResult result = wait(kvs->readRange(allKeys));
+	ASSERT_EQ(result.size(), count);
+	for (i = 0; i < count; ++i) {
+		ASSERT(result[i].key == StringRef(format("%08d", i)));
+	}
+
+	kvs->set(KeyValueRef("00000000x"_sr, "after"_sr));
+	wait(kvs->commit());
+	Optional<Value> v = wait(kvs->readValue("00000000x"_sr));
+	ASSERT(v.present() && v.get() == "after"_sr);
+
+	wait(closeKVS(kvs, true /*dispose*/));
+	return Void();
+}
+
+#ifdef ZSTD_LIB_SUPPORTED
+TEST_CASE("/redwood/correctness/PageCompression") {
+	state std::string file = "unittest_pagecompression.redwood-v1";
+	state IKeyValueStore* kvs = nullptr;
+	state int count = params.getInt("count").orDefault(deterministicRandom()->randomInt(1, 20000));
+	state int i;
+	state std::string savedFilter = SERVER_KNOBS->REDWOOD_PAGE_COMPRESSION_FILTER;
+	IKnobCollection::getMutableGlobalKnobCollection().setKnob("redwood_page_compression_filter",
+	                                                          KnobValueRef::create(std::string{ "ZSTD" }));
+
+	printf("count=%d\n", count);
+	deleteFile(file);
+	kvs = new KeyValueStoreRedwood(file,
+	                               UID(),
+	                               {}, // db
+	                               EncryptionAtRestMode::DISABLED,
+	                               EncodingType::XXHash64,
+	                               makeReference<NullEncryptionKeyProvider>());
+	wait(kvs->init());
+
+	// Redundant values so that leaves compress into fewer blocks than they are built from
+	for (i = 0; i < count; ++i) {
+		kvs->set(KeyValueRef(
+		    StringRef(format("%08d", i)),
+		    StringRef(format("{\"id\": %d, \"padding\": \"%s\"}", i, std::string(i % 200, 'x').c_str()))));
+		if (i % 1000 == 999) {
+			wait(kvs->commit());
+		}
+	}
+	wait(kvs->commit());
+
+	// Updates in place to compressed leaves and reads after reopening must see the same data
+	kvs->clear(KeyRangeRef("00000010"_sr, "00000020"_sr));
+	wait(kvs->commit());
+	wait(closeKVS(kvs));
+	kvs = new KeyValueStoreRedwood(file,
+	                               UID(),
+	                               {}, // db
+	                               EncryptionAtRestMode::DISABLED,
+	                               EncodingType::XXHash64,
+	                               makeReference<NullEncryptionKeyProvider>());
+	wait(kvs->init());
+
+	state RangeResult result = wait(kvs->readRange(allKeys));
+	state int expected = 0;
+	for (i = 0; i < count; ++i) {
+		if (i >= 10 && i < 20) {
+			continue;
+		}
+		ASSERT(expected < result.size());
+		ASSERT(result[expected].key == StringRef(format("%08d", i)));
+		ASSERT(result[expected].value ==
+		       StringRef(format("{\"id\": %d, \"padding\": \"%s\"}", i, std::string(i % 200, 'x').c_str())));
+		++expected;
+	}
+	ASSERT_EQ(result.size(), expected);
+
+	wait(closeKVS(kvs, true /*dispose*/));
+	IKnobCollection::getMutableGlobalKnobCollection().setKnob("redwood_page_compression_filter",
+	                                                          KnobValueRef::create(savedFilter));
+	return Void();
+}
+#endif
@@ -26,7 +26,9 @@
 #include <cctype>
 #include <fstream>
 #include <iterator>
+#include <map>
 #include <sstream>
+#include <thread>
 
 #include <stdarg.h>
 #include <stdio.h>
@@ -89,6 +91,8 @@
 #if defined(__linux__) || defined(__FreeBSD__)
 #include <execinfo.h>
 #include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
 #if defined(__linux__)
 #include <sys/prctl.h>
 #elif defined(__FreeBSD__)
@@ -116,7 +120,7 @@ enum {
 	OPT_DCID, OPT_MACHINE_CLASS, OPT_BUGGIFY, OPT_VERSION, OPT_BUILD_FLAGS, OPT_CRASHONERROR, OPT_HELP, OPT_NETWORKIMPL, OPT_NOBUFSTDOUT, OPT_BUFSTDOUTERR,
 	OPT_TRACECLOCK, OPT_NUMTESTERS, OPT_DEVHELP, OPT_PRINT_CODE_PROBES, OPT_ROLLSIZE, OPT_MAXLOGS, OPT_MAXLOGSSIZE, OPT_KNOB, OPT_UNITTESTPARAM, OPT_TESTSERVERS, OPT_TEST_ON_SERVERS, OPT_METRICSCONNFILE,
 	OPT_METRICSPREFIX, OPT_LOGGROUP, OPT_LOCALITY, OPT_IO_TRUST_SECONDS, OPT_IO_TRUST_WARN_ONLY, OPT_FILESYSTEM, OPT_PROFILER_RSS_SIZE, OPT_KVFILE,
-	OPT_TRACE_FORMAT, OPT_WHITELIST_BINPATH, OPT_BLOB_CREDENTIAL_FILE, OPT_CONFIG_PATH, OPT_USE_TEST_CONFIG_DB, OPT_NO_CONFIG_DB, OPT_FAULT_INJECTION, OPT_PROFILER, OPT_PRINT_SIMTIME,
+	OPT_TRACE_FORMAT, OPT_WHITELIST_BINPATH, OPT_BLOB_CREDENTIAL_FILE, OPT_CONFIG_PATH, OPT_USE_TEST_CONFIG_DB, OPT_NO_CONFIG_DB, OPT_FAULT_INJECTION, OPT_PROFILER, OPT_PRINT_SIMTIME, OPT_SIMULATION_SEEDS,
 	OPT_FLOW_PROCESS_NAME, OPT_FLOW_PROCESS_ENDPOINT, OPT_IP_TRUSTED_MASK, OPT_KMS_CONN_DISCOVERY_URL_FILE, OPT_KMS_CONNECTOR_TYPE, OPT_KMS_CONN_VALIDATION_TOKEN_DETAILS,
 	OPT_KMS_CONN_GET_ENCRYPTION_KEYS_ENDPOINT, OPT_KMS_CONN_GET_LATEST_ENCRYPTION_KEYS_ENDPOINT, OPT_KMS_CONN_GET_BLOB_METADATA_ENDPOINT, OPT_NEW_CLUSTER_KEY, OPT_AUTHZ_PUBLIC_KEY_FILE, OPT_USE_FUTURE_PROTOCOL_VERSION
 };
@@ -210,6 +214,7 @@ CSimpleOpt::SOption g_rgOptions[] = {
 	{ OPT_FAULT_INJECTION,       "--fault-injection",           SO_REQ_SEP },
 	{ OPT_PROFILER,	             "--profiler-",                 SO_REQ_SEP },
 	{ OPT_PRINT_SIMTIME,         "--print-sim-time",             SO_NONE },
+	{ OPT_SIMULATION_SEEDS,      "--simulation-seeds",          SO_REQ_SEP },
 	{ OPT_FLOW_PROCESS_NAME,     "--process-name",              SO_REQ_SEP },
 	{ OPT_FLOW_PROCESS_ENDPOINT, "--process-endpoint",          SO_REQ_SEP },
 	{ OPT_IP_TRUSTED_MASK,       "--trusted-subnet-",           SO_REQ_SEP },
@@ -639,8 +644,8 @@ static void printUsage(const char* name, bool devhelp) {
 	                 " Sets the LogGroup field with the specified value for all"
 	                 " events in the trace output (defaults to `default').");
 	printOptionUsage("--trace-format FORMAT",
-	                 " Select the format of the log files. xml (the default) and json"
-	                 " are supported.");
+	                 " Select the format of the log files. xml (the default), json and"
+	                 " msgpack (compact binary, see contrib/trace_convert.py) are supported.");
 	printOptionUsage("--tracer       TRACER",
 	                 " Select a tracer for transaction tracing. Currently disabled"
 	                 " (the default) and log_file are supported.");
@@ -683,7 +688,8 @@ static void printUsage(const char* name, bool devhelp) {
 		printOptionUsage("-r ROLE, --role ROLE",
 		                 " Server role (valid options are fdbd, test, multitest,"
 		                 " simulation, networktestclient, networktestserver, restore"
-		                 " consistencycheck, kvfileintegritycheck, kvfilegeneratesums, kvfiledump, unittests)."
+		                 " consistencycheck, kvfileintegritycheck, kvfilegeneratesums, kvfiledump, kvbench,"
+		                 " unittests)."
 		                 " The default is `fdbd'.");
 #ifdef _WIN32
 		printOptionUsage("-n, --newconsole", " Create a new console.");
@@ -695,6 +701,12 @@ static void printUsage(const char* name, bool devhelp) {
 		                 "unit tests to run as a search prefix.");
 		printOptionUsage("-R, --restarting", " Restart a previous simulation that was cleanly shut down.");
 		printOptionUsage("-s SEED, --seed SEED", " Random seed.");
+#if defined(__linux__) || defined(__FreeBSD__)
+		printOptionUsage("--simulation-seeds COUNT",
+		                 " Run the simulation with COUNT consecutive seeds starting at SEED, each in a forked process "
+		                 "working in the directory `seed-SEED', as many at once as there are cores. Relative data and "
+		                 "log folders are per seed. Exits with the first non-zero exit code of a seed.");
+#endif
 		printOptionUsage("-k KEY, --key KEY", "Target key for search role.");
 		printOptionUsage("--kvfile FILE",
 		                 "Input file (SQLite database file) for use by the 'kvfilegeneratesums', "
@@ -752,6 +764,19 @@ static void printUsage(const char* name, bool devhelp) {
 		       " - FDB_DUMP_ENDKEY: end key for the dump, default is \"\\xff\\xff\"\n"
 		       " - FDB_DUMP_DEBUG: print key-values to stderr in escaped format\n");
 
+		printf("\n"
+		       "The 'kvbench' role benchmarks a storage engine in a new directory under --datadir and prints\n"
+		       "throughput, latency percentiles, write amplification and space amplification as JSON to stdout.\n"
+		       "This role takes these environment variables as parameters:\n"
+		       " - FDB_KVBENCH_ENGINE: storage engine, e.g. ssd-2, memory, ssd-redwood-1-experimental (default ssd-2)\n"
+		       " - FDB_KVBENCH_TRACE: trace file to replay, one tab separated operation per line in escaped format:\n"
+		       "   set KEY VALUE, clear BEGIN END, get KEY, range BEGIN END LIMIT, or commit\n"
+		       " - FDB_KVBENCH_WORKLOAD: YCSB workload a, b, c or e to run when there is no trace (default a)\n"
+		       " - FDB_KVBENCH_RECORDS, FDB_KVBENCH_OPERATIONS: YCSB record and operation counts (default 100000)\n"
+		       " - FDB_KVBENCH_VALUE_BYTES: YCSB value size (default 100)\n"
+		       " - FDB_KVBENCH_BATCH: YCSB mutations per commit (default 100)\n"
+		       " - FDB_KVBENCH_KEEP: keep the store's files instead of deleting them\n");
+
 		printf(
 		    "\n"
 		    "The 'changedescription' role replaces the old cluster key in all coordinators' data file to the specified "
@@ -1017,6 +1042,7 @@ enum class ServerRole {
 	KVFileGenerateIOLogChecksums,
 	KVFileIntegrityCheck,
 	KVFileDump,
+	KVBench,
 	MultiTester,
 	NetworkTestClient,
 	NetworkTestServer,
@@ -1086,6 +1112,7 @@ struct CLIOptions {
 	std::string flowProcessName;
 	Endpoint flowProcessEndpoint;
 	bool printSimTime = false;
+	int simulationSeeds = 1;
 	IPAllowList allowList;
 
 	static CLIOptions parseArgs(int argc, char* argv[]) {
@@ -1293,6 +1320,8 @@ private:
 					role = ServerRole::KVFileGenerateIOLogChecksums;
 				else if (!strcmp(sRole, "kvfiledump"))
 					role = ServerRole::KVFileDump;
+				else if (!strcmp(sRole, "kvbench"))
+					role = ServerRole::KVBench;
 				else if (!strcmp(sRole, "consistencycheck"))
 					role = ServerRole::ConsistencyCheck;
 				else if (!strcmp(sRole, "unittests"))
@@ -1676,6 +1705,16 @@ private:
 			case OPT_PRINT_SIMTIME:
 				printSimTime = true;
 				break;
+			case OPT_SIMULATION_SEEDS: {
+				char* end;
+				simulationSeeds = strtol(args.OptionArg(), &end, 10);
+				if (*end || simulationSeeds < 1) {
+					fprintf(stderr, "ERROR: Could not parse simulation seed count `%s'\n", args.OptionArg());
+					printHelpTeaser(argv[0]);
+					flushAndExit(FDB_EXIT_ERROR);
+				}
+				break;
+			}
 
 			case TLSConfig::OPT_TLS_PLUGIN:
 				args.OptionArg();
@@ -1781,7 +1820,7 @@ private:
 		    });
 		if ((role != ServerRole::Simulation && role != ServerRole::CreateTemplateDatabase &&
 		     role != ServerRole::KVFileIntegrityCheck && role != ServerRole::KVFileGenerateIOLogChecksums &&
-		     role != ServerRole::KVFileDump && role != ServerRole::UnitTests) ||
+		     role != ServerRole::KVFileDump && role != ServerRole::KVBench && role != ServerRole::UnitTests) ||
 		    autoPublicAddress) {
 
 			if (seedSpecified && !fileExists(connFile)) {
@@ -1819,6 +1858,12 @@ private:
 			// failmon?
 		}
 
+		if (simulationSeeds > 1 && role != ServerRole::Simulation) {
+			fprintf(stderr, "ERROR: --simulation-seeds requires the simulation role\n");
+			printHelpTeaser(argv[0]);
+			flushAndExit(FDB_EXIT_ERROR);
+		}
+
 		if (role == ServerRole::Simulation) {
 			Optional<bool> buggifyOverride = checkBuggifyOverride(testFile);
 			if (buggifyOverride.present())
@@ -1908,6 +1953,64 @@ bool validateSimulationDataFiles(std::string const& dataFolder, bool isRestartin
 	return true;
 }
 
+#if defined(__linux__) || defined(__FreeBSD__)
+// Runs opts.simulationSeeds simulations with consecutive seeds, each in a forked child that shares the parent's
+// already initialized memory copy-on-write. Returns in each child with opts changed to its seed and working
+// directory, and never returns in the parent, which exits with the first non-zero exit code of a child.
+void forkSimulationSeeds(CLIOptions& opts) {
+	opts.testFile = abspath(opts.testFile);
+	int parallelism = std::max<int>(std::thread::hardware_concurrency(), 1);
+	std::map<pid_t, uint32_t> running;
+	int next = 0;
+	int exitCode = FDB_EXIT_SUCCESS;
+	while (next < opts.simulationSeeds || !running.empty()) {
+		if (next < opts.simulationSeeds && running.size() < static_cast<size_t>(parallelism)) {
+			uint32_t seed = opts.randomSeed + next++;
+			std::string directory = format("seed-%u", seed);
+			fflush(stdout);
+			fflush(stderr);
+			pid_t pid = fork();
+			if (pid == 0) {
+				if (!platform::createDirectory(directory) || chdir(directory.c_str()) != 0) {
+					fprintf(stderr, "ERROR: Could not use directory `%s' for seed %u\n", directory.c_str(), seed);
+					_exit(FDB_EXIT_ERROR);
+				}
+				opts.randomSeed = seed;
+				opts.simulationSeeds = 1;
+				return;
+			}
+			if (pid < 0) {
+				fprintf(stderr, "ERROR: Could not fork a simulation for seed %u\n", seed);
+				exitCode = FDB_EXIT_ERROR;
+				next = opts.simulationSeeds;
+			} else {
+				running[pid] = seed;
+			}
+			continue;
+		}
+
+		int status;
+		pid_t pid = waitpid(-1, &status, 0);
+		if (pid < 0) {
+			break;
+		}
+		auto it = running.find(pid);
+		if (it == running.end()) {
+			continue;
+		}
+		int code = WIFEXITED(status) ? WEXITSTATUS(status) : FDB_EXIT_ERROR;
+		if (code != FDB_EXIT_SUCCESS) {
+			fprintf(stderr, "Simulation with seed %u failed with exit code %d\n", it->second, code);
+			if (exitCode == FDB_EXIT_SUCCESS) {
+				exitCode = code;
+			}
+		}
+		running.erase(it);
+	}
+	flushAndExit(exitCode);
+}
+#endif
+
 } // namespace
 
 int main(int argc, char* argv[]) {
@@ -1919,6 +2022,15 @@ int main(int argc, char* argv[]) {
 	try {
 		platformInit();
 
+		// How long each step of starting up takes, traced once the trace file is open
+		double startupPhaseStart = timer();
+		std::vector<std::pair<std::string, double>> startupPhases;
+		auto endStartupPhase = [&](const char* phase) {
+			double t = timer();
+			startupPhases.emplace_back(phase, t - startupPhaseStart);
+			startupPhaseStart = t;
+		};
+
 #ifdef ALLOC_INSTRUMENTATION
 		g_extra_memory = new uint8_t[1000000];
 #endif
@@ -1939,6 +2051,13 @@ int main(int argc, char* argv[]) {
 		auto opts = CLIOptions::parseArgs(argc, argv);
 		const auto role = opts.role;
 
+#if defined(__linux__) || defined(__FreeBSD__)
+		if (opts.simulationSeeds > 1) {
+			forkSimulationSeeds(opts);
+		}
+#endif
+		endStartupPhase("Arguments");
+
 		if (role == ServerRole::Simulation) {
 			printf("Random seed is %u...\n", opts.randomSeed);
 			bindDeterministicRandomToOpenssl();
@@ -2006,6 +2125,8 @@ int main(int argc, char* argv[]) {
 			flushAndExit(FDB_EXIT_SUCCESS);
 		}
 
+		endStartupPhase("Knobs");
+
 		// Initialize the thread pool
 		CoroThreadPool::init();
 		// Ordinarily, this is done when the network is run. However, network thread should be set before TraceEvents
@@ -2026,6 +2147,7 @@ int main(int argc, char* argv[]) {
 			g_network->addStopCallback(Net2FileSystem::stop);
 			FlowTransport::createInstance(false, 1, WLTOKEN_RESERVED_COUNT, &opts.allowList);
 			opts.buildNetwork(argv[0]);
+			endStartupPhase("Network");
 
 			const bool expectsPublicAddress = (role == ServerRole::FDBD || role == ServerRole::NetworkTestServer ||
 			                                   role == ServerRole::Restore || role == ServerRole::FlowProcess);
@@ -2040,6 +2162,7 @@ int main(int argc, char* argv[]) {
 			openTraceFile(
 			    opts.publicAddresses.address, opts.rollsize, opts.maxLogsSize, opts.logFolder, "trace", opts.logGroup);
 			g_network->initTLS();
+			endStartupPhase("TraceFileAndTLS");
 			if (!opts.authzPublicKeyFile.empty()) {
 				try {
 					FlowTransport::transport().loadPublicKeyFile(opts.authzPublicKeyFile);
@@ -2081,6 +2204,7 @@ int main(int argc, char* argv[]) {
 			g_network->initMetrics();
 			FlowTransport::transport().initMetrics();
 			initTraceEventMetrics();
+			endStartupPhase("ListenAndFileSystem");
 		}
 
 		double start = timer(), startNow = now();
@@ -2126,6 +2250,16 @@ int main(int argc, char* argv[]) {
 		    .detail("ProtocolVersion", currentProtocolVersion())
 		    .trackLatest("ProgramStart");
 
+		if (!g_network->isSimulated()) {
+			TraceEvent startupEvent("ProgramStartupPhases");
+			double total = 0;
+			for (auto const& [phase, seconds] : startupPhases) {
+				startupEvent.detail(phase + "Seconds", seconds);
+				total += seconds;
+			}
+			startupEvent.detail("TotalSeconds", total);
+		}
+
 		Error::init();
 		std::set_new_handler(&platform::outOfMemory);
 		Future<Void> memoryUsageMonitor = startMemoryUsageMonitor(opts.memLimit);
@@ -2428,6 +2562,9 @@ int main(int argc, char* argv[]) {
 		} else if (role == ServerRole::KVFileDump) {
 			f = stopAfter(KVFileDump(opts.kvFile));
 			g_network->run();
+		} else if (role == ServerRole::KVBench) {
+			f = stopAfter(KVBench(opts.dataFolder));
+			g_network->run();
 		} else if (role == ServerRole::ChangeClusterKey) {
 			Key newClusterKey(opts.newClusterKey);
 			Key oldClusterKey = opts.connectionFile->getConnectionString().clusterKey();
@@ -0,0 +1,75 @@
+/*
+ * ArtVersionHistory.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FDBSERVER_ARTVERSIONHISTORY_H
+#define FDBSERVER_ARTVERSIONHISTORY_H
+#pragma once
+
+#include "fdbclient/FDBTypes.h"
+
+// The version history of a ConflictSet, kept in an adaptive radix tree instead of a SkipList.
+//
+// The history is a set of boundary keys.  Each boundary holds the newest commit version of any write to the keys from
+// it up to the next boundary, and the empty key is always a boundary.  Every tree node is annotated with the max
+// version found in its subtree, so a read range is checked by walking down the paths of its two ends and looking at
+// the annotations of the subtrees in between.  The cost of a lookup depends on the length of the keys and not on the
+// number of boundaries, and keys sharing long prefixes (such as the keys of one tenant) share the nodes of the prefix.
+class ArtVersionHistory : NonCopyable {
+public:
+	explicit ArtVersionHistory(Version version = 0);
+	~ArtVersionHistory();
+
+	// Returns true if any key in [begin, end) was written at a version newer than readVersion.  As in the SkipList, an
+	// empty range is checked against the keys just before begin.
+	bool hasConflict(KeyRef begin, KeyRef end, Version readVersion) const;
+
+	// Records a write to [begin, end) at version, which must not be older than any version already recorded
+	void addConflictRange(KeyRef begin, KeyRef end, Version version);
+
+	// Visits up to nodeCount boundaries in key order starting at the first boundary >= from, and removes each one that
+	// is older than oldestVersion and follows a boundary that is also older.  Reads at or after oldestVersion can't
+	// tell the difference.  Returns the key of the next boundary to visit, or an empty key after the last one.
+	Key removeBefore(Version oldestVersion, KeyRef from, int nodeCount);
+
+	// Resets the history to a single boundary at the empty key
+	void clear(Version version);
+
+	// Returns the number of boundaries
+	int count() const { return boundaryCount; }
+
+	// Verifies the structure and version annotations of the whole tree, for tests
+	void checkInvariants() const;
+
+private:
+	struct Node;
+
+	Node* root;
+	int boundaryCount;
+
+	Node* floorNode(KeyRef key, bool inclusive) const;
+	Node* ceilNode(KeyRef key, bool inclusive) const;
+	bool newerBetween(KeyRef begin, KeyRef end, Version readVersion) const;
+	Node* insert(KeyRef key, Version version, bool overwrite);
+	void eraseBoundary(Node* n);
+	Key keyOf(const Node* n) const;
+	void destroy();
+};
+
+#endif
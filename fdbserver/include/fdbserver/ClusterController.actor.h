@@ -3430,6 +3430,7 @@ public:
 	Counter getClientWorkersRequests;
 	Counter registerMasterRequests;
 	Counter statusRequests;
+	Counter statusRequestsFromCache;
 
 	Reference<EventCacheHolder> recruitedMasterWorkerEventHolder;
 
@@ -3451,6 +3452,7 @@ public:
 	    getClientWorkersRequests("GetClientWorkersRequests", clusterControllerMetrics),
 	    registerMasterRequests("RegisterMasterRequests", clusterControllerMetrics),
 	    statusRequests("StatusRequests", clusterControllerMetrics),
+	    statusRequestsFromCache("StatusRequestsFromCache", clusterControllerMetrics),
 	    recruitedMasterWorkerEventHolder(makeReference<EventCacheHolder>("RecruitedMasterWorker")) {
 		auto serverInfo = ServerDBInfo();
 		serverInfo.id = deterministicRandom()->randomUniqueID();
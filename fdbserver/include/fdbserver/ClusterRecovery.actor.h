@@ -233,6 +233,7 @@ struct ClusterRecoveryData : NonCopyable, ReferenceCounted<ClusterRecoveryData>
 	Reference<AsyncVar<bool>> recruitmentStalled;
 	bool forceRecovery;
 	bool neverCreated;
+	double recoveryPhaseStart; // When the latest recovery state event was logged
 	int8_t safeLocality;
 	int8_t primaryLocality;
 
@@ -272,7 +273,7 @@ struct ClusterRecoveryData : NonCopyable, ReferenceCounted<ClusterRecoveryData>
 	    masterInterface(masterInterface), masterLifetime(masterLifetimeToken), clusterController(clusterController),
 	    cstate(coordinators, addActor, dbgid), dbInfo(dbInfo), registrationCount(0), addActor(addActor),
 	    recruitmentStalled(makeReference<AsyncVar<bool>>(false)), forceRecovery(forceRecovery), neverCreated(false),
-	    safeLocality(tagLocalityInvalid), primaryLocality(tagLocalityInvalid),
+	    recoveryPhaseStart(now()), safeLocality(tagLocalityInvalid), primaryLocality(tagLocalityInvalid),
 	    cc("ClusterRecoveryData", dbgid.toString()), changeCoordinatorsRequests("ChangeCoordinatorsRequests", cc),
 	    getCommitVersionRequests("GetCommitVersionRequests", cc),
 	    backupWorkerDoneRequests("BackupWorkerDoneRequests", cc),
@@ -298,6 +299,14 @@ struct ClusterRecoveryData : NonCopyable, ReferenceCounted<ClusterRecoveryData>
 			forceRecovery = false;
 		}
 	}
+
+	// Seconds spent in the previous recovery state; call once per recovery state event
+	double endRecoveryPhase() {
+		double t = now();
+		double elapsed = t - recoveryPhaseStart;
+		recoveryPhaseStart = t;
+		return elapsed;
+	}
 	~ClusterRecoveryData() {
 		if (txnStateStore)
 			txnStateStore->close();
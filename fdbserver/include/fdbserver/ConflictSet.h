@@ -28,7 +28,11 @@
 #include "fdbclient/CommitTransaction.h"
 
 struct ConflictSet;
-ConflictSet* newConflictSet();
+// partitionCount > 1 splits conflict detection for large batches across that many key range partitions of the
+// version history, each checked on its own thread.  useART keeps the version history in an ArtVersionHistory instead
+// of a SkipList, in which case partitionCount is ignored.  useWriteFilter puts a RecentWriteFilter in front of the
+// version history, configured by the RESOLVER_RECENT_WRITE_FILTER_* knobs.
+ConflictSet* newConflictSet(int partitionCount = 1, bool useART = false, bool useWriteFilter = false);
 void clearConflictSet(ConflictSet*, Version);
 void destroyConflictSet(ConflictSet*);
 
@@ -45,13 +49,24 @@ struct ConflictBatch {
 		TransactionCommitted,
 	};
 
-	void addTransaction(const CommitTransactionRef& transaction, Version newOldestVersion);
+	// With sampleConflictingKeys, the conflicting read ranges of a transaction that did not ask for them are
+	// recorded in sampledConflictingKeyRanges()
+	void addTransaction(const CommitTransactionRef& transaction,
+	                    Version newOldestVersion,
+	                    bool sampleConflictingKeys = false);
 	void detectConflicts(Version now,
 	                     Version newOldestVersion,
 	                     std::vector<int>& nonConflicting,
 	                     std::vector<int>* tooOldTransactions = nullptr);
 	void GetTooOldTransactions(std::vector<int>& tooOldTransactions);
 
+	// The read conflict ranges of the last detectConflicts() that the recent write filter proved conflict-free, and
+	// those that were checked against the version history
+	int filteredReadConflictRanges() const { return filteredReadRanges; }
+	int checkedReadConflictRanges() const { return checkedReadRanges; }
+	// Transaction index -> indices of its conflicting read conflict ranges, for the sampled transactions
+	const std::map<int, VectorRef<int>>& sampledConflictingKeyRanges() const { return sampledConflictingKeyRangeMap; }
+
 private:
 	ConflictSet* cs;
 	Standalone<VectorRef<struct TransactionInfo*>> transactionInfo;
@@ -63,11 +78,21 @@ private:
 	// Stores the map: a transaction -> conflicted transactions' indices
 	std::map<int, VectorRef<int>>* conflictingKeyRangeMap;
 	Arena* resolveBatchReplyArena;
+	std::map<int, VectorRef<int>> sampledConflictingKeyRangeMap;
+	Arena sampledConflictingKeyRangeArena;
+	int filteredReadRanges;
+	int checkedReadRanges;
 
+	void filterReadConflictRanges();
 	void checkIntraBatchConflicts();
 	void combineWriteConflictRanges();
 	void checkReadConflictRanges();
 	void mergeWriteConflictRanges(Version now);
+	std::vector<StringRef> choosePartitionKeys(int partitionCount);
+	void checkReadConflictRangesPartitioned(const std::vector<StringRef>& partitionKeys, class SkipList* parts);
+	void mergeWriteConflictRangesPartitioned(Version now,
+	                                         const std::vector<StringRef>& partitionKeys,
+	                                         class SkipList* parts);
 	void addConflictRanges(Version now,
 	                       std::vector<std::pair<StringRef, StringRef>>::iterator begin,
 	                       std::vector<std::pair<StringRef, StringRef>>::iterator end,
@@ -233,6 +233,7 @@ protected:
 	Reference<StorageWiggler> storageWiggler;
 	std::vector<AddressExclusion> wiggleAddresses; // collection of wiggling servers' address
 	Optional<UID> wigglingId; // Process id of current wiggling storage server;
+	std::vector<UID> zoneWigglingIds; // Servers in wigglingId's zone wiggled along with it
 	Reference<AsyncVar<bool>> pauseWiggle;
 	Reference<AsyncVar<bool>> processingWiggle; // track whether wiggling relocation is being processed
 	PromiseStream<StorageWiggleValue> nextWiggleInfo;
@@ -441,6 +442,10 @@ protected:
 	// Return a vector of futures wait for all data is moved to other teams.
 	Future<Void> excludeStorageServersForWiggle(const UID& id);
 
+	// Returns up to PERPETUAL_WIGGLE_ZONE_SERVERS other servers in the zone of server "id" that are due to be wiggled.
+	// Every team has at most one server in a zone, so wiggling them together loses no more replicas than wiggling "id"
+	std::vector<UID> getZoneServersToWiggle(const UID& id) const;
+
 	// Include wiggled storage servers by setting their status from `WIGGLING`
 	// to `NONE`. The storage recruiter will recruit them as new storage servers
 	void includeStorageServersForWiggle();
@@ -252,10 +252,12 @@ struct ShardMetrics {
 	StorageMetrics metrics;
 	double lastLowBandwidthStartTime;
 	int shardCount; // number of smaller shards whose metrics are aggregated in the ShardMetrics
+	// Write bandwidth extrapolated SHARD_WRITE_TREND_HORIZON seconds ahead from its recent trend
+	int64_t projectedBytesWrittenPerKSecond = 0;
 
 	bool operator==(ShardMetrics const& rhs) const {
 		return metrics == rhs.metrics && lastLowBandwidthStartTime == rhs.lastLowBandwidthStartTime &&
-		       shardCount == rhs.shardCount;
+		       shardCount == rhs.shardCount && projectedBytesWrittenPerKSecond == rhs.projectedBytesWrittenPerKSecond;
 	}
 
 	ShardMetrics(StorageMetrics const& metrics, double lastLowBandwidthStartTime, int shardCount)
@@ -599,6 +601,8 @@ struct StorageWiggler : ReferenceCounted<StorageWiggler> {
 	// update metadata and adjust priority_queue
 	void updateMetadata(const UID& serverId, const StorageMetadataType& metadata);
 	bool contains(const UID& serverId) const { return pq_handles.count(serverId) > 0; }
+	// whether the server is still waiting in the queue and is necessary to wiggle
+	bool isDue(const UID& serverId) const;
 	bool empty() const { return wiggle_pq.empty(); }
 
 	// It's guarantee that When a.metadata >= b.metadata, if !necessary(a) then !necessary(b)
@@ -911,6 +911,10 @@ private:
 //    // Update cache with the Partial for *this, storing any heap memory for the Partial in arena
 //    void updateCache(Optional<Partial> cache, Arena& arena) const;
 //
+//    // Returns a fingerprint of the bytes of *this after skipLen, such that if a and b share their first skipLen
+//    // bytes then a.getSearchPrefix(skipLen) < b.getSearchPrefix(skipLen) implies a < b.
+//    uint64_t getSearchPrefix(int skipLen) const;
+//
 //    // For debugging, return a useful human-readable string representation of *this
 //    std::string toString() const;
 //
@@ -1093,11 +1097,24 @@ public:
 		// Index 0 is always the root
 		std::vector<DecodedNode> decodedNodes;
 
+		// The search accelerator holds the search prefixes of the nodes in the top levels of the tree, in heap order,
+		// so that seeks can descend through those levels by comparing integers instead of decoding each node.
+		// It is built by the first seek once searchAcceleratorLevels is set, and only covers nodes whose items share
+		// the first searchPrefixLen bytes of the bounds.
+		struct SearchSlot {
+			uint64_t prefix;
+			int16_t decodedIndex; // -1 if there is no node at this position
+		};
+		int searchAcceleratorLevels = 0;
+		bool searchAcceleratorBuilt = false;
+		int searchPrefixLen = 0;
+		std::vector<SearchSlot> searchSlots;
+
 		DecodedNode& get(int index) { return decodedNodes[index]; }
 
 		void updateUsedMemory() {
 			int usedNow = sizeof(DeltaTree2) + arena.getSize(FastInaccurateEstimate::True) +
-			              (decodedNodes.capacity() * sizeof(DecodedNode));
+			              (decodedNodes.capacity() * sizeof(DecodedNode)) + (searchSlots.capacity() * sizeof(SearchSlot));
 			if (pMemoryTracker != nullptr) {
 				*pMemoryTracker += (usedNow - lastKnownUsedMemory);
 			}
@@ -1115,6 +1132,8 @@ public:
 
 		void clear() {
 			decodedNodes.clear();
+			searchSlots.clear();
+			searchAcceleratorBuilt = false;
 			Arena a;
 			lowerBound = T(a, lowerBound);
 			upperBound = T(a, upperBound);
@@ -1357,6 +1376,13 @@ public:
 			int nIndex = rootIndex();
 			int cmp = 0;
 
+			if (nIndex != -1 && cache->searchAcceleratorLevels > 0) {
+				if (!cache->searchAcceleratorBuilt) {
+					buildSearchAccelerator();
+				}
+				nIndex = seekAccelerated(s, nIndex, cmp);
+			}
+
 			while (nIndex != -1) {
 				nodeIndex = nIndex;
 				item.reset();
@@ -1376,6 +1402,66 @@ public:
 			return cmp;
 		}
 
+		// Descends from the root through the levels of the tree covered by the search accelerator for as long as s's
+		// search prefix decides each comparison. Sets nodeIndex and cmp as seek() would for the last node passed and
+		// returns the index of the node that seek() must continue from, which is nIndex if nothing was decided.
+		int seekAccelerated(const T& s, int nIndex, int& cmp) {
+			const auto& slots = cache->searchSlots;
+			if (slots.empty() || s.getCommonPrefixLen(cache->lowerBound, 0) < cache->searchPrefixLen) {
+				return nIndex;
+			}
+
+			uint64_t prefix = s.getSearchPrefix(cache->searchPrefixLen);
+			int slot = 0;
+			// The cache can be shared with newer versions of the tree, so each step checks that the node the tree
+			// leads to is the one the slot was built from
+			while (nIndex != -1 && slot < slots.size() && slots[slot].decodedIndex == nIndex &&
+			       prefix != slots[slot].prefix) {
+				nodeIndex = nIndex;
+				if (prefix > slots[slot].prefix) {
+					cmp = 1;
+					nIndex = getRightChildIndex(nIndex);
+					slot = 2 * slot + 2;
+				} else {
+					cmp = -1;
+					nIndex = getLeftChildIndex(nIndex);
+					slot = 2 * slot + 1;
+				}
+			}
+			return nIndex;
+		}
+
+		void buildSearchAccelerator() {
+			cache->searchAcceleratorBuilt = true;
+			int numSlots = (1 << cache->searchAcceleratorLevels) - 1;
+			// A tree that does not fill the accelerated levels is too small to benefit
+			if (tree->numItems < numSlots) {
+				return;
+			}
+
+			cache->searchPrefixLen = cache->lowerBound.getCommonPrefixLen(cache->upperBound, 0);
+			cache->searchSlots.assign(numSlots, { 0, -1 });
+			cache->searchSlots[0].decodedIndex = rootIndex();
+			for (int i = 0; i < numSlots; i++) {
+				int index = cache->searchSlots[i].decodedIndex;
+				if (index == -1) {
+					continue;
+				}
+				const T rec = get(cache->get(index));
+				if (rec.getCommonPrefixLen(cache->lowerBound, 0) < cache->searchPrefixLen) {
+					cache->searchSlots.clear();
+					return;
+				}
+				cache->searchSlots[i].prefix = rec.getSearchPrefix(cache->searchPrefixLen);
+				if (2 * i + 2 < numSlots) {
+					int left = getLeftChildIndex(index);
+					int right = getRightChildIndex(index);
+					cache->searchSlots[2 * i + 1].decodedIndex = left;
+					cache->searchSlots[2 * i + 2].decodedIndex = right;
+				}
+			}
+		}
+
 		bool moveFirst() {
 			nodeIndex = -1;
 			item.reset();
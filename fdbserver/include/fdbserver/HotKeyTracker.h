@@ -0,0 +1,98 @@
+/*
+ * HotKeyTracker.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FDBSERVER_HOTKEYTRACKER_H
+#define FDBSERVER_HOTKEYTRACKER_H
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "fdbclient/FDBTypes.h"
+
+// A Space-Saving heavy hitter sketch over keys.  It counts at most capacity keys; when a new key arrives and the
+// sketch is full, the key with the smallest count is replaced and the new key inherits that count.  Every key seen
+// more than total / capacity times is therefore tracked, and a tracked key's count overestimates its true count by at
+// most the count it inherited.
+class HotKeySketch {
+public:
+	explicit HotKeySketch(int capacity);
+
+	void add(KeyRef key, int64_t count = 1);
+	// Returns 0 for a key that isn't tracked
+	int64_t getCount(KeyRef key) const;
+	void clear();
+
+	int size() const { return heap.size(); }
+	int64_t getTotal() const { return total; }
+
+	template <class F>
+	void forEach(F const& f) const {
+		for (auto const& e : heap) {
+			f(KeyRef(e.key), e.count);
+		}
+	}
+
+private:
+	struct Entry {
+		Key key;
+		int64_t count = 0;
+	};
+
+	size_t capacity;
+	int64_t total = 0;
+	// A min-heap by count
+	std::vector<Entry> heap;
+	// The heap index of each tracked key.  The keys point into the keys of the entries, which don't move when the
+	// entries do.
+	std::unordered_map<StringRef, int> positions;
+
+	void siftDown(int i);
+	void swapEntries(int i, int j);
+};
+
+// Estimates the operation rates of the most frequent keys from a sample of the operations.  Samples are counted in two
+// windows of windowSeconds each, so the rates cover the last one to two windows.
+class HotKeyTracker : NonCopyable {
+public:
+	HotKeyTracker(int capacity, double sampleRate, double windowSeconds);
+
+	void add(KeyRef key) {
+		if (sampleRate >= 1.0 || (sampleRate > 0 && deterministicRandom()->random01() < sampleRate))
+			addSample(key);
+	}
+
+	// Counts a key that the caller has already sampled at sampleRate
+	void addSample(KeyRef key);
+
+	// The tracked keys in range with their estimated operations per second, in key order
+	std::vector<std::pair<Key, double>> getHotKeys(KeyRangeRef range);
+
+private:
+	const double sampleRate;
+	const double windowSeconds;
+	HotKeySketch current, previous;
+	double currentStart;
+	double previousDuration = 0;
+
+	void roll();
+};
+
+#endif
@@ -0,0 +1,102 @@
+/*
+ * HotRowCache.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FDBSERVER_HOTROWCACHE_H
+#define FDBSERVER_HOTROWCACHE_H
+#pragma once
+
+#include <map>
+
+#include <boost/intrusive/list.hpp>
+
+#include "fdbclient/FDBTypes.h"
+
+// A bounded LRU cache of point reads from a storage server's IKeyValueStore, including reads that found no value.
+//
+// The cache mirrors the durable state, not any particular version of it.  That is enough because the storage server
+// only reads a key from storage when no mutation in its versioned data decides it, and then the durable value is the
+// answer at every readable version.  So the cache only needs to forget a key when the durable state of the key changes:
+// every write to storage must be passed to invalidate() before it is applied.
+//
+// Storage engines may keep serving the previous value of a written key until the commit that includes the write
+// completes, so a read that starts in between can return a stale value.  The cache therefore remembers the ranges
+// written since the last commit and invalidates them again in endCommit(), and a read only fills the cache if its
+// key was not invalidated while the read was outstanding.
+class HotRowCache : NonCopyable {
+public:
+	HotRowCache(int64_t capacityBytes, int maxValueBytes);
+
+	// Returns the cached value of key, which is absent if storage has no value for it, or an empty Optional if the
+	// key is not cached
+	Optional<Optional<Value>> get(KeyRef key);
+
+	// Must be called before key is read from storage.  Returns a token to pass to endFill() with the result, or 0 if
+	// the result shouldn't be cached, for example because another read of the key is already filling it.
+	uint64_t beginFill(KeyRef key);
+	void endFill(KeyRef key, uint64_t token, const Optional<Value>& value);
+	// For a read that failed
+	void abandonFill(KeyRef key, uint64_t token);
+
+	// Forgets every key in range, now and again when the next commit to begin completes
+	void invalidate(KeyRangeRef range);
+	void invalidate(KeyRef key);
+
+	// Bracket each storage commit.  beginCommit() returns the id to pass to endCommit() once the commit completes.
+	uint64_t beginCommit();
+	void endCommit(uint64_t commitId);
+
+	// Forgets every key, for when the whole storage is replaced
+	void clear();
+
+	int64_t getBytes() const { return bytes; }
+	int64_t getEntries() const { return entries.size(); }
+	int64_t getEvictions() const { return evictions; }
+
+private:
+	struct Entry : boost::intrusive::list_base_hook<> {
+		KeyRef key; // Points into the key of the map node holding this entry
+		Optional<Value> value;
+		// Nonzero while a read from storage is filling the entry
+		uint64_t fillToken = 0;
+		int64_t size = 0;
+	};
+
+	const int64_t capacityBytes;
+	const int maxValueBytes;
+
+	std::map<Key, Entry, std::less<>> entries;
+	// Least recently used first
+	boost::intrusive::list<Entry> lru;
+	int64_t bytes = 0;
+	int64_t evictions = 0;
+	uint64_t nextFillToken = 1;
+	uint64_t nextCommitId = 1;
+
+	// Ranges written since the last commit began, and those written before each commit that hasn't completed yet
+	Standalone<VectorRef<KeyRangeRef>> uncommitted;
+	std::map<uint64_t, Standalone<VectorRef<KeyRangeRef>>> committing;
+
+	void erase(std::map<Key, Entry, std::less<>>::iterator it);
+	void eraseRange(KeyRangeRef range);
+	void setSize(Entry& e, int64_t size);
+	void evict();
+};
+
+#endif
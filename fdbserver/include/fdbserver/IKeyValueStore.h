@@ -68,6 +68,19 @@ public:
 	                                                int maxLength,
 	                                                Optional<ReadOptions> options = Optional<ReadOptions>()) = 0;
 
+	// Reads the prefixes of many values at once, where each of keys is a key and its maxLength. keys must be sorted and
+	// without duplicates. Engines that can batch point reads should override this.
+	virtual Future<std::vector<Optional<Value>>> readValuePrefixes(
+	    std::vector<std::pair<KeyRef, int>> const& keys,
+	    Optional<ReadOptions> options = Optional<ReadOptions>()) {
+		std::vector<Future<Optional<Value>>> values;
+		values.reserve(keys.size());
+		for (auto& [key, maxLength] : keys) {
+			values.push_back(readValuePrefix(key, maxLength, options));
+		}
+		return getAll(values);
+	}
+
 	// If rowLimit>=0, reads first rows sorted ascending, otherwise reads last rows sorted descending
 	// The total size of the returned value (less the last entry) will be less than byteLimit
 	virtual Future<RangeResult> readRange(KeyRangeRef keys,
@@ -75,6 +88,11 @@ public:
 	                                      int byteLimit = 1 << 30,
 	                                      Optional<ReadOptions> options = Optional<ReadOptions>()) = 0;
 
+	// Loads a stream of sorted key/value batches, ending with end_of_stream, into an empty store as a single commit.
+	// Batches must be in key order without duplicates and no other mutations may be pending.  Engines that can build
+	// their on-disk structures directly from sorted input should override this.
+	virtual Future<Void> bulkLoad(FutureStream<Standalone<VectorRef<KeyValueRef>>> kvs) { throw not_implemented(); }
+
 	// Shard management APIs.
 	// Adds key range to a physical shard.
 	virtual Future<Void> addRange(KeyRangeRef range, std::string id) { return Void(); }
@@ -229,5 +247,6 @@ inline IKeyValueStore* openKVStore(KeyValueStoreType storeType,
 void GenerateIOLogChecksumFile(std::string filename);
 Future<Void> KVFileCheck(std::string const& filename, bool const& integrity);
 Future<Void> KVFileDump(std::string const& filename);
+Future<Void> KVBench(std::string const& dataFolder);
 
 #endif
@@ -727,6 +727,14 @@ public:
 		}
 	}
 
+	uint8_t getPageFormat() const {
+		if (page->headerVersion == 1) {
+			return page->getMainHeader<RedwoodHeaderV1>()->pageFormat;
+		} else {
+			throw page_header_version_not_supported();
+		}
+	}
+
 	// Used by encodings that do encryption
 	EncryptionKey encryptionKey;
 
@@ -277,6 +277,8 @@ struct ILogSystem {
 		Optional<LogMessageVersion> nextVersion;
 		LogMessageVersion messageVersion;
 		bool hasNextMessage;
+		// While reading from bestServer, the version the other cursors were last advanced to
+		Version othersAdvancedVersion = invalidVersion;
 		UID randomID;
 		int tLogReplicationFactor;
 		Future<Void> more;
@@ -338,6 +340,8 @@ struct ILogSystem {
 		LogMessageVersion messageVersion;
 		bool hasNextMessage;
 		bool useBestSet;
+		// While reading from bestServer of bestSet, the version the other cursors were last advanced to
+		Version othersAdvancedVersion = invalidVersion;
 		UID randomID;
 		Future<Void> more;
 
@@ -793,6 +797,13 @@ struct LogPushData : NonCopyable {
 
 	Standalone<StringRef> getMessages(int loc) const { return messagesWriter[loc].toValue(); }
 
+	// Returns the number of bytes written so far for location loc
+	int getMessageBytes(int loc) const { return messagesWriter[loc].getLength(); }
+
+	// Sizes the message buffer of location loc for a total of about bytes, so that the messages written to it are not
+	// copied each time the buffer grows
+	void reserveMessageBytes(int loc, int bytes) { messagesWriter[loc].reserve(bytes); }
+
 	// Returns all locations' messages, including empty ones.
 	std::vector<Standalone<StringRef>> getAllMessages() const;
 
@@ -60,6 +60,8 @@ struct ProxyStats {
 	Counter commitBatchIn, commitBatchOut;
 	Counter mutationBytes;
 	Counter mutations;
+	// The mutation log copies written into the database for backups and DR, which add to the source's write volume
+	Counter backupMutationBytes;
 	Counter conflictRanges;
 	Counter keyServerLocationIn, keyServerLocationOut, keyServerLocationErrors;
 	Counter tenantIdRequestIn;
@@ -79,6 +81,12 @@ struct ProxyStats {
 
 	LatencySample computeLatency;
 
+	// Where the time of the commits sampled for latency breakdown went, see CLIENT_KNOBS->LATENCY_BREAKDOWN_SAMPLE_RATE
+	LatencySample clientQueueBreakdown;
+	LatencySample batchWaitBreakdown;
+	LatencySample resolverBreakdown;
+	LatencySample tlogBreakdown;
+
 	Future<Void> logger;
 
 	int64_t maxComputeNS;
@@ -93,6 +101,15 @@ struct ProxyStats {
 	Reference<Histogram> tlogLoggingDist;
 	Reference<Histogram> replyCommitDist;
 
+	// Number of commit batches currently in each phase of commitBatch(). Batches waiting for their turn to do
+	// post-resolution processing are counted separately from the one doing it.
+	int64_t batchesPreresolution = 0;
+	int64_t batchesResolving = 0;
+	int64_t batchesPostResolutionQueued = 0;
+	int64_t batchesPostResolution = 0;
+	int64_t batchesLogging = 0;
+	int64_t batchesReplying = 0;
+
 	int64_t getAndResetMaxCompute() {
 		int64_t r = maxComputeNS;
 		maxComputeNS = 0;
@@ -116,7 +133,8 @@ struct ProxyStats {
 	    txnCommitOutSuccess("TxnCommitOutSuccess", cc), txnCommitErrors("TxnCommitErrors", cc),
 	    txnConflicts("TxnConflicts", cc), txnRejectedForQueuedTooLong("TxnRejectedForQueuedTooLong", cc),
 	    commitBatchIn("CommitBatchIn", cc), commitBatchOut("CommitBatchOut", cc), mutationBytes("MutationBytes", cc),
-	    mutations("Mutations", cc), conflictRanges("ConflictRanges", cc),
+	    mutations("Mutations", cc), backupMutationBytes("BackupMutationBytes", cc),
+	    conflictRanges("ConflictRanges", cc),
 	    keyServerLocationIn("KeyServerLocationIn", cc), keyServerLocationOut("KeyServerLocationOut", cc),
 	    keyServerLocationErrors("KeyServerLocationErrors", cc), tenantIdRequestIn("TenantIdRequestIn", cc),
 	    tenantIdRequestOut("TenantIdRequestOut", cc), tenantIdRequestErrors("TenantIdRequestErrors", cc),
@@ -140,6 +158,22 @@ struct ProxyStats {
 	                   id,
 	                   SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
 	                   SERVER_KNOBS->LATENCY_SKETCH_ACCURACY),
+	    clientQueueBreakdown("LatencyBreakdownClientQueue",
+	                         id,
+	                         SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
+	                         SERVER_KNOBS->LATENCY_SKETCH_ACCURACY),
+	    batchWaitBreakdown("LatencyBreakdownBatchWait",
+	                       id,
+	                       SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
+	                       SERVER_KNOBS->LATENCY_SKETCH_ACCURACY),
+	    resolverBreakdown("LatencyBreakdownResolver",
+	                      id,
+	                      SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
+	                      SERVER_KNOBS->LATENCY_SKETCH_ACCURACY),
+	    tlogBreakdown("LatencyBreakdownTLog",
+	                  id,
+	                  SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
+	                  SERVER_KNOBS->LATENCY_SKETCH_ACCURACY),
 	    maxComputeNS(0), minComputeNS(1e12),
 	    commitBatchQueuingDist(
 	        Histogram::getHistogram("CommitProxy"_sr, "CommitBatchQueuing"_sr, Histogram::Unit::milliseconds)),
@@ -161,10 +195,57 @@ struct ProxyStats {
 		specialCounter(cc, "NumTenants", [pTenantMap]() { return pTenantMap ? pTenantMap->size() : 0; });
 		specialCounter(cc, "MaxCompute", [this]() { return this->getAndResetMaxCompute(); });
 		specialCounter(cc, "MinCompute", [this]() { return this->getAndResetMinCompute(); });
+		specialCounter(cc, "BatchesPreresolution", [this]() { return this->batchesPreresolution; });
+		specialCounter(cc, "BatchesResolving", [this]() { return this->batchesResolving; });
+		specialCounter(cc, "BatchesPostResolutionQueued", [this]() { return this->batchesPostResolutionQueued; });
+		specialCounter(cc, "BatchesPostResolution", [this]() { return this->batchesPostResolution; });
+		specialCounter(cc, "BatchesLogging", [this]() { return this->batchesLogging; });
+		specialCounter(cc, "BatchesReplying", [this]() { return this->batchesReplying; });
 		logger = cc.traceCounters("ProxyMetrics", id, SERVER_KNOBS->WORKER_LOGGING_INTERVAL, "ProxyMetrics");
 	}
 };
 
+// Chooses the commit batch interval when COMMIT_BATCHING_TARGET_LATENCY is set. The interval is corrected after every
+// batch by the difference between the target and a running estimate of the p99 commit latency, and it is capped by
+// the part of the target left over after the resolver and TLog round trips, since the time a transaction spends
+// waiting in the batcher adds directly to its commit latency.
+class CommitBatchingController {
+public:
+	// Takes the measurements of a batch that was batched for interval seconds, and returns the interval to use for the
+	// next batches
+	double update(double target, double interval, double latency, double resolverRtt, double tlogRtt) {
+		double alpha = SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_SMOOTHER_ALPHA;
+		if (batches++ == 0) {
+			latencyP99 = latency;
+			smoothResolverRtt = resolverRtt;
+			smoothTLogRtt = tlogRtt;
+		} else {
+			// Streaming quantile estimate: at equilibrium 1% of the batches are above it
+			double step = target * SERVER_KNOBS->COMMIT_BATCHING_LATENCY_QUANTILE_STEP;
+			latencyP99 += latency > latencyP99 ? 0.99 * step : -0.01 * step;
+			latencyP99 = std::max(latencyP99, 0.0);
+			smoothResolverRtt = alpha * resolverRtt + (1 - alpha) * smoothResolverRtt;
+			smoothTLogRtt = alpha * tlogRtt + (1 - alpha) * smoothTLogRtt;
+		}
+
+		double maxInterval = std::max(SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_MIN,
+		                              std::min(SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_MAX,
+		                                       target - smoothResolverRtt - smoothTLogRtt));
+		interval += SERVER_KNOBS->COMMIT_BATCHING_CONTROLLER_GAIN * (target - latencyP99);
+		return std::max(SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_MIN, std::min(maxInterval, interval));
+	}
+
+	double getLatencyP99() const { return latencyP99; }
+	double getResolverRtt() const { return smoothResolverRtt; }
+	double getTLogRtt() const { return smoothTLogRtt; }
+
+private:
+	int64_t batches = 0;
+	double latencyP99 = 0;
+	double smoothResolverRtt = 0;
+	double smoothTLogRtt = 0;
+};
+
 struct ExpectedIdempotencyIdCountForKey {
 	Version commitVersion = invalidVersion;
 	int16_t idempotencyIdCount = 0;
@@ -180,6 +261,9 @@ struct ProxyCommitData {
 	int64_t commitBatchesMemBytesCount;
 	std::unordered_map<TenantName, int64_t> tenantNameIndex;
 	std::map<int64_t, TenantName> tenantMap;
+	// The ids in tenantMap, for constant time validation of the tenant of each mutation. tenantMap stays ordered for
+	// splitting clear ranges at tenant boundaries.
+	std::unordered_set<int64_t> tenantIdIndex;
 	std::set<int64_t> lockedTenants;
 	std::unordered_set<int64_t> tenantsOverStorageQuota;
 	ProxyStats stats;
@@ -210,6 +294,8 @@ struct ProxyCommitData {
 	bool locked;
 	Optional<Value> metadataVersion;
 	double commitBatchInterval;
+	CommitBatchingController commitBatchingController;
+	std::vector<int> lastTLogMessageBytes; // Size of the previous batch's message to each TLog location
 	bool provisional;
 
 	int64_t localCommitBatchesStarted;
@@ -247,6 +333,7 @@ struct ProxyCommitData {
 
 	PromiseStream<ExpectedIdempotencyIdCountForKey> expectedIdempotencyIdCountForKey;
 	Standalone<VectorRef<MutationRef>> idempotencyClears;
+	int64_t idempotencyIdTimeIndexBucket = -1; // The last idempotency id time index bucket this proxy wrote an entry in
 
 	AsyncVar<bool> triggerCommit;
 
@@ -0,0 +1,82 @@
+/*
+ * RecentWriteFilter.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FDBSERVER_RECENTWRITEFILTER_H
+#define FDBSERVER_RECENTWRITEFILTER_H
+#pragma once
+
+#include <deque>
+#include <utility>
+#include <vector>
+
+#include "fdbclient/FDBTypes.h"
+
+// A compact, conservative summary of the write ranges recently merged into a ConflictSet, used to prove read ranges
+// conflict-free before they are checked against the version history.
+//
+// Writes are grouped into windows of consecutive versions.  Each window keeps a bloom filter of the key prefixes
+// (the first prefixBytes bytes of a key, or the whole key if it is shorter) written in it, plus the exact bounds of the
+// few write ranges that span more than one prefix.  A read range whose keys all share one prefix is then checked with
+// two bit probes per window newer than its read version.  The filter never reports a read as conflict-free if the
+// version history could find a conflict; when in doubt it sends the read on to the history.
+class RecentWriteFilter : NonCopyable {
+public:
+	RecentWriteFilter(int bitsLog2, int prefixBytes, Version windowVersions);
+
+	// Returns false only if no write recorded at a version newer than readVersion intersects [begin, end)
+	bool mayConflict(KeyRef begin, KeyRef end, Version readVersion) const;
+
+	// Records the write ranges of a batch committed at version, which must not be older than any previous batch
+	void addWrites(const std::vector<std::pair<StringRef, StringRef>>& ranges, Version version);
+
+	// Forgets the windows whose writes are all at or before oldestVersion
+	void removeBefore(Version oldestVersion);
+
+	// Treats every key as written at version, as clearConflictSet() does for the version history
+	void clear(Version version);
+
+	int windowCount() const { return windows.size(); }
+
+private:
+	struct Window {
+		Version minVersion = 0, maxVersion = 0;
+		std::vector<uint64_t> bits;
+		int64_t setBits = 0;
+		Arena arena;
+		std::vector<KeyRangeRef> wideRanges;
+		// Set when the window can't rule anything out, because it is too full or has too many wide ranges
+		bool coversAll = false;
+	};
+
+	const int bitsLog2;
+	const int prefixBytes;
+	const Version windowVersions;
+
+	// Oldest first.  The versions of a window are all at or after those of the windows before it.
+	std::deque<Window> windows;
+	std::vector<Window> spare;
+
+	Optional<StringRef> sharedPrefix(KeyRef begin, KeyRef end) const;
+	Window& newWindow(Version version);
+	void addRange(Window& w, KeyRef begin, KeyRef end);
+	void mergeOldestWindows();
+};
+
+#endif
@@ -78,6 +78,7 @@ struct IKVSInterface {
 	RequestStream<struct IKVSClearRequest> clear;
 	RequestStream<struct IKVSCommitRequest> commit;
 	RequestStream<struct IKVSReadValuePrefixRequest> readValuePrefix;
+	RequestStream<struct IKVSReadValuePrefixesRequest> readValuePrefixes;
 	RequestStream<struct IKVSReadRangeRequest> readRange;
 	RequestStream<struct IKVSGetStorageByteRequest> getStorageBytes;
 	RequestStream<struct IKVSGetErrorRequest> getError;
@@ -105,6 +106,7 @@ struct IKVSInterface {
 		           clear,
 		           commit,
 		           readValuePrefix,
+		           readValuePrefixes,
 		           readRange,
 		           getStorageBytes,
 		           getError,
@@ -210,6 +212,31 @@ struct IKVSReadValuePrefixRequest {
 	}
 };
 
+struct IKVSReadValuePrefixesReply {
+	constexpr static FileIdentifier file_identifier = 3817264;
+	std::vector<Optional<Value>> values;
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar, values);
+	}
+};
+
+// A batch of point reads in one round trip, see IKeyValueStore::readValuePrefixes
+struct IKVSReadValuePrefixesRequest {
+	constexpr static FileIdentifier file_identifier = 7291635;
+	VectorRef<KeyRef> keys;
+	std::vector<int> maxLengths;
+	Optional<ReadOptions> options;
+	ReplyPromise<IKVSReadValuePrefixesReply> reply;
+	Arena arena;
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar, keys, maxLengths, options, reply, arena);
+	}
+};
+
 // Use this instead of RangeResult as reply for better serialization performance
 struct IKVSReadRangeReply {
 	constexpr static FileIdentifier file_identifier = 6682449;
@@ -413,6 +440,21 @@ struct RemoteIKeyValueStore : public IKeyValueStore {
 		    IKVSReadValuePrefixRequest{ key, maxLength, options, ReplyPromise<Optional<Value>>() });
 	}
 
+	Future<std::vector<Optional<Value>>> readValuePrefixes(
+	    std::vector<std::pair<KeyRef, int>> const& keys,
+	    Optional<ReadOptions> options = Optional<ReadOptions>()) override {
+		IKVSReadValuePrefixesRequest req;
+		req.keys.reserve(req.arena, keys.size());
+		req.maxLengths.reserve(keys.size());
+		for (auto& [key, maxLength] : keys) {
+			req.keys.push_back_deep(req.arena, key);
+			req.maxLengths.push_back(maxLength);
+		}
+		req.options = options;
+		return fmap([](const IKVSReadValuePrefixesReply& reply) { return reply.values; },
+		            interf.readValuePrefixes.getReply(req));
+	}
+
 	Future<RangeResult> readRange(KeyRangeRef keys,
 	                              int rowLimit = 1 << 30,
 	                              int byteLimit = 1 << 30,
@@ -102,16 +102,24 @@ struct ServerDBInfo {
 
 struct UpdateServerDBInfoRequest {
 	constexpr static FileIdentifier file_identifier = 9467438;
+	// The serialized ServerDBInfo, or with deltaBaseID its delta from the payload with that ID
 	Standalone<StringRef> serializedDbInfo;
 	std::vector<Endpoint> broadcastInfo;
 	ReplyPromise<std::vector<Endpoint>> reply;
+	UID payloadID; // Identifies the serialized ServerDBInfo, so that later deltas can name it as their base
+	Optional<UID> deltaBaseID;
 
 	template <class Ar>
 	void serialize(Ar& ar) {
-		serializer(ar, serializedDbInfo, broadcastInfo, reply);
+		serializer(ar, serializedDbInfo, broadcastInfo, reply, payloadID, deltaBaseID);
 	}
 };
 
+// Encodes the bytes of updated that differ from base, which must be the same size, as runs of <offset, length, bytes>.
+// Returns an empty Optional if the delta wouldn't be much smaller than updated.
+Optional<Standalone<StringRef>> encodeDBInfoDelta(StringRef base, StringRef updated);
+Standalone<StringRef> applyDBInfoDelta(StringRef base, StringRef delta);
+
 struct GetServerDBInfoRequest {
 	constexpr static FileIdentifier file_identifier = 9467439;
 	UID knownServerInfoID;
@@ -47,6 +47,12 @@ const StringRef SS_DURABLE_VERSION_UPDATE_LATENCY_HISTOGRAM = "SSDurableVersionU
 const StringRef SS_READ_RANGE_BYTES_RETURNED_HISTOGRAM = "SSReadRangeBytesReturned"_sr;
 const StringRef SS_READ_RANGE_BYTES_LIMIT_HISTOGRAM = "SSReadRangeBytesLimit"_sr;
 const StringRef SS_READ_RANGE_KV_PAIRS_RETURNED_HISTOGRAM = "SSReadRangeKVPairsReturned"_sr;
+// Time reads wait for a storage server read slot, by ReadType
+const StringRef SS_READ_QUEUE_LATENCY_HISTOGRAMS[] = { "SSReadQueueLatencyEager"_sr,
+	                                                   "SSReadQueueLatencyFetch"_sr,
+	                                                   "SSReadQueueLatencyLow"_sr,
+	                                                   "SSReadQueueLatencyNormal"_sr,
+	                                                   "SSReadQueueLatencyHigh"_sr };
 
 struct StorageMetricSample {
 	IndexedSet<Key, int64_t> sample;
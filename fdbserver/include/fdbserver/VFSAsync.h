@@ -88,6 +88,14 @@ struct VFSAsyncFile {
 
 	int chunkSize;
 
+	// Sequential read detection for read ahead of the main database file
+	int64_t nextReadOffset;
+	int sequentialReads;
+	int64_t readAheadEnd;
+
+	// Warms the page cache ahead of a run of sequential page reads
+	void readAhead(int64_t offset, int length);
+
 	VFSAsyncFile(std::string const& filename, int flags);
 	~VFSAsyncFile();
 
@@ -50,6 +50,8 @@
 #include "flow/Util.h"
 #include "fdbclient/Atomic.h"
 #include "fdbclient/AuditUtils.actor.h"
+#include "fdbclient/BackupAgent.actor.h"
+#include "fdbclient/BackupContainer.h"
 #include "fdbclient/BlobConnectionProvider.h"
 #include "fdbclient/BlobGranuleReader.actor.h"
 #include "fdbclient/CommitProxyInterface.h"
@@ -59,6 +61,7 @@
 #include "fdbclient/KeyRangeMap.h"
 #include "fdbclient/NativeAPI.actor.h"
 #include "fdbclient/Notified.h"
+#include "fdbclient/RangeFilter.h"
 #include "fdbclient/StatusClient.h"
 #include "fdbclient/StorageServerShard.h"
 #include "fdbclient/SystemData.h"
@@ -66,11 +69,14 @@
 #include "fdbclient/TransactionLineage.h"
 #include "fdbclient/Tuple.h"
 #include "fdbclient/VersionedMap.h"
+#include "fdbclient/VersionedWideMap.h"
 #include "fdbrpc/sim_validation.h"
 #include "fdbrpc/Smoother.h"
 #include "fdbrpc/Stats.h"
 #include "fdbserver/FDBExecHelper.actor.h"
 #include "fdbclient/GetEncryptCipherKeys.actor.h"
+#include "fdbserver/HotKeyTracker.h"
+#include "fdbserver/HotRowCache.h"
 #include "fdbserver/IKeyValueStore.h"
 #include "fdbserver/Knobs.h"
 #include "fdbserver/LatencyBandConfig.h"
@@ -154,6 +160,7 @@ bool canReplyWith(Error e) {
 	case error_code_key_not_tuple:
 	case error_code_value_not_tuple:
 	case error_code_mapper_not_tuple:
+	case error_code_range_filter_invalid:
 		// case error_code_all_alternatives_failed:
 		return true;
 	default:
@@ -190,6 +197,8 @@ static const KeyRef persistLogProtocol = PERSIST_PREFIX "LogProtocol"_sr;
 static const KeyRef persistPrimaryLocality = PERSIST_PREFIX "PrimaryLocality"_sr;
 static const KeyRangeRef persistChangeFeedKeys = KeyRangeRef(PERSIST_PREFIX "CF/"_sr, PERSIST_PREFIX "CF0"_sr);
 static const KeyRangeRef persistTenantMapKeys = KeyRangeRef(PERSIST_PREFIX "TM/"_sr, PERSIST_PREFIX "TM0"_sr);
+// The hottest read keys, read back on restart to warm the storage engine's cache
+static const KeyRangeRef persistWarmKeys = KeyRangeRef(PERSIST_PREFIX "WK/"_sr, PERSIST_PREFIX "WK0"_sr);
 // data keys are unmangled (but never start with PERSIST_PREFIX because they are always in allKeys)
 
 static const KeyRangeRef persistStorageServerShardKeys =
@@ -201,6 +210,7 @@ static const KeyRangeRef persistCheckpointKeys =
 static const KeyRangeRef persistPendingCheckpointKeys =
     KeyRangeRef(PERSIST_PREFIX "PendingCheckpoint/"_sr, PERSIST_PREFIX "PendingCheckpoint0"_sr);
 static const std::string rocksdbCheckpointDirPrefix = "/rockscheckpoints_";
+static const std::string fetchedCheckpointDirPrefix = "/fetchedcheckpoints_";
 
 struct AddingShard : NonCopyable {
 	KeyRange keys;
@@ -371,7 +381,12 @@ public:
 };
 
 struct StorageServerDisk {
-	explicit StorageServerDisk(struct StorageServer* data, IKeyValueStore* storage) : data(data), storage(storage) {}
+	explicit StorageServerDisk(struct StorageServer* data, IKeyValueStore* storage) : data(data), storage(storage) {
+		if (SERVER_KNOBS->STORAGE_HOT_ROW_CACHE_BYTES > 0) {
+			hotRowCache = std::make_unique<HotRowCache>(SERVER_KNOBS->STORAGE_HOT_ROW_CACHE_BYTES,
+			                                            SERVER_KNOBS->STORAGE_HOT_ROW_CACHE_MAX_VALUE_BYTES);
+		}
+	}
 
 	void makeNewStorageServerDurable(const bool shardAware);
 	bool makeVersionMutationsDurable(Version& prevStorageVersion,
@@ -380,6 +395,7 @@ struct StorageServerDisk {
 	                                 UnlimitedCommitBytes unlimitedCommitBytes);
 	void makeVersionDurable(Version version);
 	void makeTssQuarantineDurable();
+	void makeWarmKeysDurable(std::vector<Key> const& keys);
 	Future<bool> restoreDurableState();
 
 	void changeLogProtocol(Version version, ProtocolVersion protocol);
@@ -390,14 +406,23 @@ struct StorageServerDisk {
 
 	Future<Void> addRange(KeyRangeRef range, std::string id) { return storage->addRange(range, id); }
 
-	std::vector<std::string> removeRange(KeyRangeRef range) { return storage->removeRange(range); }
+	std::vector<std::string> removeRange(KeyRangeRef range) {
+		if (hotRowCache)
+			hotRowCache->invalidate(range);
+		return storage->removeRange(range);
+	}
 
 	void persistRangeMapping(KeyRangeRef range, bool isAdd) { storage->persistRangeMapping(range, isAdd); }
 
 	Future<Void> getError() { return storage->getError(); }
 	Future<Void> init() { return storage->init(); }
 	Future<Void> canCommit() { return storage->canCommit(); }
-	Future<Void> commit() { return storage->commit(); }
+	Future<Void> commit() {
+		if (!hotRowCache)
+			return storage->commit();
+		uint64_t commitId = hotRowCache->beginCommit();
+		return endCacheCommit(hotRowCache.get(), commitId, storage->commit());
+	}
 
 	// SOMEDAY: Put readNextKeyInclusive in IKeyValueStore
 	// Read the key that is equal or greater then 'key' from the storage engine.
@@ -410,6 +435,18 @@ struct StorageServerDisk {
 		return readFirstKey(storage, KeyRangeRef(key, allKeys.end), options);
 	}
 	Future<Optional<Value>> readValue(KeyRef key, Optional<ReadOptions> options = Optional<ReadOptions>()) {
+		if (hotRowCache) {
+			Optional<Optional<Value>> cached = hotRowCache->get(key);
+			if (cached.present()) {
+				++(*hotRowCacheHits);
+				return cached.get();
+			}
+			++(*hotRowCacheMisses);
+			if (!options.present() || options.get().cacheResult) {
+				++(*kvGets);
+				return readValueAndFill(hotRowCache.get(), storage, key, options);
+			}
+		}
 		++(*kvGets);
 		return storage->readValue(key, options);
 	}
@@ -419,6 +456,11 @@ struct StorageServerDisk {
 		++(*kvGets);
 		return storage->readValuePrefix(key, maxLength, options);
 	}
+	Future<std::vector<Optional<Value>>> readValuePrefixes(std::vector<std::pair<KeyRef, int>> const& keys,
+	                                                       Optional<ReadOptions> options = Optional<ReadOptions>()) {
+		*kvGets += keys.size();
+		return storage->readValuePrefixes(keys, options);
+	}
 	Future<RangeResult> readRange(KeyRangeRef keys,
 	                              int rowLimit = 1 << 30,
 	                              int byteLimit = 1 << 30,
@@ -429,7 +471,23 @@ struct StorageServerDisk {
 
 	Future<CheckpointMetaData> checkpoint(const CheckpointRequest& request) { return storage->checkpoint(request); }
 
-	Future<Void> restore(const std::vector<CheckpointMetaData>& checkpoints) { return storage->restore(checkpoints); }
+	Future<Void> restore(const std::vector<CheckpointMetaData>& checkpoints) {
+		// The restored data doesn't pass through the write methods, but it is only readable after another commit,
+		// which invalidates everything again
+		if (hotRowCache)
+			hotRowCache->invalidate(allKeys);
+		return storage->restore(checkpoints);
+	}
+
+	Future<Void> restore(const std::string& shardId,
+	                     const std::vector<KeyRange>& ranges,
+	                     const std::vector<CheckpointMetaData>& checkpoints) {
+		if (hotRowCache) {
+			for (const KeyRange& range : ranges)
+				hotRowCache->invalidate(range);
+		}
+		return storage->restore(shardId, ranges, checkpoints);
+	}
 
 	Future<Void> deleteCheckpoint(const CheckpointMetaData& checkpoint) {
 		return storage->deleteCheckpoint(checkpoint);
@@ -448,12 +506,49 @@ struct StorageServerDisk {
 	Counter* kvGets;
 	Counter* kvScans;
 	Counter* kvCommits;
+	Counter* hotRowCacheHits;
+	Counter* hotRowCacheMisses;
+
+	// Null unless STORAGE_HOT_ROW_CACHE_BYTES is set
+	std::unique_ptr<HotRowCache> hotRowCache;
 
 private:
 	struct StorageServer* data;
 	IKeyValueStore* storage;
 	void writeMutations(const VectorRef<MutationRef>& mutations, Version debugVersion, const char* debugContext);
 
+	ACTOR static Future<Optional<Value>> readValueAndFill(HotRowCache* cache,
+	                                                      IKeyValueStore* storage,
+	                                                      Key key,
+	                                                      Optional<ReadOptions> options) {
+		state uint64_t token = cache->beginFill(key);
+		try {
+			Optional<Value> value = wait(storage->readValue(key, options));
+			cache->endFill(key, token, value);
+			return value;
+		} catch (Error& e) {
+			// A cancelled fill is left for eviction, since the cache may be going away with the storage server
+			if (e.code() != error_code_actor_cancelled)
+				cache->abandonFill(key, token);
+			throw;
+		}
+	}
+
+	ACTOR static Future<Void> endCacheCommit(HotRowCache* cache, uint64_t commitId, Future<Void> commit) {
+		try {
+			wait(commit);
+		} catch (Error& e) {
+			// Nothing read from storage can be trusted after a failed commit
+			if (e.code() != error_code_actor_cancelled) {
+				cache->clear();
+				cache->endCommit(commitId);
+			}
+			throw;
+		}
+		cache->endCommit(commitId);
+		return Void();
+	}
+
 	ACTOR static Future<Key> readFirstKey(IKeyValueStore* storage, KeyRangeRef range, Optional<ReadOptions> options) {
 		RangeResult r = wait(storage->readRange(range, 1, 1 << 30, options));
 		if (r.size())
@@ -582,6 +677,15 @@ struct ChangeFeedInfo : ReferenceCounted<ChangeFeedInfo> {
 
 	KeyRangeMap<std::unordered_map<UID, Promise<Void>>> moveTriggers;
 
+	// Filtered copies of recent in-memory batches, by version, so that streams reading the same version and range
+	// share one copy instead of each filtering it again. See filterMutationsShared().
+	struct SharedFilteredMutations {
+		KeyRange range;
+		bool encrypted;
+		Standalone<MutationsAndVersionRef> filtered;
+	};
+	std::map<Version, std::vector<SharedFilteredMutations>> sharedFilteredMutations;
+
 	void triggerOnMove(KeyRange range, UID streamUID, Promise<Void> p) {
 		auto toInsert = moveTriggers.modify(range);
 		for (auto triggerRange = toInsert.begin(); triggerRange != toInsert.end(); ++triggerRange) {
@@ -643,6 +747,8 @@ public:
 	Optional<TagSet> tags;
 	Optional<UID> debugID;
 	int64_t tenantId;
+	// Watch requests on this key that have not been replied to yet, with the time each arrived
+	std::deque<std::pair<WatchValueRequest, double>> waiters;
 
 	ServerWatchMetadata(Key key,
 	                    Optional<Value> value,
@@ -760,7 +866,11 @@ struct TenantSSInfo {
 };
 
 struct StorageServer : public IStorageMetricsService {
+#ifdef STORAGE_WIDE_VERSIONED_MAP
+	typedef VersionedWideMap<KeyRef, ValueOrClearToRef> VersionedData;
+#else
 	typedef VersionedMap<KeyRef, ValueOrClearToRef> VersionedData;
+#endif
 
 private:
 	// versionedData contains sets and clears.
@@ -854,6 +964,8 @@ public:
 	Reference<Histogram> readRangeBytesReturnedHistogram;
 	Reference<Histogram> readRangeBytesLimitHistogram;
 	Reference<Histogram> readRangeKVPairsReturnedHistogram;
+	// Moving average of the bytes returned by readRange, used to size the arena of the next reply
+	double readRangeArenaBytesEstimate = 0;
 
 	// watch map operations
 	Reference<ServerWatchMetadata> getWatchMetadata(KeyRef key, int64_t tenantId) const;
@@ -962,6 +1074,9 @@ public:
 	void byteSampleApplyMutation(MutationRef const& m, Version ver);
 	void byteSampleApplySet(KeyValueRef kv, Version ver);
 	void byteSampleApplyClear(KeyRangeRef range, Version ver);
+	// Applies up to limit of the byte sample updates deferred by addMutationToMutationLog(), oldest first, and returns
+	// whether any remain
+	bool applyDeferredByteSampleMutations(int limit = std::numeric_limits<int>::max());
 
 	void popVersion(Version v, bool popAllTags = false) {
 		if (logSystem && !isTss()) {
@@ -1006,9 +1121,18 @@ public:
 	}
 
 	MutationRef addMutationToMutationLog(Standalone<VerUpdateRef>& mLV, MutationRef const& m) {
-		byteSampleApplyMutation(m, mLV.version);
+		if (SERVER_KNOBS->STORAGE_DEFERRED_BYTE_SAMPLE_BATCH <= 0)
+			byteSampleApplyMutation(m, mLV.version);
 		counters.bytesInput += mvccStorageBytes(m);
-		return mLV.push_back_deep(mLV.arena(), m);
+		MutationRef logged = mLV.push_back_deep(mLV.arena(), m);
+		if (SERVER_KNOBS->STORAGE_DEFERRED_BYTE_SAMPLE_BATCH > 0) {
+			// The byte sample is updated later by byteSampleUpdater(), or by updateStorage() before it makes the
+			// version durable, so that the mutation log still holds the mutation
+			if (deferredByteSampleMutations.empty())
+				byteSampleMutationsDeferred.trigger();
+			deferredByteSampleMutations.emplace_back(mLV.version, logged);
+		}
+		return logged;
 	}
 
 	void setTssPair(UID pairId) {
@@ -1118,7 +1242,12 @@ public:
 
 	CoalescedKeyRangeMap<bool, int64_t, KeyBytesMetric<int64_t>> byteSampleClears;
 	AsyncVar<bool> byteSampleClearsTooLarge;
+	// Mutations in the mutation log that the byte sample doesn't reflect yet, oldest first
+	std::deque<std::pair<Version, MutationRef>> deferredByteSampleMutations;
+	AsyncTrigger byteSampleMutationsDeferred;
 	Future<Void> byteSampleRecovery;
+	Future<Void> warmKeysRecovery;
+	double nextWarmKeysWrite = 0;
 	Future<Void> durableInProgress;
 
 	AsyncMap<Key, bool> watches;
@@ -1146,11 +1275,32 @@ public:
 
 	Reference<PriorityMultiLock> ssLock;
 	std::vector<int> readPriorityRanks;
+	// Time spent waiting for ssLock, by ReadType
+	std::vector<Reference<Histogram>> readQueueLatencyHistograms;
+	// Total wait for ssLock of normal and high priority reads since the read weights were last adjusted
+	double foregroundReadQueueSeconds = 0;
+	int64_t foregroundReadQueueCount = 0;
+
+	void recordReadQueueLatency(int readType, double seconds) {
+		readQueueLatencyHistograms[readType]->sampleSeconds(seconds);
+		if (readType >= (int)ReadType::NORMAL) {
+			foregroundReadQueueSeconds += seconds;
+			++foregroundReadQueueCount;
+		}
+	}
 
 	Future<PriorityMultiLock::Lock> getReadLock(const Optional<ReadOptions>& options) {
 		int readType = (int)(options.present() ? options.get().type : ReadType::NORMAL);
-		readType = std::clamp<int>(readType, 0, readPriorityRanks.size() - 1);
-		return ssLock->lock(readPriorityRanks[readType]);
+		readType = std::clamp<int>(readType, 0, (int)ReadType::MAX);
+		Future<PriorityMultiLock::Lock> lock = ssLock->lock(readPriorityRanks[readType]);
+		if (lock.isReady()) {
+			recordReadQueueLatency(readType, 0);
+			return lock;
+		}
+		return map(lock, [this, readType, start = now()](PriorityMultiLock::Lock lock) {
+			recordReadQueueLatency(readType, now() - start);
+			return lock;
+		});
 	}
 
 	FlowLock serveAuditStorageParallelismLock;
@@ -1183,6 +1333,10 @@ public:
 	TransactionTagCounter transactionTagCounter;
 	BusiestWriteTagContext busiestWriteTagContext;
 
+	// The most frequently read keys, counting the first key returned by a range read, and written keys
+	HotKeyTracker hotReadKeys;
+	HotKeyTracker hotWriteKeys;
+
 	Optional<LatencyBandConfig> latencyBandConfig;
 
 	Optional<EncryptionAtRestMode> encryptionMode;
@@ -1198,6 +1352,9 @@ public:
 		Counter getMappedRangeBytesQueried, finishedGetMappedRangeSecondaryQueries, getMappedRangeQueries,
 		    finishedGetMappedRangeQueries;
 
+		// counters related to batched point reads
+		Counter getValuesQueries, getValuesKeys;
+
 		// Bytes of the mutations that have been added to the memory of the storage server. When the data is durable
 		// and cleared from the memory, we do not subtract it but add it to bytesDurable.
 		Counter bytesInput;
@@ -1239,6 +1396,7 @@ public:
 		Counter loops;
 		Counter fetchWaitingMS, fetchWaitingCount, fetchExecutingMS, fetchExecutingCount;
 		Counter readsRejected;
+		Counter readsCancelled;
 		Counter wrongShardServer;
 		Counter fetchedVersions;
 		Counter fetchesFromLogs;
@@ -1253,12 +1411,22 @@ public:
 		Counter kvGetBytes;
 		// The number of keys read from storage engine by eagerReads.
 		Counter eagerReadsKeys;
+		// The number of atomic op keys that eagerReads took from the versioned data instead of the storage engine.
+		Counter eagerReadsInMemory;
 		// The count of readValue operation to the storage engine.
 		Counter kvGets;
 		// The count of readValue operation to the storage engine.
 		Counter kvScans;
 		// The count of commit operation to the storage engine.
 		Counter kvCommits;
+		// The count of commits to the storage engine during which the next versions were written to it.
+		Counter kvCommitsPipelined;
+		// The count of readRange operations to the storage engine that were split into concurrent reads.
+		Counter parallelStorageRangeReads;
+		// The count of readValue operations answered by, or missing, the hot row cache in front of the storage engine.
+		Counter hotRowCacheHits, hotRowCacheMisses;
+		// The number of rows read for filtered range reads that didn't match the filter.
+		Counter filteredRangeRowsDiscarded;
 		// The count of change feed reads that hit disk
 		Counter changeFeedDiskReads;
 
@@ -1270,12 +1438,19 @@ public:
 		LatencySample readQueueWaitSample;
 		LatencySample kvReadRangeLatencySample;
 		LatencySample updateLatencySample;
+		LatencySample eagerReadWaitSample; // Samples how long each batch of updates waits on its eager reads
 
 		LatencyBands readLatencyBands;
 		LatencySample mappedRangeSample; // Samples getMappedRange latency
 		LatencySample mappedRangeRemoteSample; // Samples getMappedRange remote subquery latency
 		LatencySample mappedRangeLocalSample; // Samples getMappedRange local subquery latency
 
+		// Where the time of the point reads sampled for latency breakdown went (see
+		// CLIENT_KNOBS->LATENCY_BREAKDOWN_SAMPLE_RATE). Engine reads are only sampled for reads missing the MVCC data.
+		LatencySample clientQueueBreakdown;
+		LatencySample versionWaitBreakdown;
+		LatencySample engineReadBreakdown;
+
 		Counters(StorageServer* self)
 		  : cc("StorageServer", self->thisServerID.toString()), allQueries("QueryQueue", cc),
 		    systemKeyQueries("SystemKeyQueries", cc), getKeyQueries("GetKeyQueries", cc),
@@ -1300,14 +1475,20 @@ public:
 		    updateVersions("UpdateVersions", cc), loops("Loops", cc), fetchWaitingMS("FetchWaitingMS", cc),
 		    fetchWaitingCount("FetchWaitingCount", cc), fetchExecutingMS("FetchExecutingMS", cc),
 		    fetchExecutingCount("FetchExecutingCount", cc), readsRejected("ReadsRejected", cc),
-		    wrongShardServer("WrongShardServer", cc), fetchedVersions("FetchedVersions", cc),
+		    readsCancelled("ReadsCancelled", cc), wrongShardServer("WrongShardServer", cc),
+		    fetchedVersions("FetchedVersions", cc),
 		    fetchesFromLogs("FetchesFromLogs", cc), quickGetValueHit("QuickGetValueHit", cc),
 		    quickGetValueMiss("QuickGetValueMiss", cc), quickGetKeyValuesHit("QuickGetKeyValuesHit", cc),
 		    quickGetKeyValuesMiss("QuickGetKeyValuesMiss", cc), kvScanBytes("KVScanBytes", cc),
-		    kvGetBytes("KVGetBytes", cc), eagerReadsKeys("EagerReadsKeys", cc), kvGets("KVGets", cc),
-		    kvScans("KVScans", cc), kvCommits("KVCommits", cc), changeFeedDiskReads("ChangeFeedDiskReads", cc),
+		    kvGetBytes("KVGetBytes", cc), eagerReadsKeys("EagerReadsKeys", cc),
+		    eagerReadsInMemory("EagerReadsInMemory", cc), kvGets("KVGets", cc),
+		    kvScans("KVScans", cc), kvCommits("KVCommits", cc), kvCommitsPipelined("KVCommitsPipelined", cc),
+		    parallelStorageRangeReads("ParallelStorageRangeReads", cc), hotRowCacheHits("HotRowCacheHits", cc),
+		    hotRowCacheMisses("HotRowCacheMisses", cc), filteredRangeRowsDiscarded("FilteredRangeRowsDiscarded", cc),
+		    changeFeedDiskReads("ChangeFeedDiskReads", cc),
 		    getMappedRangeBytesQueried("GetMappedRangeBytesQueried", cc),
 		    finishedGetMappedRangeQueries("FinishedGetMappedRangeQueries", cc),
+		    getValuesQueries("GetValuesQueries", cc), getValuesKeys("GetValuesKeys", cc),
 		    finishedGetMappedRangeSecondaryQueries("FinishedGetMappedRangeSecondaryQueries", cc),
 		    readLatencySample("ReadLatencyMetrics",
 		                      self->thisServerID,
@@ -1351,6 +1532,22 @@ public:
 		                             SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
 		                             SERVER_KNOBS->LATENCY_SKETCH_ACCURACY),
 		    updateLatencySample("UpdateLatencyMetrics",
+		                        self->thisServerID,
+		                        SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
+		                        SERVER_KNOBS->LATENCY_SKETCH_ACCURACY),
+		    eagerReadWaitSample("EagerReadWaitMetrics",
+		                        self->thisServerID,
+		                        SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
+		                        SERVER_KNOBS->LATENCY_SKETCH_ACCURACY),
+		    clientQueueBreakdown("LatencyBreakdownClientQueue",
+		                         self->thisServerID,
+		                         SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
+		                         SERVER_KNOBS->LATENCY_SKETCH_ACCURACY),
+		    versionWaitBreakdown("LatencyBreakdownVersionWait",
+		                         self->thisServerID,
+		                         SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
+		                         SERVER_KNOBS->LATENCY_SKETCH_ACCURACY),
+		    engineReadBreakdown("LatencyBreakdownEngineRead",
 		                        self->thisServerID,
 		                        SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
 		                        SERVER_KNOBS->LATENCY_SKETCH_ACCURACY) {
@@ -1393,6 +1590,15 @@ public:
 			specialCounter(cc, "ActiveChangeFeeds", [self]() { return self->uidChangeFeed.size(); });
 			specialCounter(cc, "ActiveChangeFeedQueries", [self]() { return self->activeFeedQueries; });
 			specialCounter(cc, "ChangeFeedMemoryBytes", [self]() { return self->changeFeedMemoryBytes; });
+			specialCounter(cc, "HotRowCacheBytes", [self]() {
+				return self->storage.hotRowCache ? self->storage.hotRowCache->getBytes() : 0;
+			});
+			specialCounter(cc, "HotRowCacheEntries", [self]() {
+				return self->storage.hotRowCache ? self->storage.hotRowCache->getEntries() : 0;
+			});
+			specialCounter(cc, "HotRowCacheEvictions", [self]() {
+				return self->storage.hotRowCache ? self->storage.hotRowCache->getEvictions() : 0;
+			});
 		}
 	} counters;
 
@@ -1457,11 +1663,22 @@ public:
 	    instanceID(deterministicRandom()->randomUniqueID().first()), shuttingDown(false), behind(false),
 	    versionBehind(false), debug_inApplyUpdate(false), debug_lastValidateTime(0), lastBytesInputEBrake(0),
 	    lastDurableVersionEBrake(0), maxQueryQueue(0), transactionTagCounter(ssi.id()),
-	    busiestWriteTagContext(ssi.id()), counters(this),
+	    busiestWriteTagContext(ssi.id()),
+	    hotReadKeys(SERVER_KNOBS->HOT_KEY_TRACKER_CAPACITY,
+	                SERVER_KNOBS->HOT_KEY_SAMPLE_RATE,
+	                SERVER_KNOBS->HOT_KEY_WINDOW),
+	    hotWriteKeys(SERVER_KNOBS->HOT_KEY_TRACKER_CAPACITY,
+	                 SERVER_KNOBS->HOT_KEY_SAMPLE_RATE,
+	                 SERVER_KNOBS->HOT_KEY_WINDOW),
+	    counters(this),
 	    storageServerSourceTLogIDEventHolder(
 	        makeReference<EventCacheHolder>(ssi.id().toString() + "/StorageServerSourceTLogID")) {
 		readPriorityRanks = parseStringToVector<int>(SERVER_KNOBS->STORAGESERVER_READTYPE_PRIORITY_MAP, ',');
 		ASSERT(readPriorityRanks.size() > (int)ReadType::MAX);
+		for (int type = 0; type <= (int)ReadType::MAX; type++) {
+			readQueueLatencyHistograms.push_back(Histogram::getHistogram(
+			    STORAGESERVER_HISTOGRAM_GROUP, SS_READ_QUEUE_LATENCY_HISTOGRAMS[type], Histogram::Unit::milliseconds));
+		}
 		version.initMetric("StorageServer.Version"_sr, counters.cc.getId());
 		oldestVersion.initMetric("StorageServer.OldestVersion"_sr, counters.cc.getId());
 		durableVersion.initMetric("StorageServer.DurableVersion"_sr, counters.cc.getId());
@@ -1483,6 +1700,8 @@ public:
 		this->storage.kvGets = &counters.kvGets;
 		this->storage.kvScans = &counters.kvScans;
 		this->storage.kvCommits = &counters.kvCommits;
+		this->storage.hotRowCacheHits = &counters.hotRowCacheHits;
+		this->storage.hotRowCacheMisses = &counters.hotRowCacheMisses;
 
 		if (SERVER_KNOBS->BG_METADATA_SOURCE != "tenant") {
 			try {
@@ -2141,9 +2360,14 @@ ACTOR Future<Void> getValueQ(StorageServer* data, GetValueRequest req) {
 			                      "getValueQ.DoRead"); //.detail("TaskID", g_network->getCurrentTask());
 
 		state Optional<Value> v;
+		state bool sampleBreakdown = req.options.present() && req.options.get().clientQueueTime.present();
 		Version commitVersion = getLatestCommitVersion(req.ssLatestCommitVersions, data->tag);
 		state Version version = wait(waitForVersion(data, commitVersion, req.version, req.spanContext));
 		data->counters.readVersionWaitSample.addMeasurement(g_network->timer() - queueWaitEnd);
+		if (sampleBreakdown) {
+			data->counters.clientQueueBreakdown.addMeasurement(req.options.get().clientQueueTime.get());
+			data->counters.versionWaitBreakdown.addMeasurement(g_network->timer() - queueWaitEnd);
+		}
 
 		if (req.options.present() && req.options.get().debugID.present())
 			g_traceBatch.addEvent("GetValueDebug",
@@ -2168,7 +2392,11 @@ ACTOR Future<Void> getValueQ(StorageServer* data, GetValueRequest req) {
 			path = 1;
 		} else if (!i || !i->isClearTo() || i->getEndKey() <= req.key) {
 			path = 2;
+			state double engineReadStart = g_network->timer();
 			Optional<Value> vv = wait(data->storage.readValue(req.key, req.options));
+			if (sampleBreakdown) {
+				data->counters.engineReadBreakdown.addMeasurement(g_network->timer() - engineReadStart);
+			}
 			data->counters.kvGetBytes += vv.expectedSize();
 			// Validate that while we were reading the data we didn't lose the version or shard
 			if (version < data->storageVersion()) {
@@ -2214,6 +2442,7 @@ ACTOR Future<Void> getValueQ(StorageServer* data, GetValueRequest req) {
 			                : SERVER_KNOBS->EMPTY_READ_PENALTY;
 			data->metrics.notifyBytesReadPerKSecond(req.key, bytesReadPerKSecond);
 		}
+		data->hotReadKeys.add(req.key);
 
 		if (req.options.present() && req.options.get().debugID.present())
 			g_traceBatch.addEvent("GetValueDebug",
@@ -2252,9 +2481,145 @@ ACTOR Future<Void> getValueQ(StorageServer* data, GetValueRequest req) {
 	return Void();
 }
 
+// Serves the point reads of many keys at one version like that many getValueQ()s, but waits for the version, checks the
+// tenant and takes the read lock once.  Keys are looked up in the versioned data in one pass, and those it doesn't
+// decide are read from the storage engine concurrently.
+ACTOR Future<Void> getValuesQ(StorageServer* data, GetValuesRequest req) {
+	state int64_t resultSize = 0;
+	state int64_t keyBytes = 0;
+	Span span("SS:getValues"_loc, req.spanContext);
+
+	try {
+		++data->counters.getValuesQueries;
+		data->counters.getValuesKeys += req.keys.size();
+		++data->counters.allQueries;
+		data->maxQueryQueue = std::max<int>(
+		    data->maxQueryQueue, data->counters.allQueries.getValue() - data->counters.finishedQueries.getValue());
+
+		// Active load balancing runs at a very high priority (to obtain accurate queue lengths)
+		// so we need to downgrade here
+		wait(data->getQueryDelay());
+		state PriorityMultiLock::Lock readLock = wait(data->getReadLock(req.options));
+
+		// Track time from requestTime through now as read queueing wait time
+		state double queueWaitEnd = g_network->timer();
+		data->counters.readQueueWaitSample.addMeasurement(queueWaitEnd - req.requestTime());
+
+		if (req.options.present() && req.options.get().debugID.present())
+			g_traceBatch.addEvent("GetValueDebug", req.options.get().debugID.get().first(), "getValuesQ.DoRead");
+
+		Version commitVersion = getLatestCommitVersion(req.ssLatestCommitVersions, data->tag);
+		state Version version = wait(waitForVersion(data, commitVersion, req.version, req.spanContext));
+		data->counters.readVersionWaitSample.addMeasurement(g_network->timer() - queueWaitEnd);
+
+		data->checkTenantEntry(version, req.tenantInfo, req.options.present() ? req.options.get().lockAware : false);
+		state VectorRef<KeyRef> keys = req.keys;
+		if (req.tenantInfo.hasTenant()) {
+			keys = VectorRef<KeyRef>();
+			keys.reserve(req.arena, req.keys.size());
+			for (const KeyRef& key : req.keys)
+				keys.push_back(req.arena, key.withPrefix(req.tenantInfo.prefix.get(), req.arena));
+		}
+		state uint64_t changeCounter = data->shardChangeCounter;
+
+		for (const KeyRef& key : keys) {
+			if (key.startsWith(systemKeys.begin)) {
+				++data->counters.systemKeyQueries;
+			}
+			if (!data->shards[key]->isReadable()) {
+				throw wrong_shard_server();
+			}
+		}
+
+		state GetValuesReply reply;
+		state std::vector<Optional<ValueRef>> values(keys.size());
+		state std::vector<int> storageReads;
+		state std::vector<Future<Optional<Value>>> storageValues;
+		auto view = data->data().at(version);
+		for (int k = 0; k < keys.size(); k++) {
+			auto i = view.lastLessOrEqual(keys[k]);
+			if (i && i->isValue() && i.key() == keys[k]) {
+				values[k] = ValueRef(reply.arena, i->getValue());
+			} else if (!i || !i->isClearTo() || i->getEndKey() <= keys[k]) {
+				storageReads.push_back(k);
+				storageValues.push_back(data->storage.readValue(keys[k], req.options));
+			}
+		}
+
+		if (!storageValues.empty()) {
+			wait(waitForAll(storageValues));
+			// Validate that while we were reading the data we didn't lose the version or shard
+			if (version < data->storageVersion()) {
+				CODE_PROBE(true, "transaction_too_old after readValue in getValuesQ");
+				throw transaction_too_old();
+			}
+			for (int r = 0; r < storageReads.size(); r++) {
+				const Optional<Value>& vv = storageValues[r].get();
+				data->counters.kvGetBytes += vv.expectedSize();
+				data->checkChangeCounter(changeCounter, keys[storageReads[r]]);
+				if (vv.present())
+					values[storageReads[r]] = ValueRef(reply.arena, vv.get());
+			}
+		}
+
+		bool cached = false;
+		reply.data.reserve(reply.arena, keys.size());
+		for (int k = 0; k < keys.size(); k++) {
+			keyBytes += req.keys[k].size();
+			if (values[k].present()) {
+				++data->counters.rowsQueried;
+				resultSize += values[k].get().size();
+				reply.data.push_back(reply.arena, KeyValueRef(StringRef(reply.arena, req.keys[k]), values[k].get()));
+			} else {
+				++data->counters.emptyQueries;
+			}
+
+			if (SERVER_KNOBS->READ_SAMPLING_ENABLED) {
+				// If the read yields no value, randomly sample the empty read.
+				int64_t bytesReadPerKSecond =
+				    values[k].present()
+				        ? std::max((int64_t)(keys[k].size() + values[k].get().size()), SERVER_KNOBS->EMPTY_READ_PENALTY)
+				        : SERVER_KNOBS->EMPTY_READ_PENALTY;
+				data->metrics.notifyBytesReadPerKSecond(keys[k], bytesReadPerKSecond);
+			}
+			data->hotReadKeys.add(keys[k]);
+			cached = cached || data->cachedRangeMap[keys[k]];
+		}
+		data->counters.bytesQueried += resultSize;
+
+		if (req.options.present() && req.options.get().debugID.present())
+			g_traceBatch.addEvent("GetValueDebug", req.options.get().debugID.get().first(), "getValuesQ.AfterRead");
+
+		reply.cached = cached;
+		reply.penalty = data->getPenalty();
+		req.reply.send(reply);
+	} catch (Error& e) {
+		if (!canReplyWith(e))
+			throw;
+		data->sendErrorWithPenalty(req.reply, e, data->getPenalty());
+	}
+
+	// Key size is not included in "BytesQueried", but still contributes to cost,
+	// so it must be accounted for here.
+	data->transactionTagCounter.addRequest(req.tags, keyBytes + resultSize);
+
+	++data->counters.finishedQueries;
+
+	double duration = g_network->timer() - req.requestTime();
+	data->counters.readLatencySample.addMeasurement(duration);
+	if (data->latencyBandConfig.present()) {
+		int maxReadBytes =
+		    data->latencyBandConfig.get().readConfig.maxReadBytes.orDefault(std::numeric_limits<int>::max());
+		data->counters.readLatencyBands.addMeasurement(duration, 1, Filtered(resultSize > maxReadBytes));
+	}
+
+	return Void();
+}
+
 // Pessimistic estimate the number of overhead bytes used by each
 // watch. Watch key references are stored in an AsyncMap<Key,bool>, and actors
-// must be kept alive until the watch is finished.
+// must be kept alive until the watch is finished. Requests on the same key share
+// one set of actors, so each request only adds its queue entry.
 extern size_t WATCH_OVERHEAD_WATCHQ, WATCH_OVERHEAD_WATCHIMPL;
 
 ACTOR Future<Version> watchWaitForValueChange(StorageServer* data, SpanContext parent, KeyRef key, int64_t tenantId) {
@@ -2370,61 +2735,76 @@ ACTOR Future<Version> watchWaitForValueChange(StorageServer* data, SpanContext p
 	}
 }
 
-void checkCancelWatchImpl(StorageServer* data, WatchValueRequest req) {
-	Reference<ServerWatchMetadata> metadata = data->getWatchMetadata(req.key.contents(), req.tenantInfo.tenantId);
-	if (metadata.isValid() && metadata->versionPromise.getFutureReferenceCount() == 1) {
-		// last watch timed out so cancel watch_impl and delete key from the map
-		data->deleteWatchMetadata(req.key.contents(), req.tenantInfo.tenantId);
-		metadata->watch_impl.cancel();
+void addWatchWaiter(StorageServer* data, Reference<ServerWatchMetadata> const& metadata, WatchValueRequest const& req) {
+	++data->counters.watchQueries;
+	++data->numWatches;
+	data->watchBytes += WATCH_OVERHEAD_WATCHQ;
+	metadata->waiters.emplace_back(req, now());
+}
+
+// Drops the remaining requests of metadata and, if it is still the watch for its key, removes it from the map and
+// cancels its watch_impl
+void finishWatchWaiters(StorageServer* data, Reference<ServerWatchMetadata> const& metadata) {
+	data->numWatches -= metadata->waiters.size();
+	data->watchBytes -= metadata->waiters.size() * WATCH_OVERHEAD_WATCHQ;
+	metadata->waiters.clear();
+	if (data->getWatchMetadata(metadata->key, metadata->tenantId).getPtr() == metadata.getPtr()) {
+		data->deleteWatchMetadata(metadata->key, metadata->tenantId);
 	}
+	metadata->watch_impl.cancel();
 }
 
-ACTOR Future<Void> watchValueSendReply(StorageServer* data,
-                                       WatchValueRequest req,
-                                       Future<Version> resp,
-                                       SpanContext spanContext) {
+// Replies to every request waiting on metadata from this one actor, rather than running an actor per request, so a
+// key watched by many clients costs one actor plus a queued request per watch. Requests still time out individually.
+ACTOR Future<Void> watchValueSendReplies(StorageServer* data,
+                                         Reference<ServerWatchMetadata> metadata,
+                                         SpanContext spanContext) {
 	state Span span("SS:watchValue"_loc, spanContext);
-	state double startTime = now();
-	++data->counters.watchQueries;
-	++data->numWatches;
-	data->watchBytes += WATCH_OVERHEAD_WATCHQ;
+	state Future<Version> resp = metadata->versionPromise.getFuture();
 
 	loop {
 		double timeoutDelay = -1;
-		if (data->noRecentUpdates.get()) {
-			timeoutDelay = std::max(CLIENT_KNOBS->FAST_WATCH_TIMEOUT - (now() - startTime), 0.0);
-		} else if (!BUGGIFY) {
-			timeoutDelay = std::max(CLIENT_KNOBS->WATCH_TIMEOUT - (now() - startTime), 0.0);
+		if (data->noRecentUpdates.get() || !BUGGIFY) {
+			double timeout =
+			    data->noRecentUpdates.get() ? CLIENT_KNOBS->FAST_WATCH_TIMEOUT : CLIENT_KNOBS->WATCH_TIMEOUT;
+			// Requests are queued in arrival order, so the ones that have timed out are at the front
+			while (!metadata->waiters.empty() && now() - metadata->waiters.front().second >= timeout) {
+				data->sendErrorWithPenalty(metadata->waiters.front().first.reply, timed_out(), data->getPenalty());
+				metadata->waiters.pop_front();
+				--data->numWatches;
+				data->watchBytes -= WATCH_OVERHEAD_WATCHQ;
+			}
+			if (!metadata->waiters.empty()) {
+				timeoutDelay = metadata->waiters.front().second + timeout - now();
+			}
+		}
+		if (metadata->waiters.empty()) {
+			finishWatchWaiters(data, metadata);
+			return Void();
 		}
 
 		try {
 			choose {
 				when(Version ver = wait(resp)) {
 					// fire watch
-					req.reply.send(WatchValueReply{ ver });
-					checkCancelWatchImpl(data, req);
-					--data->numWatches;
-					data->watchBytes -= WATCH_OVERHEAD_WATCHQ;
-					return Void();
-				}
-				when(wait(timeoutDelay < 0 ? Never() : delay(timeoutDelay))) {
-					// watch timed out
-					data->sendErrorWithPenalty(req.reply, timed_out(), data->getPenalty());
-					checkCancelWatchImpl(data, req);
-					--data->numWatches;
-					data->watchBytes -= WATCH_OVERHEAD_WATCHQ;
+					for (auto& waiter : metadata->waiters) {
+						waiter.first.reply.send(WatchValueReply{ ver });
+					}
+					finishWatchWaiters(data, metadata);
 					return Void();
 				}
+				when(wait(timeoutDelay < 0 ? Never() : delay(timeoutDelay))) {}
 				when(wait(data->noRecentUpdates.onChange())) {}
 			}
 		} catch (Error& e) {
-			data->watchBytes -= WATCH_OVERHEAD_WATCHQ;
-			checkCancelWatchImpl(data, req);
-			--data->numWatches;
-
+			if (canReplyWith(e)) {
+				for (auto& waiter : metadata->waiters) {
+					data->sendErrorWithPenalty(waiter.first.reply, e, data->getPenalty());
+				}
+			}
+			finishWatchWaiters(data, metadata);
 			if (!canReplyWith(e))
 				throw e;
-			data->sendErrorWithPenalty(req.reply, e, data->getPenalty());
 			return Void();
 		}
 	}
@@ -2499,6 +2879,26 @@ ACTOR Future<Void> deleteCheckpointQ(StorageServer* self, Version version, Check
 	return Void();
 }
 
+// Deletes a checkpoint that its creator asked at version to delete. A checkpoint requested at an earlier version has
+// been created, or has failed, once version is durable.
+ACTOR Future<Void> deleteCheckpointWhenCreated(StorageServer* self, Version version, UID checkpointID) {
+	wait(self->durableVersion.whenAtLeast(version));
+
+	auto it = self->checkpoints.find(checkpointID);
+	if (it == self->checkpoints.end() || it->second.getState() != CheckpointMetaData::Complete) {
+		return Void();
+	}
+
+	it->second.setState(CheckpointMetaData::Deleting);
+	Key persistCheckpointKey(persistCheckpointKeys.begin.toString() + checkpointID.toString());
+	auto& mLV = self->addVersionToMutationLog(self->data().getLatestVersion());
+	self->addMutationToMutationLog(
+	    mLV, MutationRef(MutationRef::SetValue, persistCheckpointKey, checkpointValue(it->second)));
+	self->actors.add(deleteCheckpointQ(self, version, it->second));
+	TraceEvent("SSDeleteCheckpointRequested", self->thisServerID).detail("Checkpoint", it->second.toString());
+	return Void();
+}
+
 // Serves FetchCheckpointRequests.
 ACTOR Future<Void> fetchCheckpointQ(StorageServer* self, FetchCheckpointRequest req) {
 	TraceEvent("ServeFetchCheckpointBegin", self->thisServerID)
@@ -2785,6 +3185,52 @@ MutationsAndVersionRef filterMutations(Arena& arena,
 	return MutationsAndVersionRef(m.encrypted.get(), m.version, m.knownCommittedVersion);
 }
 
+// Like filterMutations(), but for a batch in feed's memory queue. When filtering has to copy the batch, the copy is
+// kept on the feed for the most recent versions and handed to every other stream reading the same version and range,
+// so fanning out a feed to many consumers filters and copies each batch only once.
+MutationsAndVersionRef filterMutationsShared(Arena& arena,
+                                             ChangeFeedInfo* feed,
+                                             Standalone<EncryptedMutationsAndVersionRef> const& m,
+                                             KeyRange const& range,
+                                             bool encrypted,
+                                             int commonPrefixLength) {
+	if (SERVER_KNOBS->CHANGE_FEED_SHARED_FILTER_VERSIONS <= 0) {
+		return filterMutations(arena, m, range, encrypted, commonPrefixLength);
+	}
+
+	auto& shared = feed->sharedFilteredMutations[m.version];
+	for (auto& s : shared) {
+		if (s.encrypted == encrypted && s.range == range) {
+			CODE_PROBE(true, "change feed stream reused shared filtered mutations");
+			arena.dependsOn(s.filtered.arena());
+			return s.filtered;
+		}
+	}
+
+	Standalone<MutationsAndVersionRef> filtered;
+	filtered.contents() = filterMutations(filtered.arena(), m, range, encrypted, commonPrefixLength);
+	arena.dependsOn(filtered.arena());
+
+	// Unfiltered batches already point into the feed's own memory, so there is nothing to share
+	auto sameAs = [&](VectorRef<MutationRef> const& v) {
+		return filtered.mutations.begin() == v.begin() && filtered.mutations.size() == v.size();
+	};
+	if (sameAs(m.mutations) || (m.encrypted.present() && sameAs(m.encrypted.get()))) {
+		if (shared.empty()) {
+			feed->sharedFilteredMutations.erase(m.version);
+		}
+		return filtered;
+	}
+
+	// A prefix of the batch is a slice of the feed's memory, which may be popped while shared
+	filtered.arena().dependsOn(m.arena());
+	shared.push_back({ range, encrypted, filtered });
+	while (feed->sharedFilteredMutations.size() > (size_t)SERVER_KNOBS->CHANGE_FEED_SHARED_FILTER_VERSIONS) {
+		feed->sharedFilteredMutations.erase(feed->sharedFilteredMutations.begin());
+	}
+	return filtered;
+}
+
 // set this for VERY verbose logs on change feed SS reads
 #define DEBUG_CF_TRACE false
 
@@ -2958,7 +3404,8 @@ ACTOR Future<std::pair<ChangeFeedStreamReply, bool>> getChangeFeedMutations(Stor
 
 			MutationsAndVersionRef m;
 			if (doFilterMutations) {
-				m = filterMutations(memoryReply.arena, *it, req.range, req.encrypted, commonFeedPrefixLength);
+				m = filterMutationsShared(
+				    memoryReply.arena, feedInfo.getPtr(), *it, req.range, req.encrypted, commonFeedPrefixLength);
 			} else {
 				m = MutationsAndVersionRef(req.encrypted && it->encrypted.present() ? it->encrypted.get()
 				                                                                    : it->mutations,
@@ -3609,10 +4056,10 @@ ACTOR Future<Void> changeFeedVersionUpdateQ(StorageServer* data, ChangeFeedVersi
 }
 
 #ifdef NO_INTELLISENSE
-size_t WATCH_OVERHEAD_WATCHQ =
-    sizeof(WatchValueSendReplyActorState<WatchValueSendReplyActor>) + sizeof(WatchValueSendReplyActor);
+size_t WATCH_OVERHEAD_WATCHQ = sizeof(std::pair<WatchValueRequest, double>);
 size_t WATCH_OVERHEAD_WATCHIMPL =
-    sizeof(WatchWaitForValueChangeActorState<WatchWaitForValueChangeActor>) + sizeof(WatchWaitForValueChangeActor);
+    sizeof(WatchWaitForValueChangeActorState<WatchWaitForValueChangeActor>) + sizeof(WatchWaitForValueChangeActor) +
+    sizeof(WatchValueSendRepliesActorState<WatchValueSendRepliesActor>) + sizeof(WatchValueSendRepliesActor);
 #else
 size_t WATCH_OVERHEAD_WATCHQ = 0; // only used in IDE so value is irrelevant
 size_t WATCH_OVERHEAD_WATCHIMPL = 0;
@@ -3797,6 +4244,170 @@ ACTOR Future<GetValueReqAndResultRef> quickGetValue(StorageServer* data,
 	}
 }
 
+// Returns the keys at which a storage read of keys, expected to return about bytes, should be split into pieces that
+// are read concurrently.  The keys are in ascending order, come from the byte sample, and each piece is expected to
+// hold about the same number of bytes; bytes are counted from the end of keys if reverse.  Only the last piece read
+// extends beyond the expected bytes, to the end of keys in the direction of reading.
+Standalone<VectorRef<KeyRef>> splitStorageRangeRead(const StorageMetricSample& byteSample,
+                                                    KeyRangeRef keys,
+                                                    int64_t bytes,
+                                                    int pieces,
+                                                    bool reverse) {
+	Standalone<VectorRef<KeyRef>> splits;
+	const int64_t begin = byteSample.sample.sumTo(byteSample.sample.lower_bound(keys.begin));
+	const int64_t end = byteSample.sample.sumTo(byteSample.sample.lower_bound(keys.end));
+	bytes = std::min(bytes, end - begin);
+	for (int i = 1; i < pieces; i++) {
+		int64_t offset = bytes * i / pieces;
+		auto it = byteSample.sample.index(reverse ? end - offset : begin + offset);
+		if (it == byteSample.sample.end())
+			break;
+		KeyRef split = *it;
+		if (split <= keys.begin || split >= keys.end)
+			continue;
+		if (splits.empty() || (reverse ? split < splits.back() : split > splits.back()))
+			splits.push_back_deep(splits.arena(), split);
+	}
+	if (reverse)
+		std::reverse(splits.begin(), splits.end());
+	return splits;
+}
+
+// Appends the pieces of a storage read, in the order they were read, cut at the row and byte limits of the whole read.
+// The result holds a prefix of what a single read would have returned, and may stop earlier, with more set, if a
+// piece hit its own limits.  Later pieces are not waited for once the limits are reached.  splits holds the memory of
+// the piece boundaries until then.
+ACTOR Future<RangeResult> stitchStorageRangeReads(std::vector<Future<RangeResult>> pieces,
+                                                  Standalone<VectorRef<KeyRef>> splits,
+                                                  int limit,
+                                                  int byteLimit) {
+	state RangeResult result;
+	state int rowLimit = std::abs(limit);
+	state int bytes = 0;
+	state int p = 0;
+	for (; p < pieces.size(); p++) {
+		RangeResult piece = wait(pieces[p]);
+		result.arena().dependsOn(piece.arena());
+		for (const KeyValueRef& kv : piece) {
+			if (result.size() >= rowLimit || bytes >= byteLimit) {
+				result.more = true;
+				return result;
+			}
+			result.push_back(result.arena(), kv);
+			bytes += sizeof(KeyValueRef) + kv.expectedSize();
+		}
+		// There may be rows between the end of this piece and the start of the next
+		if (piece.more) {
+			result.more = !result.empty();
+			return result;
+		}
+	}
+	return result;
+}
+
+// Reads keys from the storage engine, as one read or, for large reads from engines that serve reads on several
+// threads, as concurrent reads of consecutive pieces split at byte sample keys
+Future<RangeResult> readStorageRange(StorageServer* data,
+                                     KeyRangeRef keys,
+                                     int limit,
+                                     int byteLimit,
+                                     Optional<ReadOptions> options) {
+	const int pieces = SERVER_KNOBS->STORAGE_PARALLEL_RANGE_READS;
+	const KeyValueStoreType storeType = data->storage.getKeyValueStoreType();
+	if (pieces > 1 && std::abs(limit) > 1 && byteLimit >= SERVER_KNOBS->STORAGE_PARALLEL_RANGE_READ_MIN_BYTES &&
+	    storeType != KeyValueStoreType::MEMORY && storeType != KeyValueStoreType::MEMORY_RADIXTREE) {
+		int64_t estimate = data->metrics.byteSample.getEstimate(keys);
+		if (estimate >= SERVER_KNOBS->STORAGE_PARALLEL_RANGE_READ_MIN_BYTES) {
+			Standalone<VectorRef<KeyRef>> splits =
+			    splitStorageRangeRead(data->metrics.byteSample, keys, byteLimit, pieces, limit < 0);
+			if (!splits.empty()) {
+				std::vector<Future<RangeResult>> reads;
+				for (int i = 0; i <= splits.size(); i++) {
+					// Pieces are read and stitched in the direction of the read
+					int s = limit > 0 ? i : splits.size() - i;
+					KeyRangeRef piece(s == 0 ? keys.begin : splits[s - 1], s == splits.size() ? keys.end : splits[s]);
+					reads.push_back(data->storage.readRange(piece, limit, byteLimit, options));
+				}
+				++data->counters.parallelStorageRangeReads;
+				return stitchStorageRangeReads(reads, splits, limit, byteLimit);
+			}
+		}
+	}
+	return data->storage.readRange(keys, limit, byteLimit, options);
+}
+
+// Reads keys from kvs with the limits of IKeyValueStore::readRange()
+static RangeResult readRangeFromMap(const std::map<std::string, std::string>& kvs,
+                                    KeyRangeRef keys,
+                                    int limit,
+                                    int byteLimit) {
+	RangeResult result;
+	std::vector<KeyValueRef> rows;
+	for (auto it = kvs.lower_bound(keys.begin.toString()); it != kvs.end() && it->first < keys.end; ++it)
+		rows.push_back(KeyValueRef(StringRef(it->first), StringRef(it->second)));
+	if (limit < 0)
+		std::reverse(rows.begin(), rows.end());
+	int bytes = 0;
+	for (const KeyValueRef& kv : rows) {
+		if (result.size() >= std::abs(limit) || bytes >= byteLimit) {
+			result.more = true;
+			break;
+		}
+		result.push_back_deep(result.arena(), kv);
+		bytes += sizeof(KeyValueRef) + kv.expectedSize();
+	}
+	return result;
+}
+
+TEST_CASE("/fdbserver/storageserver/stitchStorageRangeReads") {
+	state std::map<std::string, std::string> kvs;
+	state StorageMetricSample byteSample(0);
+	state int iteration = 0;
+	for (; iteration < 500; iteration++) {
+		kvs.clear();
+		byteSample.sample.clear();
+		for (int i = deterministicRandom()->randomInt(0, 200); i > 0; i--) {
+			std::string key = deterministicRandom()->randomAlphaNumeric(deterministicRandom()->randomInt(1, 4));
+			std::string value = deterministicRandom()->randomAlphaNumeric(deterministicRandom()->randomInt(0, 40));
+			kvs[key] = value;
+			if (deterministicRandom()->coinflip())
+				byteSample.sample.insert(Key(key), key.size() + value.size());
+		}
+
+		state Key begin = Key(deterministicRandom()->randomAlphaNumeric(deterministicRandom()->randomInt(0, 3)));
+		state Key end = Key(deterministicRandom()->randomAlphaNumeric(deterministicRandom()->randomInt(0, 3)));
+		if (end < begin)
+			std::swap(begin, end);
+		state KeyRangeRef keys(begin, end);
+		state int limit = deterministicRandom()->randomInt(1, 100) * (deterministicRandom()->coinflip() ? 1 : -1);
+		state int byteLimit = deterministicRandom()->randomInt(1, 5000);
+
+		state Standalone<VectorRef<KeyRef>> splits =
+		    splitStorageRangeRead(byteSample, keys, byteLimit, deterministicRandom()->randomInt(2, 8), limit < 0);
+		for (int i = 0; i < splits.size(); i++) {
+			ASSERT(keys.begin < splits[i] && splits[i] < keys.end);
+			ASSERT(i == 0 || splits[i - 1] < splits[i]);
+		}
+
+		state std::vector<Future<RangeResult>> reads;
+		for (int i = 0; i <= splits.size(); i++) {
+			int s = limit > 0 ? i : splits.size() - i;
+			KeyRangeRef piece(s == 0 ? keys.begin : splits[s - 1], s == splits.size() ? keys.end : splits[s]);
+			reads.push_back(readRangeFromMap(kvs, piece, limit, byteLimit));
+		}
+		RangeResult stitched = wait(stitchStorageRangeReads(reads, splits, limit, byteLimit));
+
+		// The stitched rows must start the single read, and only be all of the range if more is not set
+		RangeResult all = readRangeFromMap(kvs, keys, std::numeric_limits<int>::max() * (limit > 0 ? 1 : -1), 1 << 30);
+		ASSERT(stitched.size() <= std::abs(limit));
+		ASSERT(stitched.size() <= all.size());
+		for (int i = 0; i < stitched.size(); i++)
+			ASSERT(stitched[i] == all[i]);
+		ASSERT(stitched.more ? !stitched.empty() : stitched.size() == all.size());
+	}
+	return Void();
+}
+
 // If limit>=0, it returns the first rows in the range (sorted ascending), otherwise the last rows (sorted descending).
 // readRange has O(|result|) + O(log |data|) cost
 ACTOR Future<GetKeyValuesReply> readRange(StorageServer* data,
@@ -3824,6 +4435,13 @@ ACTOR Future<GetKeyValuesReply> readRange(StorageServer* data,
 	// for remembering the position in the resultCache
 	state int pos = 0;
 
+	state int startLimitBytes = *pLimitBytes;
+
+	// Large replies otherwise grow their arena one doubling block at a time, reallocating on the way up
+	if (SERVER_KNOBS->STORAGE_READ_RANGE_ARENA_PRESIZE && data->readRangeArenaBytesEstimate >= 4096) {
+		result.arena = Arena(std::min<int64_t>(data->readRangeArenaBytesEstimate, std::max(*pLimitBytes, 0)));
+	}
+
 	// Check if the desired key-range is cached
 	auto containingRange = data->cachedRangeMap.rangeContaining(range.begin);
 	if (containingRange.value() && containingRange->range().end >= range.end) {
@@ -3882,7 +4500,7 @@ ACTOR Future<GetKeyValuesReply> readRange(StorageServer* data,
 			// Read the data on disk up to vCurrent (or the end of the range)
 			readEnd = vCurrent ? std::min(vCurrent.key(), range.end) : range.end;
 			RangeResult atStorageVersion =
-			    wait(data->storage.readRange(KeyRangeRef(readBegin, readEnd), limit, *pLimitBytes, options));
+			    wait(readStorageRange(data, KeyRangeRef(readBegin, readEnd), limit, *pLimitBytes, options));
 			logicalSize = atStorageVersion.logicalSize();
 			data->counters.kvScanBytes += logicalSize;
 			resultLogicalSize += logicalSize;
@@ -3984,7 +4602,7 @@ ACTOR Future<GetKeyValuesReply> readRange(StorageServer* data,
 			readBegin = vCurrent ? std::max(vCurrent->isClearTo() ? vCurrent->getEndKey() : vCurrent.key(), range.begin)
 			                     : range.begin;
 			RangeResult atStorageVersion =
-			    wait(data->storage.readRange(KeyRangeRef(readBegin, readEnd), limit, *pLimitBytes, options));
+			    wait(readStorageRange(data, KeyRangeRef(readBegin, readEnd), limit, *pLimitBytes, options));
 			logicalSize = atStorageVersion.logicalSize();
 			data->counters.kvScanBytes += logicalSize;
 			resultLogicalSize += logicalSize;
@@ -4040,6 +4658,7 @@ ACTOR Future<GetKeyValuesReply> readRange(StorageServer* data,
 	}
 	data->readRangeBytesReturnedHistogram->sample(resultLogicalSize);
 	data->readRangeKVPairsReturnedHistogram->sample(result.data.size());
+	data->readRangeArenaBytesEstimate += (startLimitBytes - *pLimitBytes - data->readRangeArenaBytesEstimate) / 8;
 
 	// all but the last item are less than *pLimitBytes
 	ASSERT(result.data.size() == 0 || *pLimitBytes + result.data.end()[-1].expectedSize() + sizeof(KeyValueRef) > 0);
@@ -4048,6 +4667,89 @@ ACTOR Future<GetKeyValuesReply> readRange(StorageServer* data,
 	return result;
 }
 
+// Like readRange, but returns only the rows that match filterSpec, as the filter projects them.  The limits apply to the
+// rows returned.  A read that examines STORAGE_FILTERED_RANGE_SCAN_BYTES without reaching them stops and sets
+// readThrough, which may leave the result empty.
+ACTOR Future<GetKeyValuesReply> readFilteredRange(StorageServer* data,
+                                                  Version version,
+                                                  KeyRange range,
+                                                  int limit,
+                                                  int* pLimitBytes,
+                                                  SpanContext parentSpan,
+                                                  Optional<ReadOptions> options,
+                                                  Optional<KeyRef> tenantPrefix,
+                                                  Key filterSpec,
+                                                  int64_t* pScannedBytes) {
+	state RangeFilter filter(filterSpec);
+	state GetKeyValuesReply result;
+	state KeyRange remaining = range;
+	state bool forward = limit >= 0;
+	state int64_t scannedBytes = 0;
+	state int64_t scannedRows = 0;
+	state int64_t matchedRows = 0;
+	state int scanLimitBytes;
+	state Span span("SS:readFilteredRange"_loc, parentSpan);
+
+	loop {
+		// Read about enough rows to fill the limit at the fraction of rows matched so far
+		int64_t rows = std::abs(limit) * (scannedRows + 1) / (matchedRows + 1);
+		rows = std::max<int64_t>(1, std::min<int64_t>(rows, std::numeric_limits<int>::max()));
+		scanLimitBytes = std::max<int64_t>(1, SERVER_KNOBS->STORAGE_FILTERED_RANGE_SCAN_BYTES - scannedBytes);
+		state int prevScanLimitBytes = scanLimitBytes;
+		GetKeyValuesReply r = wait(readRange(data,
+		                                     version,
+		                                     remaining,
+		                                     forward ? (int)rows : (int)-rows,
+		                                     &scanLimitBytes,
+		                                     span.context,
+		                                     options,
+		                                     tenantPrefix));
+		scannedBytes += prevScanLimitBytes - scanLimitBytes;
+		*pScannedBytes += prevScanLimitBytes - scanLimitBytes;
+		scannedRows += r.data.size();
+		result.version = r.version;
+		result.cached = r.cached;
+		result.arena.dependsOn(r.arena);
+
+		for (const KeyValueRef& kv : r.data) {
+			if (!filter.matches(kv)) {
+				++data->counters.filteredRangeRowsDiscarded;
+				continue;
+			}
+			KeyValueRef row = filter.project(result.arena, kv);
+			result.data.push_back(result.arena, row);
+			++matchedRows;
+			limit += forward ? -1 : 1;
+			*pLimitBytes -= sizeof(KeyValueRef) + row.expectedSize();
+			if (limit == 0 || *pLimitBytes <= 0) {
+				result.more = true;
+				return result;
+			}
+		}
+
+		if (!r.more) {
+			result.more = false;
+			return result;
+		}
+
+		// readRange stopped at its own limits, after at least one row
+		ASSERT(!r.data.empty());
+		KeyRef last = r.data.back().key;
+		if (scannedBytes >= SERVER_KNOBS->STORAGE_FILTERED_RANGE_SCAN_BYTES) {
+			result.more = true;
+			result.readThrough = forward ? keyAfter(last, result.arena) : last;
+			return result;
+		}
+		Key lastKey = tenantPrefix.present() ? last.withPrefix(tenantPrefix.get()) : Key(last);
+		remaining = forward ? KeyRange(KeyRangeRef(keyAfter(lastKey), remaining.end))
+		                    : KeyRange(KeyRangeRef(remaining.begin, lastKey));
+		if (remaining.empty()) {
+			result.more = false;
+			return result;
+		}
+	}
+}
+
 ACTOR Future<Key> findKey(StorageServer* data,
                           KeySelectorRef sel,
                           Version version,
@@ -4186,6 +4888,7 @@ ACTOR Future<Void> getKeyValuesQ(StorageServer* data, GetKeyValuesRequest req)
 {
 	state Span span("SS:getKeyValues"_loc, req.spanContext);
 	state int64_t resultSize = 0;
+	state int64_t scannedBytes = 0;
 
 	getCurrentLineage()->modify(&TransactionLineage::txID) = req.spanContext.traceID;
 
@@ -4302,14 +5005,24 @@ ACTOR Future<Void> getKeyValuesQ(StorageServer* data, GetKeyValuesRequest req)
 			state int remainingLimitBytes = req.limitBytes;
 
 			state double kvReadRange = g_network->timer();
-			GetKeyValuesReply _r = wait(readRange(data,
-			                                      version,
-			                                      KeyRangeRef(begin, end),
-			                                      req.limit,
-			                                      &remainingLimitBytes,
-			                                      span.context,
-			                                      req.options,
-			                                      req.tenantInfo.prefix));
+			GetKeyValuesReply _r = wait(req.filter.empty() ? readRange(data,
+			                                                           version,
+			                                                           KeyRangeRef(begin, end),
+			                                                           req.limit,
+			                                                           &remainingLimitBytes,
+			                                                           span.context,
+			                                                           req.options,
+			                                                           req.tenantInfo.prefix)
+			                                               : readFilteredRange(data,
+			                                                                   version,
+			                                                                   KeyRangeRef(begin, end),
+			                                                                   req.limit,
+			                                                                   &remainingLimitBytes,
+			                                                                   span.context,
+			                                                                   req.options,
+			                                                                   req.tenantInfo.prefix,
+			                                                                   req.filter,
+			                                                                   &scannedBytes));
 			const double duration = g_network->timer() - kvReadRange;
 			data->counters.kvReadRangeLatencySample.addMeasurement(duration);
 			GetKeyValuesReply r = _r;
@@ -4347,9 +5060,26 @@ ACTOR Future<Void> getKeyValuesQ(StorageServer* data, GetKeyValuesRequest req)
 				data->metrics.notifyBytesReadPerKSecond(
 				    addPrefix(r.data[r.data.size() - 1].key, req.tenantInfo.prefix, req.arena), bytesReadPerKSecond);
 			}
+			if (!r.data.empty()) {
+				data->hotReadKeys.add(addPrefix(r.data[0].key, req.tenantInfo.prefix, req.arena));
+			}
 
 			r.penalty = data->getPenalty();
-			req.reply.send(r);
+			if (req.digestOnly) {
+				// The rows are compared by digest, so only the digest and the reply metadata go back
+				GetKeyValuesReply digestReply;
+				digestReply.version = r.version;
+				digestReply.more = r.more;
+				digestReply.cached = r.cached;
+				digestReply.penalty = r.penalty;
+				digestReply.digest = getKeyValuesDigest(r.data);
+				if (r.readThrough.present()) {
+					digestReply.readThrough = KeyRef(digestReply.arena, r.readThrough.get());
+				}
+				req.reply.send(digestReply);
+			} else {
+				req.reply.send(r);
+			}
 
 			resultSize = req.limitBytes - remainingLimitBytes;
 			data->counters.bytesQueried += resultSize;
@@ -4364,7 +5094,8 @@ ACTOR Future<Void> getKeyValuesQ(StorageServer* data, GetKeyValuesRequest req)
 		data->sendErrorWithPenalty(req.reply, e, data->getPenalty());
 	}
 
-	data->transactionTagCounter.addRequest(req.tags, resultSize);
+	// A filtered read costs the rows it scanned, not just the few it returned
+	data->transactionTagCounter.addRequest(req.tags, std::max(resultSize, scannedBytes));
 	++data->counters.finishedQueries;
 
 	double duration = g_network->timer() - req.requestTime();
@@ -4472,30 +5203,30 @@ ACTOR Future<GetRangeReqAndResultRef> quickGetKeyValues(
 	}
 }
 
-void unpackKeyTuple(Tuple** referenceTuple, Optional<Tuple>& keyTuple, KeyValueRef* keyValue) {
-	if (!keyTuple.present()) {
-		// May throw exception if the key is not parsable as a tuple.
-		try {
-			keyTuple = Tuple::unpack(keyValue->key);
-		} catch (Error& e) {
-			TraceEvent("KeyNotTuple").error(e).detail("Key", keyValue->key.printable());
+// Returns the encoding of element idx of the tuple packed in keyOrValue, without copying or fully unpacking it
+StringRef getMappedTupleElement(StringRef keyOrValue, int idx, bool isKey) {
+	// May throw exception if the key or value is not parsable as a tuple.
+	Optional<StringRef> element;
+	try {
+		int i = 0;
+		// Scan the whole tuple, so that one that is malformed after idx is still rejected
+		for (auto e : TupleView(keyOrValue)) {
+			if (i++ == idx) {
+				element = e.raw();
+			}
+		}
+	} catch (Error& e) {
+		if (isKey) {
+			TraceEvent("KeyNotTuple").error(e).detail("Key", keyOrValue.printable());
 			throw key_not_tuple();
 		}
+		TraceEvent("ValueNotTuple").error(e).detail("Value", keyOrValue.printable());
+		throw value_not_tuple();
 	}
-	*referenceTuple = &keyTuple.get();
-}
-
-void unpackValueTuple(Tuple** referenceTuple, Optional<Tuple>& valueTuple, KeyValueRef* keyValue) {
-	if (!valueTuple.present()) {
-		// May throw exception if the value is not parsable as a tuple.
-		try {
-			valueTuple = Tuple::unpack(keyValue->value);
-		} catch (Error& e) {
-			TraceEvent("ValueNotTuple").error(e).detail("Value", keyValue->value.printable());
-			throw value_not_tuple();
-		}
+	if (!element.present()) {
+		throw mapper_bad_index();
 	}
-	*referenceTuple = &valueTuple.get();
+	return element.get();
 }
 
 bool unescapeLiterals(std::string& s, std::string before, std::string after) {
@@ -4563,9 +5294,7 @@ void preprocessMappedKey(Tuple& mappedKeyFormatTuple, std::vector<Optional<Tuple
 }
 
 Key constructMappedKey(KeyValueRef* keyValue, std::vector<Optional<Tuple>>& vec, Tuple& mappedKeyFormatTuple) {
-	// Lazily parse key and/or value to tuple because they may not need to be a tuple if not used.
-	Optional<Tuple> keyTuple;
-	Optional<Tuple> valueTuple;
+	// The key and value are only parsed as tuples if they are referenced, because they may not need to be tuples.
 	Tuple mappedKeyTuple;
 
 	mappedKeyTuple.reserve(vec.size());
@@ -4582,24 +5311,21 @@ Key constructMappedKey(KeyValueRef* keyValue, std::vector<Optional<Tuple>>& vec,
 			std::string s = mappedKeyFormatTuple.getString(i).toString();
 			auto sz = s.size();
 			int idx;
-			Tuple* referenceTuple;
 			try {
 				idx = std::stoi(s.substr(3, sz - 5));
 			} catch (std::exception& e) {
 				throw mapper_bad_index();
 			}
+			StringRef element;
 			if (s[1] == 'K') {
-				unpackKeyTuple(&referenceTuple, keyTuple, keyValue);
+				element = getMappedTupleElement(keyValue->key, idx, true);
 			} else if (s[1] == 'V') {
-				unpackValueTuple(&referenceTuple, valueTuple, keyValue);
+				element = getMappedTupleElement(keyValue->value, idx, false);
 			} else {
 				ASSERT(false);
 				throw internal_error();
 			}
-			if (idx < 0 || idx >= referenceTuple->size()) {
-				throw mapper_bad_index();
-			}
-			mappedKeyTuple.appendRaw(referenceTuple->subTupleRawString(idx));
+			mappedKeyTuple.appendRaw(element);
 		}
 	}
 
@@ -4620,6 +5346,8 @@ ACTOR Future<Void> validateRangeAgainstServer(StorageServer* data,
 	state Key originBegin = range.begin;
 	state int validatedKeys = 0;
 	state std::string error;
+	// Set when the remote's digest of the current batch differed from ours, so the batch is compared row by row
+	state bool compareRows = false;
 	loop {
 		try {
 			std::vector<Future<ErrorOr<GetKeyValuesReply>>> fs;
@@ -4632,6 +5360,7 @@ ACTOR Future<Void> validateRangeAgainstServer(StorageServer* data,
 			req.limitBytes = limitBytes;
 			req.version = version;
 			req.tags = TagSet();
+			req.digestOnly = SERVER_KNOBS->AUDIT_STORAGE_USE_DIGESTS && !compareRows;
 			fs.push_back(remoteServer.getKeyValues.getReplyUnlessFailedFor(req, 2, 0));
 
 			GetKeyValuesRequest localReq;
@@ -4666,6 +5395,28 @@ ACTOR Future<Void> validateRangeAgainstServer(StorageServer* data,
 			Key lastKey = range.begin;
 			auditState.range = range;
 
+			if (remote.digest.present()) {
+				// Both servers read the same batch at the same version, so equal digests mean equal batches and only
+				// a differing batch is read again in full to find the mismatch
+				if (remote.digest.get() != getKeyValuesDigest(local.data) || remote.more != local.more) {
+					TraceEvent(SevInfo, "ValidateRangeDigestMismatch", data->thisServerID)
+					    .detail("Range", range)
+					    .detail("RemoteServer", remoteServer.toString());
+					compareRows = true;
+					continue;
+				}
+				validatedKeys += local.data.size();
+				if (!local.more) {
+					break;
+				}
+				range = KeyRangeRef(keyAfter(local.data.back().key), range.end);
+				auditState.range = KeyRangeRef(originBegin, range.begin);
+				auditState.setPhase(AuditPhase::Complete);
+				wait(persistAuditStateMap(data->cx, auditState));
+				continue;
+			}
+			compareRows = false;
+
 			const int end = std::min(local.data.size(), remote.data.size());
 			int i = 0;
 			for (; i < end; ++i) {
@@ -5053,7 +5804,10 @@ ACTOR Future<Void> mapSubquery(StorageServer* data,
                                bool isRangeQuery,
                                KeyValueRef* it,
                                MappedKeyValueRef* kvm,
-                               Key mappedKey) {
+                               Key mappedKey,
+                               Reference<FlowLock> parallelLookups) {
+	wait(parallelLookups->take());
+	state FlowLock::Releaser releaser(*parallelLookups);
 	if (isRangeQuery) {
 		// Use the mappedKey as the prefix of the range query.
 		GetRangeReqAndResultRef getRange = wait(quickGetKeyValues(data, mappedKey, version, pArena, pOriginalReq));
@@ -5070,6 +5824,63 @@ ACTOR Future<Void> mapSubquery(StorageServer* data,
 	return Void();
 }
 
+// Looks up the mapped keys of rows that this server can read, all with one local GetValuesRequest in key order. Falls
+// back to a mapSubquery per row if the request fails, for example because a shard moved away.
+ACTOR Future<Void> mapLocalSubqueries(StorageServer* data,
+                                      Version version,
+                                      GetMappedKeyValuesRequest* pOriginalReq,
+                                      Arena* pArena,
+                                      std::vector<std::pair<Key, MappedKeyValueRef*>> lookups,
+                                      Reference<FlowLock> parallelLookups) {
+	state double start = g_network->timer();
+	std::sort(lookups.begin(), lookups.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+	try {
+		Standalone<VectorRef<KeyRef>> keys;
+		keys.reserve(keys.arena(), lookups.size());
+		for (const auto& lookup : lookups) {
+			keys.push_back(keys.arena(), lookup.first);
+			keys.arena().dependsOn(lookup.first.arena());
+		}
+		GetValuesRequest req(pOriginalReq->spanContext,
+		                     pOriginalReq->tenantInfo,
+		                     keys,
+		                     version,
+		                     pOriginalReq->tags,
+		                     pOriginalReq->options,
+		                     VersionVector());
+		// As in quickGetValue, the lookups are throttled by the original request rather than individually
+		data->actors.add(getValuesQ(data, req));
+		GetValuesReply reply = wait(req.reply.getFuture());
+		if (!reply.error.present()) {
+			pArena->dependsOn(reply.arena);
+			// The reply has the keys that have a value, in the order requested
+			int next = 0;
+			for (const auto& [key, kvm] : lookups) {
+				GetValueReqAndResultRef getValue;
+				getValue.key = key;
+				if (next < reply.data.size() && reply.data[next].key == key)
+					getValue.result = reply.data[next++].value;
+				kvm->reqAndResult = getValue;
+			}
+			data->counters.quickGetValueHit += lookups.size();
+			data->counters.mappedRangeLocalSample.addMeasurement(g_network->timer() - start);
+			return Void();
+		}
+	} catch (Error& e) {
+		if (e.code() == error_code_actor_cancelled)
+			throw;
+	}
+
+	CODE_PROBE(true, "Batched local lookups of getMappedRange fell back to single lookups");
+	state std::vector<Future<Void>> subqueries;
+	for (const auto& [key, kvm] : lookups) {
+		subqueries.push_back(mapSubquery(
+		    data, version, pOriginalReq, pArena, MATCH_INDEX_ALL, false, nullptr, kvm, key, parallelLookups));
+	}
+	wait(waitForAll(subqueries));
+	return Void();
+}
+
 int getMappedKeyValueSize(MappedKeyValueRef mappedKeyValue) {
 	auto& reqAndResult = mappedKeyValue.reqAndResult;
 	int bytes = 0;
@@ -5114,18 +5925,26 @@ ACTOR Future<GetMappedKeyValuesReply> mapKeyValues(StorageServer* data,
 	preprocessMappedKey(mappedKeyFormatTuple, vt, isRangeQuery);
 
 	state int sz = input.data.size();
-	const int k = std::min(sz, SERVER_KNOBS->MAX_PARALLEL_QUICK_GET_VALUE);
+	// Point lookups that this server can answer are batched, so more of them are worth reading at a time than there can
+	// be single lookups in flight
+	state bool batchLocal = !isRangeQuery && SERVER_KNOBS->MAPPED_RANGE_LOCAL_BATCH_ROWS > 0;
+	state int batchRows =
+	    batchLocal ? std::max(SERVER_KNOBS->MAPPED_RANGE_LOCAL_BATCH_ROWS, SERVER_KNOBS->MAX_PARALLEL_QUICK_GET_VALUE)
+	               : SERVER_KNOBS->MAX_PARALLEL_QUICK_GET_VALUE;
+	const int k = std::min(sz, batchRows);
 	state std::vector<MappedKeyValueRef> kvms(k);
+	state Reference<FlowLock> parallelLookups = makeReference<FlowLock>(SERVER_KNOBS->MAX_PARALLEL_QUICK_GET_VALUE);
 	state std::vector<Future<Void>> subqueries;
+	state std::vector<std::pair<Key, MappedKeyValueRef*>> localLookups;
 	state int offset = 0;
 	if (pOriginalReq->options.present() && pOriginalReq->options.get().debugID.present())
 		g_traceBatch.addEvent("TransactionDebug",
 		                      pOriginalReq->options.get().debugID.get().first(),
 		                      "storageserver.mapKeyValues.BeforeLoop");
 
-	for (; offset<sz&& * remainingLimitBytes> 0; offset += SERVER_KNOBS->MAX_PARALLEL_QUICK_GET_VALUE) {
-		// Divide into batches of MAX_PARALLEL_QUICK_GET_VALUE subqueries
-		for (int i = 0; i + offset < sz && i < SERVER_KNOBS->MAX_PARALLEL_QUICK_GET_VALUE; i++) {
+	for (; offset<sz&& * remainingLimitBytes> 0; offset += batchRows) {
+		// Divide into batches of batchRows rows, with at most MAX_PARALLEL_QUICK_GET_VALUE subqueries in flight
+		for (int i = 0; i + offset < sz && i < batchRows; i++) {
 			KeyValueRef* it = &input.data[i + offset];
 			MappedKeyValueRef* kvm = &kvms[i];
 			// Clear key value to the default.
@@ -5138,8 +5957,26 @@ ACTOR Future<GetMappedKeyValuesReply> mapKeyValues(StorageServer* data,
 			// std::cout << "key:" << printable(kvm->key) << ", value:" << printable(kvm->value)
 			//          << ", mappedKey:" << printable(mappedKey) << std::endl;
 
-			subqueries.push_back(mapSubquery(
-			    data, input.version, pOriginalReq, &result.arena, matchIndex, isRangeQuery, it, kvm, mappedKey));
+			// Same check as quickGetValue makes before reading locally
+			if (batchLocal && data->shards[mappedKey]->isReadable()) {
+				localLookups.emplace_back(mappedKey, kvm);
+				continue;
+			}
+			subqueries.push_back(mapSubquery(data,
+			                                 input.version,
+			                                 pOriginalReq,
+			                                 &result.arena,
+			                                 matchIndex,
+			                                 isRangeQuery,
+			                                 it,
+			                                 kvm,
+			                                 mappedKey,
+			                                 parallelLookups));
+		}
+		if (!localLookups.empty()) {
+			subqueries.push_back(mapLocalSubqueries(
+			    data, input.version, pOriginalReq, &result.arena, std::move(localLookups), parallelLookups));
+			localLookups.clear();
 		}
 		wait(waitForAll(subqueries));
 		if (pOriginalReq->options.present() && pOriginalReq->options.get().debugID.present())
@@ -5147,7 +5984,7 @@ ACTOR Future<GetMappedKeyValuesReply> mapKeyValues(StorageServer* data,
 			                      pOriginalReq->options.get().debugID.get().first(),
 			                      "storageserver.mapKeyValues.AfterBatch");
 		subqueries.clear();
-		for (int i = 0; i + offset < sz && i < SERVER_KNOBS->MAX_PARALLEL_QUICK_GET_VALUE; i++) {
+		for (int i = 0; i + offset < sz && i < batchRows; i++) {
 			// since we always read the index, so always consider the index size
 			int indexSize = sizeof(KeyValueRef) + input.data[i + offset].expectedSize();
 			int size = indexSize + getMappedKeyValueSize(kvms[i]);
@@ -5169,6 +6006,9 @@ ACTOR Future<GetMappedKeyValuesReply> mapKeyValues(StorageServer* data,
 		result.data.back().value = input.data[resultSize - 1].value;
 	}
 	result.more = input.more || resultSize < sz;
+	// A filtered read that stopped early can only resume after the rows it couldn't return if all of them were mapped
+	if (resultSize == sz)
+		result.readThrough = input.readThrough;
 	if (pOriginalReq->options.present() && pOriginalReq->options.get().debugID.present())
 		g_traceBatch.addEvent("TransactionDebug",
 		                      pOriginalReq->options.get().debugID.get().first(),
@@ -5359,6 +6199,7 @@ ACTOR Future<Void> getMappedKeyValuesQ(StorageServer* data, GetMappedKeyValuesRe
 {
 	state Span span("SS:getMappedKeyValues"_loc, req.spanContext);
 	state int64_t resultSize = 0;
+	state int64_t scannedBytes = 0;
 
 	getCurrentLineage()->modify(&TransactionLineage::txID) = req.spanContext.traceID;
 
@@ -5485,14 +6326,24 @@ ACTOR Future<Void> getMappedKeyValuesQ(StorageServer* data, GetMappedKeyValuesRe
 			// because readRange is cheap when reading additional bytes
 			state int bytesForIndex =
 			    std::min(req.limitBytes, (int)(req.limitBytes * SERVER_KNOBS->FRACTION_INDEX_BYTELIMIT_PREFETCH));
-			GetKeyValuesReply getKeyValuesReply = wait(readRange(data,
-			                                                     version,
-			                                                     KeyRangeRef(begin, end),
-			                                                     req.limit,
-			                                                     &bytesForIndex,
-			                                                     span.context,
-			                                                     req.options,
-			                                                     req.tenantInfo.prefix));
+			GetKeyValuesReply getKeyValuesReply = wait(req.filter.empty() ? readRange(data,
+			                                                                          version,
+			                                                                          KeyRangeRef(begin, end),
+			                                                                          req.limit,
+			                                                                          &bytesForIndex,
+			                                                                          span.context,
+			                                                                          req.options,
+			                                                                          req.tenantInfo.prefix)
+			                                                              : readFilteredRange(data,
+			                                                                                  version,
+			                                                                                  KeyRangeRef(begin, end),
+			                                                                                  req.limit,
+			                                                                                  &bytesForIndex,
+			                                                                                  span.context,
+			                                                                                  req.options,
+			                                                                                  req.tenantInfo.prefix,
+			                                                                                  req.filter,
+			                                                                                  &scannedBytes));
 
 			// Unlock read lock before the subqueries because each
 			// subquery will route back to getValueQ or getKeyValuesQ with a new request having the same
@@ -5541,7 +6392,8 @@ ACTOR Future<Void> getMappedKeyValuesQ(StorageServer* data, GetMappedKeyValuesRe
 		data->sendErrorWithPenalty(req.reply, e, data->getPenalty());
 	}
 
-	data->transactionTagCounter.addRequest(req.tags, resultSize);
+	// A filtered index read costs the rows it scanned. The secondary lookups are charged by their own requests.
+	data->transactionTagCounter.addRequest(req.tags, std::max(resultSize, scannedBytes));
 	++data->counters.finishedGetMappedRangeQueries;
 
 	double duration = g_network->timer() - req.requestTime();
@@ -5737,6 +6589,9 @@ ACTOR Future<Void> getKeyValuesStreamQ(StorageServer* data, GetKeyValuesStreamRe
 					data->metrics.notifyBytesReadPerKSecond(firstKey, bytesReadPerKSecond);
 					data->metrics.notifyBytesReadPerKSecond(lastKey, bytesReadPerKSecond);
 				}
+				if (!r.data.empty()) {
+					data->hotReadKeys.add(addPrefix(r.data[0].key, req.tenantInfo.prefix, req.arena));
+				}
 
 				req.reply.send(r);
 
@@ -5906,35 +6761,60 @@ void getQueuingMetrics(StorageServer* self, StorageQueuingMetricsRequest const&
 
 ACTOR Future<Void> doEagerReads(StorageServer* data, UpdateEagerReadInfo* eager) {
 	eager->finishKeyBegin();
+	state double start = now();
 	state ReadOptions options;
 	options.type = ReadType::EAGER;
+	state Future<std::vector<Key>> futureKeyEnds;
 	if (eager->enableClearRangeEagerReads) {
 		std::vector<Future<Key>> keyEnd(eager->keyBegin.size());
 		for (int i = 0; i < keyEnd.size(); i++)
 			keyEnd[i] = data->storage.readNextKeyInclusive(eager->keyBegin[i], options);
 		data->counters.eagerReadsKeys += keyEnd.size();
+		futureKeyEnds = getAll(keyEnd);
+	}
 
-		state Future<std::vector<Key>> futureKeyEnds = getAll(keyEnd);
-		state std::vector<Key> keyEndVal = wait(futureKeyEnds);
+	// Keys that the versioned data decides are resolved here rather than in the storage engine. Their values are
+	// copied now because changeDurableVersion() may erase the entries before the mutations are applied.
+	eager->value.resize(eager->keys.size());
+	state std::vector<int> engineIndexes;
+	state std::vector<std::pair<KeyRef, int>> engineKeys;
+	{
+		auto view = data->data().atLatest();
+		for (int i = 0; i < eager->keys.size(); i++) {
+			KeyRef key = eager->keys[i].first;
+			auto it = view.lastLessOrEqual(key);
+			if (it && it.key() == key && it->isValue()) {
+				eager->value[i] = Value(it->getValue());
+			} else if (!it || !it->isClearTo() || it->getEndKey() <= key) {
+				engineIndexes.push_back(i);
+				engineKeys.push_back(eager->keys[i]);
+			}
+		}
+	}
+	data->counters.eagerReadsInMemory += eager->keys.size() - engineKeys.size();
+
+	// Issue the point reads before waiting on the clear range boundaries, so the two overlap
+	state Future<std::vector<Optional<Value>>> futureValues =
+	    engineKeys.empty() ? Future<std::vector<Optional<Value>>>(std::vector<Optional<Value>>())
+	                       : data->storage.readValuePrefixes(engineKeys, options);
+
+	if (eager->enableClearRangeEagerReads) {
+		std::vector<Key> keyEndVal = wait(futureKeyEnds);
 		for (const auto& key : keyEndVal) {
 			data->counters.kvScanBytes += key.expectedSize();
 		}
 		eager->keyEnd = keyEndVal;
 	}
 
-	std::vector<Future<Optional<Value>>> value(eager->keys.size());
-	for (int i = 0; i < value.size(); i++)
-		value[i] = data->storage.readValuePrefix(eager->keys[i].first, eager->keys[i].second, options);
-
-	state Future<std::vector<Optional<Value>>> futureValues = getAll(value);
 	std::vector<Optional<Value>> optionalValues = wait(futureValues);
-	for (const auto& value : optionalValues) {
-		if (value.present()) {
-			data->counters.kvGetBytes += value.expectedSize();
+	for (int i = 0; i < optionalValues.size(); i++) {
+		if (optionalValues[i].present()) {
+			data->counters.kvGetBytes += optionalValues[i].expectedSize();
 		}
+		eager->value[engineIndexes[i]] = std::move(optionalValues[i]);
 	}
-	data->counters.eagerReadsKeys += eager->keys.size();
-	eager->value = optionalValues;
+	data->counters.eagerReadsKeys += engineKeys.size();
+	data->counters.eagerReadWaitSample.addMeasurement(now() - start);
 
 	return Void();
 }
@@ -6510,7 +7390,11 @@ public:
 	}
 };
 
-ACTOR Future<Void> tryGetRange(PromiseStream<RangeResult> results, Transaction* tr, KeyRange keys) {
+// If boundPrefetch, reads at most one block ahead of what has been taken from results
+ACTOR Future<Void> tryGetRange(PromiseStream<RangeResult> results,
+                               Transaction* tr,
+                               KeyRange keys,
+                               bool boundPrefetch = false) {
 	if (SERVER_KNOBS->FETCH_USING_STREAMING) {
 		wait(tr->getRangeStream(results, keys, GetRangeLimits(), Snapshot::True));
 		return Void();
@@ -6533,6 +7417,9 @@ ACTOR Future<Void> tryGetRange(PromiseStream<RangeResult> results, Transaction*
 				results.sendError(end_of_stream());
 				return Void();
 			}
+			if (boundPrefetch) {
+				wait(results.onEmpty());
+			}
 
 			if (rep.readThrough.present()) {
 				begin = firstGreaterOrEqual(rep.readThrough.get());
@@ -6549,6 +7436,180 @@ ACTOR Future<Void> tryGetRange(PromiseStream<RangeResult> results, Transaction*
 	}
 }
 
+// Like tryGetRange, but fetches the pieces of keys between consecutive boundaries concurrently, each from whichever
+// replica load balancing picks for it. Blocks are still delivered in key order, so that a failure leaves a contiguous
+// fetched prefix of keys, and each piece reads at most a block ahead of its turn.
+ACTOR Future<Void> tryGetRangeParallel(PromiseStream<RangeResult> results,
+                                       Transaction* tr,
+                                       KeyRange keys,
+                                       Standalone<VectorRef<KeyRef>> boundaries) {
+	ASSERT(boundaries.size() >= 2 && boundaries.front() == keys.begin && boundaries.back() == keys.end);
+	state std::vector<PromiseStream<RangeResult>> pieces(boundaries.size() - 1);
+	state std::vector<Future<Void>> fetchers;
+	state int i = 0;
+	state bool pieceDone = false;
+
+	try {
+		for (int p = 0; p < pieces.size(); p++) {
+			fetchers.push_back(tryGetRange(pieces[p], tr, KeyRangeRef(boundaries[p], boundaries[p + 1]), true));
+		}
+		for (; i < pieces.size(); i++) {
+			pieceDone = false;
+			while (!pieceDone) {
+				try {
+					RangeResult block = waitNext(pieces[i].getFuture());
+					results.send(block);
+				} catch (Error& e) {
+					if (e.code() != error_code_end_of_stream) {
+						throw;
+					}
+					pieceDone = true;
+				}
+				if (!pieceDone) {
+					wait(results.onEmpty());
+				}
+			}
+		}
+		results.sendError(end_of_stream());
+		return Void();
+	} catch (Error& e) {
+		if (e.code() == error_code_actor_cancelled) {
+			throw;
+		}
+		results.sendError(e);
+		throw;
+	}
+}
+
+// Returns at most maxPieces + 1 boundaries of pieces of keys that have roughly
+// FETCH_KEYS_PARALLEL_RANGE_BYTES each, or just keys.begin and keys.end if keys is too small to split
+ACTOR Future<Standalone<VectorRef<KeyRef>>> getFetchPieceBoundaries(Transaction* tr, KeyRange keys, int maxPieces) {
+	state Standalone<VectorRef<KeyRef>> boundaries;
+	boundaries.push_back_deep(boundaries.arena(), keys.begin);
+	if (maxPieces > 1) {
+		try {
+			Standalone<VectorRef<KeyRef>> splitPoints =
+			    wait(tr->getRangeSplitPoints(keys, SERVER_KNOBS->FETCH_KEYS_PARALLEL_RANGE_BYTES));
+			// splitPoints begins with keys.begin and ends with keys.end
+			int chunks = splitPoints.size() - 1;
+			int step = (chunks + maxPieces - 1) / maxPieces;
+			for (int p = step; p < chunks; p += step) {
+				boundaries.push_back_deep(boundaries.arena(), splitPoints[p]);
+			}
+		} catch (Error& e) {
+			if (e.code() == error_code_actor_cancelled) {
+				throw;
+			}
+			// Fetching the shard as a single piece is always correct
+			TraceEvent(SevDebug, "FetchKeysSplitPointsError").error(e);
+		}
+	}
+	boundaries.push_back_deep(boundaries.arena(), keys.end);
+	return boundaries;
+}
+
+// Moves keys in as SST files cut from checkpoints of the source replicas, which the storage engine ingests directly
+// instead of the keys going through its write path. Returns the version of the moved data.
+ACTOR Future<Version> fetchKeysFromCheckpoint(StorageServer* data, KeyRange keys, UID fetchKeysID) {
+	state Transaction tr(data->cx);
+	state Version version;
+	loop {
+		try {
+			tr.setOption(FDBTransactionOptions::PRIORITY_SYSTEM_IMMEDIATE);
+			tr.setOption(FDBTransactionOptions::LOCK_AWARE);
+			tr.setOption(FDBTransactionOptions::ACCESS_SYSTEM_KEYS);
+			wait(createCheckpoint(&tr, { keys }, DataMoveRocksCF, fetchKeysID));
+			wait(tr.commit());
+			version = tr.getCommittedVersion();
+			break;
+		} catch (Error& e) {
+			wait(tr.onError(e));
+		}
+	}
+
+	// The sources create the checkpoints once version is durable on them, or fail to if their storage engine can't
+	state std::vector<CheckpointMetaData> records = wait(getCheckpointMetaData(
+	    data->cx, { keys }, version, DataMoveRocksCF, fetchKeysID, SERVER_KNOBS->FETCH_KEYS_CHECKPOINT_TIMEOUT));
+
+	state std::string dir = data->folder + fetchedCheckpointDirPrefix + fetchKeysID.toString();
+	platform::eraseDirectoryRecursive(dir);
+	ASSERT(platform::createDirectory(dir));
+	try {
+		state std::vector<CheckpointMetaData> fetched;
+		state int i = 0;
+		for (; i < records.size(); ++i) {
+			std::vector<KeyRange> ranges;
+			for (const auto& range : records[i].ranges) {
+				if (range.intersects(keys)) {
+					ranges.push_back(range & keys);
+				}
+			}
+			CheckpointMetaData record = wait(fetchCheckpointRanges(data->cx, records[i], dir, ranges));
+			fetched.push_back(record);
+		}
+
+		// The storage engine maps a newly assigned range to its physical shard when the assignment is durable
+		state Version assigned = invalidVersion;
+		for (const auto& [ver, newShards] : data->pendingAddRanges) {
+			for (const auto& newShard : newShards) {
+				if (newShard.range.intersects(keys)) {
+					assigned = ver;
+				}
+			}
+		}
+		wait(data->durableVersion.whenAtLeast(assigned));
+
+		std::string shardId = format("%016llx", data->shards[keys.begin]->desiredShardId);
+		wait(data->storage.restore(shardId, { keys }, fetched));
+		TraceEvent(SevDebug, "FetchKeysCheckpointRestored", data->thisServerID)
+		    .detail("FKID", fetchKeysID)
+		    .detail("Keys", keys)
+		    .detail("Version", version)
+		    .detail("Checkpoints", describe(fetched));
+	} catch (Error& e) {
+		platform::eraseDirectoryRecursive(dir);
+		throw;
+	}
+	platform::eraseDirectoryRecursive(dir);
+	return version;
+}
+
+// Deletes the checkpoints a fetch asked the source replicas for, whether or not it got to use them. Marking them
+// deleting tells the sources to delete them, and the marked records are cleared in a following transaction.
+ACTOR Future<Void> deleteFetchKeysCheckpoints(Database cx, UID fetchKeysID) {
+	state Transaction tr(cx);
+	state bool marked;
+	loop {
+		try {
+			tr.setOption(FDBTransactionOptions::PRIORITY_SYSTEM_IMMEDIATE);
+			tr.setOption(FDBTransactionOptions::LOCK_AWARE);
+			tr.setOption(FDBTransactionOptions::ACCESS_SYSTEM_KEYS);
+			RangeResult checkpoints = wait(tr.getRange(prefixRange(checkpointPrefix), CLIENT_KNOBS->TOO_MANY));
+			marked = false;
+			for (const auto& kv : checkpoints) {
+				CheckpointMetaData checkpoint = decodeCheckpointValue(kv.value);
+				if (checkpoint.actionId != fetchKeysID) {
+					continue;
+				}
+				if (checkpoint.getState() == CheckpointMetaData::Deleting) {
+					tr.clear(kv.key);
+				} else {
+					checkpoint.setState(CheckpointMetaData::Deleting);
+					tr.set(kv.key, checkpointValue(checkpoint));
+					marked = true;
+				}
+			}
+			wait(tr.commit());
+			if (!marked) {
+				return Void();
+			}
+			tr.reset();
+		} catch (Error& e) {
+			wait(tr.onError(e));
+		}
+	}
+}
+
 // Read blob granules mapping from system keyspace. It keeps retrying until reaching maxRetryCount.
 ACTOR Future<Standalone<VectorRef<BlobGranuleChunkRef>>> tryReadBlobGranules(Transaction* tr,
                                                                              KeyRange keys,
@@ -6621,6 +7682,91 @@ ACTOR Future<Void> tryGetRangeFromBlob(PromiseStream<RangeResult> results,
 	return Void();
 }
 
+// The bulk load state of keys at the transaction's read version, if all of keys is bulk loaded from the same files
+ACTOR Future<Optional<BulkLoadState>> getBulkLoadState(Transaction* tr, KeyRange keys) {
+	RangeResult ranges = wait(krmGetRanges(tr, bulkLoadPrefix, keys));
+	if (ranges.size() == 2 && !ranges[0].value.empty()) {
+		return decodeBulkLoadState(ranges[0].value);
+	}
+	for (int i = 0; i + 1 < ranges.size(); i++) {
+		if (!ranges[i].value.empty()) {
+			// Data distribution assigns shards, not bulk loaded ranges, so this can only happen if a shard straddles
+			// the boundary of a bulk loaded range
+			TraceEvent(SevWarnAlways, "FetchKeysPartiallyBulkLoaded").detail("Keys", keys);
+			break;
+		}
+	}
+	return Optional<BulkLoadState>();
+}
+
+// Reads the rows of keys from the sorted range files of a bulk load
+ACTOR Future<Void> tryGetRangeFromFiles(PromiseStream<RangeResult> results,
+                                        Database cx,
+                                        KeyRange keys,
+                                        BulkLoadState bulkLoadState) {
+	state Key lastKey;
+	state bool sentRows = false;
+	try {
+		state Reference<IBackupContainer> container =
+		    IBackupContainer::openContainer(bulkLoadState.containerUrl, {}, {});
+		state int i = 0;
+		for (; i < bulkLoadState.files.size(); i++) {
+			state BulkLoadFile file = bulkLoadState.files[i];
+			state Reference<IAsyncFile> inFile = wait(container->readFile(file.fileName));
+			state int64_t offset = 0;
+			for (; offset < file.fileSize; offset += file.blockSize) {
+				Standalone<VectorRef<KeyValueRef>> block = wait(fileBackup::decodeRangeFileBlock(
+				    inFile, offset, std::min<int64_t>(file.blockSize, file.fileSize - offset), cx));
+				// The first and last pairs of a block are the bounds of its range rather than data
+				if (block.size() < 2 || block.back().key <= keys.begin) {
+					continue;
+				}
+				if (block.front().key >= keys.end) {
+					break;
+				}
+				RangeResult rows;
+				for (int k = 1; k + 1 < block.size(); k++) {
+					KeyValueRef kv = block[k];
+					if (!keys.contains(kv.key)) {
+						continue;
+					}
+					if (sentRows && kv.key <= lastKey) {
+						TraceEvent(SevError, "BulkLoadFileOutOfOrder")
+						    .detail("File", file.fileName)
+						    .detail("Key", kv.key)
+						    .detail("PreviousKey", lastKey);
+						throw restore_corrupted_data();
+					}
+					rows.push_back_deep(rows.arena(), kv);
+					lastKey = kv.key;
+					sentRows = true;
+				}
+				if (rows.size()) {
+					results.send(rows);
+				}
+			}
+		}
+		results.sendError(end_of_stream());
+	} catch (Error& e) {
+		if (e.code() == error_code_actor_cancelled) {
+			throw;
+		}
+		TraceEvent(SevWarn, "ReadBulkLoadFilesFailure")
+		    .errorUnsuppressed(e)
+		    .suppressFor(5.0)
+		    .detail("Keys", keys)
+		    .detail("Container", bulkLoadState.containerUrl);
+		// Failures to reach the container are retried like failures to reach a source server
+		if (e.code() == error_code_http_request_failed || e.code() == error_code_connection_failed ||
+		    e.code() == error_code_timed_out || e.code() == error_code_lookup_failed) {
+			results.sendError(connection_failed());
+		} else {
+			results.sendError(e);
+		}
+	}
+	return Void();
+}
+
 // We have to store the version the change feed was stopped at in the SS instead of just the stopped status
 // In addition to simplifying stopping logic, it enables communicating stopped status when fetching change feeds
 // from other SS correctly
@@ -7431,6 +8577,8 @@ ACTOR Future<Void> fetchKeys(StorageServer* data, AddingShard* shard) {
 
 		wait(data->fetchKeysParallelismLock.take(TaskPriority::DefaultYield));
 		state FlowLock::Releaser holdingFKPL(data->fetchKeysParallelismLock);
+		// Permits taken beyond our own to fetch pieces of the shard concurrently
+		state FlowLock::Releaser holdingExtraFKPL;
 
 		state double executeStart = now();
 		++data->counters.fetchWaitingCount;
@@ -7465,7 +8613,56 @@ ACTOR Future<Void> fetchKeys(StorageServer* data, AddingShard* shard) {
 		// we must refresh the cache manually.
 		data->cx->invalidateCache(Key(), keys);
 
-		loop {
+		// Sharded RocksDB can ingest the shard as SST files, if the sources can cut them from checkpoints of their own
+		// RocksDB stores. Otherwise the keys are read and written one by one.
+		state bool fetchedFromCheckpoint = false;
+		if (SERVER_KNOBS->FETCH_KEYS_USE_CHECKPOINT && !isFullRestore && data->shardAware &&
+		    data->storage.getKeyValueStoreType() == KeyValueStoreType::SSD_SHARDED_ROCKSDB) {
+			try {
+				Version checkpointVersion = wait(fetchKeysFromCheckpoint(data, keys, fetchKeysID));
+				ASSERT(checkpointVersion >= shard->fetchVersion);
+				fetchVersion = checkpointVersion;
+				shard->fetchVersion = fetchVersion;
+				while (!shard->updates.empty() && shard->updates[0].version <= fetchVersion)
+					shard->updates.pop_front();
+				fetchedFromCheckpoint = true;
+			} catch (Error& e) {
+				if (e.code() == error_code_actor_cancelled) {
+					throw;
+				}
+				TraceEvent(SevInfo, "FetchKeysCheckpointFallback", data->thisServerID)
+				    .errorUnsuppressed(e)
+				    .detail("FKID", interval.pairID);
+				// Nothing may have been ingested, but make sure the logical fetch starts from an empty range
+				data->storage.clearRange(keys);
+			}
+			data->actors.add(deleteFetchKeysCheckpoints(data->cx, fetchKeysID));
+		}
+
+		if (fetchedFromCheckpoint) {
+			// The ingested keys bypassed the byte sample too
+			state RangeResult sampled;
+			state Key sampleBegin = keys.begin;
+			loop {
+				wait(store(sampled,
+				           data->storage.readRange(KeyRangeRef(sampleBegin, keys.end),
+				                                   1 << 30,
+				                                   SERVER_KNOBS->FETCH_BLOCK_BYTES,
+				                                   readOptions)));
+				data->applyDeferredByteSampleMutations();
+				for (const auto& kv : sampled) {
+					data->byteSampleApplySet(kv, invalidVersion);
+				}
+				metricReporter.addFetchedBytes(sampled.expectedSize(), sampled.size());
+				if (!sampled.more || sampled.empty()) {
+					break;
+				}
+				sampleBegin = keyAfter(sampled.back().key);
+				wait(yield(TaskPriority::FetchKeys));
+			}
+		}
+
+		while (!fetchedFromCheckpoint) {
 			state Transaction tr(data->cx);
 			tr.setOption(FDBTransactionOptions::PRIORITY_SYSTEM_IMMEDIATE);
 			tr.setOption(FDBTransactionOptions::LOCK_AWARE);
@@ -7522,7 +8719,17 @@ ACTOR Future<Void> fetchKeys(StorageServer* data, AddingShard* shard) {
 
 			state PromiseStream<RangeResult> results;
 			state Future<Void> hold;
-			if (isFullRestore) {
+			state Optional<BulkLoadState> bulkLoad;
+			if (!isFullRestore) {
+				Optional<BulkLoadState> _bulkLoad = wait(getBulkLoadState(&tr, keys));
+				bulkLoad = _bulkLoad;
+			}
+			if (bulkLoad.present()) {
+				TraceEvent(SevDebug, "FetchKeysFromBulkLoad", data->thisServerID)
+				    .detail("FKID", interval.pairID)
+				    .detail("State", bulkLoad.get().toString());
+				hold = tryGetRangeFromFiles(results, data->cx, keys, bulkLoad.get());
+			} else if (isFullRestore) {
 				state std::pair<KeyRange, BlobRestoreStatus> rangeStatus = wait(getRestoreRangeStatus(data->cx, keys));
 				// Read from blob only when it's copying data for full restore. Otherwise it may cause data corruptions
 				// e.g we don't want to copy from blob any more when it's applying mutation logs(APPLYING_MLOGS)
@@ -7533,6 +8740,28 @@ ACTOR Future<Void> fetchKeys(StorageServer* data, AddingShard* shard) {
 				} else {
 					hold = tryGetRange(results, &tr, keys);
 				}
+			} else if (!SERVER_KNOBS->FETCH_USING_STREAMING && SERVER_KNOBS->FETCH_KEYS_PARALLEL_RANGES > 1) {
+				// Streaming reads already split the range. Otherwise spend whatever of the fetch parallelism budget
+				// other fetches aren't waiting for on fetching pieces of this shard concurrently.
+				holdingExtraFKPL.release();
+				state int pieces = 1;
+				if (!data->fetchKeysParallelismLock.waiters()) {
+					pieces += std::max<int64_t>(0,
+					                            std::min<int64_t>(SERVER_KNOBS->FETCH_KEYS_PARALLEL_RANGES - 1,
+					                                              data->fetchKeysParallelismLock.available()));
+				}
+				state Standalone<VectorRef<KeyRef>> boundaries = wait(getFetchPieceBoundaries(&tr, keys, pieces));
+				pieces = boundaries.size() - 1;
+				if (pieces > 1 && pieces - 1 <= data->fetchKeysParallelismLock.available()) {
+					wait(data->fetchKeysParallelismLock.take(TaskPriority::DefaultYield, pieces - 1));
+					holdingExtraFKPL = FlowLock::Releaser(data->fetchKeysParallelismLock, pieces - 1);
+					hold = tryGetRangeParallel(results, &tr, keys, boundaries);
+				} else {
+					hold = tryGetRange(results, &tr, keys);
+				}
+				TraceEvent(SevDebug, "FetchKeysPieces", data->thisServerID)
+				    .detail("FKID", interval.pairID)
+				    .detail("Pieces", holdingExtraFKPL.remaining + 1);
 			} else {
 				hold = tryGetRange(results, &tr, keys);
 			}
@@ -7574,6 +8803,8 @@ ACTOR Future<Void> fetchKeys(StorageServer* data, AddingShard* shard) {
 					// Write this_block to storage
 					state int sinceYield = 0;
 					state KeyValueRef* kvItr = this_block.begin();
+					// Keep the byte sample updates in version order
+					data->applyDeferredByteSampleMutations();
 					for (; kvItr != this_block.end(); ++kvItr) {
 						data->storage.writeKeyValue(*kvItr);
 						data->byteSampleApplySet(*kvItr, invalidVersion);
@@ -7695,6 +8926,7 @@ ACTOR Future<Void> fetchKeys(StorageServer* data, AddingShard* shard) {
 		state Future<Void> fetchDurable = data->durableVersion.whenAtLeast(data->storageVersion() + 1);
 		state Future<Void> dataArrive = data->version.whenAtLeast(fetchVersion);
 
+		holdingExtraFKPL.release();
 		holdingFKPL.release();
 		wait(dataArrive && fetchDurable);
 
@@ -7871,6 +9103,7 @@ ACTOR Future<Void> fetchKeys(StorageServer* data, AddingShard* shard) {
 			if (shard->phase < AddingShard::FetchingCF) {
 				data->storage.clearRange(keys);
 				++data->counters.kvSystemClearRanges;
+				data->applyDeferredByteSampleMutations();
 				data->byteSampleApplyClear(keys, invalidVersion);
 			} else {
 				ASSERT(data->data().getLatestVersion() > data->version.get());
@@ -9020,8 +10253,12 @@ private:
 	// Registers a pending checkpoint request, it will be fullfilled when the desired version is durable.
 	void registerPendingCheckpoint(StorageServer* data, const MutationRef& m, Version ver) {
 		CheckpointMetaData checkpoint = decodeCheckpointValue(m.param2);
-		ASSERT(checkpoint.getState() == CheckpointMetaData::Pending);
 		const UID checkpointID = decodeCheckpointKey(m.param1.substr(1));
+		if (checkpoint.getState() == CheckpointMetaData::Deleting) {
+			data->actors.add(deleteCheckpointWhenCreated(data, ver, checkpointID));
+			return;
+		}
+		ASSERT(checkpoint.getState() == CheckpointMetaData::Pending);
 		checkpoint.version = ver;
 		data->pendingCheckpoints[ver].push_back(checkpoint);
 
@@ -9208,6 +10445,9 @@ ACTOR Future<Void> update(StorageServer* data, bool* pReceivedUpdate) {
 		state Reference<ILogSystem::IPeekCursor> cloneCursor2 = cursor->cloneNoMore();
 		state Optional<std::unordered_map<BlobCipherDetails, Reference<BlobCipherKey>>> cipherKeys;
 		state bool collectingCipherKeys = false;
+		// The encrypted mutations of cloneCursor2, in order, as decrypted while collecting eager reads, so that they
+		// are not decrypted a second time when they are applied
+		state std::vector<MutationRef> decryptedMutations;
 
 		// Collect eager read keys.
 		// If encrypted mutation is encountered, we collect cipher details and fetch cipher keys, then start over.
@@ -9258,6 +10498,7 @@ ACTOR Future<Void> update(StorageServer* data, bool* pReceivedUpdate) {
 							collectingCipherKeys = true;
 						} else {
 							msg = msg.decrypt(cipherKeys.get(), eager.arena, BlobCipherMetrics::TLOG);
+							decryptedMutations.push_back(msg);
 						}
 					}
 					// TraceEvent(SevDebug, "SSReadingLog", data->thisServerID).detail("Mutation", msg);
@@ -9284,6 +10525,7 @@ ACTOR Future<Void> update(StorageServer* data, bool* pReceivedUpdate) {
 				cipherKeys = getCipherKeysResult;
 				collectingCipherKeys = false;
 				eager = UpdateEagerReadInfo(enableClearRangeEagerReads);
+				decryptedMutations.clear();
 			} else {
 				// Any fetchKeys which are ready to transition their shards to the adding,transferred state do so now.
 				// If there is an epoch end we skip this step, to increase testability and to prevent inserting a
@@ -9308,6 +10550,7 @@ ACTOR Future<Void> update(StorageServer* data, bool* pReceivedUpdate) {
 				// SOMEDAY: Theoretically we could check the change counters of individual shards and retry the reads
 				// only selectively
 				eager = UpdateEagerReadInfo(enableClearRangeEagerReads);
+				decryptedMutations.clear();
 				cloneCursor2 = cursor->cloneNoMore();
 			}
 		}
@@ -9355,6 +10598,7 @@ ACTOR Future<Void> update(StorageServer* data, bool* pReceivedUpdate) {
 		state SpanContext spanContext = SpanContext();
 		state double beforeTLogMsgsUpdates = now();
 		state std::set<Key> updatedChangeFeeds;
+		state int decryptedIndex = 0;
 		for (; cloneCursor2->hasMessage(); cloneCursor2->nextMessage()) {
 			if (mutationBytes > SERVER_KNOBS->DESIRED_UPDATE_BYTES) {
 				mutationBytes = 0;
@@ -9417,7 +10661,8 @@ ACTOR Future<Void> update(StorageServer* data, bool* pReceivedUpdate) {
 					ASSERT(cipherKeys.present());
 					encryptedMutation.mutation = msg;
 					encryptedMutation.cipherKeys = msg.getCipherKeys(cipherKeys.get());
-					msg = msg.decrypt(encryptedMutation.cipherKeys, rd.arena(), BlobCipherMetrics::TLOG);
+					ASSERT(decryptedIndex < decryptedMutations.size());
+					msg = decryptedMutations[decryptedIndex++];
 				}
 
 				Span span("SS:update"_loc, spanContext);
@@ -9449,6 +10694,10 @@ ACTOR Future<Void> update(StorageServer* data, bool* pReceivedUpdate) {
 					}
 
 					updater.applyMutation(data, msg, encryptedMutation, ver, false);
+					if (!msg.param1.startsWith("\xff\xff"_sr)) {
+						// Not a private mutation
+						data->hotWriteKeys.add(msg.param1);
+					}
 					mutationBytes += msg.totalSize();
 					data->counters.mutationBytes += msg.totalSize();
 					data->counters.logicalBytesInput += msg.expectedSize();
@@ -9659,13 +10908,49 @@ ACTOR Future<Void> createCheckpoint(StorageServer* data, CheckpointMetaData meta
 	return Void();
 }
 
+// Writes the mutations of the versions after *storageVersion up to desiredVersion from the mutation log to the storage
+// engine, until bytesLeft is used up, and forgets those versions from the in-memory data.
+ACTOR Future<Void> writeVersionMutations(StorageServer* data,
+                                         Version* storageVersion,
+                                         Version desiredVersion,
+                                         int64_t* bytesLeft,
+                                         UnlimitedCommitBytes unlimitedCommitBytes) {
+	loop {
+		state bool done = data->storage.makeVersionMutationsDurable(
+		    *storageVersion, desiredVersion, *bytesLeft, unlimitedCommitBytes);
+		if (data->tenantMap.getLatestVersion() < *storageVersion) {
+			data->tenantMap.createNewVersion(*storageVersion);
+		}
+		// We want to forget things from these data structures atomically with changing oldestVersion (and "before",
+		// since oldestVersion.set() may trigger waiting actors) forgetVersionsBeforeAsync visibly forgets
+		// immediately (without waiting) but asynchronously frees memory.
+		Future<Void> finishedForgetting =
+		    data->mutableData().forgetVersionsBeforeAsync(*storageVersion, TaskPriority::UpdateStorage) &&
+		    data->tenantMap.forgetVersionsBeforeAsync(*storageVersion, TaskPriority::UpdateStorage);
+		data->oldestVersion.set(*storageVersion);
+		wait(finishedForgetting);
+		wait(yield(TaskPriority::UpdateStorage));
+		if (done)
+			return Void();
+	}
+}
+
 ACTOR Future<Void> updateStorage(StorageServer* data) {
 	state UnlimitedCommitBytes unlimitedCommitBytes = UnlimitedCommitBytes::False;
 	state Future<Void> durableDelay = Void();
+	// Engines whose commit() takes the writes made before it, so that writes made while a commit is in progress go
+	// into the next one, can have the next versions written while the previous ones are being made durable.
+	state bool pipelineCommits = SERVER_KNOBS->STORAGE_PIPELINE_COMMITS &&
+	                             (data->storage.getKeyValueStoreType() == KeyValueStoreType::SSD_REDWOOD_V1 ||
+	                              data->storage.getKeyValueStoreType() == KeyValueStoreType::SSD_ROCKSDB_V1);
+	// Bytes of the versions written to the engine while the last commit was in progress
+	state int64_t pipelinedBytes = 0;
 
 	loop {
 		unlimitedCommitBytes = UnlimitedCommitBytes::False;
-		ASSERT(data->durableVersion.get() == data->storageVersion());
+		// The versions after the durable version may already have been written while the last commit was in progress
+		ASSERT(data->durableVersion.get() <= data->storageVersion());
+		ASSERT(pipelineCommits || data->durableVersion.get() == data->storageVersion());
 		if (g_network->isSimulated()) {
 			double endTime =
 			    g_simulator->checkDisabled(format("%s/updateStorage", data->thisServerID.toString().c_str()));
@@ -9676,8 +10961,8 @@ ACTOR Future<Void> updateStorage(StorageServer* data) {
 
 		// If the fetch keys budget is not used up then we have already waited for the storage commit delay so
 		// wait for either a new mutation version or the budget to be used up.
-		// Otherwise, don't wait at all.
-		if (!data->fetchKeysBudgetUsed.get()) {
+		// Otherwise, don't wait at all. Versions that were already written are committed without waiting.
+		if (!data->fetchKeysBudgetUsed.get() && data->durableVersion.get() == data->storageVersion()) {
 			wait(data->desiredOldestVersion.whenAtLeast(data->storageVersion() + 1) ||
 			     data->fetchKeysBudgetUsed.onChange());
 		}
@@ -9691,10 +10976,15 @@ ACTOR Future<Void> updateStorage(StorageServer* data) {
 		state Promise<Void> durableInProgress;
 		data->durableInProgress = durableInProgress.getFuture();
 
-		state Version startOldestVersion = data->storageVersion();
+		// The byte sample updates for the versions about to be made durable go in their mutation log entries. Mutations
+		// deferred after this are at versions newer than desiredOldestVersion.
+		data->applyDeferredByteSampleMutations();
+
+		state Version startOldestVersion = data->durableVersion.get();
 		state Version newOldestVersion = data->storageVersion();
 		state Version desiredVersion = data->desiredOldestVersion.get();
-		state int64_t bytesLeft = SERVER_KNOBS->STORAGE_COMMIT_BYTES;
+		state int64_t bytesLeft = SERVER_KNOBS->STORAGE_COMMIT_BYTES - pipelinedBytes;
+		pipelinedBytes = 0;
 
 		// Clean up stale checkpoint requests, this is not supposed to happen, since checkpoints are cleaned up on
 		// failures. This is kept as a safeguard.
@@ -9769,26 +11059,13 @@ ACTOR Future<Void> updateStorage(StorageServer* data) {
 			}
 		}
 
+		// Versions written while the last commit was in progress come before any pending checkpoint or range change,
+		// since those arrive at versions newer than desiredOldestVersion was then.
+		ASSERT(newOldestVersion <= desiredVersion);
+
 		// Write mutations to storage until we reach the desiredVersion or have written too much (bytesleft)
 		state double beforeStorageUpdates = now();
-		loop {
-			state bool done = data->storage.makeVersionMutationsDurable(
-			    newOldestVersion, desiredVersion, bytesLeft, unlimitedCommitBytes);
-			if (data->tenantMap.getLatestVersion() < newOldestVersion) {
-				data->tenantMap.createNewVersion(newOldestVersion);
-			}
-			// We want to forget things from these data structures atomically with changing oldestVersion (and "before",
-			// since oldestVersion.set() may trigger waiting actors) forgetVersionsBeforeAsync visibly forgets
-			// immediately (without waiting) but asynchronously frees memory.
-			Future<Void> finishedForgetting =
-			    data->mutableData().forgetVersionsBeforeAsync(newOldestVersion, TaskPriority::UpdateStorage) &&
-			    data->tenantMap.forgetVersionsBeforeAsync(newOldestVersion, TaskPriority::UpdateStorage);
-			data->oldestVersion.set(newOldestVersion);
-			wait(finishedForgetting);
-			wait(yield(TaskPriority::UpdateStorage));
-			if (done)
-				break;
-		}
+		wait(writeVersionMutations(data, &newOldestVersion, desiredVersion, &bytesLeft, unlimitedCommitBytes));
 
 		// Allow data fetch to use an additional bytesLeft but don't penalize fetch budget if bytesLeft is negative
 		if (bytesLeft > 0) {
@@ -9890,6 +11167,20 @@ ACTOR Future<Void> updateStorage(StorageServer* data) {
 			curFeed++;
 		}
 
+		if (SERVER_KNOBS->STORAGE_WARM_KEYS > 0 && now() >= data->nextWarmKeysWrite) {
+			std::vector<std::pair<Key, double>> hot = data->hotReadKeys.getHotKeys(allKeys);
+			// Until keys are sampled after a restart, keep the ones persisted before it
+			if (!hot.empty()) {
+				std::sort(hot.begin(), hot.end(), [](auto const& a, auto const& b) { return a.second > b.second; });
+				std::vector<Key> warmKeys;
+				for (int i = 0; i < std::min<int>(hot.size(), SERVER_KNOBS->STORAGE_WARM_KEYS); i++) {
+					warmKeys.push_back(hot[i].first);
+				}
+				data->storage.makeWarmKeysDurable(warmKeys);
+			}
+			data->nextWarmKeysWrite = now() + SERVER_KNOBS->STORAGE_WARM_KEYS_INTERVAL;
+		}
+
 		// Set the new durable version as part of the outstanding change set, before commit
 		if (startOldestVersion != newOldestVersion)
 			data->storage.makeVersionDurable(newOldestVersion);
@@ -9905,7 +11196,24 @@ ACTOR Future<Void> updateStorage(StorageServer* data) {
 		durableDelay =
 		    (bytesLeft > 0) ? delay(SERVER_KNOBS->STORAGE_COMMIT_INTERVAL, TaskPriority::UpdateStorage) : Void();
 
-		wait(ioTimeoutError(durable, SERVER_KNOBS->MAX_STORAGE_COMMIT_TIME, "StorageCommit"));
+		state Future<Void> committed = ioTimeoutError(durable, SERVER_KNOBS->MAX_STORAGE_COMMIT_TIME, "StorageCommit");
+		// Write the next versions while this commit is in progress, unless this commit is followed by work that must
+		// see the engine exactly at newOldestVersion.
+		if (pipelineCommits && !requireCheckpoint && !removeKVSRanges && !addedRanges &&
+		    data->pendingCheckpoints.empty() && data->pendingRemoveRanges.empty() && data->pendingAddRanges.empty() &&
+		    data->desiredOldestVersion.get() > newOldestVersion) {
+			data->applyDeferredByteSampleMutations();
+			state Version pipelinedVersion = newOldestVersion;
+			state int64_t pipelineBytesLeft = SERVER_KNOBS->STORAGE_COMMIT_BYTES;
+			wait(writeVersionMutations(data,
+			                           &pipelinedVersion,
+			                           data->desiredOldestVersion.get(),
+			                           &pipelineBytesLeft,
+			                           UnlimitedCommitBytes::False));
+			pipelinedBytes = SERVER_KNOBS->STORAGE_COMMIT_BYTES - pipelineBytesLeft;
+			++data->counters.kvCommitsPipelined;
+		}
+		wait(committed);
 		data->storageCommitLatencyHistogram->sampleSeconds(now() - beforeStorageCommit);
 
 		debug_advanceMinCommittedVersion(data->thisServerID, data->storageMinRecoverVersion);
@@ -10197,6 +11505,8 @@ void setAssignedStatus(StorageServer* self, KeyRangeRef keys, bool nowAssigned)
 }
 
 void StorageServerDisk::clearRange(KeyRangeRef keys) {
+	if (hotRowCache)
+		hotRowCache->invalidate(keys);
 	storage->clear(keys, &data->metrics);
 	++(*kvClearRanges);
 	if (keys.singleKeyRange()) {
@@ -10205,15 +11515,21 @@ void StorageServerDisk::clearRange(KeyRangeRef keys) {
 }
 
 void StorageServerDisk::writeKeyValue(KeyValueRef kv) {
+	if (hotRowCache)
+		hotRowCache->invalidate(kv.key);
 	storage->set(kv);
 	*kvCommitLogicalBytes += kv.expectedSize();
 }
 
 void StorageServerDisk::writeMutation(MutationRef mutation) {
 	if (mutation.type == MutationRef::SetValue) {
+		if (hotRowCache)
+			hotRowCache->invalidate(mutation.param1);
 		storage->set(KeyValueRef(mutation.param1, mutation.param2));
 		*kvCommitLogicalBytes += mutation.expectedSize();
 	} else if (mutation.type == MutationRef::ClearRange) {
+		if (hotRowCache)
+			hotRowCache->invalidate(KeyRangeRef(mutation.param1, mutation.param2));
 		storage->clear(KeyRangeRef(mutation.param1, mutation.param2), &data->metrics);
 		++(*kvClearRanges);
 		if (KeyRangeRef(mutation.param1, mutation.param2).singleKeyRange()) {
@@ -10229,9 +11545,13 @@ void StorageServerDisk::writeMutations(const VectorRef<MutationRef>& mutations,
 	for (const auto& m : mutations) {
 		DEBUG_MUTATION(debugContext, debugVersion, m, data->thisServerID);
 		if (m.type == MutationRef::SetValue) {
+			if (hotRowCache)
+				hotRowCache->invalidate(m.param1);
 			storage->set(KeyValueRef(m.param1, m.param2));
 			*kvCommitLogicalBytes += m.expectedSize();
 		} else if (m.type == MutationRef::ClearRange) {
+			if (hotRowCache)
+				hotRowCache->invalidate(KeyRangeRef(m.param1, m.param2));
 			storage->clear(KeyRangeRef(m.param1, m.param2), &data->metrics);
 			++(*kvClearRanges);
 			if (KeyRangeRef(m.param1, m.param2).singleKeyRange()) {
@@ -10281,6 +11601,14 @@ void StorageServerDisk::makeTssQuarantineDurable() {
 	storage->set(KeyValueRef(persistTssQuarantine, "1"_sr));
 }
 
+// Update data->storage to persist the keys to read back into the engine's cache on restart
+void StorageServerDisk::makeWarmKeysDurable(std::vector<Key> const& keys) {
+	storage->clear(persistWarmKeys);
+	for (auto const& key : keys) {
+		storage->set(KeyValueRef(key.withPrefix(persistWarmKeys.begin), ""_sr));
+	}
+}
+
 void StorageServerDisk::changeLogProtocol(Version version, ProtocolVersion protocol) {
 	data->addMutationToMutationLogOrStorage(
 	    version,
@@ -10400,6 +11728,25 @@ ACTOR Future<Void> restoreByteSample(StorageServer* data,
 	return Void();
 }
 
+// Reads the keys that were hottest before a restart, so that they are in the storage engine's cache before the
+// clients that read them return
+ACTOR Future<Void> warmStorageCache(StorageServer* data, IKeyValueStore* storage, RangeResult warmKeys) {
+	state double start = now();
+	state int i = 0;
+	while (i < warmKeys.size()) {
+		std::vector<Future<Optional<Value>>> reads;
+		for (; i < warmKeys.size() && reads.size() < SERVER_KNOBS->STORAGE_WARM_KEYS_PARALLELISM; i++) {
+			reads.push_back(storage->readValue(warmKeys[i].key.removePrefix(persistWarmKeys.begin),
+			                                   ReadOptions(ReadType::LOW, CacheResult::True)));
+		}
+		wait(waitForAll(reads));
+	}
+	TraceEvent("StorageWarmedCache", data->thisServerID)
+	    .detail("Keys", warmKeys.size())
+	    .detail("Duration", now() - start);
+	return Void();
+}
+
 ACTOR Future<bool> restoreDurableState(StorageServer* data, IKeyValueStore* storage) {
 	state Future<Optional<Value>> fFormat = storage->readValue(persistFormat.key);
 	state Future<Optional<Value>> fID = storage->readValue(persistID);
@@ -10416,6 +11763,7 @@ ACTOR Future<bool> restoreDurableState(StorageServer* data, IKeyValueStore* stor
 	state Future<RangeResult> fCheckpoints = storage->readRange(persistCheckpointKeys);
 	state Future<RangeResult> fTenantMap = storage->readRange(persistTenantMapKeys);
 	state Future<RangeResult> fStorageShards = storage->readRange(persistStorageServerShardKeys);
+	state Future<RangeResult> fWarmKeys = storage->readRange(persistWarmKeys);
 
 	state Promise<Void> byteSampleSampleRecovered;
 	state Promise<Void> startByteSampleRestore;
@@ -10431,7 +11779,8 @@ ACTOR Future<bool> restoreDurableState(StorageServer* data, IKeyValueStore* stor
 	                             fPendingCheckpoints,
 	                             fCheckpoints,
 	                             fTenantMap,
-	                             fStorageShards }));
+	                             fStorageShards,
+	                             fWarmKeys }));
 	wait(byteSampleSampleRecovered.getFuture());
 	TraceEvent("RestoringDurableState", data->thisServerID).log();
 
@@ -10621,6 +11970,9 @@ ACTOR Future<bool> restoreDurableState(StorageServer* data, IKeyValueStore* stor
 
 	validate(data, true);
 	startByteSampleRestore.send(Void());
+	if (!fWarmKeys.get().empty()) {
+		data->warmKeysRecovery = warmStorageCache(data, storage, fWarmKeys.get());
+	}
 
 	return true;
 }
@@ -10699,6 +12051,29 @@ void StorageServer::byteSampleApplySet(KeyValueRef kv, Version ver) {
 		metrics.notifyBytes(key, delta);
 }
 
+bool StorageServer::applyDeferredByteSampleMutations(int limit) {
+	// Applying a mutation can defer more, for the byte sample's own keys, which are applied in the same pass
+	for (; limit > 0 && !deferredByteSampleMutations.empty(); --limit) {
+		auto [ver, m] = deferredByteSampleMutations.front();
+		deferredByteSampleMutations.pop_front();
+		ASSERT(ver > durableVersion.get());
+		byteSampleApplyMutation(m, ver);
+	}
+	return !deferredByteSampleMutations.empty();
+}
+
+// Keeps the byte sample up to date with the mutations that update() adds to the mutation log, at a lower priority
+ACTOR Future<Void> byteSampleUpdater(StorageServer* data) {
+	loop {
+		wait(data->byteSampleMutationsDeferred.onTrigger());
+		loop {
+			wait(delay(0, TaskPriority::UpdateStorage));
+			if (!data->applyDeferredByteSampleMutations(SERVER_KNOBS->STORAGE_DEFERRED_BYTE_SAMPLE_BATCH))
+				break;
+		}
+	}
+}
+
 void StorageServer::byteSampleApplyClear(KeyRangeRef range, Version ver) {
 	// Update byteSample in memory and (eventually) on disk via the mutationLog and notify waiting metrics
 
@@ -10879,6 +12254,51 @@ Future<Void> StorageServer::waitMetricsTenantAware(const WaitMetricsRequest& req
 	return waitMetricsTenantAware_internal(this, req);
 }
 
+// Moves read slots from fetch and low priority reads to normal and high priority reads while the latter wait longer
+// than STORAGESERVER_READ_QUEUE_LATENCY_TARGET for them, and gives them back once they don't.
+ACTOR Future<Void> adjustReadPriorityWeights(StorageServer* self) {
+	state std::vector<int> configuredWeights =
+	    parseStringToVector<int>(SERVER_KNOBS->STORAGESERVER_READ_PRIORITIES, ',');
+	state std::vector<int> backgroundRanks;
+	for (ReadType type : { ReadType::FETCH, ReadType::LOW }) {
+		int rank = self->readPriorityRanks[(int)type];
+		// Only priorities that no foreground reads share
+		if (rank != self->readPriorityRanks[(int)ReadType::NORMAL] &&
+		    rank != self->readPriorityRanks[(int)ReadType::HIGH] &&
+		    std::find(backgroundRanks.begin(), backgroundRanks.end(), rank) == backgroundRanks.end()) {
+			backgroundRanks.push_back(rank);
+		}
+	}
+	if (SERVER_KNOBS->STORAGESERVER_READ_WEIGHT_ADJUST_INTERVAL <= 0 || backgroundRanks.empty()) {
+		return Void();
+	}
+
+	loop {
+		wait(delay(SERVER_KNOBS->STORAGESERVER_READ_WEIGHT_ADJUST_INTERVAL));
+
+		double queueLatency = self->foregroundReadQueueCount > 0
+		                          ? self->foregroundReadQueueSeconds / self->foregroundReadQueueCount
+		                          : 0;
+		self->foregroundReadQueueSeconds = 0;
+		self->foregroundReadQueueCount = 0;
+		bool foregroundQueued = queueLatency > SERVER_KNOBS->STORAGESERVER_READ_QUEUE_LATENCY_TARGET;
+
+		for (int rank : backgroundRanks) {
+			int weight = self->ssLock->getWeight(rank);
+			int newWeight =
+			    foregroundQueued ? std::max(1, weight / 2) : std::min(configuredWeights[rank], weight * 2);
+			if (newWeight != weight) {
+				TraceEvent("StorageServerReadWeightChanged", self->thisServerID)
+				    .suppressFor(10.0)
+				    .detail("Priority", rank)
+				    .detail("Weight", newWeight)
+				    .detail("ForegroundQueueLatency", queueLatency);
+				self->ssLock->setWeight(rank, newWeight);
+			}
+		}
+	}
+}
+
 ACTOR Future<Void> metricsCore(StorageServer* self, StorageServerInterface ssi) {
 
 	wait(self->byteSampleRecovery);
@@ -10899,9 +12319,11 @@ ACTOR Future<Void> metricsCore(StorageServer* self, StorageServerInterface ssi)
 		    int type = (int)ReadType::FETCH;
 		    te.detail("ReadFetchActive", self->ssLock->getRunnersCount(rpr[type]));
 		    te.detail("ReadFetchWaiting", self->ssLock->getWaitersCount(rpr[type]));
+		    te.detail("ReadFetchWeight", self->ssLock->getWeight(rpr[type]));
 		    type = (int)ReadType::LOW;
 		    te.detail("ReadLowActive", self->ssLock->getRunnersCount(rpr[type]));
 		    te.detail("ReadLowWaiting", self->ssLock->getWaitersCount(rpr[type]));
+		    te.detail("ReadLowWeight", self->ssLock->getWeight(rpr[type]));
 		    type = (int)ReadType::NORMAL;
 		    te.detail("ReadNormalActive", self->ssLock->getRunnersCount(rpr[type]));
 		    te.detail("ReadNormalWaiting", self->ssLock->getWaitersCount(rpr[type]));
@@ -10984,6 +12406,40 @@ ACTOR Future<Void> serveGetValueRequests(StorageServer* self, FutureStream<GetVa
 	}
 }
 
+ACTOR Future<Void> serveGetValuesRequests(StorageServer* self, FutureStream<GetValuesRequest> getValues) {
+	getCurrentLineage()->modify(&TransactionLineage::operation) = TransactionLineage::Operation::GetValue;
+	loop {
+		GetValuesRequest req = waitNext(getValues);
+		// Warning: This code is executed at extremely high priority (TaskPriority::LoadBalancedEndpoint), so
+		// downgrade before doing real work
+		if (req.options.present() && req.options.get().debugID.present())
+			g_traceBatch.addEvent(
+			    "GetValueDebug", req.options.get().debugID.get().first(), "storageServer.received.getValues");
+
+		self->actors.add(self->readGuard(req, getValuesQ));
+	}
+}
+
+// Serves a read until its remote requester gives up on it (see FlowTransport::cancelRequest). The read and any storage
+// engine reads it is waiting on are then cancelled, nothing is sent back, and the read is counted as finished.
+ACTOR template <class Reply>
+Future<Void> cancelWhenAbandoned(StorageServer* data,
+                                 Future<Void> serving,
+                                 ReplyPromise<Reply> reply,
+                                 Counter* finishedQueries) {
+	choose {
+		when(wait(serving)) {}
+		when(wait(FlowTransport::transport().onRequestCancelled(reply.getEndpoint().token))) {
+			++data->counters.readsCancelled;
+			++(*finishedQueries);
+			if (!reply.isSet()) {
+				reply.send(Never());
+			}
+		}
+	}
+	return Void();
+}
+
 ACTOR Future<Void> serveGetKeyValuesRequests(StorageServer* self, FutureStream<GetKeyValuesRequest> getKeyValues) {
 	getCurrentLineage()->modify(&TransactionLineage::operation) = TransactionLineage::Operation::GetKeyValues;
 	loop {
@@ -10991,7 +12447,11 @@ ACTOR Future<Void> serveGetKeyValuesRequests(StorageServer* self, FutureStream<G
 
 		// Warning: This code is executed at extremely high priority (TaskPriority::LoadBalancedEndpoint), so
 		// downgrade before doing real work
-		self->actors.add(self->readGuard(req, getKeyValuesQ));
+		Future<Void> serving = self->readGuard(req, getKeyValuesQ);
+		if (FLOW_KNOBS->CANCEL_ABANDONED_REQUESTS && req.reply.isRemoteEndpoint()) {
+			serving = cancelWhenAbandoned(self, serving, req.reply, &self->counters.finishedQueries);
+		}
+		self->actors.add(serving);
 	}
 }
 
@@ -11004,7 +12464,11 @@ ACTOR Future<Void> serveGetMappedKeyValuesRequests(StorageServer* self,
 
 		// Warning: This code is executed at extremely high priority (TaskPriority::LoadBalancedEndpoint), so downgrade
 		// before doing real work
-		self->actors.add(self->readGuard(req, getMappedKeyValuesQ));
+		Future<Void> serving = self->readGuard(req, getMappedKeyValuesQ);
+		if (FLOW_KNOBS->CANCEL_ABANDONED_REQUESTS && req.reply.isRemoteEndpoint()) {
+			serving = cancelWhenAbandoned(self, serving, req.reply, &self->counters.finishedGetMappedRangeQueries);
+		}
+		self->actors.add(serving);
 	}
 }
 
@@ -11050,6 +12514,24 @@ ACTOR Future<Void> watchValueWaitForVersion(StorageServer* self,
 	return Void();
 }
 
+ACTOR Future<Void> serveGetHotKeysRequests(StorageServer* self, FutureStream<GetHotKeysRequest> getHotKeys) {
+	loop {
+		GetHotKeysRequest req = waitNext(getHotKeys);
+		std::map<Key, std::pair<double, double>> rates;
+		for (auto const& [key, rate] : self->hotReadKeys.getHotKeys(req.keys)) {
+			rates[key].first = rate;
+		}
+		for (auto const& [key, rate] : self->hotWriteKeys.getHotKeys(req.keys)) {
+			rates[key].second = rate;
+		}
+		GetHotKeysReply reply;
+		for (auto const& [key, rate] : rates) {
+			reply.hotKeys.push_back_deep(reply.hotKeys.arena(), HotKeyRef(key, rate.first, rate.second));
+		}
+		req.reply.send(reply);
+	}
+}
+
 ACTOR Future<Void> serveWatchValueRequestsImpl(StorageServer* self, FutureStream<WatchValueRequest> stream) {
 	loop {
 		getCurrentLineage()->modify(&TransactionLineage::txID) = UID();
@@ -11067,7 +12549,8 @@ ACTOR Future<Void> serveWatchValueRequestsImpl(StorageServer* self, FutureStream
 			KeyRef key = self->setWatchMetadata(metadata);
 			metadata->watch_impl = forward(watchWaitForValueChange(self, span.context, key, req.tenantInfo.tenantId),
 			                               metadata->versionPromise);
-			self->actors.add(watchValueSendReply(self, req, metadata->versionPromise.getFuture(), span.context));
+			addWatchWaiter(self, metadata, req);
+			self->actors.add(watchValueSendReplies(self, metadata, span.context));
 		}
 		// case 2: there is a watch in the map and it has the same value so just update version
 		else if (metadata->value == req.value) {
@@ -11076,7 +12559,7 @@ ACTOR Future<Void> serveWatchValueRequestsImpl(StorageServer* self, FutureStream
 				metadata->tags = req.tags;
 				metadata->debugID = req.debugID;
 			}
-			self->actors.add(watchValueSendReply(self, req, metadata->versionPromise.getFuture(), span.context));
+			addWatchWaiter(self, metadata, req);
 		}
 		// case 3: version in map has a lower version so trigger watch and create a new entry in map
 		else if (req.version > metadata->version) {
@@ -11090,7 +12573,8 @@ ACTOR Future<Void> serveWatchValueRequestsImpl(StorageServer* self, FutureStream
 			metadata->watch_impl = forward(watchWaitForValueChange(self, span.context, key, req.tenantInfo.tenantId),
 			                               metadata->versionPromise);
 
-			self->actors.add(watchValueSendReply(self, req, metadata->versionPromise.getFuture(), span.context));
+			addWatchWaiter(self, metadata, req);
+			self->actors.add(watchValueSendReplies(self, metadata, span.context));
 		}
 		// case 4: version in the map is higher so immediately trigger watch
 		else if (req.version < metadata->version) {
@@ -11124,8 +12608,8 @@ ACTOR Future<Void> serveWatchValueRequestsImpl(StorageServer* self, FutureStream
 						metadata->watch_impl =
 						    forward(watchWaitForValueChange(self, span.context, key, req.tenantInfo.tenantId),
 						            metadata->versionPromise);
-						self->actors.add(
-						    watchValueSendReply(self, req, metadata->versionPromise.getFuture(), span.context));
+						addWatchWaiter(self, metadata, req);
+						self->actors.add(watchValueSendReplies(self, metadata, span.context));
 					} else {
 						req.reply.send(WatchValueReply{ latest });
 					}
@@ -11232,12 +12716,16 @@ ACTOR Future<Void> storageServerCore(StorageServer* self, StorageServerInterface
 	state Future<Void> updateProcessStatsTimer = delay(SERVER_KNOBS->FASTRESTORE_UPDATE_PROCESS_STATS_INTERVAL);
 
 	self->actors.add(updateStorage(self));
+	self->actors.add(byteSampleUpdater(self));
 	self->actors.add(waitFailureServer(ssi.waitFailure.getFuture()));
 	self->actors.add(self->otherError.getFuture());
 	self->actors.add(metricsCore(self, ssi));
+	self->actors.add(adjustReadPriorityWeights(self));
 	self->actors.add(logLongByteSampleRecovery(self->byteSampleRecovery));
 	self->actors.add(checkBehind(self));
 	self->actors.add(serveGetValueRequests(self, ssi.getValue.getFuture()));
+	self->actors.add(serveGetValuesRequests(self, ssi.getValues.getFuture()));
+	self->actors.add(serveGetHotKeysRequests(self, ssi.getHotKeys.getFuture()));
 	self->actors.add(serveGetKeyValuesRequests(self, ssi.getKeyValues.getFuture()));
 	self->actors.add(serveGetMappedKeyValuesRequests(self, ssi.getMappedKeyValues.getFuture()));
 	self->actors.add(serveGetKeyValuesStreamRequests(self, ssi.getKeyValuesStream.getFuture()));
@@ -11827,6 +13315,9 @@ ACTOR Future<Void> storageServer(IKeyValueStore* persistentData,
 		if (self.byteSampleRecovery.isValid()) {
 			self.byteSampleRecovery.cancel();
 		}
+		if (self.warmKeysRecovery.isValid()) {
+			self.warmKeysRecovery.cancel();
+		}
 
 		if (recovered.canBeSet())
 			recovered.send(Void());
@@ -11893,7 +13384,7 @@ Possibilities:
 void versionedMapTest() {
 	VersionedMap<int, int> vm;
 
-	printf("SS Ptree node is %zu bytes\n", sizeof(StorageServer::VersionedData::PTreeT));
+	printf("SS Ptree node is %zu bytes\n", sizeof(VersionedMap<KeyRef, ValueOrClearToRef>::PTreeT));
 
 	const int NSIZE = sizeof(VersionedMap<int, int>::PTreeT);
 	const int ASIZE = NSIZE <= 64 ? 64 : nextFastAllocatedSize(NSIZE);
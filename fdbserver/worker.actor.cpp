@@ -130,6 +130,86 @@ ACTOR Future<std::vector<Endpoint>> tryDBInfoBroadcast(RequestStream<UpdateServe
 	return req.broadcastInfo;
 }
 
+Optional<Standalone<StringRef>> encodeDBInfoDelta(StringRef base, StringRef updated) {
+	ASSERT(base.size() == updated.size());
+	// A run costs 8 bytes of header, so differing bytes separated by less than that are sent as one run
+	constexpr int minGap = 8;
+	BinaryWriter wr(Unversioned());
+	int i = 0;
+	while (i < updated.size()) {
+		if (base[i] == updated[i]) {
+			i++;
+			continue;
+		}
+		int begin = i, end = i + 1;
+		for (int j = end; j < updated.size() && j < end + minGap; j++) {
+			if (base[j] != updated[j]) {
+				end = j + 1;
+			}
+		}
+		wr << static_cast<int32_t>(begin) << static_cast<int32_t>(end - begin);
+		wr.serializeBytes(updated.substr(begin, end - begin));
+		if (wr.getLength() > updated.size() / 2) {
+			return Optional<Standalone<StringRef>>();
+		}
+		i = end;
+	}
+	return wr.toValue();
+}
+
+Standalone<StringRef> applyDBInfoDelta(StringRef base, StringRef delta) {
+	Standalone<StringRef> result = makeString(base.size());
+	uint8_t* out = mutateString(result);
+	memcpy(out, base.begin(), base.size());
+	BinaryReader rd(delta, Unversioned());
+	while (!rd.empty()) {
+		int32_t offset, length;
+		if (rd.remainingBytes() < sizeof(offset) + sizeof(length)) {
+			throw serialization_failed();
+		}
+		rd >> offset >> length;
+		if (offset < 0 || length < 0 || offset > base.size() - length ||
+		    length > static_cast<int64_t>(rd.remainingBytes())) {
+			throw serialization_failed();
+		}
+		memcpy(out + offset, rd.readBytes(length), length);
+	}
+	return result;
+}
+
+TEST_CASE("/fdbserver/worker/dbInfoDelta") {
+	auto randomString = [](int size) {
+		Standalone<StringRef> s = makeString(size);
+		for (int i = 0; i < size; i++) {
+			mutateString(s)[i] = deterministicRandom()->randomInt(0, 256);
+		}
+		return s;
+	};
+	Standalone<StringRef> base = randomString(1000);
+	Standalone<StringRef> updated = makeString(base.size());
+	memcpy(mutateString(updated), base.begin(), base.size());
+	for (int i = 0; i < 10; i++) {
+		mutateString(updated)[deterministicRandom()->randomInt(0, updated.size())]++;
+	}
+
+	Optional<Standalone<StringRef>> delta = encodeDBInfoDelta(base, updated);
+	ASSERT(delta.present() && delta.get().size() < updated.size() / 2);
+	ASSERT(applyDBInfoDelta(base, delta.get()) == updated);
+	ASSERT(encodeDBInfoDelta(base, base).get().size() == 0);
+
+	ASSERT(!encodeDBInfoDelta(base, randomString(base.size())).present());
+
+	BinaryWriter bad(Unversioned());
+	bad << static_cast<int32_t>(base.size() - 1) << static_cast<int32_t>(2) << static_cast<uint16_t>(0);
+	try {
+		applyDBInfoDelta(base, bad.toValue());
+		ASSERT(false);
+	} catch (Error& e) {
+		ASSERT_EQ(e.code(), error_code_serialization_failed);
+	}
+	return Void();
+}
+
 ACTOR Future<std::vector<Endpoint>> broadcastDBInfoRequest(UpdateServerDBInfoRequest req,
                                                            int sendAmount,
                                                            Optional<Endpoint> sender,
@@ -686,7 +766,8 @@ ACTOR Future<Void> registrationClient(
 				asyncPriorityInfo->set(reply.priorityInfo);
 				TraceEvent("WorkerRegisterReply")
 				    .detail("CCID", ccInterface->get().get().id())
-				    .detail("ProcessClass", reply.processClass.toString());
+				    .detail("ProcessClass", reply.processClass.toString())
+				    .detail("UptimeSeconds", now() - machineStartTime());
 				break;
 			}
 			when(wait(delay(SERVER_KNOBS->UNKNOWN_CC_TIMEOUT))) {
@@ -1399,6 +1480,8 @@ ACTOR Future<Void> storageServerRollbackRebooter(std::set<std::pair<UID, KeyValu
 		recruited.initEndpoints();
 
 		DUMPTOKEN(recruited.getValue);
+		DUMPTOKEN(recruited.getValues);
+		DUMPTOKEN(recruited.getHotKeys);
 		DUMPTOKEN(recruited.getKey);
 		DUMPTOKEN(recruited.getKeyValues);
 		DUMPTOKEN(recruited.getMappedKeyValues);
@@ -1446,6 +1529,8 @@ ACTOR Future<Void> storageCacheRollbackRebooter(Future<Void> prevStorageCache,
 		recruited.initEndpoints();
 
 		DUMPTOKEN(recruited.getValue);
+		DUMPTOKEN(recruited.getValues);
+		DUMPTOKEN(recruited.getHotKeys);
 		DUMPTOKEN(recruited.getKey);
 		DUMPTOKEN(recruited.getKeyValues);
 		DUMPTOKEN(recruited.getShardState);
@@ -1752,6 +1837,9 @@ ACTOR Future<Void> workerServer(Reference<IClusterConnectionRecord> connRecord,
                                 Reference<LocalConfiguration> localConfig,
                                 Reference<AsyncVar<Optional<UID>>> clusterId) {
 	state PromiseStream<ErrorInfo> errors;
+	// The latest serialized ServerDBInfo received, the base of the deltas that follow it
+	state UID dbInfoPayloadID;
+	state Standalone<StringRef> dbInfoPayload;
 	state Reference<AsyncVar<Optional<DataDistributorInterface>>> ddInterf(
 	    new AsyncVar<Optional<DataDistributorInterface>>());
 	state Reference<AsyncVar<Optional<RatekeeperInterface>>> rkInterf(new AsyncVar<Optional<RatekeeperInterface>>());
@@ -1924,6 +2012,8 @@ ACTOR Future<Void> workerServer(Reference<IClusterConnectionRecord> connRecord,
 				startRole(ssRole, recruited.id(), interf.id(), details, "Restored");
 
 				DUMPTOKEN(recruited.getValue);
+				DUMPTOKEN(recruited.getValues);
+				DUMPTOKEN(recruited.getHotKeys);
 				DUMPTOKEN(recruited.getKey);
 				DUMPTOKEN(recruited.getKeyValues);
 				DUMPTOKEN(recruited.getMappedKeyValues);
@@ -1973,7 +2063,16 @@ ACTOR Future<Void> workerServer(Reference<IClusterConnectionRecord> connRecord,
 					logQueueBasename = fileLogQueuePrefix.toString() + optionsString.toString() + "-";
 				}
 				ASSERT_WE_THINK(abspath(parentDirectory(s.filename)) == folder);
-				IKeyValueStore* kv = openKVStore(s.storeType, s.filename, s.storeID, memoryLimit, validateDataFiles);
+				// Mutations are encrypted before they reach a TLog, so its spill store is never encrypted itself.
+				IKeyValueStore* kv = openKVStore(s.storeType,
+				                                 s.filename,
+				                                 s.storeID,
+				                                 memoryLimit,
+				                                 validateDataFiles,
+				                                 false,
+				                                 false,
+				                                 {},
+				                                 EncryptionAtRestMode(EncryptionAtRestMode::DISABLED));
 				const DiskQueueVersion dqv = s.tLogOptions.getDiskQueueVersion();
 				const int64_t diskQueueWarnSize =
 				    s.tLogOptions.spillType == TLogSpillType::VALUE ? 10 * SERVER_KNOBS->TARGET_BYTES_PER_TLOG : -1;
@@ -2033,6 +2132,8 @@ ACTOR Future<Void> workerServer(Reference<IClusterConnectionRecord> connRecord,
 
 			// DUMPTOKEN(recruited.getVersion);
 			DUMPTOKEN(recruited.getValue);
+			DUMPTOKEN(recruited.getValues);
+			DUMPTOKEN(recruited.getHotKeys);
 			DUMPTOKEN(recruited.getKey);
 			DUMPTOKEN(recruited.getKeyValues);
 			DUMPTOKEN(recruited.getMappedKeyValues);
@@ -2072,7 +2173,8 @@ ACTOR Future<Void> workerServer(Reference<IClusterConnectionRecord> connRecord,
 		Promise<Void> recoveredDiskFiles;
 		Future<Void> recoverDiskFiles = trigger(
 		    [=]() {
-			    TraceEvent("DiskFileRecoveriesComplete", interf.id());
+			    TraceEvent("DiskFileRecoveriesComplete", interf.id())
+			        .detail("UptimeSeconds", now() - machineStartTime());
 			    recoveredDiskFiles.send(Void());
 		    },
 		    waitForAll(recoveries));
@@ -2108,43 +2210,66 @@ ACTOR Future<Void> workerServer(Reference<IClusterConnectionRecord> connRecord,
 
 		loop choose {
 			when(UpdateServerDBInfoRequest req = waitNext(interf.updateServerDBInfo.getFuture())) {
-				ServerDBInfo localInfo = BinaryReader::fromStringRef<ServerDBInfo>(
-				    req.serializedDbInfo, AssumeVersion(g_network->protocolVersion()));
-				localInfo.myLocality = locality;
-
-				if (localInfo.infoGeneration < dbInfo->get().infoGeneration &&
-				    localInfo.clusterInterface == dbInfo->get().clusterInterface) {
-					std::vector<Endpoint> rep = req.broadcastInfo;
-					rep.push_back(interf.updateServerDBInfo.getEndpoint());
-					req.reply.send(rep);
-				} else {
-					Optional<Endpoint> notUpdated;
-					if (!ccInterface->get().present() || localInfo.clusterInterface != ccInterface->get().get()) {
-						notUpdated = interf.updateServerDBInfo.getEndpoint();
-					} else if (localInfo.infoGeneration > dbInfo->get().infoGeneration ||
-					           dbInfo->get().clusterInterface != ccInterface->get().get()) {
-						TraceEvent("GotServerDBInfoChange")
-						    .detail("ChangeID", localInfo.id)
-						    .detail("InfoGeneration", localInfo.infoGeneration)
-						    .detail("MasterID", localInfo.master.id())
-						    .detail("RatekeeperID",
-						            localInfo.ratekeeper.present() ? localInfo.ratekeeper.get().id() : UID())
-						    .detail("DataDistributorID",
-						            localInfo.distributor.present() ? localInfo.distributor.get().id() : UID())
-						    .detail("BlobManagerID",
-						            localInfo.blobManager.present() ? localInfo.blobManager.get().id() : UID())
-						    .detail("BlobMigratorID",
-						            localInfo.blobMigrator.present() ? localInfo.blobMigrator.get().id() : UID())
-						    .detail("EncryptKeyProxyID",
-						            localInfo.encryptKeyProxy.present() ? localInfo.encryptKeyProxy.get().id() : UID());
-						dbInfo->set(localInfo);
+				Optional<Standalone<StringRef>> serializedDbInfo;
+				if (!req.deltaBaseID.present()) {
+					serializedDbInfo = req.serializedDbInfo;
+				} else if (req.deltaBaseID.get() == dbInfoPayloadID) {
+					try {
+						serializedDbInfo = applyDBInfoDelta(dbInfoPayload, req.serializedDbInfo);
+					} catch (Error& e) {
+						if (e.code() != error_code_serialization_failed) {
+							throw e;
+						}
+						TraceEvent(SevWarnAlways, "BadServerDBInfoDelta", interf.id()).error(e);
 					}
-					errorForwarders.add(
-					    success(broadcastDBInfoRequest(req, SERVER_KNOBS->DBINFO_SEND_AMOUNT, notUpdated, true)));
+				}
+				if (!serializedDbInfo.present()) {
+					// Without a usable delta, pass it on and wait for the full ServerDBInfo to be resent
+					CODE_PROBE(true, "Worker unable to apply a ServerDBInfo delta");
+					errorForwarders.add(success(broadcastDBInfoRequest(
+					    req, SERVER_KNOBS->DBINFO_SEND_AMOUNT, interf.updateServerDBInfo.getEndpoint(), true)));
+				} else {
+					ServerDBInfo localInfo = BinaryReader::fromStringRef<ServerDBInfo>(
+					    serializedDbInfo.get(), AssumeVersion(g_network->protocolVersion()));
+					localInfo.myLocality = locality;
+					dbInfoPayloadID = req.payloadID;
+					dbInfoPayload = serializedDbInfo.get();
+
+					if (localInfo.infoGeneration < dbInfo->get().infoGeneration &&
+					    localInfo.clusterInterface == dbInfo->get().clusterInterface) {
+						std::vector<Endpoint> rep = req.broadcastInfo;
+						rep.push_back(interf.updateServerDBInfo.getEndpoint());
+						req.reply.send(rep);
+					} else {
+						Optional<Endpoint> notUpdated;
+						if (!ccInterface->get().present() || localInfo.clusterInterface != ccInterface->get().get()) {
+							notUpdated = interf.updateServerDBInfo.getEndpoint();
+						} else if (localInfo.infoGeneration > dbInfo->get().infoGeneration ||
+						           dbInfo->get().clusterInterface != ccInterface->get().get()) {
+							TraceEvent("GotServerDBInfoChange")
+							    .detail("ChangeID", localInfo.id)
+							    .detail("InfoGeneration", localInfo.infoGeneration)
+							    .detail("MasterID", localInfo.master.id())
+							    .detail("RatekeeperID",
+							            localInfo.ratekeeper.present() ? localInfo.ratekeeper.get().id() : UID())
+							    .detail("DataDistributorID",
+							            localInfo.distributor.present() ? localInfo.distributor.get().id() : UID())
+							    .detail("BlobManagerID",
+							            localInfo.blobManager.present() ? localInfo.blobManager.get().id() : UID())
+							    .detail("BlobMigratorID",
+							            localInfo.blobMigrator.present() ? localInfo.blobMigrator.get().id() : UID())
+							    .detail("EncryptKeyProxyID",
+							            localInfo.encryptKeyProxy.present() ? localInfo.encryptKeyProxy.get().id()
+							                                                : UID());
+							dbInfo->set(localInfo);
+						}
+						errorForwarders.add(
+						    success(broadcastDBInfoRequest(req, SERVER_KNOBS->DBINFO_SEND_AMOUNT, notUpdated, true)));
 
-					if (!updateClusterIdFuture.isValid() && !clusterId->get().present() &&
-					    localInfo.client.clusterId.isValid()) {
-						updateClusterIdFuture = updateClusterId(localInfo.client.clusterId, clusterId, folder);
+						if (!updateClusterIdFuture.isValid() && !clusterId->get().present() &&
+						    localInfo.client.clusterId.isValid()) {
+							updateClusterIdFuture = updateClusterId(localInfo.client.clusterId, clusterId, folder);
+						}
 					}
 				}
 			}
@@ -2480,7 +2605,15 @@ ACTOR Future<Void> workerServer(Reference<IClusterConnectionRecord> connRecord,
 					    req.logVersion > TLogVersion::V2 ? fileVersionedLogDataPrefix : fileLogDataPrefix;
 					std::string filename =
 					    filenameFromId(req.storeType, folder, prefix.toString() + tLogOptions.toPrefix(), logId);
-					IKeyValueStore* data = openKVStore(req.storeType, filename, logId, memoryLimit);
+					IKeyValueStore* data = openKVStore(req.storeType,
+					                                   filename,
+					                                   logId,
+					                                   memoryLimit,
+					                                   false,
+					                                   false,
+					                                   false,
+					                                   {},
+					                                   EncryptionAtRestMode(EncryptionAtRestMode::DISABLED));
 					const DiskQueueVersion dqv = tLogOptions.getDiskQueueVersion();
 					IDiskQueue* queue = openDiskQueue(
 					    joinPath(folder,
@@ -2542,6 +2675,8 @@ ACTOR Future<Void> workerServer(Reference<IClusterConnectionRecord> connRecord,
 					startRole(ssRole, recruited.id(), interf.id(), details);
 
 					DUMPTOKEN(recruited.getValue);
+					DUMPTOKEN(recruited.getValues);
+					DUMPTOKEN(recruited.getHotKeys);
 					DUMPTOKEN(recruited.getKey);
 					DUMPTOKEN(recruited.getKeyValues);
 					DUMPTOKEN(recruited.getMappedKeyValues);
@@ -36,6 +36,7 @@ static const char* storageMigrationTypes[] = { "perpetual_storage_wiggle=0 stora
 	                                           "storage_migration_type=aggressive" };
 static const char* logTypes[] = { "log_engine:=1",
 	                              "log_engine:=2",
+	                              "log_engine:=3",
 	                              "log_spill:=1",
 	                              "log_spill:=2",
 	                              "log_version:=2",
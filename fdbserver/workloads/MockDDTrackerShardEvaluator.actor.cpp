@@ -39,6 +39,12 @@ struct MockDDTrackerShardEvaluatorWorkload : public MockDDTestWorkload {
 
 	std::map<RelocateReason, int> rsReasonCounts;
 
+	// --- benchmark results ---
+	double startTime = 0, lastRelocationTime = 0;
+	double startCpuSeconds = 0, cpuSeconds = 0;
+	int64_t relocatedBytes = 0;
+	int shardCount = 0;
+
 	// --- test configs ---
 
 	// Each key space is convert from an int N. [N, N+1) represent a key space. So at most we have 2G key spaces
@@ -135,6 +141,9 @@ struct MockDDTrackerShardEvaluatorWorkload : public MockDDTestWorkload {
 		loop choose {
 			when(RelocateShard rs = waitNext(input)) {
 				++self->rsReasonCounts[rs.reason];
+				self->lastRelocationTime = now();
+				// Relocations are only reported, never executed, so every server still has the whole database
+				self->relocatedBytes += self->mgs->allServers.begin()->second.sumRangeSize(rs.keys);
 			}
 		}
 	}
@@ -143,6 +152,9 @@ struct MockDDTrackerShardEvaluatorWorkload : public MockDDTestWorkload {
 		if (!enabled)
 			return Void();
 
+		startTime = lastRelocationTime = now();
+		startCpuSeconds = getProcessorTimeThread();
+
 		// start mock servers
 		actors.add(waitForAll(mgs->runAllMockServers()));
 
@@ -173,12 +185,19 @@ struct MockDDTrackerShardEvaluatorWorkload : public MockDDTestWorkload {
 	}
 
 	Future<bool> check(Database const& cx) override {
+		cpuSeconds = getProcessorTimeThread() - startCpuSeconds;
+		shardCount = shards.size();
 		std::cout << "Check phase shards count: " << shards.size() << "\n";
 		actors.clear(true);
 		return true;
 	}
 
 	void getMetrics(std::vector<PerfMetric>& m) override {
+		// The tracker has converged once it stops asking for relocations, so a run must be long enough to see that
+		m.emplace_back("ShardCount", shardCount, Averaged::False);
+		m.emplace_back("ConvergenceTime", lastRelocationTime - startTime, Averaged::False);
+		m.emplace_back("RelocatedBytes", relocatedBytes, Averaged::False);
+		m.emplace_back("CPUSeconds", cpuSeconds, Averaged::False);
 		for (const auto& [reason, count] : rsReasonCounts) {
 			m.push_back(PerfMetric(RelocateReason(reason).toString(), count, Averaged::False));
 		}
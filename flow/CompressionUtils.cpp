@@ -28,7 +28,26 @@
 #ifdef ZSTD_LIB_SUPPORTED
 #define ZSTD_STATIC_LINKING_ONLY
 #include <zstd.h>
+#include <zdict.h>
 static constexpr int ZSTD_COMPRESSION_LEVEL_1 = 1;
+
+namespace {
+// Contexts are reused by the dictionary calls on each thread, since creating one costs more than compressing a small
+// value
+struct ZstdContexts {
+	ZSTD_CCtx* cctx = ZSTD_createCCtx();
+	ZSTD_DCtx* dctx = ZSTD_createDCtx();
+	~ZstdContexts() {
+		ZSTD_freeCCtx(cctx);
+		ZSTD_freeDCtx(dctx);
+	}
+};
+
+ZstdContexts& zstdContexts() {
+	thread_local ZstdContexts contexts;
+	return contexts;
+}
+} // namespace
 #endif
 
 namespace {
@@ -103,6 +122,99 @@ StringRef CompressionUtils::decompress(const CompressionFilter filter, const Str
 	throw internal_error(); // We should never get here
 }
 
+StringRef CompressionUtils::compress(const CompressionFilter filter,
+                                    const StringRef& data,
+                                    int level,
+                                    const StringRef& dictionary,
+                                    Arena& arena) {
+	checkFilterSupported(filter);
+
+	if (filter == CompressionFilter::NONE || dictionary.empty()) {
+		return CompressionUtils::compress(filter, data, level, arena);
+	}
+#ifdef ZSTD_LIB_SUPPORTED
+	if (filter == CompressionFilter::ZSTD) {
+		size_t destSize = ZSTD_compressBound(data.size());
+		std::unique_ptr<uint8_t[]> dest = std::make_unique<uint8_t[]>(destSize);
+		size_t bytes = ZSTD_compress_usingDict(zstdContexts().cctx,
+		                                       dest.get(),
+		                                       destSize,
+		                                       data.begin(),
+		                                       data.size(),
+		                                       dictionary.begin(),
+		                                       dictionary.size(),
+		                                       level);
+		if (ZSTD_isError(bytes)) {
+			throw internal_error();
+		}
+		return StringRef(arena, StringRef(dest.get(), bytes));
+	}
+#endif
+	throw internal_error(); // We should never get here
+}
+
+StringRef CompressionUtils::decompress(const CompressionFilter filter,
+                                      const StringRef& data,
+                                      const StringRef& dictionary,
+                                      Arena& arena) {
+	checkFilterSupported(filter);
+
+	if (filter == CompressionFilter::NONE || dictionary.empty()) {
+		return CompressionUtils::decompress(filter, data, arena);
+	}
+#ifdef ZSTD_LIB_SUPPORTED
+	if (filter == CompressionFilter::ZSTD) {
+		size_t destSize = ZSTD_decompressBound(data.begin(), data.size());
+		if (ZSTD_isError(destSize)) {
+			throw internal_error();
+		}
+		std::unique_ptr<uint8_t[]> dest = std::make_unique<uint8_t[]>(destSize);
+		size_t bytes = ZSTD_decompress_usingDict(zstdContexts().dctx,
+		                                         dest.get(),
+		                                         destSize,
+		                                         data.begin(),
+		                                         data.size(),
+		                                         dictionary.begin(),
+		                                         dictionary.size());
+		if (ZSTD_isError(bytes)) {
+			throw internal_error();
+		}
+		return StringRef(arena, StringRef(dest.get(), bytes));
+	}
+#endif
+	throw internal_error(); // We should never get here
+}
+
+Standalone<StringRef> CompressionUtils::trainDictionary(const CompressionFilter filter,
+                                                        const std::vector<StringRef>& samples,
+                                                        int maxSize) {
+	checkFilterSupported(filter);
+
+	if (filter == CompressionFilter::NONE) {
+		return Standalone<StringRef>();
+	}
+#ifdef ZSTD_LIB_SUPPORTED
+	if (filter == CompressionFilter::ZSTD) {
+		// The trainer takes the samples concatenated, along with each one's size
+		std::string concatenated;
+		std::vector<size_t> sizes;
+		sizes.reserve(samples.size());
+		for (auto const& sample : samples) {
+			concatenated.append(reinterpret_cast<const char*>(sample.begin()), sample.size());
+			sizes.push_back(sample.size());
+		}
+		Standalone<StringRef> dictionary = makeString(maxSize);
+		size_t bytes = ZDICT_trainFromBuffer(
+		    mutateString(dictionary), maxSize, concatenated.data(), sizes.data(), sizes.size());
+		if (ZDICT_isError(bytes)) {
+			return Standalone<StringRef>();
+		}
+		return dictionary.substr(0, bytes);
+	}
+#endif
+	throw internal_error(); // We should never get here
+}
+
 int CompressionUtils::getDefaultCompressionLevel(CompressionFilter filter) {
 	checkFilterSupported(filter);
 
@@ -174,6 +286,45 @@ void testCompression2(CompressionFilter filter) {
 	ASSERT_EQ(verify.compare(uncompressed), 0);
 }
 
+// Small records which share most of their structure, like the values of a single table
+std::vector<Standalone<StringRef>> genSimilarRecords(int count) {
+	std::vector<Standalone<StringRef>> records;
+	for (int i = 0; i < count; i++) {
+		records.push_back(StringRef(format(R"({"id":%d,"name":"%s","status":"%s","region":"us-west-%d"})",
+		                                   deterministicRandom()->randomInt(0, 1e9),
+		                                   deterministicRandom()->randomAlphaNumeric(8).c_str(),
+		                                   deterministicRandom()->coinflip() ? "active" : "suspended",
+		                                   deterministicRandom()->randomInt(1, 3))));
+	}
+	return records;
+}
+
+void testDictionaryCompression(CompressionFilter filter) {
+	std::vector<Standalone<StringRef>> training = genSimilarRecords(2000);
+	std::vector<StringRef> samples(training.begin(), training.end());
+	Standalone<StringRef> dictionary = CompressionUtils::trainDictionary(filter, samples, 4096);
+	ASSERT(!dictionary.empty());
+	ASSERT_LE(dictionary.size(), 4096);
+
+	Arena arena;
+	int level = CompressionUtils::getDefaultCompressionLevel(filter);
+	size_t plainBytes = 0;
+	size_t dictionaryBytes = 0;
+	for (auto const& record : genSimilarRecords(100)) {
+		plainBytes += CompressionUtils::compress(filter, record, level, arena).size();
+		StringRef compressed = CompressionUtils::compress(filter, record, level, dictionary, arena);
+		dictionaryBytes += compressed.size();
+		StringRef verify = CompressionUtils::decompress(filter, compressed, dictionary, arena);
+		ASSERT_EQ(verify.compare(record), 0);
+	}
+	printf("Bytes without dictionary: %d, with dictionary: %d\n", (int)plainBytes, (int)dictionaryBytes);
+	ASSERT_LT(dictionaryBytes, plainBytes);
+
+	// Too few samples to train on
+	ASSERT(CompressionUtils::trainDictionary(filter, std::vector<StringRef>(samples.begin(), samples.begin() + 1), 4096)
+	           .empty());
+}
+
 } // namespace
 
 TEST_CASE("/CompressionUtils/noCompression") {
@@ -206,4 +357,11 @@ TEST_CASE("/CompressionUtils/zstdCompression2") {
 
 	return Void();
 }
+
+TEST_CASE("/CompressionUtils/zstdDictionaryCompression") {
+	testDictionaryCompression(CompressionFilter::ZSTD);
+	TraceEvent("ZstdDictionaryCompressionDone");
+
+	return Void();
+}
 #endif
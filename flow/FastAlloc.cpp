@@ -248,11 +248,25 @@ struct FastAllocator<Size>::GlobalData {
 	std::atomic<long long> totalMemory;
 	long long partialMagazineUnallocatedMemory;
 	std::atomic<long long> activeThreads;
-	GlobalData() : totalMemory(0), partialMagazineUnallocatedMemory(0), activeThreads(0) {
+	std::atomic<long long> lockContentions;
+	GlobalData() : totalMemory(0), partialMagazineUnallocatedMemory(0), activeThreads(0), lockContentions(0) {
 		InitializeCriticalSection(&mutex);
 	}
 };
 
+template <int Size>
+void FastAllocator<Size>::lockGlobalData() {
+	if (!TryEnterCriticalSection(&globalData()->mutex)) {
+		globalData()->lockContentions.fetch_add(1, std::memory_order_relaxed);
+		EnterCriticalSection(&globalData()->mutex);
+	}
+}
+
+template <int Size>
+long long FastAllocator<Size>::getGlobalLockContentions() {
+	return globalData()->lockContentions.load(std::memory_order_relaxed);
+}
+
 template <int Size>
 long long FastAllocator<Size>::getTotalMemory() {
 	return globalData()->totalMemory.load();
@@ -261,7 +275,7 @@ long long FastAllocator<Size>::getTotalMemory() {
 // This does not include memory held by various threads that's available for allocation
 template <int Size>
 long long FastAllocator<Size>::getApproximateMemoryUnused() {
-	EnterCriticalSection(&globalData()->mutex);
+	lockGlobalData();
 	long long unused =
 	    globalData()->magazines.size() * magazine_size * Size + globalData()->partialMagazineUnallocatedMemory;
 	LeaveCriticalSection(&globalData()->mutex);
@@ -464,7 +478,7 @@ void FastAllocator<Size>::getMagazine() {
 	ThreadData& thr = threadData();
 	ASSERT(!thr.freelist && !thr.alternate && thr.count == 0);
 
-	EnterCriticalSection(&globalData()->mutex);
+	lockGlobalData();
 	if (globalData()->magazines.size()) {
 		void* m = globalData()->magazines.back();
 		globalData()->magazines.pop_back();
@@ -540,13 +554,13 @@ void FastAllocator<Size>::getMagazine() {
 }
 template <int Size>
 void FastAllocator<Size>::releaseMagazine(void* mag) {
-	EnterCriticalSection(&globalData()->mutex);
+	lockGlobalData();
 	globalData()->magazines.push_back(mag);
 	LeaveCriticalSection(&globalData()->mutex);
 }
 template <int Size>
 FastAllocator<Size>::ThreadData::~ThreadData() {
-	EnterCriticalSection(&globalData()->mutex);
+	lockGlobalData();
 	if (freelist) {
 		ASSERT_ABORT(count > 0 && count <= magazine_size);
 		globalData()->partial_magazines.emplace_back(count, freelist);
@@ -563,6 +577,64 @@ FastAllocator<Size>::ThreadData::~ThreadData() {
 	freelist = nullptr;
 }
 
+namespace {
+
+// Buffers up to this many 4k pages are cached by allocateCached4kAligned()
+constexpr int kAlignedBufferCacheMaxPages = 256;
+
+std::atomic<int64_t> g_alignedBufferCacheBytes;
+
+struct AlignedBufferCache {
+	// freeLists[n] holds buffers of n 4k pages
+	std::vector<void*> freeLists[kAlignedBufferCacheMaxPages + 1];
+	int64_t bytes = 0;
+
+	~AlignedBufferCache() {
+		for (int pages = 0; pages <= kAlignedBufferCacheMaxPages; ++pages) {
+			for (void* ptr : freeLists[pages]) {
+				aligned_free(ptr);
+			}
+		}
+		g_alignedBufferCacheBytes -= bytes;
+	}
+};
+
+thread_local AlignedBufferCache alignedBufferCache;
+
+} // namespace
+
+void* allocateCached4kAligned(int size) {
+	int pages = size / 4096;
+	if (size % 4096 == 0 && pages <= kAlignedBufferCacheMaxPages) {
+		auto& freeList = alignedBufferCache.freeLists[pages];
+		if (!freeList.empty()) {
+			void* result = freeList.back();
+			freeList.pop_back();
+			alignedBufferCache.bytes -= size;
+			g_alignedBufferCacheBytes -= size;
+			return result;
+		}
+	}
+
+	void* result = aligned_alloc(4096, size);
+	if (result == nullptr) {
+		platform::outOfMemory();
+	}
+	return result;
+}
+
+void freeCached4kAligned(int size, void* ptr) {
+	int pages = size / 4096;
+	int64_t limit = FLOW_KNOBS ? FLOW_KNOBS->ALIGNED_BUFFER_CACHE_BYTES : 0;
+	if (size % 4096 == 0 && pages <= kAlignedBufferCacheMaxPages && alignedBufferCache.bytes + size <= limit) {
+		alignedBufferCache.freeLists[pages].push_back(ptr);
+		alignedBufferCache.bytes += size;
+		g_alignedBufferCacheBytes += size;
+		return;
+	}
+	aligned_free(ptr);
+}
+
 int64_t getTotalUnusedAllocatedMemory() {
 	int64_t unusedMemory = 0;
 
@@ -578,6 +650,7 @@ int64_t getTotalUnusedAllocatedMemory() {
 	unusedMemory += FastAllocator<4096>::getApproximateMemoryUnused();
 	unusedMemory += FastAllocator<8192>::getApproximateMemoryUnused();
 	unusedMemory += FastAllocator<16384>::getApproximateMemoryUnused();
+	unusedMemory += g_alignedBufferCacheBytes;
 
 	return unusedMemory;
 }
@@ -595,6 +668,28 @@ template class FastAllocator<4096>;
 template class FastAllocator<8192>;
 template class FastAllocator<16384>;
 
+TEST_CASE("/flow/FastAlloc/alignedBufferCache") {
+	const int size = 64 * 1024;
+	void* a = allocateCached4kAligned(size);
+	ASSERT(uintptr_t(a) % 4096 == 0);
+	freeCached4kAligned(size, a);
+
+	// A freed buffer is handed back for the next allocation of the same size if the cache has room for it
+	void* b = allocateCached4kAligned(size);
+	ASSERT(uintptr_t(b) % 4096 == 0);
+	if (FLOW_KNOBS->ALIGNED_BUFFER_CACHE_BYTES >= size) {
+		ASSERT(a == b);
+	}
+
+	// Sizes that are not whole pages bypass the cache
+	void* c = allocateCached4kAligned(size + 100);
+	ASSERT(uintptr_t(c) % 4096 == 0);
+	freeCached4kAligned(size + 100, c);
+	freeCached4kAligned(size, b);
+
+	return Void();
+}
+
 #ifdef USE_JEMALLOC
 #include <jemalloc/jemalloc.h>
 TEST_CASE("/jemalloc/4k_aligned_usable_size") {
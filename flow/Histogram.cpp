@@ -88,6 +88,35 @@ void HistogramRegistry::clear() {
 const char* const Histogram::UnitToStringMapper[] = { "milliseconds", "bytes", "bytes_per_second",
 	                                                  "percentage",   "count", "none" };
 
+void Histogram::initBucketNames() {
+	for (uint32_t i = 0; i < 32; i++) {
+		uint64_t value = uint64_t(1) << (i + 1);
+
+		switch (unit) {
+		case Unit::milliseconds:
+			// value stored in microseconds, so divide by 1000 before writing
+			bucketNames[i] = format("LessThan%u.%03u", int(value / 1000), int(value % 1000));
+			break;
+		case Unit::bytes:
+		case Unit::bytes_per_second:
+			bucketNames[i] = format("LessThan%" PRIu64, value);
+			break;
+		case Unit::percentageLinear:
+			bucketNames[i] = format("LessThan%f", (i + 1) * 0.04);
+			break;
+		case Unit::countLinear:
+			value = uint64_t((i + 1) * ((upperBound - lowerBound) / 31.0));
+			bucketNames[i] = format("LessThan%" PRIu64, value);
+			break;
+		case Unit::MAXHISTOGRAMUNIT:
+			bucketNames[i] = format("Default%u", i);
+			break;
+		default:
+			ASSERT(false);
+		}
+	}
+}
+
 void Histogram::writeToLog(double elapsed) {
 	bool active = false;
 	for (uint32_t i = 0; i < 32; i++) {
@@ -106,32 +135,9 @@ void Histogram::writeToLog(double elapsed) {
 		e.detail("Elapsed", elapsed);
 	int totalCount = 0;
 	for (uint32_t i = 0; i < 32; i++) {
-		uint64_t value = uint64_t(1) << (i + 1);
-
 		if (buckets[i]) {
 			totalCount += buckets[i];
-			switch (unit) {
-			case Unit::milliseconds:
-				// value stored in microseconds, so divide by 1000 before writing
-				e.detail(format("LessThan%u.%03u", int(value / 1000), int(value % 1000)), buckets[i]);
-				break;
-			case Unit::bytes:
-			case Unit::bytes_per_second:
-				e.detail(format("LessThan%" PRIu64, value), buckets[i]);
-				break;
-			case Unit::percentageLinear:
-				e.detail(format("LessThan%f", (i + 1) * 0.04), buckets[i]);
-				break;
-			case Unit::countLinear:
-				value = uint64_t((i + 1) * ((upperBound - lowerBound) / 31.0));
-				e.detail(format("LessThan%" PRIu64, value), buckets[i]);
-				break;
-			case Unit::MAXHISTOGRAMUNIT:
-				e.detail(format("Default%u", i), buckets[i]);
-				break;
-			default:
-				ASSERT(false);
-			}
+			e.detail(bucketNames[i].c_str(), buckets[i]);
 		}
 	}
 	e.detail("TotalCount", totalCount);
@@ -240,6 +246,13 @@ TEST_CASE("/flow/histogram/smoke_test") {
 
 		h->sampleSeconds(4400.0);
 		ASSERT(h->buckets[31] == 1);
+		ASSERT(h->bucketNames[0] == "LessThan0.002");
+		ASSERT(h->bucketNames[3] == "LessThan0.016");
+
+		h = Histogram::getHistogram("smoke_test"_sr, "records"_sr, Histogram::Unit::countLinear, 0, 31);
+		ASSERT(h->bucketNames[30] == "LessThan31");
+		h->updateUpperBound(62);
+		ASSERT(h->bucketNames[30] == "LessThan62");
 
 		GetHistogramRegistry().logReport();
 	}
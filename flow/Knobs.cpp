@@ -70,9 +70,13 @@ void FlowKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	init( SATURATION_PROFILING_LOG_INTERVAL,                   0.5 ); // A value of 0 means use RUN_LOOP_PROFILING_INTERVAL
 	init( SATURATION_PROFILING_MAX_LOG_INTERVAL,               5.0 );
 	init( SATURATION_PROFILING_LOG_BACKOFF,                    2.0 );
+	init( ACTOR_PROFILE_SAMPLE_TASKS,                           16 ); // A value of 0 disables the actor profile
+	init( ACTOR_PROFILE_LOG_INTERVAL,                         60.0 );
+	init( ACTOR_PROFILE_MAX_STACKS,                             50 );
 
 	init( FAST_ALLOC_LOGGING_BYTES,                           10e6 );
 	init( FAST_ALLOC_ALLOW_GUARD_PAGES,                      false );
+	init( ALIGNED_BUFFER_CACHE_BYTES,                         16e6 ); if( randomize && BUGGIFY ) ALIGNED_BUFFER_CACHE_BYTES = deterministicRandom()->coinflip() ? 0 : 1e6;
 	init( HUGE_ARENA_LOGGING_BYTES,                          100e6 );
 	init( HUGE_ARENA_LOGGING_INTERVAL,                         5.0 );
 
@@ -103,6 +107,7 @@ void FlowKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	init( CONNECTION_MONITOR_IDLE_TIMEOUT,                   180.0 ); if( randomize && BUGGIFY ) CONNECTION_MONITOR_IDLE_TIMEOUT = 5.0;
 	init( CONNECTION_MONITOR_INCOMING_IDLE_MULTIPLIER,         1.2 );
 	init( CONNECTION_MONITOR_UNREFERENCED_CLOSE_DELAY,         2.0 );
+	init( CONNECTION_MONITOR_ACTIVE_PING_INTERVAL,               5 ); if( randomize && BUGGIFY ) CONNECTION_MONITOR_ACTIVE_PING_INTERVAL = deterministicRandom()->randomInt(1, 20);
 
 	//FlowTransport
 	init( CONNECTION_REJECTED_MESSAGE_DELAY,                   1.0 );
@@ -119,6 +124,9 @@ void FlowKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	init( PEER_UNAVAILABLE_FOR_LONG_TIME_TIMEOUT,           3600.0 );
 	init( INCOMPATIBLE_PEER_DELAY_BEFORE_LOGGING,              5.0 );
 	init( PING_LOGGING_INTERVAL,                               3.0 );
+	init( PEER_CONNECTION_STRIPES,                               1 ); if( randomize && BUGGIFY ) PEER_CONNECTION_STRIPES = 3; // Clients only
+	init( PEER_BULK_LANE_PRIORITY,                            4000 ); if( randomize && BUGGIFY ) PEER_BULK_LANE_PRIORITY = 0; // Unreliable packets sent below this TaskPriority can't delay others; 0 disables
+	init( CANCEL_ABANDONED_REQUESTS,                         false ); if( randomize && BUGGIFY ) CANCEL_ABANDONED_REQUESTS = true; // Tell the server when a reply is no longer wanted
 	init( PING_SKETCH_ACCURACY,                                0.1 );
 
 	init( TLS_CERT_REFRESH_DELAY_SECONDS,                 12*60*60 );
@@ -180,6 +188,11 @@ void FlowKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	init( PAGE_WRITE_CHECKSUM_HISTORY,                           0 ); if( randomize && BUGGIFY ) PAGE_WRITE_CHECKSUM_HISTORY = 10000000;
 	init( DISABLE_POSIX_KERNEL_AIO,                              0 );
 
+	//AsyncFileIOUring
+	init( ENABLE_IO_URING,                                   false );
+	init( IO_URING_QUEUE_DEPTH,                                256 );
+	init( IO_URING_FIXED_FILES,                                 64 );
+
 	//AsyncFileNonDurable
 	init( NON_DURABLE_MAX_WRITE_DELAY,                         2.0 ); if( randomize && BUGGIFY ) NON_DURABLE_MAX_WRITE_DELAY = 5.0;
 	init( MAX_PRIOR_MODIFICATION_DELAY,                        1.0 ); if( randomize && BUGGIFY ) MAX_PRIOR_MODIFICATION_DELAY = 10.0;
@@ -209,17 +222,23 @@ void FlowKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	init( MIN_LOGGED_PRIORITY_BUSY_FRACTION,                  0.05 );
 	init( CERT_FILE_MAX_SIZE,                      5 * 1024 * 1024 );
 	init( READY_QUEUE_RESERVED_SIZE,                          8192 );
+	init( NET2_IDLE_SPIN_MAX_TIME,                               0 );
+	init( NET2_FAIR_SCHEDULING_SHARE,                            0 );
 	init( TASKS_PER_REACTOR_CHECK,                             100 );
 
 	//Network
 	init( PACKET_LIMIT,                                  100LL<<20 );
 	init( PACKET_WARNING,                                  2LL<<20 );  // 2MB packet warning quietly allows for 1MB system messages
+	init( PACKET_COMPRESSION_THRESHOLD,                          0 ); if( randomize && BUGGIFY ) PACKET_COMPRESSION_THRESHOLD = 1024; // 0 disables
 	init( TIME_OFFSET_LOGGING_INTERVAL,                       60.0 );
 	init( MAX_PACKET_SEND_BYTES,                        128 * 1024 );
+	init( TLS_WRITE_COALESCE_BYTES,                      16 * 1024 ); // One full TLS record; 0 disables coalescing
 	init( MIN_PACKET_BUFFER_BYTES,                        4 * 1024 );
 	init( MIN_PACKET_BUFFER_FREE_BYTES,                        256 );
 	init( FLOW_TCP_NODELAY,                                      1 );
 	init( FLOW_TCP_QUICKACK,                                     0 );
+	init( FLOW_TCP_FASTOPEN,                                     0 ); // Listen queue length for TCP Fast Open; > 0 also uses it to connect
+	init( FLOW_TCP_THIN_STREAMS,                                 0 );
 
 	//Sim2
 	init( MIN_OPEN_TIME,                                    0.0002 );
@@ -273,6 +292,8 @@ void FlowKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	init( SECOND_REQUEST_MULTIPLIER_DECAY,                 0.00025 );
 	init( SECOND_REQUEST_BUDGET_GROWTH,                       0.05 );
 	init( SECOND_REQUEST_MAX_BUDGET,                         100.0 );
+	init( LOAD_BALANCE_POWER_OF_TWO_CHOICES,                 false ); if( randomize && BUGGIFY ) LOAD_BALANCE_POWER_OF_TWO_CHOICES = true;
+	init( LOAD_BALANCE_LATENCY_SMOOTHING,                      0.1 ); // Weight of each reply in the smoothed latency and its 95th percentile
 	init( ALTERNATIVES_FAILURE_RESET_TIME,                     5.0 );
 	init( ALTERNATIVES_FAILURE_MIN_DELAY,                     0.05 );
 	init( ALTERNATIVES_FAILURE_DELAY_RATIO,                    0.2 );
@@ -293,6 +314,7 @@ void FlowKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	init( BASIC_LOAD_BALANCE_BUCKETS,                           40 ); //proxies bin recent GRV requests into 40 time bins
 	init( BASIC_LOAD_BALANCE_COMPUTE_PRECISION,              10000 ); //determines how much of the LB usage is holding the CPU usage of the proxy
 	init( LOAD_BALANCE_TSS_TIMEOUT,                            5.0 );
+	init( LOAD_BALANCE_TSS_SAMPLE_RATE,                        1.0 ); if( randomize && BUGGIFY ) LOAD_BALANCE_TSS_SAMPLE_RATE = deterministicRandom()->random01(); // Fraction of requests to a storage server with a TSS pair that are also sent to the TSS and compared
 	init( LOAD_BALANCE_TSS_MISMATCH_VERIFY_SS,                true ); if( randomize && BUGGIFY ) LOAD_BALANCE_TSS_MISMATCH_VERIFY_SS = false; // Whether the client should validate the SS teams all agree on TSS mismatch
 	init( LOAD_BALANCE_TSS_MISMATCH_TRACE_FULL,              false ); if( randomize && BUGGIFY ) LOAD_BALANCE_TSS_MISMATCH_TRACE_FULL = true; // If true, saves the full details of the mismatch in a trace event. If false, saves them in the DB and the trace event references the DB row.
 	init( TSS_LARGE_TRACE_SIZE,                              50000 );
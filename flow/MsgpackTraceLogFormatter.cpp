@@ -0,0 +1,163 @@
+/*
+ * MsgpackTraceLogFormatter.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "flow/MsgpackTraceLogFormatter.h"
+#include "flow/CompressionUtils.h"
+#include "flow/UnitTest.h"
+
+void MsgpackTraceLogFormatter::addref() {
+	ReferenceCounted<MsgpackTraceLogFormatter>::addref();
+}
+
+void MsgpackTraceLogFormatter::delref() {
+	ReferenceCounted<MsgpackTraceLogFormatter>::delref();
+}
+
+const char* MsgpackTraceLogFormatter::getExtension() const {
+	return "msgpack";
+}
+
+const char* MsgpackTraceLogFormatter::getHeader() const {
+	return MSGPACK_TRACE_MAGIC;
+}
+
+const char* MsgpackTraceLogFormatter::getFooter() const {
+	return "";
+}
+
+namespace {
+
+// flow/Msgpack.h is not used here because it traces, and this runs on the trace writer thread
+
+void appendBigEndian(std::string& out, uint32_t value, int bytes) {
+	for (int i = bytes - 1; i >= 0; i--) {
+		out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+	}
+}
+
+void appendLittleEndian(std::string& out, uint32_t value) {
+	for (int i = 0; i < 4; i++) {
+		out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+	}
+}
+
+void appendString(std::string& out, const std::string& s) {
+	if (s.size() <= 31) {
+		out.push_back(static_cast<char>(0xa0 | s.size()));
+	} else if (s.size() <= 0xff) {
+		out.push_back(static_cast<char>(0xd9));
+		appendBigEndian(out, s.size(), 1);
+	} else if (s.size() <= 0xffff) {
+		out.push_back(static_cast<char>(0xda));
+		appendBigEndian(out, s.size(), 2);
+	} else {
+		out.push_back(static_cast<char>(0xdb));
+		appendBigEndian(out, s.size(), 4);
+	}
+	out.append(s);
+}
+
+void appendEvent(std::string& out, const TraceEventFields& fields) {
+	size_t size = fields.size();
+	if (size <= 15) {
+		out.push_back(static_cast<char>(0x80 | size));
+	} else if (size <= 0xffff) {
+		out.push_back(static_cast<char>(0xde));
+		appendBigEndian(out, size, 2);
+	} else {
+		out.push_back(static_cast<char>(0xdf));
+		appendBigEndian(out, size, 4);
+	}
+	for (const auto& [name, value] : fields) {
+		appendString(out, name);
+		appendString(out, value);
+	}
+}
+
+std::string makeBlock(const std::string& raw) {
+	CompressionFilter filter = CompressionUtils::supportedFilters.count(CompressionFilter::ZSTD)
+	                               ? CompressionFilter::ZSTD
+	                               : CompressionFilter::NONE;
+	Arena arena;
+	StringRef stored = CompressionUtils::compress(filter, StringRef(raw), arena);
+	if (stored.size() >= raw.size()) {
+		filter = CompressionFilter::NONE;
+		stored = StringRef(raw);
+	}
+
+	std::string block;
+	block.reserve(9 + stored.size());
+	appendLittleEndian(block, raw.size());
+	appendLittleEndian(block, stored.size());
+	block.push_back(static_cast<char>(filter));
+	block.append(reinterpret_cast<const char*>(stored.begin()), stored.size());
+	return block;
+}
+
+} // namespace
+
+std::string MsgpackTraceLogFormatter::formatEvent(const TraceEventFields& fields) const {
+	std::string raw;
+	appendEvent(raw, fields);
+	return makeBlock(raw);
+}
+
+std::string MsgpackTraceLogFormatter::formatEvents(const std::vector<TraceEventFields>& events) const {
+	if (events.empty()) {
+		return std::string();
+	}
+	std::string raw;
+	for (const auto& event : events) {
+		appendEvent(raw, event);
+	}
+	return makeBlock(raw);
+}
+
+TEST_CASE("/flow/MsgpackTraceLogFormatter/block") {
+	MsgpackTraceLogFormatter formatter;
+	std::vector<TraceEventFields> events(2);
+	events[0].addField("Type", "Short");
+	events[1].addField("Type", "Long");
+	events[1].addField("Detail", std::string(300, 'x'));
+
+	std::string block = formatter.formatEvents(events);
+	auto readLittleEndian = [&](int offset) {
+		uint32_t value = 0;
+		for (int i = 3; i >= 0; i--) {
+			value = (value << 8) | static_cast<uint8_t>(block[offset + i]);
+		}
+		return value;
+	};
+	uint32_t rawLength = readLittleEndian(0);
+	uint32_t storedLength = readLittleEndian(4);
+	ASSERT(block.size() == 9 + storedLength);
+	// two maps, four field names and values, and the 300 byte value
+	ASSERT(rawLength == 2 + (1 + 4) + (1 + 5) + (1 + 4) + (1 + 4) + (1 + 6) + (3 + 300));
+
+	Arena arena;
+	StringRef stored(reinterpret_cast<const uint8_t*>(block.data()) + 9, storedLength);
+	StringRef raw = CompressionUtils::decompress(static_cast<CompressionFilter>(block[8]), stored, arena);
+	ASSERT(raw.size() == rawLength);
+	ASSERT(raw[0] == 0x81 && raw[1] == (0xa0 | 4) && raw.substr(2, 4) == "Type"_sr);
+	ASSERT(raw[raw.size() - 301] == 0x2c && raw[raw.size() - 302] == 0x01 && raw[raw.size() - 303] == 0xda);
+
+	ASSERT(formatter.formatEvents({}).empty());
+	return Void();
+}
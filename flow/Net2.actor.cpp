@@ -269,7 +269,18 @@ public:
 
 	TaskQueue<PromiseTask> taskQueue;
 
+	double idleSpinTime; // Current budget for spinBeforeSleep(), adapted between calls
+	void spinBeforeSleep();
+
 	void checkForSlowTask(int64_t tscBegin, int64_t tscEnd, double duration, TaskPriority priority);
+
+	// Run loop time of one in every ACTOR_PROFILE_SAMPLE_TASKS tasks, by priority and the actor the task woke up
+	std::map<std::pair<TaskPriority, const char*>, double> actorProfile;
+	int tasksUntilActorSample;
+	double lastActorProfileLog;
+	void sampleActorProfile(TaskPriority priority, double duration);
+	void logActorProfile(double now);
+
 	bool check_yield(TaskPriority taskId, int64_t tscNow);
 	void trackAtPriority(TaskPriority priority, double now);
 	void stopImmediately() {
@@ -292,6 +303,7 @@ public:
 	Int64MetricHandle countUDPReads;
 	Int64MetricHandle countWouldBlock;
 	Int64MetricHandle countWrites;
+	Int64MetricHandle countCoalescedWrites;
 	Int64MetricHandle countUDPWrites;
 	Int64MetricHandle countRunLoop;
 	Int64MetricHandle countTasks;
@@ -337,6 +349,56 @@ static udp::endpoint udpEndpoint(NetworkAddress const& n) {
 	return udp::endpoint(tcpAddress(n.ip), n.port);
 }
 
+// TCP Fast Open lets a connection to a server that has been reached before carry its first bytes (the connect packet,
+// or the TLS client hello) in the SYN, which saves a round trip on every reconnect. Both ends have to enable it, and it
+// falls back to a normal handshake when they don't.
+static void setFastOpenConnect(tcp::socket& socket, tcp::endpoint const& to) {
+#if defined(__linux__) && defined(TCP_FASTOPEN_CONNECT)
+	if (FLOW_KNOBS->FLOW_TCP_FASTOPEN > 0) {
+		boost::system::error_code error;
+		socket.open(to.protocol(), error);
+		if (!error) {
+			socket.set_option(boost::asio::detail::socket_option::boolean<IPPROTO_TCP, TCP_FASTOPEN_CONNECT>(true),
+			                  error);
+		}
+		if (error) {
+			TraceEvent(SevWarn, "N2_FastOpenConnectError").suppressFor(60.0).detail("Message", error.message());
+		}
+	}
+#endif
+}
+
+static void setFastOpenListen(tcp::acceptor& acceptor) {
+	if (FLOW_KNOBS->FLOW_TCP_FASTOPEN > 0) {
+#ifdef __linux__
+		boost::system::error_code error;
+		acceptor.set_option(
+		    boost::asio::detail::socket_option::integer<IPPROTO_TCP, TCP_FASTOPEN>(FLOW_KNOBS->FLOW_TCP_FASTOPEN),
+		    error);
+		if (error) {
+			TraceEvent(SevWarn, "N2_FastOpenListenError").detail("Message", error.message());
+		}
+#else
+		TraceEvent(SevWarn, "N2_InitWarn").detail("Message", "TCP_FASTOPEN not supported");
+#endif
+	}
+}
+
+// Thin stream mode keeps retransmission timeouts from backing off exponentially while only a few packets are in
+// flight, which is the usual state of a connection carrying small requests and replies, so a lost packet costs one
+// timeout instead of several on a lossy network.
+static void setThinStream(tcp::socket& socket) {
+	if (FLOW_KNOBS->FLOW_TCP_THIN_STREAMS) {
+#if defined(__linux__) && defined(TCP_THIN_LINEAR_TIMEOUTS)
+		boost::system::error_code error;
+		socket.set_option(boost::asio::detail::socket_option::boolean<IPPROTO_TCP, TCP_THIN_LINEAR_TIMEOUTS>(true),
+		                  error);
+#else
+		TraceEvent(SevWarn, "N2_InitWarn").suppressFor(60.0).detail("Message", "TCP_THIN_LINEAR_TIMEOUTS not supported");
+#endif
+	}
+}
+
 class BindPromise {
 	Promise<Void> p;
 	const char* errContext;
@@ -392,6 +454,7 @@ public:
 		self->peer_address = addr;
 		try {
 			auto to = tcpEndpoint(addr);
+			setFastOpenConnect(self->socket, to);
 			BindPromise p("N2_ConnectError", self->id);
 			Future<Void> onConnected = p.getFuture();
 			self->socket.async_connect(to, std::move(p));
@@ -516,6 +579,7 @@ private:
 			TraceEvent(SevWarn, "N2_InitWarn").detail("Message", "TCP_QUICKACK not supported");
 #endif
 		}
+		setThinStream(socket);
 		platform::setCloseOnExec(socket.native_handle());
 	}
 
@@ -741,6 +805,7 @@ public:
 			    NetworkAddress::parse(acceptor.local_endpoint().address().to_string().append(":").append(
 			        std::to_string(acceptor.local_endpoint().port())));
 		}
+		setFastOpenListen(acceptor);
 		platform::setCloseOnExec(acceptor.native_handle());
 	}
 
@@ -865,6 +930,7 @@ public:
 		self->peer_address = addr;
 		try {
 			auto to = tcpEndpoint(self->peer_address);
+			setFastOpenConnect(self->socket, to);
 			BindPromise p("N2_ConnectError", self->id);
 			Future<Void> onConnected = p.getFuture();
 			self->socket.async_connect(to, std::move(p));
@@ -908,6 +974,7 @@ public:
 				self->ssl_sock.async_handshake(boost::asio::ssl::stream_base::server, std::move(p));
 			}
 			wait(onHandshook);
+			self->logSessionEstablished();
 			wait(delay(0, TaskPriority::Handshake));
 			connected.send(Void());
 		} catch (...) {
@@ -990,6 +1057,7 @@ public:
 				self->ssl_sock.async_handshake(boost::asio::ssl::stream_base::client, std::move(p));
 			}
 			wait(onHandshook);
+			self->logSessionEstablished();
 			wait(delay(0, TaskPriority::Handshake));
 			connected.send(Void());
 		} catch (...) {
@@ -1083,8 +1151,27 @@ public:
 		boost::system::error_code err;
 		++g_net2->countWrites;
 
-		size_t sent = ssl_sock.write_some(
-		    boost::iterator_range<SendBufferIterator>(SendBufferIterator(data, limit), SendBufferIterator()), err);
+		// An SSL write_some() only writes the first buffer of a sequence, as one TLS record and usually one send()
+		// call. When the packet queue holds several buffers, copy up to a full record's worth of them together
+		// instead.
+		size_t sent;
+		int coalesceBytes = std::min(limit, FLOW_KNOBS->TLS_WRITE_COALESCE_BYTES);
+		if (data->next && data->bytes_written - data->bytes_sent < coalesceBytes) {
+			if (!writeCoalesceBuffer) {
+				writeCoalesceBuffer.reset(new uint8_t[FLOW_KNOBS->TLS_WRITE_COALESCE_BYTES]);
+			}
+			int len = 0;
+			for (auto p = data; p && len < coalesceBytes; p = p->next) {
+				int n = std::min(p->bytes_written - p->bytes_sent, coalesceBytes - len);
+				memcpy(writeCoalesceBuffer.get() + len, p->data() + p->bytes_sent, n);
+				len += n;
+			}
+			++g_net2->countCoalescedWrites;
+			sent = ssl_sock.write_some(boost::asio::const_buffer(writeCoalesceBuffer.get(), len), err);
+		} else {
+			sent = ssl_sock.write_some(
+			    boost::iterator_range<SendBufferIterator>(SendBufferIterator(data, limit), SendBufferIterator()), err);
+		}
 
 		if (err) {
 			// Since there was an error, sent's value can't be used to infer that the buffer has data and the limit is
@@ -1128,11 +1215,13 @@ private:
 	NetworkAddress peer_address;
 	Reference<ReferencedObject<boost::asio::ssl::context>> sslContext;
 	bool has_trusted_peer;
+	std::unique_ptr<uint8_t[]> writeCoalesceBuffer;
 
 	void init() {
 		// Socket settings that have to be set after connect or accept succeeds
 		socket.non_blocking(true);
 		socket.set_option(boost::asio::ip::tcp::no_delay(true));
+		setThinStream(socket);
 		platform::setCloseOnExec(socket.native_handle());
 	}
 
@@ -1145,6 +1234,16 @@ private:
 		ssl_sock.shutdown(shutdownError);
 	}
 
+	// Records are encrypted on the network thread through asio's in-memory BIOs, which also rules out kernel TLS
+	// offload, so the negotiated cipher is what decides the CPU cost of a connection.
+	void logSessionEstablished() {
+		SSL* ssl = ssl_sock.native_handle();
+		TraceEvent(SevDebug, "N2_TLSSessionEstablished", id)
+		    .detail("PeerAddr", peer_address)
+		    .detail("Version", SSL_get_version(ssl))
+		    .detail("Cipher", SSL_get_cipher_name(ssl));
+	}
+
 	void onReadError(const boost::system::error_code& error) {
 		TraceEvent(SevWarn, "N2_ReadError", id)
 		    .suppressFor(1.0)
@@ -1185,6 +1284,7 @@ public:
 			                                                .append(std::to_string(acceptor.local_endpoint().port()))
 			                                                .append(listenAddress.isTLS() ? ":tls" : ""));
 		}
+		setFastOpenListen(acceptor);
 		platform::setCloseOnExec(acceptor.native_handle());
 	}
 
@@ -1227,7 +1327,8 @@ Net2::Net2(const TLSConfig& tlsConfig, bool useThreadPool, bool useMetrics)
     sslHandshakerThreadsStarted(0), sslPoolHandshakesInProgress(0), tlsConfig(tlsConfig),
     tlsInitializedState(ETLSInitState::NONE), network(this), tscBegin(0), tscEnd(0), taskBegin(0),
     currentTaskID(TaskPriority::DefaultYield), stopped(false), started(false), numYields(0),
-    lastPriorityStats(nullptr) {
+    lastPriorityStats(nullptr), idleSpinTime(FLOW_KNOBS->NET2_IDLE_SPIN_MAX_TIME),
+    tasksUntilActorSample(FLOW_KNOBS->ACTOR_PROFILE_SAMPLE_TASKS), lastActorProfileLog(0) {
 	// Until run() is called, yield() will always yield
 	TraceEvent("Net2Starting").log();
 
@@ -1381,6 +1482,7 @@ void Net2::initMetrics() {
 	countReads.init("Net2.CountReads"_sr);
 	countWouldBlock.init("Net2.CountWouldBlock"_sr);
 	countWrites.init("Net2.CountWrites"_sr);
+	countCoalescedWrites.init("Net2.CountCoalescedWrites"_sr);
 	countRunLoop.init("Net2.CountRunLoop"_sr);
 	countTasks.init("Net2.CountTasks"_sr);
 	countYields.init("Net2.CountYields"_sr);
@@ -1434,6 +1536,8 @@ void Net2::run() {
 	runCycleFuncPtr runFunc = reinterpret_cast<runCycleFuncPtr>(
 	    reinterpret_cast<flowGlobalType>(g_network->global(INetwork::enRunCycleFunc)));
 
+	taskQueue.setFairShare(FLOW_KNOBS->NET2_FAIR_SCHEDULING_SHARE);
+
 	started.store(true);
 	double nnow = timer_monotonic();
 
@@ -1445,6 +1549,7 @@ void Net2::run() {
 			tscBegin = timestampCounter();
 			taskBegin = nnow;
 			trackAtPriority(TaskPriority::RunCycleFunction, taskBegin);
+			currentTaskActorName = nullptr;
 			runFunc();
 			double taskEnd = timer_monotonic();
 			trackAtPriority(TaskPriority::RunLoop, taskEnd);
@@ -1452,6 +1557,10 @@ void Net2::run() {
 			checkForSlowTask(tscBegin, timestampCounter(), taskEnd - taskBegin, TaskPriority::RunCycleFunction);
 		}
 
+		if (FLOW_KNOBS->NET2_IDLE_SPIN_MAX_TIME > 0 && !taskQueue.hasReadyTask()) {
+			spinBeforeSleep();
+		}
+
 		double sleepTime = 0;
 		if (taskQueue.canSleep()) {
 			sleepTime = 1e99;
@@ -1474,6 +1583,7 @@ void Net2::run() {
 		tscBegin = timestampCounter();
 		taskBegin = timer_monotonic();
 		trackAtPriority(TaskPriority::ASIOReactor, taskBegin);
+		currentTaskActorName = nullptr;
 		reactor.react();
 		tasksSinceReact = 0;
 
@@ -1500,15 +1610,18 @@ void Net2::run() {
 		[[maybe_unused]] int queueSize = taskQueue.getNumReadyTasks();
 
 		FDB_TRACE_PROBE(run_loop_tasks_start, queueSize);
+		taskQueue.startCycle();
 		while (taskQueue.hasReadyTask()) {
 			++countTasks;
 			currentTaskID = taskQueue.getReadyTaskID();
+			TaskPriority scheduledTaskID = currentTaskID;
 			priorityMetric = static_cast<int64_t>(currentTaskID);
 			PromiseTask* task = taskQueue.getReadyTask();
 			taskQueue.popReadyTask();
 
 			try {
 				++tasksSinceReact;
+				currentTaskActorName = nullptr;
 				(*task)();
 			} catch (Error& e) {
 				TraceEvent(SevError, "TaskError").error(e);
@@ -1532,6 +1645,11 @@ void Net2::run() {
 
 			double tscNow = timestampCounter();
 			double newTaskBegin = timer_monotonic();
+			taskQueue.chargeTask(scheduledTaskID, newTaskBegin - taskBegin);
+			if (FLOW_KNOBS->ACTOR_PROFILE_SAMPLE_TASKS > 0 && --tasksUntilActorSample <= 0) {
+				tasksUntilActorSample = FLOW_KNOBS->ACTOR_PROFILE_SAMPLE_TASKS;
+				sampleActorProfile(scheduledTaskID, newTaskBegin - taskBegin);
+			}
 			if (check_yield(TaskPriority::Max, tscNow)) {
 				checkForSlowTask(tscBegin, tscNow, newTaskBegin - taskBegin, currentTaskID);
 				taskBegin = newTaskBegin;
@@ -1595,6 +1713,11 @@ void Net2::run() {
 #endif
 		nnow = timer_monotonic();
 
+		if (FLOW_KNOBS->ACTOR_PROFILE_SAMPLE_TASKS > 0 &&
+		    nnow - lastActorProfileLog >= FLOW_KNOBS->ACTOR_PROFILE_LOG_INTERVAL) {
+			logActorProfile(nnow);
+		}
+
 		if ((nnow - now) > FLOW_KNOBS->SLOW_LOOP_CUTOFF &&
 		    nondeterministicRandom()->random01() < (nnow - now) * FLOW_KNOBS->SLOW_LOOP_SAMPLING_RATE)
 			TraceEvent("SomewhatSlowRunLoopBottom")
@@ -1631,6 +1754,23 @@ void Net2::updateStarvationTracker(struct NetworkMetrics::PriorityStats& binStat
 	}
 }
 
+// A completion from another thread (e.g. an IThreadPool result or ThreadSafeTransaction call) that arrives after the
+// run loop has gone to sleep costs the sender a reactor wake and the run loop a trip through the reactor. When such
+// completions tend to arrive within microseconds, polling for them briefly first is cheaper. The budget doubles when a
+// spin catches one and halves when it doesn't, so an idle process settles on short spins.
+void Net2::spinBeforeSleep() {
+	const double maxSpin = FLOW_KNOBS->NET2_IDLE_SPIN_MAX_TIME;
+	double spinEnd = timer_monotonic() + idleSpinTime;
+	while (!taskQueue.hasThreadReady()) {
+		if (timer_monotonic() >= spinEnd) {
+			idleSpinTime = std::max(idleSpinTime / 2, maxSpin / 16);
+			return;
+		}
+		spinPause();
+	}
+	idleSpinTime = std::min(idleSpinTime * 2, maxSpin);
+}
+
 // Update both vectors of starvation trackers (one that updates every 5s and the other every 1s)
 void Net2::trackAtPriority(TaskPriority priority, double now) {
 	if (lastPriorityStats == nullptr || priority != lastPriorityStats->priority) {
@@ -1689,8 +1829,43 @@ void Net2::checkForSlowTask(int64_t tscBegin, int64_t tscEnd, double duration, T
 			    .detail("MClocks", elapsed / 1e6)
 			    .detail("Duration", duration)
 			    .detail("SampleRate", sampleRate)
-			    .detail("NumYields", numYields);
+			    .detail("NumYields", numYields)
+			    .detail("Actor", currentTaskActorName ? currentTaskActorName : "");
+	}
+}
+
+void Net2::sampleActorProfile(TaskPriority priority, double duration) {
+	actorProfile[std::make_pair(priority, currentTaskActorName)] += duration;
+}
+
+// Logs the sampled profile as folded stacks ("Priority;Actor Microseconds"), which flame graph tools take as input. The
+// time is scaled up by the sampling rate to estimate the whole interval.
+void Net2::logActorProfile(double now) {
+	if (lastActorProfileLog > 0 && !actorProfile.empty()) {
+		// The same actor name may be at several addresses, so merge by the name itself
+		std::map<std::string, double> stacks;
+		for (auto const& [key, seconds] : actorProfile) {
+			stacks[format("%d;%s", static_cast<int>(key.first), key.second ? key.second : "(none)")] += seconds;
+		}
+		std::vector<std::pair<double, std::string>> sorted;
+		sorted.reserve(stacks.size());
+		for (auto& [stack, seconds] : stacks) {
+			sorted.emplace_back(seconds, stack);
+		}
+		int n = std::min<int>(sorted.size(), FLOW_KNOBS->ACTOR_PROFILE_MAX_STACKS);
+		std::partial_sort(sorted.begin(), sorted.begin() + n, sorted.end(), std::greater<>());
+
+		TraceEvent ev("ActorProfile");
+		ev.detail("Elapsed", now - lastActorProfileLog).detail("Stacks", stacks.size());
+		for (int i = 0; i < n; ++i) {
+			ev.detail(format("Stack%d", i),
+			          format("%s %lld",
+			                 sorted[i].second.c_str(),
+			                 (long long)(sorted[i].first * FLOW_KNOBS->ACTOR_PROFILE_SAMPLE_TASKS * 1e6)));
+		}
 	}
+	actorProfile.clear();
+	lastActorProfileLog = now;
 }
 
 bool Net2::check_yield(TaskPriority taskID, int64_t tscNow) {
@@ -2088,10 +2263,12 @@ THREAD_HANDLE startThreadF(F&& func) {
 
 TEST_CASE("flow/Net2/ThreadSafeQueue/Interface") {
 	ThreadSafeQueue<int> tq;
+	ASSERT(!tq.hasPending());
 	ASSERT(!tq.pop().present());
 	ASSERT(tq.canSleep());
 
 	ASSERT(tq.push(1) == true);
+	ASSERT(tq.hasPending());
 	ASSERT(!tq.canSleep());
 	ASSERT(!tq.canSleep());
 	ASSERT(tq.push(2) == false);
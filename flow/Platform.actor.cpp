@@ -295,6 +295,34 @@ double getProcessorTimeProcess() {
 #endif
 }
 
+std::string getProcessCPUAffinity() {
+#if defined(__linux__)
+	cpu_set_t cpus;
+	CPU_ZERO(&cpus);
+	if (sched_getaffinity(0, sizeof(cpus), &cpus) != 0) {
+		return std::string();
+	}
+	std::string result;
+	for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+		if (!CPU_ISSET(cpu, &cpus)) {
+			continue;
+		}
+		int last = cpu;
+		while (last + 1 < CPU_SETSIZE && CPU_ISSET(last + 1, &cpus)) {
+			last++;
+		}
+		if (!result.empty()) {
+			result += ',';
+		}
+		result += last == cpu ? std::to_string(cpu) : fmt::format("{}-{}", cpu, last);
+		cpu = last;
+	}
+	return result;
+#else
+	return std::string();
+#endif
+}
+
 uint64_t getResidentMemoryUsage() {
 #if defined(__linux__)
 	uint64_t rssize = 0;
@@ -71,7 +71,8 @@ SystemStatistics getSystemStatistics() {
 #define DETAILALLOCATORMEMUSAGE(size)                                                                                  \
 	detail("TotalMemory" #size, FastAllocator<size>::getTotalMemory())                                                 \
 	    .detail("ApproximateUnusedMemory" #size, FastAllocator<size>::getApproximateMemoryUnused())                    \
-	    .detail("ActiveThreads" #size, FastAllocator<size>::getActiveThreads())
+	    .detail("ActiveThreads" #size, FastAllocator<size>::getActiveThreads())                                        \
+	    .detail("GlobalLockContentions" #size, FastAllocator<size>::getGlobalLockContentions())
 
 namespace {
 
@@ -114,6 +115,7 @@ SystemStatistics customSystemMonitor(std::string const& eventName, StatisticsSta
 			    .detail("Elapsed", currentStats.elapsed)
 			    .detail("CPUSeconds", currentStats.processCPUSeconds)
 			    .detail("MainThreadCPUSeconds", currentStats.mainThreadCPUSeconds)
+			    .detail("CPUAffinity", getProcessCPUAffinity())
 			    .detail("UptimeSeconds", now() - machineState.monitorStartTime)
 			    .detail("Memory", currentStats.processMemory)
 			    .detail("ResidentMemory", currentStats.processResidentMemory)
@@ -241,6 +243,7 @@ SystemStatistics customSystemMonitor(std::string const& eventName, StatisticsSta
 			n.detail("Elapsed", currentStats.elapsed)
 			    .detail("CantSleep", netData.countCantSleep - statState->networkState.countCantSleep)
 			    .detail("WontSleep", netData.countWontSleep - statState->networkState.countWontSleep)
+			    .detail("FairScheduled", netData.countFairScheduled - statState->networkState.countFairScheduled)
 			    .detail("Yields", netData.countYields - statState->networkState.countYields)
 			    .detail("YieldCalls", netData.countYieldCalls - statState->networkState.countYieldCalls)
 			    .detail("YieldCallsTrue", netData.countYieldCallsTrue - statState->networkState.countYieldCallsTrue)
@@ -253,11 +256,15 @@ SystemStatistics customSystemMonitor(std::string const& eventName, StatisticsSta
 			    .detail("ASIOEventsProcessed", netData.countASIOEvents - statState->networkState.countASIOEvents)
 			    .detail("ReadCalls", netData.countReads - statState->networkState.countReads)
 			    .detail("WriteCalls", netData.countWrites - statState->networkState.countWrites)
+			    .detail("CoalescedWriteCalls",
+			            netData.countCoalescedWrites - statState->networkState.countCoalescedWrites)
 			    .detail("ReadProbes", netData.countReadProbes - statState->networkState.countReadProbes)
 			    .detail("WriteProbes", netData.countWriteProbes - statState->networkState.countWriteProbes)
 			    .detail("PacketsRead", netData.countPacketsReceived - statState->networkState.countPacketsReceived)
 			    .detail("PacketsGenerated",
 			            netData.countPacketsGenerated - statState->networkState.countPacketsGenerated)
+			    .detail("BytesSavedByCompression",
+			            netData.bytesSavedByCompression - statState->networkState.bytesSavedByCompression)
 			    .detail("WouldBlock", netData.countWouldBlock - statState->networkState.countWouldBlock)
 			    .detail("LaunchTime", netData.countLaunchTime - statState->networkState.countLaunchTime)
 			    .detail("ReactTime", netData.countReactTime - statState->networkState.countReactTime)
@@ -0,0 +1,88 @@
+/*
+ * TimerWheel.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// At the moment, this file just contains tests.  TimerWheel<> is a template
+// and so all the important implementation is in the header file
+
+#include "flow/TimerWheel.h"
+#include "flow/IRandom.h"
+#include "flow/UnitTest.h"
+
+namespace {
+
+struct TestTimer {
+	double at;
+	int id;
+	bool operator<(TestTimer const& rhs) const { return at > rhs.at; } // Ordering is reversed for priority_queue
+};
+
+double randomTimerDelay() {
+	switch (deterministicRandom()->randomInt(0, 5)) {
+	case 0:
+		return 0;
+	case 1:
+		return deterministicRandom()->random01() * 0.01;
+	case 2:
+		return deterministicRandom()->random01() * 60;
+	case 3:
+		// Past the last wheel level, into the overflow heap
+		return deterministicRandom()->random01() * 1e6;
+	default:
+		return -deterministicRandom()->random01();
+	}
+}
+
+} // namespace
+
+TEST_CASE("/flow/TimerWheel/matches priority_queue") {
+	for (int t = 0; t < 20; t++) {
+		TimerWheel<TestTimer> wheel(deterministicRandom()->coinflip() ? 0.001 : 1e-6);
+		std::priority_queue<TestTimer> heap;
+		double now = deterministicRandom()->random01() * 1e5;
+		int ops = deterministicRandom()->randomInt(0, 100000);
+
+		for (int i = 0; i < ops; i++) {
+			if (heap.empty() || deterministicRandom()->random01() < 0.55) {
+				TestTimer timer{ now + randomTimerDelay(), i };
+				wheel.push(timer);
+				heap.push(timer);
+			} else {
+				// Like TaskQueue::processReadyTimers, time only moves forward to the earliest timer
+				ASSERT(wheel.top().at == heap.top().at);
+				now = std::max(now, heap.top().at);
+				wheel.pop();
+				heap.pop();
+			}
+			ASSERT(wheel.size() == heap.size());
+		}
+
+		while (!heap.empty()) {
+			ASSERT(wheel.top().at == heap.top().at);
+			wheel.pop();
+			heap.pop();
+		}
+		ASSERT(wheel.empty());
+
+		wheel.push(TestTimer{ now, 0 });
+		wheel.clear();
+		ASSERT(wheel.empty());
+	}
+	return Void();
+}
@@ -23,6 +23,7 @@
 #include "flow/Knobs.h"
 #include "flow/XmlTraceLogFormatter.h"
 #include "flow/JsonTraceLogFormatter.h"
+#include "flow/MsgpackTraceLogFormatter.h"
 #include "flow/flow.h"
 #include "flow/DeterministicRandom.h"
 #include <exception>
@@ -60,6 +61,14 @@ thread_local int failedLineOverflow = 0;
 
 ITraceLogIssuesReporter::~ITraceLogIssuesReporter() {}
 
+std::string ITraceLogFormatter::formatEvents(const std::vector<TraceEventFields>& events) const {
+	std::string result;
+	for (const auto& event : events) {
+		result += formatEvent(event);
+	}
+	return result;
+}
+
 struct SuppressionMap {
 	struct SuppressionInfo {
 		double endTime;
@@ -258,8 +267,8 @@ public:
 		void action(WriteBuffer& a) {
 			for (const auto& event : a.events) {
 				event.validateFormat();
-				logWriter->write(formatter->formatEvent(event));
 			}
+			logWriter->write(formatter->formatEvents(a.events));
 
 			if (FLOW_KNOBS->TRACE_SYNC_ENABLED) {
 				logWriter->sync();
@@ -686,6 +695,11 @@ bool traceFormatImpl(std::string& format) {
 			g_traceLog.formatter = Reference<ITraceLogFormatter>(new JsonTraceLogFormatter());
 		}
 		return true;
+	} else if (format == "msgpack") {
+		if (!validate) {
+			g_traceLog.formatter = Reference<ITraceLogFormatter>(new MsgpackTraceLogFormatter());
+		}
+		return true;
 	} else {
 		if (!validate) {
 			g_traceLog.formatter = Reference<ITraceLogFormatter>(new XmlTraceLogFormatter());
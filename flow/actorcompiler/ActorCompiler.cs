@@ -421,7 +421,7 @@ namespace actorcompiler
 
             string callback_base_classes = string.Join(", ", callbacks.Select(c=>string.Format("public {0}", c.type)));
             if (callback_base_classes != "") callback_base_classes += ", ";
-            writer.WriteLine("class {0} final : public Actor<{2}>, {3}public FastAllocated<{1}>, public {4} {{",
+            writer.WriteLine("class {0} final : public Actor<{2}>, {3}public FastAllocated<{1}, kFastAllocatedActorMaxPooledSize>, public {4} {{",
                 className,
                 fullClassName,
                 actor.returnType == null ? "void" : actor.returnType,
@@ -429,8 +429,8 @@ namespace actorcompiler
                 fullStateClassName
                 );
             writer.WriteLine("public:");
-            writer.WriteLine("\tusing FastAllocated<{0}>::operator new;", fullClassName);
-            writer.WriteLine("\tusing FastAllocated<{0}>::operator delete;", fullClassName);
+            writer.WriteLine("\tusing FastAllocated<{0}, kFastAllocatedActorMaxPooledSize>::operator new;", fullClassName);
+            writer.WriteLine("\tusing FastAllocated<{0}, kFastAllocatedActorMaxPooledSize>::operator delete;", fullClassName);
 
             writer.WriteLine("#pragma clang diagnostic push");
             writer.WriteLine("#pragma clang diagnostic ignored \"-Wdelete-non-virtual-dtor\"");
@@ -502,6 +502,11 @@ namespace actorcompiler
             }
         }
 
+        // Lets Net2 attribute the run loop task to this actor (see currentTaskActorName in flow.h)
+        void RecordTaskActor(Function fun) {
+            fun.WriteLine("recordTaskActor(\"{0}\");", actor.name);
+        }
+
         void LineNumber(TextWriter writer, int SourceLine)
         {
             if(SourceLine == 0)
@@ -878,6 +883,7 @@ namespace actorcompiler
                 functions.Add(string.Format("{0}#{1}", cbFunc.name, ch.Index), cbFunc);
                 cbFunc.Indent(codeIndent);
                 ProbeEnter(cbFunc, actor.name, ch.Index);
+                RecordTaskActor(cbFunc);
                 cbFunc.WriteLine("{0};", exitFunc.call());
 
                 Function _overload = cbFunc.popOverload();
@@ -905,6 +911,7 @@ namespace actorcompiler
                 functions.Add(string.Format("{0}#{1}", errFunc.name, ch.Index), errFunc);
                 errFunc.Indent(codeIndent);
                 ProbeEnter(errFunc, actor.name, ch.Index);
+                RecordTaskActor(errFunc);
                 errFunc.WriteLine("{0};", exitFunc.call());
                 TryCatch(cx.WithTarget(errFunc), cx.catchFErr, cx.tryLoopDepth, () =>
                 {
@@ -1298,6 +1305,7 @@ namespace actorcompiler
             constructor.WriteLine("{");
             constructor.Indent(+1);
             ProbeEnter(constructor, actor.name);
+            RecordTaskActor(constructor);
             constructor.WriteLine("#ifdef ENABLE_SAMPLING");
             constructor.WriteLine("this->lineage.setActorName(\"{0}\");", actor.name);
             constructor.WriteLine("LineageScope _(&this->lineage);");
@@ -492,6 +492,96 @@ TEST_CASE("/flow/FlatBuffers/VectorRef") {
 	return Void();
 }
 
+namespace {
+
+// std::deque is not contiguous, so it always takes the element by element path that vectors of scalars skip
+template <class T>
+void checkScalarVectorFastPath(std::vector<T> const& src) {
+	constexpr FileIdentifier id = 1234567;
+	std::deque<T> deq(src.begin(), src.end());
+	ObjectWriter vecWriter(Unversioned());
+	vecWriter.serialize(id, src);
+	ObjectWriter deqWriter(Unversioned());
+	deqWriter.serialize(id, deq);
+	ASSERT(vecWriter.toStringRef() == deqWriter.toStringRef());
+
+	Standalone<StringRef> msg(vecWriter.toStringRef());
+	{
+		std::vector<T> out{ T() };
+		ObjectReader reader(msg.begin(), Unversioned());
+		reader.deserialize(id, out);
+		ASSERT(out == src);
+	}
+	{
+		std::deque<T> out;
+		ObjectReader reader(msg.begin(), Unversioned());
+		reader.deserialize(id, out);
+		ASSERT(std::equal(out.begin(), out.end(), src.begin(), src.end()));
+	}
+	{
+		::Arena arena;
+		VectorRef<T> out;
+		ArenaObjectReader reader(arena, msg, Unversioned());
+		reader.deserialize(id, out);
+		ASSERT(std::equal(out.begin(), out.end(), src.begin(), src.end()));
+
+		ObjectWriter refWriter(Unversioned());
+		refWriter.serialize(id, out);
+		ASSERT(refWriter.toStringRef() == vecWriter.toStringRef());
+	}
+}
+
+// Vectors of bool take the element by element path
+void checkBoolVector(std::vector<bool> const& src) {
+	constexpr FileIdentifier id = 1234567;
+	ObjectWriter writer(Unversioned());
+	writer.serialize(id, src);
+	Standalone<StringRef> msg(writer.toStringRef());
+	{
+		std::vector<bool> out{ true };
+		ObjectReader reader(msg.begin(), Unversioned());
+		reader.deserialize(id, out);
+		ASSERT(out == src);
+	}
+	{
+		std::deque<bool> out;
+		ObjectReader reader(msg.begin(), Unversioned());
+		reader.deserialize(id, out);
+		ASSERT(std::equal(out.begin(), out.end(), src.begin(), src.end()));
+	}
+	{
+		::Arena arena;
+		VectorRef<bool> out;
+		ArenaObjectReader reader(arena, msg, Unversioned());
+		reader.deserialize(id, out);
+		ASSERT(std::equal(out.begin(), out.end(), src.begin(), src.end()));
+	}
+}
+
+} // namespace
+
+TEST_CASE("/flow/FlatBuffers/ScalarVectorFastPath") {
+	for (int t = 0; t < 10; ++t) {
+		int n = deterministicRandom()->randomInt(0, 1000);
+		std::vector<int64_t> i64s;
+		std::vector<uint8_t> bytes;
+		std::vector<double> doubles;
+		std::vector<bool> bools;
+		for (int i = 0; i < n; ++i) {
+			i64s.push_back(deterministicRandom()->randomInt64(std::numeric_limits<int64_t>::min(),
+			                                                  std::numeric_limits<int64_t>::max()));
+			bytes.push_back(deterministicRandom()->randomInt(0, 256));
+			doubles.push_back(deterministicRandom()->random01());
+			bools.push_back(deterministicRandom()->coinflip());
+		}
+		checkScalarVectorFastPath(i64s);
+		checkScalarVectorFastPath(bytes);
+		checkScalarVectorFastPath(doubles);
+		checkBoolVector(bools);
+	}
+	return Void();
+}
+
 TEST_CASE("/flow/FlatBuffers/Standalone") {
 	std::vector<Standalone<StringRef>> vecIn;
 	auto numElements = deterministicRandom()->randomInt(1, 20);
@@ -510,6 +600,28 @@ TEST_CASE("/flow/FlatBuffers/Standalone") {
 	return Void();
 }
 
+// FlowTransport delivers packets with an ArenaObjectReader over the receive buffer, and relies on StringRefs pointing
+// into that buffer rather than being copied out of it
+TEST_CASE("/flow/FlatBuffers/ArenaReaderZeroCopy") {
+	std::vector<StringRef> vecIn;
+	::Arena strings;
+	auto numElements = deterministicRandom()->randomInt(1, 20);
+	for (int i = 0; i < numElements; ++i) {
+		auto str = deterministicRandom()->randomAlphaNumeric(deterministicRandom()->randomInt(1, 1000));
+		vecIn.push_back(StringRef(strings, str));
+	}
+	Standalone<StringRef> value = ObjectWriter::toValue(vecIn, Unversioned());
+	ArenaObjectReader reader(value.arena(), value, Unversioned());
+	std::vector<StringRef> vecOut;
+	reader.deserialize(vecOut);
+	ASSERT(vecOut.size() == vecIn.size());
+	for (int i = 0; i < vecOut.size(); ++i) {
+		ASSERT(vecOut[i] == vecIn[i]);
+		ASSERT(vecOut[i].begin() >= value.begin() && vecOut[i].end() <= value.end());
+	}
+	return Void();
+}
+
 // Meant to be run with valgrind or asan, to catch heap buffer overflows
 TEST_CASE("/flow/FlatBuffers/Void") {
 	Standalone<StringRef> msg = ObjectWriter::toValue(Void(), Unversioned());
@@ -40,6 +40,7 @@
 std::atomic<bool> startSampling = false;
 LineageReference rootLineage;
 thread_local LineageReference* currentLineage = &rootLineage;
+thread_local const char* currentTaskActorName = nullptr;
 
 LineagePropertiesBase::~LineagePropertiesBase() {}
 
@@ -25,6 +25,7 @@
 #include "flow/Arena.h"
 
 #include <unordered_set>
+#include <vector>
 
 enum class CompressionFilter {
 	NONE,
@@ -37,6 +38,24 @@ struct CompressionUtils {
 	static StringRef compress(const CompressionFilter filter, const StringRef& data, int level, Arena& arena);
 	static StringRef decompress(const CompressionFilter filter, const StringRef& data, Arena& arena);
 
+	// Compression with a dictionary trained on similar data, for small values which compress poorly on their own.
+	// The same dictionary must be given to decompress(), and an empty dictionary is the same as none.
+	static StringRef compress(const CompressionFilter filter,
+	                          const StringRef& data,
+	                          int level,
+	                          const StringRef& dictionary,
+	                          Arena& arena);
+	static StringRef decompress(const CompressionFilter filter,
+	                            const StringRef& data,
+	                            const StringRef& dictionary,
+	                            Arena& arena);
+
+	// Trains a dictionary of at most maxSize bytes from samples of the data it will be used for. Returns an empty
+	// dictionary if the filter does not use one, or if the samples are too few or too varied to train one.
+	static Standalone<StringRef> trainDictionary(const CompressionFilter filter,
+	                                             const std::vector<StringRef>& samples,
+	                                             int maxSize);
+
 	static int getDefaultCompressionLevel(CompressionFilter filter);
 	static CompressionFilter getRandomFilter();
 
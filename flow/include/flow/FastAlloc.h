@@ -115,6 +115,8 @@ public:
 	static long long getTotalMemory();
 	static long long getApproximateMemoryUnused();
 	static long long getActiveThreads();
+	// Number of times a thread found the global magazine lock held by another thread
+	static long long getGlobalLockContentions();
 
 #ifdef ALLOC_INSTRUMENTATION
 	static volatile int32_t pageCount;
@@ -170,6 +172,7 @@ private:
 
 	static void getMagazine();
 	static void releaseMagazine(void*);
+	static void lockGlobalData();
 };
 
 extern std::atomic<int64_t> g_hugeArenaMemory;
@@ -177,6 +180,12 @@ void hugeArenaSample(int size);
 void releaseAllThreadMagazines();
 int64_t getTotalUnusedAllocatedMemory();
 
+// Allocate and free 4k aligned buffers too large for FastAllocator.  Freed buffers are kept in per-thread free lists
+// by size, up to FLOW_KNOBS->ALIGNED_BUFFER_CACHE_BYTES per thread, so that page and IO buffers of the same few sizes
+// are reused instead of being returned to and faulted back in from the system allocator.
+[[nodiscard]] void* allocateCached4kAligned(int size);
+void freeCached4kAligned(int size, void* ptr);
+
 inline constexpr int nextFastAllocatedSize(int x) {
 	assert(x > 0 && x <= 16384);
 	if (x <= 16)
@@ -205,7 +214,12 @@ inline constexpr int nextFastAllocatedSize(int x) {
 		return 16384;
 }
 
-template <class Object>
+// Actor frames are created and destroyed once per actor invocation, so the actor compiler pools them in FastAllocator
+// size classes up to this size instead of the default 256 bytes for other FastAllocated types.
+inline constexpr int kFastAllocatedActorMaxPooledSize = 4096;
+
+// Objects of at most MaxPooledSize bytes are allocated from FastAllocator, larger ones from the system allocator
+template <class Object, int MaxPooledSize = 256>
 class FastAllocated {
 public:
 	[[nodiscard]] static void* operator new(size_t s) {
@@ -213,7 +227,7 @@ public:
 			abort();
 		INSTRUMENT_ALLOCATE(typeid(Object).name());
 
-		if constexpr (sizeof(Object) <= 256) {
+		if constexpr (sizeof(Object) <= MaxPooledSize) {
 			void* p = FastAllocator < sizeof(Object) <= 64 ? 64 : nextFastAllocatedSize(sizeof(Object)) > ::allocate();
 			return p;
 		} else {
@@ -225,7 +239,7 @@ public:
 	static void operator delete(void* s) {
 		INSTRUMENT_RELEASE(typeid(Object).name());
 
-		if constexpr (sizeof(Object) <= 256) {
+		if constexpr (sizeof(Object) <= MaxPooledSize) {
 			FastAllocator<sizeof(Object) <= 64 ? 64 : nextFastAllocatedSize(sizeof(Object))>::release(s);
 		} else {
 			delete[] reinterpret_cast<uint8_t*>(s);
@@ -279,12 +293,14 @@ inline void freeFast(int size, void* ptr) {
 		return FastAllocator<8192>::allocate();
 	if (size <= 16384)
 		return FastAllocator<16384>::allocate();
-#endif
+	return allocateCached4kAligned(size);
+#else
 	auto* result = aligned_alloc(4096, size);
 	if (result == nullptr) {
 		platform::outOfMemory();
 	}
 	return result;
+#endif
 }
 
 // Free a pointer returned from allocateFast4kAligned(size)
@@ -297,8 +313,10 @@ inline void freeFast4kAligned(int size, void* ptr) {
 		return FastAllocator<8192>::release(ptr);
 	if (size <= 16384)
 		return FastAllocator<16384>::release(ptr);
-#endif
+	freeCached4kAligned(size, ptr);
+#else
 	aligned_free(ptr);
+#endif
 }
 
 #endif
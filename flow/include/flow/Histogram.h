@@ -23,6 +23,7 @@
 #pragma once
 
 #include <flow/Arena.h>
+#include <array>
 #include <string>
 #include <map>
 #include <unordered_map>
@@ -72,6 +73,7 @@ public:
 		ASSERT(unit <= Unit::MAXHISTOGRAMUNIT);
 		ASSERT(upperBound >= lowerBound);
 		clear();
+		initBucketNames();
 	}
 
 private:
@@ -155,6 +157,7 @@ public:
 	void updateUpperBound(uint32_t upperBound) {
 		this->upperBound = upperBound;
 		clear();
+		initBucketNames();
 	}
 
 	void clear() {
@@ -168,6 +171,11 @@ public:
 
 	std::string drawHistogram();
 
+private:
+	void initBucketNames();
+
+public:
+
 	std::string const group;
 	std::string const op;
 	Unit const unit;
@@ -175,6 +183,8 @@ public:
 	uint32_t buckets[32];
 	uint32_t lowerBound;
 	uint32_t upperBound;
+	// The trace event detail of each bucket, formatted once instead of on every writeToLog() on the network thread
+	std::array<std::string, 32> bucketNames;
 };
 
 #endif // FLOW_HISTOGRAM_H
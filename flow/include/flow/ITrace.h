@@ -22,6 +22,7 @@
 
 #include <string>
 #include <set>
+#include <vector>
 
 class StringRef;
 
@@ -44,6 +45,9 @@ struct ITraceLogFormatter {
 	virtual const char* getHeader() const = 0; // Called when starting a new file
 	virtual const char* getFooter() const = 0; // Called when ending a file
 	virtual std::string formatEvent(const TraceEventFields&) const = 0; // Called for each event
+	// Called for each batch of events written together, so that a format can encode them together. Concatenates the
+	// formatted events by default.
+	virtual std::string formatEvents(const std::vector<TraceEventFields>&) const;
 
 	virtual void addref() = 0;
 	virtual void delref() = 0;
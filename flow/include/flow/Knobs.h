@@ -131,6 +131,7 @@ public:
 
 	double FAST_ALLOC_LOGGING_BYTES;
 	bool FAST_ALLOC_ALLOW_GUARD_PAGES;
+	int64_t ALIGNED_BUFFER_CACHE_BYTES; // Per thread limit on freed 4k aligned buffers kept for reuse
 	double HUGE_ARENA_LOGGING_BYTES;
 	double HUGE_ARENA_LOGGING_INTERVAL;
 
@@ -163,6 +164,9 @@ public:
 	double SATURATION_PROFILING_LOG_INTERVAL;
 	double SATURATION_PROFILING_MAX_LOG_INTERVAL;
 	double SATURATION_PROFILING_LOG_BACKOFF;
+	int ACTOR_PROFILE_SAMPLE_TASKS; // Run loop tasks per sample of the actor profile
+	double ACTOR_PROFILE_LOG_INTERVAL;
+	int ACTOR_PROFILE_MAX_STACKS; // Number of the most expensive stacks logged per ActorProfile event
 
 	// connectionMonitor
 	double CONNECTION_MONITOR_LOOP_TIME;
@@ -170,6 +174,7 @@ public:
 	double CONNECTION_MONITOR_IDLE_TIMEOUT;
 	double CONNECTION_MONITOR_INCOMING_IDLE_MULTIPLIER;
 	double CONNECTION_MONITOR_UNREFERENCED_CLOSE_DELAY;
+	int CONNECTION_MONITOR_ACTIVE_PING_INTERVAL; // Pings a peer that is sending data only every this many loops
 
 	// FlowTransport
 	double CONNECTION_REJECTED_MESSAGE_DELAY;
@@ -183,6 +188,9 @@ public:
 	int ACCEPT_BATCH_SIZE;
 	double INCOMPATIBLE_PEER_DELAY_BEFORE_LOGGING;
 	double PING_LOGGING_INTERVAL;
+	int PEER_CONNECTION_STRIPES; // Connections a client opens to each peer, with endpoints spread between them
+	int PEER_BULK_LANE_PRIORITY;
+	bool CANCEL_ABANDONED_REQUESTS;
 	double PING_SKETCH_ACCURACY;
 
 	int TLS_CERT_REFRESH_DELAY_SECONDS;
@@ -217,7 +225,7 @@ public:
 	int64_t SIM_PAGE_CACHE_64K;
 	int64_t BUGGIFY_SIM_PAGE_CACHE_4K;
 	int64_t BUGGIFY_SIM_PAGE_CACHE_64K;
-	std::string CACHE_EVICTION_POLICY; // for now, "random", "lru", are supported
+	std::string CACHE_EVICTION_POLICY; // for now, "random", "lru", "clock" are supported
 	int MAX_EVICT_ATTEMPTS;
 	double PAGE_CACHE_TRUNCATE_LOOKUP_FRACTION;
 	double TOO_MANY_CONNECTIONS_CLOSED_RESET_DELAY;
@@ -243,6 +251,11 @@ public:
 	int PAGE_WRITE_CHECKSUM_HISTORY;
 	int DISABLE_POSIX_KERNEL_AIO;
 
+	// AsyncFileIOUring
+	bool ENABLE_IO_URING; // Use io_uring instead of kernel AIO for unbuffered files, when built WITH_LIBURING
+	int IO_URING_QUEUE_DEPTH;
+	int IO_URING_FIXED_FILES; // Size of the ring's registered file table
+
 	// AsyncFileNonDurable
 	double NON_DURABLE_MAX_WRITE_DELAY;
 	double MAX_PRIOR_MODIFICATION_DELAY;
@@ -273,17 +286,24 @@ public:
 	double MIN_LOGGED_PRIORITY_BUSY_FRACTION;
 	int CERT_FILE_MAX_SIZE;
 	int READY_QUEUE_RESERVED_SIZE;
+	double NET2_IDLE_SPIN_MAX_TIME; // Longest the run loop polls for completions from other threads before sleeping
+	double NET2_FAIR_SCHEDULING_SHARE; // Least fraction of each run loop cycle that each lower priority band with ready
+	                                   // tasks gets to run; 0 always runs the highest priority task first
 	int TASKS_PER_REACTOR_CHECK;
 
 	// Network
 	int64_t PACKET_LIMIT;
 	int64_t PACKET_WARNING; // 2MB packet warning quietly allows for 1MB system messages
+	int PACKET_COMPRESSION_THRESHOLD; // Unreliable packets at least this large are compressed for peers that accept it
 	double TIME_OFFSET_LOGGING_INTERVAL;
 	int MAX_PACKET_SEND_BYTES;
+	int TLS_WRITE_COALESCE_BYTES;
 	int MIN_PACKET_BUFFER_BYTES;
 	int MIN_PACKET_BUFFER_FREE_BYTES;
 	int FLOW_TCP_NODELAY;
 	int FLOW_TCP_QUICKACK;
+	int FLOW_TCP_FASTOPEN;
+	int FLOW_TCP_THIN_STREAMS;
 
 	// Sim2
 	// FIMXE: more parameters could be factored out
@@ -338,6 +358,8 @@ public:
 	double SECOND_REQUEST_MULTIPLIER_DECAY;
 	double SECOND_REQUEST_BUDGET_GROWTH;
 	double SECOND_REQUEST_MAX_BUDGET;
+	bool LOAD_BALANCE_POWER_OF_TWO_CHOICES;
+	double LOAD_BALANCE_LATENCY_SMOOTHING;
 	double ALTERNATIVES_FAILURE_RESET_TIME;
 	double ALTERNATIVES_FAILURE_MIN_DELAY;
 	double ALTERNATIVES_FAILURE_DELAY_RATIO;
@@ -358,6 +380,7 @@ public:
 	double BASIC_LOAD_BALANCE_MIN_REQUESTS;
 	double BASIC_LOAD_BALANCE_MIN_CPU;
 	double LOAD_BALANCE_TSS_TIMEOUT;
+	double LOAD_BALANCE_TSS_SAMPLE_RATE;
 	bool LOAD_BALANCE_TSS_MISMATCH_VERIFY_SS;
 	bool LOAD_BALANCE_TSS_MISMATCH_TRACE_FULL;
 	int TSS_LARGE_TRACE_SIZE;
@@ -0,0 +1,42 @@
+/*
+ * MsgpackTraceLogFormatter.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "flow/FastRef.h"
+#include "flow/Trace.h"
+
+// Writes each event as a MessagePack map from field name to field value, so the fields are the same as in the xml and
+// json formats. The events of each batch the trace writer thread gets are written together as one block, compressed
+// with zstd when flow is built with it, so that compression also stays off the network thread.
+//
+// A file is MSGPACK_TRACE_MAGIC followed by blocks of
+//   uint32_t rawLength, uint32_t storedLength (both little endian), uint8_t CompressionFilter, storedLength bytes
+// where the raw bytes are the concatenated maps. contrib/trace_convert.py converts these files to xml or json.
+struct MsgpackTraceLogFormatter final : public ITraceLogFormatter, ReferenceCounted<MsgpackTraceLogFormatter> {
+	static constexpr const char* MSGPACK_TRACE_MAGIC = "FDBTRACE-MSGPACK-1\n";
+
+	const char* getExtension() const override;
+	const char* getHeader() const override; // Called when starting a new file
+	const char* getFooter() const override; // Called when ending a file
+	std::string formatEvent(const TraceEventFields&) const override; // Called for each event
+	std::string formatEvents(const std::vector<TraceEventFields>&) const override; // Called for each batch
+
+	void addref() override;
+	void delref() override;
+};
@@ -123,6 +123,7 @@
 	} while (0)
 #define DeleteCriticalSection(m) pthread_mutex_destroy(m)
 #define EnterCriticalSection(m) pthread_mutex_lock(m)
+#define TryEnterCriticalSection(m) (pthread_mutex_trylock(m) == 0)
 #define LeaveCriticalSection(m) pthread_mutex_unlock(m)
 #endif
 
@@ -245,6 +246,9 @@ double getProcessorTimeThread();
 
 double getProcessorTimeProcess();
 
+// The CPUs this process may run on as a list such as "0-3,8", or an empty string where that isn't known
+std::string getProcessCPUAffinity();
+
 #ifdef __linux__
 namespace linux_os {
 
@@ -202,6 +202,29 @@ public:
 		return priorities[priority].runners;
 	}
 
+	int getWeight(const unsigned int priority) const {
+		ASSERT(priority < priorities.size());
+		return priorities[priority].weight;
+	}
+
+	// Changes the weight of a priority.  Capacities of priorities with waiters follow immediately, and runners already
+	// holding locks beyond a lowered capacity keep them.
+	void setWeight(const unsigned int priority, int weight) {
+		ASSERT(priority < priorities.size());
+		ASSERT(weight > 0);
+		Priority& p = priorities[priority];
+		if (!p.queue.empty()) {
+			totalPendingWeights += weight - p.weight;
+		}
+		p.weight = weight;
+		pml_debug_printf("setWeight priority %d  %s\n", (int)priority, toString().c_str());
+
+		// Raising a weight, or lowering it and so raising the share of the others, may let waiters launch
+		if (waiting > 0) {
+			wakeRunner.trigger();
+		}
+	}
+
 private:
 	struct Waiter {
 		Promise<Lock> lockPromise;
@@ -58,15 +58,18 @@ struct NetworkData {
 	int64_t bytesSent;
 	int64_t countPacketsReceived;
 	int64_t countPacketsGenerated;
+	int64_t bytesSavedByCompression;
 	int64_t bytesReceived;
 	int64_t countWriteProbes;
 	int64_t countReadProbes;
 	int64_t countReads;
 	int64_t countWouldBlock;
 	int64_t countWrites;
+	int64_t countCoalescedWrites;
 	int64_t countRunLoop;
 	int64_t countCantSleep;
 	int64_t countWontSleep;
+	int64_t countFairScheduled;
 	int64_t countTimers;
 	int64_t countTasks;
 	int64_t countYields;
@@ -100,15 +103,18 @@ struct NetworkData {
 		bytesSent = Int64Metric::getValueOrDefault("Net2.BytesSent"_sr);
 		countPacketsReceived = Int64Metric::getValueOrDefault("Net2.CountPacketsReceived"_sr);
 		countPacketsGenerated = Int64Metric::getValueOrDefault("Net2.CountPacketsGenerated"_sr);
+		bytesSavedByCompression = Int64Metric::getValueOrDefault("Net2.BytesSavedByCompression"_sr);
 		bytesReceived = Int64Metric::getValueOrDefault("Net2.BytesReceived"_sr);
 		countWriteProbes = Int64Metric::getValueOrDefault("Net2.CountWriteProbes"_sr);
 		countReadProbes = Int64Metric::getValueOrDefault("Net2.CountReadProbes"_sr);
 		countReads = Int64Metric::getValueOrDefault("Net2.CountReads"_sr);
 		countWouldBlock = Int64Metric::getValueOrDefault("Net2.CountWouldBlock"_sr);
 		countWrites = Int64Metric::getValueOrDefault("Net2.CountWrites"_sr);
+		countCoalescedWrites = Int64Metric::getValueOrDefault("Net2.CountCoalescedWrites"_sr);
 		countRunLoop = Int64Metric::getValueOrDefault("Net2.CountRunLoop"_sr);
 		countCantSleep = Int64Metric::getValueOrDefault("Net2.CountCantSleep"_sr);
 		countWontSleep = Int64Metric::getValueOrDefault("Net2.CountWontSleep"_sr);
+		countFairScheduled = Int64Metric::getValueOrDefault("Net2.CountFairScheduled"_sr);
 		countTimers = Int64Metric::getValueOrDefault("Net2.CountTimers"_sr);
 		countTasks = Int64Metric::getValueOrDefault("Net2.CountTasks"_sr);
 		countYields = Int64Metric::getValueOrDefault("Net2.CountYields"_sr);
@@ -22,21 +22,28 @@
 #define FLOW_TASK_QUEUE_H
 #pragma once
 
+#include <algorithm>
 #include <queue>
 #include <vector>
 #include "flow/TDMetric.actor.h"
 #include "flow/network.h"
 #include "flow/ThreadSafeQueue.h"
+#include "flow/TimerWheel.h"
 
 template <typename Task>
 // A queue of ordered tasks, both ready to execute, and delayed for later execution.
 // All functions must be called on the main thread, except for addReadyThreadSafe() which can be called from any thread.
 class TaskQueue {
 public:
-	TaskQueue() : tasksIssued(0), ready(FLOW_KNOBS->READY_QUEUE_RESERVED_SIZE) {}
+	TaskQueue() : tasksIssued(0), fairShare(0) {
+		ready[0].reserve(FLOW_KNOBS->READY_QUEUE_RESERVED_SIZE);
+		std::fill(std::begin(bandTime), std::end(bandTime), 0.0);
+	}
 
 	// Add a task that is ready to be executed.
-	void addReady(TaskPriority taskId, Task* t) { this->ready.push(OrderedTask(getFIFOPriority(taskId), taskId, t)); }
+	void addReady(TaskPriority taskId, Task* t) {
+		this->ready[bandOf(taskId)].push(OrderedTask(getFIFOPriority(taskId), taskId, t));
+	}
 	// Add a task to be executed at a given future time instant (a "timer").
 	void addTimer(double at, TaskPriority taskId, Task* t) {
 		this->timers.push(DelayedTask(at, getFIFOPriority(taskId), taskId, t));
@@ -55,7 +62,7 @@ public:
 	}
 	// Returns true if the there are no tasks that are ready to be executed.
 	bool canSleep() {
-		bool b = ready.empty();
+		bool b = !hasReadyTask();
 		if (b) {
 			b = threadReady.canSleep();
 			if (!b)
@@ -65,7 +72,7 @@ public:
 		return b;
 	}
 	// Returns a time interval a caller should sleep from now until the next timer.
-	double getSleepTime(double now) const {
+	double getSleepTime(double now) {
 		if (!timers.empty()) {
 			return timers.top().at - now;
 		}
@@ -78,7 +85,8 @@ public:
 		while (!timers.empty() && timers.top().at <= now + INetwork::TIME_EPS) {
 			++numTimers;
 			++countTimers;
-			ready.push(timers.top());
+			DelayedTask const& t = timers.top();
+			ready[bandOf(t.taskID)].push(t);
 			timers.pop();
 		}
 		FDB_TRACE_PROBE(run_loop_ready_timers, numTimers);
@@ -98,24 +106,50 @@ public:
 		FDB_TRACE_PROBE(run_loop_thread_ready, numReady);
 	}
 
-	bool hasReadyTask() const { return !ready.empty(); }
-	size_t getNumReadyTasks() const { return ready.size(); }
-	TaskPriority getReadyTaskID() const { return ready.top().taskID; }
-	int64_t getReadyTaskPriority() const { return ready.top().priority; }
-	Task* getReadyTask() const { return ready.top().task; }
-	void popReadyTask() { ready.pop(); }
+	// Returns true if a task may have been added from another thread since the last processThreadReady()
+	bool hasThreadReady() const { return threadReady.hasPending(); }
+
+	bool hasReadyTask() const { return highestReadyBand() >= 0; }
+	size_t getNumReadyTasks() const {
+		size_t n = 0;
+		for (auto const& r : ready) {
+			n += r.size();
+		}
+		return n;
+	}
+	// The next task to run. This is the highest priority ready task unless fair scheduling picks a lower band.
+	TaskPriority getReadyTaskID() const { return ready[nextReadyBand()].top().taskID; }
+	Task* getReadyTask() const { return ready[nextReadyBand()].top().task; }
+	void popReadyTask() {
+		int band = nextReadyBand();
+		if (band != highestReadyBand()) {
+			++countFairScheduled;
+		}
+		ready[band].pop();
+	}
+	// The priority of the highest priority ready task, which is what running tasks yield to.
+	int64_t getReadyTaskPriority() const { return ready[highestReadyBand()].top().priority; }
+
+	// Fair scheduling: while a band has ready tasks but has run for less than `share` of the time in the current run
+	// loop cycle, its tasks run ahead of higher priority bands. 0 disables it, so that tasks always run in priority
+	// order.
+	void setFairShare(double share) { fairShare = share; }
+	void startCycle() { std::fill(std::begin(bandTime), std::end(bandTime), 0.0); }
+	void chargeTask(TaskPriority taskID, double seconds) { bandTime[bandOf(taskID)] += seconds; }
 
 	void initMetrics() {
 		countTimers.init("Net2.CountTimers"_sr);
 		countCantSleep.init("Net2.CountCantSleep"_sr);
 		countWontSleep.init("Net2.CountWontSleep"_sr);
+		countFairScheduled.init("Net2.CountFairScheduled"_sr);
 	}
 
 	void clear() {
-		decltype(ready) _1;
-		ready.swap(_1);
-		decltype(timers) _2;
-		timers.swap(_2);
+		for (auto& r : ready) {
+			std::remove_reference_t<decltype(r)> _1;
+			r.swap(_1);
+		}
+		timers.clear();
 	}
 
 private:
@@ -143,19 +177,66 @@ private:
 		void reserve(size_type capacity) { this->c.reserve(capacity); }
 	};
 
+	// Ready tasks are kept in one queue per band of priorities, so that fair scheduling can find the best task of a lower
+	// band. The bands are contiguous ranges of priorities, so taking the top of the highest non-empty band is the same as
+	// taking the top of a single queue.
+	static constexpr int kBands = 4;
+	static int bandOf(TaskPriority taskID) {
+		if (taskID >= TaskPriority::DefaultOnMainThread) {
+			return 0; // Networking, coordination and the commit path
+		}
+		if (taskID >= TaskPriority::UnknownEndpoint) {
+			return 1; // Default endpoints, delays and reads
+		}
+		if (taskID >= TaskPriority::UpdateStorage) {
+			return 2; // Data distribution and making storage durable
+		}
+		return 3; // Fetching keys, spilled peeks and other background work
+	}
+
+	int highestReadyBand() const {
+		for (int b = 0; b < kBands; ++b) {
+			if (!ready[b].empty()) {
+				return b;
+			}
+		}
+		return -1;
+	}
+
+	int nextReadyBand() const {
+		int top = highestReadyBand();
+		if (fairShare > 0 && top >= 0) {
+			double total = 0;
+			for (double t : bandTime) {
+				total += t;
+			}
+			for (int b = top + 1; b < kBands; ++b) {
+				if (!ready[b].empty() && bandTime[b] < fairShare * total) {
+					return b;
+				}
+			}
+		}
+		return top;
+	}
+
 	// Returns a unique priority value for a task which preserves FIFO ordering
 	// for tasks with the same priority.
 	int64_t getFIFOPriority(TaskPriority taskId) { return (int64_t(taskId) << 32) - (++tasksIssued); }
 	uint64_t tasksIssued;
 
-	ReadyQueue<OrderedTask> ready;
+	ReadyQueue<OrderedTask> ready[kBands];
+	double fairShare;
+	double bandTime[kBands]; // Seconds spent running each band in the current run loop cycle
 	ThreadSafeQueue<std::pair<TaskPriority, Task*>> threadReady;
 
-	std::priority_queue<DelayedTask, std::vector<DelayedTask>> timers;
+	// Outstanding timers can number in the hundreds of thousands (watches, failure monitors, load balancing backups),
+	// so they are bucketed by millisecond rather than kept in one heap.
+	TimerWheel<DelayedTask> timers;
 
 	Int64MetricHandle countTimers;
 	Int64MetricHandle countCantSleep;
 	Int64MetricHandle countWontSleep;
+	Int64MetricHandle countFairScheduled; // Tasks run ahead of a higher priority band because of fair scheduling
 };
 
 #endif /* FLOW_TASK_QUEUE_H */
@@ -503,11 +503,12 @@ protected:
 	}
 };
 
+// Every client operation allocates one of these, so they are pooled. FastAllocated checks the size of the object being
+// allocated, so each subclass must derive from FastAllocated as well and use its operator new and operator delete.
 template <class T>
-class ThreadSingleAssignmentVar
-  : public ThreadSingleAssignmentVarBase,
-    /* public FastAllocated<ThreadSingleAssignmentVar<T>>,*/ public ThreadSafeReferenceCounted<
-        ThreadSingleAssignmentVar<T>> {
+class ThreadSingleAssignmentVar : public ThreadSingleAssignmentVarBase,
+                                  public FastAllocated<ThreadSingleAssignmentVar<T>>,
+                                  public ThreadSafeReferenceCounted<ThreadSingleAssignmentVar<T>> {
 public:
 	virtual ~ThreadSingleAssignmentVar() {}
 
@@ -49,6 +49,17 @@
 // can set this variable properly?
 constexpr size_t MAX_CACHE_LINE_SIZE = 64;
 
+// Hints to the CPU that the caller is busy waiting
+inline void spinPause() {
+#if defined(__aarch64__)
+	__asm__ volatile("isb");
+#elif defined(__powerpc64__)
+	__asm__ volatile("or 27,27,27" ::: "memory");
+#else
+	_mm_pause();
+#endif
+}
+
 class alignas(MAX_CACHE_LINE_SIZE) ThreadSpinLock {
 public:
 	// #ifdef _WIN32
@@ -64,13 +75,7 @@ public:
 	}
 	void enter() {
 		while (isLocked.test_and_set(std::memory_order_acquire))
-#if defined(__aarch64__)
-			__asm__ volatile("isb");
-#elif defined(__powerpc64__)
-			__asm__ volatile("or 27,27,27" ::: "memory");
-#else
-			_mm_pause();
-#endif
+			spinPause();
 #if VALGRIND
 		ANNOTATE_RWLOCK_ACQUIRED(this, true);
 #endif
@@ -38,6 +38,8 @@ interpreted as representing official policies, either expressed or implied, of D
 
 #include <atomic>
 
+#include "flow/ThreadPrimitives.h"
+
 #if VALGRIND
 #include <drd.h>
 #endif
@@ -54,8 +56,9 @@ class ThreadSafeQueue : NonCopyable {
 		Node(T const& data) : data(data) {}
 		Node(T&& data) : data(std::move(data)) {}
 	};
-	std::atomic<BaseNode*> head;
-	BaseNode* tail;
+	// head is written by every producer and tail only by the consumer, so they are kept on separate cache lines
+	alignas(MAX_CACHE_LINE_SIZE) std::atomic<BaseNode*> head;
+	alignas(MAX_CACHE_LINE_SIZE) BaseNode* tail;
 	BaseNode stub, sleeping;
 	bool sleepy;
 
@@ -140,6 +143,10 @@ public:
 
 	///////////// The below functions may only be called by a single, consumer thread //////////////////
 
+	// Returns true if something may have been pushed since the queue was last drained, without popping anything.
+	// Cheap enough to poll while spinning.
+	bool hasPending() const { return this->tail != &stub || this->tail->next.load() != nullptr; }
+
 	// If canSleep returns true, then the queue is empty and the next push() will return true
 	bool canSleep() {
 		if (sleepy) {
@@ -0,0 +1,182 @@
+/*
+ * TimerWheel.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLOW_TIMER_WHEEL_H
+#define FLOW_TIMER_WHEEL_H
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <queue>
+#include <vector>
+
+#include "flow/Error.h"
+
+// A min-queue of timers ordered by their double member `at`, with the same top()/pop() results as a priority_queue
+// ordered by `at`.
+//
+// Timers are bucketed by tick (at / tickSeconds) into three levels of 256 slots each, so push() is O(1) and a timer is
+// moved between levels at most three times before it is due. Only the timers of the earliest pending tick are kept in
+// a heap (near), which is what keeps the exact ordering within a tick. Timers more than 256^3 ticks past the cursor
+// wait in an overflow heap.
+//
+// A level L timer's tick agrees with the cursor on every bit above the lowest 8 * (L + 1), but not above the lowest
+// 8 * L. Every timer in the wheel is after the cursor, and every timer in near is at or before it.
+template <class T>
+class TimerWheel {
+public:
+	explicit TimerWheel(double tickSeconds = 0.001)
+	  : tickSeconds(tickSeconds), cursor(std::numeric_limits<int64_t>::min()), count(0) {
+		for (auto& l : occupied) {
+			std::fill(std::begin(l), std::end(l), 0);
+		}
+	}
+
+	bool empty() const { return count == 0; }
+	size_t size() const { return count; }
+
+	void push(T const& t) {
+		++count;
+		place(t, tickOf(t.at));
+	}
+
+	// The timer with the earliest `at`. Not const, because it may move the next pending slot into near.
+	T const& top() {
+		ASSERT(count > 0);
+		while (near.empty()) {
+			advance();
+		}
+		return near.top();
+	}
+
+	void pop() {
+		top();
+		near.pop();
+		--count;
+	}
+
+	void clear() {
+		decltype(near) n;
+		near.swap(n);
+		decltype(overflow) o;
+		overflow.swap(o);
+		for (int level = 0; level < kLevels; ++level) {
+			for (auto& slot : slots[level]) {
+				slot.clear();
+			}
+			std::fill(std::begin(occupied[level]), std::end(occupied[level]), 0);
+		}
+		cursor = std::numeric_limits<int64_t>::min();
+		count = 0;
+	}
+
+private:
+	static constexpr int kLevels = 3;
+	static constexpr int kSlotBits = 8;
+	static constexpr int kSlots = 1 << kSlotBits;
+
+	struct Later {
+		bool operator()(T const& a, T const& b) const { return a.at > b.at; }
+	};
+
+	int64_t tickOf(double at) const {
+		// Clamp so that very distant (or infinite) timers still have a representable tick
+		double t = std::floor(at / tickSeconds);
+		if (!(t < 4e18)) {
+			return int64_t(4e18);
+		}
+		if (t < -4e18) {
+			return int64_t(-4e18);
+		}
+		return int64_t(t);
+	}
+
+	void place(T const& t, int64_t tick) {
+		if (tick <= cursor) {
+			near.push(t);
+			return;
+		}
+		for (int level = 0; level < kLevels; ++level) {
+			int shift = kSlotBits * (level + 1);
+			if ((tick >> shift) == (cursor >> shift)) {
+				int slot = (tick >> (kSlotBits * level)) & (kSlots - 1);
+				slots[level][slot].push_back(t);
+				occupied[level][slot / 64] |= uint64_t(1) << (slot % 64);
+				return;
+			}
+		}
+		overflow.push(t);
+	}
+
+	int firstOccupied(int level) const {
+		for (int i = 0; i < kSlots / 64; ++i) {
+			if (occupied[level][i]) {
+				return i * 64 + std::countr_zero(occupied[level][i]);
+			}
+		}
+		return -1;
+	}
+
+	// Moves the cursor to the start of the earliest non-empty slot and redistributes that slot's timers, which puts at
+	// least one timer into near or a lower level.
+	void advance() {
+		for (int level = 0; level < kLevels; ++level) {
+			int slot = firstOccupied(level);
+			if (slot < 0) {
+				continue;
+			}
+			int shift = kSlotBits * level;
+			int64_t blockMask = (int64_t(1) << (shift + kSlotBits)) - 1;
+			cursor = (cursor & ~blockMask) | (int64_t(slot) << shift);
+			occupied[level][slot / 64] &= ~(uint64_t(1) << (slot % 64));
+			// Every timer in the slot now lands in near or a lower level, so the slot can be cleared afterwards and
+			// keeps its capacity for reuse
+			auto& timers = slots[level][slot];
+			for (auto const& t : timers) {
+				place(t, tickOf(t.at));
+			}
+			timers.clear();
+			return;
+		}
+
+		// The wheel is empty, so jump to the earliest overflow timer and pull in everything that now fits the wheel
+		ASSERT(!overflow.empty());
+		cursor = tickOf(overflow.top().at);
+		int shift = kSlotBits * kLevels;
+		while (!overflow.empty() && (tickOf(overflow.top().at) >> shift) == (cursor >> shift)) {
+			T t = overflow.top();
+			overflow.pop();
+			place(t, tickOf(t.at));
+		}
+	}
+
+	double tickSeconds;
+	int64_t cursor; // Every timer in near has a tick <= cursor, and every other timer a tick > cursor
+	size_t count;
+	std::priority_queue<T, std::vector<T>, Later> near;
+	std::vector<T> slots[kLevels][kSlots];
+	uint64_t occupied[kLevels][kSlots / 64];
+	std::priority_queue<T, std::vector<T>, Later> overflow;
+};
+
+#endif /* FLOW_TIMER_WHEEL_H */
@@ -97,6 +97,18 @@ struct scalar_traits<
 	}
 };
 
+// Types whose scalar_traits are the generic memcpy above, so that an array of them is serialized byte-for-byte as it is
+// laid out in memory. bool is left out: std::vector<bool> is not an array, and not every byte is a valid bool.
+template <class T>
+constexpr bool is_memcpy_scalar =
+    (std::is_integral_v<T> && !std::is_same_v<T, bool>) || std::is_floating_point_v<T> || std::is_enum_v<T>;
+
+template <class T>
+struct is_std_vector : std::false_type {};
+
+template <class T, class Alloc>
+struct is_std_vector<std::vector<T, Alloc>> : std::true_type {};
+
 template <class F, class S>
 struct serializable_traits<std::pair<F, S>> : std::true_type {
 	template <class Archiver>
@@ -1142,6 +1154,21 @@ struct LoadSaveHelper : Context {
 		uint32_t numEntries = interpret_as<uint32_t>(current);
 		current += sizeof(uint32_t);
 		auto inserter = VectorTraits::insert(member, numEntries, this->context());
+		if constexpr (is_memcpy_scalar<T>) {
+			// The wire format of a vector of these is exactly the in-memory array, so copy it in one go
+			if constexpr (std::is_same_v<typename VectorTraits::insert_iterator, T*>) {
+				if (numEntries > 0) {
+					memcpy(inserter, current, numEntries * sizeof(T));
+				}
+				return;
+			} else if constexpr (is_std_vector<VectorLike>::value) {
+				member.resize(numEntries);
+				if (numEntries > 0) {
+					memcpy(member.data(), current, numEntries * sizeof(T));
+				}
+				return;
+			}
+		}
 		for (uint32_t i = 0; i < numEntries; ++i) {
 			T value;
 			load_helper(value, current, this->context());
@@ -1215,10 +1242,16 @@ struct LoadSaveHelper : Context {
 		uint32_t len = num_entries * size;
 		auto self = writer.getMessageWriter(len);
 		auto iter = VectorTraits::begin(members, this->context());
-		for (uint32_t i = 0; i < num_entries; ++i) {
-			auto result = save_helper(*iter, writer, vtables, this->context());
-			self.write(&result, i * size, size);
-			++iter;
+		if constexpr (is_memcpy_scalar<T> && std::contiguous_iterator<typename VectorTraits::iterator>) {
+			if (num_entries > 0) {
+				self.write(std::to_address(iter), 0, len);
+			}
+		} else {
+			for (uint32_t i = 0; i < num_entries; ++i) {
+				auto result = save_helper(*iter, writer, vtables, this->context());
+				self.write(&result, i * size, size);
+				++iter;
+			}
 		}
 		int padding = 0;
 		int start =
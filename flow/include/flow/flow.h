@@ -720,6 +720,17 @@ struct LineageScope {
 };
 #endif
 
+// The name of the first actor that ran in the current run loop task, or nullptr if none has. The actor compiler calls
+// recordTaskActor() wherever an actor starts or resumes, and Net2 clears it before each task, so that slow tasks and the
+// actor profile can name the actor that the task woke up.
+extern thread_local const char* currentTaskActorName;
+
+inline void recordTaskActor(const char* name) {
+	if (!currentTaskActorName) {
+		currentTaskActorName = name;
+	}
+}
+
 // This class can be used in order to modify all lineage properties
 // of actors created within a (non-actor) scope
 struct LocalLineage {
@@ -445,6 +445,19 @@ public:
 	int getLength() const { return size; }
 	Standalone<StringRef> toValue() const { return Standalone<StringRef>(StringRef(data, size), arena); }
 	StringRef toValue(Arena& arena) const { return StringRef(arena, StringRef(data, size)); }
+	// Makes room for a total of at least bytes, so that writing up to that much doesn't move the data again
+	void reserve(int bytes) {
+		if (bytes > allocated) {
+			Arena newArena;
+			uint8_t* newData = new (newArena) uint8_t[bytes];
+			if (size > 0) {
+				memcpy(newData, data, size);
+			}
+			arena = newArena;
+			data = newData;
+			allocated = bytes;
+		}
+	}
 	template <class VersionOptions>
 	explicit BinaryWriter(VersionOptions vo) : data(nullptr), size(0), allocated(0) {
 		vo.write(*this);
@@ -939,4 +952,18 @@ struct SerializeSource : MakeSerializeSource<SerializeSource<T>, T> {
 	T const& get() const override { return value; }
 };
 
+// A SerializeSource which serializes its value for the network only once, so that the same message can be sent to many
+// endpoints for the cost of copying its bytes.  version must be the protocol version packets are written with.
+template <class T>
+struct PreserializedSource : MakeSerializeSource<PreserializedSource<T>, T> {
+	using value_type = T;
+	T const& value;
+	Standalone<StringRef> serialized;
+	PreserializedSource(T const& value, ProtocolVersion version)
+	  : value(value), serialized(ObjectWriter::toValue(value, AssumeVersion(version))) {}
+	void serializePacketWriter(PacketWriter& w) const override { w.serializeBytes(serialized); }
+	void serializeObjectWriter(ObjectWriter& w) const override { w.serialize(value); }
+	T const& get() const override { return value; }
+};
+
 #endif
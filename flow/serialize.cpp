@@ -130,3 +130,31 @@ TEST_CASE("flow/serialize/Downgrade/WriteNew") {
 	verifyData(writer.toStringRef(), numObjects);
 	return Void();
 }
+
+namespace {
+
+Standalone<StringRef> writePacket(ISerializeSource const& source) {
+	PacketBuffer* buffer = PacketBuffer::create();
+	PacketWriter writer(buffer, nullptr, AssumeVersion(g_network->protocolVersion()));
+	source.serializePacketWriter(writer);
+	ASSERT(writer.finish() == buffer);
+	Standalone<StringRef> bytes(StringRef(buffer->data(), buffer->bytes_written));
+	buffer->delref();
+	return bytes;
+}
+
+} // namespace
+
+// A preserialized message must be written into packets exactly as if it were serialized in place
+TEST_CASE("flow/serialize/PreserializedSource") {
+	std::vector<NewStruct> data(deterministicRandom()->randomInt(1, 101));
+	for (auto& newObject : data) {
+		newObject.setFields();
+	}
+	ErrorOr<EnsureTable<std::vector<NewStruct>>> message(data);
+	Standalone<StringRef> inPlace = writePacket(SerializeSource<decltype(message)>(message));
+	Standalone<StringRef> preserialized =
+	    writePacket(PreserializedSource<decltype(message)>(message, g_network->protocolVersion()));
+	ASSERT(inPlace == preserialized);
+	return Void();
+}
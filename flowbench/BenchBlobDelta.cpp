@@ -71,6 +71,17 @@ public:
 		throw std::invalid_argument("Test delta file size is not pre-generated!");
 	}
 
+	// Generate a sorted snapshot of new keys in the same range as the deltas
+	Standalone<GranuleSnapshot> newSnapshot(int rows) {
+		Standalone<GranuleSnapshot> snapshot;
+		for (int i = 0; i < rows; i++) {
+			std::string key = prefix.toString() + randGen->randomUniqueID().toString();
+			snapshot.push_back_deep(snapshot.arena(), KeyValueRef(key, value()));
+		}
+		std::sort(snapshot.begin(), snapshot.end(), KeyValueRef::OrderByKey());
+		return snapshot;
+	}
+
 private:
 	void genDeltas(int targetBytes) {
 		Standalone<GranuleDeltas> data;
@@ -170,6 +181,58 @@ static void bench_sort_deltas(benchmark::State& state) {
 	state.SetBytesProcessed(static_cast<long>(state.iterations()) * targetBytes);
 }
 
+// Benchmark materializing a granule from a snapshot file and the 1024KB deltas split across several delta files. The
+// main CPU cost should be merging the sorted files
+static void bench_materialize_granule(benchmark::State& state) {
+	int snapshotRows = state.range(0);
+	int deltaFileCount = state.range(1);
+	int chunkSize = 32 * 1024;
+
+	Standalone<GranuleDeltas> delta = deltaGen.getDelta(1024 * 1024);
+	KeyRange range = deltaGen.getRange();
+	Standalone<GranuleSnapshot> snapshot = deltaGen.newSnapshot(snapshotRows);
+
+	Standalone<BlobGranuleChunkRef> chunk;
+	chunk.keyRange = range;
+	chunk.includedVersion = delta.back().version;
+	chunk.snapshotVersion = delta.front().version - 1;
+
+	Value snapshotData = serializeChunkedSnapshot("testsnapshot"_sr, snapshot, chunkSize, {});
+	chunk.snapshotFile = BlobFilePointerRef(
+	    chunk.arena(), "testsnapshot", 0, snapshotData.size(), snapshotData.size(), chunk.snapshotVersion);
+
+	std::vector<Value> deltaFiles;
+	std::vector<StringRef> deltaFileData;
+	int deltasPerFile = (delta.size() + deltaFileCount - 1) / deltaFileCount;
+	for (int i = 0; i < delta.size(); i += deltasPerFile) {
+		Standalone<GranuleDeltas> fileDeltas;
+		fileDeltas.arena().dependsOn(delta.arena());
+		fileDeltas.append(fileDeltas.arena(), delta.begin() + i, std::min(deltasPerFile, delta.size() - i));
+		deltaFiles.push_back(serializeChunkedDeltaFile("testdelta"_sr, fileDeltas, range, chunkSize, {}));
+		deltaFileData.push_back(deltaFiles.back());
+		chunk.deltaFiles.emplace_back_deep(chunk.arena(),
+		                                   "testdelta",
+		                                   0,
+		                                   deltaFiles.back().size(),
+		                                   deltaFiles.back().size(),
+		                                   fileDeltas.back().version);
+	}
+
+	int64_t inputBytes = snapshotData.size();
+	for (auto& it : deltaFiles) {
+		inputBytes += it.size();
+	}
+	int64_t outputRows = 0;
+	for (auto _ : state) {
+		GranuleMaterializeStats stats;
+		RangeResult result =
+		    materializeBlobGranule(chunk, range, 0, chunk.includedVersion, snapshotData, deltaFileData, stats);
+		outputRows += result.size();
+	}
+	state.SetBytesProcessed(static_cast<long>(state.iterations()) * inputBytes);
+	state.counters["output_rows"] = benchmark::Counter(outputRows, benchmark::Counter::kAvgIterations);
+}
+
 // Benchmark serialization for granule deltas 128KB, 512KB and 1024KB. Chunk size 32KB
 BENCHMARK(bench_serialize_deltas)
     ->Args({ 128 * 1024, 32 * 1024 })
@@ -177,4 +240,7 @@ BENCHMARK(bench_serialize_deltas)
     ->Args({ 1024 * 1024, 32 * 1024 });
 
 // Benchmark sorting for granule deltas 128KB, 512KB and 1024KB. Chunk size 32KB
-BENCHMARK(bench_sort_deltas)->Args({ 128 * 1024 })->Args({ 512 * 1024 })->Args({ 1024 * 1024 });
\ No newline at end of file
+BENCHMARK(bench_sort_deltas)->Args({ 128 * 1024 })->Args({ 512 * 1024 })->Args({ 1024 * 1024 });
+
+// Benchmark materializing a granule with 10K and 100K snapshot rows, and 1, 8 and 32 delta files
+BENCHMARK(bench_materialize_granule)->ArgsProduct({ { 10000, 100000 }, { 1, 8, 32 } });
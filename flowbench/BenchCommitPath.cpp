@@ -0,0 +1,197 @@
+/*
+ * BenchCommitPath.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark/benchmark.h"
+
+#include "fdbclient/CommitTransaction.h"
+#include "fdbclient/KeyRangeMap.h"
+#include "fdbclient/VersionedMap.h"
+#include "fdbclient/VersionedWideMap.h"
+#include "flow/IRandom.h"
+#include "flowbench/CommitBatchGenerator.h"
+
+// Benchmarks of the commit proxy and storage server steps that bound commit throughput, over batches from the same
+// generator as bench_conflict_set.
+
+static int mutationCount(std::vector<CommitTransactionRef> const& batch) {
+	int count = 0;
+	for (auto const& tr : batch) {
+		count += tr.mutations.size();
+	}
+	return count;
+}
+
+// A map of shards to the tags of their storage servers, like the commit proxy's keyInfo
+static void makeShardTags(Arena& arena, int prefixLength, int shards, KeyRangeMap<std::vector<Tag>>& keyInfo) {
+	const int replicas = 3;
+	const int storageServers = std::max(replicas, shards / 10);
+	for (int i = 0; i < shards; i++) {
+		std::vector<Tag> tags;
+		for (int r = 0; r < replicas; r++) {
+			tags.emplace_back(0, deterministicRandom()->randomInt(0, storageServers));
+		}
+		int64_t beginKey = int64_t(kCommitKeySpace) * i / shards;
+		int64_t endKey = int64_t(kCommitKeySpace) * (i + 1) / shards;
+		KeyRef begin = i == 0 ? allKeys.begin : makeCommitKey(arena, prefixLength, beginKey);
+		KeyRef end = i + 1 == shards ? allKeys.end : makeCommitKey(arena, prefixLength, endKey);
+		keyInfo.insert(KeyRangeRef(begin, end), tags);
+	}
+}
+
+// Looks up the tags of every mutation in a batch the way assignMutationsToStorageServers does: the shard containing a
+// set's key, or every shard intersecting a clear. The argument is the number of shards.
+static void bench_tag_assignment(benchmark::State& state) {
+	const int shards = state.range(0);
+	Arena arena;
+	CommitBatchOptions options;
+	std::vector<CommitTransactionRef> batch = makeCommitBatch(arena, options);
+	KeyRangeMap<std::vector<Tag>> keyInfo;
+	makeShardTags(arena, options.prefixLength, shards, keyInfo);
+
+	std::vector<Tag> tags;
+	for (auto _ : state) {
+		for (auto const& tr : batch) {
+			for (auto const& m : tr.mutations) {
+				tags.clear();
+				if (m.type == MutationRef::ClearRange) {
+					for (auto r : keyInfo.intersectingRanges(KeyRangeRef(m.param1, m.param2))) {
+						tags.insert(tags.end(), r.value().begin(), r.value().end());
+					}
+					std::sort(tags.begin(), tags.end());
+					tags.erase(std::unique(tags.begin(), tags.end()), tags.end());
+				} else {
+					auto const& shardTags = keyInfo.rangeContaining(m.param1).value();
+					tags.insert(tags.end(), shardTags.begin(), shardTags.end());
+				}
+				benchmark::DoNotOptimize(tags.data());
+			}
+		}
+	}
+	state.SetItemsProcessed(mutationCount(batch) * static_cast<long>(state.iterations()));
+}
+
+// Serializes every mutation of a batch into per log push location messages, in the format LogPushData writes: a length,
+// subsequence and tags before each mutation, serialized once and copied to the other locations. LogPushData itself
+// needs a log system, so its message loop is repeated here. The arguments are the number of shards and of tlogs.
+static void bench_log_push_serialization(benchmark::State& state) {
+	const int shards = state.range(0);
+	const int tlogs = state.range(1);
+	Arena arena;
+	CommitBatchOptions options;
+	std::vector<CommitTransactionRef> batch = makeCommitBatch(arena, options);
+	KeyRangeMap<std::vector<Tag>> keyInfo;
+	makeShardTags(arena, options.prefixLength, shards, keyInfo);
+
+	// Tags are resolved up front, so that this measures only the serialization
+	std::vector<std::vector<Tag>> mutationTags;
+	for (auto const& tr : batch) {
+		for (auto const& m : tr.mutations) {
+			mutationTags.push_back(keyInfo.rangeContaining(m.param1).value());
+		}
+	}
+
+	size_t bytes = 0;
+	std::vector<int> locations;
+	for (auto _ : state) {
+		std::vector<BinaryWriter> messages;
+		for (int i = 0; i < tlogs; i++) {
+			messages.emplace_back(AssumeVersion(g_network->protocolVersion()));
+		}
+		uint32_t subsequence = 1;
+		int mutationIndex = 0;
+		for (auto const& tr : batch) {
+			for (auto const& m : tr.mutations) {
+				auto const& tags = mutationTags[mutationIndex++];
+				locations.clear();
+				for (auto const& tag : tags) {
+					locations.push_back(tag.id % tlogs);
+				}
+				std::sort(locations.begin(), locations.end());
+				locations.erase(std::unique(locations.begin(), locations.end()), locations.end());
+
+				uint32_t subseq = subsequence++;
+				BinaryWriter& first = messages[locations[0]];
+				int firstOffset = first.getLength();
+				first << uint32_t(0) << subseq << uint16_t(tags.size());
+				for (auto const& tag : tags) {
+					first << tag;
+				}
+				first << m;
+				int firstLength = first.getLength() - firstOffset;
+				*(uint32_t*)((uint8_t*)first.getData() + firstOffset) = firstLength - sizeof(uint32_t);
+				for (int i = 1; i < locations.size(); i++) {
+					messages[locations[i]].serializeBytes((uint8_t*)first.getData() + firstOffset, firstLength);
+				}
+			}
+		}
+		bytes = 0;
+		for (auto const& wr : messages) {
+			bytes += wr.getLength();
+		}
+		benchmark::DoNotOptimize(bytes);
+	}
+	state.SetItemsProcessed(mutationCount(batch) * static_cast<long>(state.iterations()));
+	state.SetBytesProcessed(bytes * static_cast<long>(state.iterations()));
+}
+
+// Applies a batch per version to the storage server's versioned data, then forgets versions older than the MVCC window
+// the way the storage server does as versions become durable. The argument is the number of versions kept.
+template <class VersionedData>
+static void bench_versioned_map_apply(benchmark::State& state) {
+	const int versionsKept = state.range(0);
+	constexpr int batches = 16;
+	Arena arena;
+	CommitBatchOptions options;
+	std::vector<std::vector<CommitTransactionRef>> inputs;
+	for (int i = 0; i < batches; i++) {
+		inputs.push_back(makeCommitBatch(arena, options));
+	}
+
+	VersionedData data;
+	Version version = 0;
+	for (auto _ : state) {
+		data.createNewVersion(++version);
+		for (auto const& tr : inputs[version % batches]) {
+			for (auto const& m : tr.mutations) {
+				if (m.type == MutationRef::ClearRange) {
+					data.erase(m.param1, m.param2);
+					data.insert(m.param1, ValueOrClearToRef::clearTo(m.param2));
+				} else {
+					data.insert(m.param1, ValueOrClearToRef::value(m.param2));
+				}
+			}
+		}
+		if (version > versionsKept) {
+			data.forgetVersionsBefore(version - versionsKept);
+		}
+	}
+	state.SetItemsProcessed(mutationCount(inputs[0]) * static_cast<long>(state.iterations()));
+}
+
+BENCHMARK(bench_tag_assignment)->Arg(100)->Arg(10000)->ReportAggregatesOnly(true);
+BENCHMARK(bench_log_push_serialization)->ArgsProduct({ { 100, 10000 }, { 3, 12 } })->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_versioned_map_apply, VersionedMap<KeyRef, ValueOrClearToRef>)
+    ->Arg(1)
+    ->Arg(100)
+    ->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_versioned_map_apply, VersionedWideMap<KeyRef, ValueOrClearToRef>)
+    ->Arg(1)
+    ->Arg(100)
+    ->ReportAggregatesOnly(true);
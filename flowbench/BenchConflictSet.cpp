@@ -0,0 +1,77 @@
+/*
+ * BenchConflictSet.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark/benchmark.h"
+
+#include "fdbclient/CommitTransaction.h"
+#include "fdbclient/FDBTypes.h"
+#include "fdbserver/ConflictSet.h"
+#include "flow/Arena.h"
+#include "flow/IRandom.h"
+#include "flowbench/CommitBatchGenerator.h"
+
+static constexpr int kTransactionsPerBatch = 1000;
+static constexpr int kBatches = 64;
+
+// Benchmarks resolving batches of transactions with two read ranges and one write range each.
+// Arguments are the length of the prefix shared by all keys, the number of conflict set partitions, and whether the
+// version history is kept in an adaptive radix tree rather than a SkipList.
+static void bench_conflict_set(benchmark::State& state) {
+	const int prefixLength = state.range(0);
+	const int partitions = state.range(1);
+	const bool useART = state.range(2);
+
+	Arena arena;
+	CommitBatchOptions options;
+	options.transactions = kTransactionsPerBatch;
+	options.prefixLength = prefixLength;
+	options.mutationsPerTransaction = 1;
+	options.clearFraction = 0;
+	std::vector<std::vector<CommitTransactionRef>> batches;
+	for (int i = 0; i < kBatches; i++) {
+		batches.push_back(makeCommitBatch(arena, options));
+	}
+
+	ConflictSet* cs = newConflictSet(partitions, useART);
+	Version version = 1000;
+	int batchIndex = 0;
+	for (auto _ : state) {
+		auto& batch = batches[batchIndex++ % kBatches];
+		for (auto& tr : batch)
+			tr.read_snapshot = version - 10;
+
+		const Version newOldestVersion = version - 500;
+		std::vector<int> nonConflicting;
+		ConflictBatch conflictBatch(cs);
+		for (const auto& tr : batch)
+			conflictBatch.addTransaction(tr, newOldestVersion);
+		conflictBatch.detectConflicts(version, newOldestVersion, nonConflicting);
+		benchmark::DoNotOptimize(nonConflicting);
+		version += 10;
+	}
+	destroyConflictSet(cs);
+
+	state.SetItemsProcessed(kTransactionsPerBatch * static_cast<long>(state.iterations()));
+}
+
+BENCHMARK(bench_conflict_set)
+    ->ArgsProduct({ { 0, 16, 32 }, { 1, 4 }, { 0 } })
+    ->ArgsProduct({ { 0, 16, 32 }, { 1 }, { 1 } })
+    ->ReportAggregatesOnly(true);
@@ -20,6 +20,8 @@
 
 #include "benchmark/benchmark.h"
 
+#include "fdbclient/BlobCipher.h"
+#include "fdbclient/CommitTransaction.h"
 #include "flow/StreamCipher.h"
 #include "flowbench/GlobalData.h"
 
@@ -77,3 +79,43 @@ static void bench_decrypt(benchmark::State& state) {
 
 BENCHMARK(bench_encrypt)->Ranges({ { 1 << 12, 1 << 20 }, { 1, 1 << 12 } });
 BENCHMARK(bench_decrypt)->Ranges({ { 1 << 12, 1 << 20 }, { 1, 1 << 12 } });
+
+static Reference<BlobCipherKey> getRandomCipherKey(EncryptCipherDomainId domainId) {
+	uint8_t baseCipher[AES_256_KEY_LENGTH];
+	deterministicRandom()->randomBytes(baseCipher, AES_256_KEY_LENGTH);
+	return makeReference<BlobCipherKey>(domainId,
+	                                    1,
+	                                    baseCipher,
+	                                    AES_256_KEY_LENGTH,
+	                                    std::numeric_limits<int64_t>::max(),
+	                                    std::numeric_limits<int64_t>::max());
+}
+
+// Encrypts a batch of small mutations of one domain, either with a cipher set up per mutation or with one cipher shared
+// by the batch, as the commit proxy does
+static void bench_encrypt_mutations(benchmark::State& state) {
+	constexpr int mutations = 1000;
+	auto valueSize = state.range(0);
+	bool shareCipher = state.range(1);
+	std::unordered_map<EncryptCipherDomainId, Reference<BlobCipherKey>> cipherKeys;
+	cipherKeys[1] = getRandomCipherKey(1);
+	cipherKeys[ENCRYPT_HEADER_DOMAIN_ID] = getRandomCipherKey(ENCRYPT_HEADER_DOMAIN_ID);
+	MutationRef m(MutationRef::SetValue, getKey(16), getKey(valueSize));
+	for (auto _ : state) {
+		Arena arena;
+		if (shareCipher) {
+			auto cipher = MutationRef::encryptCipher(cipherKeys, 1, BlobCipherMetrics::TLOG);
+			for (int i = 0; i < mutations; ++i) {
+				benchmark::DoNotOptimize(m.encrypt(*cipher, arena));
+			}
+		} else {
+			for (int i = 0; i < mutations; ++i) {
+				benchmark::DoNotOptimize(m.encrypt(cipherKeys, 1, arena, BlobCipherMetrics::TLOG));
+			}
+		}
+	}
+	state.SetItemsProcessed(mutations * static_cast<long>(state.iterations()));
+	state.SetBytesProcessed(mutations * m.expectedSize() * static_cast<long>(state.iterations()));
+}
+
+BENCHMARK(bench_encrypt_mutations)->ArgsProduct({ { 16, 100, 1000 }, { 0, 1 } });
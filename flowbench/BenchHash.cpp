@@ -67,3 +67,29 @@ static void bench_hash(benchmark::State& state) {
 BENCHMARK_TEMPLATE(bench_hash, HashType::CRC32C)->DenseRange(2, 18)->ReportAggregatesOnly(true);
 BENCHMARK_TEMPLATE(bench_hash, HashType::HashLittle2)->DenseRange(2, 18)->ReportAggregatesOnly(true);
 BENCHMARK_TEMPLATE(bench_hash, HashType::XXHash3)->DenseRange(2, 18)->ReportAggregatesOnly(true);
+
+// Buffer sizes that are checksummed in production: a small packet, a DiskQueue page less its checksum, a Redwood page,
+// a large packet, and a large file write.
+template <HashType hashType>
+static void bench_hash_buffer(benchmark::State& state) {
+	auto length = state.range(0);
+	auto key = getKey(length);
+	for (auto _ : state) {
+		hash<hashType>(key, length);
+	}
+	state.SetItemsProcessed(static_cast<long>(state.iterations()));
+	state.SetBytesProcessed(static_cast<long>(state.iterations() * length));
+}
+
+#define BENCH_HASH_BUFFER(hashType)                                                                                    \
+	BENCHMARK_TEMPLATE(bench_hash_buffer, hashType)                                                                    \
+	    ->Arg(200)                                                                                                     \
+	    ->Arg(4096 - 8)                                                                                                \
+	    ->Arg(8192)                                                                                                    \
+	    ->Arg(64 << 10)                                                                                                \
+	    ->Arg(1 << 20)                                                                                                 \
+	    ->ReportAggregatesOnly(true)
+
+BENCH_HASH_BUFFER(HashType::CRC32C);
+BENCH_HASH_BUFFER(HashType::HashLittle2);
+BENCH_HASH_BUFFER(HashType::XXHash3);
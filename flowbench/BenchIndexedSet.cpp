@@ -0,0 +1,131 @@
+/*
+ * BenchIndexedSet.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark/benchmark.h"
+
+#include "fdbclient/FDBTypes.h"
+#include "fdbclient/KeyRangeMap.h"
+#include "flow/IndexedSet.h"
+#include "flow/IRandom.h"
+#include "flowbench/GlobalData.h"
+
+#include <map>
+
+// These measure the ordered containers behind shard maps, byte samples and data distribution metadata, with std::map
+// as the point of comparison.  The argument is the number of keys in the container.
+
+static std::vector<Key> randomKeys(int count) {
+	std::vector<Key> keys;
+	keys.reserve(count);
+	for (int i = 0; i < count; i++) {
+		keys.push_back(Key(format("%016llx", (unsigned long long)deterministicRandom()->randomUInt64())));
+	}
+	return keys;
+}
+
+static void insertAll(IndexedSet<Key, int64_t>& set, const std::vector<Key>& keys) {
+	for (const auto& key : keys) {
+		set.insert(Key(key), (int64_t)key.size());
+	}
+}
+
+static void insertAll(std::map<Key, int64_t>& map, const std::vector<Key>& keys) {
+	for (const auto& key : keys) {
+		map.emplace(key, key.size());
+	}
+}
+
+template <class Set>
+static void bench_ordered_insert(benchmark::State& state) {
+	std::vector<Key> keys = randomKeys(state.range(0));
+	for (auto _ : state) {
+		Set set;
+		insertAll(set, keys);
+		benchmark::DoNotOptimize(set);
+	}
+	state.SetItemsProcessed(keys.size() * static_cast<long>(state.iterations()));
+}
+
+template <class Set>
+static void bench_ordered_find(benchmark::State& state) {
+	std::vector<Key> keys = randomKeys(state.range(0));
+	Set set;
+	insertAll(set, keys);
+	InputGenerator<Key> lookups(keys.size(), [&]() { return deterministicRandom()->randomChoice(keys); });
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(set.find(lookups.next()));
+	}
+	state.SetItemsProcessed(static_cast<long>(state.iterations()));
+}
+
+template <class Set>
+static void bench_ordered_iterate(benchmark::State& state) {
+	std::vector<Key> keys = randomKeys(state.range(0));
+	Set set;
+	insertAll(set, keys);
+	for (auto _ : state) {
+		for (const auto& item : set) {
+			benchmark::DoNotOptimize(item);
+		}
+	}
+	state.SetItemsProcessed(keys.size() * static_cast<long>(state.iterations()));
+}
+
+// The byte sample's estimate of the bytes in a range
+static void bench_indexed_set_sum_range(benchmark::State& state) {
+	std::vector<Key> keys = randomKeys(state.range(0));
+	IndexedSet<Key, int64_t> set;
+	insertAll(set, keys);
+	InputGenerator<std::pair<Key, Key>> ranges(keys.size(), [&]() {
+		Key a = deterministicRandom()->randomChoice(keys);
+		Key b = deterministicRandom()->randomChoice(keys);
+		return a < b ? std::make_pair(a, b) : std::make_pair(b, a);
+	});
+	for (auto _ : state) {
+		const auto& range = ranges.next();
+		benchmark::DoNotOptimize(set.sumRange(range.first, range.second));
+	}
+	state.SetItemsProcessed(static_cast<long>(state.iterations()));
+}
+
+// A shard map: ranges are assigned and looked up at random keys
+static void bench_key_range_map(benchmark::State& state) {
+	std::vector<Key> keys = randomKeys(state.range(0));
+	KeyRangeMap<int> map;
+	for (int i = 0; i + 1 < keys.size(); i += 2) {
+		map.insert(keys[i] < keys[i + 1] ? KeyRangeRef(keys[i], keys[i + 1]) : KeyRangeRef(keys[i + 1], keys[i]), i);
+	}
+	InputGenerator<Key> lookups(keys.size(), [&]() { return deterministicRandom()->randomChoice(keys); });
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(map.rangeContaining(lookups.next()));
+	}
+	state.SetItemsProcessed(static_cast<long>(state.iterations()));
+}
+
+BENCHMARK_TEMPLATE(bench_ordered_insert, IndexedSet<Key, int64_t>)->Range(1 << 10, 1 << 20)->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_ordered_insert, std::map<Key, int64_t>)->Range(1 << 10, 1 << 20)->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_ordered_find, IndexedSet<Key, int64_t>)->Range(1 << 10, 1 << 20)->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_ordered_find, std::map<Key, int64_t>)->Range(1 << 10, 1 << 20)->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_ordered_iterate, IndexedSet<Key, int64_t>)
+    ->Range(1 << 10, 1 << 20)
+    ->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_ordered_iterate, std::map<Key, int64_t>)->Range(1 << 10, 1 << 20)->ReportAggregatesOnly(true);
+BENCHMARK(bench_indexed_set_sum_range)->Range(1 << 10, 1 << 20)->ReportAggregatesOnly(true);
+BENCHMARK(bench_key_range_map)->Range(1 << 10, 1 << 20)->ReportAggregatesOnly(true);
@@ -0,0 +1,52 @@
+/*
+ * BenchSerializeVector.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark/benchmark.h"
+
+#include "flow/flow.h"
+#include "flow/ObjectSerializer.h"
+
+#include <deque>
+#include <vector>
+
+// std::vector of a scalar is copied as one block, while std::deque takes the element by element path; both produce the
+// same bytes.
+template <class Container>
+static void bench_serialize_vector(benchmark::State& state) {
+	constexpr FileIdentifier id = 1234567;
+	Container src;
+	for (int64_t i = 0; i < state.range(0); ++i) {
+		src.push_back(i * 0x9E3779B97F4A7C15LL);
+	}
+
+	Container dst;
+	for (auto _ : state) {
+		ObjectWriter writer(Unversioned());
+		writer.serialize(id, src);
+		ObjectReader reader(writer.toStringRef().begin(), Unversioned());
+		reader.deserialize(id, dst);
+		benchmark::DoNotOptimize(dst);
+	}
+	state.SetItemsProcessed(static_cast<long>(state.iterations() * state.range(0)));
+	state.SetBytesProcessed(static_cast<long>(state.iterations() * state.range(0) * sizeof(int64_t)));
+}
+
+BENCHMARK_TEMPLATE(bench_serialize_vector, std::vector<int64_t>)->Range(1, 1 << 16)->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_serialize_vector, std::deque<int64_t>)->Range(1, 1 << 16)->ReportAggregatesOnly(true);
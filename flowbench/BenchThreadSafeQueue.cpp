@@ -0,0 +1,65 @@
+/*
+ * BenchThreadSafeQueue.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark/benchmark.h"
+
+#include "flow/flow.h"
+#include "flow/ThreadSafeQueue.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// state.range(0) producer threads push into one queue that the benchmark thread drains, the way IThreadPool workers
+// and client threads hand completions to the network thread.
+static void bench_threadSafeQueue(benchmark::State& state) {
+	ThreadSafeQueue<int> queue;
+	std::atomic<bool> stop = false;
+	std::vector<std::thread> producers;
+	for (int i = 0; i < state.range(0); i++) {
+		producers.emplace_back([&queue, &stop]() {
+			int n = 0;
+			while (!stop.load(std::memory_order_relaxed)) {
+				queue.push(n++);
+				if ((n & 1023) == 0) {
+					// Keep the queue from growing without bound if the consumer falls behind
+					std::this_thread::yield();
+				}
+			}
+		});
+	}
+
+	for (auto _ : state) {
+		Optional<int> item;
+		while (!(item = queue.pop()).present()) {
+		}
+		benchmark::DoNotOptimize(item.get());
+	}
+
+	stop = true;
+	for (auto& t : producers) {
+		t.join();
+	}
+	while (queue.pop().present()) {
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(bench_threadSafeQueue)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime()->ReportAggregatesOnly(true);
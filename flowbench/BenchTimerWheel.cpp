@@ -0,0 +1,80 @@
+/*
+ * BenchTimerWheel.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark/benchmark.h"
+#include "flow/IRandom.h"
+#include "flow/TimerWheel.h"
+#include "flowbench/GlobalData.h"
+
+#include <queue>
+
+namespace {
+
+struct BenchTimer {
+	double at;
+	void* task;
+	bool operator<(BenchTimer const& rhs) const { return at > rhs.at; } // Ordering is reversed for priority_queue
+};
+
+// Most timers are short (yields, request timeouts), but a server also carries a long tail of watches, failure
+// monitors and load balancing backups that sit in the queue for tens of seconds.
+double timerDelay() {
+	double r = deterministicRandom()->random01();
+	if (r < 0.6) {
+		return deterministicRandom()->random01() * 0.01;
+	} else if (r < 0.9) {
+		return deterministicRandom()->random01();
+	}
+	return deterministicRandom()->random01() * 60;
+}
+
+// Keeps state.range(0) timers outstanding; each iteration fires the earliest timer and schedules a new one from its
+// time, the way the run loop does.
+template <class Queue>
+void benchTimers(benchmark::State& state) {
+	Queue timers;
+	InputGenerator<double> delays(1e6, timerDelay);
+	double now = 0;
+	for (int i = 0; i < state.range(0); i++) {
+		timers.push(BenchTimer{ now + delays.next(), nullptr });
+	}
+
+	for (auto _ : state) {
+		now = timers.top().at;
+		benchmark::DoNotOptimize(timers.top().task);
+		timers.pop();
+		timers.push(BenchTimer{ now + delays.next(), nullptr });
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+static void bench_timers_priority_queue(benchmark::State& state) {
+	benchTimers<std::priority_queue<BenchTimer>>(state);
+}
+
+static void bench_timers_wheel(benchmark::State& state) {
+	benchTimers<TimerWheel<BenchTimer>>(state);
+}
+
+BENCHMARK(bench_timers_priority_queue)->Arg(1000)->Arg(100000)->Arg(1000000)->ReportAggregatesOnly(true);
+BENCHMARK(bench_timers_wheel)->Arg(1000)->Arg(100000)->Arg(1000000)->ReportAggregatesOnly(true);
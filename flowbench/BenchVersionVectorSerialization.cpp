@@ -84,5 +84,43 @@ static void bench_dynamic_size_traits_version(benchmark::State& state) {
 	state.counters.insert({ { "Tags", tagCount }, { "Size", size } });
 }
 
+// The read path of a GRV reply: the proxy takes the delta a client is missing and encodes it, and the client decodes
+// it and applies it to its own cache
+static void bench_grv_reply_delta(benchmark::State& state) {
+	Arena arena;
+	TestContextArena context{ arena };
+
+	int tagCount = state.range(0);
+	int changedCount = state.range(1);
+
+	Version version = 100000;
+	VersionVector proxyVV(version);
+	for (int i = 0; i < tagCount; i++) {
+		proxyVV.setVersion(Tag(i % 2, i / 2), ++version);
+	}
+	Version clientVersion = version - changedCount;
+
+	size_t size = 0;
+	for (auto _ : state) {
+		state.PauseTiming();
+		VersionVector clientVV(clientVersion);
+		state.ResumeTiming();
+
+		VersionVector delta;
+		proxyVV.getDelta(clientVersion, delta);
+		size = dynamic_size_traits<VersionVector>::size(delta, context);
+		uint8_t* buf = context.allocate(size);
+		dynamic_size_traits<VersionVector>::save(buf, delta, context);
+
+		VersionVector received;
+		dynamic_size_traits<VersionVector>::load(buf, size, received, context);
+		clientVV.applyDelta(received);
+		benchmark::DoNotOptimize(clientVV);
+	}
+	state.SetItemsProcessed(static_cast<long>(state.iterations()));
+	state.counters.insert({ { "Tags", tagCount }, { "Changed", changedCount }, { "Size", size } });
+}
+
 BENCHMARK(bench_serializable_traits_version)->Ranges({ { 1 << 4, 1 << 10 } })->ReportAggregatesOnly(true);
 BENCHMARK(bench_dynamic_size_traits_version)->Ranges({ { 1 << 4, 1 << 10 } })->ReportAggregatesOnly(true);
+BENCHMARK(bench_grv_reply_delta)->Ranges({ { 1 << 4, 1 << 10 }, { 1, 1 << 4 } })->ReportAggregatesOnly(true);
@@ -0,0 +1,58 @@
+/*
+ * CommitBatchGenerator.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "flowbench/CommitBatchGenerator.h"
+#include "flow/IRandom.h"
+
+KeyRef makeCommitKey(Arena& arena, int prefixLength, int64_t n) {
+	uint8_t* key = new (arena) uint8_t[prefixLength + sizeof(n)];
+	memset(key, 't', prefixLength);
+	for (int i = 0; i < sizeof(n); i++)
+		key[prefixLength + i] = (uint8_t)(n >> (8 * (sizeof(n) - 1 - i)));
+	return KeyRef(key, prefixLength + sizeof(n));
+}
+
+KeyRangeRef makeCommitRange(Arena& arena, int prefixLength, int maxWidth) {
+	int64_t begin = deterministicRandom()->randomInt(0, kCommitKeySpace);
+	int64_t end = begin + 1 + deterministicRandom()->randomInt(0, maxWidth);
+	return KeyRangeRef(makeCommitKey(arena, prefixLength, begin), makeCommitKey(arena, prefixLength, end));
+}
+
+std::vector<CommitTransactionRef> makeCommitBatch(Arena& arena, CommitBatchOptions const& options) {
+	std::vector<CommitTransactionRef> batch(options.transactions);
+	for (auto& tr : batch) {
+		tr.read_conflict_ranges.push_back(arena, makeCommitRange(arena, options.prefixLength, 10));
+		tr.read_conflict_ranges.push_back(arena, makeCommitRange(arena, options.prefixLength, 1000));
+		for (int i = 0; i < options.mutationsPerTransaction; i++) {
+			if (deterministicRandom()->random01() < options.clearFraction) {
+				KeyRangeRef range = makeCommitRange(arena, options.prefixLength, 100);
+				tr.mutations.push_back(arena, MutationRef(MutationRef::ClearRange, range.begin, range.end));
+				tr.write_conflict_ranges.push_back(arena, range);
+			} else {
+				KeyRangeRef range = makeCommitRange(arena, options.prefixLength, 1);
+				StringRef value = makeString(options.valueSize, arena);
+				deterministicRandom()->randomBytes(mutateString(value), options.valueSize);
+				tr.mutations.push_back(arena, MutationRef(MutationRef::SetValue, range.begin, value));
+				tr.write_conflict_ranges.push_back(arena, range);
+			}
+		}
+	}
+	return batch;
+}
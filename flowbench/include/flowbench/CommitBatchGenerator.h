@@ -0,0 +1,53 @@
+/*
+ * CommitBatchGenerator.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLOWBENCH_COMMIT_BATCH_GENERATOR_H
+#define FLOWBENCH_COMMIT_BATCH_GENERATOR_H
+
+#pragma once
+
+#include "fdbclient/CommitTransaction.h"
+#include "fdbclient/FDBTypes.h"
+
+// Generates the transactions of commit batches for the commit path benchmarks (conflict resolution, tag assignment,
+// log push serialization and storage server apply), so that they all measure the same kind of batch.
+
+static constexpr int kCommitKeySpace = 10000000;
+
+struct CommitBatchOptions {
+	int transactions = 1000;
+	int prefixLength = 16; // Bytes shared by every key, as in one tenant
+	int mutationsPerTransaction = 4;
+	int valueSize = 100;
+	double clearFraction = 0.05; // Fraction of mutations that are range clears
+};
+
+// Returns a key made of a shared prefix of the given length followed by a big endian integer, so that keys sort
+// numerically and the first prefixLength bytes of every key are the same.
+KeyRef makeCommitKey(Arena& arena, int prefixLength, int64_t n);
+
+// Returns a random range of up to maxWidth keys in the generated key space
+KeyRangeRef makeCommitRange(Arena& arena, int prefixLength, int maxWidth);
+
+// Returns a batch of transactions, each with its mutations, a write conflict range per mutation and two read conflict
+// ranges
+std::vector<CommitTransactionRef> makeCommitBatch(Arena& arena, CommitBatchOptions const& options);
+
+#endif